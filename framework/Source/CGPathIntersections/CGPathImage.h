@@ -35,6 +35,7 @@ typedef struct {
 
 @property (nonatomic, readwrite, assign) CGPathRef _Nonnull path;
 @property (nonatomic, readwrite, assign) CGRect boundingBox;
+// the images are rendered on first use, finding intersections does not need them
 @property (nonatomic, readwrite, assign) CGImageRef _Nullable cgImage;
 @property (nonatomic, readwrite, retain) PlatformImage *image;
 @property (nonatomic, readwrite, assign) RawImage rawImage;
@@ -8,8 +8,18 @@
 //
 
 #import "CGPathImage.h"
-#import "NSMutableArray+CoalescePoints.h"
+#import "CGPathSegmentIntersections.h"
 
+#if TARGET_OS_OSX
+
+#else
+@interface CGPathImage()
+
+// pixel data behind rawImage.pixels
+@property (nonatomic, readwrite, strong, nullable) NSData *pixelData;
+
+@end
+#endif
 
 @implementation CGPathImage
 
@@ -18,12 +28,10 @@
 @synthesize cgImage;
 @synthesize image;
 @synthesize rawImage;
-
-static RawImage rrawImage;
 #if TARGET_OS_OSX
 
 #else
-static CFDataRef pixelData;
+@synthesize pixelData;
 #endif
 
 CGRect CGRectInImageFromRectAndRect(CGRect rect1, CGRect rect2);
@@ -35,79 +43,99 @@ CGRect CGRectInImageFromRectAndRect(CGRect rect1, CGRect rect2);
         // Perfectly-straight lines have a width or height of zero,
         // but to create a useful image we have to have at least one row/column of pixels.
         CGRect absoluteBoundingBox = CGPathGetBoundingBox(_path);
-        CGRect aboundingBox = CGRectMake(absoluteBoundingBox.origin.x, absoluteBoundingBox.origin.y, MAX(absoluteBoundingBox.size.width, 1), MAX(absoluteBoundingBox.size.height, 1));
-        
-        void(^drawToContext)(CGContextRef) = ^(CGContextRef context) {
-            CGColorSpaceRef colorspace = CGColorSpaceCreateDeviceRGB();
-            const CGFloat components[4] = { 0, 0, 0, 0.5 };
-            CGColorRef rgba = CGColorCreate(colorspace, components);
-            CGContextSetStrokeColorWithColor(context, rgba);
-            CGContextSetLineWidth(context, 1.0);
-            CGContextSetAllowsAntialiasing(context, NO);
-            CGContextSetShouldAntialias(context, NO);
-            CGAffineTransform translationToOrigin = CGAffineTransformMakeTranslation(-CGRectGetMinX(aboundingBox), -CGRectGetMinY(aboundingBox));
-            
-            CGPathRef pathAtOrigin = CGPathCreateCopyByTransformingPath(self.path, &translationToOrigin);
-            CGContextAddPath(context, pathAtOrigin);
-            CGContextDrawPath(context,  kCGPathStroke);
-            CGPathRelease(pathAtOrigin);
-            CGColorRelease(rgba);
-            CGColorSpaceRelease(colorspace);
-        };
-        
-        PlatformImage *anImage = [PlatformImage renderImageWithSize:aboundingBox.size draw:drawToContext];
+        self.boundingBox = CGRectMake(absoluteBoundingBox.origin.x, absoluteBoundingBox.origin.y, MAX(absoluteBoundingBox.size.width, 1), MAX(absoluteBoundingBox.size.height, 1));
         
-        self.boundingBox = aboundingBox;
-        self.image = anImage;
-        self.cgImage = anImage.CGImage;
-        
-        [self setRrawImage];
-        self.rawImage = rrawImage;
+        // the intersections are found geometrically, the path is only rendered for the debugging images
     }
     return self;
 }
 
 - (void)dealloc {
     self.cgImage = nil;
+}
+
+#pragma mark - Rendering
+
+-(PlatformImage*)image {
+    if ( image == nil ) {
+        [self renderPath];
+    }
+    return image;
+}
+
+-(CGImageRef)cgImage {
+    if ( cgImage == nil && image == nil ) {
+        [self renderPath];
+    }
+    return cgImage;
+}
+
+-(RawImage)rawImage {
+#if TARGET_OS_OSX
+    if ( rawImage.bitmapRep == nil ) {
+        [self setRrawImage];
+    }
+#else
+    if ( rawImage.pixels == nil ) {
+        [self setRrawImage];
+    }
+#endif
+    return rawImage;
+}
+
+-(void)renderPath {
+    CGRect aboundingBox = self.boundingBox;
+    
+    void(^drawToContext)(CGContextRef) = ^(CGContextRef context) {
+        CGColorSpaceRef colorspace = CGColorSpaceCreateDeviceRGB();
+        const CGFloat components[4] = { 0, 0, 0, 0.5 };
+        CGColorRef rgba = CGColorCreate(colorspace, components);
+        CGContextSetStrokeColorWithColor(context, rgba);
+        CGContextSetLineWidth(context, 1.0);
+        CGContextSetAllowsAntialiasing(context, NO);
+        CGContextSetShouldAntialias(context, NO);
+        CGAffineTransform translationToOrigin = CGAffineTransformMakeTranslation(-CGRectGetMinX(aboundingBox), -CGRectGetMinY(aboundingBox));
+        
+        CGPathRef pathAtOrigin = CGPathCreateCopyByTransformingPath(self.path, &translationToOrigin);
+        CGContextAddPath(context, pathAtOrigin);
+        CGContextDrawPath(context,  kCGPathStroke);
+        CGPathRelease(pathAtOrigin);
+        CGColorRelease(rgba);
+        CGColorSpaceRelease(colorspace);
+    };
     
-//#if TARGET_OS_OSX
-//    
-//#else
-//    if ( pixelData != NULL ) {
-//        CFRelease(pixelData);
-//    }
-//#endif
-//    
+    PlatformImage *anImage = [PlatformImage renderImageWithSize:aboundingBox.size draw:drawToContext];
     
+    image = anImage;
+    cgImage = anImage.CGImage;
 }
 
 -(void)setRrawImage {
-    if ( self.image.CGImage == nil ) {
+    CGImageRef aCGImage = self.cgImage;
+    if ( aCGImage == nil ) {
         return;
     }
     
-    CGImageRef aCGImage = self.image.CGImage;
     CGRect aboundingBox = CGRectMake((NSInteger)self.boundingBox.origin.x, (NSInteger)self.boundingBox.origin.y, CGImageGetWidth(aCGImage), CGImageGetHeight(aCGImage));
     
-    rrawImage.options.bounds = aboundingBox;
-    rrawImage.options.bytesPerRow = CGImageGetBytesPerRow(aCGImage);
-    rrawImage.options.bitsPerComponent = CGImageGetBitsPerComponent(aCGImage);
+    rawImage.options.bounds = aboundingBox;
+    rawImage.options.bytesPerRow = CGImageGetBytesPerRow(aCGImage);
+    rawImage.options.bitsPerComponent = CGImageGetBitsPerComponent(aCGImage);
     
 #if TARGET_OS_OSX
-    NSData *tiffRep = [self.image TIFFRepresentation];
-    NSBitmapImageRep *bitmapRep = [NSBitmapImageRep imageRepWithData:tiffRep];
-    rrawImage.bitmapRep = bitmapRep;
+    // read the pixels of the rendered bitmap directly rather than through a TIFF representation
+    rawImage.bitmapRep = [[NSBitmapImageRep alloc] initWithCGImage:aCGImage];
 #else
-    pixelData = CGDataProviderCopyData(CGImageGetDataProvider(aCGImage));
+    self.pixelData = (__bridge_transfer NSData *)CGDataProviderCopyData(CGImageGetDataProvider(aCGImage));
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wcast-qual"
-    rrawImage.pixels = (UInt8*)(CFDataGetBytePtr(pixelData));
+    rawImage.pixels = (UInt8*)(self.pixelData.bytes);
 #pragma clang diagnostic pop
 #endif
 }
 
 -(RawImage)getRawImage {
-    return rrawImage;
+    return self.rawImage;
 }
 
 
@@ -118,48 +146,26 @@ CGRect CGRectInImageFromRectAndRect(CGRect rect1, CGRect rect2);
 }
 
 -(NSArray<NSValue*>*)intersectionPointsWithOther:(CGPathImage*)other {
-    RawImage image1Raw = self.rawImage;
-    RawImage image2Raw = other.rawImage;
-#if TARGET_OS_OSX
-    if ( image1Raw.bitmapRep == nil && image2Raw.bitmapRep == nil ) {
-        return nil;
-    }
-#else
-    if ( image1Raw.pixels == nil && image2Raw.pixels == nil ) {
-        return nil;
-    }
-#endif
-    NSMutableArray<NSValue*>* intersectionPixels = [[NSMutableArray alloc] init];
-    CGRect intersectionRect = CGRectIntersection(self.boundingBox, other.boundingBox);
-    if ( CGRectIsNull(intersectionRect) ) {
+    // intersect the flattened paths directly rather than comparing the rendered pixels
+    if ( !CGRectIntersectsRect(self.boundingBox, other.boundingBox) ) {
         return nil;
     }
-    //iterate over intersection of bounding boxes
-    for( NSInteger x = (NSInteger)(floor(CGRectGetMinX(intersectionRect))); x < (NSInteger)(floor(CGRectGetMaxX(intersectionRect))); x++) {
-        for( NSInteger y = (NSInteger)(floor(CGRectGetMinY(intersectionRect))); y < (NSInteger)(floor(CGRectGetMaxY(intersectionRect))); y++) {
-            CGColorRef color1 = CGColorCreateSRGB(0, 0, 0, 0);
-            CGColorRef color2 = CGColorCreateSRGB(0, 0, 0, 0);
-            [self colorOfRawImage:image1Raw atX:x y:y color:&color1];
-            [self colorOfRawImage:image2Raw atX:x y:y color:&color2];
-            if ( CGColorGetAlpha(color1) > 0.05 && CGColorGetAlpha(color2) > 0.05 ) {
-                NSValue *value;
+    CGPathIntersections intersections;
+    initCGPathIntersections(&intersections, 8);
+    CGPathIntersectionsWithOther(self.path, other.path, &intersections);
+
+    NSMutableArray<NSValue*>* intersectionPoints = [[NSMutableArray alloc] initWithCapacity:intersections.used];
+    for( size_t i = 0; i < intersections.used; i++ ) {
+        NSValue *value;
 #if TARGET_OS_OSX
-                value = [NSValue valueWithPoint:(NSPoint)CGPointMake((CGFloat)x, (CGFloat)y)];
+        value = [NSValue valueWithPoint:(NSPoint)intersections.array[i].point];
 #else
-                value = [NSValue valueWithCGPoint:CGPointMake((CGFloat)x, (CGFloat)y)];
+        value = [NSValue valueWithCGPoint:intersections.array[i].point];
 #endif
-                [intersectionPixels addObject:value];
-            }
-            CGColorRelease(color1);
-            CGColorRelease(color2);
-        }
-    }
-    if ( [intersectionPixels count] <= 1 ) {
-        return intersectionPixels;
-    }
-    else {
-        return [intersectionPixels coalescePoints];
+        [intersectionPoints addObject:value];
     }
+    freeCGPathIntersections(&intersections);
+    return intersectionPoints;
 }
 
 #pragma mark: - Debugging Helpers
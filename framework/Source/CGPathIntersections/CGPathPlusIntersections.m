@@ -8,7 +8,7 @@
 //
 
 #import "CGPathPlusIntersections.h"
-#import "CGPathImage.h"
+#import "CGPathSegmentIntersections.h"
 
 
 BOOL CGPathIntersectsPathWithOther(CGPathRef path1, CGPathRef path2) {
@@ -16,27 +16,24 @@ BOOL CGPathIntersectsPathWithOther(CGPathRef path1, CGPathRef path2) {
 }
 
 NSUInteger CGPathCountIntersectionPointsWithOther(CGPathRef path1, CGPathRef path2) {
-    CGPathImage *pathImage1 = [[CGPathImage alloc] initFromPath:path1];
-    CGPathImage *pathImage2 = [[CGPathImage alloc] initFromPath:path2];
-    
-    
-    return [[pathImage1 intersectionPointsWithOther:pathImage2] count];
+    CGPathIntersections intersections;
+    initCGPathIntersections(&intersections, 8);
+    CGPathIntersectionsWithOther(path1, path2, &intersections);
+    NSUInteger count = (NSUInteger)intersections.used;
+    freeCGPathIntersections(&intersections);
+
+    return count;
 }
 
 CGPoint CGPathIntersectionPointWithOtherAtIndex(CGPathRef path1, CGPathRef path2, size_t index) {
-    CGPathImage *pathImage1 = [[CGPathImage alloc] initFromPath:path1];
-    CGPathImage *pathImage2 = [[CGPathImage alloc] initFromPath:path2];
-        
-    NSArray<NSValue*> *values = [pathImage1 intersectionPointsWithOther:pathImage2];
-    if ( /*index < 0 &&*/ index > values.count - 1 ) {
-        return CGPointMake(-0.0, -0.0);
+    CGPathIntersections intersections;
+    initCGPathIntersections(&intersections, 8);
+    CGPathIntersectionsWithOther(path1, path2, &intersections);
+
+    CGPoint point = CGPointMake(-0.0, -0.0);
+    if ( index < intersections.used ) {
+        point = intersections.array[index].point;
     }
-    
-    CGPoint point;
-#if TARGET_OS_OSX
-    point = (CGPoint)[[values objectAtIndex:index] pointValue];
-#else
-    point = [[values objectAtIndex:index] CGPointValue];
-#endif
+    freeCGPathIntersections(&intersections);
     return point;
 }
@@ -0,0 +1,67 @@
+//
+//  CGPathSegmentIntersections.h
+//  CGPathIntersections
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Geometric intersection of flattened CGPaths. Each path is flattened into
+//  line segments, the segments of the first path are binned into a uniform grid
+//  laid over the overlap of the two bounding boxes, and each segment of the other
+//  path is only tested against the segments sharing its grid cells. The cost
+//  depends on the number of segments and intersections, not on the pixel area
+//  the paths cover.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef struct {
+    CGPoint start;
+    CGPoint end;
+} CGPathSegment;
+
+typedef struct {
+    CGPathSegment * _Nullable array;
+    size_t used;
+    size_t size;
+} CGPathSegments;
+
+void initCGPathSegments(CGPathSegments *a, size_t initialSize);
+void appendCGPathSegments(CGPathSegments *a, CGPathSegment element);
+void clearCGPathSegments(CGPathSegments *a);
+void freeCGPathSegments(CGPathSegments *a);
+
+typedef struct {
+    CGPoint point;
+    size_t segment;         // index of the segment in the first set of segments
+    size_t otherSegment;    // index of the segment in the other set of segments
+} CGPathIntersection;
+
+typedef struct {
+    CGPathIntersection * _Nullable array;
+    size_t used;
+    size_t size;
+} CGPathIntersections;
+
+void initCGPathIntersections(CGPathIntersections *a, size_t initialSize);
+void appendCGPathIntersections(CGPathIntersections *a, CGPathIntersection element);
+void clearCGPathIntersections(CGPathIntersections *a);
+void freeCGPathIntersections(CGPathIntersections *a);
+
+// default maximum distance between a curve and the segments that replace it, in path units
+extern const CGFloat CGPathSegmentsDefaultFlatness;
+
+// appends the line segments of path to segments, curves are subdivided until they are within flatness of the curve
+// and closed subpaths get a closing segment. Zero length segments are dropped.
+void CGPathAppendFlattenedSegments(CGPathRef path, CGFloat flatness, CGPathSegments *segments);
+
+// appends every point where a segment of segments meets a segment of otherSegments to intersections, ordered by the
+// index in segments. A point shared by consecutive segments is only reported once and collinear overlaps report their end points.
+void CGPathSegmentsIntersections(const CGPathSegments *segments, const CGPathSegments *otherSegments, CGPathIntersections *intersections);
+
+// convenience, flattens both paths with the default flatness and intersects them
+void CGPathIntersectionsWithOther(CGPathRef path, CGPathRef otherPath, CGPathIntersections *intersections);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,472 @@
+//
+//  CGPathSegmentIntersections.m
+//  CGPathIntersections
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "CGPathSegmentIntersections.h"
+
+#import <tgmath.h>
+
+const CGFloat CGPathSegmentsDefaultFlatness = (CGFloat)0.1;
+
+// tolerance on the segment parameters, hits this close to an end point are snapped onto it
+static const CGFloat kSegmentParameterTolerance = (CGFloat)1.0e-9;
+// limits on the uniform grid and on the subdivision of a single curve
+static const size_t kMaxGridCellsPerSide        = 1024;
+static const size_t kMaxCurveSubdivisions       = 1024;
+
+#pragma mark -
+#pragma mark Growable arrays
+
+void initCGPathSegments(CGPathSegments *a, size_t initialSize) {
+    a->array = (CGPathSegment*)calloc(initialSize, sizeof(CGPathSegment));
+    a->used = 0;
+    a->size = initialSize;
+}
+
+void appendCGPathSegments(CGPathSegments *a, CGPathSegment element) {
+    if (a->used == a->size) {
+        a->size = a->size > 0 ? a->size * 2 : 8;
+        a->array = (CGPathSegment*)realloc(a->array, a->size * sizeof(CGPathSegment));
+    }
+    a->array[a->used++] = element;
+}
+
+void clearCGPathSegments(CGPathSegments *a) {
+    a->used = 0;
+}
+
+void freeCGPathSegments(CGPathSegments *a) {
+    free(a->array);
+    a->array = NULL;
+    a->used = a->size = 0;
+}
+
+void initCGPathIntersections(CGPathIntersections *a, size_t initialSize) {
+    a->array = (CGPathIntersection*)calloc(initialSize, sizeof(CGPathIntersection));
+    a->used = 0;
+    a->size = initialSize;
+}
+
+void appendCGPathIntersections(CGPathIntersections *a, CGPathIntersection element) {
+    if (a->used == a->size) {
+        a->size = a->size > 0 ? a->size * 2 : 8;
+        a->array = (CGPathIntersection*)realloc(a->array, a->size * sizeof(CGPathIntersection));
+    }
+    a->array[a->used++] = element;
+}
+
+void clearCGPathIntersections(CGPathIntersections *a) {
+    a->used = 0;
+}
+
+void freeCGPathIntersections(CGPathIntersections *a) {
+    free(a->array);
+    a->array = NULL;
+    a->used = a->size = 0;
+}
+
+#pragma mark -
+#pragma mark Flattening
+
+typedef struct {
+    CGPathSegments *segments;
+    CGFloat flatness;
+    CGPoint current;
+    CGPoint subpathStart;
+} FlattenState;
+
+static void appendFlattenedSegment(FlattenState *state, CGPoint point) {
+    if ( !CGPointEqualToPoint(state->current, point) ) {
+        CGPathSegment segment = { state->current, point };
+        appendCGPathSegments(state->segments, segment);
+    }
+    state->current = point;
+}
+
+// number of segments needed to keep a polynomial curve within flatness, from the bound on its second
+// difference (Wang's formula), degreeFactor is d(d-1)/8 for a curve of degree d
+static size_t curveSubdivisions(CGFloat secondDifference, CGFloat degreeFactor, CGFloat flatness) {
+    if ( !(secondDifference > 0) || !(flatness > 0) ) {
+        return 1;
+    }
+    CGFloat n = ceil(sqrt(degreeFactor * secondDifference / flatness));
+    if ( !(n >= 1) ) {
+        return 1;
+    }
+    return n > (CGFloat)kMaxCurveSubdivisions ? kMaxCurveSubdivisions : (size_t)n;
+}
+
+static void flattenPathElement(void *info, const CGPathElement *element) {
+    FlattenState *state = (FlattenState*)info;
+    const CGPoint *points = element->points;
+
+    switch ( element->type ) {
+        case kCGPathElementMoveToPoint:
+            state->current = points[0];
+            state->subpathStart = points[0];
+            break;
+
+        case kCGPathElementAddLineToPoint:
+            appendFlattenedSegment(state, points[0]);
+            break;
+
+        case kCGPathElementAddQuadCurveToPoint:
+        {
+            CGPoint p0 = state->current;
+            CGFloat ddx = p0.x - 2 * points[0].x + points[1].x;
+            CGFloat ddy = p0.y - 2 * points[0].y + points[1].y;
+            size_t n = curveSubdivisions(hypot(ddx, ddy), (CGFloat)0.25, state->flatness);
+            for ( size_t i = 1; i < n; i++ ) {
+                CGFloat t = (CGFloat)i / (CGFloat)n, mt = 1 - t;
+                CGPoint point = CGPointMake(mt * mt * p0.x + 2 * mt * t * points[0].x + t * t * points[1].x,
+                                            mt * mt * p0.y + 2 * mt * t * points[0].y + t * t * points[1].y);
+                appendFlattenedSegment(state, point);
+            }
+            appendFlattenedSegment(state, points[1]);
+            break;
+        }
+
+        case kCGPathElementAddCurveToPoint:
+        {
+            CGPoint p0 = state->current;
+            CGFloat dd1 = hypot(p0.x - 2 * points[0].x + points[1].x, p0.y - 2 * points[0].y + points[1].y);
+            CGFloat dd2 = hypot(points[0].x - 2 * points[1].x + points[2].x, points[0].y - 2 * points[1].y + points[2].y);
+            size_t n = curveSubdivisions(MAX(dd1, dd2), (CGFloat)0.75, state->flatness);
+            for ( size_t i = 1; i < n; i++ ) {
+                CGFloat t = (CGFloat)i / (CGFloat)n, mt = 1 - t;
+                CGFloat b0 = mt * mt * mt, b1 = 3 * mt * mt * t, b2 = 3 * mt * t * t, b3 = t * t * t;
+                CGPoint point = CGPointMake(b0 * p0.x + b1 * points[0].x + b2 * points[1].x + b3 * points[2].x,
+                                            b0 * p0.y + b1 * points[0].y + b2 * points[1].y + b3 * points[2].y);
+                appendFlattenedSegment(state, point);
+            }
+            appendFlattenedSegment(state, points[2]);
+            break;
+        }
+
+        case kCGPathElementCloseSubpath:
+            appendFlattenedSegment(state, state->subpathStart);
+            break;
+    }
+}
+
+void CGPathAppendFlattenedSegments(CGPathRef path, CGFloat flatness, CGPathSegments *segments) {
+    FlattenState state = { segments, flatness > 0 ? flatness : CGPathSegmentsDefaultFlatness, CGPointZero, CGPointZero };
+    CGPathApply(path, &state, flattenPathElement);
+}
+
+#pragma mark -
+#pragma mark Segment intersection
+
+static CGFloat crossProduct(CGPoint a, CGPoint b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+static CGFloat dotProduct(CGPoint a, CGPoint b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+// the point at parameter t along segment, snapped onto an end point when t is within tolerance of it
+static CGPoint pointOnSegment(const CGPathSegment *segment, CGFloat t) {
+    if ( t <= kSegmentParameterTolerance ) {
+        return segment->start;
+    }
+    else if ( t >= 1 - kSegmentParameterTolerance ) {
+        return segment->end;
+    }
+    return CGPointMake(segment->start.x + t * (segment->end.x - segment->start.x), segment->start.y + t * (segment->end.y - segment->start.y));
+}
+
+static BOOL parameterInSegment(CGFloat t) {
+    return t >= -kSegmentParameterTolerance && t <= 1 + kSegmentParameterTolerance;
+}
+
+static void intersectSegments(const CGPathSegment *segment, size_t index, const CGPathSegment *otherSegment, size_t otherIndex, CGPathIntersections *intersections) {
+    CGPoint r = CGPointMake(segment->end.x - segment->start.x, segment->end.y - segment->start.y);
+    CGPoint s = CGPointMake(otherSegment->end.x - otherSegment->start.x, otherSegment->end.y - otherSegment->start.y);
+    CGPoint qp = CGPointMake(otherSegment->start.x - segment->start.x, otherSegment->start.y - segment->start.y);
+    CGFloat rr = dotProduct(r, r), ss = dotProduct(s, s);
+    CGFloat denominator = crossProduct(r, s);
+    CGPathIntersection intersection = { CGPointZero, index, otherIndex };
+
+    if ( rr == 0 || ss == 0 ) {
+        return;
+    }
+
+    if ( fabs(denominator) > kSegmentParameterTolerance * sqrt(rr * ss) ) {
+        CGFloat t = crossProduct(qp, s) / denominator;
+        CGFloat u = crossProduct(qp, r) / denominator;
+        if ( parameterInSegment(t) && parameterInSegment(u) ) {
+            // an end point of the other segment is the exact answer when u snaps, keep it so shared vertices compare equal
+            if ( u <= kSegmentParameterTolerance || u >= 1 - kSegmentParameterTolerance ) {
+                if ( t > kSegmentParameterTolerance && t < 1 - kSegmentParameterTolerance ) {
+                    intersection.point = pointOnSegment(otherSegment, u);
+                }
+                else {
+                    intersection.point = pointOnSegment(segment, t);
+                }
+            }
+            else {
+                intersection.point = pointOnSegment(segment, t);
+            }
+            appendCGPathIntersections(intersections, intersection);
+        }
+    }
+    else if ( fabs(crossProduct(qp, r)) <= kSegmentParameterTolerance * sqrt(rr * dotProduct(qp, qp)) ) {
+        // collinear, report the ends of the overlap
+        CGFloat t0 = dotProduct(qp, r) / rr;
+        CGFloat t1 = t0 + dotProduct(s, r) / rr;
+        CGFloat tMin = MAX(MIN(t0, t1), 0), tMax = MIN(MAX(t0, t1), 1);
+        if ( tMin <= tMax + kSegmentParameterTolerance ) {
+            intersection.point = pointOnSegment(segment, tMin);
+            appendCGPathIntersections(intersections, intersection);
+            if ( tMax - tMin > kSegmentParameterTolerance ) {
+                intersection.point = pointOnSegment(segment, tMax);
+                appendCGPathIntersections(intersections, intersection);
+            }
+        }
+    }
+}
+
+static int compareIntersectionPoints(const void *a, const void *b) {
+    const CGPathIntersection *aO = (const CGPathIntersection*)a;
+    const CGPathIntersection *bO = (const CGPathIntersection*)b;
+
+    if ( aO->point.x < bO->point.x ) return -1;
+    if ( aO->point.x > bO->point.x ) return 1;
+    if ( aO->point.y < bO->point.y ) return -1;
+    if ( aO->point.y > bO->point.y ) return 1;
+    if ( aO->segment < bO->segment ) return -1;
+    if ( aO->segment > bO->segment ) return 1;
+    if ( aO->otherSegment < bO->otherSegment ) return -1;
+    if ( aO->otherSegment > bO->otherSegment ) return 1;
+    return 0;
+}
+
+static int compareIntersectionSegments(const void *a, const void *b) {
+    const CGPathIntersection *aO = (const CGPathIntersection*)a;
+    const CGPathIntersection *bO = (const CGPathIntersection*)b;
+
+    if ( aO->segment < bO->segment ) return -1;
+    if ( aO->segment > bO->segment ) return 1;
+    if ( aO->otherSegment < bO->otherSegment ) return -1;
+    if ( aO->otherSegment > bO->otherSegment ) return 1;
+    return compareIntersectionPoints(a, b);
+}
+
+#pragma mark -
+#pragma mark Uniform grid
+
+typedef struct {
+    CGRect bounds;
+    CGFloat cellWidth;
+    CGFloat cellHeight;
+    size_t columns;
+    size_t rows;
+    size_t *cellStarts;     // rows * columns + 1 offsets into cellSegments
+    size_t *cellSegments;   // segment indices, grouped by cell
+} SegmentGrid;
+
+static CGRect segmentBounds(const CGPathSegment *segment) {
+    return CGRectMake(MIN(segment->start.x, segment->end.x), MIN(segment->start.y, segment->end.y), fabs(segment->end.x - segment->start.x), fabs(segment->end.y - segment->start.y));
+}
+
+static CGRect segmentsBounds(const CGPathSegments *segments) {
+    CGRect bounds = CGRectNull;
+    for ( size_t i = 0; i < segments->used; i++ ) {
+        bounds = CGRectUnion(bounds, segmentBounds(&segments->array[i]));
+    }
+    return bounds;
+}
+
+// overlapping rectangles including those that only touch, CGRectIntersectsRect misses zero width or height
+static BOOL rectsTouch(CGRect a, CGRect b) {
+    return CGRectGetMinX(a) <= CGRectGetMaxX(b) && CGRectGetMinX(b) <= CGRectGetMaxX(a) && CGRectGetMinY(a) <= CGRectGetMaxY(b) && CGRectGetMinY(b) <= CGRectGetMaxY(a);
+}
+
+static size_t gridCellIndex(CGFloat offset, CGFloat cellSize, size_t count) {
+    if ( !(cellSize > 0) || !(offset > 0) ) {
+        return 0;
+    }
+    CGFloat index = floor(offset / cellSize);
+    return index >= (CGFloat)count ? count - 1 : (size_t)index;
+}
+
+typedef void (*SegmentCellVisitor)(size_t cell, void *context);
+
+// calls visit for every cell of the grid the segment passes through, row by row, using the part of the
+// segment that lies in each row to find its columns. Cells are visited once each.
+static void visitSegmentCells(const SegmentGrid *grid, const CGPathSegment *segment, SegmentCellVisitor visit, void *context) {
+    CGRect bounds = segmentBounds(segment);
+    CGFloat minX = CGRectGetMinX(grid->bounds), minY = CGRectGetMinY(grid->bounds);
+    size_t firstRow = gridCellIndex(CGRectGetMinY(bounds) - minY, grid->cellHeight, grid->rows);
+    size_t lastRow = gridCellIndex(CGRectGetMaxY(bounds) - minY, grid->cellHeight, grid->rows);
+    CGFloat dx = segment->end.x - segment->start.x, dy = segment->end.y - segment->start.y;
+
+    for ( size_t row = firstRow; row <= lastRow; row++ ) {
+        CGFloat rowMinX = CGRectGetMinX(bounds), rowMaxX = CGRectGetMaxX(bounds);
+        if ( dy != 0 && lastRow > firstRow ) {
+            CGFloat y0 = MAX(minY + (CGFloat)row * grid->cellHeight, CGRectGetMinY(bounds));
+            CGFloat y1 = MIN(minY + (CGFloat)(row + 1) * grid->cellHeight, CGRectGetMaxY(bounds));
+            CGFloat x0 = segment->start.x + (y0 - segment->start.y) / dy * dx;
+            CGFloat x1 = segment->start.x + (y1 - segment->start.y) / dy * dx;
+            // widen by a cell fraction so rounding never drops a cell the segment grazes
+            CGFloat slack = grid->cellWidth * kSegmentParameterTolerance;
+            rowMinX = MAX(MIN(x0, x1) - slack, CGRectGetMinX(bounds));
+            rowMaxX = MIN(MAX(x0, x1) + slack, CGRectGetMaxX(bounds));
+        }
+        size_t firstColumn = gridCellIndex(rowMinX - minX, grid->cellWidth, grid->columns);
+        size_t lastColumn = gridCellIndex(rowMaxX - minX, grid->cellWidth, grid->columns);
+        for ( size_t column = firstColumn; column <= lastColumn; column++ ) {
+            visit(row * grid->columns + column, context);
+        }
+    }
+}
+
+static void countSegmentInCell(size_t cell, void *context) {
+    SegmentGrid *grid = (SegmentGrid*)context;
+    grid->cellStarts[cell + 1]++;
+}
+
+typedef struct {
+    SegmentGrid *grid;
+    size_t *cellFill;
+    size_t segment;
+} GridFill;
+
+static void fillSegmentInCell(size_t cell, void *context) {
+    GridFill *fill = (GridFill*)context;
+    fill->grid->cellSegments[fill->cellFill[cell]++] = fill->segment;
+}
+
+typedef struct {
+    SegmentGrid *grid;
+    const CGPathSegments *segments;
+    size_t *tested;
+    const CGPathSegment *otherSegment;
+    CGRect otherSegmentBounds;
+    size_t otherIndex;
+    CGPathIntersections *intersections;
+} GridQuery;
+
+static void intersectSegmentsInCell(size_t cell, void *context) {
+    GridQuery *query = (GridQuery*)context;
+    SegmentGrid *grid = query->grid;
+    for ( size_t k = grid->cellStarts[cell]; k < grid->cellStarts[cell + 1]; k++ ) {
+        size_t i = grid->cellSegments[k];
+        if ( query->tested[i] == query->otherIndex ) {
+            continue;
+        }
+        query->tested[i] = query->otherIndex;
+        if ( rectsTouch(segmentBounds(&query->segments->array[i]), query->otherSegmentBounds) ) {
+            intersectSegments(&query->segments->array[i], i, query->otherSegment, query->otherIndex, query->intersections);
+        }
+    }
+}
+
+void CGPathSegmentsIntersections(const CGPathSegments *segments, const CGPathSegments *otherSegments, CGPathIntersections *intersections) {
+    if ( segments->used == 0 || otherSegments->used == 0 ) {
+        return;
+    }
+    CGRect bounds = segmentsBounds(segments), otherBounds = segmentsBounds(otherSegments);
+    if ( !rectsTouch(bounds, otherBounds) ) {
+        return;
+    }
+    // the grid only needs to cover the region both sets of segments share
+    CGRect overlap = CGRectMake(MAX(CGRectGetMinX(bounds), CGRectGetMinX(otherBounds)), MAX(CGRectGetMinY(bounds), CGRectGetMinY(otherBounds)), 0, 0);
+    overlap.size.width = MIN(CGRectGetMaxX(bounds), CGRectGetMaxX(otherBounds)) - overlap.origin.x;
+    overlap.size.height = MIN(CGRectGetMaxY(bounds), CGRectGetMaxY(otherBounds)) - overlap.origin.y;
+
+    size_t noCandidates = 0, noOtherCandidates = 0;
+    for ( size_t i = 0; i < segments->used; i++ ) {
+        noCandidates += rectsTouch(segmentBounds(&segments->array[i]), overlap) ? 1 : 0;
+    }
+    for ( size_t j = 0; j < otherSegments->used; j++ ) {
+        noOtherCandidates += rectsTouch(segmentBounds(&otherSegments->array[j]), overlap) ? 1 : 0;
+    }
+    if ( noCandidates == 0 || noOtherCandidates == 0 ) {
+        return;
+    }
+
+    // about one segment per cell, split along the overlap's aspect ratio
+    SegmentGrid grid;
+    grid.bounds = overlap;
+    CGFloat side = ceil(sqrt((CGFloat)(noCandidates + noOtherCandidates)));
+    CGFloat aspect = overlap.size.height > 0 && overlap.size.width > 0 ? sqrt(overlap.size.width / overlap.size.height) : 1;
+    CGFloat columns = overlap.size.width > 0 ? ceil(side * aspect) : 1;
+    CGFloat rows = overlap.size.height > 0 ? ceil(side / aspect) : 1;
+    grid.columns = (size_t)MAX(MIN(columns, (CGFloat)kMaxGridCellsPerSide), 1);
+    grid.rows = (size_t)MAX(MIN(rows, (CGFloat)kMaxGridCellsPerSide), 1);
+    grid.cellWidth = overlap.size.width / (CGFloat)grid.columns;
+    grid.cellHeight = overlap.size.height / (CGFloat)grid.rows;
+
+    // bin the first set of segments with a counting pass then a filling pass
+    size_t noCells = grid.rows * grid.columns;
+    grid.cellStarts = (size_t*)calloc(noCells + 1, sizeof(size_t));
+    for ( size_t i = 0; i < segments->used; i++ ) {
+        if ( rectsTouch(segmentBounds(&segments->array[i]), overlap) ) {
+            visitSegmentCells(&grid, &segments->array[i], countSegmentInCell, &grid);
+        }
+    }
+    for ( size_t cell = 0; cell < noCells; cell++ ) {
+        grid.cellStarts[cell + 1] += grid.cellStarts[cell];
+    }
+    grid.cellSegments = (size_t*)malloc(MAX(grid.cellStarts[noCells], 1) * sizeof(size_t));
+    GridFill fill = { &grid, (size_t*)malloc(noCells * sizeof(size_t)), 0 };
+    memcpy(fill.cellFill, grid.cellStarts, noCells * sizeof(size_t));
+    for ( size_t i = 0; i < segments->used; i++ ) {
+        if ( rectsTouch(segmentBounds(&segments->array[i]), overlap) ) {
+            fill.segment = i;
+            visitSegmentCells(&grid, &segments->array[i], fillSegmentInCell, &fill);
+        }
+    }
+    free(fill.cellFill);
+
+    // walk each other segment through the grid, a segment pair can share several cells so the last other
+    // segment each segment was tested against is stamped to test every pair once
+    size_t *tested = (size_t*)malloc(segments->used * sizeof(size_t));
+    for ( size_t i = 0; i < segments->used; i++ ) {
+        tested[i] = SIZE_MAX;
+    }
+    size_t firstIntersection = intersections->used;
+    GridQuery query = { &grid, segments, tested, NULL, CGRectNull, 0, intersections };
+    for ( size_t j = 0; j < otherSegments->used; j++ ) {
+        query.otherSegment = &otherSegments->array[j];
+        query.otherSegmentBounds = segmentBounds(query.otherSegment);
+        query.otherIndex = j;
+        if ( rectsTouch(query.otherSegmentBounds, overlap) ) {
+            visitSegmentCells(&grid, query.otherSegment, intersectSegmentsInCell, &query);
+        }
+    }
+    free(tested);
+    free(grid.cellStarts);
+    free(grid.cellSegments);
+
+    // a hit on a vertex is found by every segment meeting there, keep the one from the lowest segments
+    size_t noFound = intersections->used - firstIntersection;
+    if ( noFound > 1 ) {
+        CGPathIntersection *found = intersections->array + firstIntersection;
+        qsort(found, noFound, sizeof(CGPathIntersection), compareIntersectionPoints);
+        size_t kept = 1;
+        for ( size_t k = 1; k < noFound; k++ ) {
+            if ( !CGPointEqualToPoint(found[k].point, found[kept - 1].point) ) {
+                found[kept++] = found[k];
+            }
+        }
+        qsort(found, kept, sizeof(CGPathIntersection), compareIntersectionSegments);
+        intersections->used = firstIntersection + kept;
+    }
+}
+
+void CGPathIntersectionsWithOther(CGPathRef path, CGPathRef otherPath, CGPathIntersections *intersections) {
+    CGPathSegments segments, otherSegments;
+    initCGPathSegments(&segments, 64);
+    initCGPathSegments(&otherSegments, 64);
+    CGPathAppendFlattenedSegments(path, CGPathSegmentsDefaultFlatness, &segments);
+    CGPathAppendFlattenedSegments(otherPath, CGPathSegmentsDefaultFlatness, &otherSegments);
+    CGPathSegmentsIntersections(&segments, &otherSegments, intersections);
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+}
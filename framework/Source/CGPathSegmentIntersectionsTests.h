@@ -0,0 +1,5 @@
+#import "CPTTestCase.h"
+
+@interface CGPathSegmentIntersectionsTests : CPTTestCase
+
+@end
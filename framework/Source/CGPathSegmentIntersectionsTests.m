@@ -0,0 +1,204 @@
+#import "CGPathSegmentIntersectionsTests.h"
+
+#import "CGPathIntersections/CGPathSegmentIntersections.h"
+
+@interface CGPathSegmentIntersectionsTests()
+
+-(void)appendPolylineWithPoints:(nonnull const CGPoint *)points count:(size_t)count toSegments:(nonnull CGPathSegments *)segments;
+
+@end
+
+#pragma mark -
+
+@implementation CGPathSegmentIntersectionsTests
+
+-(void)appendPolylineWithPoints:(nonnull const CGPoint *)points count:(size_t)count toSegments:(nonnull CGPathSegments *)segments
+{
+    CGMutablePathRef path = CGPathCreateMutable();
+
+    CGPathAddLines(path, NULL, points, count);
+    CGPathAppendFlattenedSegments(path, CGPathSegmentsDefaultFlatness, segments);
+    CGPathRelease(path);
+}
+
+#pragma mark -
+#pragma mark Lines
+
+-(void)testCrossingLines
+{
+    CGPoint line[]      = { { 0.0, 0.0 }, { 10.0, 10.0 } };
+    CGPoint otherLine[] = { { 0.0, 10.0 }, { 10.0, 0.0 } };
+
+    CGPathSegments segments, otherSegments;
+    CGPathIntersections intersections;
+
+    initCGPathSegments(&segments, 4);
+    initCGPathSegments(&otherSegments, 4);
+    initCGPathIntersections(&intersections, 4);
+
+    [self appendPolylineWithPoints:line count:2 toSegments:&segments];
+    [self appendPolylineWithPoints:otherLine count:2 toSegments:&otherSegments];
+    CGPathSegmentsIntersections(&segments, &otherSegments, &intersections);
+
+    XCTAssertEqual(intersections.used, (size_t)1);
+    XCTAssertEqualWithAccuracy(intersections.array[0].point.x, 5.0, 1.0e-9);
+    XCTAssertEqualWithAccuracy(intersections.array[0].point.y, 5.0, 1.0e-9);
+    XCTAssertEqual(intersections.array[0].segment, (size_t)0);
+    XCTAssertEqual(intersections.array[0].otherSegment, (size_t)0);
+
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+    freeCGPathIntersections(&intersections);
+}
+
+-(void)testSharedVertexReportedOnce
+{
+    // the other line passes through the vertex joining the two segments, both of which find it
+    CGPoint polyline[]  = { { 0.0, 0.0 }, { 5.0, 5.0 }, { 10.0, 0.0 } };
+    CGPoint otherLine[] = { { 5.0, 0.0 }, { 5.0, 10.0 } };
+
+    CGPathSegments segments, otherSegments;
+    CGPathIntersections intersections;
+
+    initCGPathSegments(&segments, 4);
+    initCGPathSegments(&otherSegments, 4);
+    initCGPathIntersections(&intersections, 4);
+
+    [self appendPolylineWithPoints:polyline count:3 toSegments:&segments];
+    [self appendPolylineWithPoints:otherLine count:2 toSegments:&otherSegments];
+    CGPathSegmentsIntersections(&segments, &otherSegments, &intersections);
+
+    XCTAssertEqual(segments.used, (size_t)2);
+    XCTAssertEqual(intersections.used, (size_t)1, @"vertex reported once");
+    XCTAssertEqual(intersections.array[0].point.x, 5.0);
+    XCTAssertEqual(intersections.array[0].point.y, 5.0);
+    XCTAssertEqual(intersections.array[0].segment, (size_t)0, @"kept from the lower segment");
+
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+    freeCGPathIntersections(&intersections);
+}
+
+-(void)testCollinearOverlap
+{
+    CGPoint line[]      = { { 0.0, 0.0 }, { 10.0, 0.0 } };
+    CGPoint otherLine[] = { { 5.0, 0.0 }, { 15.0, 0.0 } };
+
+    CGPathSegments segments, otherSegments;
+    CGPathIntersections intersections;
+
+    initCGPathSegments(&segments, 4);
+    initCGPathSegments(&otherSegments, 4);
+    initCGPathIntersections(&intersections, 4);
+
+    [self appendPolylineWithPoints:line count:2 toSegments:&segments];
+    [self appendPolylineWithPoints:otherLine count:2 toSegments:&otherSegments];
+    CGPathSegmentsIntersections(&segments, &otherSegments, &intersections);
+
+    XCTAssertEqual(intersections.used, (size_t)2, @"both ends of the overlap");
+    XCTAssertEqual(intersections.array[0].point.x, 5.0);
+    XCTAssertEqual(intersections.array[0].point.y, 0.0);
+    XCTAssertEqual(intersections.array[1].point.x, 10.0);
+    XCTAssertEqual(intersections.array[1].point.y, 0.0);
+
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+    freeCGPathIntersections(&intersections);
+}
+
+-(void)testDisjointBoundingBoxes
+{
+    CGPoint line[]      = { { 0.0, 0.0 }, { 1.0, 1.0 } };
+    CGPoint otherLine[] = { { 5.0, 6.0 }, { 6.0, 5.0 } };
+
+    CGPathSegments segments, otherSegments;
+    CGPathIntersections intersections;
+
+    initCGPathSegments(&segments, 4);
+    initCGPathSegments(&otherSegments, 4);
+    initCGPathIntersections(&intersections, 4);
+
+    [self appendPolylineWithPoints:line count:2 toSegments:&segments];
+    [self appendPolylineWithPoints:otherLine count:2 toSegments:&otherSegments];
+    CGPathSegmentsIntersections(&segments, &otherSegments, &intersections);
+
+    XCTAssertEqual(intersections.used, (size_t)0);
+
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+    freeCGPathIntersections(&intersections);
+}
+
+-(void)testSegmentIndices
+{
+    // the other path crosses the second segment first, then the first
+    CGPoint polyline[]      = { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 } };
+    CGPoint otherPolyline[] = { { 15.0, 5.0 }, { 5.0, 5.0 }, { 5.0, -5.0 } };
+
+    CGPathSegments segments, otherSegments;
+    CGPathIntersections intersections;
+
+    initCGPathSegments(&segments, 4);
+    initCGPathSegments(&otherSegments, 4);
+    initCGPathIntersections(&intersections, 4);
+
+    [self appendPolylineWithPoints:polyline count:4 toSegments:&segments];
+    [self appendPolylineWithPoints:otherPolyline count:3 toSegments:&otherSegments];
+    CGPathSegmentsIntersections(&segments, &otherSegments, &intersections);
+
+    XCTAssertEqual(intersections.used, (size_t)2);
+
+    // ordered by the segment of the first path
+    XCTAssertEqual(intersections.array[0].segment, (size_t)0);
+    XCTAssertEqual(intersections.array[0].otherSegment, (size_t)1);
+    XCTAssertEqual(intersections.array[0].point.x, 5.0);
+    XCTAssertEqual(intersections.array[0].point.y, 0.0);
+
+    XCTAssertEqual(intersections.array[1].segment, (size_t)1);
+    XCTAssertEqual(intersections.array[1].otherSegment, (size_t)0);
+    XCTAssertEqual(intersections.array[1].point.x, 10.0);
+    XCTAssertEqual(intersections.array[1].point.y, 5.0);
+
+    freeCGPathSegments(&segments);
+    freeCGPathSegments(&otherSegments);
+    freeCGPathIntersections(&intersections);
+}
+
+#pragma mark -
+#pragma mark Curves
+
+-(void)testCurveCrossingLine
+{
+    // y = 20t(1 - t) and x = 10t, which meets y = 2.5 where t = (1 ± √½) / 2
+    CGMutablePathRef curve = CGPathCreateMutable();
+
+    CGPathMoveToPoint(curve, NULL, 0.0, 0.0);
+    CGPathAddQuadCurveToPoint(curve, NULL, 5.0, 10.0, 10.0, 0.0);
+
+    CGMutablePathRef line = CGPathCreateMutable();
+
+    CGPathMoveToPoint(line, NULL, -1.0, 2.5);
+    CGPathAddLineToPoint(line, NULL, 11.0, 2.5);
+
+    CGPathIntersections intersections;
+
+    initCGPathIntersections(&intersections, 4);
+    CGPathIntersectionsWithOther(curve, line, &intersections);
+
+    XCTAssertEqual(intersections.used, (size_t)2);
+    if ( intersections.used == 2 ) {
+        CGFloat flatness = CGPathSegmentsDefaultFlatness;
+
+        XCTAssertEqualWithAccuracy(intersections.array[0].point.x, 5.0 * (1.0 - sqrt(0.5)), flatness);
+        XCTAssertEqualWithAccuracy(intersections.array[0].point.y, 2.5, 1.0e-9);
+        XCTAssertEqualWithAccuracy(intersections.array[1].point.x, 5.0 * (1.0 + sqrt(0.5)), flatness);
+        XCTAssertEqualWithAccuracy(intersections.array[1].point.y, 2.5, 1.0e-9);
+        XCTAssertLessThan(intersections.array[0].segment, intersections.array[1].segment);
+    }
+
+    freeCGPathIntersections(&intersections);
+    CGPathRelease(curve);
+    CGPathRelease(line);
+}
+
+@end
@@ -13,6 +13,7 @@
 #import "CPTUtilities.h"
 #import "CPTXYPlotSpace.h"
 #import "NSCoderExtensions.h"
+#import "_CPTSpatialIndex.h"
 #import <tgmath.h>
 
 /** @defgroup plotAnimationBarPlot Bar Plot
@@ -48,10 +49,13 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
 -(BOOL)barAtRecordIndex:(NSUInteger)idx basePoint:(nonnull CGPoint *)basePoint tipPoint:(nonnull CGPoint *)tipPoint;
 -(nullable CGMutablePathRef)newBarPathWithContext:(nullable CGContextRef)context recordIndex:(NSUInteger)recordIndex;
 -(nonnull CGMutablePathRef)newBarPathWithContext:(nullable CGContextRef)context basePoint:(CGPoint)basePoint tipPoint:(CGPoint)tipPoint width:(NSNumber *)width;
+-(CGRect)barRectWithBasePoint:(CGPoint)basePoint tipPoint:(CGPoint)tipPoint width:(nonnull NSNumber *)width;
 -(nullable CPTFill *)barFillForIndex:(NSUInteger)idx;
 -(nullable CPTLineStyle *)barLineStyleForIndex:(NSUInteger)idx;
 -(nonnull NSNumber *)barWidthForIndex:(NSUInteger)idx;
 -(void)drawBarInContext:(nonnull CGContextRef)context recordIndex:(NSUInteger)idx;
+-(void)drawBarInContext:(nonnull CGContextRef)context recordIndex:(NSUInteger)idx basePoint:(CGPoint)basePoint tipPoint:(CGPoint)tipPoint;
+-(void)calculateBasePoints:(nonnull CGPoint *)basePoints tipPoints:(nonnull CGPoint *)tipPoints barExistsFlags:(nonnull BOOL *)barExistsFlags numberOfBars:(NSUInteger)barCount;
 
 -(CGFloat)lengthInView:(NSDecimal)plotLength;
 -(double)doubleLengthInPlotCoordinates:(NSDecimal)decimalLength;
@@ -909,14 +913,92 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
 
     CGContextBeginTransparencyLayer(context, NULL);
 
-    for ( NSUInteger ii = 0; ii < barCount; ii++ ) {
-        // Draw
-        [self drawBarInContext:context recordIndex:ii];
+    if ( self.doublePrecisionCache ) {
+        CGPoint *basePoints  = calloc(barCount, sizeof(CGPoint));
+        CGPoint *tipPoints   = calloc(barCount, sizeof(CGPoint));
+        BOOL *barExistsFlags = calloc(barCount, sizeof(BOOL));
+
+        [self calculateBasePoints:basePoints tipPoints:tipPoints barExistsFlags:barExistsFlags numberOfBars:barCount];
+
+        for ( NSUInteger ii = 0; ii < barCount; ii++ ) {
+            if ( barExistsFlags[ii] ) {
+                // Draw
+                [self drawBarInContext:context recordIndex:ii basePoint:basePoints[ii] tipPoint:tipPoints[ii]];
+            }
+        }
+
+        free(basePoints);
+        free(tipPoints);
+        free(barExistsFlags);
+    }
+    else {
+        for ( NSUInteger ii = 0; ii < barCount; ii++ ) {
+            // Draw
+            [self drawBarInContext:context recordIndex:ii];
+        }
     }
 
     CGContextEndTransparencyLayer(context);
 }
 
+/** @internal
+ *  @brief Calculates the base and tip points of every bar in one pass over the double-precision cache.
+ *  @param basePoints     A c-style array that receives the base point of each bar.
+ *  @param tipPoints      A c-style array that receives the tip point of each bar.
+ *  @param barExistsFlags A c-style array that receives @YES for each bar with a valid location, tip, and base.
+ *  @param barCount       The number of bars.
+ **/
+-(void)calculateBasePoints:(nonnull CGPoint *)basePoints tipPoints:(nonnull CGPoint *)tipPoints barExistsFlags:(nonnull BOOL *)barExistsFlags numberOfBars:(NSUInteger)barCount
+{
+    BOOL horizontalBars        = self.barsAreHorizontal;
+    CPTPlotSpace *thePlotSpace = self.plotSpace;
+
+    const double *locationBytes = (const double *)[self cachedNumbersForField:CPTBarPlotFieldBarLocation].data.bytes;
+    const double *tipBytes      = (const double *)[self cachedNumbersForField:CPTBarPlotFieldBarTip].data.bytes;
+    const double *baseBytes     = NULL;
+    double *constantBaseBytes   = NULL;
+
+    if ( self.barBasesVary ) {
+        baseBytes = (const double *)[self cachedNumbersForField:CPTBarPlotFieldBarBase].data.bytes;
+    }
+    else {
+        double theBaseValue = self.baseValue.doubleValue;
+
+        constantBaseBytes = calloc(barCount, sizeof(double));
+        for ( NSUInteger i = 0; i < barCount; i++ ) {
+            constantBaseBytes[i] = theBaseValue;
+        }
+        baseBytes = constantBaseBytes;
+    }
+
+    if ( horizontalBars ) {
+        [thePlotSpace plotAreaViewPoints:tipPoints forDoublePrecisionXValues:tipBytes yValues:locationBytes numberOfPoints:barCount];
+        [thePlotSpace plotAreaViewPoints:basePoints forDoublePrecisionXValues:baseBytes yValues:locationBytes numberOfPoints:barCount];
+    }
+    else {
+        [thePlotSpace plotAreaViewPoints:tipPoints forDoublePrecisionXValues:locationBytes yValues:tipBytes numberOfPoints:barCount];
+        [thePlotSpace plotAreaViewPoints:basePoints forDoublePrecisionXValues:locationBytes yValues:baseBytes numberOfPoints:barCount];
+    }
+
+    // Offset
+    CGFloat barOffsetLength = [self lengthInView:self.barOffset.decimalValue];
+
+    for ( NSUInteger i = 0; i < barCount; i++ ) {
+        barExistsFlags[i] = !isnan(locationBytes[i]) && !isnan(tipBytes[i]) && !isnan(baseBytes[i]);
+
+        if ( horizontalBars ) {
+            basePoints[i].y += barOffsetLength;
+            tipPoints[i].y  += barOffsetLength;
+        }
+        else {
+            basePoints[i].x += barOffsetLength;
+            tipPoints[i].x  += barOffsetLength;
+        }
+    }
+
+    free(constantBaseBytes);
+}
+
 -(BOOL)barAtRecordIndex:(NSUInteger)idx basePoint:(nonnull CGPoint *)basePoint tipPoint:(nonnull CGPoint *)tipPoint
 {
     BOOL horizontalBars            = self.barsAreHorizontal;
@@ -1020,17 +1102,7 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
     // drawing a bar and for doing hit-testing on a click/touch event
     BOOL horizontalBars = self.barsAreHorizontal;
 
-    CGFloat barWidthLength = [self lengthInView:width.decimalValue];
-    CGFloat halfBarWidth   = CPTFloat(0.5) * barWidthLength;
-
-    CGRect barRect;
-
-    if ( horizontalBars ) {
-        barRect = CPTRectMake(basePoint.x, basePoint.y - halfBarWidth, tipPoint.x - basePoint.x, barWidthLength);
-    }
-    else {
-        barRect = CPTRectMake(basePoint.x - halfBarWidth, basePoint.y, barWidthLength, tipPoint.y - basePoint.y);
-    }
+    CGRect barRect = [self barRectWithBasePoint:basePoint tipPoint:tipPoint width:width];
 
     int widthNegative  = signbit(barRect.size.width);
     int heightNegative = signbit(barRect.size.height);
@@ -1138,6 +1210,20 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
     return path;
 }
 
+// The bar rectangle before pixel alignment and corner rounding, with a negative size when the tip is below or left of the base
+-(CGRect)barRectWithBasePoint:(CGPoint)basePoint tipPoint:(CGPoint)tipPoint width:(nonnull NSNumber *)width
+{
+    CGFloat barWidthLength = [self lengthInView:width.decimalValue];
+    CGFloat halfBarWidth   = CPTFloat(0.5) * barWidthLength;
+
+    if ( self.barsAreHorizontal ) {
+        return CPTRectMake(basePoint.x, basePoint.y - halfBarWidth, tipPoint.x - basePoint.x, barWidthLength);
+    }
+    else {
+        return CPTRectMake(basePoint.x - halfBarWidth, basePoint.y, barWidthLength, tipPoint.y - basePoint.y);
+    }
+}
+
 -(BOOL)barIsVisibleWithBasePoint:(CGPoint)basePoint width:(NSNumber *)width
 {
     BOOL horizontalBars    = self.barsAreHorizontal;
@@ -1196,6 +1282,11 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
         return;
     }
 
+    [self drawBarInContext:context recordIndex:idx basePoint:basePoint tipPoint:tipPoint];
+}
+
+-(void)drawBarInContext:(nonnull CGContextRef)context recordIndex:(NSUInteger)idx basePoint:(CGPoint)basePoint tipPoint:(CGPoint)tipPoint
+{
     NSNumber *width = [self barWidthForIndex:idx];
 
     // Return if bar is off screen
@@ -1430,23 +1521,37 @@ CPTBarPlotBinding const CPTBarPlotBindingBarWidths     = @"barWidths";     ///<
 
 -(NSUInteger)dataIndexFromInteractionPoint:(CGPoint)point
 {
-    NSUInteger idx      = NSNotFound;
-    NSUInteger barCount = self.cachedDataCount;
-    NSUInteger ii       = 0;
+    // Only the bars whose bounding rectangle contains the point need the exact path test
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        NSUInteger barCount  = self.cachedDataCount;
+        CGRect *barRects     = calloc(barCount, sizeof(CGRect));
+        BOOL *barExistsFlags = calloc(barCount, sizeof(BOOL));
+
+        for ( NSUInteger ii = 0; ii < barCount; ii++ ) {
+            CGPoint basePoint, tipPoint;
+            barExistsFlags[ii] = [self barAtRecordIndex:ii basePoint:&basePoint tipPoint:&tipPoint];
+
+            if ( barExistsFlags[ii] ) {
+                barRects[ii] = [self barRectWithBasePoint:basePoint tipPoint:tipPoint width:[self barWidthForIndex:ii]];
+            }
+        }
 
-    while ((ii < barCount) && (idx == NSNotFound)) {
-        CGMutablePathRef path = [self newBarPathWithContext:NULL recordIndex:ii];
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithRects:barRects flags:barExistsFlags count:barCount];
 
-        if ( CGPathContainsPoint(path, NULL, point, false)) {
-            idx = ii;
-        }
+        free(barRects);
+        free(barExistsFlags);
 
-        CGPathRelease(path);
+        return newIndex;
+    }];
 
-        ii++;
-    }
+    return [theIndex lowestIndexOfItemContainingPoint:point passingTest:^BOOL (NSUInteger idx) {
+        CGMutablePathRef path = [self newBarPathWithContext:NULL recordIndex:idx];
+        BOOL containsPoint = path && CGPathContainsPoint(path, NULL, point, false);
+
+        CGPathRelease(path);
 
-    return idx;
+        return containsPoint;
+    }];
 }
 
 /// @endcond
@@ -358,6 +358,7 @@ double TestFunction(double x,double y);
 @property (nonatomic, readwrite, assign) BOOL extrapolateToLimits;
 @property (nonatomic, readwrite, assign) BOOL fillIsoCurves;
 @property (nonatomic, readwrite, assign) BOOL joinContourLineStartToEnd;
+@property (nonatomic, readwrite, assign) BOOL concurrentGeneration;
 @property (nonatomic, readwrite, assign) double scaleX;
 @property (nonatomic, readwrite, assign) double scaleY;
 /// @}
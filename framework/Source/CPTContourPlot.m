@@ -50,6 +50,9 @@
 #import "CPTFieldFunctionDataSource.h"
 #import "_CPTContours.h"
 #import "_CPTHull.h"
+#import "_CPTSpatialIndex.h"
+#import "_CPTRangeClassification.h"
+#import "_CPTScratchArena.h"
 #import "_CPTContourMemoryManagement.h"
 #import "_CPTContourEnumerations.h"
 #import "_CPTContourGraph.h"
@@ -473,6 +476,15 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 
 /// @cond
 
+@interface CPTPlot()
+
+// private CPTPlot methods
+@property (nonatomic, readwrite, assign) BOOL isRenderSnapshot;
+
+-(nonnull CPTPlot *)renderSnapshot;
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot;
+
+@end
 
 @interface CPTContourPlot()
 
@@ -519,6 +531,14 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 @property (nonatomic, readwrite, strong, nullable) CPTMutableNumberArray *previousLimits;
 @property (nonatomic, readwrite, assign) BOOL firstRendition;
 @property (nonatomic, readwrite, assign) BOOL previousFillIsoCurves;
+@property (nonatomic, readonly, nonnull) NSString *planesCacheFilePath;
+@property (nonatomic, readwrite, copy, nullable) NSString *planesCacheSourcePath;
+@property (nonatomic, readwrite, assign) NSUInteger isoCurvesUpdateRequestCount;
+@property (nonatomic, readwrite, assign) NSUInteger fieldBlockGeneration;
+@property (nonatomic, readwrite, assign) BOOL generatedIsoCurves;
+@property (nonatomic, readwrite, strong, nullable) CPTLineStyleArray *loadedIsoCurvesLineStyles;
+@property (nonatomic, readwrite, strong, nullable) CPTFillArray *loadedIsoCurvesFills;
+@property (nonatomic, readwrite, assign) CGFloat isoCurvesImageScale;
 @property (nonatomic, readwrite, assign) CGPoint originOfContext;
 @property (nonatomic, readwrite, assign) CGFloat scaleOfContext;
 #if TARGET_OS_OSX
@@ -533,6 +553,12 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 
 -(CPTLineStyle *)isoCurveLineStyleForIndex:(NSUInteger)idx;
 
+-(BOOL)loadContourLineStylesInIsoCurveIndexRange:(NSRange)indexRange isoCurveIndices:(nullable CPTNumberArray *)curveIndices intoLineStyles:(nullable CPTMutableLineStyleArray *)lineStyles;
+-(void)loadContourFillsInIsoCurveIndexRange:(NSRange)indexRange isoCurveIndices:(nullable CPTNumberArray *)curveIndices intoFills:(nullable CPTMutableFillArray *)fills;
+-(void)replaceObjectsInArray:(nullable NSMutableArray *)objects withObjectsFromArray:(nullable NSArray *)loadedObjects inIsoCurveIndexRange:(NSRange)indexRange;
+-(BOOL)needsIsoCurvesGenerationForPlotSpace:(nullable CPTXYPlotSpace *)thePlotSpace;
+-(nonnull NSString *)imageFilePathForPlanesFilePath:(nonnull NSString *)planesFilePath;
+
 @end
 
 /// @endcond
@@ -842,6 +868,14 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
  **/
 @synthesize joinContourLineStartToEnd;
 
+/** @property BOOL concurrentGeneration
+ *  @brief flag to indicate whether the contours are generated concurrently. The field is then evaluated
+ *  at every node of the secondary grid on several threads and each isocurve is traced on its own thread,
+ *  so the dataSourceBlock must be safe to call from any thread.
+ *    default is NO
+ **/
+@synthesize concurrentGeneration;
+
 
 @synthesize stepX;
 @synthesize stepY;
@@ -888,6 +922,51 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
  **/
 @synthesize previousFillIsoCurves;
 
+/** @property NSString *planesCacheFilePath
+ *  @brief temporary file caching this plot's generated contour planes, unique to the plot
+ *  so that several contour plots do not overwrite each other's planes
+ **/
+@synthesize planesCacheFilePath;
+
+/** @property NSString *planesCacheSourcePath
+ *  @brief planes cache file of the plot a render snapshot was taken from
+ *  the snapshot reads the plot's cache files and writes its own, which the plot takes over when the frame is shown
+ **/
+@synthesize planesCacheSourcePath;
+
+/** @property NSUInteger isoCurvesUpdateRequestCount
+ *  @brief number of times the iso-curves were asked to update
+ *  tells whether a render snapshot's iso-curves were outdated before its frame was shown
+ **/
+@synthesize isoCurvesUpdateRequestCount;
+
+/** @property NSUInteger fieldBlockGeneration
+ *  @brief number of times the dataSourceBlock was changed
+ *  stored in the planes cache file, so planes generated from an earlier block are never read back
+ **/
+@synthesize fieldBlockGeneration;
+
+/** @property BOOL generatedIsoCurves
+ *  @brief whether a render snapshot generated the iso-curves while it was drawn
+ **/
+@synthesize generatedIsoCurves;
+
+/** @property CPTLineStyleArray *loadedIsoCurvesLineStyles
+ *  @brief line styles of every iso-curve, loaded from the data source for a render snapshot
+ **/
+@synthesize loadedIsoCurvesLineStyles;
+
+/** @property CPTFillArray *loadedIsoCurvesFills
+ *  @brief fills between every iso-curve, loaded from the data source for a render snapshot
+ **/
+@synthesize loadedIsoCurvesFills;
+
+/** @property CGFloat isoCurvesImageScale
+ *  @brief scale the cached iso-curves image is drawn at
+ *  worked out on the main thread for a render snapshot, as the screen cannot be queried from the render queue
+ **/
+@synthesize isoCurvesImageScale;
+
 /** @property CGPoint originOfContext
  *  @brief origin point of  current Drawing context
  *    default is CGPointZero
@@ -981,26 +1060,58 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
     if ( (self = [super initWithLayer:layer]) ) {
         CPTContourPlot *theLayer = (CPTContourPlot*)layer;
         
-        needsIsoCurvesUpdate = YES;
+        // the copy works on iso-curve arrays of its own, so drawing or deallocating it leaves the plot's alone
+        needsIsoCurvesUpdate = theLayer->needsIsoCurvesUpdate;
+        isoCurvesUpdateRequestCount = theLayer->isoCurvesUpdateRequestCount;
+        fieldBlockGeneration = theLayer->fieldBlockGeneration;
 
         plotSymbol              = theLayer->plotSymbol;
-        isoCurvesIndices        = theLayer->isoCurvesIndices;
-        isoCurvesValues          = theLayer->isoCurvesValues;
+        isoCurvesIndices        = [theLayer->isoCurvesIndices mutableCopy];
+        isoCurvesValues          = [theLayer->isoCurvesValues mutableCopy];
         isoCurveLineStyle        = theLayer->isoCurveLineStyle;
-        isoCurvesFills           = theLayer->isoCurvesFills;
-        isoCurvesFillings        = theLayer->isoCurvesFillings;
-        isoCurvesLabels          = theLayer->isoCurvesLabels;
-        isoCurvesLabelAnnotations = theLayer->isoCurvesLabelAnnotations;
-        isoCurvesLabelsPositions = theLayer->isoCurvesLabelsPositions;
-        isoCurvesLabelsRotations = theLayer->isoCurvesLabelsRotations;
-        isoCurvesNoStrips        = theLayer->isoCurvesNoStrips;
+        isoCurveFill             = theLayer->isoCurveFill;
+        isoCurvesLineStyles      = [theLayer->isoCurvesLineStyles mutableCopy];
+        isoCurvesFills           = [theLayer->isoCurvesFills mutableCopy];
+        isoCurvesFillings        = [theLayer->isoCurvesFillings mutableCopy];
+        isoCurvesLabels          = [theLayer->isoCurvesLabels mutableCopy];
+        isoCurvesLabelAnnotations = nil;
+        isoCurvesLabelsPositions = [theLayer->isoCurvesLabelsPositions mutableCopy];
+        isoCurvesLabelsRotations = [theLayer->isoCurvesLabelsRotations mutableCopy];
+        isoCurvesNoStrips        = [theLayer->isoCurvesNoStrips mutableCopy];
         
+        dataSourceBlock = theLayer->dataSourceBlock;
+        functionPlot = theLayer->functionPlot;
+        limits = [theLayer->limits mutableCopy];
+        minFunctionValue = theLayer->minFunctionValue;
+        maxFunctionValue = theLayer->maxFunctionValue;
+        interpolation = theLayer->interpolation;
+        curvedInterpolationOption = theLayer->curvedInterpolationOption;
+        curvedInterpolationCustomAlpha = theLayer->curvedInterpolationCustomAlpha;
+        easyOnTheEye = theLayer->easyOnTheEye;
+        extrapolateToLimits = theLayer->extrapolateToLimits;
+        fillIsoCurves = theLayer->fillIsoCurves;
+        joinContourLineStartToEnd = theLayer->joinContourLineStartToEnd;
+        concurrentGeneration = theLayer->concurrentGeneration;
+
         noIsoCurves = theLayer->noIsoCurves;
+        noActualIsoCurves = theLayer->noActualIsoCurves;
         noColumnsFirst = theLayer->noColumnsFirst;
         noRowsFirst = theLayer->noRowsFirst;
         noColumnsSecondary = theLayer->noColumnsSecondary;
         noRowsSecondary = theLayer->noRowsSecondary;
-        firstRendition = YES;
+        firstRendition = theLayer->firstRendition;
+        previousFillIsoCurves = theLayer->previousFillIsoCurves;
+        initialXRange = theLayer->initialXRange;
+        initialYRange = theLayer->initialYRange;
+        previousLimits = [theLayer->previousLimits mutableCopy];
+        greatestContourBox = theLayer->greatestContourBox;
+        maxWidthPixels = theLayer->maxWidthPixels;
+        maxHeightPixels = theLayer->maxHeightPixels;
+        scaleX = theLayer->scaleX;
+        scaleY = theLayer->scaleY;
+        originOfContext = theLayer->originOfContext;
+        scaleOfContext = theLayer->scaleOfContext;
+        planesCacheSourcePath = theLayer->planesCacheSourcePath ?: theLayer->planesCacheFilePath;
 
         plotSymbolMarginForHitDetection = theLayer->plotSymbolMarginForHitDetection;
         plotLineMarginForHitDetection   = theLayer->plotLineMarginForHitDetection;
@@ -1013,6 +1124,11 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 - (void)dealloc {
     [self clearOut];
     
+    if ( planesCacheFilePath != nil ) {
+        [[NSFileManager defaultManager] removeItemAtPath:planesCacheFilePath error:NULL];
+        [[NSFileManager defaultManager] removeItemAtPath:[self imageFilePathForPlanesFilePath:planesCacheFilePath] error:NULL];
+    }
+    
     if(self.isoCurvesIndices != nil) {
         [self.isoCurvesIndices removeAllObjects];
         self.isoCurvesIndices = nil;
@@ -1155,10 +1271,6 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         return;
     }
 
-    CPTPlotRangeComparisonResult *xRangeFlags = (CPTPlotRangeComparisonResult*)calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-    CPTPlotRangeComparisonResult *yRangeFlags = (CPTPlotRangeComparisonResult*)calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-    BOOL *nanFlags                            = (BOOL*)calloc(dataCount, sizeof(BOOL));
-
     CPTPlotRange *xRange = xyPlotSpace.xRange;
     CPTPlotRange *yRange = xyPlotSpace.yRange;
 
@@ -1166,46 +1278,18 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
     if ( self.doublePrecisionCache ) {
         const double *xBytes = (const double *)[self cachedNumbersForField:CPTContourPlotFieldX].data.bytes;
         const double *yBytes = (const double *)[self cachedNumbersForField:CPTContourPlotFieldY].data.bytes;
-//        const double *functionValueBytes   = (const double *)([self cachedNumbersForField:CPTContourPlotFieldFunctionValue].data.bytes);
-        
 
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x = xBytes[i];
-            const double y = yBytes[i];
-//            const double functionValue  = functionValueBytes[i];
-
-            xRangeFlags[i] = [xRange compareToDouble:x];
-            yRangeFlags[i] = [yRange compareToDouble:y];
-            nanFlags[i]    = isnan(x) || isnan(y) /*|| isnan(functionValue)*/;
-        });
+        CPTRangeClassificationFlagPoints(pointDrawFlags, xBytes, yBytes, dataCount,
+                                         CPTRangeClassificationLimitsForRange(xRange),
+                                         CPTRangeClassificationLimitsForRange(yRange),
+                                         CPTRangeClassificationExpansionNone);
     }
     else {
         const NSDecimal *xBytes = (const NSDecimal *)[self cachedNumbersForField:CPTContourPlotFieldX].data.bytes;
         const NSDecimal *yBytes = (const NSDecimal *)[self cachedNumbersForField:CPTContourPlotFieldY].data.bytes;
-//        const NSDecimal *functionValueBytes  = (const NSDecimal *)([self cachedNumbersForField:CPTContourPlotFieldFunctionValue].data.bytes);
-        
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const NSDecimal x = xBytes[i];
-            const NSDecimal y = yBytes[i];
-//            const NSDecimal functionValue  = functionValueBytes[i];
-
-            xRangeFlags[i] = [xRange compareToDecimal:x];
-            yRangeFlags[i] = [yRange compareToDecimal:y];
-            nanFlags[i]    = NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y) /*|| NSDecimalIsNotANumber(&functionValue)*/;
-        });
-    }
-
-    for ( NSUInteger i = 0; i < dataCount; i++ ) {
-        BOOL drawPoint = (xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                         (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                         !nanFlags[i];
 
-        pointDrawFlags[i] = drawPoint;
+        CPTRangeClassificationFlagDecimalPoints(pointDrawFlags, xBytes, yBytes, dataCount, xRange, yRange, CPTRangeClassificationExpansionNone);
     }
-
-    free(xRangeFlags);
-    free(yRangeFlags);
-    free(nanFlags);
 }
 
 -(void)calculateViewPoints:(nonnull CGPoint*)viewPoints withDrawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount {
@@ -1216,42 +1300,39 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         const double *xBytes     = (const double *)([self cachedNumbersForField:CPTContourPlotFieldX].data.bytes);
         const double *yBytes     = (const double *)([self cachedNumbersForField:CPTContourPlotFieldY].data.bytes);
         const double *functionValueBytes   = (const double *)([self cachedNumbersForField:CPTContourPlotFieldFunctionValue].data.bytes);
-        self.minFunctionValue = DBL_MAX;
-        self.maxFunctionValue = -DBL_MAX;
+        double minFunctionValue = DBL_MAX;
+        double maxFunctionValue = -DBL_MAX;
+        BOOL negInfinities = NO, infinities = NO;
         
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x     = xBytes[i];
-            const double y     = yBytes[i];
-            double functionValue  = functionValueBytes[i];
-            
-//            if ( isnan(functionValue) ) {
-//                functionValue = -0.0;
-//            }
+        [thePlotSpace plotAreaViewPoints:viewPoints forDoublePrecisionXValues:xBytes yValues:yBytes numberOfPoints:dataCount];
+        
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            const double functionValue = functionValueBytes[i];
             
-            if ( !drawPointFlags[i] || isnan(x) || isnan(y) || isnan(functionValue)/* functionValue == -0.0*/ ) {
+            if ( !drawPointFlags[i] || isnan(xBytes[i]) || isnan(yBytes[i]) || isnan(functionValue) ) {
                 viewPoints[i].x = (CGFloat)NAN; // depending coordinates
                 viewPoints[i].y = (CGFloat)NAN;
             }
+            else if( functionValue == -DBL_MAX || isinf(-functionValue) ) {
+                negInfinities = YES;
+            }
+            else if( functionValue == DBL_MAX || isinf(functionValue) ) {
+                infinities = YES;
+            }
             else {
-                double plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
-                CGPoint pos               = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].x           = pos.x;
-                viewPoints[i].y           = pos.y;
-                
-                if( functionValue == -DBL_MAX || isinf(-functionValue) ) {
-                    self.hasNegInfinities = YES;
-                }
-                else if( functionValue == DBL_MAX || isinf(functionValue) ) {
-                    self.hasInfinities = YES;
-                }
-                else {
-                    self.minFunctionValue = MIN(self.minFunctionValue, functionValue);
-                    self.maxFunctionValue = MAX(self.maxFunctionValue, functionValue);
-                }
+                minFunctionValue = MIN(minFunctionValue, functionValue);
+                maxFunctionValue = MAX(maxFunctionValue, functionValue);
             }
-        });
+        }
+        
+        self.minFunctionValue = minFunctionValue;
+        self.maxFunctionValue = maxFunctionValue;
+        if ( negInfinities ) {
+            self.hasNegInfinities = YES;
+        }
+        if ( infinities ) {
+            self.hasInfinities = YES;
+        }
     }
     else {
         const NSDecimal *xBytes     = (const NSDecimal *)([self cachedNumbersForField:CPTContourPlotFieldX].data.bytes);
@@ -1513,37 +1594,63 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
  *  @param indexRange The index range to load.
  **/
 -(void)reloadContourLineStylesInIsoCurveIndexRange:(NSRange)indexRange {
+    if ( self.isRenderSnapshot ) {
+        // the data source is only called on the main thread, so the plot loaded the styles for the snapshot
+        [self replaceObjectsInArray:self.isoCurvesLineStyles withObjectsFromArray:self.loadedIsoCurvesLineStyles inIsoCurveIndexRange:indexRange];
+        return;
+    }
+
+    BOOL needsLegendUpdate = [self loadContourLineStylesInIsoCurveIndexRange:indexRange isoCurveIndices:self.isoCurvesIndices intoLineStyles:self.isoCurvesLineStyles];
+
+    // Legend
+    if ( needsLegendUpdate ) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:CPTLegendNeedsRedrawForPlotNotification object:self];
+    }
+
+    [self setNeedsDisplay];
+}
+
+/// @cond
+
+/** @internal
+ *  @brief Loads contour line styles in the given index range from the data source.
+ *  @param indexRange The index range to load.
+ *  @param curveIndices The planes of the iso-curves, used by data sources that load the styles in one call.
+ *  @param lineStyles The array the line styles are stored in.
+ *  @return @YES if the data source supplied the line styles.
+ **/
+-(BOOL)loadContourLineStylesInIsoCurveIndexRange:(NSRange)indexRange isoCurveIndices:(nullable CPTNumberArray *)curveIndices intoLineStyles:(nullable CPTMutableLineStyleArray *)lineStyles {
     id<CPTContourPlotDataSource> theDataSource = (id<CPTContourPlotDataSource>)self.dataSource;
     
     if ([theDataSource isKindOfClass:[CPTFieldFunctionDataSource class]]) {
         theDataSource = (id<CPTContourPlotDataSource>)self.appearanceDataSource;
     }
 
-    BOOL needsLegendUpdate = NO;
+    BOOL loaded = NO;
 
     if ( [theDataSource respondsToSelector:@selector(lineStylesForContourPlot:isoCurveIndices:isoCurveIndicesSize:)] ) {
-        needsLegendUpdate = YES;
+        loaded = YES;
 
         id nilObject                    = [CPTPlot nilData];
         NSUInteger maxIndex             = NSMaxRange(indexRange);
         NSUInteger *indices = (NSUInteger*)calloc(maxIndex - indexRange.location, sizeof(NSUInteger));
         for ( NSUInteger idx = indexRange.location; idx < maxIndex; idx++ ) {
-            indices[idx - indexRange.location] = [[self.isoCurvesIndices objectAtIndex:idx] unsignedIntegerValue];
+            indices[idx - indexRange.location] = [[curveIndices objectAtIndex:idx] unsignedIntegerValue];
         }
         CPTLineStyleArray *dataSourceLineStyles = [theDataSource lineStylesForContourPlot:self isoCurveIndices:indices isoCurveIndicesSize:maxIndex - indexRange.location];
         for ( NSUInteger idx = 0; idx < maxIndex - indexRange.location; idx++ ) {
             CPTMutableLineStyle *dataSourceLineStyle = [CPTMutableLineStyle lineStyleWithStyle: [dataSourceLineStyles objectAtIndex:indices[idx]]];
             if ( dataSourceLineStyle ) {
-                [self.isoCurvesLineStyles replaceObjectAtIndex:indices[idx] withObject:dataSourceLineStyle];
+                [lineStyles replaceObjectAtIndex:indices[idx] withObject:dataSourceLineStyle];
             }
             else {
-                [self.isoCurvesLineStyles replaceObjectAtIndex:indices[idx] withObject:nilObject];
+                [lineStyles replaceObjectAtIndex:indices[idx] withObject:nilObject];
             }
         }
         free(indices);
     }
     else if ( [theDataSource respondsToSelector:@selector(lineStyleForContourPlot:isoCurveIndex:)] ) {
-        needsLegendUpdate = YES;
+        loaded = YES;
 
         id nilObject                    = [CPTPlot nilData];
         NSUInteger maxIndex             = NSMaxRange(indexRange);
@@ -1553,23 +1660,20 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 //                actualIndex = [[self.isoCurvesIndices objectAtIndex:idx] unsignedIntegerValue];
                 CPTMutableLineStyle *dataSourceLineStyle = [CPTMutableLineStyle lineStyleWithStyle: [theDataSource lineStyleForContourPlot:self isoCurveIndex:idx/*actualIndex*/]];
                 if ( dataSourceLineStyle ) {
-                    [self.isoCurvesLineStyles replaceObjectAtIndex:idx/*actualIndex*/ withObject:dataSourceLineStyle];
+                    [lineStyles replaceObjectAtIndex:idx/*actualIndex*/ withObject:dataSourceLineStyle];
                 }
                 else {
-                    [self.isoCurvesLineStyles replaceObjectAtIndex:idx/*actualIndex*/ withObject:nilObject];
+                    [lineStyles replaceObjectAtIndex:idx/*actualIndex*/ withObject:nilObject];
                 }
          //   }
         }
     }
 
-    // Legend
-    if ( needsLegendUpdate ) {
-        [[NSNotificationCenter defaultCenter] postNotificationName:CPTLegendNeedsRedrawForPlotNotification object:self];
-    }
-
-    [self setNeedsDisplay];
+    return loaded;
 }
 
+/// @endcond
+
 #pragma mark -
 #pragma mark Fills
 /**
@@ -1583,6 +1687,26 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
  *  @param indexRange The index range to load.
  **/
 -(void)reloadContourFillsInIsoCurveIndexRange:(NSRange)indexRange {
+    if ( self.isRenderSnapshot ) {
+        // the data source is only called on the main thread, so the plot loaded the fills for the snapshot
+        [self replaceObjectsInArray:self.isoCurvesFills withObjectsFromArray:self.loadedIsoCurvesFills inIsoCurveIndexRange:indexRange];
+        return;
+    }
+
+    [self loadContourFillsInIsoCurveIndexRange:indexRange isoCurveIndices:self.isoCurvesIndices intoFills:self.isoCurvesFills];
+
+    [self setNeedsDisplay];
+}
+
+/// @cond
+
+/** @internal
+ *  @brief Loads contour fills in the given index range from the data source.
+ *  @param indexRange The index range to load.
+ *  @param curveIndices The planes of the iso-curves, used by data sources that load the fills in one call.
+ *  @param fills The array the fills are stored in.
+ **/
+-(void)loadContourFillsInIsoCurveIndexRange:(NSRange)indexRange isoCurveIndices:(nullable CPTNumberArray *)curveIndices intoFills:(nullable CPTMutableFillArray *)fills {
     id<CPTContourPlotDataSource> theDataSource = (id<CPTContourPlotDataSource>)self.dataSource;
     
     if ([theDataSource isKindOfClass:[CPTFieldFunctionDataSource class]]) {
@@ -1595,19 +1719,19 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         NSUInteger maxIndex             = NSMaxRange(indexRange);
         NSUInteger *indices = (NSUInteger*)calloc(maxIndex - indexRange.location, sizeof(NSUInteger));
         for ( NSUInteger idx = indexRange.location; idx < maxIndex; idx++ ) {
-            indices[idx] = [[self.isoCurvesIndices objectAtIndex:idx] unsignedIntegerValue];
+            indices[idx] = [[curveIndices objectAtIndex:idx] unsignedIntegerValue];
         }
         CPTFillArray *dataSourceFills = [theDataSource fillsForContourPlot:self isoCurveIndices:indices isoCurveIndicesSize:maxIndex - indexRange.location];
         for ( NSUInteger idx = 0; idx < maxIndex - indexRange.location; idx++ ) {
             CPTFill *dataSourceFill = [dataSourceFills objectAtIndex:idx];
-            if ( idx > self.isoCurvesFills.count - 1 ) {
-                [self.isoCurvesFills addObject:nilObject];
+            if ( idx > fills.count - 1 ) {
+                [fills addObject:nilObject];
             }
             if ( dataSourceFill ) {
-                [self.isoCurvesFills replaceObjectAtIndex:indices[idx] withObject:dataSourceFill];
+                [fills replaceObjectAtIndex:indices[idx] withObject:dataSourceFill];
             }
             else {
-                [self.isoCurvesFills replaceObjectAtIndex:indices[idx] withObject:nilObject];
+                [fills replaceObjectAtIndex:indices[idx] withObject:nilObject];
             }
         }
         free(indices);
@@ -1618,21 +1742,34 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         NSUInteger maxIndex             = NSMaxRange(indexRange);
         for ( NSUInteger idx = indexRange.location; idx < maxIndex; idx++ ) {
             CPTFill *dataSourceFill = [theDataSource fillForContourPlot:self isoCurveIndex:idx];
-            if ( idx > self.isoCurvesFills.count - 1 ) {
-                [self.isoCurvesFills addObject:nilObject];
+            if ( idx > fills.count - 1 ) {
+                [fills addObject:nilObject];
             }
             if ( dataSourceFill ) {
-                [self.isoCurvesFills replaceObjectAtIndex:idx withObject:dataSourceFill];
+                [fills replaceObjectAtIndex:idx withObject:dataSourceFill];
             }
             else {
-                [self.isoCurvesFills replaceObjectAtIndex:idx withObject:nilObject];
+                [fills replaceObjectAtIndex:idx withObject:nilObject];
             }
         }
     }
+}
 
-    [self setNeedsDisplay];
+/** @internal
+ *  @brief Copies the line styles or fills a render snapshot was given into the arrays it draws with.
+ *  @param objects The line styles or fills the snapshot draws with.
+ *  @param loadedObjects The line styles or fills loaded for the snapshot.
+ *  @param indexRange The index range to copy.
+ **/
+-(void)replaceObjectsInArray:(nullable NSMutableArray *)objects withObjectsFromArray:(nullable NSArray *)loadedObjects inIsoCurveIndexRange:(NSRange)indexRange {
+    NSUInteger maxIndex = MIN(NSMaxRange(indexRange), MIN(objects.count, loadedObjects.count));
+    for ( NSUInteger idx = indexRange.location; idx < maxIndex; idx++ ) {
+        [objects replaceObjectAtIndex:idx withObject:loadedObjects[idx]];
+    }
 }
 
+/// @endcond
+
 - (CPTColor*) averageFillColourBetweenIndex:(NSUInteger)index0 OtherIndex:(NSUInteger)index1 {
     id nilObject                    = [CPTPlot nilData];
     CPTColor *avg = nil;
@@ -1752,32 +1889,25 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
  **/
 -(NSUInteger)indexOfVisiblePointClosestToPlotAreaPoint:(CGPoint)viewPoint
 {
-    NSUInteger dataCount = self.cachedDataCount;
-    CGPoint *viewPoints = (CGPoint*)calloc(dataCount, sizeof(CGPoint));
-    BOOL *drawPointFlags     = (BOOL*)calloc(dataCount, sizeof(BOOL));
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        NSUInteger dataCount = self.cachedDataCount;
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
 
-    [self calculatePointsToDraw:drawPointFlags forPlotSpace:(CPTXYPlotSpace *)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        CGPoint *viewPoints = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+        BOOL *drawPointFlags     = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
-    NSInteger result = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
+        [self calculatePointsToDraw:drawPointFlags forPlotSpace:(CPTXYPlotSpace *)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
+        [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
 
-    if ( result != NSNotFound ) {
-        CGFloat minimumDistanceSquared = (CGFloat)NAN;
-        for ( NSUInteger i = (NSUInteger)result; i < dataCount; ++i ) {
-            if ( drawPointFlags[i] ) {
-                CGFloat distanceSquared = squareOfDistanceBetweenPoints(viewPoint, viewPoints[i]);
-                if ( isnan(minimumDistanceSquared) || (distanceSquared < minimumDistanceSquared)) {
-                    minimumDistanceSquared = distanceSquared;
-                    result                 = (NSInteger)i;
-                }
-            }
-        }
-    }
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithPoints:viewPoints flags:drawPointFlags count:dataCount];
 
-    free(viewPoints);
-    free(drawPointFlags);
+        [arena resetToMark:scratchMark];
 
-    return (NSUInteger)result;
+        return newIndex;
+    }];
+
+    return [theIndex indexOfItemClosestToPoint:viewPoint];
 }
 
 /** @brief Returns the plot area view point of a visible point.
@@ -1815,6 +1945,119 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
 
 /// @cond
 
+-(nonnull CPTPlot *)renderSnapshot
+{
+    CPTContourPlot *snapshot = (CPTContourPlot *)[super renderSnapshot];
+
+    snapshot.isoCurvesImageScale = self.isoCurvesImageScale;
+
+    if ( [self needsIsoCurvesGenerationForPlotSpace:(CPTXYPlotSpace *)self.plotSpace] ) {
+        // the snapshot may generate any of the planes, so load the appearance of all of them
+        NSUInteger planeCount = self.noIsoCurves;
+        id nilObject          = [CPTPlot nilData];
+
+        CPTMutableNumberArray *planeIndices  = [CPTMutableNumberArray arrayWithCapacity:planeCount + 1];
+        CPTMutableLineStyleArray *lineStyles = [CPTMutableLineStyleArray arrayWithCapacity:planeCount];
+        CPTMutableFillArray *fills           = [CPTMutableFillArray arrayWithCapacity:planeCount + 1];
+
+        for ( NSUInteger plane = 0; plane <= planeCount; plane++ ) {
+            [planeIndices addObject:@(plane)];
+            if ( plane < planeCount ) {
+                [lineStyles addObject:[CPTMutableLineStyle lineStyleWithStyle:self.isoCurveLineStyle]];
+            }
+            [fills addObject:nilObject];
+        }
+        [self loadContourLineStylesInIsoCurveIndexRange:NSMakeRange(0, planeCount) isoCurveIndices:planeIndices intoLineStyles:lineStyles];
+        [self loadContourFillsInIsoCurveIndexRange:NSMakeRange(0, planeCount + 1) isoCurveIndices:planeIndices intoFills:fills];
+
+        snapshot.loadedIsoCurvesLineStyles = lineStyles;
+        snapshot.loadedIsoCurvesFills      = fills;
+    }
+
+    return snapshot;
+}
+
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot
+{
+    [super didRenderSnapshot:snapshot];
+
+    CPTContourPlot *theSnapshot = (CPTContourPlot *)snapshot;
+
+    if ( theSnapshot.generatedIsoCurves ) {
+        // take over the cache files the snapshot wrote, later frames read them
+        NSFileManager *fileManager   = [NSFileManager defaultManager];
+        NSString *planesFilePath     = self.planesCacheFilePath;
+        NSString *snapshotPlanesPath = theSnapshot.planesCacheFilePath;
+        NSString *imageFilePath      = [self imageFilePathForPlanesFilePath:planesFilePath];
+        NSString *snapshotImagePath  = [self imageFilePathForPlanesFilePath:snapshotPlanesPath];
+
+        if ( [fileManager fileExistsAtPath:snapshotPlanesPath] ) {
+            [fileManager removeItemAtPath:planesFilePath error:NULL];
+            [fileManager moveItemAtPath:snapshotPlanesPath toPath:planesFilePath error:NULL];
+        }
+        if ( [fileManager fileExistsAtPath:snapshotImagePath] ) {
+            [fileManager removeItemAtPath:imageFilePath error:NULL];
+            [fileManager moveItemAtPath:snapshotImagePath toPath:imageFilePath error:NULL];
+        }
+
+        // and the iso-curves it generated, copied as the snapshot empties its arrays when it is deallocated
+        self.isoCurvesIndices         = [theSnapshot.isoCurvesIndices mutableCopy];
+        self.isoCurvesValues          = [theSnapshot.isoCurvesValues mutableCopy];
+        self.isoCurvesLineStyles      = [theSnapshot.isoCurvesLineStyles mutableCopy];
+        self.isoCurvesFills           = [theSnapshot.isoCurvesFills mutableCopy];
+        self.isoCurvesFillings        = [theSnapshot.isoCurvesFillings mutableCopy];
+        self.isoCurvesLabels          = [theSnapshot.isoCurvesLabels mutableCopy];
+        self.isoCurvesLabelsPositions = [theSnapshot.isoCurvesLabelsPositions mutableCopy];
+        self.isoCurvesLabelsRotations = [theSnapshot.isoCurvesLabelsRotations mutableCopy];
+        self.isoCurvesNoStrips        = [theSnapshot.isoCurvesNoStrips mutableCopy];
+
+        self.noActualIsoCurves  = theSnapshot.noActualIsoCurves;
+        self.noColumnsSecondary = theSnapshot.noColumnsSecondary;
+        self.noRowsSecondary    = theSnapshot.noRowsSecondary;
+        self.firstRendition     = theSnapshot.firstRendition;
+        self.initialXRange      = theSnapshot.initialXRange;
+        self.initialYRange      = theSnapshot.initialYRange;
+        self.previousLimits     = theSnapshot.previousLimits;
+        self.greatestContourBox = theSnapshot.greatestContourBox;
+        self.maxWidthPixels     = theSnapshot.maxWidthPixels;
+        self.maxHeightPixels    = theSnapshot.maxHeightPixels;
+        self.scaleX             = theSnapshot.scaleX;
+        self.scaleY             = theSnapshot.scaleY;
+        self.originOfContext    = theSnapshot.originOfContext;
+        self.scaleOfContext     = theSnapshot.scaleOfContext;
+        if ( !self.dataSourceBlock ) {
+            self.dataSourceBlock = theSnapshot.dataSourceBlock;
+            // the planes the snapshot cached were generated from this block
+            self.fieldBlockGeneration = theSnapshot.fieldBlockGeneration;
+        }
+
+        // unless the iso-curves were asked to update again while the snapshot was drawn
+        if ( self.isoCurvesUpdateRequestCount == theSnapshot.isoCurvesUpdateRequestCount ) {
+            self.needsIsoCurvesUpdate = NO;
+        }
+        self.needsIsoCurvesRelabel = YES;
+
+        [[NSNotificationCenter defaultCenter] postNotificationName:CPTLegendNeedsRedrawForPlotNotification object:self];
+    }
+    self.previousFillIsoCurves = theSnapshot.previousFillIsoCurves;
+
+    CPTGraph *theGraph = self.graph;
+    if ( theGraph.allowTracking ) {
+        [self updateTrackingAreas];
+        [self updateIsoCurveTrackingAreas];
+    }
+}
+
+/** @internal
+ *  @brief Whether the iso-curves have to be generated again before the plot is drawn in the given plot space.
+ *  @param thePlotSpace The plot space the plot is drawn in.
+ *  @return @YES if the iso-curves have to be generated.
+ **/
+-(BOOL)needsIsoCurvesGenerationForPlotSpace:(nullable CPTXYPlotSpace *)thePlotSpace
+{
+    return self.needsIsoCurvesUpdate || fabs(thePlotSpace.xRange.lengthDouble - self.initialXRange.lengthDouble) > 0.001 || fabs(thePlotSpace.yRange.lengthDouble - self.initialYRange.lengthDouble) > 0.001 || self.previousFillIsoCurves != self.fillIsoCurves || self.firstRendition;
+}
+
 -(void)renderAsVectorInContext:(nonnull CGContextRef)context {
     if ( self.hidden ) {
         return;
@@ -1908,8 +2151,10 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         NSUInteger index, pos, pos2, plane;
         double x, y;
         CGPoint point;
-        NSString *filePath = [NSString stringWithFormat:@"%@contours.bin", NSTemporaryDirectory()];
-        NSString *imageFilePath = [NSString stringWithFormat:@"%@layer.png", NSTemporaryDirectory()];
+        NSString *filePath = self.planesCacheFilePath;
+        NSString *imageFilePath = [self imageFilePathForPlanesFilePath:filePath];
+        // a render snapshot reads the cache files of the plot it was taken from and writes its own
+        NSString *sourceFilePath = self.planesCacheSourcePath ?: filePath;
 
         double _limits[4] = { limit0, limit1, limit2, limit3 };
         CGRect previousGreatestContourBox = CGRectMake((_limits[0] - thePlotSpace.xRange.locationDouble) * self.scaleX, (_limits[2] - thePlotSpace.yRange.locationDouble) * self.scaleY, (_limits[1] - _limits[0]) * self.scaleX, (_limits[3] - _limits[2]) * self.scaleY);
@@ -1929,7 +2174,7 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         self.originOfContext = CGPointZero;
         self.scaleOfContext = 1.0;
         
-        if ( fabs(thePlotSpace.xRange.lengthDouble - self.initialXRange.lengthDouble) > 0.001 || fabs(thePlotSpace.yRange.lengthDouble - self.initialYRange.lengthDouble) > 0.001 || self.previousFillIsoCurves != self.fillIsoCurves || self.firstRendition ) {
+        if ( [self needsIsoCurvesGenerationForPlotSpace:thePlotSpace] ) {
             self.needsIsoCurvesUpdate = YES;
         }
 //        else if ( (self.functionPlot && ([self.limits[1] doubleValue] - [self.limits[0] doubleValue] > thePlotSpace.xRange.lengthDouble || [self.limits[3] doubleValue] - [self.limits[2] doubleValue] > thePlotSpace.yRange.lengthDouble) && (fabs(thePlotSpace.xRange.locationDouble - self.initialXRange.locationDouble) > 0.001 || fabs(thePlotSpace.yRange.locationDouble - self.initialYRange.locationDouble) > 0.001)) ) {
@@ -2001,18 +2246,36 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
                 CPTContourDataSourceBlock __dataSourceBlock = self.dataSourceBlock;
                 [contours setFieldBlock:__dataSourceBlock];
             }
+            contours.fieldGeneration = self.fieldBlockGeneration;
+            contours.concurrentGeneration = self.concurrentGeneration;
+            // when the limits are searched for keep the field, so each search only has to add the border
+            contours.denseGeneration = !self.extrapolateToLimits && !self.functionPlot;
             NSUInteger repeatContoursCalculation = 3;
+            BOOL extendContours = NO;
             while ( repeatContoursCalculation > 0 ) {
-                [contours setFirstGridDimensionColumns:workingNoColumnsFirst Rows:workingNoRowsFirst];
-                [contours setSecondaryGridDimensionColumns:workingNoColumnsSecondary Rows:workingNoRowsSecondary];
-                [contours initialiseMemory];
-                if ( !self.firstRendition && self.fillIsoCurves != self.previousFillIsoCurves && [contours readPlanesFromDisk:filePath]) {
-                    self.greatestContourBox = CGRectZero;
+                if ( extendContours && [contours extendAndCompactStripsToLimits:_limits] ) {
+                    double *extendedLimits = [contours getLimits];
+                    limit0 = _limits[0] = extendedLimits[0];
+                    limit1 = _limits[1] = extendedLimits[1];
+                    limit2 = _limits[2] = extendedLimits[2];
+                    limit3 = _limits[3] = extendedLimits[3];
+                    [contours writePlanesToDisk:filePath];
                 }
                 else {
-                    self.firstRendition = NO;
-                    [contours generateAndCompactStrips];
-                    [contours writePlanesToDisk:filePath];
+                    if ( extendContours ) {
+                        [contours setXYLimits:_limits];
+                    }
+                    [contours setFirstGridDimensionColumns:workingNoColumnsFirst Rows:workingNoRowsFirst];
+                    [contours setSecondaryGridDimensionColumns:workingNoColumnsSecondary Rows:workingNoRowsSecondary];
+                    [contours initialiseMemory];
+                    if ( !self.firstRendition && self.fillIsoCurves != self.previousFillIsoCurves && [contours readPlanesFromDisk:sourceFilePath]) {
+                        self.greatestContourBox = CGRectZero;
+                    }
+                    else {
+                        self.firstRendition = NO;
+                        [contours generateAndCompactStrips];
+                        [contours writePlanesToDisk:filePath];
+                    }
                 }
                 
                 if ( self.isoCurvesIndices != nil ) {
@@ -2078,17 +2341,23 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
                     _limits[1] = (self.greatestContourBox.origin.x + self.greatestContourBox.size.width * 2.0) / self.scaleX + thePlotSpace.xRange.locationDouble;
                     _limits[2] = (self.greatestContourBox.origin.y - self.greatestContourBox.size.height) / self.scaleY + thePlotSpace.yRange.locationDouble;
                     _limits[3] = (self.greatestContourBox.origin.y + self.greatestContourBox.size.height * 2.0) / self.scaleY + thePlotSpace.yRange.locationDouble;
-                    if ( ceil((_limits[1] - _limits[0]) / (limit1 - limit0)) >= 2 || ceil((_limits[3] - _limits[2]) / (limit3 - limit2)) >= 2 ) {
-                        limit0 = _limits[0];
-                        limit1 = _limits[1];
-                        limit2 = _limits[2];
-                        limit3 = _limits[3];
-//                        self.noColumnsFirst *= 2;
-//                        self.noRowsFirst *= 2;
-                        self.noColumnsSecondary *= 2;
-                        self.noRowsSecondary *= 2;
+                    if ( contours.denseGeneration ) {
+                        // grow the existing grid at the same spacing on the next pass rather than regenerating it
+                        extendContours = YES;
+                    }
+                    else {
+                        if ( ceil((_limits[1] - _limits[0]) / (limit1 - limit0)) >= 2 || ceil((_limits[3] - _limits[2]) / (limit3 - limit2)) >= 2 ) {
+                            limit0 = _limits[0];
+                            limit1 = _limits[1];
+                            limit2 = _limits[2];
+                            limit3 = _limits[3];
+//                            self.noColumnsFirst *= 2;
+//                            self.noRowsFirst *= 2;
+                            self.noColumnsSecondary *= 2;
+                            self.noRowsSecondary *= 2;
+                        }
+                        [contours setXYLimits:_limits];
                     }
-                    [contours setXYLimits:_limits];
                 }
                 else {
                     repeatContoursCalculation = 0;
@@ -2664,39 +2933,20 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
             self.initialXRange = [thePlotSpace.xRange mutableCopy];
             self.initialYRange = [thePlotSpace.yRange mutableCopy];
             self.previousLimits = [NSMutableArray arrayWithObjects:[NSNumber numberWithDouble:limit0], [NSNumber numberWithDouble:limit1], [NSNumber numberWithDouble:limit2], [NSNumber numberWithDouble:limit3], nil];
+            self.generatedIsoCurves = YES;
+            sourceFilePath = filePath;
             self.needsIsoCurvesRelabel = YES;
         }
         
         if ( !self.needsIsoCurvesUpdate ) {
             CGContextSaveGState(context);
-            CGFloat imageScaleX = 1.0, imageScaleY = 1.0;
+            CGFloat imageScaleX = self.isoCurvesImageScale, imageScaleY = imageScaleX;
+            NSString *sourceImageFilePath = [self imageFilePathForPlanesFilePath:sourceFilePath];
 #if TARGET_OS_OSX
-            NSImage *image = [[NSImage alloc] initWithContentsOfFile:imageFilePath];
+            NSImage *image = [[NSImage alloc] initWithContentsOfFile:sourceImageFilePath];
             CGImageRef imageRef = [image CGImageForProposedRect:nil context:[NSGraphicsContext graphicsContextWithCGContext:context flipped:NO] hints:nil];
-            imageScaleX = 1 / self.plotArea.contentsScale;
-            imageScaleY = 1 / self.plotArea.contentsScale;
 #else
-            UIImage* image = [UIImage imageWithContentsOfFile:imageFilePath];
-            
-            NSInteger display = 0; // standard display
-            if ([[UIScreen mainScreen] respondsToSelector:@selector(scale)] && [[UIScreen mainScreen] scale] == 2.0) {
-                display = 1; // is retina display
-            }
-            else if ([[UIScreen mainScreen] respondsToSelector:@selector(scale)] && [[UIScreen mainScreen] scale] == 3.0) {
-                display = 4; // is retina display
-            }
-            if ([[UIDevice currentDevice] userInterfaceIdiom] == UIUserInterfaceIdiomPad) {
-                display += 2;
-            }
-            
-            if (display == 1 || display == 3) {
-                imageScaleX = 0.5;
-                imageScaleY = 0.5;
-            }
-            else if (display == 4) {
-                imageScaleX = 1.0 / 3.0;
-                imageScaleY = 1.0 / 3.0;
-            }
+            UIImage* image = [UIImage imageWithContentsOfFile:sourceImageFilePath];
             CGImageRef imageRef = [image CGImage];
 #endif
 
@@ -5821,6 +6071,8 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
     CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
     Discontinuities *_discontinuities = [contours getDiscontinuities];
     if ( _discontinuities->used > 0 ) {
+        // the generator records discontinuities in discovery order; the clustering expects grid order
+        sortDiscontinuities(_discontinuities);
         size_t discontinuousCount = _discontinuities->used;
         self.hasDiscontinuity = YES;
         CGPoint *discontinuousPoints = (CGPoint*)malloc(_discontinuities->used * sizeof(CGPoint));
@@ -6788,8 +7040,11 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
     CPTContourPlotCurvedInterpolationOption interpolationOption = self.curvedInterpolationOption;
 
     if ( lastDrawnPointIndex > 0 ) {
-        CGPoint *controlPoints1 = (CGPoint*)calloc(lastDrawnPointIndex, sizeof(CGPoint));
-        CGPoint *controlPoints2 = (CGPoint*)calloc(lastDrawnPointIndex, sizeof(CGPoint));
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *controlPoints1 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
+        CGPoint *controlPoints2 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
 
         lastDrawnPointIndex--;
 
@@ -6958,8 +7213,7 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
             }
         }
 
-        free(controlPoints1);
-        free(controlPoints2);
+        [arena resetToMark:scratchMark];
     }
 
     return dataLinePath;
@@ -7202,10 +7456,13 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
         NSUInteger n = indexRange.length - 1;
 
         // rhs vector
-        CGPoint *a = (CGPoint*)calloc(n, sizeof(CGPoint));
-        CGPoint *b = (CGPoint*)calloc(n, sizeof(CGPoint));
-        CGPoint *c = (CGPoint*)calloc(n, sizeof(CGPoint));
-        CGPoint *r = (CGPoint*)calloc(n, sizeof(CGPoint));
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *a = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *b = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *c = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *r = [arena allocateCount:n size:sizeof(CGPoint)];
 
         // left most segment
         a[0] = CGPointZero;
@@ -7269,10 +7526,7 @@ CPTContourPlotBinding const CPTContourPlotBindingPlotSymbols = @"plotSymbols"; /
                                     (CGFloat)0.5 * (viewPoints[rangeEnd].y + cp1[rangeEnd].y) );
 
         // clean up
-        free(a);
-        free(b);
-        free(c);
-        free(r);
+        [arena resetToMark:scratchMark];
     }
 }
 
@@ -9426,6 +9680,47 @@ void pathApplierSumCoordinatesOfAllPoints(void* info, const CGPathElement* eleme
 
 /// @cond
 
+-(nonnull NSString *)planesCacheFilePath {
+    if ( !planesCacheFilePath ) {
+        planesCacheFilePath = [NSString stringWithFormat:@"%@contours-%@.bin", NSTemporaryDirectory(), [NSUUID UUID].UUIDString];
+    }
+    return planesCacheFilePath;
+}
+
+-(nonnull NSString *)imageFilePathForPlanesFilePath:(nonnull NSString *)planesFilePath {
+    return [[planesFilePath stringByDeletingPathExtension] stringByAppendingPathExtension:@"png"];
+}
+
+-(CGFloat)isoCurvesImageScale {
+    if ( self.isRenderSnapshot ) {
+        return isoCurvesImageScale;
+    }
+
+    CGFloat imageScale = 1.0;
+#if TARGET_OS_OSX
+    imageScale = 1 / self.plotArea.contentsScale;
+#else
+    NSInteger display = 0; // standard display
+    if ([[UIScreen mainScreen] respondsToSelector:@selector(scale)] && [[UIScreen mainScreen] scale] == 2.0) {
+        display = 1; // is retina display
+    }
+    else if ([[UIScreen mainScreen] respondsToSelector:@selector(scale)] && [[UIScreen mainScreen] scale] == 3.0) {
+        display = 4; // is retina display
+    }
+    if ([[UIDevice currentDevice] userInterfaceIdiom] == UIUserInterfaceIdiomPad) {
+        display += 2;
+    }
+    
+    if (display == 1 || display == 3) {
+        imageScale = 0.5;
+    }
+    else if (display == 4) {
+        imageScale = 1.0 / 3.0;
+    }
+#endif
+    return imageScale;
+}
+
 -(void)setIsoCurveLineStyle:(nullable CPTLineStyle *)newLineStyle {
     if ( isoCurveLineStyle != newLineStyle ) {
         isoCurveLineStyle = [newLineStyle copy];
@@ -9519,13 +9814,22 @@ void pathApplierSumCoordinatesOfAllPoints(void* info, const CGPathElement* eleme
 -(void)setNeedsIsoCurvesUpdate:(BOOL)newNeedsIsoCurvesUpdate {
     if ( newNeedsIsoCurvesUpdate != needsIsoCurvesUpdate ) {
         needsIsoCurvesUpdate = newNeedsIsoCurvesUpdate;
-        if ( needsIsoCurvesUpdate ) {
+        // a render snapshot generates its iso-curves while it is drawn, the plot takes them over on the main thread
+        if ( needsIsoCurvesUpdate && !self.isRenderSnapshot ) {
+            self.isoCurvesUpdateRequestCount++;
             [self reloadData];
             [self setNeedsLayout];
         }
     }
 }
 
+-(void)setDataSourceBlock:(nullable CPTContourDataSourceBlock)newDataSourceBlock {
+    if ( newDataSourceBlock != dataSourceBlock ) {
+        dataSourceBlock = newDataSourceBlock;
+        self.fieldBlockGeneration++;
+    }
+}
+
 -(void)setNoIsoCurves:(NSUInteger)newNoIsoCurves {
     if ( newNoIsoCurves != noIsoCurves ) {
         noIsoCurves = newNoIsoCurves;
@@ -9536,7 +9840,7 @@ void pathApplierSumCoordinatesOfAllPoints(void* info, const CGPathElement* eleme
 -(void)setNeedsIsoCurvesRelabel:(BOOL)newNeedsRelabel {
     if ( newNeedsRelabel != needsIsoCurvesRelabel ) {
         needsIsoCurvesRelabel = newNeedsRelabel;
-        if ( needsIsoCurvesRelabel ) {
+        if ( needsIsoCurvesRelabel && !self.isRenderSnapshot ) {
             self.isoCurvesLabelIndexRange = NSMakeRange(0, self.isoCurvesValues.count);
             [self reLabelIsoCurves];
             [self setNeedsLayout];
@@ -8,15 +8,23 @@
 #import <tgmath.h>
 
 /// @cond
+
+// number of colors in the lookup table of a gradient
+static const NSUInteger CPTGradientTableSize = 256;
+
+typedef void (*CPTGradientBlendFunction)(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out);
+
 @interface CPTGradient()
 
 @property (nonatomic, readwrite, strong, nonnull) CPTColorSpace *colorspace;
 @property (nonatomic, readwrite, assign) CPTGradientBlendingMode blendingMode;
 @property (nonatomic, readwrite, assign) CPTGradientElement *elementList;
 @property (nonatomic, readwrite, assign, nonnull) CGFunctionRef gradientFunction;
+@property (nonatomic, readwrite, assign, nullable) CGFloat *colorTable;
 
 -(void)commonInit;
 -(void)addElement:(nonnull CPTGradientElement *)newElement;
+-(void)updateColorTable;
 
 -(nonnull CGShadingRef)newAxialGradientInRect:(CGRect)rect;
 -(nonnull CGShadingRef)newRadialGradientInRect:(CGRect)rect context:(nonnull CGContextRef)context;
@@ -31,9 +39,11 @@
 @end
 
 // C Functions for color blending
-static void CPTLinearEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out);
-static void CPTChromaticEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out);
-static void CPTInverseChromaticEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out);
+static void CPTTableEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out);
+static void CPTColorTableLookup(const CGFloat *__nullable table, CGFloat position, CGFloat *__nonnull out);
+static void CPTLinearBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out);
+static void CPTChromaticBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out);
+static void CPTInverseChromaticBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out);
 static void CPTTransformRGB_HSV(CGFloat *__nonnull components);
 static void CPTTransformHSV_RGB(CGFloat *__nonnull components);
 static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
@@ -98,6 +108,14 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
 @synthesize elementList;
 @synthesize gradientFunction;
 
+/** @internal
+ *  @property nullable CGFloat *colorTable
+ *  @brief The RGBA colors of the gradient at evenly spaced positions from zero (@num{0}) to one (@num{1}),
+ *  blended with the @ref blendingMode. Rebuilt whenever the color stops or blending mode change,
+ *  so drawing never has to walk the color stops. @NULL if there are no color stops.
+ **/
+@synthesize colorTable;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -138,6 +156,21 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
 {
     self.colorspace  = [CPTColorSpace genericRGBSpace];
     self.elementList = NULL;
+    self.colorTable  = NULL;
+
+    CGFunctionCallbacks evaluationCallbackInfo = { 0, &CPTTableEvaluation, NULL }; // Version, evaluator function, cleanup function
+
+    static const CGFloat input_value_range[2]   = { 0, 1 };                   // range  for the evaluator input
+    static const CGFloat output_value_ranges[8] = { 0, 1, 0, 1, 0, 1, 0, 1 }; // ranges for the evaluator output (4 returned values)
+
+    CGFunctionRef cgFunction = CGFunctionCreate((__bridge void *)(self),  // the color table
+                                                1, input_value_range,     // number of inputs (just fraction of progression)
+                                                4, output_value_ranges,   // number of outputs (4 - RGBa)
+                                                &evaluationCallbackInfo); // info for using the evaluator function
+
+    if ( cgFunction ) {
+        self.gradientFunction = cgFunction;
+    }
 }
 
 -(void)dealloc
@@ -812,19 +845,7 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
     CGFloat components[4] = { CPTFloat(0.0), CPTFloat(0.0), CPTFloat(0.0), CPTFloat(0.0) };
     CGColorRef gradientColor;
 
-    switch ( self.blendingMode ) {
-        case CPTLinearBlendingMode:
-            CPTLinearEvaluation((__bridge void *)(self), &position, components);
-            break;
-
-        case CPTChromaticBlendingMode:
-            CPTChromaticEvaluation((__bridge void *)(self), &position, components);
-            break;
-
-        case CPTInverseChromaticBlendingMode:
-            CPTInverseChromaticEvaluation((__bridge void *)(self), &position, components);
-            break;
-    }
+    CPTColorTableLookup(self.colorTable, position, components);
 
 #if TARGET_OS_SIMULATOR || TARGET_OS_IPHONE || TARGET_OS_MACCATALYST
     CGFloat colorComponents[4] = { components[0], components[1], components[2], components[3] };
@@ -1147,35 +1168,48 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
 {
     blendingMode = mode;
 
-    // Choose what blending function to use
-    CGFunctionEvaluateCallback evaluationFunction = NULL;
-
-    switch ( blendingMode ) {
-        case CPTLinearBlendingMode:
-            evaluationFunction = &CPTLinearEvaluation;
-            break;
+    [self updateColorTable];
+}
 
-        case CPTChromaticBlendingMode:
-            evaluationFunction = &CPTChromaticEvaluation;
-            break;
+-(void)updateColorTable
+{
+    CPTGradientElement *list = self.elementList;
+    CGFloat *table           = self.colorTable;
 
-        case CPTInverseChromaticBlendingMode:
-            evaluationFunction = &CPTInverseChromaticEvaluation;
-            break;
+    if ( list == NULL ) {
+        free(table);
+        self.colorTable = NULL;
     }
+    else {
+        // Choose what blending function to use
+        CPTGradientBlendFunction blendFunction = &CPTLinearBlend;
 
-    CGFunctionCallbacks evaluationCallbackInfo = { 0, evaluationFunction, NULL }; // Version, evaluator function, cleanup function
+        switch ( self.blendingMode ) {
+            case CPTLinearBlendingMode:
+                blendFunction = &CPTLinearBlend;
+                break;
 
-    static const CGFloat input_value_range[2]   = { 0, 1 };                   // range  for the evaluator input
-    static const CGFloat output_value_ranges[8] = { 0, 1, 0, 1, 0, 1, 0, 1 }; // ranges for the evaluator output (4 returned values)
+            case CPTChromaticBlendingMode:
+                blendFunction = &CPTChromaticBlend;
+                break;
 
-    CGFunctionRef cgFunction = CGFunctionCreate((__bridge void *)(self),  // the two transition colors
-                                                1, input_value_range,     // number of inputs (just fraction of progression)
-                                                4, output_value_ranges,   // number of outputs (4 - RGBa)
-                                                &evaluationCallbackInfo); // info for using the evaluator function
+            case CPTInverseChromaticBlendingMode:
+                blendFunction = &CPTInverseChromaticBlend;
+                break;
+        }
 
-    if ( cgFunction ) {
-        self.gradientFunction = cgFunction;
+        if ( table == NULL ) {
+            table           = calloc(CPTGradientTableSize * 4, sizeof(CGFloat));
+            self.colorTable = table;
+        }
+
+        if ( table ) {
+            CGFloat lastIndex = (CGFloat)(CPTGradientTableSize - 1);
+
+            for ( NSUInteger i = 0; i < CPTGradientTableSize; i++ ) {
+                blendFunction(list, (CGFloat)i / lastIndex, &table[4 * i]);
+            }
+        }
     }
 }
 
@@ -1204,6 +1238,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
         *(curElement->nextElement)           = *newElement;
         curElement->nextElement->nextElement = tmpNext;
     }
+
+    [self updateColorTable];
 }
 
 -(CPTGradientElement)removeElementAtIndex:(NSUInteger)idx
@@ -1218,6 +1254,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
             removedElement = *tmpNext;
             free(tmpNext);
 
+            [self updateColorTable];
+
             return removedElement;
         }
 
@@ -1231,6 +1269,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
                 removedElement = *tmpNext;
                 free(tmpNext);
 
+                [self updateColorTable];
+
                 return removedElement;
             }
 
@@ -1263,6 +1303,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
             removedElement = *tmpNext;
             free(tmpNext);
 
+            [self updateColorTable];
+
             return removedElement;
         }
         else {
@@ -1274,6 +1316,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
                     removedElement = *tmpNext;
                     free(tmpNext);
 
+                    [self updateColorTable];
+
                     return removedElement;
                 }
             }
@@ -1302,6 +1346,8 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
     }
 
     self.elementList = NULL;
+
+    [self updateColorTable];
 }
 
 -(nullable CPTGradientElement *)elementAtIndex:(NSUInteger)idx
@@ -1341,20 +1387,52 @@ static void CPTResolveHSV(CGFloat *__nonnull color1, CGFloat *__nonnull color2);
 
 /// @cond
 
-void CPTLinearEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out)
+// Color Table Evaluation -
+// CoreGraphics asks for thousands of samples of a shading, so the colors are not blended
+// here but looked up in the table the gradient builds whenever it changes.
+void CPTTableEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out)
 {
-    CGFloat position      = *in;
     CPTGradient *gradient = (__bridge CPTGradient *)info;
 
+    CPTColorTableLookup(gradient.colorTable, *in, out);
+}
+
+// Interpolates between the two table entries either side of position, positions outside [0,1]
+// take the end colors. A gradient without color stops is white.
+void CPTColorTableLookup(const CGFloat *__nullable table, CGFloat position, CGFloat *__nonnull out)
+{
+    if ( table == NULL ) {
+        out[0] = out[1] = out[2] = out[3] = CPTFloat(1.0);
+        return;
+    }
+
+    const CGFloat lastIndex = (CGFloat)(CPTGradientTableSize - 1);
+
+    // fmax and fmin also map NaN to the first entry
+    CGFloat scaled = fmin(fmax(position * lastIndex, CPTFloat(0.0)), lastIndex);
+    NSUInteger idx = MIN((NSUInteger)scaled, CPTGradientTableSize - 2);
+    CGFloat offset = scaled - (CGFloat)idx;
+
+    const CGFloat *color1 = &table[4 * idx];
+    const CGFloat *color2 = color1 + 4;
+
+    out[0] = (color2[0] - color1[0]) * offset + color1[0];
+    out[1] = (color2[1] - color1[1]) * offset + color1[1];
+    out[2] = (color2[2] - color1[2]) * offset + color1[2];
+    out[3] = (color2[3] - color1[3]) * offset + color1[3];
+}
+
+void CPTLinearBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out)
+{
     // This grabs the first two colors in the sequence
-    CPTGradientElement *color1 = gradient.elementList;
+    const CPTGradientElement *color1 = elementList;
 
     if ( color1 == NULL ) {
         out[0] = out[1] = out[2] = out[3] = CPTFloat(1.0);
         return;
     }
 
-    CPTGradientElement *color2 = color1->nextElement;
+    const CPTGradientElement *color2 = color1->nextElement;
 
     // make sure first color and second color are on other sides of position
     while ( color2 != NULL && color2->position < position ) {
@@ -1407,20 +1485,17 @@ void CPTLinearEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGF
 // this we will add to the hue's angle (if we subtract we'll be doing the inverse
 // chromatic...scroll down more for that). All we need to do is keep adding to the hue
 // until we wrap around the color wheel and get to color2.
-void CPTChromaticEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out)
+void CPTChromaticBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out)
 {
-    CGFloat position      = *in;
-    CPTGradient *gradient = (__bridge CPTGradient *)info;
-
     // This grabs the first two colors in the sequence
-    CPTGradientElement *color1 = gradient.elementList;
+    const CPTGradientElement *color1 = elementList;
 
     if ( color1 == NULL ) {
         out[0] = out[1] = out[2] = out[3] = CPTFloat(1.0);
         return;
     }
 
-    CPTGradientElement *color2 = color1->nextElement;
+    const CPTGradientElement *color2 = color1->nextElement;
 
     CGFloat c1[4];
     CGFloat c2[4];
@@ -1484,20 +1559,17 @@ void CPTChromaticEvaluation(void *__nullable info, const CGFloat *__nonnull in,
 // is strictly decreasing, that is we need to get from color1 to color2 by decreasing
 // the 'angle' (i.e. 90º -> 180º would be done by subtracting 270º and getting -180º...
 // which is equivalent to 180º mod 360º
-void CPTInverseChromaticEvaluation(void *__nullable info, const CGFloat *__nonnull in, CGFloat *__nonnull out)
+void CPTInverseChromaticBlend(const CPTGradientElement *__nullable elementList, CGFloat position, CGFloat *__nonnull out)
 {
-    CGFloat position      = *in;
-    CPTGradient *gradient = (__bridge CPTGradient *)info;
-
     // This grabs the first two colors in the sequence
-    CPTGradientElement *color1 = gradient.elementList;
+    const CPTGradientElement *color1 = elementList;
 
     if ( color1 == NULL ) {
         out[0] = out[1] = out[2] = out[3] = CPTFloat(1.0);
         return;
     }
 
-    CPTGradientElement *color2 = color1->nextElement;
+    const CPTGradientElement *color2 = color1->nextElement;
 
     CGFloat c1[4];
     CGFloat c2[4];
@@ -1,9 +1,113 @@
 #import "CPTGradientTests.h"
 
+#import "CPTColor.h"
 #import "CPTGradient.h"
 
+static const CGFloat precision = CPTFloat(1.0e-6);
+
+// the color table holds 256 entries, interpolating between them strays this far from a curved blend
+static const CGFloat tablePrecision = CPTFloat(0.01);
+
+// RGB color of a hue in degrees at full saturation and brightness, as the chromatic blend converts it
+static void CPTGradientTestsHueToRGB(CGFloat hue, CGFloat *rgb)
+{
+    CGFloat h = fmod(hue, CPTFloat(360.0)) / CPTFloat(60.0);
+
+    rgb[0] = fmin(fmax(fabs(h - CPTFloat(3.0)) - CPTFloat(1.0), CPTFloat(0.0)), CPTFloat(1.0));
+    rgb[1] = fmin(fmax(CPTFloat(2.0) - fabs(h - CPTFloat(2.0)), CPTFloat(0.0)), CPTFloat(1.0));
+    rgb[2] = fmin(fmax(CPTFloat(2.0) - fabs(h - CPTFloat(4.0)), CPTFloat(0.0)), CPTFloat(1.0));
+}
+
+@interface CPTGradientTests()
+
+-(void)checkColorAtPosition:(CGFloat)position ofGradient:(nonnull CPTGradient *)gradient red:(CGFloat)red green:(CGFloat)green blue:(CGFloat)blue alpha:(CGFloat)alpha;
+-(void)checkColorAtPosition:(CGFloat)position ofGradient:(nonnull CPTGradient *)gradient red:(CGFloat)red green:(CGFloat)green blue:(CGFloat)blue alpha:(CGFloat)alpha accuracy:(CGFloat)accuracy;
+
+@end
+
+#pragma mark -
+
 @implementation CPTGradientTests
 
+#pragma mark -
+#pragma mark Color Lookup
+
+-(void)testColorAtPositionLinearBlending
+{
+    CPTGradient *gradient = [CPTGradient gradientWithBeginningColor:[CPTColor blackColor] endingColor:[CPTColor whiteColor]];
+
+    [self checkColorAtPosition:CPTFloat(0.3) ofGradient:gradient red:CPTFloat(0.3) green:CPTFloat(0.3) blue:CPTFloat(0.3) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(0.75) ofGradient:gradient red:CPTFloat(0.75) green:CPTFloat(0.75) blue:CPTFloat(0.75) alpha:CPTFloat(1.0)];
+
+    // positions outside the gradient take the end colors
+    [self checkColorAtPosition:CPTFloat(-0.5) ofGradient:gradient red:CPTFloat(0.0) green:CPTFloat(0.0) blue:CPTFloat(0.0) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(1.5) ofGradient:gradient red:CPTFloat(1.0) green:CPTFloat(1.0) blue:CPTFloat(1.0) alpha:CPTFloat(1.0)];
+}
+
+-(void)testColorAtPositionChromaticBlending
+{
+    CPTGradient *gradient = [CPTGradient gradientWithBeginningColor:[CPTColor redColor] endingColor:[CPTColor blueColor]];
+
+    gradient = [gradient gradientWithBlendingMode:CPTChromaticBlendingMode];
+
+    [self checkColorAtPosition:CPTFloat(0.0) ofGradient:gradient red:CPTFloat(1.0) green:CPTFloat(0.0) blue:CPTFloat(0.0) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(1.0) ofGradient:gradient red:CPTFloat(0.0) green:CPTFloat(0.0) blue:CPTFloat(1.0) alpha:CPTFloat(1.0)];
+
+    // in between, the hue turns from red (0 degrees) up to blue (240 degrees) as the HSV blend did
+    const CGFloat positions[] = { CPTFloat(0.1), CPTFloat(0.3), CPTFloat(0.5), CPTFloat(0.55), CPTFloat(0.9) };
+
+    for ( size_t i = 0; i < sizeof(positions) / sizeof(CGFloat); i++ ) {
+        CGFloat rgb[3];
+
+        CPTGradientTestsHueToRGB(CPTFloat(240.0) * positions[i], rgb);
+
+        [self checkColorAtPosition:positions[i] ofGradient:gradient red:rgb[0] green:rgb[1] blue:rgb[2] alpha:CPTFloat(1.0) accuracy:tablePrecision];
+    }
+}
+
+-(void)testColorAtPositionAcrossHardStop
+{
+    CPTGradient *gradient = [CPTGradient gradientWithBeginningColor:[CPTColor blackColor] endingColor:[CPTColor blackColor] beginningPosition:CPTFloat(0.0) endingPosition:CPTFloat(0.5)];
+
+    gradient = [gradient addColorStop:[CPTColor whiteColor] atPosition:CPTFloat(0.5)];
+    gradient = [gradient addColorStop:[CPTColor whiteColor] atPosition:CPTFloat(1.0)];
+
+    // the stop falls halfway between two table entries and is smoothed over the one entry between them
+    [self checkColorAtPosition:CPTFloat(127.0 / 255.0) ofGradient:gradient red:CPTFloat(0.0) green:CPTFloat(0.0) blue:CPTFloat(0.0) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(0.5) ofGradient:gradient red:CPTFloat(0.5) green:CPTFloat(0.5) blue:CPTFloat(0.5) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(128.0 / 255.0) ofGradient:gradient red:CPTFloat(1.0) green:CPTFloat(1.0) blue:CPTFloat(1.0) alpha:CPTFloat(1.0)];
+
+    // and leaves the colors either side alone
+    [self checkColorAtPosition:CPTFloat(0.25) ofGradient:gradient red:CPTFloat(0.0) green:CPTFloat(0.0) blue:CPTFloat(0.0) alpha:CPTFloat(1.0)];
+    [self checkColorAtPosition:CPTFloat(0.75) ofGradient:gradient red:CPTFloat(1.0) green:CPTFloat(1.0) blue:CPTFloat(1.0) alpha:CPTFloat(1.0)];
+}
+
+-(void)testColorAtPositionWithoutColorStops
+{
+    CPTGradient *gradient = [[CPTGradient alloc] init];
+
+    [self checkColorAtPosition:CPTFloat(0.5) ofGradient:gradient red:CPTFloat(1.0) green:CPTFloat(1.0) blue:CPTFloat(1.0) alpha:CPTFloat(1.0)];
+}
+
+-(void)checkColorAtPosition:(CGFloat)position ofGradient:(nonnull CPTGradient *)gradient red:(CGFloat)red green:(CGFloat)green blue:(CGFloat)blue alpha:(CGFloat)alpha
+{
+    [self checkColorAtPosition:position ofGradient:gradient red:red green:green blue:blue alpha:alpha accuracy:precision];
+}
+
+-(void)checkColorAtPosition:(CGFloat)position ofGradient:(nonnull CPTGradient *)gradient red:(CGFloat)red green:(CGFloat)green blue:(CGFloat)blue alpha:(CGFloat)alpha accuracy:(CGFloat)accuracy
+{
+    CGColorRef color          = [gradient newColorAtPosition:position];
+    const CGFloat *components = CGColorGetComponents(color);
+
+    XCTAssertEqual(CGColorGetNumberOfComponents(color), (size_t)4, @"Number of components at %g", (double)position);
+    XCTAssertEqualWithAccuracy(components[0], red, accuracy, @"Red at %g", (double)position);
+    XCTAssertEqualWithAccuracy(components[1], green, accuracy, @"Green at %g", (double)position);
+    XCTAssertEqualWithAccuracy(components[2], blue, accuracy, @"Blue at %g", (double)position);
+    XCTAssertEqualWithAccuracy(components[3], alpha, accuracy, @"Alpha at %g", (double)position);
+
+    CGColorRelease(color);
+}
+
 #pragma mark -
 #pragma mark NSCoding Methods
 
@@ -17,6 +17,7 @@
 #import "CPTColor.h"
 #import "CPTMutableLineStyle.h"
 #import "NSCoderExtensions.h"
+#import "_CPTRasterTileCache.h"
 
 /** @defgroup graphAnimation Graphs
  *  @brief Graph properties that can be animated using Core Animation.
@@ -777,7 +778,8 @@ CPTGraphPlotSpaceKey const CPTGraphPlotSpaceNotificationKey       = @"CPTGraphPl
     }
     for ( CPTPlot *plot in self.plots ) {
         if ( plot.plotSpace == plotSpace ) {
-            [plot setNeedsDisplay];
+            [plot setNeedsDisplayKeepingRasterTiles];
+            [plot setNeedsVisibleRelabel];
         }
     }
     if ( backgroundBandsNeedRedraw ) {
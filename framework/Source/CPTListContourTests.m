@@ -0,0 +1,180 @@
+#import "CPTListContourTests.h"
+
+#import "_CPTListContour.h"
+
+@interface CPTListContour(Testing)
+
+-(void)setFieldBlock:(nonnull CPTContourDataSourceBlock)block;
+
+@end
+
+#pragma mark -
+
+@interface CPTListContourTests()
+
+-(nonnull CPTListContour *)contourWithLimits:(nonnull double *)limits columns:(NSUInteger)columns rows:(NSUInteger)rows;
+-(nonnull NSArray<NSSet<NSString *> *> *)segmentsOfContour:(nonnull CPTListContour *)contour;
+-(nonnull NSArray<NSSet<NSString *> *> *)segmentsGeneratedDensely:(BOOL)dense concurrently:(BOOL)concurrent;
+
+@end
+
+#pragma mark -
+
+@implementation CPTListContourTests
+
+static double isoCurveValues[] = { -0.6, -0.3, 0.0, 0.3, 0.6 };
+
+-(nonnull CPTListContour *)contourWithLimits:(nonnull double *)limits columns:(NSUInteger)columns rows:(NSUInteger)rows
+{
+    CPTListContour *contour = [[CPTListContour alloc] initWithNoIsoCurve:sizeof(isoCurveValues) / sizeof(double)
+                                                          IsoCurveValues:isoCurveValues
+                                                                  Limits:limits];
+
+    // primary cells four nodes wide either way
+    [contour setSecondaryGridDimensionColumns:columns Rows:rows];
+    [contour setFirstGridDimensionColumns:rows / 4 Rows:columns / 4];
+    [contour setFieldBlock:^double (double x, double y) {
+        return sin(6.0 * x + 1.0) * cos(5.0 * y) + 0.25 * x * y;
+    }];
+    contour.denseGeneration = YES;
+
+    return contour;
+}
+
+// every isocurve as the set of node pairs its strips join, whatever order they were welded in
+-(nonnull NSArray<NSSet<NSString *> *> *)segmentsOfContour:(nonnull CPTListContour *)contour
+{
+    NSMutableArray<NSSet<NSString *> *> *planes = [NSMutableArray array];
+
+    for ( NSUInteger i = 0; i < [contour getNoIsoCurves]; i++ ) {
+        NSMutableSet<NSString *> *segments = [NSMutableSet set];
+        LineStripList *pStripList          = [contour getStripListForIsoCurve:i];
+
+        for ( size_t s = 0; s < pStripList->used; s++ ) {
+            LineStrip *pStrip = &pStripList->array[s];
+
+            for ( size_t k = 1; k < pStrip->used; k++ ) {
+                NSUInteger i1 = pStrip->array[k - 1];
+                NSUInteger i2 = pStrip->array[k];
+                [segments addObject:[NSString stringWithFormat:@"%lu-%lu", (unsigned long)MIN(i1, i2), (unsigned long)MAX(i1, i2)]];
+            }
+        }
+        [planes addObject:segments];
+    }
+    return planes;
+}
+
+-(nonnull NSArray<NSSet<NSString *> *> *)segmentsGeneratedDensely:(BOOL)dense concurrently:(BOOL)concurrent
+{
+    double limits[] = { -1.0, 1.0, -1.0, 1.0 };
+
+    NSArray<NSSet<NSString *> *> *segments = nil;
+
+    // the contours share their working storage, so only one can be alive at a time
+    @autoreleasepool {
+        CPTListContour *contour = [self contourWithLimits:limits columns:64 rows:48];
+
+        contour.denseGeneration      = dense;
+        contour.concurrentGeneration = concurrent;
+
+        XCTAssertTrue([contour generate]);
+
+        segments = [self segmentsOfContour:contour];
+    }
+
+    return segments;
+}
+
+#pragma mark -
+#pragma mark Generating
+
+-(void)testDenseFieldMatchesSerialSweep
+{
+    NSArray<NSSet<NSString *> *> *serialSegments     = [self segmentsGeneratedDensely:NO concurrently:NO];
+    NSArray<NSSet<NSString *> *> *denseSegments      = [self segmentsGeneratedDensely:YES concurrently:NO];
+    NSArray<NSSet<NSString *> *> *concurrentSegments = [self segmentsGeneratedDensely:YES concurrently:YES];
+
+    XCTAssertEqual(denseSegments.count, serialSegments.count);
+    XCTAssertEqual(concurrentSegments.count, serialSegments.count);
+
+    for ( NSUInteger i = 0; i < serialSegments.count; i++ ) {
+        XCTAssertTrue(serialSegments[i].count > 0, @"isocurve %lu", (unsigned long)i);
+        if ( i < denseSegments.count ) {
+            XCTAssertEqualObjects(denseSegments[i], serialSegments[i], @"dense isocurve %lu", (unsigned long)i);
+        }
+        if ( i < concurrentSegments.count ) {
+            XCTAssertEqualObjects(concurrentSegments[i], serialSegments[i], @"concurrent isocurve %lu", (unsigned long)i);
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Extending
+
+-(void)testExtendingLimitsMatchesFreshGeneration
+{
+    double limits[]         = { -1.0, 1.0, -1.0, 1.0 };
+    double extendedLimits[] = { -1.25, 1.25, -1.0, 1.25 };
+
+    NSArray<NSSet<NSString *> *> *extendedSegments = nil;
+
+    // the contours share their working storage, so only one can be alive at a time
+    @autoreleasepool {
+        CPTListContour *contour = [self contourWithLimits:limits columns:32 rows:32];
+
+        XCTAssertTrue([contour generate]);
+        XCTAssertTrue([contour extendToLimits:extendedLimits], @"dense field extends");
+        XCTAssertEqual([contour getNoColumnsSecondaryGrid], (NSUInteger)40);
+        XCTAssertEqual([contour getNoRowsSecondaryGrid], (NSUInteger)36);
+
+        extendedSegments = [self segmentsOfContour:contour];
+    }
+
+    @autoreleasepool {
+        CPTListContour *contour = [self contourWithLimits:extendedLimits columns:40 rows:36];
+
+        XCTAssertTrue([contour generate]);
+
+        NSArray<NSSet<NSString *> *> *freshSegments = [self segmentsOfContour:contour];
+
+        XCTAssertEqual(extendedSegments.count, freshSegments.count);
+        for ( NSUInteger i = 0; i < MIN(extendedSegments.count, freshSegments.count); i++ ) {
+            XCTAssertTrue(freshSegments[i].count > 0, @"isocurve %lu", (unsigned long)i);
+            XCTAssertEqualObjects(extendedSegments[i], freshSegments[i], @"isocurve %lu", (unsigned long)i);
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Performance
+
+-(void)testSerialGenerationPerformance
+{
+    [self measureBlock:^{
+        double limits[] = { -1.0, 1.0, -1.0, 1.0 };
+
+        @autoreleasepool {
+            CPTListContour *contour = [self contourWithLimits:limits columns:512 rows:512];
+
+            contour.denseGeneration = NO;
+            [contour generate];
+        }
+    }];
+}
+
+-(void)testDenseGenerationPerformance
+{
+    [self measureBlock:^{
+        double limits[] = { -1.0, 1.0, -1.0, 1.0 };
+
+        @autoreleasepool {
+            CPTListContour *contour = [self contourWithLimits:limits columns:512 rows:512];
+
+            // evaluated in column tiles and traced one isocurve per worker
+            contour.concurrentGeneration = YES;
+            [contour generate];
+        }
+    }];
+}
+
+@end
@@ -3,6 +3,629 @@
 #import "complex.h"
 #import "CPTUtilities.h"
 
+/// @cond
+
+#pragma mark -
+#pragma mark Conversion kernels
+
+// Buffers with at least this many samples are converted on several threads
+static const NSUInteger CPTConversionParallelThreshold = 1024 * 1024;
+
+// Samples converted by each thread at a time, small enough to stay in the cache of one core
+static const NSUInteger CPTConversionChunkSize = 64 * 1024;
+
+// Samples converted together by the vector kernels
+#define CPTConversionLanes 8
+
+// Number of real numeric types with a conversion kernel, see CPTConversionKernelIndex()
+#define CPTConversionKernelTypeCount 10
+
+typedef int8_t CPTInt8Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef int16_t CPTInt16Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef int32_t CPTInt32Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef int64_t CPTInt64Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef uint8_t CPTUInt8Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef uint16_t CPTUInt16Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef uint32_t CPTUInt32Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef uint64_t CPTUInt64Vector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef float CPTFloatVector __attribute__((ext_vector_type(CPTConversionLanes)));
+typedef double CPTDoubleVector __attribute__((ext_vector_type(CPTConversionLanes)));
+
+typedef void (*CPTConversionKernelFunction)(const void *source, void *dest, NSUInteger count);
+
+// Converts CPTConversionLanes samples per step; each vector is loaded before it is stored, so a
+// conversion to a type no larger than the source can run in place
+#define CPTConversionKernel(fromName, fromType, toName, toType)                                                 \
+    static void CPTConvert ## fromName ## To ## toName(const void *source, void *dest, NSUInteger count)       \
+    {                                                                                                           \
+        const fromType *fromSamples = (const fromType *)source;                                                 \
+        toType *toSamples           = (toType *)dest;                                                           \
+        NSUInteger i                = 0;                                                                        \
+                                                                                                                \
+        for ( ; i + CPTConversionLanes <= count; i += CPTConversionLanes ) {                                    \
+            CPT ## fromName ## Vector fromVector;                                                               \
+            memcpy(&fromVector, fromSamples + i, sizeof(fromVector));                                           \
+            CPT ## toName ## Vector toVector = __builtin_convertvector(fromVector, CPT ## toName ## Vector);     \
+            memcpy(toSamples + i, &toVector, sizeof(toVector));                                                 \
+        }                                                                                                       \
+        for ( ; i < count; i++ ) {                                                                              \
+            toSamples[i] = (toType)fromSamples[i];                                                              \
+        }                                                                                                       \
+    }
+
+// Swaps the byte order of each source sample as it is read, saving a separate pass over the buffer
+#define CPTSwappedConversionKernel(fromName, fromType, bitsType, swapFunction, toName, toType)                  \
+    static void CPTConvertSwapped ## fromName ## To ## toName(const void *source, void *dest, NSUInteger count) \
+    {                                                                                                           \
+        const bitsType *fromBits = (const bitsType *)source;                                                    \
+        toType *toSamples        = (toType *)dest;                                                              \
+                                                                                                                \
+        for ( NSUInteger i = 0; i < count; i++ ) {                                                              \
+            bitsType bits = swapFunction(fromBits[i]);                                                          \
+            fromType sample;                                                                                    \
+            memcpy(&sample, &bits, sizeof(sample));                                                             \
+            toSamples[i] = (toType)sample;                                                                      \
+        }                                                                                                       \
+    }
+
+// Code generated with "CPTNumericData+TypeConversions_Generation.py"
+// ========================================================================
+
+CPTConversionKernel(Int8, int8_t, Int8, int8_t)
+CPTConversionKernel(Int8, int8_t, Int16, int16_t)
+CPTConversionKernel(Int8, int8_t, Int32, int32_t)
+CPTConversionKernel(Int8, int8_t, Int64, int64_t)
+CPTConversionKernel(Int8, int8_t, UInt8, uint8_t)
+CPTConversionKernel(Int8, int8_t, UInt16, uint16_t)
+CPTConversionKernel(Int8, int8_t, UInt32, uint32_t)
+CPTConversionKernel(Int8, int8_t, UInt64, uint64_t)
+CPTConversionKernel(Int8, int8_t, Float, float)
+CPTConversionKernel(Int8, int8_t, Double, double)
+CPTConversionKernel(Int16, int16_t, Int8, int8_t)
+CPTConversionKernel(Int16, int16_t, Int16, int16_t)
+CPTConversionKernel(Int16, int16_t, Int32, int32_t)
+CPTConversionKernel(Int16, int16_t, Int64, int64_t)
+CPTConversionKernel(Int16, int16_t, UInt8, uint8_t)
+CPTConversionKernel(Int16, int16_t, UInt16, uint16_t)
+CPTConversionKernel(Int16, int16_t, UInt32, uint32_t)
+CPTConversionKernel(Int16, int16_t, UInt64, uint64_t)
+CPTConversionKernel(Int16, int16_t, Float, float)
+CPTConversionKernel(Int16, int16_t, Double, double)
+CPTConversionKernel(Int32, int32_t, Int8, int8_t)
+CPTConversionKernel(Int32, int32_t, Int16, int16_t)
+CPTConversionKernel(Int32, int32_t, Int32, int32_t)
+CPTConversionKernel(Int32, int32_t, Int64, int64_t)
+CPTConversionKernel(Int32, int32_t, UInt8, uint8_t)
+CPTConversionKernel(Int32, int32_t, UInt16, uint16_t)
+CPTConversionKernel(Int32, int32_t, UInt32, uint32_t)
+CPTConversionKernel(Int32, int32_t, UInt64, uint64_t)
+CPTConversionKernel(Int32, int32_t, Float, float)
+CPTConversionKernel(Int32, int32_t, Double, double)
+CPTConversionKernel(Int64, int64_t, Int8, int8_t)
+CPTConversionKernel(Int64, int64_t, Int16, int16_t)
+CPTConversionKernel(Int64, int64_t, Int32, int32_t)
+CPTConversionKernel(Int64, int64_t, Int64, int64_t)
+CPTConversionKernel(Int64, int64_t, UInt8, uint8_t)
+CPTConversionKernel(Int64, int64_t, UInt16, uint16_t)
+CPTConversionKernel(Int64, int64_t, UInt32, uint32_t)
+CPTConversionKernel(Int64, int64_t, UInt64, uint64_t)
+CPTConversionKernel(Int64, int64_t, Float, float)
+CPTConversionKernel(Int64, int64_t, Double, double)
+CPTConversionKernel(UInt8, uint8_t, Int8, int8_t)
+CPTConversionKernel(UInt8, uint8_t, Int16, int16_t)
+CPTConversionKernel(UInt8, uint8_t, Int32, int32_t)
+CPTConversionKernel(UInt8, uint8_t, Int64, int64_t)
+CPTConversionKernel(UInt8, uint8_t, UInt8, uint8_t)
+CPTConversionKernel(UInt8, uint8_t, UInt16, uint16_t)
+CPTConversionKernel(UInt8, uint8_t, UInt32, uint32_t)
+CPTConversionKernel(UInt8, uint8_t, UInt64, uint64_t)
+CPTConversionKernel(UInt8, uint8_t, Float, float)
+CPTConversionKernel(UInt8, uint8_t, Double, double)
+CPTConversionKernel(UInt16, uint16_t, Int8, int8_t)
+CPTConversionKernel(UInt16, uint16_t, Int16, int16_t)
+CPTConversionKernel(UInt16, uint16_t, Int32, int32_t)
+CPTConversionKernel(UInt16, uint16_t, Int64, int64_t)
+CPTConversionKernel(UInt16, uint16_t, UInt8, uint8_t)
+CPTConversionKernel(UInt16, uint16_t, UInt16, uint16_t)
+CPTConversionKernel(UInt16, uint16_t, UInt32, uint32_t)
+CPTConversionKernel(UInt16, uint16_t, UInt64, uint64_t)
+CPTConversionKernel(UInt16, uint16_t, Float, float)
+CPTConversionKernel(UInt16, uint16_t, Double, double)
+CPTConversionKernel(UInt32, uint32_t, Int8, int8_t)
+CPTConversionKernel(UInt32, uint32_t, Int16, int16_t)
+CPTConversionKernel(UInt32, uint32_t, Int32, int32_t)
+CPTConversionKernel(UInt32, uint32_t, Int64, int64_t)
+CPTConversionKernel(UInt32, uint32_t, UInt8, uint8_t)
+CPTConversionKernel(UInt32, uint32_t, UInt16, uint16_t)
+CPTConversionKernel(UInt32, uint32_t, UInt32, uint32_t)
+CPTConversionKernel(UInt32, uint32_t, UInt64, uint64_t)
+CPTConversionKernel(UInt32, uint32_t, Float, float)
+CPTConversionKernel(UInt32, uint32_t, Double, double)
+CPTConversionKernel(UInt64, uint64_t, Int8, int8_t)
+CPTConversionKernel(UInt64, uint64_t, Int16, int16_t)
+CPTConversionKernel(UInt64, uint64_t, Int32, int32_t)
+CPTConversionKernel(UInt64, uint64_t, Int64, int64_t)
+CPTConversionKernel(UInt64, uint64_t, UInt8, uint8_t)
+CPTConversionKernel(UInt64, uint64_t, UInt16, uint16_t)
+CPTConversionKernel(UInt64, uint64_t, UInt32, uint32_t)
+CPTConversionKernel(UInt64, uint64_t, UInt64, uint64_t)
+CPTConversionKernel(UInt64, uint64_t, Float, float)
+CPTConversionKernel(UInt64, uint64_t, Double, double)
+CPTConversionKernel(Float, float, Int8, int8_t)
+CPTConversionKernel(Float, float, Int16, int16_t)
+CPTConversionKernel(Float, float, Int32, int32_t)
+CPTConversionKernel(Float, float, Int64, int64_t)
+CPTConversionKernel(Float, float, UInt8, uint8_t)
+CPTConversionKernel(Float, float, UInt16, uint16_t)
+CPTConversionKernel(Float, float, UInt32, uint32_t)
+CPTConversionKernel(Float, float, UInt64, uint64_t)
+CPTConversionKernel(Float, float, Float, float)
+CPTConversionKernel(Float, float, Double, double)
+CPTConversionKernel(Double, double, Int8, int8_t)
+CPTConversionKernel(Double, double, Int16, int16_t)
+CPTConversionKernel(Double, double, Int32, int32_t)
+CPTConversionKernel(Double, double, Int64, int64_t)
+CPTConversionKernel(Double, double, UInt8, uint8_t)
+CPTConversionKernel(Double, double, UInt16, uint16_t)
+CPTConversionKernel(Double, double, UInt32, uint32_t)
+CPTConversionKernel(Double, double, UInt64, uint64_t)
+CPTConversionKernel(Double, double, Float, float)
+CPTConversionKernel(Double, double, Double, double)
+
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Int8, int8_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Int16, int16_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Int32, int32_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Int64, int64_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, UInt8, uint8_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, UInt16, uint16_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, UInt32, uint32_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, UInt64, uint64_t)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Float, float)
+CPTSwappedConversionKernel(Int16, int16_t, uint16_t, CFSwapInt16, Double, double)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Int8, int8_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Int16, int16_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Int32, int32_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Int64, int64_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, UInt8, uint8_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, UInt16, uint16_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, UInt32, uint32_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, UInt64, uint64_t)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Float, float)
+CPTSwappedConversionKernel(Int32, int32_t, uint32_t, CFSwapInt32, Double, double)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Int8, int8_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Int16, int16_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Int32, int32_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Int64, int64_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, UInt8, uint8_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, UInt16, uint16_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, UInt32, uint32_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, UInt64, uint64_t)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Float, float)
+CPTSwappedConversionKernel(Int64, int64_t, uint64_t, CFSwapInt64, Double, double)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Int8, int8_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Int16, int16_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Int32, int32_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Int64, int64_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, UInt8, uint8_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, UInt16, uint16_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, UInt32, uint32_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, UInt64, uint64_t)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Float, float)
+CPTSwappedConversionKernel(UInt16, uint16_t, uint16_t, CFSwapInt16, Double, double)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Int8, int8_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Int16, int16_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Int32, int32_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Int64, int64_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, UInt8, uint8_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, UInt16, uint16_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, UInt32, uint32_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, UInt64, uint64_t)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Float, float)
+CPTSwappedConversionKernel(UInt32, uint32_t, uint32_t, CFSwapInt32, Double, double)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Int8, int8_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Int16, int16_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Int32, int32_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Int64, int64_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, UInt8, uint8_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, UInt16, uint16_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, UInt32, uint32_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, UInt64, uint64_t)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Float, float)
+CPTSwappedConversionKernel(UInt64, uint64_t, uint64_t, CFSwapInt64, Double, double)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Int8, int8_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Int16, int16_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Int32, int32_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Int64, int64_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, UInt8, uint8_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, UInt16, uint16_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, UInt32, uint32_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, UInt64, uint64_t)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Float, float)
+CPTSwappedConversionKernel(Float, float, uint32_t, CFSwapInt32, Double, double)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Int8, int8_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Int16, int16_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Int32, int32_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Int64, int64_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, UInt8, uint8_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, UInt16, uint16_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, UInt32, uint32_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, UInt64, uint64_t)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Float, float)
+CPTSwappedConversionKernel(Double, double, uint64_t, CFSwapInt64, Double, double)
+
+static const CPTConversionKernelFunction CPTConversionKernels[CPTConversionKernelTypeCount][CPTConversionKernelTypeCount] = {
+    { // int8_t
+        CPTConvertInt8ToInt8,
+        CPTConvertInt8ToInt16,
+        CPTConvertInt8ToInt32,
+        CPTConvertInt8ToInt64,
+        CPTConvertInt8ToUInt8,
+        CPTConvertInt8ToUInt16,
+        CPTConvertInt8ToUInt32,
+        CPTConvertInt8ToUInt64,
+        CPTConvertInt8ToFloat,
+        CPTConvertInt8ToDouble,
+    },
+    { // int16_t
+        CPTConvertInt16ToInt8,
+        CPTConvertInt16ToInt16,
+        CPTConvertInt16ToInt32,
+        CPTConvertInt16ToInt64,
+        CPTConvertInt16ToUInt8,
+        CPTConvertInt16ToUInt16,
+        CPTConvertInt16ToUInt32,
+        CPTConvertInt16ToUInt64,
+        CPTConvertInt16ToFloat,
+        CPTConvertInt16ToDouble,
+    },
+    { // int32_t
+        CPTConvertInt32ToInt8,
+        CPTConvertInt32ToInt16,
+        CPTConvertInt32ToInt32,
+        CPTConvertInt32ToInt64,
+        CPTConvertInt32ToUInt8,
+        CPTConvertInt32ToUInt16,
+        CPTConvertInt32ToUInt32,
+        CPTConvertInt32ToUInt64,
+        CPTConvertInt32ToFloat,
+        CPTConvertInt32ToDouble,
+    },
+    { // int64_t
+        CPTConvertInt64ToInt8,
+        CPTConvertInt64ToInt16,
+        CPTConvertInt64ToInt32,
+        CPTConvertInt64ToInt64,
+        CPTConvertInt64ToUInt8,
+        CPTConvertInt64ToUInt16,
+        CPTConvertInt64ToUInt32,
+        CPTConvertInt64ToUInt64,
+        CPTConvertInt64ToFloat,
+        CPTConvertInt64ToDouble,
+    },
+    { // uint8_t
+        CPTConvertUInt8ToInt8,
+        CPTConvertUInt8ToInt16,
+        CPTConvertUInt8ToInt32,
+        CPTConvertUInt8ToInt64,
+        CPTConvertUInt8ToUInt8,
+        CPTConvertUInt8ToUInt16,
+        CPTConvertUInt8ToUInt32,
+        CPTConvertUInt8ToUInt64,
+        CPTConvertUInt8ToFloat,
+        CPTConvertUInt8ToDouble,
+    },
+    { // uint16_t
+        CPTConvertUInt16ToInt8,
+        CPTConvertUInt16ToInt16,
+        CPTConvertUInt16ToInt32,
+        CPTConvertUInt16ToInt64,
+        CPTConvertUInt16ToUInt8,
+        CPTConvertUInt16ToUInt16,
+        CPTConvertUInt16ToUInt32,
+        CPTConvertUInt16ToUInt64,
+        CPTConvertUInt16ToFloat,
+        CPTConvertUInt16ToDouble,
+    },
+    { // uint32_t
+        CPTConvertUInt32ToInt8,
+        CPTConvertUInt32ToInt16,
+        CPTConvertUInt32ToInt32,
+        CPTConvertUInt32ToInt64,
+        CPTConvertUInt32ToUInt8,
+        CPTConvertUInt32ToUInt16,
+        CPTConvertUInt32ToUInt32,
+        CPTConvertUInt32ToUInt64,
+        CPTConvertUInt32ToFloat,
+        CPTConvertUInt32ToDouble,
+    },
+    { // uint64_t
+        CPTConvertUInt64ToInt8,
+        CPTConvertUInt64ToInt16,
+        CPTConvertUInt64ToInt32,
+        CPTConvertUInt64ToInt64,
+        CPTConvertUInt64ToUInt8,
+        CPTConvertUInt64ToUInt16,
+        CPTConvertUInt64ToUInt32,
+        CPTConvertUInt64ToUInt64,
+        CPTConvertUInt64ToFloat,
+        CPTConvertUInt64ToDouble,
+    },
+    { // float
+        CPTConvertFloatToInt8,
+        CPTConvertFloatToInt16,
+        CPTConvertFloatToInt32,
+        CPTConvertFloatToInt64,
+        CPTConvertFloatToUInt8,
+        CPTConvertFloatToUInt16,
+        CPTConvertFloatToUInt32,
+        CPTConvertFloatToUInt64,
+        CPTConvertFloatToFloat,
+        CPTConvertFloatToDouble,
+    },
+    { // double
+        CPTConvertDoubleToInt8,
+        CPTConvertDoubleToInt16,
+        CPTConvertDoubleToInt32,
+        CPTConvertDoubleToInt64,
+        CPTConvertDoubleToUInt8,
+        CPTConvertDoubleToUInt16,
+        CPTConvertDoubleToUInt32,
+        CPTConvertDoubleToUInt64,
+        CPTConvertDoubleToFloat,
+        CPTConvertDoubleToDouble,
+    },
+};
+
+static const CPTConversionKernelFunction CPTSwappedConversionKernels[CPTConversionKernelTypeCount][CPTConversionKernelTypeCount] = {
+    { // int8_t
+        CPTConvertInt8ToInt8,
+        CPTConvertInt8ToInt16,
+        CPTConvertInt8ToInt32,
+        CPTConvertInt8ToInt64,
+        CPTConvertInt8ToUInt8,
+        CPTConvertInt8ToUInt16,
+        CPTConvertInt8ToUInt32,
+        CPTConvertInt8ToUInt64,
+        CPTConvertInt8ToFloat,
+        CPTConvertInt8ToDouble,
+    },
+    { // int16_t
+        CPTConvertSwappedInt16ToInt8,
+        CPTConvertSwappedInt16ToInt16,
+        CPTConvertSwappedInt16ToInt32,
+        CPTConvertSwappedInt16ToInt64,
+        CPTConvertSwappedInt16ToUInt8,
+        CPTConvertSwappedInt16ToUInt16,
+        CPTConvertSwappedInt16ToUInt32,
+        CPTConvertSwappedInt16ToUInt64,
+        CPTConvertSwappedInt16ToFloat,
+        CPTConvertSwappedInt16ToDouble,
+    },
+    { // int32_t
+        CPTConvertSwappedInt32ToInt8,
+        CPTConvertSwappedInt32ToInt16,
+        CPTConvertSwappedInt32ToInt32,
+        CPTConvertSwappedInt32ToInt64,
+        CPTConvertSwappedInt32ToUInt8,
+        CPTConvertSwappedInt32ToUInt16,
+        CPTConvertSwappedInt32ToUInt32,
+        CPTConvertSwappedInt32ToUInt64,
+        CPTConvertSwappedInt32ToFloat,
+        CPTConvertSwappedInt32ToDouble,
+    },
+    { // int64_t
+        CPTConvertSwappedInt64ToInt8,
+        CPTConvertSwappedInt64ToInt16,
+        CPTConvertSwappedInt64ToInt32,
+        CPTConvertSwappedInt64ToInt64,
+        CPTConvertSwappedInt64ToUInt8,
+        CPTConvertSwappedInt64ToUInt16,
+        CPTConvertSwappedInt64ToUInt32,
+        CPTConvertSwappedInt64ToUInt64,
+        CPTConvertSwappedInt64ToFloat,
+        CPTConvertSwappedInt64ToDouble,
+    },
+    { // uint8_t
+        CPTConvertUInt8ToInt8,
+        CPTConvertUInt8ToInt16,
+        CPTConvertUInt8ToInt32,
+        CPTConvertUInt8ToInt64,
+        CPTConvertUInt8ToUInt8,
+        CPTConvertUInt8ToUInt16,
+        CPTConvertUInt8ToUInt32,
+        CPTConvertUInt8ToUInt64,
+        CPTConvertUInt8ToFloat,
+        CPTConvertUInt8ToDouble,
+    },
+    { // uint16_t
+        CPTConvertSwappedUInt16ToInt8,
+        CPTConvertSwappedUInt16ToInt16,
+        CPTConvertSwappedUInt16ToInt32,
+        CPTConvertSwappedUInt16ToInt64,
+        CPTConvertSwappedUInt16ToUInt8,
+        CPTConvertSwappedUInt16ToUInt16,
+        CPTConvertSwappedUInt16ToUInt32,
+        CPTConvertSwappedUInt16ToUInt64,
+        CPTConvertSwappedUInt16ToFloat,
+        CPTConvertSwappedUInt16ToDouble,
+    },
+    { // uint32_t
+        CPTConvertSwappedUInt32ToInt8,
+        CPTConvertSwappedUInt32ToInt16,
+        CPTConvertSwappedUInt32ToInt32,
+        CPTConvertSwappedUInt32ToInt64,
+        CPTConvertSwappedUInt32ToUInt8,
+        CPTConvertSwappedUInt32ToUInt16,
+        CPTConvertSwappedUInt32ToUInt32,
+        CPTConvertSwappedUInt32ToUInt64,
+        CPTConvertSwappedUInt32ToFloat,
+        CPTConvertSwappedUInt32ToDouble,
+    },
+    { // uint64_t
+        CPTConvertSwappedUInt64ToInt8,
+        CPTConvertSwappedUInt64ToInt16,
+        CPTConvertSwappedUInt64ToInt32,
+        CPTConvertSwappedUInt64ToInt64,
+        CPTConvertSwappedUInt64ToUInt8,
+        CPTConvertSwappedUInt64ToUInt16,
+        CPTConvertSwappedUInt64ToUInt32,
+        CPTConvertSwappedUInt64ToUInt64,
+        CPTConvertSwappedUInt64ToFloat,
+        CPTConvertSwappedUInt64ToDouble,
+    },
+    { // float
+        CPTConvertSwappedFloatToInt8,
+        CPTConvertSwappedFloatToInt16,
+        CPTConvertSwappedFloatToInt32,
+        CPTConvertSwappedFloatToInt64,
+        CPTConvertSwappedFloatToUInt8,
+        CPTConvertSwappedFloatToUInt16,
+        CPTConvertSwappedFloatToUInt32,
+        CPTConvertSwappedFloatToUInt64,
+        CPTConvertSwappedFloatToFloat,
+        CPTConvertSwappedFloatToDouble,
+    },
+    { // double
+        CPTConvertSwappedDoubleToInt8,
+        CPTConvertSwappedDoubleToInt16,
+        CPTConvertSwappedDoubleToInt32,
+        CPTConvertSwappedDoubleToInt64,
+        CPTConvertSwappedDoubleToUInt8,
+        CPTConvertSwappedDoubleToUInt16,
+        CPTConvertSwappedDoubleToUInt32,
+        CPTConvertSwappedDoubleToUInt64,
+        CPTConvertSwappedDoubleToFloat,
+        CPTConvertSwappedDoubleToDouble,
+    },
+};
+
+// End of code generated with "CPTNumericData+TypeConversions_Generation.py"
+// ========================================================================
+
+#undef CPTConversionKernel
+#undef CPTSwappedConversionKernel
+
+/** @internal
+ *  @brief Returns the row or column of a data type in the conversion kernel tables.
+ *  @param dataType The data type.
+ *  @return The index of the type, or @num{-1} if there is no kernel for it.
+ **/
+static NSInteger CPTConversionKernelIndex(CPTNumericDataType dataType)
+{
+    NSInteger sizeIndex = -1;
+
+    switch ( dataType.sampleBytes ) {
+        case sizeof(int8_t):
+            sizeIndex = 0;
+            break;
+
+        case sizeof(int16_t):
+            sizeIndex = 1;
+            break;
+
+        case sizeof(int32_t):
+            sizeIndex = 2;
+            break;
+
+        case sizeof(int64_t):
+            sizeIndex = 3;
+            break;
+    }
+
+    if ( sizeIndex < 0 ) {
+        return -1;
+    }
+
+    switch ( dataType.dataTypeFormat ) {
+        case CPTIntegerDataType:
+            return sizeIndex;
+
+        case CPTUnsignedIntegerDataType:
+            return 4 + sizeIndex;
+
+        case CPTFloatingPointDataType:
+            if ( dataType.sampleBytes == sizeof(float)) {
+                return 8;
+            }
+            else if ( dataType.sampleBytes == sizeof(double)) {
+                return 9;
+            }
+            return -1;
+
+        case CPTUndefinedDataType:
+        case CPTComplexFloatingPointDataType:
+        case CPTDecimalDataType:
+            return -1;
+    }
+
+    return -1;
+}
+
+/** @internal
+ *  @brief Finds the vector kernel that converts between two data types.
+ *  @param sourceDataType The data type of the source samples.
+ *  @param destDataType   The data type of the converted samples.
+ *  @param swapSource     If @YES, the source samples are in the opposite byte order to the host.
+ *  @return The kernel, or @NULL if complex or decimal numbers are involved.
+ **/
+static CPTConversionKernelFunction CPTConversionKernelForTypes(CPTNumericDataType sourceDataType, CPTNumericDataType destDataType, BOOL swapSource)
+{
+    NSInteger sourceIndex = CPTConversionKernelIndex(sourceDataType);
+    NSInteger destIndex   = CPTConversionKernelIndex(destDataType);
+
+    if ((sourceIndex < 0) || (destIndex < 0)) {
+        return NULL;
+    }
+
+    return swapSource ? CPTSwappedConversionKernels[sourceIndex][destIndex] : CPTConversionKernels[sourceIndex][destIndex];
+}
+
+/** @internal
+ *  @brief Calls a block for consecutive chunks of a buffer, on several threads if the buffer is large.
+ *  @param sampleCount The number of samples in the buffer.
+ *  @param parallel    If @NO, the chunks are processed in order on the calling thread.
+ *  @param block       The block called with the first sample and the number of samples of each chunk.
+ **/
+static void CPTApplyInChunks(NSUInteger sampleCount, BOOL parallel, void (^__nonnull block)(NSUInteger first, NSUInteger count))
+{
+    if ( !parallel || (sampleCount < CPTConversionParallelThreshold)) {
+        block(0, sampleCount);
+        return;
+    }
+
+    size_t chunkCount = (sampleCount + CPTConversionChunkSize - 1) / CPTConversionChunkSize;
+
+    dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger first = (NSUInteger)chunk * CPTConversionChunkSize;
+        block(first, MIN(CPTConversionChunkSize, sampleCount - first));
+    });
+}
+
+/** @internal
+ *  @brief Runs a conversion kernel over a buffer.
+ *
+ *  An in-place conversion to a smaller type is run on one thread, since a chunk
+ *  would otherwise overwrite source samples another thread has not read yet.
+ *  @param kernel          The conversion kernel.
+ *  @param source          The source samples.
+ *  @param sourceSampleSize The size of each source sample in bytes.
+ *  @param dest            The destination buffer.
+ *  @param destSampleSize  The size of each converted sample in bytes.
+ *  @param sampleCount     The number of samples to convert.
+ **/
+static void CPTRunConversionKernel(CPTConversionKernelFunction kernel, const void *source, size_t sourceSampleSize, void *dest, size_t destSampleSize, NSUInteger sampleCount)
+{
+    BOOL parallel = (source != dest) || (sourceSampleSize == destSampleSize);
+
+    CPTApplyInChunks(sampleCount, parallel, ^(NSUInteger first, NSUInteger count) {
+        kernel((const int8_t *)source + first * sourceSampleSize, (int8_t *)dest + first * destSampleSize, count);
+    });
+}
+
+/// @endcond
+
+#pragma mark -
+
 @implementation CPTNumericData(TypeConversion)
 
 /** @brief Copies the current numeric data and converts the data to a new data type.
@@ -47,17 +670,13 @@
 
         newData = [[NSMutableData alloc] initWithLength:(sampleCount * newDataType.sampleBytes)];
 
-        NSData *sourceData = nil;
         if ( myDataType.byteOrder != hostByteOrder ) {
-            sourceData = [self.data mutableCopy];
-            [self swapByteOrderForData:(NSMutableData *)sourceData sampleSize:myDataType.sampleBytes];
+            [self convertSwappedData:self.data dataType:&myDataType toData:(NSMutableData *)newData dataType:&newDataType];
         }
         else {
-            sourceData = self.data;
+            [self convertData:self.data dataType:&myDataType toData:(NSMutableData *)newData dataType:&newDataType];
         }
 
-        [self convertData:sourceData dataType:&myDataType toData:(NSMutableData *)newData dataType:&newDataType];
-
         if ( newDataType.byteOrder != hostByteOrder ) {
             [self swapByteOrderForData:(NSMutableData *)newData sampleSize:newDataType.sampleBytes];
         }
@@ -76,6 +695,9 @@
 /** @brief Copies a data buffer and converts the data to a new data type without changing the byte order.
  *
  *  The data is assumed to be in host byte order and no byte order conversion is performed.
+ *  Conversions between integer and floating point types run in vector kernels, split across
+ *  several threads for large buffers. The destination may be the source buffer if the new
+ *  samples are no larger than the old ones.
  *  @param sourceData     The source data buffer.
  *  @param sourceDataType The data type of the source.
  *  @param destData       The destination data buffer.
@@ -85,6 +707,65 @@
           dataType:(nonnull CPTNumericDataType *)sourceDataType
             toData:(nonnull NSMutableData *)destData
           dataType:(nonnull CPTNumericDataType *)destDataType
+{
+    CPTConversionKernelFunction kernel = CPTConversionKernelForTypes(*sourceDataType, *destDataType, NO);
+
+    if ( kernel ) {
+        CPTRunConversionKernel(kernel,
+                               sourceData.bytes, sourceDataType->sampleBytes,
+                               destData.mutableBytes, destDataType->sampleBytes,
+                               sourceData.length / sourceDataType->sampleBytes);
+    }
+    else {
+        [self scalarConvertData:sourceData dataType:sourceDataType toData:destData dataType:destDataType];
+    }
+}
+
+/** @brief Copies a data buffer in the opposite byte order to the host and converts the data to a new data type in host byte order.
+ *
+ *  The byte order of each sample is swapped as it is converted, without a separate pass over the data.
+ *  The destination may be the source buffer if the new samples are no larger than the old ones.
+ *  @param sourceData     The source data buffer.
+ *  @param sourceDataType The data type of the source.
+ *  @param destData       The destination data buffer.
+ *  @param destDataType   The new data type.
+ **/
+-(void)convertSwappedData:(nonnull NSData *)sourceData
+                 dataType:(nonnull CPTNumericDataType *)sourceDataType
+                   toData:(nonnull NSMutableData *)destData
+                 dataType:(nonnull CPTNumericDataType *)destDataType
+{
+    CPTConversionKernelFunction kernel = CPTConversionKernelForTypes(*sourceDataType, *destDataType, YES);
+
+    if ( kernel ) {
+        CPTRunConversionKernel(kernel,
+                               sourceData.bytes, sourceDataType->sampleBytes,
+                               destData.mutableBytes, destDataType->sampleBytes,
+                               sourceData.length / sourceDataType->sampleBytes);
+    }
+    else {
+        NSMutableData *swappedData = [sourceData mutableCopy];
+        [self swapByteOrderForData:swappedData sampleSize:sourceDataType->sampleBytes];
+
+        [self convertData:swappedData dataType:sourceDataType toData:destData dataType:destDataType];
+    }
+}
+
+/// @cond
+
+/** @internal
+ *  @brief Converts a data buffer one sample at a time.
+ *
+ *  Handles every data type, including complex and decimal numbers, which have no vector kernels.
+ *  @param sourceData     The source data buffer.
+ *  @param sourceDataType The data type of the source.
+ *  @param destData       The destination data buffer.
+ *  @param destDataType   The new data type.
+ **/
+-(void)scalarConvertData:(nonnull NSData *)sourceData
+                dataType:(nonnull CPTNumericDataType *)sourceDataType
+                  toData:(nonnull NSMutableData *)destData
+                dataType:(nonnull CPTNumericDataType *)destDataType
 {
     NSUInteger sampleCount = sourceData.length / sourceDataType->sampleBytes;
 
@@ -2252,51 +2933,55 @@
     // ========================================================================
 }
 
+/// @endcond
+
 /** @brief Swaps the byte order for each sample stored in a data buffer.
+ *
+ *  Large buffers are swapped on several threads.
  *  @param sourceData The data buffer.
  *  @param sampleSize The number of bytes in each sample stored in sourceData.
  **/
 -(void)swapByteOrderForData:(nonnull NSMutableData *)sourceData sampleSize:(size_t)sampleSize
 {
-    NSUInteger sampleCount;
+    NSUInteger sampleCount = sourceData.length / sampleSize;
 
     switch ( sampleSize ) {
         case sizeof(uint16_t):
         {
             uint16_t *samples = (uint16_t *)sourceData.mutableBytes;
-            sampleCount = sourceData.length / sampleSize;
-            uint16_t *lastSample = samples + sampleCount;
 
-            while ( samples < lastSample ) {
-                uint16_t swapped = CFSwapInt16(*samples);
-                *samples++ = swapped;
-            }
+            CPTApplyInChunks(sampleCount, YES, ^(NSUInteger first, NSUInteger count) {
+                uint16_t *chunk = samples + first;
+                for ( NSUInteger i = 0; i < count; i++ ) {
+                    chunk[i] = CFSwapInt16(chunk[i]);
+                }
+            });
             break;
         }
 
         case sizeof(uint32_t):
         {
             uint32_t *samples = (uint32_t *)sourceData.mutableBytes;
-            sampleCount = sourceData.length / sampleSize;
-            uint32_t *lastSample = samples + sampleCount;
 
-            while ( samples < lastSample ) {
-                uint32_t swapped = CFSwapInt32(*samples);
-                *samples++ = swapped;
-            }
+            CPTApplyInChunks(sampleCount, YES, ^(NSUInteger first, NSUInteger count) {
+                uint32_t *chunk = samples + first;
+                for ( NSUInteger i = 0; i < count; i++ ) {
+                    chunk[i] = CFSwapInt32(chunk[i]);
+                }
+            });
             break;
         }
 
         case sizeof(uint64_t):
         {
             uint64_t *samples = (uint64_t *)sourceData.mutableBytes;
-            sampleCount = sourceData.length / sampleSize;
-            uint64_t *lastSample = samples + sampleCount;
 
-            while ( samples < lastSample ) {
-                uint64_t swapped = CFSwapInt64(*samples);
-                *samples++ = swapped;
-            }
+            CPTApplyInChunks(sampleCount, YES, ^(NSUInteger first, NSUInteger count) {
+                uint64_t *chunk = samples + first;
+                for ( NSUInteger i = 0; i < count; i++ ) {
+                    chunk[i] = CFSwapInt64(chunk[i]);
+                }
+            });
             break;
         }
 
@@ -1,3 +1,5 @@
+from __future__ import print_function
+
 dataTypes = ["CPTUndefinedDataType", "CPTIntegerDataType", "CPTUnsignedIntegerDataType", "CPTFloatingPointDataType", "CPTComplexFloatingPointDataType", "CPTDecimalDataType"]
 
 types = { "CPTUndefinedDataType" : [],
@@ -52,98 +54,166 @@ null_values = { "int8_t" : "0",
              "NSDecimal" : "CPTDecimalNaN()"
 }
 
-print "[CPTNumericData sampleValue:]"
-print ""
-print "switch ( self.dataTypeFormat ) {"
+print("[CPTNumericData sampleValue:]")
+print("")
+print("switch ( self.dataTypeFormat ) {")
 for dt in dataTypes:
-    print "\tcase %s:" % dt
+    print("\tcase %s:" % dt)
     if ( len(types[dt]) == 0 ):
-        print '\t\t[NSException raise:NSInvalidArgumentException format:@"Unsupported data type (%s)"];' % (dt)
+        print('\t\t[NSException raise:NSInvalidArgumentException format:@"Unsupported data type (%s)"];' % (dt))
     else:
-        print "\t\tswitch ( self.sampleBytes ) {"
+        print("\t\tswitch ( self.sampleBytes ) {")
         for t in types[dt]:
-            print "\t\t\tcase sizeof(%s):" % t
+            print("\t\t\tcase sizeof(%s):" % t)
             if ( t == "float complex" ):
-                print "\t\t\t\tresult = @(*( crealf(const %s *)[self samplePointer:sample]) );" % (t)
+                print("\t\t\t\tresult = @(*( crealf(const %s *)[self samplePointer:sample]) );" % (t))
             elif ( t == "double complex" ):
-                print "\t\t\t\tresult = @(*( creal(const %s *)[self samplePointer:sample]) );" % (t)
+                print("\t\t\t\tresult = @(*( creal(const %s *)[self samplePointer:sample]) );" % (t))
             elif ( t == "NSDecimal" ):
-                print "\t\t\t\tresult = [NSDecimalNumber decimalNumberWithDecimal:*(const %s *)[self samplePointer:sample]];" % (t)
+                print("\t\t\t\tresult = [NSDecimalNumber decimalNumberWithDecimal:*(const %s *)[self samplePointer:sample]];" % (t))
             else:
-                print "\t\t\t\tresult = @(*(const %s *)[self samplePointer:sample]);" % (t)
-            print "\t\t\t\tbreak;"
-        print "\t\t}"
-    print "\t\tbreak;"
-print "}"
-
-print "\n\n"
-print "---------------"
-print "\n\n"
-
-print "[CPTNumericData dataFromArray:dataType:]"
-print ""
-print "switch ( newDataType.dataTypeFormat ) {"
+                print("\t\t\t\tresult = @(*(const %s *)[self samplePointer:sample]);" % (t))
+            print("\t\t\t\tbreak;")
+        print("\t\t}")
+    print("\t\tbreak;")
+print("}")
+
+print("\n\n")
+print("---------------")
+print("\n\n")
+
+print("[CPTNumericData dataFromArray:dataType:]")
+print("")
+print("switch ( newDataType.dataTypeFormat ) {")
 for dt in dataTypes:
-    print "\tcase %s:" % dt
+    print("\tcase %s:" % dt)
     if ( len(types[dt]) == 0 ):
-        print "\t\t// Unsupported"
+        print("\t\t// Unsupported")
     else:
-        print "\t\tswitch ( newDataType.sampleBytes ) {"
+        print("\t\tswitch ( newDataType.sampleBytes ) {")
         for t in types[dt]:
-            print "\t\t\tcase sizeof(%s): {" % t
-            print "\t\t\t\t%s *toBytes = (%s *)sampleData.mutableBytes;" % (t, t)
-            print "\t\t\t\tfor ( id sample in newData ) {"
-            print "\t\t\t\t\tif ( [sample respondsToSelector:@selector(%sValue)] ) {" % nsnumber_methods[t]
-            print "\t\t\t\t\t\t*toBytes++ = (%s)[sample %sValue];" % (t, nsnumber_methods[t])
-            print "\t\t\t\t\t}"
-            print "\t\t\t\t\telse {"
-            print "\t\t\t\t\t\t*toBytes++ = %s;" % null_values[t]
-            print "\t\t\t\t\t}"
-            print "\t\t\t\t}"
-            print "\t\t\t}"
-            print "\t\t\t\tbreak;"
-        print "\t\t}"
-    print "\t\tbreak;"
-print "}"
-
-print "\n\n"
-print "---------------"
-print "\n\n"
-
-print "[CPTNumericData convertData:dataType:toData:dataType:]"
-print ""
-print "switch ( sourceDataType->dataTypeFormat ) {"
+            print("\t\t\tcase sizeof(%s): {" % t)
+            print("\t\t\t\t%s *toBytes = (%s *)sampleData.mutableBytes;" % (t, t))
+            print("\t\t\t\tfor ( id sample in newData ) {")
+            print("\t\t\t\t\tif ( [sample respondsToSelector:@selector(%sValue)] ) {" % nsnumber_methods[t])
+            print("\t\t\t\t\t\t*toBytes++ = (%s)[sample %sValue];" % (t, nsnumber_methods[t]))
+            print("\t\t\t\t\t}")
+            print("\t\t\t\t\telse {")
+            print("\t\t\t\t\t\t*toBytes++ = %s;" % null_values[t])
+            print("\t\t\t\t\t}")
+            print("\t\t\t\t}")
+            print("\t\t\t}")
+            print("\t\t\t\tbreak;")
+        print("\t\t}")
+    print("\t\tbreak;")
+print("}")
+
+print("\n\n")
+print("---------------")
+print("\n\n")
+
+print("[CPTNumericData scalarConvertData:dataType:toData:dataType:]")
+print("")
+print("switch ( sourceDataType->dataTypeFormat ) {")
 for dt in dataTypes:
-    print "\tcase %s:" % dt
+    print("\tcase %s:" % dt)
     if ( len(types[dt]) > 0 ):
-        print "\t\tswitch ( sourceDataType->sampleBytes ) {"
+        print("\t\tswitch ( sourceDataType->sampleBytes ) {")
         for t in types[dt]:
-            print "\t\t\tcase sizeof(%s):" % t
-            print "\t\t\t\tswitch ( destDataType->dataTypeFormat ) {"
+            print("\t\t\tcase sizeof(%s):" % t)
+            print("\t\t\t\tswitch ( destDataType->dataTypeFormat ) {")
             for ndt in dataTypes:
-                print "\t\t\t\t\tcase %s:" % ndt
+                print("\t\t\t\t\tcase %s:" % ndt)
                 if ( len(types[ndt]) > 0 ):
-                    print "\t\t\t\t\t\tswitch ( destDataType->sampleBytes ) {"
+                    print("\t\t\t\t\t\tswitch ( destDataType->sampleBytes ) {")
                     for nt in types[ndt]:
-                        print "\t\t\t\t\t\t\tcase sizeof(%s): { // %s -> %s" % (nt, t, nt)
+                        print("\t\t\t\t\t\t\tcase sizeof(%s): { // %s -> %s" % (nt, t, nt))
                         if ( t == nt ):
-                            print "\t\t\t\t\t\t\t\t\tmemcpy(destData.mutableBytes, sourceData.bytes, sampleCount * sizeof(%s));" % t
+                            print("\t\t\t\t\t\t\t\t\tmemcpy(destData.mutableBytes, sourceData.bytes, sampleCount * sizeof(%s));" % t)
                         else:
-                            print "\t\t\t\t\t\t\t\t\tconst %s *fromBytes = (const %s *)sourceData.bytes;" % (t, t)
-                            print "\t\t\t\t\t\t\t\t\tconst %s *lastSample = fromBytes + sampleCount;" % t
-                            print "\t\t\t\t\t\t\t\t\t%s *toBytes = (%s *)destData.mutableBytes;" % (nt, nt)
+                            print("\t\t\t\t\t\t\t\t\tconst %s *fromBytes = (const %s *)sourceData.bytes;" % (t, t))
+                            print("\t\t\t\t\t\t\t\t\tconst %s *lastSample = fromBytes + sampleCount;" % t)
+                            print("\t\t\t\t\t\t\t\t\t%s *toBytes = (%s *)destData.mutableBytes;" % (nt, nt))
                             if ( t == "NSDecimal" ):
-                                print "\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = CPTDecimal%sValue(*fromBytes++);" % nsnumber_factory[nt]
+                                print("\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = CPTDecimal%sValue(*fromBytes++);" % nsnumber_factory[nt])
                             elif ( nt == "NSDecimal" ):
-                                print "\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = CPTDecimalFrom%s(*fromBytes++);" % nsnumber_factory[t]
+                                print("\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = CPTDecimalFrom%s(*fromBytes++);" % nsnumber_factory[t])
                             else:
-                                print "\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = (%s)*fromBytes++;" % nt
-                        print "\t\t\t\t\t\t\t\t}"
-                        print "\t\t\t\t\t\t\t\tbreak;"
-                    print "\t\t\t\t\t\t}"
-                print "\t\t\t\t\t\tbreak;"
-            print "\t\t\t\t}"
-            print "\t\t\t\tbreak;"
-        print "\t\t}"
-    print "\t\tbreak;"
-print "}"
+                                print("\t\t\t\t\t\t\t\t\twhile ( fromBytes < lastSample ) *toBytes++ = (%s)*fromBytes++;" % nt)
+                        print("\t\t\t\t\t\t\t\t}")
+                        print("\t\t\t\t\t\t\t\tbreak;")
+                    print("\t\t\t\t\t\t}")
+                print("\t\t\t\t\t\tbreak;")
+            print("\t\t\t\t}")
+            print("\t\t\t\tbreak;")
+        print("\t\t}")
+    print("\t\tbreak;")
+print("}")
+
+print("\n\n")
+print("---------------")
+print("\n\n")
+
+# Vector kernels for the real numeric types, in the order of CPTConversionKernelIndex()
+kernel_types = ["int8_t", "int16_t", "int32_t", "int64_t", "uint8_t", "uint16_t", "uint32_t", "uint64_t", "float", "double"]
+
+kernel_names = { "int8_t" : "Int8",
+                "int16_t" : "Int16",
+                "int32_t" : "Int32",
+                "int64_t" : "Int64",
+                "uint8_t" : "UInt8",
+               "uint16_t" : "UInt16",
+               "uint32_t" : "UInt32",
+               "uint64_t" : "UInt64",
+                  "float" : "Float",
+                 "double" : "Double"
+}
+
+# unsigned integer type with the same size, used to swap the byte order
+kernel_bits = { "int8_t" : "uint8_t",
+               "int16_t" : "uint16_t",
+               "int32_t" : "uint32_t",
+               "int64_t" : "uint64_t",
+               "uint8_t" : "uint8_t",
+              "uint16_t" : "uint16_t",
+              "uint32_t" : "uint32_t",
+              "uint64_t" : "uint64_t",
+                 "float" : "uint32_t",
+                "double" : "uint64_t"
+}
+
+kernel_swaps = { "uint16_t" : "CFSwapInt16",
+                 "uint32_t" : "CFSwapInt32",
+                 "uint64_t" : "CFSwapInt64"
+}
+
+print("[CPTNumericData conversion kernels]")
+print("")
+for t in kernel_types:
+    for nt in kernel_types:
+        print("CPTConversionKernel(%s, %s, %s, %s)" % (kernel_names[t], t, kernel_names[nt], nt))
+print("")
+for t in kernel_types:
+    if ( kernel_bits[t] in kernel_swaps ):
+        for nt in kernel_types:
+            print("CPTSwappedConversionKernel(%s, %s, %s, %s, %s, %s)" % (kernel_names[t], t, kernel_bits[t], kernel_swaps[kernel_bits[t]], kernel_names[nt], nt))
+print("")
+print("static const CPTConversionKernelFunction CPTConversionKernels[CPTConversionKernelTypeCount][CPTConversionKernelTypeCount] = {")
+for t in kernel_types:
+    print("\t{ // %s" % t)
+    for nt in kernel_types:
+        print("\t\tCPTConvert%sTo%s," % (kernel_names[t], kernel_names[nt]))
+    print("\t},")
+print("};")
+print("")
+print("static const CPTConversionKernelFunction CPTSwappedConversionKernels[CPTConversionKernelTypeCount][CPTConversionKernelTypeCount] = {")
+for t in kernel_types:
+    print("\t{ // %s" % t)
+    for nt in kernel_types:
+        if ( kernel_bits[t] in kernel_swaps ):
+            print("\t\tCPTConvertSwapped%sTo%s," % (kernel_names[t], kernel_names[nt]))
+        else:
+            # single bytes have no byte order
+            print("\t\tCPTConvert%sTo%s," % (kernel_names[t], kernel_names[nt]))
+    print("\t},")
+print("};")
@@ -17,6 +17,7 @@
 -(void)commonInitWithData:(nonnull NSData *)newData dataType:(CPTNumericDataType)newDataType shape:(nullable CPTNumberArray *)shapeArray dataOrder:(CPTDataOrder)order;
 -(NSUInteger)sampleIndex:(NSUInteger)idx indexList:(va_list)indexList;
 -(nonnull NSData *)dataFromArray:(nonnull CPTNumberArray *)newData dataType:(CPTNumericDataType)newDataType;
+-(void)adoptData:(nonnull NSData *)newData;
 
 @end
 
@@ -507,6 +508,20 @@
     }
 }
 
+/** @internal
+ *  @brief Replaces the data buffer with @par{newData} without copying it.
+ *
+ *  The receiver becomes a one-dimensional array of the samples in @par{newData}.
+ *  A mutable receiver must be given an NSMutableData instance.
+ *
+ *  @param newData The new data buffer.
+ **/
+-(void)adoptData:(nonnull NSData *)newData
+{
+    data  = newData;
+    shape = @[@(self.numberOfSamples)];
+}
+
 -(void)setDataType:(CPTNumericDataType)newDataType
 {
     CPTNumericDataType oldDataType = dataType;
@@ -528,20 +543,27 @@
     if ((oldDataType.dataTypeFormat != CPTUndefinedDataType) && (oldDataType.byteOrder != CFByteOrderUnknown)) {
         NSMutableData *myData     = (NSMutableData *)self.data;
         CFByteOrder hostByteOrder = CFByteOrderGetCurrent();
+        BOOL swapOldData          = (oldDataType.byteOrder != hostByteOrder);
 
         NSUInteger sampleCount = myData.length / oldDataType.sampleBytes;
 
-        if ( oldDataType.byteOrder != hostByteOrder ) {
-            [self swapByteOrderForData:myData sampleSize:oldDataType.sampleBytes];
-        }
-
         if ( newDataType.sampleBytes > oldDataType.sampleBytes ) {
             NSData *oldData = [myData copy];
             myData.length = sampleCount * newDataType.sampleBytes;
-            [self convertData:oldData dataType:&oldDataType toData:myData dataType:&newDataType];
+            if ( swapOldData ) {
+                [self convertSwappedData:oldData dataType:&oldDataType toData:myData dataType:&newDataType];
+            }
+            else {
+                [self convertData:oldData dataType:&oldDataType toData:myData dataType:&newDataType];
+            }
         }
         else {
-            [self convertData:myData dataType:&oldDataType toData:myData dataType:&newDataType];
+            if ( swapOldData ) {
+                [self convertSwappedData:myData dataType:&oldDataType toData:myData dataType:&newDataType];
+            }
+            else {
+                [self convertData:myData dataType:&oldDataType toData:myData dataType:&newDataType];
+            }
             myData.length = sampleCount * newDataType.sampleBytes;
         }
 
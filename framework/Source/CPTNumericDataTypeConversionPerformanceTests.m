@@ -1,10 +1,32 @@
 #import "CPTNumericDataTypeConversionPerformanceTests.h"
 
 #import "CPTNumericData+TypeConversion.h"
-#import <mach/mach_time.h>
 
 static const size_t numberOfSamples = 10000000;
 
+static const size_t numberOfPairSamples = 1000000;
+
+static CFByteOrder CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder(void)
+{
+    return (CFByteOrderGetCurrent() == CFByteOrderLittleEndian) ? CFByteOrderBigEndian : CFByteOrderLittleEndian;
+}
+
+@interface CPTNumericData(ScalarTypeConversion)
+
+-(void)scalarConvertData:(nonnull NSData *)sourceData dataType:(nonnull CPTNumericDataType *)sourceDataType toData:(nonnull NSMutableData *)destData dataType:(nonnull CPTNumericDataType *)destDataType;
+
+@end
+
+@interface CPTNumericDataTypeConversionPerformanceTests()
+
+-(nonnull NSData *)sourceDataOfType:(CPTNumericDataType)sourceType;
+-(void)checkAllConversionPairsSwapped:(BOOL)swapped;
+-(void)measureConversionFromType:(CPTNumericDataType)sourceType toType:(CPTNumericDataType)destType kernel:(BOOL)kernel;
+
+@end
+
+#pragma mark -
+
 @implementation CPTNumericDataTypeConversionPerformanceTests
 
 -(void)testFloatToDoubleConversion
@@ -87,4 +109,198 @@ static const size_t numberOfSamples = 10000000;
     }];
 }
 
+#pragma mark -
+#pragma mark Conversion kernels
+
+-(void)testAllConversionPairs
+{
+    [self checkAllConversionPairsSwapped:NO];
+}
+
+-(void)testAllSwappedConversionPairs
+{
+    [self checkAllConversionPairsSwapped:YES];
+}
+
+-(void)testInt16ToFloatKernelConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTIntegerDataType, sizeof(int16_t), CFByteOrderGetCurrent())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(float), CFByteOrderGetCurrent())
+                             kernel:YES];
+}
+
+-(void)testInt16ToFloatScalarConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTIntegerDataType, sizeof(int16_t), CFByteOrderGetCurrent())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(float), CFByteOrderGetCurrent())
+                             kernel:NO];
+}
+
+-(void)testUInt8ToDoubleKernelConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTUnsignedIntegerDataType, sizeof(uint8_t), CFByteOrderGetCurrent())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent())
+                             kernel:YES];
+}
+
+-(void)testUInt8ToDoubleScalarConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTUnsignedIntegerDataType, sizeof(uint8_t), CFByteOrderGetCurrent())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent())
+                             kernel:NO];
+}
+
+-(void)testSwappedInt32ToDoubleKernelConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTIntegerDataType, sizeof(int32_t), CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent())
+                             kernel:YES];
+}
+
+-(void)testSwappedInt32ToDoubleScalarConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTIntegerDataType, sizeof(int32_t), CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent())
+                             kernel:NO];
+}
+
+-(void)testSwappedDoubleToFloatKernelConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(float), CFByteOrderGetCurrent())
+                             kernel:YES];
+}
+
+-(void)testSwappedDoubleToFloatScalarConversion
+{
+    [self measureConversionFromType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder())
+                             toType:CPTDataType(CPTFloatingPointDataType, sizeof(float), CFByteOrderGetCurrent())
+                             kernel:NO];
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+-(nonnull NSData *)sourceDataOfType:(CPTNumericDataType)sourceType
+{
+    NSMutableData *values = [[NSMutableData alloc] initWithLength:numberOfPairSamples * sizeof(double)];
+    double *valueSamples  = (double *)values.mutableBytes;
+
+    for ( NSUInteger i = 0; i < numberOfPairSamples; i++ ) {
+        valueSamples[i] = (double)(i % 101);
+    }
+
+    CPTNumericDataType valueType = CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent());
+    CPTNumericDataType hostType  = CPTDataType(sourceType.dataTypeFormat, sourceType.sampleBytes, CFByteOrderGetCurrent());
+
+    CPTNumericData *converter = [[CPTNumericData alloc] initWithData:[NSData data]
+                                                            dataType:valueType
+                                                               shape:nil];
+
+    NSMutableData *sourceData = [[NSMutableData alloc] initWithLength:numberOfPairSamples * sourceType.sampleBytes];
+
+    [converter scalarConvertData:values dataType:&valueType toData:sourceData dataType:&hostType];
+
+    if ( sourceType.byteOrder != CFByteOrderGetCurrent()) {
+        [converter swapByteOrderForData:sourceData sampleSize:sourceType.sampleBytes];
+    }
+
+    return sourceData;
+}
+
+// the kernels must give the same samples as the scalar loops for every pair of types
+-(void)checkAllConversionPairsSwapped:(BOOL)swapped
+{
+    const CPTDataTypeFormat formats[] = {
+        CPTIntegerDataType, CPTIntegerDataType, CPTIntegerDataType, CPTIntegerDataType,
+        CPTUnsignedIntegerDataType, CPTUnsignedIntegerDataType, CPTUnsignedIntegerDataType, CPTUnsignedIntegerDataType,
+        CPTFloatingPointDataType, CPTFloatingPointDataType
+    };
+    const size_t sizes[] = {
+        sizeof(int8_t), sizeof(int16_t), sizeof(int32_t), sizeof(int64_t),
+        sizeof(uint8_t), sizeof(uint16_t), sizeof(uint32_t), sizeof(uint64_t),
+        sizeof(float), sizeof(double)
+    };
+    const size_t typeCount = sizeof(sizes) / sizeof(sizes[0]);
+
+    CFByteOrder hostByteOrder   = CFByteOrderGetCurrent();
+    CFByteOrder sourceByteOrder = swapped ? CPTNumericDataTypeConversionPerformanceTestsSwappedByteOrder() : hostByteOrder;
+
+    CPTNumericData *converter = [[CPTNumericData alloc] initWithData:[NSData data]
+                                                            dataType:CPTDataType(CPTFloatingPointDataType, sizeof(double), hostByteOrder)
+                                                               shape:nil];
+
+    for ( size_t from = 0; from < typeCount; from++ ) {
+        CPTNumericDataType sourceType = CPTDataType(formats[from], sizes[from], sourceByteOrder);
+        NSData *sourceData            = [self sourceDataOfType:sourceType];
+
+        NSMutableData *hostSourceData = [sourceData mutableCopy];
+
+        if ( swapped ) {
+            [converter swapByteOrderForData:hostSourceData sampleSize:sourceType.sampleBytes];
+        }
+
+        for ( size_t to = 0; to < typeCount; to++ ) {
+            CPTNumericDataType destType = CPTDataType(formats[to], sizes[to], hostByteOrder);
+
+            NSMutableData *scalarData = [[NSMutableData alloc] initWithLength:numberOfPairSamples * destType.sampleBytes];
+            NSMutableData *kernelData = [[NSMutableData alloc] initWithLength:numberOfPairSamples * destType.sampleBytes];
+
+            [converter scalarConvertData:hostSourceData dataType:&sourceType toData:scalarData dataType:&destType];
+
+            if ( swapped ) {
+                [converter convertSwappedData:sourceData dataType:&sourceType toData:kernelData dataType:&destType];
+            }
+            else {
+                [converter convertData:sourceData dataType:&sourceType toData:kernelData dataType:&destType];
+            }
+
+            XCTAssertEqualObjects(kernelData, scalarData, @"%@ from type %lu to type %lu", swapped ? @"swapped conversion" : @"conversion", (unsigned long)from, (unsigned long)to);
+        }
+    }
+}
+
+// times one conversion, through the kernels or through the scalar loops with a separate byte swap
+-(void)measureConversionFromType:(CPTNumericDataType)sourceType toType:(CPTNumericDataType)destType kernel:(BOOL)kernel
+{
+    NSData *sourceData = [self sourceDataOfType:sourceType];
+    BOOL swapped       = (sourceType.byteOrder != CFByteOrderGetCurrent());
+
+    CPTNumericData *converter = [[CPTNumericData alloc] initWithData:[NSData data]
+                                                            dataType:destType
+                                                               shape:nil];
+
+    NSMutableData *destData = [[NSMutableData alloc] initWithLength:numberOfPairSamples * destType.sampleBytes];
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock: ^{
+        CPTNumericDataType fromType = sourceType;
+        CPTNumericDataType toType   = destType;
+
+        if ( kernel ) {
+            [self startMeasuring];
+            if ( swapped ) {
+                [converter convertSwappedData:sourceData dataType:&fromType toData:destData dataType:&toType];
+            }
+            else {
+                [converter convertData:sourceData dataType:&fromType toData:destData dataType:&toType];
+            }
+            [self stopMeasuring];
+        }
+        else if ( swapped ) {
+            // the scalar path swaps a copy of the samples, copying is not part of the conversion
+            NSMutableData *swappedData = [sourceData mutableCopy];
+
+            [self startMeasuring];
+            [converter swapByteOrderForData:swappedData sampleSize:fromType.sampleBytes];
+            [converter scalarConvertData:swappedData dataType:&fromType toData:destData dataType:&toType];
+            [self stopMeasuring];
+        }
+        else {
+            [self startMeasuring];
+            [converter scalarConvertData:sourceData dataType:&fromType toData:destData dataType:&toType];
+            [self stopMeasuring];
+        }
+    }];
+}
+
 @end
@@ -36,8 +36,12 @@ CPTPieChartBinding const CPTPieChartBindingPieSliceRadialOffsets = @"sliceRadial
 @property (nonatomic, readwrite, copy, nullable) CPTFillArray *sliceFills;
 @property (nonatomic, readwrite, copy, nullable) CPTNumberArray *sliceRadialOffsets;
 @property (nonatomic, readwrite, assign) NSUInteger pointingDeviceDownIndex;
+@property (nonatomic, readwrite, strong, nullable) NSData *sliceStartData;
 
 -(void)updateNormalizedData;
+-(void)updateSliceStartData;
+-(nonnull const double *)sliceStartValues;
+-(NSUInteger)pieSliceIndexAtPieSliceValue:(CGFloat)pieSliceValue;
 -(CGFloat)radiansForPieSliceValue:(CGFloat)pieSliceValue;
 -(CGFloat)normalizedPosition:(CGFloat)rawPosition;
 -(BOOL)angle:(CGFloat)touchedAngle betweenStartAngle:(CGFloat)startingAngle endAngle:(CGFloat)endingAngle;
@@ -125,6 +129,12 @@ CPTPieChartBinding const CPTPieChartBindingPieSliceRadialOffsets = @"sliceRadial
  **/
 @synthesize pointingDeviceDownIndex;
 
+/** @internal
+ *  @property nullable NSData *sliceStartData
+ *  @brief The running total of the normalized slice widths before each slice, as doubles, followed by the total of all slices.
+ **/
+@synthesize sliceStartData;
+
 #pragma mark -
 #pragma mark Convenience Factory Methods
 
@@ -468,12 +478,100 @@ static const CGFloat colorLookupTable[10][3] = {
         [self cacheNumbers:nil forField:CPTPieChartFieldSliceWidthSum];
     }
 
+    [self updateSliceStartData];
+
     // Labels
     id<CPTPlotDataSource> theDataSource = self.dataSource;
 
     [self relabelIndexRange:NSMakeRange(0, [theDataSource numberOfRecordsForPlot:self])];
 }
 
+/** @internal
+ *  @brief Rebuilds the table of slice starting values from the normalized slice widths.
+ *
+ *  Slices with a @NAN width take no room, the same as when drawing the pie.
+ **/
+-(void)updateSliceStartData
+{
+    NSUInteger sampleCount = self.cachedDataCount;
+
+    NSMutableData *newStartData = [[NSMutableData alloc] initWithLength:(sampleCount + 1) * sizeof(double)];
+    double *startValues         = (double *)newStartData.mutableBytes;
+
+    CPTMutableNumericData *normalizedSliceValues = [self cachedNumbersForField:CPTPieChartFieldSliceWidthNormalized];
+    NSUInteger valueCount                        = MIN(normalizedSliceValues.numberOfSamples, sampleCount);
+    BOOL isDouble                                = (normalizedSliceValues.dataTypeFormat == CPTFloatingPointDataType);
+
+    double cumulativeSum = 0.0;
+
+    for ( NSUInteger i = 0; i < valueCount; i++ ) {
+        startValues[i] = cumulativeSum;
+
+        double currentWidth;
+        if ( isDouble ) {
+            currentWidth = ((const double *)normalizedSliceValues.bytes)[i];
+        }
+        else {
+            currentWidth = CPTDecimalDoubleValue(((const NSDecimal *)normalizedSliceValues.bytes)[i]);
+        }
+
+        if ( !isnan(currentWidth)) {
+            cumulativeSum += currentWidth;
+        }
+    }
+    for ( NSUInteger i = valueCount; i <= sampleCount; i++ ) {
+        startValues[i] = cumulativeSum;
+    }
+
+    self.sliceStartData = newStartData;
+}
+
+/** @internal
+ *  @brief The pie slice value each slice starts at, followed by the total of all slices.
+ *  @return A table of @ref cachedDataCount + 1 values.
+ **/
+-(nonnull const double *)sliceStartValues
+{
+    if ( self.sliceStartData.length != (self.cachedDataCount + 1) * sizeof(double)) {
+        [self updateSliceStartData];
+    }
+
+    return (const double *)self.sliceStartData.bytes;
+}
+
+/** @internal
+ *  @brief Finds the first slice, in index order, that covers a pie slice value.
+ *  @param  pieSliceValue A distance from the start of the pie in the units of the normalized slice widths.
+ *  @return The index of the pie slice, or @ref NSNotFound if @par{pieSliceValue} is past the end of the last slice.
+ **/
+-(NSUInteger)pieSliceIndexAtPieSliceValue:(CGFloat)pieSliceValue
+{
+    NSUInteger sampleCount    = self.cachedDataCount;
+    const double *startValues = [self sliceStartValues];
+
+    // binary search for the first slice that ends at or after the value; each slice ends where the next one starts
+    NSUInteger low  = 0;
+    NSUInteger high = sampleCount;
+
+    while ( low < high ) {
+        NSUInteger mid = low + (high - low) / 2;
+
+        if ( startValues[mid + 1] < pieSliceValue ) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    // slices with a NAN width cannot be hit
+    while ( low < sampleCount && isnan([self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:low])) {
+        low++;
+    }
+
+    return (low < sampleCount) ? low : NSNotFound;
+}
+
 /// @endcond
 
 /**
@@ -822,32 +920,21 @@ static const CGFloat colorLookupTable[10][3] = {
     CGFloat pieAngle      = [self normalizedPosition:angle];
     CGFloat startingAngle = [self normalizedPosition:self.startAngle];
 
-    // Iterate through the pie slices and compute their starting and ending angles.
-    // If the angle we are searching for lies within those two angles, return the index
-    // of that pie slice.
-    for ( NSUInteger currentIndex = 0; currentIndex < self.cachedDataCount; currentIndex++ ) {
-        CGFloat width = CPTFloat([self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
-        if ( isnan(width)) {
-            continue;
-        }
-        CGFloat endingAngle = startingAngle;
-
-        if ( self.sliceDirection == CPTPieDirectionClockwise ) {
-            endingAngle -= width;
-        }
-        else {
-            endingAngle += width;
-        }
-
-        if ( [self angle:pieAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
-            return currentIndex;
-        }
+    // Measure the angle from the start of the pie in the direction the slices are laid out,
+    // then look up the slice covering it in the table of slice starting values.
+    CGFloat pieSliceValue;
 
-        startingAngle = endingAngle;
+    if ( self.sliceDirection == CPTPieDirectionClockwise ) {
+        pieSliceValue = startingAngle - pieAngle;
+    }
+    else {
+        pieSliceValue = pieAngle - startingAngle;
+    }
+    if ( pieSliceValue < CPTFloat(0.0)) {
+        pieSliceValue += CPTFloat(1.0);
     }
 
-    // Searched every pie slice but couldn't find one that corresponds to the given angle.
-    return NSNotFound;
+    return [self pieSliceIndexAtPieSliceValue:pieSliceValue];
 }
 
 /** @brief Computes the halfway-point between the starting and ending angles of a given pie slice.
@@ -861,29 +948,22 @@ static const CGFloat colorLookupTable[10][3] = {
 
     NSParameterAssert(idx < sampleCount);
 
-    if ( sampleCount == 0 ) {
-        return CPTNAN;
-    }
+    CGFloat medianAngle = CPTNAN;
 
-    CGFloat startingWidth = CPTFloat(0.0);
+    if ( idx < sampleCount ) {
+        CGFloat currentWidth = CPTFloat([self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:idx]);
 
-    // Iterate through the pie slices until the slice with the given index is found
-    for ( NSUInteger currentIndex = 0; currentIndex < sampleCount; currentIndex++ ) {
-        CGFloat currentWidth = CPTFloat([self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
-
-        // If the slice index is a match...
-        if ( !isnan(currentWidth) && (idx == currentIndex)) {
-            // Compute and return the angle that is halfway between the slice's starting and ending angles
+        if ( !isnan(currentWidth)) {
+            // Compute the angle that is halfway between the slice's starting and ending angles
+            CGFloat startingWidth  = (CGFloat)[self sliceStartValues][idx];
             CGFloat startingAngle  = [self radiansForPieSliceValue:startingWidth];
             CGFloat finishingAngle = [self radiansForPieSliceValue:startingWidth + currentWidth];
-            return (startingAngle + finishingAngle) * CPTFloat(0.5);
-        }
 
-        startingWidth += currentWidth;
+            medianAngle = (startingAngle + finishingAngle) * CPTFloat(0.5);
+        }
     }
 
-    // Searched every pie slice but couldn't find one that corresponds to the given index
-    return CPTNAN;
+    return medianAngle;
 }
 
 #pragma mark -
@@ -961,10 +1041,7 @@ static const CGFloat colorLookupTable[10][3] = {
             CGFloat radialOffset = [(NSNumber *)[self cachedValueForKey:CPTPieChartBindingPieSliceRadialOffsets recordIndex:idx] cgFloatValue];
             CGFloat labelRadius  = self.pieRadius + self.labelOffset + radialOffset;
 
-            CGFloat startingWidth = CPTFloat(0.0);
-            if ( idx > 0 ) {
-                startingWidth = (CGFloat)[self cachedDoubleForField:CPTPieChartFieldSliceWidthSum recordIndex:idx - 1];
-            }
+            CGFloat startingWidth = (CGFloat)[self sliceStartValues][idx];
             CGFloat labelAngle = [self radiansForPieSliceValue:startingWidth + currentWidth / CPTFloat(2.0)];
 
             label.displacement = CPTPointMake(labelRadius * cos(labelAngle), labelRadius * sin(labelAngle));
@@ -1272,6 +1349,7 @@ static const CGFloat colorLookupTable[10][3] = {
     CGFloat theStartAngle = self.startAngle;
     CGFloat theEndAngle   = self.endAngle;
     CGFloat widthFactor;
+    CGFloat direction;
 
     CGFloat touchedAngle  = [self normalizedPosition:atan2(dy, dx)];
     CGFloat startingAngle = [self normalizedPosition:theStartAngle];
@@ -1284,54 +1362,7 @@ static const CGFloat colorLookupTable[10][3] = {
             else {
                 widthFactor = CPTFloat(2.0 * M_PI) / (CPTFloat(2.0 * M_PI) - ABS(theEndAngle - theStartAngle));
             }
-
-            for ( NSUInteger currentIndex = 0; currentIndex < sampleCount; currentIndex++ ) {
-                // calculate angles for this slice
-                CGFloat width = (CGFloat)[self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex];
-                if ( isnan(width)) {
-                    continue;
-                }
-
-                width /= widthFactor;
-
-                CGFloat endingAngle = startingAngle - width;
-
-                // offset the center point of the slice if needed
-                CGFloat offsetTouchedAngle    = touchedAngle;
-                CGFloat offsetDistanceSquared = distanceSquared;
-                CGFloat radialOffset          = [(NSNumber *)[self cachedValueForKey:CPTPieChartBindingPieSliceRadialOffsets recordIndex:currentIndex] cgFloatValue];
-                if ( radialOffset != CPTFloat(0.0)) {
-                    CGPoint offsetCenter;
-                    CGFloat medianAngle = CPTFloat(M_PI) * (startingAngle + endingAngle);
-                    offsetCenter = CPTPointMake(centerPoint.x + cos(medianAngle) * radialOffset,
-                                                centerPoint.y + sin(medianAngle) * radialOffset);
-
-                    dx = point.x - offsetCenter.x;
-                    dy = point.y - offsetCenter.y;
-
-                    offsetTouchedAngle    = [self normalizedPosition:atan2(dy, dx)];
-                    offsetDistanceSquared = dx * dx + dy * dy;
-                }
-
-                // check angles
-                BOOL angleInSlice = NO;
-                if ( [self angle:touchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
-                    if ( [self angle:offsetTouchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
-                        angleInSlice = YES;
-                    }
-                    else {
-                        return NSNotFound;
-                    }
-                }
-
-                // check distance
-                if ( angleInSlice && (offsetDistanceSquared >= chartInnerRadiusSquared) && (offsetDistanceSquared <= chartRadiusSquared)) {
-                    return currentIndex;
-                }
-
-                // save angle for the next slice
-                startingAngle = endingAngle;
-            }
+            direction = CPTFloat(-1.0);
             break;
 
         case CPTPieDirectionCounterClockwise:
@@ -1341,54 +1372,59 @@ static const CGFloat colorLookupTable[10][3] = {
             else {
                 widthFactor = (CGFloat)(2.0 * M_PI) / ABS(theEndAngle - theStartAngle);
             }
+            direction = CPTFloat(1.0);
+            break;
+    }
 
-            for ( NSUInteger currentIndex = 0; currentIndex < sampleCount; currentIndex++ ) {
-                // calculate angles for this slice
-                CGFloat width = (CGFloat)[self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex];
-                if ( isnan(width)) {
-                    continue;
-                }
-                width /= widthFactor;
+    // distance of the touch from the start of the pie in pie slice values
+    CGFloat pieSliceValue = direction * (touchedAngle - startingAngle);
 
-                CGFloat endingAngle = startingAngle + width;
+    if ( pieSliceValue < CPTFloat(0.0)) {
+        pieSliceValue += CPTFloat(1.0);
+    }
+    pieSliceValue *= widthFactor;
 
-                // offset the center point of the slice if needed
-                CGFloat offsetTouchedAngle    = touchedAngle;
-                CGFloat offsetDistanceSquared = distanceSquared;
-                CGFloat radialOffset          = [(NSNumber *)[self cachedValueForKey:CPTPieChartBindingPieSliceRadialOffsets recordIndex:currentIndex] cgFloatValue];
-                if ( radialOffset != CPTFloat(0.0)) {
-                    CGPoint offsetCenter;
-                    CGFloat medianAngle = CPTFloat(M_PI) * (startingAngle + endingAngle);
-                    offsetCenter = CPTPointMake(centerPoint.x + cos(medianAngle) * radialOffset,
-                                                centerPoint.y + sin(medianAngle) * radialOffset);
+    // the touched angle is only on more than one slice where slices meet
+    const double *startValues = [self sliceStartValues];
 
-                    dx = point.x - offsetCenter.x;
-                    dy = point.y - offsetCenter.y;
+    for ( NSUInteger currentIndex = [self pieSliceIndexAtPieSliceValue:pieSliceValue];
+          (currentIndex < sampleCount) && (startValues[currentIndex] <= pieSliceValue);
+          currentIndex++ ) {
+        // calculate angles for this slice
+        CGFloat width = (CGFloat)[self cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex];
+        if ( isnan(width)) {
+            continue;
+        }
 
-                    offsetTouchedAngle    = [self normalizedPosition:atan2(dy, dx)];
-                    offsetDistanceSquared = dx * dx + dy * dy;
-                }
+        CGFloat sliceStartingAngle = startingAngle + direction * (CGFloat)startValues[currentIndex] / widthFactor;
+        CGFloat endingAngle        = sliceStartingAngle + direction * width / widthFactor;
 
-                // check angles
-                BOOL angleInSlice = NO;
-                if ( [self angle:touchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
-                    if ( [self angle:offsetTouchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
-                        angleInSlice = YES;
-                    }
-                    else {
-                        return NSNotFound;
-                    }
-                }
+        // offset the center point of the slice if needed
+        CGFloat offsetTouchedAngle    = touchedAngle;
+        CGFloat offsetDistanceSquared = distanceSquared;
+        CGFloat radialOffset          = [(NSNumber *)[self cachedValueForKey:CPTPieChartBindingPieSliceRadialOffsets recordIndex:currentIndex] cgFloatValue];
+        if ( radialOffset != CPTFloat(0.0)) {
+            CGPoint offsetCenter;
+            CGFloat medianAngle = CPTFloat(M_PI) * (sliceStartingAngle + endingAngle);
+            offsetCenter = CPTPointMake(centerPoint.x + cos(medianAngle) * radialOffset,
+                                        centerPoint.y + sin(medianAngle) * radialOffset);
 
-                // check distance
-                if ( angleInSlice && (offsetDistanceSquared >= chartInnerRadiusSquared) && (offsetDistanceSquared <= chartRadiusSquared)) {
-                    return currentIndex;
-                }
+            dx = point.x - offsetCenter.x;
+            dy = point.y - offsetCenter.y;
 
-                // save angle for the next slice
-                startingAngle = endingAngle;
-            }
-            break;
+            offsetTouchedAngle    = [self normalizedPosition:atan2(dy, dx)];
+            offsetDistanceSquared = dx * dx + dy * dy;
+        }
+
+        // check angles
+        if ( ![self angle:offsetTouchedAngle betweenStartAngle:sliceStartingAngle endAngle:endingAngle] ) {
+            return NSNotFound;
+        }
+
+        // check distance
+        if ((offsetDistanceSquared >= chartInnerRadiusSquared) && (offsetDistanceSquared <= chartRadiusSquared)) {
+            return currentIndex;
+        }
     }
 
     return NSNotFound;
@@ -0,0 +1,11 @@
+#import "CPTTestCase.h"
+
+@class CPTPieChart;
+@class CPTXYGraph;
+
+@interface CPTPieChartTests : CPTTestCase
+
+@property (nonatomic, readwrite, strong, nullable) CPTPieChart *pieChart;
+@property (nonatomic, readwrite, strong, nullable) CPTXYGraph *graph;
+
+@end
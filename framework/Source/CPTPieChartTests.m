@@ -0,0 +1,409 @@
+#import "CPTPieChartTests.h"
+
+#import "CPTPieChart.h"
+#import "CPTPlotArea.h"
+#import "CPTUtilities.h"
+#import "CPTXYGraph.h"
+#import "NSNumberExtensions.h"
+
+@interface CPTPieChart(Testing)
+
+-(void)updateNormalizedData;
+-(NSUInteger)pieSliceIndexAtPieSliceValue:(CGFloat)pieSliceValue;
+-(CGFloat)radiansForPieSliceValue:(CGFloat)pieSliceValue;
+-(CGFloat)normalizedPosition:(CGFloat)rawPosition;
+-(BOOL)angle:(CGFloat)touchedAngle betweenStartAngle:(CGFloat)startingAngle endAngle:(CGFloat)endingAngle;
+
+@end
+
+typedef void (^CPTPieChartTestsConfigurationBlock)(NSString *_Nonnull description);
+
+@interface CPTPieChartTests()
+
+-(void)loadSliceWidths:(nonnull CPTNumberArray *)widths radialOffsets:(nullable CPTNumberArray *)offsets;
+-(void)enumerateConfigurationsUsingBlock:(nonnull CPTPieChartTestsConfigurationBlock)block;
+
+-(NSUInteger)linearPieSliceIndexAtPieSliceValue:(CGFloat)pieSliceValue;
+-(NSUInteger)linearPieSliceIndexAtAngle:(CGFloat)angle;
+-(CGFloat)linearMedianAngleForPieSliceIndex:(NSUInteger)idx;
+-(NSUInteger)linearDataIndexFromInteractionPoint:(CGPoint)point;
+
+@end
+
+#pragma mark -
+
+@implementation CPTPieChartTests
+
+@synthesize pieChart;
+@synthesize graph;
+
+-(void)setUp
+{
+    self.graph = [[CPTXYGraph alloc] initWithFrame:CPTRectMake(0.0, 0.0, 200.0, 200.0)];
+
+    self.pieChart                = [[CPTPieChart alloc] init];
+    self.pieChart.cachePrecision = CPTPlotCachePrecisionDouble;
+    self.pieChart.pieRadius      = CPTFloat(80.0);
+
+    [self.graph addPlot:self.pieChart];
+    [self.graph layoutIfNeeded];
+}
+
+-(void)tearDown
+{
+    self.pieChart = nil;
+    self.graph    = nil;
+}
+
+-(void)loadSliceWidths:(nonnull CPTNumberArray *)widths radialOffsets:(nullable CPTNumberArray *)offsets
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    // caching the offsets sets the record count, so they go first
+    if ( offsets ) {
+        [theChart cacheArray:offsets forKey:CPTPieChartBindingPieSliceRadialOffsets];
+    }
+    [theChart cacheNumbers:widths forField:CPTPieChartFieldSliceWidth];
+    [theChart updateNormalizedData];
+}
+
+-(void)enumerateConfigurationsUsingBlock:(nonnull CPTPieChartTestsConfigurationBlock)block
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    const CPTPieDirection directions[] = { CPTPieDirectionClockwise, CPTPieDirectionCounterClockwise };
+    const CGFloat startAngles[]        = { CPTFloat(0.0), CPTFloat(M_PI_2), CPTFloat(1.1) };
+    const CGFloat pieRanges[]          = { CPTNAN, CPTFloat(M_PI), CPTFloat(1.5 * M_PI) };
+
+    for ( NSUInteger d = 0; d < 2; d++ ) {
+        for ( NSUInteger s = 0; s < 3; s++ ) {
+            for ( NSUInteger r = 0; r < 3; r++ ) {
+                // a NAN end angle draws a full pie
+                theChart.sliceDirection = directions[d];
+                theChart.startAngle     = startAngles[s];
+                theChart.endAngle       = startAngles[s] + pieRanges[r];
+
+                block([NSString stringWithFormat:@"%@, start %g, end %g",
+                       (directions[d] == CPTPieDirectionClockwise) ? @"clockwise" : @"counter-clockwise",
+                       (double)theChart.startAngle, (double)theChart.endAngle]);
+            }
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Linear walk
+
+// the slice lookups as they were before the table of slice starting values
+
+-(NSUInteger)linearPieSliceIndexAtPieSliceValue:(CGFloat)pieSliceValue
+{
+    CPTPieChart *theChart = self.pieChart;
+    CGFloat sliceStart    = CPTFloat(0.0);
+
+    for ( NSUInteger currentIndex = 0; currentIndex < theChart.cachedDataCount; currentIndex++ ) {
+        CGFloat width = CPTFloat([theChart cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
+        if ( isnan(width)) {
+            continue;
+        }
+        if ( sliceStart + width >= pieSliceValue ) {
+            return currentIndex;
+        }
+        sliceStart += width;
+    }
+
+    return NSNotFound;
+}
+
+-(NSUInteger)linearPieSliceIndexAtAngle:(CGFloat)angle
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    CGFloat pieAngle      = [theChart normalizedPosition:angle];
+    CGFloat startingAngle = [theChart normalizedPosition:theChart.startAngle];
+
+    for ( NSUInteger currentIndex = 0; currentIndex < theChart.cachedDataCount; currentIndex++ ) {
+        CGFloat width = CPTFloat([theChart cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
+        if ( isnan(width)) {
+            continue;
+        }
+        CGFloat endingAngle = startingAngle;
+
+        if ( theChart.sliceDirection == CPTPieDirectionClockwise ) {
+            endingAngle -= width;
+        }
+        else {
+            endingAngle += width;
+        }
+
+        if ( [theChart angle:pieAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
+            return currentIndex;
+        }
+
+        startingAngle = endingAngle;
+    }
+
+    return NSNotFound;
+}
+
+-(CGFloat)linearMedianAngleForPieSliceIndex:(NSUInteger)idx
+{
+    CPTPieChart *theChart = self.pieChart;
+    CGFloat startingWidth = CPTFloat(0.0);
+
+    for ( NSUInteger currentIndex = 0; currentIndex < theChart.cachedDataCount; currentIndex++ ) {
+        CGFloat currentWidth = CPTFloat([theChart cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
+
+        if ( isnan(currentWidth)) {
+            // slices with a NAN width take no room when drawn; the old walk carried the NAN on to every later slice instead
+            if ( idx == currentIndex ) {
+                break;
+            }
+            continue;
+        }
+        if ( idx == currentIndex ) {
+            CGFloat startingAngle  = [theChart radiansForPieSliceValue:startingWidth];
+            CGFloat finishingAngle = [theChart radiansForPieSliceValue:startingWidth + currentWidth];
+            return (startingAngle + finishingAngle) * CPTFloat(0.5);
+        }
+
+        startingWidth += currentWidth;
+    }
+
+    return CPTNAN;
+}
+
+-(NSUInteger)linearDataIndexFromInteractionPoint:(CGPoint)point
+{
+    CPTPieChart *theChart    = self.pieChart;
+    CPTPlotArea *thePlotArea = theChart.plotArea;
+
+    CGRect plotAreaBounds = thePlotArea.bounds;
+    CGPoint anchor        = theChart.centerAnchor;
+    CGPoint centerPoint   = CPTPointMake(plotAreaBounds.origin.x + plotAreaBounds.size.width * anchor.x,
+                                         plotAreaBounds.origin.y + plotAreaBounds.size.height * anchor.y);
+
+    centerPoint = [theChart convertPoint:centerPoint fromLayer:thePlotArea];
+
+    CGFloat chartRadiusSquared      = theChart.pieRadius * theChart.pieRadius;
+    CGFloat chartInnerRadiusSquared = theChart.pieInnerRadius * theChart.pieInnerRadius;
+    CGFloat dx                      = point.x - centerPoint.x;
+    CGFloat dy                      = point.y - centerPoint.y;
+    CGFloat distanceSquared         = dx * dx + dy * dy;
+
+    CGFloat theStartAngle = theChart.startAngle;
+    CGFloat theEndAngle   = theChart.endAngle;
+    BOOL clockwise        = (theChart.sliceDirection == CPTPieDirectionClockwise);
+    CGFloat widthFactor   = CPTFloat(1.0);
+
+    if ( !isnan(theEndAngle) && (CPTFloat(2.0 * M_PI) != ABS(theEndAngle - theStartAngle))) {
+        if ( clockwise ) {
+            widthFactor = CPTFloat(2.0 * M_PI) / (CPTFloat(2.0 * M_PI) - ABS(theEndAngle - theStartAngle));
+        }
+        else {
+            widthFactor = CPTFloat(2.0 * M_PI) / ABS(theEndAngle - theStartAngle);
+        }
+    }
+
+    CGFloat touchedAngle  = [theChart normalizedPosition:atan2(dy, dx)];
+    CGFloat startingAngle = [theChart normalizedPosition:theStartAngle];
+
+    for ( NSUInteger currentIndex = 0; currentIndex < theChart.cachedDataCount; currentIndex++ ) {
+        CGFloat width = CPTFloat([theChart cachedDoubleForField:CPTPieChartFieldSliceWidthNormalized recordIndex:currentIndex]);
+        if ( isnan(width)) {
+            continue;
+        }
+
+        width /= widthFactor;
+
+        CGFloat endingAngle = clockwise ? startingAngle - width : startingAngle + width;
+
+        CGFloat offsetTouchedAngle    = touchedAngle;
+        CGFloat offsetDistanceSquared = distanceSquared;
+        CGFloat radialOffset          = [(NSNumber *)[theChart cachedValueForKey:CPTPieChartBindingPieSliceRadialOffsets recordIndex:currentIndex] cgFloatValue];
+        if ( radialOffset != CPTFloat(0.0)) {
+            CGFloat medianAngle  = CPTFloat(M_PI) * (startingAngle + endingAngle);
+            CGPoint offsetCenter = CPTPointMake(centerPoint.x + cos(medianAngle) * radialOffset,
+                                                centerPoint.y + sin(medianAngle) * radialOffset);
+
+            dx = point.x - offsetCenter.x;
+            dy = point.y - offsetCenter.y;
+
+            offsetTouchedAngle    = [theChart normalizedPosition:atan2(dy, dx)];
+            offsetDistanceSquared = dx * dx + dy * dy;
+        }
+
+        BOOL angleInSlice = NO;
+        if ( [theChart angle:touchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
+            if ( [theChart angle:offsetTouchedAngle betweenStartAngle:startingAngle endAngle:endingAngle] ) {
+                angleInSlice = YES;
+            }
+            else {
+                return NSNotFound;
+            }
+        }
+
+        if ( angleInSlice && (offsetDistanceSquared >= chartInnerRadiusSquared) && (offsetDistanceSquared <= chartRadiusSquared)) {
+            return currentIndex;
+        }
+
+        startingAngle = endingAngle;
+    }
+
+    return NSNotFound;
+}
+
+#pragma mark -
+#pragma mark Slice lookup
+
+-(void)testPieSliceIndexAtPieSliceValueMatchesLinearWalk
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    // dyadic widths put the slice boundaries exactly on the sampled values
+    [self loadSliceWidths:@[@(NAN), @1.0, @1.0, @0.0, @2.0, @(NAN), @0.0, @4.0, @(NAN)] radialOffsets:nil];
+
+    for ( NSUInteger i = 0; i <= 72; i++ ) {
+        CGFloat value = CPTFloat(i) / CPTFloat(64.0);
+
+        XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:value], [self linearPieSliceIndexAtPieSliceValue:value], @"value %g", (double)value);
+    }
+
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(0.0)], (NSUInteger)1, @"leading NAN slice skipped");
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(0.125)], (NSUInteger)1, @"boundary belongs to the slice ending there");
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(0.25)], (NSUInteger)2, @"zero width slice at a boundary not hit");
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(0.5)], (NSUInteger)4, @"last slice before a NAN slice");
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(1.0)], (NSUInteger)7, @"end of the pie");
+    XCTAssertEqual([theChart pieSliceIndexAtPieSliceValue:CPTFloat(1.01)], (NSUInteger)NSNotFound, @"past the end of the pie");
+}
+
+-(void)testPieSliceIndexAtAngleMatchesLinearWalk
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    [self loadSliceWidths:@[@3.0, @(NAN), @1.5, @0.0, @2.25, @0.0, @(NAN), @4.0, @1.0] radialOffsets:nil];
+
+    [self enumerateConfigurationsUsingBlock:^(NSString *description) {
+        for ( NSUInteger i = 0; i < 97; i++ ) {
+            CGFloat angle = (CPTFloat(i) + CPTFloat(0.37)) * CPTFloat(2.0 * M_PI / 97.0);
+
+            XCTAssertEqual([theChart pieSliceIndexAtAngle:angle], [self linearPieSliceIndexAtAngle:angle], @"%@, angle %g", description, (double)angle);
+        }
+    }];
+}
+
+-(void)testPieSliceIndexAtAngleOnSliceBoundaries
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    // normalized widths 0.125, 0.125, 0, 0.25, 0.5
+    [self loadSliceWidths:@[@1.0, @1.0, @0.0, @2.0, @4.0] radialOffsets:nil];
+
+    const CPTPieDirection directions[] = { CPTPieDirectionClockwise, CPTPieDirectionCounterClockwise };
+
+    for ( NSUInteger d = 0; d < 2; d++ ) {
+        theChart.sliceDirection = directions[d];
+        theChart.startAngle     = CPTFloat(0.0);
+
+        for ( NSUInteger i = 0; i < 16; i++ ) {
+            CGFloat angle = CPTFloat(i) * CPTFloat(2.0 * M_PI / 16.0);
+
+            XCTAssertEqual([theChart pieSliceIndexAtAngle:angle], [self linearPieSliceIndexAtAngle:angle], @"direction %lu, angle %g", (unsigned long)d, (double)angle);
+        }
+    }
+
+    theChart.sliceDirection = CPTPieDirectionCounterClockwise;
+    theChart.startAngle     = CPTFloat(0.0);
+
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.0)], (NSUInteger)0, @"start of the pie");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.25 * M_PI)], (NSUInteger)0, @"end of the first slice");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.5 * M_PI)], (NSUInteger)1, @"zero width slice not hit");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(M_PI)], (NSUInteger)3, @"end of the fourth slice");
+
+    theChart.sliceDirection = CPTPieDirectionClockwise;
+    theChart.startAngle     = CPTFloat(M_PI_2);
+
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.5 * M_PI)], (NSUInteger)0, @"clockwise start of the pie");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.25 * M_PI)], (NSUInteger)0, @"clockwise end of the first slice");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(0.0)], (NSUInteger)1, @"clockwise zero width slice not hit");
+    XCTAssertEqual([theChart pieSliceIndexAtAngle:CPTFloat(M_PI)], (NSUInteger)4, @"clockwise last slice");
+}
+
+#pragma mark -
+#pragma mark Median angle
+
+-(void)testMedianAngleMatchesLinearWalk
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    [self loadSliceWidths:@[@3.0, @(NAN), @1.5, @0.0, @2.25, @0.0, @(NAN), @4.0, @1.0] radialOffsets:nil];
+
+    [self enumerateConfigurationsUsingBlock:^(NSString *description) {
+        for ( NSUInteger idx = 0; idx < theChart.cachedDataCount; idx++ ) {
+            CGFloat medianAngle = [theChart medianAngleForPieSliceIndex:idx];
+            CGFloat expected    = [self linearMedianAngleForPieSliceIndex:idx];
+
+            if ( isnan(expected)) {
+                XCTAssertTrue(isnan(medianAngle), @"%@, NAN slice %lu", description, (unsigned long)idx);
+            }
+            else {
+                XCTAssertEqualWithAccuracy(medianAngle, expected, CPTFloat(1.0e-9), @"%@, slice %lu", description, (unsigned long)idx);
+            }
+        }
+    }];
+}
+
+-(void)testMedianAngleAfterNaNSlice
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    [self loadSliceWidths:@[@1.0, @(NAN), @1.0] radialOffsets:nil];
+
+    theChart.sliceDirection = CPTPieDirectionCounterClockwise;
+    theChart.startAngle     = CPTFloat(0.0);
+
+    XCTAssertEqualWithAccuracy([theChart medianAngleForPieSliceIndex:0], CPTFloat(0.5 * M_PI), CPTFloat(1.0e-9), @"first slice");
+    XCTAssertTrue(isnan([theChart medianAngleForPieSliceIndex:1]), @"NAN slice");
+    XCTAssertEqualWithAccuracy([theChart medianAngleForPieSliceIndex:2], CPTFloat(1.5 * M_PI), CPTFloat(1.0e-9), @"slice after the NAN slice");
+}
+
+#pragma mark -
+#pragma mark Hit testing
+
+-(void)testDataIndexFromInteractionPointMatchesLinearWalk
+{
+    CPTPieChart *theChart = self.pieChart;
+
+    theChart.pieInnerRadius = CPTFloat(20.0);
+
+    [self loadSliceWidths:@[@3.0, @(NAN), @1.5, @0.0, @2.25, @0.0, @(NAN), @4.0, @1.0]
+            radialOffsets:@[@0.0, @0.0, @8.0, @0.0, @0.0, @0.0, @0.0, @12.0, @0.0]];
+
+    CPTPlotArea *thePlotArea = theChart.plotArea;
+    CGRect plotAreaBounds    = thePlotArea.bounds;
+    CGPoint centerPoint      = [theChart convertPoint:CPTPointMake(CGRectGetMidX(plotAreaBounds), CGRectGetMidY(plotAreaBounds)) fromLayer:thePlotArea];
+
+    [self enumerateConfigurationsUsingBlock:^(NSString *description) {
+        NSUInteger hitCount = 0;
+
+        for ( NSUInteger r = 0; r < 12; r++ ) {
+            CGFloat radius = CPTFloat(5.0) + CPTFloat(r) * CPTFloat(8.3);
+
+            for ( NSUInteger i = 0; i < 97; i++ ) {
+                CGFloat angle = (CPTFloat(i) + CPTFloat(0.37)) * CPTFloat(2.0 * M_PI / 97.0);
+                CGPoint point = CPTPointMake(centerPoint.x + radius * cos(angle), centerPoint.y + radius * sin(angle));
+
+                NSUInteger idx = [theChart dataIndexFromInteractionPoint:point];
+
+                XCTAssertEqual(idx, [self linearDataIndexFromInteractionPoint:point], @"%@, radius %g, angle %g", description, (double)radius, (double)angle);
+
+                if ( idx != NSNotFound ) {
+                    hitCount++;
+                }
+            }
+        }
+        XCTAssertGreaterThan(hitCount, (NSUInteger)0, @"%@: slices hit", description);
+    }];
+}
+
+@end
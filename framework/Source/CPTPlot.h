@@ -134,6 +134,19 @@ typedef NSMutableArray<__kindof CPTPlot *> CPTMutablePlotArray;
  **/
 -(nullable CPTNumericData *)dataForPlot:(nonnull CPTPlot *)plot recordIndexRange:(NSRange)indexRange;
 
+/** @brief @optional Allows the plot to keep the data returned by
+ *  @link CPTPlotDataSource::dataForPlot:recordIndexRange: -dataForPlot:recordIndexRange: @endlink instead of copying it.
+ *
+ *  Return @YES only if the data source will not change the returned data buffer afterwards. Column-major
+ *  data that already matches the type of the plot cache then becomes the cache without being copied.
+ *  The plot never writes to the buffer; it copies a column before it first changes the cached values.
+ *  If this method is not implemented, the data is copied.
+ *
+ *  @param  plot The plot.
+ *  @return      @YES if the plot may keep the returned data buffer.
+ **/
+-(BOOL)plotMayAdoptData:(nonnull CPTPlot *)plot;
+
 /// @}
 
 /// @name Data Labels
@@ -293,6 +306,7 @@ typedef NSMutableArray<__kindof CPTPlot *> CPTMutablePlotArray;
 @property (nonatomic, readonly) NSUInteger cachedDataCount;
 @property (nonatomic, readonly) BOOL doublePrecisionCache;
 @property (nonatomic, readwrite, assign) CPTPlotCachePrecision cachePrecision;
+@property (nonatomic, readwrite, assign) NSUInteger streamingCapacity;
 @property (nonatomic, readonly) CPTNumericDataType doubleDataType;
 @property (nonatomic, readonly) CPTNumericDataType decimalDataType;
 /// @}
@@ -308,11 +322,18 @@ typedef NSMutableArray<__kindof CPTPlot *> CPTMutablePlotArray;
 @property (nonatomic, readwrite, copy, nullable) CPTTextStyle *labelTextStyle;
 @property (nonatomic, readwrite, strong, nullable) NSFormatter *labelFormatter;
 @property (nonatomic, readwrite, strong, nullable) CPTShadow *labelShadow;
+@property (nonatomic, readwrite, assign) BOOL virtualizesLabels;
+@property (nonatomic, readwrite, assign) CGFloat virtualLabelMargin;
 /// @}
 
 /// @name Drawing
 /// @{
 @property (nonatomic, readwrite, assign) BOOL alignsPointsToPixels;
+@property (nonatomic, readwrite, assign) BOOL cachesRasterTiles;
+@property (nonatomic, readwrite, assign) BOOL rendersAsynchronously;
+@property (nonatomic, readonly) NSTimeInterval renderingLatency;
+@property (nonatomic, readonly) NSUInteger scratchArenaCapacity;
+@property (nonatomic, readonly) NSUInteger scratchArenaAllocationCount;
 /// @}
 
 /// @name Legends
@@ -325,11 +346,17 @@ typedef NSMutableArray<__kindof CPTPlot *> CPTMutablePlotArray;
 -(void)setNeedsRelabel;
 -(void)relabel;
 -(void)relabelIndexRange:(NSRange)indexRange cpt_requires_super;
+-(void)setNeedsVisibleRelabel;
 -(void)repositionAllLabelAnnotations;
 -(void)reloadDataLabels;
 -(void)reloadDataLabelsInIndexRange:(NSRange)indexRange cpt_requires_super;
 /// @}
 
+/// @name Drawing
+/// @{
++(BOOL)supportsAsynchronousRendering;
+/// @}
+
 /// @name Data Loading
 /// @{
 -(void)setDataNeedsReloading;
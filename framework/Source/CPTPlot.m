@@ -1,8 +1,10 @@
 #import "CPTPlot.h"
 
+#import "CPTColorSpace.h"
 #import "CPTExceptions.h"
 #import "CPTFill.h"
 #import "CPTGraph.h"
+#import "CPTGraphHostingView.h"
 #import "CPTLegend.h"
 #import "CPTLineStyle.h"
 #import "CPTMutableNumericData+TypeConversion.h"
@@ -15,8 +17,13 @@
 #import "CPTShadow.h"
 #import "CPTTextLayer.h"
 #import "CPTUtilities.h"
+#import "CPTXYPlotSpace.h"
 #import "CPTFunctionDataSource.h"  // S.Wainwright
 #import "NSCoderExtensions.h"
+#import "_CPTFixedPointNumbers.h"
+#import "_CPTRasterTileCache.h"
+#import "_CPTScratchArena.h"
+#import "_CPTSpatialIndex.h"
 #import "CPTMutableLineStyle.h" // S.Wainwright 09/03/2023
 #import "CPTColor.h"            // S.Wainwright 09/03/2023
 #import <tgmath.h>
@@ -50,15 +57,115 @@
 CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data labels.
 
 /// @cond
+
+// Running extrema and NaN count for one numeric field of the data cache.
+// Kept up to date by the incremental cache updates so plot range queries do not rescan the data.
+struct CPTPlotFieldStatistics {
+    BOOL doublePrecision;   // YES if the statistics were gathered from a double cache, NO for NSDecimal
+    NSUInteger nanCount;    // number of NaN samples
+    NSRange pendingRange;   // records allocated by an insert that have not been loaded yet
+    double minDouble;       // smallest non-NaN sample (double cache)
+    double maxDouble;       // largest non-NaN sample (double cache)
+    NSDecimal minDecimal;   // smallest non-NaN sample (NSDecimal cache)
+    NSDecimal maxDecimal;   // largest non-NaN sample (NSDecimal cache)
+};
+typedef struct CPTPlotFieldStatistics CPTPlotFieldStatistics;
+
+static void CPTPlotFieldStatisticsReset(CPTPlotFieldStatistics *stats, BOOL doublePrecision);
+static void CPTPlotFieldStatisticsAddSamples(CPTPlotFieldStatistics *stats, const void *samples, NSUInteger count);
+static BOOL CPTPlotFieldStatisticsRemoveSamples(CPTPlotFieldStatistics *stats, const void *samples, NSUInteger count);
+
+static void CPTPlotSetStreamingWindow(CPTMutableNumericData *numbers, NSMutableData *buffer, NSUInteger head, NSUInteger count);
+
+static id CPTPlotLabelLayerPoolKey(CPTTextStyle *style);
+
+// time without a zoom change to wait before rendering the raster tiles at the new scale
+static const NSTimeInterval CPTPlotRasterTileRefreshDelay = 0.15;
+
+// rows converted at a time when transposing row-major data, few enough that the columns being filled stay in cache
+static const NSUInteger CPTPlotTransposeBlockRows = 256;
+
+// asynchronous rendering uses one queue per plot so the frames of a plot are drawn in order
+static const char *const CPTPlotRenderQueueLabel = "com.CorePlot.CPTPlot.render";
+
+// the current appearance is per thread, so -[CPTLayer display] does not set it for the render queue
+static void CPTPlotPerformWithAppearance(id appearance, dispatch_block_t block)
+{
+#if TARGET_OS_OSX
+    if ( appearance ) {
+        NSAppearance *oldAppearance = NSAppearance.currentAppearance;
+        NSAppearance.currentAppearance = (NSAppearance *)appearance;
+        block();
+        NSAppearance.currentAppearance = oldAppearance;
+        return;
+    }
+#else
+#ifdef __IPHONE_13_0
+    if ( appearance ) {
+        if ( @available(iOS 13, *)) {
+            [(UITraitCollection *) appearance performAsCurrentTraitCollection:block];
+            return;
+        }
+    }
+#endif
+#endif
+    block();
+}
+
+@interface CPTNumericData()
+
+// private CPTNumericData method
+-(void)adoptData:(nonnull NSData *)newData;
+
+@end
+
+@interface CPTLayer()
+
+// private CPTLayer method
+-(nullable CPTGraphHostingView *)findHostingView;
+
+@end
+
+@interface CPTPlotSpace()
+
+// private CPTPlotSpace property
+@property (nonatomic, readwrite, strong, nullable) CPTPlotArea *detachedPlotArea;
+
+@end
+
 @interface CPTPlot()
 
 @property (nonatomic, readwrite, assign) BOOL dataNeedsReloading;
 @property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary *cachedData;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary<NSNumber *, NSMutableData *> *fieldStatistics;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary<NSNumber *, _CPTFixedPointNumbers *> *fixedPointCache;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary<NSNumber *, NSMutableData *> *streamingBuffers;
 
 @property (nonatomic, readwrite, assign) BOOL needsRelabel;
 @property (nonatomic, readwrite, assign) NSRange labelIndexRange;
 @property (nonatomic, readwrite, strong, nullable) CPTMutableAnnotationArray *labelAnnotations;
 @property (nonatomic, readwrite, copy, nullable) CPTLayerArray *dataLabels;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary<id, NSMutableArray<CPTTextLayer *> *> *labelLayerPool;
+
+@property (nonatomic, readwrite, strong, nonnull) _CPTScratchArena *scratchArena;
+@property (nonatomic, readwrite, strong, nullable) _CPTRasterTileCache *rasterTileCache;
+@property (nonatomic, readwrite, assign) NSUInteger rasterTileRefreshGeneration;
+@property (nonatomic, readwrite, assign) NSTimeInterval renderingLatency;
+@property (nonatomic, readwrite, assign) CFTimeInterval renderRequestTime;
+@property (nonatomic, readwrite, assign) NSUInteger renderGeneration;
+@property (nonatomic, readwrite, strong, nullable) dispatch_queue_t renderQueue;
+@property (nonatomic, readwrite, strong, nullable) _CPTScratchArena *renderScratchArena;
+@property (nonatomic, readwrite, assign) BOOL isRenderSnapshot;
+@property (nonatomic, readwrite, assign) CGPoint renderSnapshotPlotAreaOffset;
+@property (nonatomic, readwrite, strong, nullable) NSMapTable *sharedCachedData;
+@property (nonatomic, readwrite, strong, nullable) NSHashTable<CPTPlot *> *cachedDataSharers;
+@property (nonatomic, readwrite, strong, nullable) NSHashTable<CPTMutableNumericData *> *adoptedCachedData;
+@property (nonatomic, readwrite, strong, nullable) CPTPlotSpace *renderPlotSpace;
+@property (nonatomic, readwrite, strong, nullable) CPTPlotArea *renderPlotArea;
+@property (nonatomic, readwrite, cpt_weak_property, nullable) CPTPlotSpace *renderPlotSpaceSource;
+@property (nonatomic, readwrite, strong, nullable) _CPTSpatialIndex *spatialIndex;
+@property (nonatomic, readwrite, assign) CGRect spatialIndexBounds;
+@property (nonatomic, readwrite, assign) NSUInteger spatialIndexDataCount;
 
 @property (nonatomic, readwrite, assign) NSUInteger pointingDeviceDownLabelIndex;
 @property (nonatomic, readwrite, assign) NSUInteger cachedDataCount;
@@ -67,8 +174,31 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 @property (nonatomic, readonly, assign) NSUInteger numberOfRecords;
 
 -(nonnull CPTMutableNumericData *)numericDataForNumbers:(nonnull id)numbers;
+-(void)cacheNumbers:(nullable id)numbers forField:(NSUInteger)fieldEnum atRecordIndex:(NSUInteger)idx copyingNumbers:(BOOL)copyNumbers;
 -(void)setCachedDataType:(CPTNumericDataType)newDataType;
 -(void)updateContentAnchorForLabel:(nonnull CPTPlotSpaceAnnotation *)label;
+-(void)flagVisibleLabelRecords:(nonnull BOOL *)visible count:(NSUInteger)count;
+-(void)recycleLabelAnnotation:(nonnull CPTPlotSpaceAnnotation *)annotation forIndex:(NSUInteger)idx;
+-(nonnull CPTTextLayer *)dequeueLabelLayerWithText:(nullable NSString *)text style:(nullable CPTTextStyle *)style;
+-(nonnull CPTTextLayer *)dequeueLabelLayerWithAttributedText:(nullable NSAttributedString *)text;
+-(BOOL)drawRasterTilesInContext:(nonnull CGContextRef)context;
+-(void)displayAsynchronously;
+-(nonnull CPTPlot *)renderSnapshot;
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot;
+-(void)detachCachedDataForKey:(nullable id)cacheKey;
+-(void)updateRenderPlotSpace;
+-(void)renderPlotSpaceMappingDidChange:(nonnull NSNotification *)notif;
+-(nullable id)hostingAppearance;
+-(nullable CGImageRef)newImageWithBounds:(CGRect)imageBounds scale:(CGFloat)scale flipped:(BOOL)flipped CF_RETURNS_RETAINED;
+
+-(nullable const CPTPlotFieldStatistics *)statisticsForField:(NSUInteger)fieldEnum numbers:(nonnull CPTNumericData *)numbers;
+-(void)updateStatisticsForKey:(nonnull NSNumber *)cacheKey cachedNumbers:(nonnull CPTNumericData *)cachedNumbers previousCount:(NSUInteger)previousCount replacingRange:(NSRange)indexRange withSamples:(nonnull const void *)samples;
+-(void)insertStatisticsPlaceholdersAtIndex:(NSUInteger)idx numberOfRecords:(NSUInteger)numberOfRecords;
+-(void)deleteStatisticsInIndexRange:(NSRange)indexRange;
+
+-(nonnull NSMutableData *)streamingBufferForKey:(nonnull NSNumber *)cacheKey numbers:(nonnull CPTMutableNumericData *)numbers minimumCount:(NSUInteger)minimumCount;
+-(void)appendRecords:(NSUInteger)numberOfRecords toStreamingNumbers:(nonnull CPTMutableNumericData *)numbers forKey:(nonnull NSNumber *)cacheKey;
+-(void)evictRecords:(NSUInteger)numberOfRecords fromStreamingNumbers:(nonnull CPTMutableNumericData *)numbers forKey:(nonnull NSNumber *)cacheKey;
 
 @end
 
@@ -150,6 +280,20 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
 @synthesize cachedData;
 
+/** @internal
+ *  @property nonnull NSMutableDictionary<NSNumber *, NSMutableData *> *fieldStatistics
+ *  @brief The running extrema and NaN counts of the cached numeric fields, keyed by field identifier.
+ *  A missing entry means the statistics for that field must be rebuilt from the cache.
+ **/
+@synthesize fieldStatistics;
+
+/** @internal
+ *  @property nonnull NSMutableDictionary<NSNumber *, _CPTFixedPointNumbers *> *fixedPointCache
+ *  @brief Fixed point copies of the cached NSDecimal fields, keyed by field identifier.
+ *  Used for range checks and view points; built on first use and dropped when the field changes.
+ **/
+@synthesize fixedPointCache;
+
 /** @property NSUInteger cachedDataCount
  *  @brief The number of data points stored in the cache.
  **/
@@ -165,6 +309,22 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
  **/
 @synthesize cachePrecision;
 
+/** @property NSUInteger streamingCapacity
+ *  @brief The number of records the data cache is sized for in streaming mode. Defaults to @num{0}, which turns streaming mode off.
+ *
+ *  In streaming mode, each numeric field is stored in a buffer with room for twice this many records and the
+ *  cached data is a window into that buffer. Records appended at the end with
+ *  @link CPTPlot::insertDataAtIndex:numberOfRecords: -insertDataAtIndex:numberOfRecords: @endlink and removed
+ *  from the start with @link CPTPlot::deleteDataInIndexRange: -deleteDataInIndexRange: @endlink move the window
+ *  instead of shifting the cached samples. The window is copied back to the start of the buffer only when it
+ *  reaches the end, so a sliding window of up to this many records costs constant amortized time per update.
+ *  The cached data is always presented as one contiguous array. The buffer grows if the cache holds more records
+ *  than the capacity allows.
+ **/
+@synthesize streamingCapacity;
+
+@synthesize streamingBuffers;
+
 /** @property CPTNumericDataType doubleDataType
  *  @brief The CPTNumericDataType used to cache plot data as @double.
  **/
@@ -228,15 +388,188 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
  **/
 @synthesize labelShadow;
 
+/** @property BOOL virtualizesLabels
+ *  @brief If @YES, only records whose data lies inside the plot space ranges get a data label. Defaults to @NO.
+ *
+ *  The ranges are widened by @ref virtualLabelMargin on each side. Labels scrolled out of view are removed and
+ *  their text layers kept in a pool, keyed by text style, for the labels that scroll into view. Changing the
+ *  plot ranges only creates or recycles the labels of records that enter or leave the visible region.
+ **/
+@synthesize virtualizesLabels;
+
+/** @property CGFloat virtualLabelMargin
+ *  @brief The fraction of each plot range length added on both sides of the range when deciding which
+ *  data labels to show with @ref virtualizesLabels. Defaults to @num{0.1}.
+ **/
+@synthesize virtualLabelMargin;
+
 @synthesize labelIndexRange;
 
 @synthesize labelAnnotations;
 
+@synthesize labelLayerPool;
+
+/** @internal
+ *  @property nullable _CPTSpatialIndex *spatialIndex
+ *  @brief The view space index used by the hit tests of the plot, built on the first query after a redisplay.
+ **/
+@synthesize spatialIndex;
+
+@synthesize spatialIndexBounds;
+
+@synthesize spatialIndexDataCount;
+
 /** @property BOOL alignsPointsToPixels
  *  @brief If @YES (the default), all plot points will be aligned to device pixels when drawing.
  **/
 @synthesize alignsPointsToPixels;
 
+/** @property NSUInteger scratchArenaCapacity
+ *  @brief The number of bytes held for the temporary buffers used while drawing the plot.
+ *
+ *  The buffers are kept between frames and grow to the largest frame drawn. They are
+ *  released when the data is reloaded or the system runs short of memory.
+ **/
+@dynamic scratchArenaCapacity;
+
+/** @property NSUInteger scratchArenaAllocationCount
+ *  @brief The number of times memory was requested from the system for the temporary drawing buffers.
+ *
+ *  Once the buffers have grown to fit the data this count stops increasing from frame to frame.
+ **/
+@dynamic scratchArenaAllocationCount;
+
+/** @internal
+ *  @property nonnull _CPTScratchArena *scratchArena
+ *  @brief The temporary buffers of the plot, created on first use.
+ **/
+@synthesize scratchArena;
+
+/** @property BOOL cachesRasterTiles
+ *  @brief If @YES, the plot is drawn into bitmap tiles laid out in plot coordinates and kept between frames. Defaults to @NO.
+ *
+ *  While the plot space is scrolled the cached tiles are composited and only the part of the plot that comes
+ *  into view is rendered. After a zoom the tiles are shown resized until the zoom settles and they are rendered
+ *  again at the new scale. Tiles are only used with linear scales in a CPTXYPlotSpace; other plots are drawn
+ *  directly. Vector output such as PDF export always draws the plot directly.
+ **/
+@synthesize cachesRasterTiles;
+
+/** @internal
+ *  @property nullable _CPTRasterTileCache *rasterTileCache
+ *  @brief The tiles drawn when @ref cachesRasterTiles is @YES.
+ **/
+@synthesize rasterTileCache;
+
+/** @internal
+ *  @property NSUInteger rasterTileRefreshGeneration
+ *  @brief Counts the draws that showed stale tiles. Only the refresh scheduled by the latest one renders the tiles again.
+ **/
+@synthesize rasterTileRefreshGeneration;
+
+/** @property BOOL rendersAsynchronously
+ *  @brief If @YES, the plot is drawn on a background queue and the finished bitmap is shown when it is ready. Defaults to @NO.
+ *
+ *  Each frame draws a snapshot of the plot taken on the main thread, with its own copy of the cached data
+ *  and plot space, so the data can be reloaded and the plot space changed while the frame is drawn. Frames
+ *  requested while another one is drawn are coalesced. Delegate and data source methods called while drawing, such as
+ *  @link CPTScatterPlotDelegate::scatterPlot:prepareForDrawingPlotLine:inContext: -scatterPlot:prepareForDrawingPlotLine:inContext: @endlink,
+ *  are called on the background queue; @link CPTPlotDelegate::didFinishDrawing: -didFinishDrawing: @endlink is called
+ *  on the main thread once the frame is shown.
+ *
+ *  The plot is drawn synchronously when @ref cachesRasterTiles is @YES or the class does not
+ *  @link CPTPlot::supportsAsynchronousRendering +supportsAsynchronousRendering @endlink.
+ **/
+@synthesize rendersAsynchronously;
+
+/** @property NSTimeInterval renderingLatency
+ *  @brief The time in seconds from the request to redraw the plot to the last frame being shown.
+ *
+ *  When the plot is drawn synchronously this is the time to the end of drawing.
+ **/
+@synthesize renderingLatency;
+
+/** @internal
+ *  @property CFTimeInterval renderRequestTime
+ *  @brief The media time of the first redisplay request since the last frame, or zero if there is none.
+ **/
+@synthesize renderRequestTime;
+
+/** @internal
+ *  @property NSUInteger renderGeneration
+ *  @brief Counts the frames started by asynchronous rendering.
+ **/
+@synthesize renderGeneration;
+
+/** @internal
+ *  @property nullable dispatch_queue_t renderQueue
+ *  @brief The serial queue frames are drawn on when @ref rendersAsynchronously is @YES.
+ **/
+@synthesize renderQueue;
+
+/** @internal
+ *  @property nullable _CPTScratchArena *renderScratchArena
+ *  @brief The temporary buffers shared by the snapshots drawn on @ref renderQueue.
+ **/
+@synthesize renderScratchArena;
+
+/** @internal
+ *  @property BOOL isRenderSnapshot
+ *  @brief @YES if the plot is a copy taken to be drawn on the render queue.
+ **/
+@synthesize isRenderSnapshot;
+
+/** @internal
+ *  @property CGPoint renderSnapshotPlotAreaOffset
+ *  @brief The origin of the plot area in the coordinates of the plot when the snapshot was taken.
+ **/
+@synthesize renderSnapshotPlotAreaOffset;
+
+/** @internal
+ *  @property nullable NSMapTable *sharedCachedData
+ *  @brief The cached data objects shared with @ref cachedDataSharers, by cache key.
+ *
+ *  A render snapshot holds the cached data as it was when the snapshot was taken. Whichever of the plot
+ *  and the snapshot changes a shared object in place first replaces it by a copy.
+ **/
+@synthesize sharedCachedData;
+
+/** @internal
+ *  @property nullable NSHashTable<CPTPlot *> *cachedDataSharers
+ *  @brief The render snapshots of a plot, or the plot of a render snapshot, that @ref sharedCachedData is shared with.
+ *
+ *  Held weakly, so nothing is copied once they are gone.
+ **/
+@synthesize cachedDataSharers;
+
+/** @internal
+ *  @property nullable NSHashTable<CPTMutableNumericData *> *adoptedCachedData
+ *  @brief The cached data objects that wrap a buffer adopted from the data source.
+ *
+ *  The buffer still belongs to the data source, so the plot copies it before the first change in place.
+ **/
+@synthesize adoptedCachedData;
+
+/** @internal
+ *  @property nullable CPTPlotSpace *renderPlotSpace
+ *  @brief The copy of the plot space the render snapshots map the data with.
+ *
+ *  The plot keeps the copy until its plot space or the size of the plot area changes.
+ **/
+@synthesize renderPlotSpace;
+
+/** @internal
+ *  @property nullable CPTPlotArea *renderPlotArea
+ *  @brief A plot area outside the layer tree with the bounds of the plot area, used by @ref renderPlotSpace.
+ **/
+@synthesize renderPlotArea;
+
+/** @internal
+ *  @property nullable CPTPlotSpace *renderPlotSpaceSource
+ *  @brief The plot space @ref renderPlotSpace was copied from.
+ **/
+@synthesize renderPlotSpaceSource;
+
 /** @property BOOL drawLegendSwatchDecoration
  *  @brief If @YES (the default), additional plot-specific decorations, symbols, and/or colors will be drawn on top of the legend swatch rectangle.
  **/
@@ -278,6 +611,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
  *  This is the designated initializer. The initialized layer will have the following properties:
  *  - @ref cachedDataCount = @num{0}
  *  - @ref cachePrecision = #CPTPlotCachePrecisionAuto
+ *  - @ref streamingCapacity = @num{0}
  *  - @ref dataSource = @nil
  *  - @ref title = @nil
  *  - @ref attributedTitle = @nil
@@ -292,7 +626,11 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
  *  - @ref labelTextStyle = @nil
  *  - @ref labelFormatter = @nil
  *  - @ref labelShadow = @nil
+ *  - @ref virtualizesLabels = @NO
+ *  - @ref virtualLabelMargin = @num{0.1}
  *  - @ref alignsPointsToPixels = @YES
+ *  - @ref cachesRasterTiles = @NO
+ *  - @ref rendersAsynchronously = @NO
  *  - @ref drawLegendSwatchDecoration = @YES
  *  - @ref masksToBounds = @YES
  *  - @ref needsDisplayOnBoundsChange = @YES
@@ -304,8 +642,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 {
     if ((self = [super initWithFrame:newFrame])) {
         cachedData           = [[NSMutableDictionary alloc] initWithCapacity:5];
+        fieldStatistics      = [[NSMutableDictionary alloc] initWithCapacity:5];
+        fixedPointCache      = [[NSMutableDictionary alloc] initWithCapacity:5];
+        streamingBuffers     = [[NSMutableDictionary alloc] initWithCapacity:5];
         cachedDataCount      = 0;
         cachePrecision       = CPTPlotCachePrecisionAuto;
+        streamingCapacity    = 0;
         dataSource           = nil;
         title                = nil;
         attributedTitle      = nil;
@@ -320,11 +662,18 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         labelTextStyle       = nil;
         labelFormatter       = nil;
         labelShadow          = nil;
+        virtualizesLabels    = NO;
+        virtualLabelMargin   = CPTFloat(0.1);
         labelIndexRange      = NSMakeRange(0, 0);
         labelAnnotations     = nil;
+        labelLayerPool       = [[NSMutableDictionary alloc] init];
         alignsPointsToPixels = YES;
+        cachesRasterTiles    = NO;
         inTitleUpdate        = NO;
 
+        rendersAsynchronously = NO;
+        renderingLatency      = 0.0;
+
         pointingDeviceDownLabelIndex = NSNotFound;
         drawLegendSwatchDecoration   = YES;
 
@@ -344,8 +693,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         CPTPlot *theLayer = (CPTPlot *)layer;
 
         cachedData           = theLayer->cachedData;
+        fieldStatistics      = theLayer->fieldStatistics;
+        fixedPointCache      = theLayer->fixedPointCache;
+        streamingBuffers     = theLayer->streamingBuffers;
         cachedDataCount      = theLayer->cachedDataCount;
         cachePrecision       = theLayer->cachePrecision;
+        streamingCapacity    = theLayer->streamingCapacity;
         dataSource           = theLayer->dataSource;
         title                = theLayer->title;
         attributedTitle      = theLayer->attributedTitle;
@@ -360,17 +713,29 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         labelTextStyle       = theLayer->labelTextStyle;
         labelFormatter       = theLayer->labelFormatter;
         labelShadow          = theLayer->labelShadow;
+        virtualizesLabels    = theLayer->virtualizesLabels;
+        virtualLabelMargin   = theLayer->virtualLabelMargin;
         labelIndexRange      = theLayer->labelIndexRange;
         labelAnnotations     = theLayer->labelAnnotations;
+        labelLayerPool       = [[NSMutableDictionary alloc] init];
         alignsPointsToPixels = theLayer->alignsPointsToPixels;
+        cachesRasterTiles    = theLayer->cachesRasterTiles;
         inTitleUpdate        = theLayer->inTitleUpdate;
 
+        rendersAsynchronously = theLayer->rendersAsynchronously;
+        renderingLatency      = theLayer->renderingLatency;
+
         drawLegendSwatchDecoration   = theLayer->drawLegendSwatchDecoration;
         pointingDeviceDownLabelIndex = NSNotFound;
     }
     return self;
 }
 
+-(void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 /// @endcond
 
 #pragma mark -
@@ -391,6 +756,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     [coder encodeObject:self.attributedTitle forKey:@"CPTPlot.attributedTitle"];
     [coder encodeObject:self.plotSpace forKey:@"CPTPlot.plotSpace"];
     [coder encodeInteger:self.cachePrecision forKey:@"CPTPlot.cachePrecision"];
+    [coder encodeInteger:(NSInteger)self.streamingCapacity forKey:@"CPTPlot.streamingCapacity"];
     [coder encodeBool:self.needsRelabel forKey:@"CPTPlot.needsRelabel"];
     [coder encodeBool:self.adjustLabelAnchors forKey:@"CPTPlot.adjustLabelAnchors"];
     [coder encodeBool:self.showLabels forKey:@"CPTPlot.showLabels"];
@@ -400,14 +766,31 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     [coder encodeObject:self.labelTextStyle forKey:@"CPTPlot.labelTextStyle"];
     [coder encodeObject:self.labelFormatter forKey:@"CPTPlot.labelFormatter"];
     [coder encodeObject:self.labelShadow forKey:@"CPTPlot.labelShadow"];
+    [coder encodeBool:self.virtualizesLabels forKey:@"CPTPlot.virtualizesLabels"];
+    [coder encodeCGFloat:self.virtualLabelMargin forKey:@"CPTPlot.virtualLabelMargin"];
     [coder encodeObject:[NSValue valueWithRange:self.labelIndexRange] forKey:@"CPTPlot.labelIndexRange"];
     [coder encodeObject:self.labelAnnotations forKey:@"CPTPlot.labelAnnotations"];
     [coder encodeBool:self.alignsPointsToPixels forKey:@"CPTPlot.alignsPointsToPixels"];
+    [coder encodeBool:self.cachesRasterTiles forKey:@"CPTPlot.cachesRasterTiles"];
+    [coder encodeBool:self.rendersAsynchronously forKey:@"CPTPlot.rendersAsynchronously"];
     [coder encodeBool:self.drawLegendSwatchDecoration forKey:@"CPTPlot.drawLegendSwatchDecoration"];
 
     // No need to archive these properties:
     // dataNeedsReloading
     // cachedData
+    // fieldStatistics
+    // fixedPointCache
+    // streamingBuffers
+    // labelLayerPool
+    // rasterTileCache
+    // renderingLatency
+    // renderQueue
+    // renderScratchArena
+    // sharedCachedData
+    // cachedDataSharers
+    // adoptedCachedData
+    // renderPlotSpace
+    // renderPlotArea
     // cachedDataCount
     // inTitleUpdate
     // pointingDeviceDownLabelIndex
@@ -425,6 +808,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         plotSpace = [coder decodeObjectOfClass:[CPTPlotSpace class]
                                         forKey:@"CPTPlot.plotSpace"];
         cachePrecision     = (CPTPlotCachePrecision)[coder decodeIntegerForKey:@"CPTPlot.cachePrecision"];
+        streamingCapacity  = (NSUInteger)[coder decodeIntegerForKey:@"CPTPlot.streamingCapacity"];
         needsRelabel       = [coder decodeBoolForKey:@"CPTPlot.needsRelabel"];
         adjustLabelAnchors = [coder decodeBoolForKey:@"CPTPlot.adjustLabelAnchors"];
         showLabels         = [coder decodeBoolForKey:@"CPTPlot.showLabels"];
@@ -437,11 +821,16 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
                                              forKey:@"CPTPlot.labelFormatter"];
         labelShadow = [coder decodeObjectOfClass:[CPTShadow class]
                                           forKey:@"CPTPlot.labelShadow"];
+        virtualizesLabels  = [coder decodeBoolForKey:@"CPTPlot.virtualizesLabels"];
+        virtualLabelMargin = [coder containsValueForKey:@"CPTPlot.virtualLabelMargin"] ? [coder decodeCGFloatForKey:@"CPTPlot.virtualLabelMargin"] : CPTFloat(0.1);
         labelIndexRange = [[coder decodeObjectOfClass:[NSValue class]
                                                forKey:@"CPTPlot.labelIndexRange"] rangeValue];
         labelAnnotations = [[coder decodeObjectOfClasses:[NSSet setWithArray:@[[NSArray class], [CPTAnnotation class]]]
                                                   forKey:@"CPTPlot.labelAnnotations"] mutableCopy];
         alignsPointsToPixels = [coder decodeBoolForKey:@"CPTPlot.alignsPointsToPixels"];
+        cachesRasterTiles    = [coder decodeBoolForKey:@"CPTPlot.cachesRasterTiles"];
+
+        rendersAsynchronously = [coder decodeBoolForKey:@"CPTPlot.rendersAsynchronously"];
 
         drawLegendSwatchDecoration = [coder decodeBoolForKey:@"CPTPlot.drawLegendSwatchDecoration"];
 
@@ -453,6 +842,10 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
         // init other properties
         cachedData         = [[NSMutableDictionary alloc] initWithCapacity:5];
+        fieldStatistics    = [[NSMutableDictionary alloc] initWithCapacity:5];
+        fixedPointCache    = [[NSMutableDictionary alloc] initWithCapacity:5];
+        streamingBuffers   = [[NSMutableDictionary alloc] initWithCapacity:5];
+        labelLayerPool     = [[NSMutableDictionary alloc] init];
         cachedDataCount    = 0;
         dataNeedsReloading = YES;
         inTitleUpdate      = NO;
@@ -497,10 +890,39 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
 /// @cond
 
+-(void)display
+{
+    if ( self.rendersAsynchronously && !self.isRenderSnapshot && !self.hidden && !self.cachesRasterTiles &&
+         [[self class] supportsAsynchronousRendering] ) {
+        [self displayAsynchronously];
+    }
+    else {
+        [super display];
+    }
+}
+
 -(void)drawInContext:(nonnull CGContextRef)context
 {
+    if ( self.isRenderSnapshot ) {
+        // the data was loaded when the snapshot was taken
+        [super drawInContext:context];
+        return;
+    }
+
+    CFTimeInterval startTime = self.renderRequestTime;
+
+    if ( startTime <= 0.0 ) {
+        startTime = CACurrentMediaTime();
+    }
+
     [self reloadDataIfNeeded];
-    [super drawInContext:context];
+
+    if ( ![self drawRasterTilesInContext:context] ) {
+        [super drawInContext:context];
+    }
+
+    self.renderingLatency  = CACurrentMediaTime() - startTime;
+    self.renderRequestTime = 0.0;
 
     id<CPTPlotDelegate> theDelegate = (id<CPTPlotDelegate>)self.delegate;
 
@@ -509,125 +931,618 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
-/// @endcond
-
-#pragma mark -
-#pragma mark Animation
-
-/// @cond
+-(void)setNeedsDisplay
+{
+    // data, plot range and style changes all redisplay the plot, so the view points behind the hit test index are stale
+    [self invalidateSpatialIndex];
+    [self.rasterTileCache removeAllTiles];
+    if ( self.renderRequestTime <= 0.0 ) {
+        self.renderRequestTime = CACurrentMediaTime();
+    }
+    [super setNeedsDisplay];
+}
 
-+(BOOL)needsDisplayForKey:(nonnull NSString *)aKey
+-(void)setNeedsDisplayKeepingRasterTiles
 {
-    static NSSet<NSString *> *keys   = nil;
-    static dispatch_once_t onceToken = 0;
+    [self invalidateSpatialIndex];
+    if ( self.renderRequestTime <= 0.0 ) {
+        self.renderRequestTime = CACurrentMediaTime();
+    }
+    [super setNeedsDisplay];
+}
 
-    dispatch_once(&onceToken, ^{
-        keys = [NSSet setWithArray:@[@"labelOffset",
-                                     @"labelRotation"]];
-    });
+-(CGPoint)convertPoint:(CGPoint)point fromLayer:(nullable CALayer *)layer
+{
+    CPTPlotArea *thePlotArea = self.plotArea;
 
-    if ( [keys containsObject:aKey] ) {
-        return YES;
-    }
-    else {
-        return [super needsDisplayForKey:aKey];
+    if ( self.isRenderSnapshot && thePlotArea && (layer == thePlotArea)) {
+        // the snapshot is not in the layer tree
+        CGPoint offset = self.renderSnapshotPlotAreaOffset;
+        return CGPointMake(point.x + offset.x, point.y + offset.y);
     }
+
+    return [super convertPoint:point fromLayer:layer];
 }
 
 /// @endcond
 
-#pragma mark -
-#pragma mark Layout
+/**
+ *  @brief Whether the plot can be drawn on a background queue when @ref rendersAsynchronously is @YES.
+ *
+ *  Subclasses that keep state between frames that drawing changes should return @NO, unless they take that
+ *  state back from the render snapshot when the frame is shown. The default is @YES.
+ *  @return @YES if the plot can be drawn asynchronously.
+ **/
++(BOOL)supportsAsynchronousRendering
+{
+    return YES;
+}
 
 /// @cond
 
--(void)layoutSublayers
+/** @internal
+ *  @brief Draws a snapshot of the plot on the render queue and shows the bitmap when it is done.
+ **/
+-(void)displayAsynchronously
 {
-    [self relabel];
-    [super layoutSublayers];
-}
+    // the data source is only called on the main thread
+    [self reloadDataIfNeeded];
 
-/// @endcond
+    CPTPlot *snapshot = [self renderSnapshot];
+    id appearance     = [self hostingAppearance];
 
-#pragma mark -
-#pragma mark Data Source
+    CGRect layerBounds  = self.bounds;
+    CGFloat scale       = self.contentsScale;
+    BOOL flipped        = self.contentsAreFlipped;
+    NSUInteger frameNum = self.renderGeneration + 1;
 
-/// @cond
+    CFTimeInterval requestTime = self.renderRequestTime;
 
--(NSUInteger)numberOfRecords
-{
-    id<CPTPlotDataSource> theDataSource = self.dataSource;
+    if ( requestTime <= 0.0 ) {
+        requestTime = CACurrentMediaTime();
+    }
 
-    return [theDataSource numberOfRecordsForPlot:self];
-}
+    self.renderGeneration  = frameNum;
+    self.renderRequestTime = 0.0;
 
-/// @endcond
+    dispatch_queue_t queue = self.renderQueue;
 
-/**
- *  @brief Marks the receiver as needing the data source reloaded before the content is next drawn.
- **/
--(void)setDataNeedsReloading
-{
-    self.dataNeedsReloading = YES;
+    if ( !queue ) {
+        queue = dispatch_queue_create(CPTPlotRenderQueueLabel,
+                                      dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        self.renderQueue = queue;
+    }
+
+    __weak CPTPlot *weakSelf = self;
+
+    dispatch_async(queue, ^{
+        // skip frames that were replaced before they could start
+        if ( weakSelf.renderGeneration != frameNum ) {
+            return;
+        }
+
+        __block CGImageRef image = NULL;
+
+        CPTPlotPerformWithAppearance(appearance, ^{
+            image = [snapshot newImageWithBounds:layerBounds scale:scale flipped:flipped];
+        });
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            CPTPlot *strongSelf = weakSelf;
+
+            // the plot is drawn directly again once asynchronous rendering is turned off
+            if ( strongSelf.rendersAsynchronously && image ) {
+                [strongSelf didRenderSnapshot:snapshot];
+
+                [CATransaction begin];
+                [CATransaction setDisableActions:YES];
+                strongSelf.contents = (__bridge id)image;
+                [CATransaction commit];
+
+                strongSelf.renderingLatency = CACurrentMediaTime() - requestTime;
+
+                id<CPTPlotDelegate> theDelegate = (id<CPTPlotDelegate>)strongSelf.delegate;
+
+                if ( [theDelegate respondsToSelector:@selector(didFinishDrawing:)] ) {
+                    [theDelegate didFinishDrawing:strongSelf];
+                }
+            }
+            CGImageRelease(image);
+        });
+    });
 }
 
-/**
- *  @brief Reload all plot data, labels, and plot-specific information from the data source immediately.
+/** @internal
+ *  @brief Called on the main thread when a frame drawn from a render snapshot is shown.
+ *
+ *  Subclasses take over any state the snapshot worked out while drawing. The default takes over the
+ *  fixed point copies the snapshot built for data the plot still holds.
+ *
+ *  @param snapshot The snapshot the frame was drawn from.
  **/
--(void)reloadData
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot
 {
-    [self.cachedData removeAllObjects];
-    self.cachedDataCount = 0;
+    NSMutableDictionary<NSNumber *, _CPTFixedPointNumbers *> *theFixedPointCache = self.fixedPointCache;
 
-    [self reloadDataInIndexRange:NSMakeRange(0, self.numberOfRecords)];
+    [snapshot.fixedPointCache enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, _CPTFixedPointNumbers *fixedPoint, BOOL *__unused stop) {
+        CPTMutableNumericData *numbers = [self cachedNumbersForField:key.unsignedIntegerValue];
+
+        if ( numbers && !theFixedPointCache[key] && [fixedPoint isValidForNumbers:numbers] ) {
+            theFixedPointCache[key] = fixedPoint;
+        }
+    }];
 }
 
-/**
- *  @brief Reload plot data from the data source only if the data cache is out of date.
+/** @internal
+ *  @brief Copies the plot so it can be drawn off the main thread.
+ *
+ *  The snapshot shares the cached data with the plot until either of them changes it, and maps the data
+ *  with a copy of the plot space that is not linked to the layer tree.
+ *
+ *  @return The snapshot.
  **/
--(void)reloadDataIfNeeded
+-(nonnull CPTPlot *)renderSnapshot
 {
-    if ( self.dataNeedsReloading ) {
-        [self reloadData];
+    CPTPlot *snapshot = [[[self class] alloc] initWithLayer:self];
+
+    snapshot.bounds        = self.bounds;
+    snapshot.contentsScale = self.contentsScale;
+    snapshot.graph         = nil;
+
+    snapshot.isRenderSnapshot             = YES;
+    snapshot.renderSnapshotPlotAreaOffset = [self convertPoint:CGPointZero fromLayer:self.plotArea];
+
+    // the data can be reloaded on the main thread while the snapshot draws; the fixed point copies are never
+    // changed in place, so the snapshot starts with the ones already built for the shared data
+    NSMutableDictionary *dataCache = self.cachedData;
+    NSMapTable *sharedData         = self.sharedCachedData;
+    NSHashTable *sharers           = self.cachedDataSharers;
+
+    if ( !sharedData ) {
+        sharedData             = [NSMapTable strongToWeakObjectsMapTable];
+        sharers                = [NSHashTable weakObjectsHashTable];
+        self.sharedCachedData  = sharedData;
+        self.cachedDataSharers = sharers;
     }
-}
+    [sharers addObject:snapshot];
 
-/** @brief Reload plot data, labels, and plot-specific information in the given index range from the data source immediately.
- *  @param indexRange The index range to load.
- **/
--(void)reloadDataInIndexRange:(NSRange)indexRange
-{
-    NSParameterAssert(NSMaxRange(indexRange) <= self.numberOfRecords);
+    NSMapTable *snapshotSharedData = [NSMapTable strongToWeakObjectsMapTable];
+    NSHashTable *snapshotSharers   = [NSHashTable weakObjectsHashTable];
 
-    self.dataNeedsReloading = NO;
+    [snapshotSharers addObject:self];
 
-    [self reloadPlotDataInIndexRange:indexRange];
+    [dataCache enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *__unused stop) {
+        [sharedData setObject:obj forKey:key];
+        [snapshotSharedData setObject:obj forKey:key];
+    }];
 
-    // Data labels
-    [self reloadDataLabelsInIndexRange:indexRange];
+    snapshot.cachedData        = [dataCache mutableCopy];
+    snapshot.sharedCachedData  = snapshotSharedData;
+    snapshot.cachedDataSharers = snapshotSharers;
+    snapshot.fieldStatistics   = [[NSMutableDictionary alloc] initWithCapacity:5];
+    snapshot.fixedPointCache   = [self.fixedPointCache mutableCopy];
+    snapshot.streamingBuffers  = [[NSMutableDictionary alloc] initWithCapacity:5];
+
+    // as can the plot ranges
+    [self updateRenderPlotSpace];
+
+    CPTPlotSpace *plotSpaceCopy = self.renderPlotSpace;
+
+    if ( plotSpaceCopy ) {
+        snapshot.plotSpace       = plotSpaceCopy;
+        snapshot.renderPlotSpace = plotSpaceCopy;
+        snapshot.renderPlotArea  = self.renderPlotArea;
+    }
+
+    // the snapshots are drawn one at a time on the render queue
+    _CPTScratchArena *arena = self.renderScratchArena;
+
+    if ( !arena ) {
+        arena                   = [[_CPTScratchArena alloc] init];
+        self.renderScratchArena = arena;
+    }
+    snapshot.scratchArena = arena;
+
+    return snapshot;
 }
 
-/** @brief Insert records into the plot data cache at the given index.
- *  @param idx             The starting index of the new records.
- *  @param numberOfRecords The number of records to insert.
+/** @internal
+ *  @brief Replaces cached data shared with the data source or a render snapshot by a private copy before it is changed in place.
+ *  @param cacheKey The cache key of the data that will change, or @nil for all of the cached data.
+ **/
+-(void)detachCachedDataForKey:(nullable id)cacheKey
+{
+    NSHashTable<CPTMutableNumericData *> *adoptedData = self.adoptedCachedData;
+
+    if ( adoptedData.allObjects.count > 0 ) {
+        NSMutableDictionary *dataCache = self.cachedData;
+        NSArray *keys                  = cacheKey ? @[cacheKey] : dataCache.allKeys;
+
+        for ( id key in keys ) {
+            id data = dataCache[key];
+
+            if ( data && [adoptedData containsObject:data] ) {
+                // the data source buffer is only read
+                dataCache[key] = [data mutableCopy];
+                [adoptedData removeObject:data];
+            }
+        }
+    }
+
+    NSMapTable *sharedData = self.sharedCachedData;
+
+    if ( sharedData.count == 0 ) {
+        return;
+    }
+
+    if ( self.cachedDataSharers.allObjects.count == 0 ) {
+        // the snapshots are done with the data
+        [sharedData removeAllObjects];
+        return;
+    }
+
+    NSMutableDictionary *dataCache = self.cachedData;
+    NSArray *keys                  = cacheKey ? @[cacheKey] : sharedData.keyEnumerator.allObjects;
+
+    for ( id key in keys ) {
+        id data = dataCache[key];
+
+        if ( data && (data == [sharedData objectForKey:key])) {
+            // the copy of a streaming window has its own buffer, the snapshot keeps the old one
+            dataCache[key] = [data mutableCopy];
+        }
+        [sharedData removeObjectForKey:key];
+    }
+}
+
+/** @internal
+ *  @brief Copies the plot space for the render snapshots unless the copy made for an earlier snapshot still matches.
+ **/
+-(void)updateRenderPlotSpace
+{
+    CPTPlotSpace *thePlotSpace = self.plotSpace;
+    CPTPlotArea *thePlotArea   = self.plotArea;
+    CGRect plotAreaBounds      = thePlotArea ? thePlotArea.bounds : CGRectZero;
+
+    if ( self.renderPlotSpace && (thePlotSpace == self.renderPlotSpaceSource) &&
+         CGRectEqualToRect(plotAreaBounds, self.renderPlotArea.bounds)) {
+        return;
+    }
+
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+    CPTPlotSpace *oldSource                  = self.renderPlotSpaceSource;
+
+    if ( oldSource != thePlotSpace ) {
+        if ( oldSource ) {
+            [notificationCenter removeObserver:self
+                                          name:CPTPlotSpaceCoordinateMappingDidChangeNotification
+                                        object:oldSource];
+        }
+        if ( thePlotSpace ) {
+            [notificationCenter addObserver:self
+                                   selector:@selector(renderPlotSpaceMappingDidChange:)
+                                       name:CPTPlotSpaceCoordinateMappingDidChangeNotification
+                                     object:thePlotSpace];
+        }
+        self.renderPlotSpaceSource = thePlotSpace;
+    }
+
+    self.renderPlotSpace = nil;
+    self.renderPlotArea  = nil;
+
+    if ( !thePlotSpace ) {
+        return;
+    }
+
+    NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initRequiringSecureCoding:NO];
+
+    [archiver encodeObject:thePlotSpace forKey:NSKeyedArchiveRootObjectKey];
+    [archiver finishEncoding];
+
+    NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:archiver.encodedData error:NULL];
+
+    unarchiver.requiresSecureCoding = NO;
+
+    CPTPlotSpace *plotSpaceCopy = [unarchiver decodeObjectForKey:NSKeyedArchiveRootObjectKey];
+
+    [unarchiver finishDecoding];
+
+    // the copy maps to a plot area of the same size that is not in the layer tree
+    CPTPlotArea *plotAreaCopy = nil;
+
+    if ( thePlotArea ) {
+        plotAreaCopy        = [[CPTPlotArea alloc] initWithFrame:CGRectZero];
+        plotAreaCopy.bounds = plotAreaBounds;
+    }
+    plotSpaceCopy.graph            = nil;
+    plotSpaceCopy.detachedPlotArea = plotAreaCopy;
+
+    self.renderPlotSpace = plotSpaceCopy;
+    self.renderPlotArea  = plotAreaCopy;
+}
+
+/** @internal
+ *  @brief Drops the copy of the plot space when the plot ranges or scale types change.
+ *  @param notif The change notification.
+ **/
+-(void)renderPlotSpaceMappingDidChange:(nonnull NSNotification *__unused)notif
+{
+    self.renderPlotSpace = nil;
+    self.renderPlotArea  = nil;
+}
+
+/** @internal
+ *  @brief Gets the appearance of the hosting view to draw a render snapshot with.
+ *  @return The effective @ref NSAppearance on macOS or the @ref UITraitCollection on iOS, or @nil if there is no hosting view.
+ **/
+-(nullable id)hostingAppearance
+{
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+#if TARGET_OS_OSX
+    if ( [NSView instancesRespondToSelector:@selector(effectiveAppearance)] ) {
+        return [self findHostingView].effectiveAppearance;
+    }
+#else
+#ifdef __IPHONE_13_0
+    if ( @available(iOS 13, *)) {
+        if ( [UITraitCollection instancesRespondToSelector:@selector(performAsCurrentTraitCollection:)] ) {
+            return [self findHostingView].traitCollection;
+        }
+    }
+#endif
+#endif
+#pragma clang diagnostic pop
+    return nil;
+}
+
+/** @internal
+ *  @brief Draws the plot into a new bitmap.
+ *  @param imageBounds The bounds of the layer.
+ *  @param scale The contents scale of the layer.
+ *  @param flipped Whether the contents of the layer are flipped.
+ *  @return The image, or @NULL if the layer is empty. The caller must release it.
+ **/
+-(nullable CGImageRef)newImageWithBounds:(CGRect)imageBounds scale:(CGFloat)scale flipped:(BOOL)flipped
+{
+    size_t width  = (size_t)ceil(imageBounds.size.width * scale);
+    size_t height = (size_t)ceil(imageBounds.size.height * scale);
+
+    if ((width == 0) || (height == 0)) {
+        return NULL;
+    }
+
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    if ( !context ) {
+        return NULL;
+    }
+
+    if ( flipped ) {
+        CGContextTranslateCTM(context, CPTFloat(0.0), (CGFloat)height);
+        CGContextScaleCTM(context, CPTFloat(1.0), CPTFloat(-1.0));
+    }
+    CGContextScaleCTM(context, scale, scale);
+    CGContextTranslateCTM(context, -imageBounds.origin.x, -imageBounds.origin.y);
+
+    [self drawInContext:context];
+
+    CGImageRef image = CGBitmapContextCreateImage(context);
+
+    CGContextRelease(context);
+
+    return image;
+}
+
+/** @internal
+ *  @brief Draws the plot from cached bitmap tiles when @ref cachesRasterTiles is @YES.
+ *  @param context The graphics context to draw into.
+ *  @return        @YES if the plot was drawn, @NO if it must be drawn directly.
+ **/
+-(BOOL)drawRasterTilesInContext:(nonnull CGContextRef)context
+{
+    if ( !self.cachesRasterTiles ) {
+        return NO;
+    }
+
+    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
+    CPTPlotArea *thePlotArea     = self.plotArea;
+
+    if ( ![thePlotSpace isKindOfClass:[CPTXYPlotSpace class]] || !thePlotArea ||
+         (thePlotSpace.xScaleType != CPTScaleTypeLinear) || (thePlotSpace.yScaleType != CPTScaleTypeLinear)) {
+        return NO;
+    }
+
+    // the scales are linear, so the ends of the ranges give the mapping from plot coordinates to this layer
+    CPTPlotRange *xRange = thePlotSpace.xRange;
+    CPTPlotRange *yRange = thePlotSpace.yRange;
+
+    double startPoint[2] = { xRange.locationDouble, yRange.locationDouble };
+    double endPoint[2]   = { xRange.endDouble, yRange.endDouble };
+
+    CGPoint startViewPoint = [self convertPoint:[thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:startPoint numberOfCoordinates:2] fromLayer:thePlotArea];
+    CGPoint endViewPoint   = [self convertPoint:[thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:endPoint numberOfCoordinates:2] fromLayer:thePlotArea];
+
+    CPTRasterTileMapping mapping;
+
+    mapping.scale[0]  = ((double)endViewPoint.x - (double)startViewPoint.x) / (endPoint[0] - startPoint[0]);
+    mapping.scale[1]  = ((double)endViewPoint.y - (double)startViewPoint.y) / (endPoint[1] - startPoint[1]);
+    mapping.offset[0] = (double)startViewPoint.x - mapping.scale[0] * startPoint[0];
+    mapping.offset[1] = (double)startViewPoint.y - mapping.scale[1] * startPoint[1];
+
+    _CPTRasterTileCache *tileCache = self.rasterTileCache;
+
+    if ( !tileCache ) {
+        tileCache            = [[_CPTRasterTileCache alloc] init];
+        self.rasterTileCache = tileCache;
+    }
+
+    BOOL drawn = [tileCache drawInContext:context
+                                   bounds:self.bounds
+                                  mapping:mapping
+                            contentsScale:self.contentsScale
+                                 renderer:^(CGContextRef tileContext) {
+        [super drawInContext:tileContext];
+    }];
+
+    if ( tileCache.showsStaleTiles ) {
+        // render the tiles again at the new scale once the zoom has settled, every zoom step restarts the wait
+        self.rasterTileRefreshGeneration++;
+
+        NSUInteger refreshGeneration = self.rasterTileRefreshGeneration;
+        __weak CPTPlot *weakSelf     = self;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(CPTPlotRasterTileRefreshDelay * (double)NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            CPTPlot *strongSelf = weakSelf;
+
+            if ( strongSelf.rasterTileRefreshGeneration == refreshGeneration ) {
+                [strongSelf setNeedsDisplay];
+            }
+        });
+    }
+
+    return drawn;
+}
+
+/// @endcond
+
+#pragma mark -
+#pragma mark Animation
+
+/// @cond
+
++(BOOL)needsDisplayForKey:(nonnull NSString *)aKey
+{
+    static NSSet<NSString *> *keys   = nil;
+    static dispatch_once_t onceToken = 0;
+
+    dispatch_once(&onceToken, ^{
+        keys = [NSSet setWithArray:@[@"labelOffset",
+                                     @"labelRotation"]];
+    });
+
+    if ( [keys containsObject:aKey] ) {
+        return YES;
+    }
+    else {
+        return [super needsDisplayForKey:aKey];
+    }
+}
+
+/// @endcond
+
+#pragma mark -
+#pragma mark Layout
+
+/// @cond
+
+-(void)layoutSublayers
+{
+    [self relabel];
+    [super layoutSublayers];
+}
+
+/// @endcond
+
+#pragma mark -
+#pragma mark Data Source
+
+/// @cond
+
+-(NSUInteger)numberOfRecords
+{
+    id<CPTPlotDataSource> theDataSource = self.dataSource;
+
+    return [theDataSource numberOfRecordsForPlot:self];
+}
+
+/// @endcond
+
+/**
+ *  @brief Marks the receiver as needing the data source reloaded before the content is next drawn.
+ **/
+-(void)setDataNeedsReloading
+{
+    self.dataNeedsReloading = YES;
+}
+
+/**
+ *  @brief Reload all plot data, labels, and plot-specific information from the data source immediately.
+ **/
+-(void)reloadData
+{
+    [self.cachedData removeAllObjects];
+    [self.fieldStatistics removeAllObjects];
+    [self.fixedPointCache removeAllObjects];
+    [self.streamingBuffers removeAllObjects];
+    [scratchArena purge];
+    self.cachedDataCount = 0;
+
+    // the categories of the plot space are reloaded with the data
+    self.renderPlotSpace = nil;
+
+    [self reloadDataInIndexRange:NSMakeRange(0, self.numberOfRecords)];
+}
+
+/**
+ *  @brief Reload plot data from the data source only if the data cache is out of date.
+ **/
+-(void)reloadDataIfNeeded
+{
+    if ( self.dataNeedsReloading ) {
+        [self reloadData];
+    }
+}
+
+/** @brief Reload plot data, labels, and plot-specific information in the given index range from the data source immediately.
+ *  @param indexRange The index range to load.
+ **/
+-(void)reloadDataInIndexRange:(NSRange)indexRange
+{
+    NSParameterAssert(NSMaxRange(indexRange) <= self.numberOfRecords);
+
+    self.dataNeedsReloading = NO;
+
+    [self reloadPlotDataInIndexRange:indexRange];
+
+    // Data labels
+    [self reloadDataLabelsInIndexRange:indexRange];
+}
+
+/** @brief Insert records into the plot data cache at the given index.
+ *  @param idx             The starting index of the new records.
+ *  @param numberOfRecords The number of records to insert.
  **/
 -(void)insertDataAtIndex:(NSUInteger)idx numberOfRecords:(NSUInteger)numberOfRecords
 {
     NSParameterAssert(idx <= self.cachedDataCount);
     Class numericClass = [CPTNumericData class];
 
-    for ( id data in self.cachedData.allValues ) {
+    [self insertStatisticsPlaceholdersAtIndex:idx numberOfRecords:numberOfRecords];
+    [self detachCachedDataForKey:nil];
+
+    NSMutableDictionary *dataCache = self.cachedData;
+    BOOL streamingAppend           = (self.streamingCapacity > 0) && (idx == self.cachedDataCount);
+
+    for ( id key in dataCache.allKeys ) {
+        id data = dataCache[key];
         if ( [data isKindOfClass:numericClass] ) {
             CPTMutableNumericData *numericData = (CPTMutableNumericData *)data;
-            size_t sampleSize                  = numericData.sampleBytes;
-            size_t length                      = sampleSize * numberOfRecords;
 
-            [(NSMutableData *) numericData.data increaseLengthBy:length];
+            if ( streamingAppend ) {
+                [self appendRecords:numberOfRecords toStreamingNumbers:numericData forKey:key];
+            }
+            else {
+                size_t sampleSize = numericData.sampleBytes;
+                size_t length     = sampleSize * numberOfRecords;
 
-            int8_t *start      = [numericData mutableSamplePointer:idx];
-            size_t bytesToMove = numericData.data.length - (idx + numberOfRecords) * sampleSize;
-            if ( (int)bytesToMove > 0 ) {
-                memmove(start + length, start, bytesToMove);
+                [(NSMutableData *) numericData.data increaseLengthBy:length];
+
+                int8_t *start      = [numericData mutableSamplePointer:idx];
+                size_t bytesToMove = numericData.data.length - (idx + numberOfRecords) * sampleSize;
+                if ( (int)bytesToMove > 0 ) {
+                    memmove(start + length, start, bytesToMove);
+                }
             }
         }
         else {
@@ -663,6 +1578,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     NSParameterAssert(idx <= self.cachedDataCount);
     Class numericClass = [CPTNumericData class];
 
+    [self.fieldStatistics removeAllObjects];
+
+    [self.fixedPointCache removeAllObjects];
+
+    [self detachCachedDataForKey:nil];
+
     for ( id data in self.cachedData.allValues ) {
         if ( [data isKindOfClass:numericClass] ) {
             CPTMutableNumericData *numericData = (CPTMutableNumericData *)data;
@@ -706,19 +1627,32 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     NSParameterAssert(NSMaxRange(indexRange) <= self.cachedDataCount);
     Class numericClass = [CPTNumericData class];
 
-    for ( id data in self.cachedData.allValues ) {
+    [self deleteStatisticsInIndexRange:indexRange];
+    [self detachCachedDataForKey:nil];
+
+    NSMutableDictionary *dataCache = self.cachedData;
+    BOOL streamingEvict            = (self.streamingCapacity > 0) && (indexRange.location == 0);
+
+    for ( id key in dataCache.allKeys ) {
+        id data = dataCache[key];
         if ( [data isKindOfClass:numericClass] ) {
             CPTMutableNumericData *numericData = (CPTMutableNumericData *)data;
-            size_t sampleSize                  = numericData.sampleBytes;
-            int8_t *start                      = [numericData mutableSamplePointer:indexRange.location];
-            size_t length                      = sampleSize * indexRange.length;
-            size_t bytesToMove                 = numericData.data.length - (indexRange.location + indexRange.length) * sampleSize;
-            if ( (int)bytesToMove > 0 ) {
-                memmove(start, start + length, bytesToMove);
+
+            if ( streamingEvict ) {
+                [self evictRecords:indexRange.length fromStreamingNumbers:numericData forKey:key];
             }
+            else {
+                size_t sampleSize  = numericData.sampleBytes;
+                int8_t *start      = [numericData mutableSamplePointer:indexRange.location];
+                size_t length      = sampleSize * indexRange.length;
+                size_t bytesToMove = numericData.data.length - (indexRange.location + indexRange.length) * sampleSize;
+                if ( (int)bytesToMove > 0 ) {
+                    memmove(start, start + length, bytesToMove);
+                }
 
-            NSMutableData *dataBuffer = (NSMutableData *)numericData.data;
-            dataBuffer.length -= length;
+                NSMutableData *dataBuffer = (NSMutableData *)numericData.data;
+                dataBuffer.length -= length;
+            }
         }
         else {
             [(NSMutableArray *) data removeObjectsInRange:indexRange];
@@ -802,6 +1736,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     
     Class numericClass = [CPTNumericData class];
 
+    [self.fieldStatistics removeAllObjects];
+
+    [self.fixedPointCache removeAllObjects];
+
+    [self detachCachedDataForKey:nil];
+
     for ( id key in self.cachedData.allKeys ) {
         id data = [self.cachedData objectForKey: key];
         if ( [data isKindOfClass:numericClass] ) {
@@ -994,6 +1934,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     
     Class numericClass = [CPTNumericData class];
 
+    [self.fieldStatistics removeAllObjects];
+
+    [self.fixedPointCache removeAllObjects];
+
+    [self detachCachedDataForKey:nil];
+
     for ( id key in self.cachedData.allKeys ) {
         id data = [self.cachedData objectForKey: key];
         if ( [data isKindOfClass:numericClass] ) {
@@ -1147,6 +2093,8 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
     for ( NSNumber *fieldID in self.fieldIdentifiers ) {
         [dataCache removeObjectForKey:fieldID];
+        [self.fieldStatistics removeObjectForKey:fieldID];
+        [self.fixedPointCache removeObjectForKey:fieldID];
     }
 
     [self reloadPlotDataInIndexRange:NSMakeRange(0, self.cachedDataCount)];
@@ -1296,13 +2244,146 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     return numbers;
 }
 
-/** @brief Gets a range of plot data for the given plot.
- *  @param  indexRange The range of the data indexes of interest.
- *  @return            Returns @YES if the datasource implements the
- *  @link CPTPlotDataSource::dataForPlot:recordIndexRange: -dataForPlot:recordIndexRange: @endlink
- *  method and it returns valid data.
- **/
--(BOOL)loadNumbersForAllFieldsFromDataSourceInRecordIndexRange:(NSRange)indexRange
+/// @cond
+
+static inline NSDecimal CPTPlotDecimalValue(NSDecimal value)
+{
+    return value;
+}
+
+/** @internal
+ *  @brief Returns whether CPTPlotGatherSamples() can read samples of the given type.
+ *  @param sourceType The data type of the samples.
+ *  @return @YES for real integer, floating point, and decimal numbers in the host byte order.
+ **/
+static BOOL CPTPlotCanGatherSamples(CPTNumericDataType sourceType)
+{
+    if ((sourceType.byteOrder != CFByteOrderGetCurrent()) && (sourceType.sampleBytes > 1)) {
+        return NO;
+    }
+
+    switch ( sourceType.dataTypeFormat ) {
+        case CPTIntegerDataType:
+        case CPTUnsignedIntegerDataType:
+        case CPTDecimalDataType:
+            return YES;
+
+        case CPTFloatingPointDataType:
+            return (sourceType.sampleBytes == sizeof(float)) || (sourceType.sampleBytes == sizeof(double));
+
+        case CPTUndefinedDataType:
+        case CPTComplexFloatingPointDataType:
+            return NO;
+    }
+
+    return NO;
+}
+
+/** @internal
+ *  @brief Copies samples spaced evenly through a buffer to a contiguous array, converting them to @double or NSDecimal.
+ *  @param source     The first sample to copy.
+ *  @param sourceType The data type of the source samples, one accepted by CPTPlotCanGatherSamples().
+ *  @param stride     The distance between consecutive source samples in samples.
+ *  @param count      The number of samples to copy.
+ *  @param dest       The destination array.
+ *  @param destType   The data type of the destination, either @double or NSDecimal.
+ **/
+static void CPTPlotGatherSamples(const void *source, CPTNumericDataType sourceType, NSUInteger stride, NSUInteger count, void *dest, CPTNumericDataType destType)
+{
+    BOOL toDecimal = (destType.dataTypeFormat == CPTDecimalDataType);
+
+    // each loop reads one source type; with a stride of one the conversion to double vectorizes
+#define CPTPlotGather(sourceCType, doubleValue, decimalValue) \
+    {                                                             \
+        const sourceCType *fromSamples = (const sourceCType *)source; \
+        if ( toDecimal ) {                                        \
+            NSDecimal *toSamples = (NSDecimal *)dest;             \
+            for ( NSUInteger i = 0; i < count; i++ ) {            \
+                toSamples[i] = decimalValue(fromSamples[i * stride]); \
+            }                                                     \
+        }                                                         \
+        else {                                                    \
+            double *toSamples = (double *)dest;                   \
+            for ( NSUInteger i = 0; i < count; i++ ) {            \
+                toSamples[i] = doubleValue(fromSamples[i * stride]); \
+            }                                                     \
+        }                                                         \
+    }
+
+    switch ( sourceType.dataTypeFormat ) {
+        case CPTIntegerDataType:
+            switch ( sourceType.sampleBytes ) {
+                case sizeof(int8_t):
+                    CPTPlotGather(int8_t, (double), CPTDecimalFromChar);
+                    break;
+
+                case sizeof(int16_t):
+                    CPTPlotGather(int16_t, (double), CPTDecimalFromShort);
+                    break;
+
+                case sizeof(int32_t):
+                    CPTPlotGather(int32_t, (double), CPTDecimalFromLong);
+                    break;
+
+                case sizeof(int64_t):
+                    CPTPlotGather(int64_t, (double), CPTDecimalFromLongLong);
+                    break;
+            }
+            break;
+
+        case CPTUnsignedIntegerDataType:
+            switch ( sourceType.sampleBytes ) {
+                case sizeof(uint8_t):
+                    CPTPlotGather(uint8_t, (double), CPTDecimalFromUnsignedChar);
+                    break;
+
+                case sizeof(uint16_t):
+                    CPTPlotGather(uint16_t, (double), CPTDecimalFromUnsignedShort);
+                    break;
+
+                case sizeof(uint32_t):
+                    CPTPlotGather(uint32_t, (double), CPTDecimalFromUnsignedLong);
+                    break;
+
+                case sizeof(uint64_t):
+                    CPTPlotGather(uint64_t, (double), CPTDecimalFromUnsignedLongLong);
+                    break;
+            }
+            break;
+
+        case CPTFloatingPointDataType:
+            switch ( sourceType.sampleBytes ) {
+                case sizeof(float):
+                    CPTPlotGather(float, (double), CPTDecimalFromFloat);
+                    break;
+
+                case sizeof(double):
+                    CPTPlotGather(double, (double), CPTDecimalFromDouble);
+                    break;
+            }
+            break;
+
+        case CPTDecimalDataType:
+            CPTPlotGather(NSDecimal, CPTDecimalDoubleValue, CPTPlotDecimalValue);
+            break;
+
+        case CPTUndefinedDataType:
+        case CPTComplexFloatingPointDataType:
+            break;
+    }
+
+#undef CPTPlotGather
+}
+
+/// @endcond
+
+/** @brief Gets a range of plot data for the given plot.
+ *  @param  indexRange The range of the data indexes of interest.
+ *  @return            Returns @YES if the datasource implements the
+ *  @link CPTPlotDataSource::dataForPlot:recordIndexRange: -dataForPlot:recordIndexRange: @endlink
+ *  method and it returns valid data.
+ **/
+-(BOOL)loadNumbersForAllFieldsFromDataSourceInRecordIndexRange:(NSRange)indexRange
 {
     BOOL hasData = NO;
 
@@ -1321,97 +2402,103 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
                 const NSUInteger fieldCount = theShape[1].unsignedIntegerValue;
 
                 if ( fieldCount > 0 ) {
-                    // convert data type if needed
+                    CPTNumericDataType cacheType = self.doubleDataType;
+
                     switch ( self.cachePrecision ) {
                         case CPTPlotCachePrecisionAuto:
-                            if ( self.doublePrecisionCache ) {
-                                if ( !CPTDataTypeEqualToDataType(dataType, self.doubleDataType)) {
-                                    CPTMutableNumericData *mutableData = [data mutableCopy];
-                                    mutableData.dataType = self.doubleDataType;
-                                    data                 = mutableData;
-                                }
-                            }
-                            else {
-                                if ( !CPTDataTypeEqualToDataType(dataType, self.decimalDataType)) {
-                                    CPTMutableNumericData *mutableData = [data mutableCopy];
-                                    mutableData.dataType = self.decimalDataType;
-                                    data                 = mutableData;
-                                }
-                            }
+                            cacheType = self.doublePrecisionCache ? self.doubleDataType : self.decimalDataType;
                             break;
 
                         case CPTPlotCachePrecisionDecimal:
-                            if ( !CPTDataTypeEqualToDataType(dataType, self.decimalDataType)) {
-                                CPTMutableNumericData *mutableData = [data mutableCopy];
-                                mutableData.dataType = self.decimalDataType;
-                                data                 = mutableData;
-                            }
+                            cacheType = self.decimalDataType;
                             break;
 
                         case CPTPlotCachePrecisionDouble:
-                            if ( !CPTDataTypeEqualToDataType(dataType, self.doubleDataType)) {
-                                CPTMutableNumericData *mutableData = [data mutableCopy];
-                                mutableData.dataType = self.doubleDataType;
-                                data                 = mutableData;
-                            }
+                            cacheType = self.doubleDataType;
                             break;
                     }
 
-                    // add the data to the cache
-                    const NSUInteger bufferLength = rowCount * dataType.sampleBytes;
+                    // types the fused pass cannot read, such as swapped byte orders, are converted as a whole first
+                    if ( !CPTPlotCanGatherSamples(dataType)) {
+                        CPTMutableNumericData *mutableData = [data mutableCopy];
+                        mutableData.dataType = cacheType;
+                        data                 = mutableData;
+                        dataType             = cacheType;
+                    }
 
-                    switch ( data.dataOrder ) {
-                        case CPTDataOrderRowsFirst:
-                        {
-                            const void *sourceEnd = (const int8_t *)(data.bytes) + data.length;
+                    const BOOL rowsFirst          = (data.dataOrder == CPTDataOrderRowsFirst);
+                    const int8_t *sourceBytes     = (const int8_t *)data.bytes;
+                    const size_t sourceSampleSize = dataType.sampleBytes;
+                    const size_t cacheSampleSize  = cacheType.sampleBytes;
+                    const NSUInteger columnLength = rowCount * cacheSampleSize;
+
+                    // column-major data already in the cache type can become the cache if the data source hands it over
+                    BOOL adoptsData = !rowsFirst && CPTDataTypeEqualToDataType(dataType, cacheType) &&
+                                      [theDataSource respondsToSelector:@selector(plotMayAdoptData:)] && [theDataSource plotMayAdoptData:self];
+
+                    NSData *sourceData                        = data.data;
+                    NSMutableArray<NSMutableData *> *columns = [[NSMutableArray alloc] initWithCapacity:fieldCount];
+
+                    for ( NSUInteger fieldNum = 0; fieldNum < fieldCount; fieldNum++ ) {
+                        NSMutableData *column = nil;
+
+                        if ( adoptsData ) {
+                            // the column keeps the source buffer alive
+                            column = [[NSMutableData alloc] initWithBytesNoCopy:(void *)(sourceBytes + fieldNum * rowCount * sourceSampleSize)
+                                                                         length:columnLength
+                                                                    deallocator:^(void *__unused bytes, NSUInteger __unused length) {
+                                (void)sourceData;
+                            }];
+                        }
+                        else {
+                            column = [[NSMutableData alloc] initWithLength:columnLength];
+                        }
+                        [columns addObject:column];
+                    }
+
+                    if ( !adoptsData ) {
+                        // convert and transpose in one pass, a block of rows at a time so each source row is read once
+                        const NSUInteger blockRows = rowsFirst ? CPTPlotTransposeBlockRows : rowCount;
+                        const NSUInteger stride    = rowsFirst ? fieldCount : 1;
+
+                        for ( NSUInteger firstRow = 0; firstRow < rowCount; firstRow += blockRows ) {
+                            NSUInteger blockCount = MIN(blockRows, rowCount - firstRow);
 
                             for ( NSUInteger fieldNum = 0; fieldNum < fieldCount; fieldNum++ ) {
-                                NSMutableData *tempData = [[NSMutableData alloc] initWithLength:bufferLength];
-
-                                if ( CPTDataTypeEqualToDataType(dataType, self.doubleDataType)) {
-                                    const double *sourceData = [data samplePointerAtIndex:0, fieldNum];
-                                    double *destData         = tempData.mutableBytes;
-
-                                    while ( sourceData < (const double *)sourceEnd ) {
-                                        *destData++ = *sourceData;
-                                        sourceData += fieldCount;
-                                    }
-                                }
-                                else {
-                                    const NSDecimal *sourceData = [data samplePointerAtIndex:0, fieldNum];
-                                    NSDecimal *destData         = tempData.mutableBytes;
-
-                                    while ( sourceData < (const NSDecimal *)sourceEnd ) {
-                                        *destData++ = *sourceData;
-                                        sourceData += fieldCount;
-                                    }
-                                }
-
-                                CPTMutableNumericData *tempNumericData = [[CPTMutableNumericData alloc] initWithData:tempData
-                                                                                                            dataType:dataType
-                                                                                                               shape:nil];
-
-                                [self cacheNumbers:tempNumericData forField:fieldNum atRecordIndex:indexRange.location];
+                                NSUInteger sourceIndex = rowsFirst ? firstRow * fieldCount + fieldNum : fieldNum * rowCount + firstRow;
+
+                                CPTPlotGatherSamples(sourceBytes + sourceIndex * sourceSampleSize,
+                                                     dataType,
+                                                     stride,
+                                                     blockCount,
+                                                     (int8_t *)columns[fieldNum].mutableBytes + firstRow * cacheSampleSize,
+                                                     cacheType);
                             }
-                            hasData = YES;
-                            break;
                         }
+                    }
 
-                        case CPTDataOrderColumnsFirst:
-                            for ( NSUInteger fieldNum = 0; fieldNum < fieldCount; fieldNum++ ) {
-                                const void *samples = [data samplePointerAtIndex:0, fieldNum];
-                                NSData *tempData    = [[NSData alloc] initWithBytes:samples
-                                                                             length:bufferLength];
+                    // add the data to the cache
+                    NSHashTable<CPTMutableNumericData *> *adoptedData = self.adoptedCachedData;
 
-                                CPTMutableNumericData *tempNumericData = [[CPTMutableNumericData alloc] initWithData:tempData
-                                                                                                            dataType:dataType
-                                                                                                               shape:nil];
+                    if ( adoptsData && !adoptedData ) {
+                        adoptedData            = [NSHashTable weakObjectsHashTable];
+                        self.adoptedCachedData = adoptedData;
+                    }
 
-                                [self cacheNumbers:tempNumericData forField:fieldNum atRecordIndex:indexRange.location];
-                            }
-                            hasData = YES;
-                            break;
+                    for ( NSUInteger fieldNum = 0; fieldNum < fieldCount; fieldNum++ ) {
+                        CPTMutableNumericData *fieldNumbers = [[CPTMutableNumericData alloc] initWithData:[NSData data]
+                                                                                                 dataType:cacheType
+                                                                                                    shape:nil];
+                        [fieldNumbers adoptData:columns[fieldNum]];
+
+                        [self cacheNumbers:fieldNumbers forField:fieldNum atRecordIndex:indexRange.location copyingNumbers:NO];
+
+                        // the adopted column is copied before the plot first changes it
+                        if ( adoptsData && (self.cachedData[@(fieldNum)] == fieldNumbers)) {
+                            [adoptedData addObject:fieldNumbers];
+                        }
                     }
+                    hasData = YES;
                 }
             }
         }
@@ -1440,6 +2527,10 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     CPTCoordinate coordinate   = [self coordinateForFieldIdentifier:fieldEnum];
     CPTPlotSpace *thePlotSpace = self.plotSpace;
 
+    // The whole field is replaced; the statistics are rebuilt on the next range query
+    [self.fieldStatistics removeObjectForKey:cacheKey];
+    [self.fixedPointCache removeObjectForKey:cacheKey];
+
     if ( numbers ) {
         switch ( [thePlotSpace scaleTypeForCoordinate:coordinate] ) {
             case CPTScaleTypeLinear:
@@ -1480,6 +2571,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
                 CPTStringArray *samples = (CPTStringArray *)numbers;
                 if ( [samples isKindOfClass:[NSArray class]] ) {
                     [thePlotSpace setCategories:samples forCoordinate:coordinate];
+                    self.renderPlotSpace = nil;
 
                     NSUInteger sampleCount = samples.count;
                     if ( sampleCount > 0 ) {
@@ -1527,6 +2619,20 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
  *  @param idx       The index of the first data point to replace.
  **/
 -(void)cacheNumbers:(nullable id)numbers forField:(NSUInteger)fieldEnum atRecordIndex:(NSUInteger)idx
+{
+    [self cacheNumbers:numbers forField:fieldEnum atRecordIndex:idx copyingNumbers:YES];
+}
+
+/// @cond
+
+/** @internal
+ *  @brief Copies an array of numbers to replace a part of the cache.
+ *  @param numbers     An array of numbers to cache. Can be a CPTNumericData, NSArray, or NSData (NSData is assumed to be a c-style array of type @double).
+ *  @param fieldEnum   The field enumerator identifying the field.
+ *  @param idx         The index of the first data point to replace.
+ *  @param copyNumbers If @NO and @par{numbers} is a CPTMutableNumericData instance, the plot takes ownership of it instead of making a copy.
+ **/
+-(void)cacheNumbers:(nullable id)numbers forField:(NSUInteger)fieldEnum atRecordIndex:(NSUInteger)idx copyingNumbers:(BOOL)copyNumbers
 {
     if ( numbers ) {
         NSNumber *cacheKey     = @(fieldEnum);
@@ -1543,7 +2649,12 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
             case CPTScaleTypeLogModulus:
             {
                 id theNumbers = numbers;
-                mutableNumbers = [self numericDataForNumbers:theNumbers];
+                if ( copyNumbers || ![theNumbers isKindOfClass:[CPTMutableNumericData class]] ) {
+                    mutableNumbers = [self numericDataForNumbers:theNumbers];
+                }
+                else {
+                    mutableNumbers = theNumbers;
+                }
 
                 sampleCount = mutableNumbers.numberOfSamples;
                 if ( sampleCount > 0 ) {
@@ -1585,6 +2696,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
                             [thePlotSpace addCategory:category forCoordinate:coordinate];
                             [indices addObject:@([thePlotSpace indexOfCategory:category forCoordinate:coordinate])];
                         }
+                        self.renderPlotSpace = nil;
 
                         CPTNumericDataType dataType = (self.cachePrecision == CPTPlotCachePrecisionDecimal ? self.decimalDataType : self.doubleDataType);
 
@@ -1602,25 +2714,46 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         }
 
         if ( mutableNumbers && (sampleCount > 0)) {
-            // Ensure the data cache exists and is the right size
-            CPTMutableNumericData *cachedNumbers = (self.cachedData)[cacheKey];
-            if ( !cachedNumbers ) {
-                cachedNumbers = [CPTMutableNumericData numericDataWithData:[NSData data]
-                                                                  dataType:mutableNumbers.dataType
-                                                                     shape:nil];
-                (self.cachedData)[cacheKey] = cachedNumbers;
-            }
             id<CPTPlotDataSource> theDataSource = self.dataSource;
             NSUInteger numberOfRecords          = [theDataSource numberOfRecordsForPlot:self];
-            cachedNumbers.shape = @[@(numberOfRecords)];
 
-            // Update the cache
-            self.cachedDataCount = numberOfRecords;
+            [self detachCachedDataForKey:cacheKey];
+
+            CPTMutableNumericData *cachedNumbers = (self.cachedData)[cacheKey];
+
+            if ( !cachedNumbers && (idx == 0) && (sampleCount == numberOfRecords)) {
+                // The new numbers are already a private copy and cover every record, so they become the cache
+                [self.fieldStatistics removeObjectForKey:cacheKey];
+                [self.fixedPointCache removeObjectForKey:cacheKey];
+                (self.cachedData)[cacheKey] = mutableNumbers;
+                self.cachedDataCount        = numberOfRecords;
+            }
+            else {
+                // Ensure the data cache exists and is the right size
+                if ( !cachedNumbers ) {
+                    cachedNumbers = [CPTMutableNumericData numericDataWithData:[NSData data]
+                                                                      dataType:mutableNumbers.dataType
+                                                                         shape:nil];
+                    (self.cachedData)[cacheKey] = cachedNumbers;
+                }
+                NSUInteger previousCount = cachedNumbers.numberOfSamples;
+                cachedNumbers.shape = @[@(numberOfRecords)];
+
+                // Update the cache
+                self.cachedDataCount = numberOfRecords;
+
+                NSUInteger startByte = idx * cachedNumbers.sampleBytes;
+                void *cachePtr       = (int8_t *)(cachedNumbers.mutableBytes) + startByte;
+                size_t numberOfBytes = MIN(mutableNumbers.data.length, cachedNumbers.data.length - startByte);
 
-            NSUInteger startByte = idx * cachedNumbers.sampleBytes;
-            void *cachePtr       = (int8_t *)(cachedNumbers.mutableBytes) + startByte;
-            size_t numberOfBytes = MIN(mutableNumbers.data.length, cachedNumbers.data.length - startByte);
-            memcpy(cachePtr, mutableNumbers.bytes, numberOfBytes);
+                [self updateStatisticsForKey:cacheKey
+                               cachedNumbers:cachedNumbers
+                               previousCount:previousCount
+                              replacingRange:NSMakeRange(idx, numberOfBytes / cachedNumbers.sampleBytes)
+                                 withSamples:mutableNumbers.bytes];
+
+                memcpy(cachePtr, mutableNumbers.bytes, numberOfBytes);
+            }
 
             [self relabelIndexRange:NSMakeRange(idx, sampleCount)];
         }
@@ -1629,8 +2762,6 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
-/// @cond
-
 -(nonnull CPTMutableNumericData *)numericDataForNumbers:(nonnull id)numbers
 {
     CPTMutableNumericData *mutableNumbers = nil;
@@ -1800,6 +2931,8 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 {
     Class numberClass = [NSNumber class];
 
+    [self detachCachedDataForKey:nil];
+
     NSMutableDictionary<NSString *, CPTMutableNumericData *> *dataDictionary = self.cachedData;
 
     for ( id key in dataDictionary.allKeys ) {
@@ -1858,64 +2991,498 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
         return nil;
 }
 
-/** @brief Copies an array of arbitrary values to the cache.
- *  @param array An array of arbitrary values to cache.
- *  @param key   The key identifying the field.
+/** @brief Copies an array of arbitrary values to the cache.
+ *  @param array An array of arbitrary values to cache.
+ *  @param key   The key identifying the field.
+ **/
+-(void)cacheArray:(nullable NSArray *)array forKey:(nonnull NSString *)key
+{
+    if ( array ) {
+        NSUInteger sampleCount = array.count;
+        if ( sampleCount > 0 ) {
+            (self.cachedData)[key] = array;
+        }
+        else {
+            [self.cachedData removeObjectForKey:key];
+        }
+
+        self.cachedDataCount = sampleCount;
+    }
+    else {
+        [self.cachedData removeObjectForKey:key];
+        self.cachedDataCount = 0;
+    }
+}
+
+/** @brief Copies an array of arbitrary values to replace a part of the cache.
+ *  @param array An array of arbitrary values to cache.
+ *  @param key   The key identifying the field.
+ *  @param idx   The index of the first data point to replace.
+ **/
+-(void)cacheArray:(nullable NSArray *)array forKey:(nonnull NSString *)key atRecordIndex:(NSUInteger)idx
+{
+    NSUInteger sampleCount = array.count;
+
+    if ( sampleCount > 0 ) {
+        // Ensure the data cache exists and is the right size
+        id<CPTPlotDataSource> theDataSource = self.dataSource;
+        NSUInteger numberOfRecords          = [theDataSource numberOfRecordsForPlot:self];
+
+        [self detachCachedDataForKey:key];
+
+        NSMutableArray *cachedValues = (self.cachedData)[key];
+        if ( !cachedValues ) {
+            cachedValues = [NSMutableArray arrayWithCapacity:numberOfRecords];
+            NSNull *nullObject = [NSNull null];
+            for ( NSUInteger i = 0; i < numberOfRecords; i++ ) {
+                [cachedValues addObject:nullObject];
+            }
+            (self.cachedData)[key] = cachedValues;
+        }
+
+        // Update the cache
+        self.cachedDataCount = numberOfRecords;
+
+        NSArray *dataArray = array;
+        [cachedValues replaceObjectsInRange:NSMakeRange(idx, sampleCount) withObjectsFromArray:dataArray];
+    }
+}
+
+#pragma mark -
+#pragma mark Streaming
+
+/// @cond
+
+static void CPTPlotSetStreamingWindow(CPTMutableNumericData *numbers, NSMutableData *buffer, NSUInteger head, NSUInteger count)
+{
+    size_t sampleBytes = numbers.sampleBytes;
+
+    // The window keeps the shared buffer alive; the buffer is never resized while it is referenced
+    NSMutableData *window = [[NSMutableData alloc] initWithBytesNoCopy:(int8_t *)buffer.mutableBytes + head * sampleBytes
+                                                                length:count * sampleBytes
+                                                           deallocator:^(void * __unused bytes, NSUInteger __unused length) {
+        (void)buffer;
+    }];
+
+    [numbers adoptData:window];
+}
+
+/** @internal
+ *  @brief Returns the streaming buffer that holds the cached samples of a numeric field.
+ *
+ *  If the cached samples are not already a window into a large enough streaming buffer, a new buffer is
+ *  allocated, the samples are copied to its start, and the cached numbers are pointed at them.
+ *
+ *  @param  cacheKey     The cache key of the field.
+ *  @param  numbers      The cached numbers for the field.
+ *  @param  minimumCount The minimum number of samples the buffer must hold.
+ *  @return              The streaming buffer.
+ **/
+-(nonnull NSMutableData *)streamingBufferForKey:(nonnull NSNumber *)cacheKey numbers:(nonnull CPTMutableNumericData *)numbers minimumCount:(NSUInteger)minimumCount
+{
+    NSMutableData *buffer = self.streamingBuffers[cacheKey];
+    size_t sampleBytes    = numbers.sampleBytes;
+    NSUInteger count      = numbers.numberOfSamples;
+
+    if ( buffer && (buffer.length >= minimumCount * sampleBytes)) {
+        const int8_t *bufferStart = (const int8_t *)buffer.bytes;
+        const int8_t *samples     = (const int8_t *)numbers.bytes;
+
+        if ((samples >= bufferStart) && (samples + numbers.length <= bufferStart + buffer.length) &&
+            ((size_t)(samples - bufferStart) % sampleBytes == 0)) {
+            return buffer;
+        }
+    }
+
+    NSUInteger bufferCount = 2 * MAX(self.streamingCapacity, minimumCount);
+
+    buffer = [[NSMutableData alloc] initWithLength:bufferCount * sampleBytes];
+    memcpy(buffer.mutableBytes, numbers.bytes, count * sampleBytes);
+
+    self.streamingBuffers[cacheKey] = buffer;
+    CPTPlotSetStreamingWindow(numbers, buffer, 0, count);
+
+    return buffer;
+}
+
+/** @internal
+ *  @brief Appends zero-filled records to a numeric field stored in a streaming buffer.
+ *  @param numberOfRecords The number of records to append.
+ *  @param numbers         The cached numbers for the field.
+ *  @param cacheKey        The cache key of the field.
+ **/
+-(void)appendRecords:(NSUInteger)numberOfRecords toStreamingNumbers:(nonnull CPTMutableNumericData *)numbers forKey:(nonnull NSNumber *)cacheKey
+{
+    NSUInteger count    = numbers.numberOfSamples;
+    NSUInteger newCount = count + numberOfRecords;
+
+    NSMutableData *buffer = [self streamingBufferForKey:cacheKey numbers:numbers minimumCount:newCount];
+    size_t sampleBytes    = numbers.sampleBytes;
+    int8_t *bufferStart   = (int8_t *)buffer.mutableBytes;
+    NSUInteger head       = (NSUInteger)((const int8_t *)numbers.bytes - bufferStart) / sampleBytes;
+
+    if ((head + newCount) * sampleBytes > buffer.length ) {
+        // The window reached the end of the buffer; move it back to the start
+        memmove(bufferStart, bufferStart + head * sampleBytes, count * sampleBytes);
+        head = 0;
+    }
+
+    memset(bufferStart + (head + count) * sampleBytes, 0, numberOfRecords * sampleBytes);
+
+    CPTPlotSetStreamingWindow(numbers, buffer, head, newCount);
+}
+
+/** @internal
+ *  @brief Removes records from the start of a numeric field stored in a streaming buffer.
+ *  @param numberOfRecords The number of records to remove.
+ *  @param numbers         The cached numbers for the field.
+ *  @param cacheKey        The cache key of the field.
+ **/
+-(void)evictRecords:(NSUInteger)numberOfRecords fromStreamingNumbers:(nonnull CPTMutableNumericData *)numbers forKey:(nonnull NSNumber *)cacheKey
+{
+    NSUInteger count = numbers.numberOfSamples;
+
+    NSMutableData *buffer = [self streamingBufferForKey:cacheKey numbers:numbers minimumCount:count];
+    size_t sampleBytes    = numbers.sampleBytes;
+    NSUInteger head       = (NSUInteger)((const int8_t *)numbers.bytes - (const int8_t *)buffer.bytes) / sampleBytes;
+
+    CPTPlotSetStreamingWindow(numbers, buffer, head + numberOfRecords, count - numberOfRecords);
+}
+
+/// @endcond
+
+#pragma mark -
+#pragma mark Data Statistics
+
+/// @cond
+
+static void CPTPlotFieldStatisticsReset(CPTPlotFieldStatistics *stats, BOOL doublePrecision)
+{
+    stats->doublePrecision = doublePrecision;
+    stats->nanCount        = 0;
+    stats->pendingRange    = NSMakeRange(0, 0);
+    stats->minDouble       = (double)INFINITY;
+    stats->maxDouble       = -(double)INFINITY;
+    stats->minDecimal      = [NSDecimalNumber maximumDecimalNumber].decimalValue;
+    stats->maxDecimal      = [NSDecimalNumber minimumDecimalNumber].decimalValue;
+}
+
+static void CPTPlotFieldStatisticsAddSamples(CPTPlotFieldStatistics *stats, const void *samples, NSUInteger count)
+{
+    if ( stats->doublePrecision ) {
+        const double *doubles    = (const double *)samples;
+        const double *lastSample = doubles + count;
+
+        double min = stats->minDouble;
+        double max = stats->maxDouble;
+
+        while ( doubles < lastSample ) {
+            double value = *doubles++;
+
+            if ( isnan(value)) {
+                stats->nanCount++;
+            }
+            else {
+                if ( value < min ) {
+                    min = value;
+                }
+                if ( value > max ) {
+                    max = value;
+                }
+            }
+        }
+
+        stats->minDouble = min;
+        stats->maxDouble = max;
+    }
+    else {
+        const NSDecimal *decimals   = (const NSDecimal *)samples;
+        const NSDecimal *lastSample = decimals + count;
+
+        while ( decimals < lastSample ) {
+            NSDecimal value = *decimals++;
+
+            if ( NSDecimalIsNotANumber(&value)) {
+                stats->nanCount++;
+            }
+            else {
+                if ( CPTDecimalLessThan(value, stats->minDecimal)) {
+                    stats->minDecimal = value;
+                }
+                if ( CPTDecimalGreaterThan(value, stats->maxDecimal)) {
+                    stats->maxDecimal = value;
+                }
+            }
+        }
+    }
+}
+
+// Returns NO if one of the removed samples was an extremum; the statistics must then be rebuilt.
+static BOOL CPTPlotFieldStatisticsRemoveSamples(CPTPlotFieldStatistics *stats, const void *samples, NSUInteger count)
+{
+    if ( stats->doublePrecision ) {
+        const double *doubles    = (const double *)samples;
+        const double *lastSample = doubles + count;
+
+        while ( doubles < lastSample ) {
+            double value = *doubles++;
+
+            if ( isnan(value)) {
+                stats->nanCount--;
+            }
+            else if ((value == stats->minDouble) || (value == stats->maxDouble)) {
+                return NO;
+            }
+        }
+    }
+    else {
+        const NSDecimal *decimals   = (const NSDecimal *)samples;
+        const NSDecimal *lastSample = decimals + count;
+
+        while ( decimals < lastSample ) {
+            NSDecimal value = *decimals++;
+
+            if ( NSDecimalIsNotANumber(&value)) {
+                stats->nanCount--;
+            }
+            else if ( CPTDecimalEquals(value, stats->minDecimal) || CPTDecimalEquals(value, stats->maxDecimal)) {
+                return NO;
+            }
+        }
+    }
+
+    return YES;
+}
+
+/** @internal
+ *  @brief Returns the statistics for a numeric field, rebuilding them from the cache if needed.
+ *  @param  fieldEnum The field enumerator identifying the field.
+ *  @param  numbers   The cached numbers for the field.
+ *  @return           The field statistics or @NULL if the cache format is not supported.
+ **/
+-(nullable const CPTPlotFieldStatistics *)statisticsForField:(NSUInteger)fieldEnum numbers:(nonnull CPTNumericData *)numbers
+{
+    NSNumber *cacheKey = @(fieldEnum);
+
+    BOOL doublePrecision;
+
+    switch ( numbers.dataTypeFormat ) {
+        case CPTFloatingPointDataType:
+            doublePrecision = YES;
+            break;
+
+        case CPTDecimalDataType:
+            doublePrecision = NO;
+            break;
+
+        default:
+            return NULL;
+    }
+
+    NSMutableData *statsData = self.fieldStatistics[cacheKey];
+
+    if ( statsData ) {
+        const CPTPlotFieldStatistics *stats = (const CPTPlotFieldStatistics *)statsData.bytes;
+
+        if ((stats->doublePrecision == doublePrecision) && (stats->pendingRange.length == 0)) {
+            return stats;
+        }
+    }
+    else {
+        statsData                      = [[NSMutableData alloc] initWithLength:sizeof(CPTPlotFieldStatistics)];
+        self.fieldStatistics[cacheKey] = statsData;
+    }
+
+    CPTPlotFieldStatistics *stats = (CPTPlotFieldStatistics *)statsData.mutableBytes;
+
+    CPTPlotFieldStatisticsReset(stats, doublePrecision);
+
+    _CPTFixedPointNumbers *fixedPoint = doublePrecision ? nil : [self fixedPointNumbersForField:fieldEnum];
+
+    if ( [fixedPoint isValidForNumbers:numbers] ) {
+        // integer compares instead of one NSDecimal comparison per sample
+        stats->nanCount = [fixedPoint getMinimum:&stats->minDecimal
+                                         maximum:&stats->maxDecimal
+                                        decimals:(const NSDecimal *)numbers.bytes];
+    }
+    else {
+        CPTPlotFieldStatisticsAddSamples(stats, numbers.bytes, numbers.numberOfSamples);
+    }
+
+    return stats;
+}
+
+/** @internal
+ *  @brief Updates the statistics for a numeric field before new samples are copied into the cache.
+ *  @param cacheKey      The cache key of the field.
+ *  @param cachedNumbers The cached numbers, already resized to the current number of records.
+ *  @param previousCount The number of cached samples before the cache was resized.
+ *  @param indexRange    The range of records about to be replaced.
+ *  @param samples       The new samples, in the same data type as the cache.
  **/
--(void)cacheArray:(nullable NSArray *)array forKey:(nonnull NSString *)key
+-(void)updateStatisticsForKey:(nonnull NSNumber *)cacheKey cachedNumbers:(nonnull CPTNumericData *)cachedNumbers previousCount:(NSUInteger)previousCount replacingRange:(NSRange)indexRange withSamples:(nonnull const void *)samples
 {
-    if ( array ) {
-        NSUInteger sampleCount = array.count;
-        if ( sampleCount > 0 ) {
-            (self.cachedData)[key] = array;
+    // the samples are overwritten in place, which the fixed point copy cannot detect
+    [self.fixedPointCache removeObjectForKey:cacheKey];
+
+    NSMutableData *statsData = self.fieldStatistics[cacheKey];
+
+    if ( !statsData ) {
+        return;
+    }
+
+    CPTPlotFieldStatistics *stats = (CPTPlotFieldStatistics *)statsData.mutableBytes;
+
+    BOOL isValid               = (stats->doublePrecision == (cachedNumbers.dataTypeFormat == CPTFloatingPointDataType));
+    NSRange pending            = stats->pendingRange;
+    NSUInteger numberOfSamples = cachedNumbers.numberOfSamples;
+
+    // Records added by resizing the cache hold placeholder values until they are loaded
+    if ( isValid && (numberOfSamples != previousCount)) {
+        if ( numberOfSamples < previousCount ) {
+            isValid = NO;
+        }
+        else if ( pending.length == 0 ) {
+            pending = NSMakeRange(previousCount, numberOfSamples - previousCount);
+        }
+        else if ( NSMaxRange(pending) == previousCount ) {
+            pending.length += numberOfSamples - previousCount;
         }
         else {
-            [self.cachedData removeObjectForKey:key];
+            isValid = NO;
         }
+    }
 
-        self.cachedDataCount = sampleCount;
+    if ( isValid ) {
+        // Remove the samples about to be overwritten, skipping the unloaded placeholders
+        const int8_t *cacheBytes = (const int8_t *)cachedNumbers.bytes;
+        size_t sampleBytes       = cachedNumbers.sampleBytes;
+        NSUInteger firstIndex    = indexRange.location;
+        NSUInteger lastIndex     = NSMaxRange(indexRange);
+
+        NSUInteger pendingStart = MAX(pending.location, firstIndex);
+        NSUInteger pendingEnd   = MIN(NSMaxRange(pending), lastIndex);
+
+        if ((pending.length > 0) && (pendingStart < pendingEnd)) {
+            isValid = CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + firstIndex * sampleBytes, pendingStart - firstIndex) &&
+                      CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + pendingEnd * sampleBytes, lastIndex - pendingEnd);
+
+            if ( pendingStart == pending.location ) {
+                pending.length  -= pendingEnd - pending.location;
+                pending.location = pendingEnd;
+            }
+            else if ( pendingEnd == NSMaxRange(pending)) {
+                pending.length = pendingStart - pending.location;
+            }
+            else {
+                // a partial load split the placeholder range
+                isValid = NO;
+            }
+        }
+        else {
+            isValid = CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + firstIndex * sampleBytes, indexRange.length);
+        }
+    }
+
+    if ( isValid ) {
+        stats->pendingRange = (pending.length > 0 ? pending : NSMakeRange(0, 0));
+        CPTPlotFieldStatisticsAddSamples(stats, samples, indexRange.length);
     }
     else {
-        [self.cachedData removeObjectForKey:key];
-        self.cachedDataCount = 0;
+        [self.fieldStatistics removeObjectForKey:cacheKey];
     }
 }
 
-/** @brief Copies an array of arbitrary values to replace a part of the cache.
- *  @param array An array of arbitrary values to cache.
- *  @param key   The key identifying the field.
- *  @param idx   The index of the first data point to replace.
+/** @internal
+ *  @brief Marks newly inserted records as not yet loaded in the statistics of every numeric field.
+ *  @param idx             The starting index of the new records.
+ *  @param numberOfRecords The number of records inserted.
  **/
--(void)cacheArray:(nullable NSArray *)array forKey:(nonnull NSString *)key atRecordIndex:(NSUInteger)idx
+-(void)insertStatisticsPlaceholdersAtIndex:(NSUInteger)idx numberOfRecords:(NSUInteger)numberOfRecords
 {
-    NSUInteger sampleCount = array.count;
+    NSMutableDictionary<NSNumber *, NSMutableData *> *statsDictionary = self.fieldStatistics;
 
-    if ( sampleCount > 0 ) {
-        // Ensure the data cache exists and is the right size
-        id<CPTPlotDataSource> theDataSource = self.dataSource;
-        NSUInteger numberOfRecords          = [theDataSource numberOfRecordsForPlot:self];
-        NSMutableArray *cachedValues        = (self.cachedData)[key];
-        if ( !cachedValues ) {
-            cachedValues = [NSMutableArray arrayWithCapacity:numberOfRecords];
-            NSNull *nullObject = [NSNull null];
-            for ( NSUInteger i = 0; i < numberOfRecords; i++ ) {
-                [cachedValues addObject:nullObject];
-            }
-            (self.cachedData)[key] = cachedValues;
+    for ( NSNumber *cacheKey in statsDictionary.allKeys ) {
+        CPTPlotFieldStatistics *stats = (CPTPlotFieldStatistics *)statsDictionary[cacheKey].mutableBytes;
+        NSRange pending               = stats->pendingRange;
+
+        if ( pending.length == 0 ) {
+            stats->pendingRange = NSMakeRange(idx, numberOfRecords);
+        }
+        else if ((idx >= pending.location) && (idx <= NSMaxRange(pending))) {
+            stats->pendingRange.length += numberOfRecords;
+        }
+        else {
+            [statsDictionary removeObjectForKey:cacheKey];
+        }
+    }
+}
+
+/** @internal
+ *  @brief Removes the records in the given index range from the statistics of every numeric field.
+ *
+ *  The statistics of a field are discarded if one of the removed samples was an extremum.
+ *
+ *  @param indexRange The index range of the data records about to be removed.
+ **/
+-(void)deleteStatisticsInIndexRange:(NSRange)indexRange
+{
+    NSMutableDictionary<NSNumber *, NSMutableData *> *statsDictionary = self.fieldStatistics;
+    Class numericClass                                                 = [CPTNumericData class];
+
+    for ( NSNumber *cacheKey in statsDictionary.allKeys ) {
+        CPTPlotFieldStatistics *stats = (CPTPlotFieldStatistics *)statsDictionary[cacheKey].mutableBytes;
+        CPTNumericData *numericData   = self.cachedData[cacheKey];
+
+        if ( ![numericData isKindOfClass:numericClass] ) {
+            [statsDictionary removeObjectForKey:cacheKey];
+            continue;
         }
 
-        // Update the cache
-        self.cachedDataCount = numberOfRecords;
+        const int8_t *cacheBytes = (const int8_t *)numericData.bytes;
+        size_t sampleBytes       = numericData.sampleBytes;
+        NSRange pending          = stats->pendingRange;
+        BOOL isValid;
 
-        NSArray *dataArray = array;
-        [cachedValues replaceObjectsInRange:NSMakeRange(idx, sampleCount) withObjectsFromArray:dataArray];
+        if ((pending.length == 0) || (indexRange.location >= NSMaxRange(pending))) {
+            isValid = CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + indexRange.location * sampleBytes, indexRange.length);
+        }
+        else if ( NSMaxRange(indexRange) <= pending.location ) {
+            isValid = CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + indexRange.location * sampleBytes, indexRange.length);
+
+            pending.location -= indexRange.length;
+        }
+        else {
+            // The deleted records overlap the placeholders; only the loaded records count
+            NSUInteger overlapStart = MAX(pending.location, indexRange.location);
+            NSUInteger overlapEnd   = MIN(NSMaxRange(pending), NSMaxRange(indexRange));
+
+            isValid = CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + indexRange.location * sampleBytes, overlapStart - indexRange.location) &&
+                      CPTPlotFieldStatisticsRemoveSamples(stats, cacheBytes + overlapEnd * sampleBytes, NSMaxRange(indexRange) - overlapEnd);
+
+            pending.length  -= overlapEnd - overlapStart;
+            pending.location = MIN(pending.location, indexRange.location);
+        }
+
+        if ( isValid ) {
+            stats->pendingRange = (pending.length > 0 ? pending : NSMakeRange(0, 0));
+        }
+        else {
+            [statsDictionary removeObjectForKey:cacheKey];
+        }
     }
 }
 
+/// @endcond
+
 #pragma mark -
 #pragma mark Data Ranges
 
 /** @brief Determines the smallest plot range that fully encloses the data for a particular field.
+ *
+ *  The extrema are tracked as the cache is updated, so the cached data is only scanned
+ *  after an update removed an extreme value.
+ *
  *  @param  fieldEnum The field enumerator identifying the field.
  *  @return           The plot range enclosing the data.
  **/
@@ -1930,53 +3497,25 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     NSUInteger numberOfSamples = numbers.numberOfSamples;
 
     if ( numberOfSamples > 0 ) {
-        if ( self.doublePrecisionCache ) {
-            double min = (double)INFINITY;
-            double max = -(double)INFINITY;
+        const CPTPlotFieldStatistics *stats = [self statisticsForField:fieldEnum numbers:numbers];
 
-            const double *doubles    = (const double *)numbers.bytes;
-            const double *lastSample = doubles + numberOfSamples;
+        if ( stats && (stats->nanCount < numberOfSamples)) {
+            if ( stats->doublePrecision ) {
+                double min = stats->minDouble;
+                double max = stats->maxDouble;
 
-            while ( doubles < lastSample ) {
-                double value = *doubles++;
-
-                if ( !isnan(value)) {
-                    if ( value < min ) {
-                        min = value;
-                    }
-                    if ( value > max ) {
-                        max = value;
-                    }
+                if ( max >= min ) {
+                    range = [CPTPlotRange plotRangeWithLocation:@(min) length:@(max - min)];
                 }
             }
+            else {
+                NSDecimal min = stats->minDecimal;
+                NSDecimal max = stats->maxDecimal;
 
-            if ( max >= min ) {
-                range = [CPTPlotRange plotRangeWithLocation:@(min) length:@(max - min)];
-            }
-        }
-        else {
-            NSDecimal min = [NSDecimalNumber maximumDecimalNumber].decimalValue;
-            NSDecimal max = [NSDecimalNumber minimumDecimalNumber].decimalValue;
-
-            const NSDecimal *decimals   = (const NSDecimal *)numbers.bytes;
-            const NSDecimal *lastSample = decimals + numberOfSamples;
-
-            while ( decimals < lastSample ) {
-                NSDecimal value = *decimals++;
-
-                if ( !NSDecimalIsNotANumber(&value)) {
-                    if ( CPTDecimalLessThan(value, min)) {
-                        min = value;
-                    }
-                    if ( CPTDecimalGreaterThan(value, max)) {
-                        max = value;
-                    }
+                if ( CPTDecimalGreaterThanOrEqualTo(max, min)) {
+                    range = [CPTPlotRange plotRangeWithLocationDecimal:min lengthDecimal:CPTDecimalSubtract(max, min)];
                 }
             }
-
-            if ( CPTDecimalGreaterThanOrEqualTo(max, min)) {
-                range = [CPTPlotRange plotRangeWithLocationDecimal:min lengthDecimal:CPTDecimalSubtract(max, min)];
-            }
         }
     }
     return range;
@@ -2094,6 +3633,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
             }
         }
         self.labelAnnotations = nil;
+        [self.labelLayerPool removeAllObjects];
         return;
     }
 
@@ -2118,7 +3658,44 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     CPTMutableNumericData *labelFieldDataCache = [self cachedNumbersForField:self.labelField];
     CPTShadow *theShadow                       = self.labelShadow;
 
-    for ( NSUInteger i = indexRange.location; i < maxIndex; i++ ) {
+    // Virtualized labels visit every record so the labels follow the visible region, but only records
+    // coming into view or inside the label index range get a label layer.
+    BOOL virtualize       = self.virtualizesLabels;
+    BOOL *visibleRecords  = NULL;
+    NSUInteger firstIndex = indexRange.location;
+    NSUInteger lastIndex  = maxIndex;
+
+    if ( virtualize ) {
+        visibleRecords = (BOOL *)calloc(MAX(sampleCount, 1), sizeof(BOOL));
+        [self flagVisibleLabelRecords:visibleRecords count:sampleCount];
+        firstIndex = 0;
+        lastIndex  = sampleCount;
+    }
+
+    for ( NSUInteger i = firstIndex; i < lastIndex; i++ ) {
+        if ( virtualize ) {
+            BOOL isShown = (i < oldLabelCount) && [labelArray[i] isKindOfClass:annotationClass];
+
+            if ( !visibleRecords[i] ) {
+                if ( isShown ) {
+                    [self recycleLabelAnnotation:(CPTPlotSpaceAnnotation *)labelArray[i] forIndex:i];
+                    labelArray[i] = nullObject;
+                }
+                else if ( i >= oldLabelCount ) {
+                    [labelArray addObject:nullObject];
+                }
+                continue;
+            }
+            if ( isShown ) {
+                if ( !NSLocationInRange(i, indexRange)) {
+                    continue;
+                }
+                // the label content changed, hand its layer back to the pool before making the new one
+                [self recycleLabelAnnotation:(CPTPlotSpaceAnnotation *)labelArray[i] forIndex:i];
+                labelArray[i] = nullObject;
+            }
+        }
+
         NSNumber *dataValue = [labelFieldDataCache sampleValue:i];
 
         CPTLayer *newLabelLayer;
@@ -2131,11 +3708,21 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
             if (((newLabelLayer == nil) || (newLabelLayer == nilObject)) && plotProvidesLabels ) {
                 if ( hasAttributedFormatter ) {
                     NSAttributedString *labelString = [dataLabelFormatter attributedStringForObjectValue:dataValue withDefaultAttributes:textAttributes];
-                    newLabelLayer = [[CPTTextLayer alloc] initWithAttributedText:labelString];
+                    if ( virtualize ) {
+                        newLabelLayer = [self dequeueLabelLayerWithAttributedText:labelString];
+                    }
+                    else {
+                        newLabelLayer = [[CPTTextLayer alloc] initWithAttributedText:labelString];
+                    }
                 }
                 else {
                     NSString *labelString = [dataLabelFormatter stringForObjectValue:dataValue];
-                    newLabelLayer = [[CPTTextLayer alloc] initWithText:labelString style:dataLabelTextStyle];
+                    if ( virtualize ) {
+                        newLabelLayer = [self dequeueLabelLayerWithText:labelString style:dataLabelTextStyle];
+                    }
+                    else {
+                        newLabelLayer = [[CPTTextLayer alloc] initWithText:labelString style:dataLabelTextStyle];
+                    }
                 }
             }
 
@@ -2180,6 +3767,7 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
             [self updateContentAnchorForLabel:labelAnnotation];
         }
     }
+    free(visibleRecords);
 
     // remove labels that are no longer needed
     while ( labelArray.count > sampleCount ) {
@@ -2268,6 +3856,19 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     self.needsRelabel    = YES;
 }
 
+/** @brief Marks the receiver as needing to update which data labels are shown before the content is next drawn.
+ *
+ *  Only has an effect when @ref virtualizesLabels is @YES. The graph calls this when the plot space ranges change.
+ *  Labels that stay in view are kept as they are.
+ **/
+-(void)setNeedsVisibleRelabel
+{
+    if ( self.virtualizesLabels && self.showLabels && !self.needsRelabel ) {
+        self.labelIndexRange = NSMakeRange(0, 0);
+        self.needsRelabel    = YES;
+    }
+}
+
 /// @cond
 
 -(void)updateContentAnchorForLabel:(nonnull CPTPlotSpaceAnnotation *)label
@@ -2294,6 +3895,139 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
+// Flags the records whose data lies inside the plot space ranges, widened by virtualLabelMargin on each side.
+// A record is inside a range if any of the fields plotted along that coordinate is. Coordinates without
+// fields, cached data, or a plot range do not restrict the labels.
+-(void)flagVisibleLabelRecords:(nonnull BOOL *)visible count:(NSUInteger)count
+{
+    memset(visible, YES, count * sizeof(BOOL));
+
+    CPTPlotSpace *thePlotSpace = self.plotSpace;
+    if ( !thePlotSpace || (count == 0)) {
+        return;
+    }
+
+    BOOL *inRange                = (BOOL *)calloc(count, sizeof(BOOL));
+    const CPTCoordinate coords[] = { CPTCoordinateX, CPTCoordinateY };
+
+    for ( size_t c = 0; c < sizeof(coords) / sizeof(coords[0]); c++ ) {
+        CPTPlotRange *range = [thePlotSpace plotRangeForCoordinate:coords[c]];
+        if ( !range ) {
+            continue;
+        }
+        double margin   = fabs(range.lengthDouble) * (double)self.virtualLabelMargin;
+        double minLimit = range.minLimitDouble - margin;
+        double maxLimit = range.maxLimitDouble + margin;
+
+        BOOL constrained = NO;
+        memset(inRange, NO, count * sizeof(BOOL));
+
+        for ( NSNumber *field in [self fieldIdentifiersForCoordinate:coords[c]] ) {
+            CPTMutableNumericData *numbers = [self cachedNumbersForField:field.unsignedIntegerValue];
+            if ( numbers.numberOfSamples < count ) {
+                continue;
+            }
+            constrained = YES;
+
+            if ((numbers.dataTypeFormat == CPTFloatingPointDataType) && (numbers.sampleBytes == sizeof(double))) {
+                const double *values = (const double *)numbers.bytes;
+                for ( NSUInteger i = 0; i < count; i++ ) {
+                    if ((values[i] >= minLimit) && (values[i] <= maxLimit)) {
+                        inRange[i] = YES;
+                    }
+                }
+            }
+            else {
+                NSUInteger fieldEnum = field.unsignedIntegerValue;
+                for ( NSUInteger i = 0; i < count; i++ ) {
+                    double value = [self cachedDoubleForField:fieldEnum recordIndex:i];
+                    if ((value >= minLimit) && (value <= maxLimit)) {
+                        inRange[i] = YES;
+                    }
+                }
+            }
+        }
+
+        if ( constrained ) {
+            for ( NSUInteger i = 0; i < count; i++ ) {
+                visible[i] = visible[i] && inRange[i];
+            }
+        }
+    }
+    free(inRange);
+}
+
+// Text layers are pooled by the look of their style, so equal styles share layers even when they are
+// different objects. Attributed text carries its own styling and is pooled under NSNull.
+static id CPTPlotLabelLayerPoolKey(CPTTextStyle *style)
+{
+    NSNull *null = [NSNull null];
+
+    return @[style.font ?: null,
+             style.fontName ?: null,
+             @(style.fontSize),
+             style.color ?: null,
+             @(style.textAlignment),
+             @(style.lineBreakMode)];
+}
+
+// Removes a label that left the visible region. Text layers made by the plot go back into the pool,
+// layers supplied by the datasource are left alone.
+-(void)recycleLabelAnnotation:(nonnull CPTPlotSpaceAnnotation *)annotation forIndex:(NSUInteger)idx
+{
+    CPTLayer *content = annotation.contentLayer;
+
+    [self removeAnnotation:annotation];
+    annotation.contentLayer = nil;
+
+    if ( [content isKindOfClass:[CPTTextLayer class]] && (content != [self cachedValueForKey:CPTPlotBindingDataLabels recordIndex:idx])) {
+        CPTTextLayer *textLayer = (CPTTextLayer *)content;
+        CPTTextStyle *textStyle = textLayer.textStyle;
+        id poolKey              = textLayer.attributedText ? [NSNull null] : (textStyle ? CPTPlotLabelLayerPoolKey(textStyle) : nil);
+        if ( poolKey ) {
+            NSMutableArray<CPTTextLayer *> *pooledLayers = self.labelLayerPool[poolKey];
+            if ( !pooledLayers ) {
+                pooledLayers                 = [[NSMutableArray alloc] init];
+                self.labelLayerPool[poolKey] = pooledLayers;
+            }
+            [pooledLayers addObject:textLayer];
+        }
+    }
+}
+
+-(nonnull CPTTextLayer *)dequeueLabelLayerWithText:(nullable NSString *)text style:(nullable CPTTextStyle *)style
+{
+    NSMutableArray<CPTTextLayer *> *pooledLayers = style ? self.labelLayerPool[CPTPlotLabelLayerPoolKey(style)] : nil;
+    CPTTextLayer *textLayer                      = pooledLayers.lastObject;
+
+    if ( textLayer ) {
+        [pooledLayers removeLastObject];
+        if ( textLayer.textStyle != style ) {
+            textLayer.textStyle = style;
+        }
+        textLayer.text = text;
+    }
+    else {
+        textLayer = [[CPTTextLayer alloc] initWithText:text style:style];
+    }
+    return textLayer;
+}
+
+-(nonnull CPTTextLayer *)dequeueLabelLayerWithAttributedText:(nullable NSAttributedString *)text
+{
+    NSMutableArray<CPTTextLayer *> *pooledLayers = self.labelLayerPool[[NSNull null]];
+    CPTTextLayer *textLayer                      = pooledLayers.lastObject;
+
+    if ( textLayer ) {
+        [pooledLayers removeLastObject];
+        textLayer.attributedText = text;
+    }
+    else {
+        textLayer = [[CPTTextLayer alloc] initWithAttributedText:text];
+    }
+    return textLayer;
+}
+
 /// @endcond
 
 /**
@@ -2410,6 +4144,32 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
+#pragma mark -
+#pragma mark Hit Testing
+
+/// @cond
+
+-(nonnull _CPTSpatialIndex *)spatialIndexBuiltWithBlock:(nonnull CPTSpatialIndexBuilder)builder
+{
+    _CPTSpatialIndex *theIndex = self.spatialIndex;
+    CGRect theBounds           = self.bounds;
+
+    if ( !theIndex || !CGRectEqualToRect(theBounds, self.spatialIndexBounds) || (self.cachedDataCount != self.spatialIndexDataCount)) {
+        theIndex                   = builder();
+        self.spatialIndex          = theIndex;
+        self.spatialIndexBounds    = theBounds;
+        self.spatialIndexDataCount = self.cachedDataCount;
+    }
+    return theIndex;
+}
+
+-(void)invalidateSpatialIndex
+{
+    self.spatialIndex = nil;
+}
+
+/// @endcond
+
 #pragma mark -
 #pragma mark Responder Chain and User interaction
 
@@ -2736,6 +4496,11 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
 -(nullable CPTPlotArea *)plotArea
 {
+    if ( self.isRenderSnapshot ) {
+        // the snapshot is not in the layer tree
+        return self.renderPlotArea;
+    }
+
     CPTGraph *theGraph = self.graph;
 
     return theGraph.plotAreaFrame.plotArea;
@@ -2765,6 +4530,13 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 -(void)setLabelTextStyle:(nullable CPTTextStyle *)newStyle
 {
     if ( newStyle != labelTextStyle ) {
+        if ( labelTextStyle ) {
+            id oldPoolKey = CPTPlotLabelLayerPoolKey(labelTextStyle);
+
+            if ( !newStyle || ![oldPoolKey isEqual:CPTPlotLabelLayerPoolKey(newStyle)] ) {
+                [self.labelLayerPool removeObjectForKey:oldPoolKey];
+            }
+        }
         labelTextStyle = [newStyle copy];
 
         if ( labelTextStyle && !self.labelFormatter ) {
@@ -2779,6 +4551,25 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
+-(void)setVirtualizesLabels:(BOOL)newVirtualizesLabels
+{
+    if ( newVirtualizesLabels != virtualizesLabels ) {
+        virtualizesLabels = newVirtualizesLabels;
+        if ( !virtualizesLabels ) {
+            [self.labelLayerPool removeAllObjects];
+        }
+        [self setNeedsRelabel];
+    }
+}
+
+-(void)setVirtualLabelMargin:(CGFloat)newMargin
+{
+    if ( newMargin != virtualLabelMargin ) {
+        virtualLabelMargin = newMargin;
+        [self setNeedsVisibleRelabel];
+    }
+}
+
 -(void)setLabelOffset:(CGFloat)newOffset
 {
     if ( newOffset != labelOffset ) {
@@ -2844,6 +4635,68 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
     }
 }
 
+-(void)setStreamingCapacity:(NSUInteger)newCapacity
+{
+    if ( newCapacity != streamingCapacity ) {
+        streamingCapacity = newCapacity;
+
+        // cached numbers keep their current buffers until the next streaming update moves them
+        [self.streamingBuffers removeAllObjects];
+    }
+}
+
+-(nonnull _CPTScratchArena *)scratchArena
+{
+    if ( !scratchArena ) {
+        scratchArena = [[_CPTScratchArena alloc] init];
+    }
+    return scratchArena;
+}
+
+-(NSUInteger)scratchArenaCapacity
+{
+    return scratchArena.capacity;
+}
+
+-(NSUInteger)scratchArenaAllocationCount
+{
+    return scratchArena.systemAllocationCount;
+}
+
+-(void)setCachesRasterTiles:(BOOL)newCachesRasterTiles
+{
+    if ( newCachesRasterTiles != cachesRasterTiles ) {
+        cachesRasterTiles = newCachesRasterTiles;
+        if ( !cachesRasterTiles ) {
+            self.rasterTileCache = nil;
+        }
+        [self setNeedsDisplay];
+    }
+}
+
+-(void)setRendersAsynchronously:(BOOL)newRendersAsynchronously
+{
+    if ( newRendersAsynchronously != rendersAsynchronously ) {
+        rendersAsynchronously = newRendersAsynchronously;
+        if ( !rendersAsynchronously ) {
+            CPTPlotSpace *oldSource = self.renderPlotSpaceSource;
+
+            if ( oldSource ) {
+                [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                                name:CPTPlotSpaceCoordinateMappingDidChangeNotification
+                                                              object:oldSource];
+            }
+
+            self.renderQueue           = nil;
+            self.renderScratchArena    = nil;
+            self.renderPlotSpace       = nil;
+            self.renderPlotArea        = nil;
+            self.renderPlotSpaceSource = nil;
+        }
+        [self setNeedsDisplay];
+    }
+}
+
 -(void)setAlignsPointsToPixels:(BOOL)newAlignsPointsToPixels
 {
     if ( newAlignsPointsToPixels != alignsPointsToPixels ) {
@@ -2866,6 +4719,36 @@ CPTPlotBinding const CPTPlotBindingDataLabels = @"dataLabels"; ///< Plot data la
 
 #pragma mark -
 
+@implementation CPTPlot(FixedPointNumbers)
+
+/** @internal
+ *  @brief Returns the fixed point copy of an NSDecimal field, building it if the field changed since it was last made.
+ *  @param  fieldEnum The field enumerator identifying the field.
+ *  @return           The fixed point numbers, or @nil if the field is not cached as NSDecimal values.
+ **/
+-(nullable _CPTFixedPointNumbers *)fixedPointNumbersForField:(NSUInteger)fieldEnum
+{
+    CPTMutableNumericData *numbers = [self cachedNumbersForField:fieldEnum];
+
+    if ( !numbers || (numbers.dataTypeFormat != CPTDecimalDataType)) {
+        return nil;
+    }
+
+    NSNumber *cacheKey                = @(fieldEnum);
+    _CPTFixedPointNumbers *fixedPoint = self.fixedPointCache[cacheKey];
+
+    if ( ![fixedPoint isValidForNumbers:numbers] ) {
+        fixedPoint                     = [[_CPTFixedPointNumbers alloc] initWithNumbers:numbers];
+        self.fixedPointCache[cacheKey] = fixedPoint;
+    }
+
+    return fixedPoint;
+}
+
+@end
+
+#pragma mark -
+
 @implementation CPTPlot(AbstractMethods)
 
 #pragma mark -
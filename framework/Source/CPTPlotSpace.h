@@ -218,6 +218,7 @@ typedef NSMutableArray<__kindof CPTPlotSpace *> CPTMutablePlotSpaceArray;
 -(CGPoint)plotAreaViewPointForPlotPoint:(nonnull CPTNumberArray *)plotPoint;
 -(CGPoint)plotAreaViewPointForPlotPoint:(nonnull NSDecimal *)plotPoint numberOfCoordinates:(NSUInteger)count;
 -(CGPoint)plotAreaViewPointForDoublePrecisionPlotPoint:(nonnull double *)plotPoint numberOfCoordinates:(NSUInteger)count;
+-(void)plotAreaViewPoints:(nonnull CGPoint *)viewPoints forDoublePrecisionXValues:(nonnull const double *)xValues yValues:(nonnull const double *)yValues numberOfPoints:(NSUInteger)dataCount;
 
 -(nullable CPTNumberArray *)plotPointForPlotAreaViewPoint:(CGPoint)point;
 -(void)plotPoint:(nonnull NSDecimal *)plotPoint numberOfCoordinates:(NSUInteger)count forPlotAreaViewPoint:(CGPoint)point;
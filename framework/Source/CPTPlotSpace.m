@@ -2,6 +2,8 @@
 
 #import "CPTGraph.h"
 #import "CPTMutablePlotRange.h"
+#import "CPTPlotArea.h"
+#import "CPTPlotAreaFrame.h"
 #import "CPTUtilities.h"
 
 CPTPlotSpaceCoordinateMapping const CPTPlotSpaceCoordinateMappingDidChangeNotification = @"CPTPlotSpaceCoordinateMappingDidChangeNotification";
@@ -19,8 +21,10 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
 @property (nonatomic, readwrite, strong, nullable) NSMutableDictionary<NSNumber *, CPTMutableCategorySet *> *categoryNames;
 
 @property (nonatomic, readwrite) BOOL isDragging;
+@property (nonatomic, readwrite, strong, nullable) CPTPlotArea *detachedPlotArea;
 
 -(nonnull CPTMutableCategorySet *)orderedSetForCoordinate:(CPTCoordinate)coordinate;
+-(nullable CPTPlotArea *)mappedPlotArea;
 
 @end
 
@@ -73,6 +77,14 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
  **/
 @synthesize categoryNames;
 
+/** @internal
+ *  @property nullable CPTPlotArea *detachedPlotArea
+ *  @brief A plot area outside the layer tree that the coordinates are mapped to instead of the plot area of the graph.
+ *
+ *  Set on the copies of the plot space that plots drawn on a background queue map their data with.
+ **/
+@synthesize detachedPlotArea;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -99,6 +111,7 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
         graph                 = nil;
         delegate              = nil;
         categoryNames         = nil;
+        detachedPlotArea      = nil;
     }
     return self;
 }
@@ -134,6 +147,7 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
 
     // No need to archive these properties:
     // isDragging
+    // detachedPlotArea
 }
 
 /// @endcond
@@ -155,7 +169,8 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
         categoryNames         = [[coder decodeObjectOfClasses:[NSSet setWithArray:@[[NSDictionary class], [NSString class], [NSNumber class]]]
                                                        forKey:@"CPTPlotSpace.categoryNames"] mutableCopy];
 
-        isDragging = NO;
+        isDragging       = NO;
+        detachedPlotArea = nil;
     }
     return self;
 }
@@ -205,6 +220,23 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
     return categories;
 }
 
+/** @internal
+ *  @brief Gets the plot area the coordinates are mapped to.
+ *  @return The @ref detachedPlotArea if there is one, otherwise the plot area of the graph.
+ */
+-(nullable CPTPlotArea *)mappedPlotArea
+{
+    CPTPlotArea *thePlotArea = self.detachedPlotArea;
+
+    if ( !thePlotArea ) {
+        CPTGraph *theGraph = self.graph;
+
+        thePlotArea = theGraph.plotAreaFrame.plotArea;
+    }
+
+    return thePlotArea;
+}
+
 /// @endcond
 
 /**
@@ -537,6 +569,28 @@ typedef NSMutableOrderedSet<NSString *> CPTMutableCategorySet;
     return CGPointZero;
 }
 
+/** @brief Converts a list of data points to plot area drawing coordinates.
+ *
+ *  The default implementation converts one point at a time using
+ *  @link CPTPlotSpace::plotAreaViewPointForDoublePrecisionPlotPoint:numberOfCoordinates: -plotAreaViewPointForDoublePrecisionPlotPoint:numberOfCoordinates: @endlink.
+ *  Subclasses should override this method to convert the whole list in a single pass.
+ *
+ *  @param viewPoints A c-style array that receives the drawing coordinates. Must hold at least @par{dataCount} points.
+ *  @param xValues    A c-style array of x coordinate values (as @double values).
+ *  @param yValues    A c-style array of y coordinate values (as @double values).
+ *  @param dataCount  The number of points to convert.
+ **/
+-(void)plotAreaViewPoints:(nonnull CGPoint *)viewPoints forDoublePrecisionXValues:(nonnull const double *)xValues yValues:(nonnull const double *)yValues numberOfPoints:(NSUInteger)dataCount
+{
+    for ( NSUInteger i = 0; i < dataCount; i++ ) {
+        double plotPoint[2];
+        plotPoint[CPTCoordinateX] = xValues[i];
+        plotPoint[CPTCoordinateY] = yValues[i];
+
+        viewPoints[i] = [self plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
+    }
+}
+
 /** @brief Converts a point given in plot area drawing coordinates to the data coordinate space.
  *  @param  point The drawing coordinates of the data point.
  *  @return       An array of data point coordinates (as NSNumber values).
@@ -6,6 +6,7 @@
 #import "CPTPlatformSpecificFunctions.h"
 #import "CPTShadow.h"
 #import "NSCoderExtensions.h"
+#import "_CPTPlotSymbolAtlas.h"
 #import <tgmath.h>
 
 /// @cond
@@ -14,9 +15,9 @@
 @property (nonatomic, readwrite, assign, nullable) CGPathRef cachedSymbolPath;
 @property (nonatomic, readwrite, assign, nullable) CGLayerRef cachedLayer;
 @property (nonatomic, readwrite, assign) CGFloat cachedScale;
+@property (nonatomic, readwrite, assign) NSUInteger appearanceGeneration;
 
 -(nonnull CGPathRef)newSymbolPath;
--(CGSize)layerSizeForScale:(CGFloat)scale;
 
 @end
 
@@ -76,6 +77,12 @@
 @synthesize cachedLayer;
 @synthesize cachedScale;
 
+/** @internal
+ *  @property NSUInteger appearanceGeneration
+ *  @brief Counts the changes that discarded the cached symbol image, so symbol atlases can tell their copy of it is stale.
+ **/
+@synthesize appearanceGeneration;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -99,17 +106,18 @@
 -(nonnull instancetype)init
 {
     if ((self = [super init])) {
-        anchorPoint         = CPTPointMake(0.5, 0.5);
-        size                = CPTSizeMake(5.0, 5.0);
-        symbolType          = CPTPlotSymbolTypeNone;
-        lineStyle           = [[CPTLineStyle alloc] init];
-        fill                = nil;
-        shadow              = nil;
-        cachedSymbolPath    = NULL;
-        customSymbolPath    = NULL;
-        usesEvenOddClipRule = NO;
-        cachedLayer         = NULL;
-        cachedScale         = CPTFloat(0.0);
+        anchorPoint          = CPTPointMake(0.5, 0.5);
+        size                 = CPTSizeMake(5.0, 5.0);
+        symbolType           = CPTPlotSymbolTypeNone;
+        lineStyle            = [[CPTLineStyle alloc] init];
+        fill                 = nil;
+        shadow               = nil;
+        cachedSymbolPath     = NULL;
+        customSymbolPath     = NULL;
+        usesEvenOddClipRule  = NO;
+        cachedLayer          = NULL;
+        cachedScale          = CPTFloat(0.0);
+        appearanceGeneration = 0;
     }
     return self;
 }
@@ -147,6 +155,7 @@
     // cachedSymbolPath
     // cachedLayer
     // cachedScale
+    // appearanceGeneration
 }
 
 -(nullable instancetype)initWithCoder:(nonnull NSCoder *)coder
@@ -164,9 +173,10 @@
         customSymbolPath    = [coder newCGPathDecodeForKey:@"CPTPlotSymbol.customSymbolPath"];
         usesEvenOddClipRule = [coder decodeBoolForKey:@"CPTPlotSymbol.usesEvenOddClipRule"];
 
-        cachedSymbolPath = NULL;
-        cachedLayer      = NULL;
-        cachedScale      = CPTFloat(0.0);
+        cachedSymbolPath     = NULL;
+        cachedLayer          = NULL;
+        cachedScale          = CPTFloat(0.0);
+        appearanceGeneration = 0;
     }
     return self;
 }
@@ -260,8 +270,8 @@
     if ( cachedSymbolPath != newPath ) {
         CGPathRelease(cachedSymbolPath);
         cachedSymbolPath = CGPathRetain(newPath);
-        self.cachedLayer = NULL;
     }
+    self.cachedLayer = NULL;
 }
 
 -(void)setCachedLayer:(nullable CGLayerRef)newLayer
@@ -270,6 +280,11 @@
         CGLayerRelease(cachedLayer);
         cachedLayer = CGLayerRetain(newLayer);
     }
+
+    // the layer is only cleared when the appearance changes, even if this symbol was only drawn through an atlas
+    if ( !newLayer ) {
+        self.appearanceGeneration++;
+    }
 }
 
 /// @endcond
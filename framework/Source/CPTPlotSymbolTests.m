@@ -0,0 +1,247 @@
+#import "CPTPlotSymbolTests.h"
+
+#import "CPTColor.h"
+#import "CPTColorSpace.h"
+#import "CPTFill.h"
+#import "CPTScatterPlot.h"
+#import "CPTUtilities.h"
+#import "_CPTPlotSymbolAtlas.h"
+
+static const NSUInteger CPTPlotSymbolTestsPointCount = 20000;
+
+// points spread over a 512 by 512 area
+static void CPTPlotSymbolTestsFillPoints(CGPoint *points, NSUInteger count)
+{
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        points[i] = CPTPointMake((CGFloat)((i * 7919) % 509) + CPTFloat(1.5), (CGFloat)((i * 104729) % 503) + CPTFloat(4.5));
+    }
+}
+
+@interface CPTScatterPlot(Testing)
+
+-(void)setYValues:(nullable CPTNumberArray *)newValues;
+-(void)setPlotSymbols:(nullable NSArray *)newSymbols;
+-(nullable NSData *)plotSymbolIndices;
+-(nullable CPTPlotSymbolArray *)indexedPlotSymbols;
+
+@end
+
+@interface CPTPlotSymbolTests()
+
+-(nonnull CGContextRef)newContextWithScale:(CGFloat)scale;
+
+@end
+
+#pragma mark -
+
+@implementation CPTPlotSymbolTests
+
+@synthesize plot;
+
+-(void)setUp
+{
+    self.plot = [CPTScatterPlot new];
+    [self.plot setYValues:@[@0.5, @0.5, @0.5, @0.5, @0.5]];
+}
+
+-(void)tearDown
+{
+    self.plot = nil;
+}
+
+// a 512 by 512 point bitmap
+-(nonnull CGContextRef)newContextWithScale:(CGFloat)scale
+{
+    size_t pixelSize = (size_t)(CPTFloat(512.0) * scale);
+
+    CGContextRef context = CGBitmapContextCreate(NULL, pixelSize, pixelSize, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CGContextScaleCTM(context, scale, scale);
+    return context;
+}
+
+#pragma mark -
+#pragma mark Symbol indices
+
+-(void)testPlotSymbolsResolveToIndices
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    CPTPlotSymbol *circle = [CPTPlotSymbol ellipsePlotSymbol];
+    CPTPlotSymbol *square = [CPTPlotSymbol rectanglePlotSymbol];
+
+    [thePlot setPlotSymbols:@[circle, circle, [CPTPlot nilData], square, [NSNull null]]];
+
+    NSData *indexData = [thePlot plotSymbolIndices];
+    XCTAssertEqual(indexData.length, 5 * sizeof(uint32_t), @"One index per record");
+
+    const uint32_t *indices = (const uint32_t *)indexData.bytes;
+    XCTAssertEqual(indices[0], (uint32_t)1, @"First symbol");
+    XCTAssertEqual(indices[1], (uint32_t)1, @"Repeated symbol shares its index");
+    XCTAssertEqual(indices[2], (uint32_t)0, @"Missing symbol uses the plot symbol");
+    XCTAssertEqual(indices[3], (uint32_t)2, @"Second symbol");
+    XCTAssertEqual(indices[4], UINT32_MAX, @"Placeholder draws no symbol");
+    XCTAssertEqualObjects([thePlot indexedPlotSymbols], (@[circle, square]), @"Distinct symbols in record order");
+
+    [thePlot deleteDataInIndexRange:NSMakeRange(0, 2)];
+
+    indexData = [thePlot plotSymbolIndices];
+    indices   = (const uint32_t *)indexData.bytes;
+    XCTAssertEqual(indexData.length, 3 * sizeof(uint32_t), @"Deleted records drop their indices");
+    XCTAssertEqual(indices[1], (uint32_t)1, @"Remaining symbol is renumbered");
+    XCTAssertEqualObjects([thePlot indexedPlotSymbols], (@[square]), @"Deleted symbols are no longer indexed");
+}
+
+#pragma mark -
+#pragma mark Symbol atlas
+
+-(void)testSymbolAtlasRasterizesSymbolsOnce
+{
+    CPTPlotSymbol *circle = [CPTPlotSymbol ellipsePlotSymbol];
+    CPTPlotSymbol *square = [CPTPlotSymbol rectanglePlotSymbol];
+
+    circle.fill = [CPTFill fillWithColor:[CPTColor redColor]];
+
+    CGContextRef context = CGBitmapContextCreate(NULL, 64, 64, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    _CPTPlotSymbolAtlas *atlas = [[_CPTPlotSymbolAtlas alloc] init];
+    NSArray *entries           = @[[CPTPlot nilData], circle, square];
+
+    [atlas prepareEntries:entries scale:CPTFloat(2.0) context:context];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)1, @"Symbols rasterized");
+    XCTAssertEqual(atlas.entryCount, (NSUInteger)3, @"One entry per symbol");
+    XCTAssertGreaterThan(atlas.bitmapSize.width, CPTFloat(0.0), @"Symbols share a bitmap");
+
+    [atlas prepareEntries:entries scale:CPTFloat(2.0) context:context];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)1, @"Unchanged symbols are reused");
+
+    circle.size = CGSizeMake(8.0, 8.0);
+    [atlas prepareEntries:entries scale:CPTFloat(2.0) context:context];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)2, @"Restyled symbols are rasterized again");
+
+    [atlas prepareEntries:entries scale:CPTFloat(1.0) context:context];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)3, @"A new scale rasterizes the symbols again");
+
+    CGColorSpaceRef deviceSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef deviceContext  = CGBitmapContextCreate(NULL, 8, 8, 8, 0, deviceSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    [atlas prepareEntries:entries scale:CPTFloat(1.0) context:deviceContext];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)4, @"Another destination color space rasterizes the symbols again");
+
+    [atlas prepareEntries:entries scale:CPTFloat(1.0) context:context];
+    XCTAssertEqual(atlas.buildCount, (NSUInteger)5, @"Symbols follow the destination color space");
+
+    CGContextRelease(deviceContext);
+    CGColorSpaceRelease(deviceSpace);
+
+    CGContextClearRect(context, CGRectMake(0.0, 0.0, 64.0, 64.0));
+
+    CGPoint center = CGPointMake(32.0, 32.0);
+    [atlas stampEntry:1 atPoints:&center count:1 inContext:context alignToPixels:YES];
+
+    const uint8_t *pixels = (const uint8_t *)CGBitmapContextGetData(context);
+    size_t bytesPerRow    = CGBitmapContextGetBytesPerRow(context);
+    XCTAssertGreaterThan(pixels[31 * bytesPerRow + 32 * 4 + 3], (uint8_t)0, @"Stamped symbol covers its point");
+    XCTAssertEqual(pixels[4 * bytesPerRow + 4 * 4 + 3], (uint8_t)0, @"Stamped symbol stays around its point");
+
+    CGContextRelease(context);
+}
+
+-(void)testBatchedStampsMatchSingleStamps
+{
+    CPTPlotSymbol *circle = [CPTPlotSymbol ellipsePlotSymbol];
+
+    circle.size = CGSizeMake(9.0, 9.0);
+    circle.fill = [CPTFill fillWithColor:[[CPTColor redColor] colorWithAlphaComponent:CPTFloat(0.5)]];
+
+    CGContextRef batchContext  = [self newContextWithScale:CPTFloat(2.0)];
+    CGContextRef singleContext = [self newContextWithScale:CPTFloat(2.0)];
+
+    _CPTPlotSymbolAtlas *atlas = [[_CPTPlotSymbolAtlas alloc] init];
+
+    [atlas prepareEntries:@[circle] scale:CPTFloat(2.0) context:batchContext];
+
+    // overlapping stamps, so the blending order shows
+    CGPoint points[64];
+
+    for ( NSUInteger i = 0; i < 64; i++ ) {
+        points[i] = CPTPointMake(CPTFloat(100.0) + (CGFloat)(i % 8) * CPTFloat(3.3), CPTFloat(200.0) + (CGFloat)(i / 8) * CPTFloat(2.7));
+    }
+
+    [atlas stampEntry:0 atPoints:points count:64 inContext:batchContext alignToPixels:YES];
+    for ( NSUInteger i = 0; i < 64; i++ ) {
+        [atlas stampEntry:0 atPoints:&points[i] count:1 inContext:singleContext alignToPixels:YES];
+    }
+
+    const uint8_t *batchPixels  = (const uint8_t *)CGBitmapContextGetData(batchContext);
+    const uint8_t *singlePixels = (const uint8_t *)CGBitmapContextGetData(singleContext);
+    size_t length               = CGBitmapContextGetBytesPerRow(batchContext) * CGBitmapContextGetHeight(batchContext);
+    NSUInteger coveredCount     = 0;
+    int maxDifference           = 0;
+
+    for ( size_t i = 0; i < length; i++ ) {
+        maxDifference = MAX(maxDifference, abs((int)batchPixels[i] - (int)singlePixels[i]));
+        if ((i % 4 == 3) && (batchPixels[i] > 0)) {
+            coveredCount++;
+        }
+    }
+
+    XCTAssertGreaterThan(coveredCount, (NSUInteger)0, @"Batch drew the symbols");
+    XCTAssertLessThanOrEqual(maxDifference, 2, @"Batch blends like drawing each stamp");
+
+    CGContextRelease(batchContext);
+    CGContextRelease(singleContext);
+}
+
+#pragma mark -
+#pragma mark Performance
+
+-(void)testPerformanceStampingSymbolsFromAtlas
+{
+    CPTPlotSymbol *circle = [CPTPlotSymbol ellipsePlotSymbol];
+
+    circle.fill = [CPTFill fillWithColor:[CPTColor redColor]];
+
+    CGContextRef context = [self newContextWithScale:CPTFloat(2.0)];
+    CGPoint *points      = calloc(CPTPlotSymbolTestsPointCount, sizeof(CGPoint));
+
+    CPTPlotSymbolTestsFillPoints(points, CPTPlotSymbolTestsPointCount);
+
+    _CPTPlotSymbolAtlas *atlas = [[_CPTPlotSymbolAtlas alloc] init];
+
+    [atlas prepareEntries:@[circle] scale:CPTFloat(2.0) context:context];
+
+    [self measureBlock: ^{
+        [atlas stampEntry:0 atPoints:points count:CPTPlotSymbolTestsPointCount inContext:context alignToPixels:YES];
+    }];
+
+    free(points);
+    CGContextRelease(context);
+}
+
+// the per symbol layer the atlas replaces
+-(void)testPerformanceDrawingSymbolsFromLayers
+{
+    CPTPlotSymbol *circle = [CPTPlotSymbol ellipsePlotSymbol];
+
+    circle.fill = [CPTFill fillWithColor:[CPTColor redColor]];
+
+    CGContextRef context = [self newContextWithScale:CPTFloat(2.0)];
+    CGPoint *points      = calloc(CPTPlotSymbolTestsPointCount, sizeof(CGPoint));
+
+    CPTPlotSymbolTestsFillPoints(points, CPTPlotSymbolTestsPointCount);
+
+    // build the cached layer before measuring
+    [circle renderInContext:context atPoint:points[0] scale:CPTFloat(2.0) alignToPixels:YES];
+
+    [self measureBlock: ^{
+        for ( NSUInteger i = 0; i < CPTPlotSymbolTestsPointCount; i++ ) {
+            [circle renderInContext:context atPoint:points[i] scale:CPTFloat(2.0) alignToPixels:YES];
+        }
+    }];
+
+    free(points);
+    CGContextRelease(context);
+}
+
+@end
@@ -0,0 +1,11 @@
+#import "CPTTestCase.h"
+
+@class CPTScatterPlot;
+@class CPTXYPlotSpace;
+
+@interface CPTPlotTests : CPTTestCase
+
+@property (nonatomic, readwrite, strong, nullable) CPTScatterPlot *plot;
+@property (nonatomic, readwrite, strong, nullable) CPTXYPlotSpace *plotSpace;
+
+@end
@@ -0,0 +1,810 @@
+#import "CPTPlotTests.h"
+
+#import "CPTContourPlot.h"
+#import "CPTFieldFunctionDataSource.h"
+#import "CPTMutableNumericData.h"
+#import "CPTPlotRange.h"
+#import "CPTPlotSpaceAnnotation.h"
+#import "CPTScatterPlot.h"
+#import "CPTTextLayer.h"
+#import "CPTTextStyle.h"
+#import "CPTUtilities.h"
+#import "CPTXYGraph.h"
+#import "CPTXYPlotSpace.h"
+#import "_CPTRasterTileCache.h"
+
+@interface CPTScatterPlot(Testing)
+
+-(void)setXValues:(nullable CPTNumberArray *)newValues;
+-(void)setYValues:(nullable CPTNumberArray *)newValues;
+-(nonnull CPTPlot *)renderSnapshot;
+-(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace includeVisiblePointsOnly:(BOOL)visibleOnly numberOfPoints:(NSUInteger)dataCount;
+-(nullable id)fixedPointNumbersForField:(NSUInteger)fieldEnum;
+
+@end
+
+@interface CPTContourPlot(Testing)
+
+-(nonnull NSString *)planesCacheFilePath;
+-(BOOL)needsIsoCurvesUpdate;
+-(NSUInteger)fieldBlockGeneration;
+
+@end
+
+@interface CPTPlot(Testing)
+
+-(NSUInteger)renderGeneration;
+-(nullable dispatch_queue_t)renderQueue;
+-(void)setRenderQueue:(nullable dispatch_queue_t)newQueue;
+-(nonnull NSMutableDictionary *)labelLayerPool;
+-(nullable CPTMutableAnnotationArray *)labelAnnotations;
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot;
+
+@end
+
+#pragma mark -
+
+@interface CPTPlotTestsMatrixDataSource : NSObject<CPTScatterPlotDataSource>
+
+@property (nonatomic, readwrite, strong, nullable) CPTNumericData *matrix;
+@property (nonatomic, readwrite, assign) BOOL adoptsData;
+
+@end
+
+@implementation CPTPlotTestsMatrixDataSource
+
+@synthesize matrix;
+@synthesize adoptsData;
+
+-(NSUInteger)numberOfRecordsForPlot:(nonnull CPTPlot *__unused)plot
+{
+    return self.matrix.shape[0].unsignedIntegerValue;
+}
+
+-(nullable CPTNumericData *)dataForPlot:(nonnull CPTPlot *__unused)plot recordIndexRange:(NSRange __unused)indexRange
+{
+    return self.matrix;
+}
+
+-(BOOL)plotMayAdoptData:(nonnull CPTPlot *__unused)plot
+{
+    return self.adoptsData;
+}
+
+@end
+
+#pragma mark -
+
+@interface CPTPlotTestsStreamingDataSource : NSObject<CPTScatterPlotDataSource>
+
+@property (nonatomic, readwrite, assign) NSUInteger firstRecord;
+@property (nonatomic, readwrite, assign) NSUInteger recordCount;
+
+@end
+
+@implementation CPTPlotTestsStreamingDataSource
+
+@synthesize firstRecord;
+@synthesize recordCount;
+
+-(NSUInteger)numberOfRecordsForPlot:(nonnull CPTPlot *__unused)plot
+{
+    return self.recordCount;
+}
+
+-(nullable NSArray *)numbersForPlot:(nonnull CPTPlot *__unused)plot field:(NSUInteger)fieldEnum recordIndexRange:(NSRange)indexRange
+{
+    NSMutableArray<NSNumber *> *numbers = [NSMutableArray arrayWithCapacity:indexRange.length];
+
+    // each record keeps its values while older records are evicted in front of it
+    for ( NSUInteger i = indexRange.location; i < NSMaxRange(indexRange); i++ ) {
+        double record = (double)(self.firstRecord + i);
+        [numbers addObject:@(fieldEnum == CPTScatterPlotFieldX ? record : 10.0 * record)];
+    }
+    return numbers;
+}
+
+@end
+
+#pragma mark -
+
+@interface CPTPlotTestsSynchronousPlot : CPTScatterPlot
+@end
+
+@implementation CPTPlotTestsSynchronousPlot
+
++(BOOL)supportsAsynchronousRendering
+{
+    return NO;
+}
+
+@end
+
+#pragma mark -
+
+@interface CPTPlotTestsDrawingDelegate : NSObject<CPTScatterPlotDelegate, CPTContourPlotDelegate>
+
+@property (nonatomic, readwrite, assign) NSUInteger drawCount;
+@property (nonatomic, readwrite, assign) BOOL drewOnMainThread;
+@property (nonatomic, readwrite, strong, nullable) XCTestExpectation *expectation;
+
+@end
+
+@implementation CPTPlotTestsDrawingDelegate
+
+@synthesize drawCount;
+@synthesize drewOnMainThread;
+@synthesize expectation;
+
+-(void)didFinishDrawing:(nonnull CPTPlot *__unused)plot
+{
+    self.drawCount++;
+    self.drewOnMainThread = [NSThread isMainThread];
+    [self.expectation fulfill];
+}
+
+@end
+
+#pragma mark -
+
+@implementation CPTPlotTests
+
+@synthesize plot;
+@synthesize plotSpace;
+
+-(void)setUp
+{
+    CPTNumberArray *yValues = @[@0.5, @0.5, @0.5, @0.5, @0.5];
+
+    self.plot = [CPTScatterPlot new];
+    [self.plot setYValues:yValues];
+    self.plot.cachePrecision = CPTPlotCachePrecisionDouble;
+
+    CPTPlotRange *xPlotRange = [CPTPlotRange plotRangeWithLocation:@0.0 length:@1.0];
+    CPTPlotRange *yPlotRange = [CPTPlotRange plotRangeWithLocation:@0.0 length:@1.0];
+
+    self.plotSpace        = [[CPTXYPlotSpace alloc] init];
+    self.plotSpace.xRange = xPlotRange;
+    self.plotSpace.yRange = yPlotRange;
+}
+
+-(void)tearDown
+{
+    self.plot      = nil;
+    self.plotSpace = nil;
+}
+
+#pragma mark -
+#pragma mark Asynchronous rendering
+
+-(void)testRenderSnapshotOwnsItsData
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+    thePlot.plotSpace = self.plotSpace;
+
+    XCTAssertTrue([CPTScatterPlot supportsAsynchronousRendering], @"Scatter plots can be drawn asynchronously");
+
+    CPTScatterPlot *snapshot = (CPTScatterPlot *)[thePlot renderSnapshot];
+
+    CPTMutableNumericData *xNumbers     = [thePlot cachedNumbersForField:CPTScatterPlotFieldX];
+    CPTMutableNumericData *snapshotData = [snapshot cachedNumbersForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqual(snapshotData, xNumbers, @"Snapshot shares the data until it changes");
+
+    XCTAssertNotEqual(snapshot.plotSpace, thePlot.plotSpace, @"Snapshot has its own plot space");
+    XCTAssertNil(snapshot.plotSpace.graph, @"Snapshot plot space is not linked to the graph");
+    XCTAssertEqualObjects(((CPTXYPlotSpace *)snapshot.plotSpace).xRange, self.plotSpace.xRange, @"Snapshot x range matches the plot");
+    XCTAssertEqualObjects(((CPTXYPlotSpace *)snapshot.plotSpace).yRange, self.plotSpace.yRange, @"Snapshot y range matches the plot");
+
+    CPTScatterPlot *nextSnapshot = (CPTScatterPlot *)[thePlot renderSnapshot];
+
+    XCTAssertEqual(nextSnapshot.plotSpace, snapshot.plotSpace, @"The plot space is copied again only when it changes");
+
+    [thePlot deleteDataInIndexRange:NSMakeRange(0, 1)];
+
+    XCTAssertNotEqual([thePlot cachedNumbersForField:CPTScatterPlotFieldX], snapshotData, @"Changing the data copies it first");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], 0.2, @"The plot has the changed data");
+    XCTAssertEqual(snapshotData.numberOfSamples, (NSUInteger)5, @"Changing the data leaves the snapshot alone");
+    XCTAssertEqual([snapshot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], 0.1, @"Changing the data leaves the snapshot alone");
+
+    self.plotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@1.0 length:@2.0];
+
+    XCTAssertEqualObjects(((CPTXYPlotSpace *)snapshot.plotSpace).xRange, [CPTPlotRange plotRangeWithLocation:@0.0 length:@1.0], @"Changing the plot space leaves the snapshot alone");
+    XCTAssertNotEqual(((CPTScatterPlot *)[thePlot renderSnapshot]).plotSpace, snapshot.plotSpace, @"Changing the plot space copies it again");
+}
+
+-(void)testAsynchronousDisplay
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+    thePlot.plotSpace             = self.plotSpace;
+    thePlot.bounds                = CPTRectMake(0.0, 0.0, 100.0, 100.0);
+    thePlot.rendersAsynchronously = YES;
+
+    CPTPlotTestsDrawingDelegate *drawingDelegate = [[CPTPlotTestsDrawingDelegate alloc] init];
+
+    drawingDelegate.expectation = [self expectationWithDescription:@"Frame shown"];
+    thePlot.delegate            = drawingDelegate;
+
+    [thePlot display];
+
+    XCTAssertEqual(thePlot.renderGeneration, (NSUInteger)1, @"Frame started on the render queue");
+    XCTAssertNotNil(thePlot.renderQueue, @"Render queue created");
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)0, @"Frame is not drawn while displaying");
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)1, @"Frame shown once");
+    XCTAssertTrue(drawingDelegate.drewOnMainThread, @"Frame shown on the main thread");
+    XCTAssertNotNil(thePlot.contents, @"Frame bitmap shown");
+    XCTAssertGreaterThan(thePlot.renderingLatency, 0.0, @"Latency measured");
+}
+
+-(void)testAsynchronousDisplayCoalescesRequests
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+    thePlot.plotSpace             = self.plotSpace;
+    thePlot.bounds                = CPTRectMake(0.0, 0.0, 100.0, 100.0);
+    thePlot.rendersAsynchronously = YES;
+
+    // hold the frames until every request is made
+    dispatch_queue_t queue = dispatch_queue_create("CPTPlotTests.renderQueue", DISPATCH_QUEUE_SERIAL);
+
+    dispatch_suspend(queue);
+    thePlot.renderQueue = queue;
+
+    CPTPlotTestsDrawingDelegate *drawingDelegate = [[CPTPlotTestsDrawingDelegate alloc] init];
+
+    drawingDelegate.expectation = [self expectationWithDescription:@"Last frame shown"];
+    thePlot.delegate            = drawingDelegate;
+
+    for ( NSUInteger i = 0; i < 3; i++ ) {
+        [thePlot setNeedsDisplay];
+        [thePlot display];
+    }
+    XCTAssertEqual(thePlot.renderGeneration, (NSUInteger)3, @"Every request starts a frame");
+
+    dispatch_resume(queue);
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    // the skipped frames never reach the main queue, so a later block runs after all of them
+    XCTestExpectation *drained = [self expectationWithDescription:@"Render queue drained"];
+
+    dispatch_async(queue, ^{
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [drained fulfill];
+        });
+    });
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)1, @"Superseded frames are skipped");
+}
+
+-(void)testSynchronousDisplayFallback
+{
+    CPTPlotTestsSynchronousPlot *syncPlot = [[CPTPlotTestsSynchronousPlot alloc] init];
+
+    [syncPlot setYValues:@[@0.5, @0.5, @0.5, @0.5, @0.5]];
+
+    CPTPlotTestsDrawingDelegate *drawingDelegate = [[CPTPlotTestsDrawingDelegate alloc] init];
+
+    for ( CPTScatterPlot *thePlot in @[self.plot, syncPlot] ) {
+        [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+        thePlot.plotSpace = self.plotSpace;
+        thePlot.bounds    = CPTRectMake(0.0, 0.0, 100.0, 100.0);
+        thePlot.delegate  = drawingDelegate;
+    }
+
+    // asynchronous rendering is off
+    [self.plot display];
+
+    XCTAssertEqual(self.plot.renderGeneration, (NSUInteger)0, @"No frame started on the render queue");
+    XCTAssertNil(self.plot.renderQueue, @"No render queue");
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)1, @"Drawn while displaying");
+    XCTAssertTrue(drawingDelegate.drewOnMainThread, @"Drawn on the main thread");
+
+    // the class cannot be drawn asynchronously
+    syncPlot.rendersAsynchronously = YES;
+    [syncPlot display];
+
+    XCTAssertEqual(syncPlot.renderGeneration, (NSUInteger)0, @"Unsupported classes are drawn directly");
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)2, @"Drawn while displaying");
+
+    // the raster tiles are drawn on the main thread
+    self.plot.rendersAsynchronously = YES;
+    self.plot.cachesRasterTiles     = YES;
+    [self.plot display];
+
+    XCTAssertEqual(self.plot.renderGeneration, (NSUInteger)0, @"Raster tile caching draws directly");
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)3, @"Drawn while displaying");
+}
+
+-(void)testAsynchronousContourDisplay
+{
+    CPTXYPlotSpace *thePlotSpace = self.plotSpace;
+    CPTXYGraph *graph            = [[CPTXYGraph alloc] initWithFrame:CPTRectMake(0.0, 0.0, 100.0, 100.0)];
+    CPTContourPlot *contourPlot  = [[CPTContourPlot alloc] init];
+
+    CPTFieldFunctionDataSource *fieldDataSource = [CPTFieldFunctionDataSource dataSourceForPlot:contourPlot withBlock:^(double x, double y) {
+        return x * x + y * y;
+    }];
+
+    thePlotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@(-1.0) length:@2.0];
+    thePlotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@(-1.0) length:@2.0];
+
+    contourPlot.functionPlot = YES;
+    contourPlot.noIsoCurves  = 5;
+    contourPlot.limits       = [CPTMutableNumberArray arrayWithObjects:@(-1.0), @1.0, @(-1.0), @1.0, nil];
+    [contourPlot setFirstGridColumns:16 Rows:16];
+    [contourPlot setSecondaryGridColumns:64 Rows:64];
+
+    [graph addPlotSpace:thePlotSpace];
+    [graph addPlot:contourPlot toPlotSpace:thePlotSpace];
+    [graph layoutIfNeeded];
+
+    fieldDataSource.resolutionX = 10.0;
+    fieldDataSource.resolutionY = 10.0;
+
+    contourPlot.rendersAsynchronously = YES;
+
+    CPTPlotTestsDrawingDelegate *drawingDelegate = [[CPTPlotTestsDrawingDelegate alloc] init];
+
+    drawingDelegate.expectation = [self expectationWithDescription:@"Contours shown"];
+    contourPlot.delegate        = drawingDelegate;
+
+    XCTAssertTrue([CPTContourPlot supportsAsynchronousRendering], @"Contour plots can be drawn asynchronously");
+
+    [contourPlot display];
+
+    XCTAssertEqual(contourPlot.renderGeneration, (NSUInteger)1, @"Contours generated on the render queue");
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertTrue(drawingDelegate.drewOnMainThread, @"Frame shown on the main thread");
+    XCTAssertNotNil(contourPlot.contents, @"Frame bitmap shown");
+    XCTAssertGreaterThan([contourPlot getIsoCurveValues].count, (NSUInteger)0, @"The plot takes over the iso-curves the snapshot generated");
+    XCTAssertFalse(contourPlot.needsIsoCurvesUpdate, @"The plot knows its iso-curves are up to date");
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:contourPlot.planesCacheFilePath], @"The plot takes over the planes cache file");
+
+    // the next frame draws the cached contours rather than generating them again
+    CPTNumberArray *isoCurveValues = [contourPlot getIsoCurveValues];
+
+    drawingDelegate.expectation = [self expectationWithDescription:@"Cached contours shown"];
+
+    [contourPlot setNeedsDisplay];
+    [contourPlot display];
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(drawingDelegate.drawCount, (NSUInteger)2, @"Both frames shown");
+    XCTAssertEqual([contourPlot getIsoCurveValues], isoCurveValues, @"Cached contours are not generated again");
+
+    // planes cached for one field block are never read back for another
+    NSUInteger fieldBlockGeneration = contourPlot.fieldBlockGeneration;
+
+    contourPlot.dataSourceBlock = contourPlot.dataSourceBlock;
+    XCTAssertEqual(contourPlot.fieldBlockGeneration, fieldBlockGeneration, @"The same field block keeps the cached planes");
+
+    CPTContourPlot *copiedPlot = [[CPTContourPlot alloc] initWithLayer:contourPlot];
+    XCTAssertEqual(copiedPlot.fieldBlockGeneration, fieldBlockGeneration, @"Render snapshots write planes for the plot's field block");
+
+    [contourPlot updateDataSourceBlock:^double (double x, double y) {
+        return x - y;
+    }];
+    XCTAssertEqual(contourPlot.fieldBlockGeneration, fieldBlockGeneration + 1, @"A new field block outdates the cached planes");
+}
+
+#pragma mark -
+#pragma mark Data Ranges
+
+-(void)testPlotRangeForFieldAfterDeletingExtremum
+{
+    [self.plot setXValues:@[@0.1, @0.9, @0.5, @0.2, @0.3]];
+
+    CPTPlotRange *range = [self.plot plotRangeForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqualWithAccuracy(range.locationDouble, 0.1, 1.0e-9, @"Initial minimum");
+    XCTAssertEqualWithAccuracy(range.lengthDouble, 0.8, 1.0e-9, @"Initial extent");
+
+    [self.plot deleteDataInIndexRange:NSMakeRange(0, 2)];
+    range = [self.plot plotRangeForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqualWithAccuracy(range.locationDouble, 0.2, 1.0e-9, @"Minimum after deleting both extrema");
+    XCTAssertEqualWithAccuracy(range.lengthDouble, 0.3, 1.0e-9, @"Extent after deleting both extrema");
+}
+
+-(void)testPlotRangeForFieldAfterDeletingInteriorValues
+{
+    [self.plot setXValues:@[@0.1, @(NAN), @0.5, @0.2, @0.9]];
+
+    CPTPlotRange *range = [self.plot plotRangeForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqualWithAccuracy(range.locationDouble, 0.1, 1.0e-9, @"Initial minimum ignores NaN");
+    XCTAssertEqualWithAccuracy(range.lengthDouble, 0.8, 1.0e-9, @"Initial extent ignores NaN");
+
+    [self.plot deleteDataInIndexRange:NSMakeRange(1, 3)];
+    range = [self.plot plotRangeForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqualWithAccuracy(range.locationDouble, 0.1, 1.0e-9, @"Minimum unchanged");
+    XCTAssertEqualWithAccuracy(range.lengthDouble, 0.8, 1.0e-9, @"Extent unchanged");
+
+    [self.plot setXValues:@[@(NAN), @(NAN)]];
+    XCTAssertNil([self.plot plotRangeForField:CPTScatterPlotFieldX], @"No range when every value is NaN");
+}
+
+-(void)testDecimalCacheComparesFixedPointValues
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    thePlot.cachePrecision = CPTPlotCachePrecisionDecimal;
+
+    // the fourth value has too many digits for 64 bits and is compared as an NSDecimal
+    CPTNumberArray *xValues = @[[NSDecimalNumber decimalNumberWithString:@"-0.05"],
+                                [NSDecimalNumber decimalNumberWithString:@"0.1"],
+                                [NSDecimalNumber notANumber],
+                                [NSDecimalNumber decimalNumberWithString:@"1.0000000000000000000000000001"],
+                                [NSDecimalNumber decimalNumberWithString:@"0.99999"],
+                                [NSDecimalNumber decimalNumberWithString:@"1"]];
+    CPTNumberArray *yValues = @[@0.5, @0.5, @0.5, @0.5, @0.5, @0.5];
+
+    [thePlot setXValues:xValues];
+    [thePlot setYValues:yValues];
+
+    XCTAssertNotNil([thePlot fixedPointNumbersForField:CPTScatterPlotFieldX], @"Decimal fields get a fixed point copy");
+    XCTAssertEqualObjects([[thePlot fixedPointNumbersForField:CPTScatterPlotFieldX] valueForKey:@"overflowCount"], @1, @"Only the long value overflows");
+
+    BOOL expected[] = { NO, YES, NO, NO, YES, YES };
+    BOOL drawFlags[6];
+
+    [thePlot calculatePointsToDraw:drawFlags forPlotSpace:self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:xValues.count];
+
+    for ( NSUInteger i = 0; i < xValues.count; i++ ) {
+        XCTAssertEqual(drawFlags[i], expected[i], @"Point %lu (%@)", (unsigned long)i, xValues[i]);
+    }
+
+    CPTPlotRange *range = [thePlot plotRangeForField:CPTScatterPlotFieldX];
+
+    XCTAssertTrue(CPTDecimalEquals(range.locationDecimal, xValues[0].decimalValue), @"Exact minimum");
+    XCTAssertTrue(CPTDecimalEquals(range.endDecimal, xValues[3].decimalValue), @"Exact maximum from the overflowed value");
+}
+
+-(void)testRenderSnapshotSharesFixedPointNumbers
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    thePlot.cachePrecision = CPTPlotCachePrecisionDecimal;
+    thePlot.plotSpace      = self.plotSpace;
+
+    [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+    [thePlot setYValues:@[@0.5, @0.4, @0.3, @0.2, @0.1]];
+
+    id xFixedPoint = [thePlot fixedPointNumbersForField:CPTScatterPlotFieldX];
+
+    XCTAssertNotNil(xFixedPoint, @"Decimal fields get a fixed point copy");
+
+    CPTScatterPlot *snapshot = (CPTScatterPlot *)[thePlot renderSnapshot];
+
+    XCTAssertEqual([snapshot fixedPointNumbersForField:CPTScatterPlotFieldX], xFixedPoint, @"Snapshot shares the fixed point copy of the shared data");
+
+    id yFixedPoint = [snapshot fixedPointNumbersForField:CPTScatterPlotFieldY];
+
+    XCTAssertNotNil(yFixedPoint, @"Snapshot builds the missing fixed point copy");
+
+    [thePlot didRenderSnapshot:snapshot];
+
+    XCTAssertEqual([thePlot fixedPointNumbersForField:CPTScatterPlotFieldY], yFixedPoint, @"The plot takes over the fixed point copy the snapshot built");
+
+    // a copy built for data the plot has since changed is left behind
+    CPTScatterPlot *nextSnapshot = (CPTScatterPlot *)[thePlot renderSnapshot];
+
+    [thePlot setXValues:@[@0.2, @0.3, @0.4, @0.6, @0.8]];
+
+    id changedFixedPoint = [nextSnapshot fixedPointNumbersForField:CPTScatterPlotFieldX];
+
+    XCTAssertEqual(changedFixedPoint, xFixedPoint, @"Changing the data leaves the snapshot alone");
+
+    [thePlot didRenderSnapshot:nextSnapshot];
+
+    XCTAssertNotEqual([thePlot fixedPointNumbersForField:CPTScatterPlotFieldX], xFixedPoint, @"Fixed point copy of the old data is not taken over");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], 0.2, @"The plot has the changed data");
+}
+
+#pragma mark -
+#pragma mark Streaming
+
+-(void)testStreamingEvictionKeepsDataContiguous
+{
+    self.plot.streamingCapacity = 8;
+    [self.plot setXValues:@[@0.1, @0.9, @0.5, @0.2, @0.3]];
+
+    [self.plot deleteDataInIndexRange:NSMakeRange(0, 2)];
+
+    XCTAssertEqual(self.plot.cachedDataCount, (NSUInteger)3, @"Records remaining after eviction");
+
+    CPTMutableNumericData *xValues = [self.plot cachedNumbersForField:CPTScatterPlotFieldX];
+    XCTAssertEqual(xValues.numberOfSamples, (NSUInteger)3, @"Samples remaining after eviction");
+
+    const double *samples = (const double *)xValues.bytes;
+    XCTAssertEqual(samples[0], 0.5, @"First remaining sample");
+    XCTAssertEqual(samples[1], 0.2, @"Second remaining sample");
+    XCTAssertEqual(samples[2], 0.3, @"Last remaining sample");
+
+    [self.plot deleteDataInIndexRange:NSMakeRange(0, 1)];
+
+    xValues = [self.plot cachedNumbersForField:CPTScatterPlotFieldX];
+    XCTAssertEqual(xValues.numberOfSamples, (NSUInteger)2, @"Samples remaining after second eviction");
+    XCTAssertEqual([self.plot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], 0.2, @"First sample after second eviction");
+    XCTAssertEqual([self.plot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:1], 0.3, @"Last sample after second eviction");
+}
+
+-(void)testStreamingAppendWrapsAroundBuffer
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    CPTPlotTestsStreamingDataSource *streamingSource = [[CPTPlotTestsStreamingDataSource alloc] init];
+
+    streamingSource.recordCount = 4;
+
+    thePlot.plotSpace         = self.plotSpace;
+    thePlot.dataSource        = streamingSource;
+    thePlot.streamingCapacity = 4;
+    thePlot.labelTextStyle    = [CPTTextStyle textStyle];
+    thePlot.labelFormatter    = [[NSNumberFormatter alloc] init];
+    thePlot.labelField        = CPTScatterPlotFieldY;
+    [thePlot reloadData];
+
+    // the buffer holds eight records, so every second append moves the window back to the start
+    for ( NSUInteger step = 0; step < 6; step++ ) {
+        streamingSource.recordCount += 3;
+        [thePlot insertDataAtIndex:thePlot.cachedDataCount numberOfRecords:3];
+
+        XCTAssertEqual(thePlot.cachedDataCount, (NSUInteger)7, @"Records after append %lu", (unsigned long)step);
+
+        [thePlot setNeedsRelabel];
+        [thePlot relabel];
+
+        CPTMutableNumericData *xValues = [thePlot cachedNumbersForField:CPTScatterPlotFieldX];
+        CPTMutableNumericData *yValues = [thePlot cachedNumbersForField:CPTScatterPlotFieldY];
+
+        XCTAssertEqual(xValues.numberOfSamples, (NSUInteger)7, @"x samples after append %lu", (unsigned long)step);
+        XCTAssertEqual(yValues.numberOfSamples, (NSUInteger)7, @"y samples after append %lu", (unsigned long)step);
+        XCTAssertEqual(thePlot.labelAnnotations.count, (NSUInteger)7, @"Labels after append %lu", (unsigned long)step);
+
+        const double *xSamples = (const double *)xValues.bytes;
+        const double *ySamples = (const double *)yValues.bytes;
+
+        for ( NSUInteger i = 0; i < 7; i++ ) {
+            double record = (double)(streamingSource.firstRecord + i);
+
+            XCTAssertEqual(xSamples[i], record, @"x sample %lu after append %lu", (unsigned long)i, (unsigned long)step);
+            XCTAssertEqual(ySamples[i], 10.0 * record, @"y sample %lu after append %lu", (unsigned long)i, (unsigned long)step);
+            XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:i], record, @"Cached x %lu after append %lu", (unsigned long)i, (unsigned long)step);
+            XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldY recordIndex:i], 10.0 * record, @"Cached y %lu after append %lu", (unsigned long)i, (unsigned long)step);
+
+            CPTPlotSpaceAnnotation *label = (CPTPlotSpaceAnnotation *)thePlot.labelAnnotations[i];
+            XCTAssertTrue([label isKindOfClass:[CPTPlotSpaceAnnotation class]], @"Label %lu after append %lu", (unsigned long)i, (unsigned long)step);
+            XCTAssertEqualObjects(((CPTTextLayer *)label.contentLayer).text, [thePlot.labelFormatter stringForObjectValue:@(10.0 * record)], @"Label %lu text after append %lu", (unsigned long)i, (unsigned long)step);
+        }
+
+        streamingSource.firstRecord += 3;
+        streamingSource.recordCount -= 3;
+        [thePlot deleteDataInIndexRange:NSMakeRange(0, 3)];
+
+        XCTAssertEqual(thePlot.cachedDataCount, (NSUInteger)4, @"Records after eviction %lu", (unsigned long)step);
+        XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], (double)streamingSource.firstRecord, @"First x after eviction %lu", (unsigned long)step);
+        XCTAssertEqual(thePlot.labelAnnotations.count, (NSUInteger)4, @"Labels after eviction %lu", (unsigned long)step);
+    }
+}
+
+#pragma mark -
+#pragma mark Scratch arena
+
+-(void)testScratchArenaReusedAcrossFrames
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    [thePlot setXValues:@[@0.1, @0.2, @0.5, @0.7, @0.9]];
+    thePlot.plotSpace = self.plotSpace;
+
+    XCTAssertEqual(thePlot.scratchArenaAllocationCount, (NSUInteger)0, @"No scratch memory before drawing");
+
+    [thePlot indexOfVisiblePointClosestToPlotAreaPoint:CGPointZero];
+
+    NSUInteger allocationCount = thePlot.scratchArenaAllocationCount;
+    XCTAssertGreaterThan(allocationCount, (NSUInteger)0, @"Scratch memory allocated for the first frame");
+    XCTAssertGreaterThan(thePlot.scratchArenaCapacity, (NSUInteger)0, @"Scratch memory held after the first frame");
+
+    for ( NSUInteger i = 0; i < 10; i++ ) {
+        [thePlot setNeedsDisplay];
+        [thePlot indexOfVisiblePointClosestToPlotAreaPoint:CGPointZero];
+    }
+    XCTAssertEqual(thePlot.scratchArenaAllocationCount, allocationCount, @"Later frames reuse the scratch memory");
+
+    [thePlot reloadData];
+    XCTAssertEqual(thePlot.scratchArenaCapacity, (NSUInteger)0, @"Reloading the data releases the scratch memory");
+}
+
+#pragma mark -
+#pragma mark Raster tiles
+
+-(void)testRasterTileCacheRendersOnlyUncoveredTiles
+{
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context       = CGBitmapContextCreate(NULL, 200, 200, 8, 200 * 4, colorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CGColorSpaceRelease(colorSpace);
+
+    _CPTRasterTileCache *tileCache = [[_CPTRasterTileCache alloc] initWithTileSize:CPTFloat(50.0)];
+    CGRect bounds                  = CPTRectMake(0.0, 0.0, 200.0, 200.0);
+    CPTRasterTileRenderer renderer = ^(CGContextRef tileContext) {
+        CGContextFillRect(tileContext, CPTRectMake(0.0, 0.0, 200.0, 200.0));
+    };
+
+    // two points per plot unit, so each tile is 25 units wide and the bounds show 0 to 100
+    CPTRasterTileMapping mapping = { { 0.0, 0.0 }, { 2.0, 2.0 } };
+
+    XCTAssertTrue([tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer]);
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)1, @"The first frame renders every tile in one pass");
+    XCTAssertEqual(tileCache.tileCount, (NSUInteger)16, @"A 4 x 4 grid of tiles covers the bounds");
+
+    [tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer];
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)1, @"An unchanged frame only composites");
+
+    // scroll one tile to the right
+    mapping.offset[0] = -50.0;
+    [tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer];
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)2, @"The column scrolled into view is rendered");
+
+    // and back half a tile, which is still cached
+    mapping.offset[0] = -25.0;
+    [tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer];
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)2, @"Tiles already rendered are reused");
+
+    // zoom in
+    mapping.scale[0] = 4.0;
+    [tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer];
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)2, @"A zoom shows the old tiles first");
+    XCTAssertTrue(tileCache.showsStaleTiles, @"A zoom shows the old tiles first");
+
+    [tileCache removeAllTiles];
+    [tileCache drawInContext:context bounds:bounds mapping:mapping contentsScale:CPTFloat(1.0) renderer:renderer];
+    XCTAssertEqual(tileCache.renderCount, (NSUInteger)3, @"The tiles are rendered again at the new scale");
+    XCTAssertFalse(tileCache.showsStaleTiles, @"The tiles are rendered again at the new scale");
+
+    CGContextRelease(context);
+}
+
+#pragma mark -
+#pragma mark Matrix data
+
+-(void)testMatrixDataLoadsIntoCache
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    thePlot.plotSpace = self.plotSpace;
+
+    const int32_t rows[6] = { 1, 10, 2, 20, 3, 30 };
+
+    CPTPlotTestsMatrixDataSource *matrixSource = [[CPTPlotTestsMatrixDataSource alloc] init];
+
+    matrixSource.matrix = [CPTNumericData numericDataWithData:[NSData dataWithBytes:rows length:sizeof(rows)]
+                                                     dataType:CPTDataType(CPTIntegerDataType, sizeof(int32_t), CFByteOrderGetCurrent())
+                                                        shape:@[@3, @2]
+                                                    dataOrder:CPTDataOrderRowsFirst];
+    thePlot.dataSource = matrixSource;
+    [thePlot reloadData];
+
+    XCTAssertEqual(thePlot.cachedDataCount, (NSUInteger)3, @"Record count");
+    for ( NSUInteger i = 0; i < 3; i++ ) {
+        XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:i], (double)(i + 1), @"Row-major integer x value %lu", (unsigned long)i);
+        XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldY recordIndex:i], (double)(10 * (i + 1)), @"Row-major integer y value %lu", (unsigned long)i);
+    }
+
+    const double columns[6] = { 1.0, 2.0, 3.0, 10.0, 20.0, 30.0 };
+
+    matrixSource.matrix = [CPTNumericData numericDataWithData:[NSMutableData dataWithBytes:columns length:sizeof(columns)]
+                                                     dataType:CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent())
+                                                        shape:@[@3, @2]
+                                                    dataOrder:CPTDataOrderColumnsFirst];
+    [thePlot reloadData];
+
+    const double *sourceSamples = (const double *)matrixSource.matrix.bytes;
+
+    XCTAssertNotEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldX].bytes, sourceSamples, @"Data is copied unless the data source hands it over");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldY recordIndex:2], 30.0, @"Column-major y value");
+
+    matrixSource.adoptsData = YES;
+    [thePlot reloadData];
+
+    XCTAssertEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldX].bytes, sourceSamples, @"Adopted x column is the cache");
+    XCTAssertEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldY].bytes, sourceSamples + 3, @"Adopted y column is the cache");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldY recordIndex:1], 20.0, @"Adopted y value");
+
+    [thePlot cacheNumbers:@[@5.0] forField:CPTScatterPlotFieldX atRecordIndex:0];
+
+    XCTAssertNotEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldX].bytes, sourceSamples, @"Changed column is copied first");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:0], 5.0, @"Changed x value");
+    XCTAssertEqual([thePlot cachedDoubleForField:CPTScatterPlotFieldX recordIndex:1], 2.0, @"Copied x value");
+    XCTAssertEqual(sourceSamples[0], 1.0, @"Data source buffer unchanged");
+    XCTAssertEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldY].bytes, sourceSamples + 3, @"Unchanged column is still adopted");
+
+    [thePlot deleteDataInIndexRange:NSMakeRange(0, 1)];
+
+    XCTAssertNotEqual((const double *)[thePlot cachedNumbersForField:CPTScatterPlotFieldY].bytes, sourceSamples + 3, @"Deleting records copies the adopted column first");
+    XCTAssertEqual(sourceSamples[3], 10.0, @"Data source buffer unchanged");
+    XCTAssertEqual(sourceSamples[4], 20.0, @"Data source buffer unchanged");
+}
+
+#pragma mark -
+#pragma mark Virtualized labels
+
+-(void)testVirtualizedLabelsFollowVisibleRecords
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    [thePlot setXValues:@[@0.1, @2.0, @0.5, @(-3.0), @0.9]];
+    thePlot.plotSpace         = self.plotSpace;
+    thePlot.labelTextStyle    = [CPTTextStyle textStyle];
+    thePlot.virtualizesLabels = YES;
+
+    [thePlot setNeedsRelabel];
+    [thePlot relabel];
+
+    XCTAssertEqual(thePlot.annotations.count, (NSUInteger)3, @"Only records inside the x range are labeled");
+
+    self.plotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@1.5 length:@1.0];
+    [thePlot setNeedsVisibleRelabel];
+    [thePlot relabel];
+
+    XCTAssertEqual(thePlot.annotations.count, (NSUInteger)1, @"Labels follow the x range");
+
+    NSMutableArray *pooledLayers = thePlot.labelLayerPool.allValues.firstObject;
+    XCTAssertEqual(thePlot.labelLayerPool.count, (NSUInteger)1, @"Labels leaving the x range are pooled by style");
+    XCTAssertEqual(pooledLayers.count, (NSUInteger)2, @"Labels leaving the x range are pooled");
+
+    CPTScatterPlot *copiedPlot = [[CPTScatterPlot alloc] initWithLayer:thePlot];
+    XCTAssertEqual(copiedPlot.labelLayerPool.count, (NSUInteger)0, @"Copies do not share the pool");
+
+    // an equal style made by a different object keeps the pooled layers
+    thePlot.labelTextStyle = [CPTTextStyle textStyle];
+    XCTAssertEqual(thePlot.labelLayerPool.count, (NSUInteger)1, @"Equal styles keep the pool");
+}
+
+#pragma mark -
+#pragma mark Hit testing
+
+-(void)testClosestVisiblePointFollowsData
+{
+    CPTScatterPlot *thePlot      = self.plot;
+    CPTXYPlotSpace *thePlotSpace = self.plotSpace;
+    CPTXYGraph *graph            = [[CPTXYGraph alloc] initWithFrame:CPTRectMake(0.0, 0.0, 100.0, 50.0)];
+    CPTNumberArray *yValues      = @[@0.5, @0.5, @0.5, @0.5, @0.5];
+
+    [graph addPlotSpace:thePlotSpace];
+    [graph addPlot:thePlot toPlotSpace:thePlotSpace];
+    [graph layoutIfNeeded];
+
+    [thePlot setXValues:@[@0.1, @0.3, @0.5, @0.7, @0.9]];
+    [thePlot setYValues:yValues];
+
+    CGPoint hitPoint = [thePlotSpace plotAreaViewPointForPlotPoint:@[@0.7, @0.5]];
+
+    XCTAssertEqual([thePlot indexOfVisiblePointClosestToPlotAreaPoint:hitPoint], (NSUInteger)3, @"Closest point is the point under the hit point");
+
+    // a stale index would still answer 3, which now holds the point at 0.5
+    [thePlot setXValues:@[@0.7, @0.1, @0.3, @0.5, @0.9]];
+
+    XCTAssertEqual([thePlot indexOfVisiblePointClosestToPlotAreaPoint:hitPoint], (NSUInteger)0, @"New data replaces the hit test index");
+
+    [thePlot setXValues:@[@(-1.0), @2.0, @(-0.5), @(-3.0), @1.9]];
+
+    XCTAssertEqual([thePlot indexOfVisiblePointClosestToPlotAreaPoint:hitPoint], (NSUInteger)NSNotFound, @"No visible points");
+}
+
+@end
@@ -13,6 +13,9 @@
 #import "CPTUtilities.h"
 #import "CPTPolarPlotSpace.h"
 #import "NSCoderExtensions.h"
+#import "_CPTRangeClassification.h"
+#import "_CPTScratchArena.h"
+#import "_CPTSpatialIndex.h"
 #import <tgmath.h>
 
 /** @defgroup plotAnimationPolarPlot Scatter Plot
@@ -767,163 +770,55 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
         }
     }
     else {
-        CPTPlotRangeComparisonResult *majorRangeFlags = malloc( dataCount * sizeof(CPTPlotRangeComparisonResult) );
-        CPTPlotRangeComparisonResult *minorRangeFlags = malloc( dataCount * sizeof(CPTPlotRangeComparisonResult) );
-        CPTPlotRangeComparisonResult *radialRangeFlags = malloc( dataCount * sizeof(CPTPlotRangeComparisonResult) );
-        BOOL *nanFlags                            = malloc( dataCount * sizeof(BOOL) );
+        CPTRangeClassificationLimits limits[3];
 
-        CPTPlotRange *majorRange = polarPlotSpace.majorRange;
-        CPTPlotRange *minorRange = polarPlotSpace.minorRange;
-        CPTPlotRange *radialRange = polarPlotSpace.radialRange;
+        limits[0] = CPTRangeClassificationLimitsForRange(polarPlotSpace.majorRange);
+        limits[1] = CPTRangeClassificationLimitsForRange(polarPlotSpace.minorRange);
+        limits[2] = CPTRangeClassificationLimitsForRange(polarPlotSpace.radialRange);
 
-        // Determine where each point lies in relation to range
-        if ( self.doublePrecisionCache ) {
-            const double *thetaBytes = (const double *)[self cachedNumbersForField:CPTPolarPlotFieldRadialAngle].data.bytes;
-            const double *radiusBytes = (const double *)[self cachedNumbersForField:CPTPolarPlotFieldRadius].data.bytes;
+        // Ensure that whenever the path crosses over a region boundary, both points
+        // are included. This ensures no lines are left out that shouldn't be.
+        CPTRangeClassificationExpansion expansion = CPTRangeClassificationExpansionNone;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                
-                const double theta = thetaBytes[i];
-                const double radius = radiusBytes[i];
-                const double x = radius * sin(theta);
-                const double y = radius * cos(theta);
-
-                CPTPlotRangeComparisonResult majorFlag = [majorRange compareToDouble:x];
-                CPTPlotRangeComparisonResult minorFlag = [minorRange compareToDouble:y];
-                majorRangeFlags[i] = majorFlag;
-                minorRangeFlags[i] = minorFlag;
-                if ( majorFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    minorRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if x is out of range, then y doesn't matter
-                }
-                if ( minorFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    majorRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if y is out of range, then x doesn't matter
-                }
-                else {
-                    radialRangeFlags[i] = [radialRange compareToDouble:theta];
-                }
-                nanFlags[i] = isnan(x) || isnan(y) || isnan(theta);
-            });
+        if ( !visibleOnly ) {
+            expansion = (self.interpolation == CPTPolarPlotInterpolationCurved) ? CPTRangeClassificationExpansionTwo : CPTRangeClassificationExpansionOne;
         }
-        else {
-            // Determine where each point lies in relation to range
-            const NSDecimal *thetaBytes = (const NSDecimal *)[self cachedNumbersForField:CPTPolarPlotFieldRadialAngle].data.bytes;
-            const NSDecimal *radiusBytes = (const NSDecimal *)[self cachedNumbersForField:CPTPolarPlotFieldRadius].data.bytes;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                
-                NSDecimalNumber *_theta = [NSDecimalNumber decimalNumberWithDecimal:thetaBytes[i]];
-                NSDecimalNumber *_radius = [NSDecimalNumber decimalNumberWithDecimal:radiusBytes[i]];
-                
-                const double x = [_radius doubleValue] * sin([_theta doubleValue]);
-                const double y = [_radius doubleValue] * cos([_theta doubleValue]);
-
-                CPTPlotRangeComparisonResult xFlag = [majorRange compareToDouble:x];
-                CPTPlotRangeComparisonResult yFlag = [minorRange compareToDouble:y];
-                majorRangeFlags[i] = xFlag;
-                minorRangeFlags[i] = yFlag;
-                if ( xFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    minorRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if x is out of range, then y doesn't matter
-                }
-                else if ( yFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    majorRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if y is out of range, then x doesn't matter
+        CPTRangeClassificationState state;
+        CPTRangeClassificationStateInit(&state, expansion, 3);
+
+        BOOL doublePrecision    = self.doublePrecisionCache;
+        const void *thetaBytes  = [self cachedNumbersForField:CPTPolarPlotFieldRadialAngle].data.bytes;
+        const void *radiusBytes = [self cachedNumbersForField:CPTPolarPlotFieldRadius].data.bytes;
+
+        // Determine where each point lies in relation to range, a block at a time
+        double xValues[CPTRangeClassificationBlockSize];
+        double yValues[CPTRangeClassificationBlockSize];
+        double thetaValues[CPTRangeClassificationBlockSize];
+        CPTRegionCode codes[CPTRangeClassificationBlockSize];
+
+        for ( NSUInteger start = 0; start < dataCount; start += CPTRangeClassificationBlockSize ) {
+            size_t blockCount = MIN(dataCount - start, (NSUInteger)CPTRangeClassificationBlockSize);
+
+            for ( size_t i = 0; i < blockCount; i++ ) {
+                double theta, radius;
+                if ( doublePrecision ) {
+                    theta  = ((const double *)thetaBytes)[start + i];
+                    radius = ((const double *)radiusBytes)[start + i];
                 }
                 else {
-                    radialRangeFlags[i] = [radialRange compareToDecimal:thetaBytes[i]];
-                }
-                nanFlags[i] = isnan(x) || isnan(y) || NSDecimalIsNotANumber(&thetaBytes[i]);
-//                CPTPlotRangeComparisonResult xFlag = [majorRange compareToDecimal:x];
-//                majorRangeFlags[i] = xFlag;
-//                if ( xFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-//                    minorRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if x is out of range, then y doesn't matter
-//                }
-//                else {
-//                    minorRangeFlags[i] = [minorRange compareToDecimal:y];
-//                }
-//
-//                nanFlags[i] = NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y);
-            });
-        }
-
-        // Ensure that whenever the path crosses over a region boundary, both points
-        // are included. This ensures no lines are left out that shouldn't be.
-        CPTPolarPlotInterpolation theInterpolation = self.interpolation;
-
-        memset( pointDrawFlags, NO, dataCount * sizeof(BOOL) );
-        if ( dataCount > 0 ) {
-            pointDrawFlags[0] = (majorRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange &&
-                                 minorRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange &&
-                                 radialRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange &&
-                                 !nanFlags[0]);
-        }
-        if ( visibleOnly ) {
-            for ( NSUInteger i = 1; i < dataCount; i++ ) {
-                if ( (majorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                     (minorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                    (radialRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                     !nanFlags[i] ) {
-                    pointDrawFlags[i] = YES;
+                    theta  = CPTDecimalDoubleValue(((const NSDecimal *)thetaBytes)[start + i]);
+                    radius = CPTDecimalDoubleValue(((const NSDecimal *)radiusBytes)[start + i]);
                 }
+                xValues[i]     = radius * sin(theta);
+                yValues[i]     = radius * cos(theta);
+                thetaValues[i] = theta;
             }
-        }
-        else {
-            switch ( theInterpolation ) {
-                case CPTPolarPlotInterpolationCurved:
-                    // Keep 2 points outside of the visible area on each side to maintain the correct curvature of the line
-                    if ( dataCount > 1 ) {
-                        if ( !nanFlags[0] && !nanFlags[1] && ( (majorRangeFlags[0] != majorRangeFlags[1]) || (minorRangeFlags[0] != minorRangeFlags[1]) || (radialRangeFlags[0] != radialRangeFlags[1]) ) ) {
-                            pointDrawFlags[0] = YES;
-                            pointDrawFlags[1] = YES;
-                        }
-                        else if ( (majorRangeFlags[1] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  (minorRangeFlags[1] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (radialRangeFlags[1] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  !nanFlags[1] ) {
-                            pointDrawFlags[1] = YES;
-                        }
-                    }
 
-                    for ( NSUInteger i = 2; i < dataCount; i++ ) {
-                        if ( !nanFlags[i - 2] && !nanFlags[i - 1] && !nanFlags[i] ) {
-                            pointDrawFlags[i - 2] = YES;
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ( !nanFlags[i - 1] && !nanFlags[i] && ( (majorRangeFlags[i - 1] != majorRangeFlags[i]) || (minorRangeFlags[i - 1] != minorRangeFlags[i]) || (radialRangeFlags[i - 1] != radialRangeFlags[i]) ) ) {
-                            pointDrawFlags[i - 2] = YES;
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ( (majorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  (minorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (radialRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  !nanFlags[i] ) {
-                            pointDrawFlags[i] = YES;
-                        }
-                    }
-                    break;
-
-                default:
-                    // Keep 1 point outside of the visible area on each side
-                    for ( NSUInteger i = 1; i < dataCount; i++ ) {
-                        if ( !nanFlags[i - 1] && !nanFlags[i] && ( (majorRangeFlags[i - 1] != majorRangeFlags[i]) || (minorRangeFlags[i - 1] != minorRangeFlags[i]) ) ) {
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ( (majorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  (minorRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (radialRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                  !nanFlags[i] ) {
-                            pointDrawFlags[i] = YES;
-                        }
-                    }
-                    break;
-            }
+            const double *const coordinates[3] = { xValues, yValues, thetaValues };
+            CPTRangeClassificationClassifyDoubles(codes, coordinates, limits, 3, blockCount);
+            CPTRangeClassificationAppendCodes(&state, codes, blockCount, pointDrawFlags);
         }
-
-        free(majorRangeFlags);
-        free(minorRangeFlags);
-        free(radialRangeFlags);
-        free(nanFlags);
     }
 }
 
@@ -1074,31 +969,25 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
  **/
 -(NSUInteger)indexOfVisiblePointClosestToPlotAreaPoint:(CGPoint)viewPoint
 {
-    NSUInteger dataCount = self.cachedDataCount;
-    CGPoint *viewPoints  = calloc( dataCount, sizeof(CGPoint) );
-    BOOL *drawPointFlags = calloc( dataCount, sizeof(BOOL) );
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        NSUInteger dataCount = self.cachedDataCount;
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
 
-    [self calculatePointsToDraw:drawPointFlags forPlotSpace:(id)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+        BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
-    NSInteger result = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
-    if ( result != NSNotFound ) {
-        CGFloat minimumDistanceSquared = CPTNAN;
-        for ( NSUInteger i = (NSUInteger)result; i < dataCount; ++i ) {
-            if ( drawPointFlags[i] ) {
-                CGFloat distanceSquared = squareOfDistanceBetweenPoints(viewPoint, viewPoints[i]);
-                if ( isnan(minimumDistanceSquared) || (distanceSquared < minimumDistanceSquared) ) {
-                    minimumDistanceSquared = distanceSquared;
-                    result                 = (NSInteger)i;
-                }
-            }
-        }
-    }
+        [self calculatePointsToDraw:drawPointFlags forPlotSpace:(id)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
+        [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithPoints:viewPoints flags:drawPointFlags count:dataCount];
 
-    free(viewPoints);
-    free(drawPointFlags);
+        [arena resetToMark:scratchMark];
 
-    return (NSUInteger)result;
+        return newIndex;
+    }];
+
+    return [theIndex indexOfItemClosestToPoint:viewPoint];
 }
 
 /** @brief Returns the plot area view point of a visible point.
@@ -1191,8 +1080,11 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
     [super renderAsVectorInContext:context];
 
     // Calculate view points, and align to user space
-    CGPoint *viewPoints  = malloc( dataCount * sizeof(CGPoint) );
-    BOOL *drawPointFlags = malloc( dataCount * sizeof(BOOL) );
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+    BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
     CPTPolarPlotSpace *thePlotSpace = (CPTPolarPlotSpace *)self.plotSpace;
     [self calculatePointsToDraw:drawPointFlags forPlotSpace:thePlotSpace includeVisiblePointsOnly:NO numberOfPoints:dataCount];
@@ -1454,8 +1346,7 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
         }
     }
 
-    free(viewPoints);
-    free(drawPointFlags);
+    [arena resetToMark:scratchMark];
 }
 
 - (CGPoint)translatedPolarCoordinatesToContextCoordinatesWithFromTheta:(NSDecimal)thetaValue Radius:(NSDecimal)radiusValue
@@ -1568,8 +1459,11 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
     CPTPolarPlotCurvedInterpolationOption interpolationOption = self.curvedInterpolationOption;
 
     if ( lastDrawnPointIndex > 0 ) {
-        CGPoint *controlPoints1 = calloc( lastDrawnPointIndex, sizeof(CGPoint) );
-        CGPoint *controlPoints2 = calloc( lastDrawnPointIndex, sizeof(CGPoint) );
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *controlPoints1 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
+        CGPoint *controlPoints2 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
 
         lastDrawnPointIndex--;
 
@@ -1749,8 +1643,7 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
             CGPathCloseSubpath(dataLinePath);
         }
 
-        free(controlPoints1);
-        free(controlPoints2);
+        [arena resetToMark:scratchMark];
     }
 
     return dataLinePath;
@@ -1998,10 +1891,13 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
         NSUInteger n = indexRange.length - 1;
 
         // rhs vector
-        CGPoint *a = malloc( n * sizeof(CGPoint) );
-        CGPoint *b = malloc( n * sizeof(CGPoint) );
-        CGPoint *c = malloc( n * sizeof(CGPoint) );
-        CGPoint *r = malloc( n * sizeof(CGPoint) );
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *a = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *b = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *c = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *r = [arena allocateCount:n size:sizeof(CGPoint)];
 
         // left most segment
         a[0] = CGPointZero;
@@ -2065,10 +1961,7 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
                                      CPTFloat(0.5) * (viewPoints[rangeEnd].y + cp1[rangeEnd].y) );
 
         // clean up
-        free(a);
-        free(b);
-        free(c);
-        free(r);
+        [arena resetToMark:scratchMark];
     }
 }
 
@@ -2150,8 +2043,11 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
     }
 
     // Calculate view points
-    CGPoint *viewPoints  = malloc( dataCount * sizeof(CGPoint) );
-    BOOL *drawPointFlags = malloc( dataCount * sizeof(BOOL) );
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+    BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
     for ( NSUInteger i = 0; i < dataCount; i++ ) {
         drawPointFlags[i] = YES;
@@ -2162,8 +2058,7 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
     // Create the path
     CGPathRef dataLinePath = [self newDataLinePathForViewPoints:viewPoints indexRange:NSMakeRange(0, dataCount) baselineRadiusValue:CPTNAN centrePoint:CGPointZero];
 
-    free(viewPoints);
-    free(drawPointFlags);
+    [arena resetToMark:scratchMark];
 
     return dataLinePath;
 }
@@ -2666,8 +2561,11 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
     NSUInteger dataCount     = self.cachedDataCount;
 
     if ( theGraph && thePlotArea && !self.hidden && dataCount ) {
-        CGPoint *viewPoints  = malloc( dataCount * sizeof(CGPoint) );
-        BOOL *drawPointFlags = malloc( dataCount * sizeof(BOOL) );
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+        BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
         CPTPolarPlotSpace *thePlotSpace = (CPTPolarPlotSpace *)self.plotSpace;
         [self calculatePointsToDraw:drawPointFlags forPlotSpace:thePlotSpace includeVisiblePointsOnly:NO numberOfPoints:dataCount];
@@ -2699,8 +2597,7 @@ NSString *const CPTPolarPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbo
             CGPathRelease(path);
         }
 
-        free(viewPoints);
-        free(drawPointFlags);
+        [arena resetToMark:scratchMark];
     }
 
     return plotLineHit;
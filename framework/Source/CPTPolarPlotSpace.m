@@ -22,6 +22,13 @@
 typedef NSMutableArray<CPTAnimationOperation *> *CPTMutableAnimationArray;
 
 /// @cond
+@interface CPTPlotSpace()
+
+// private CPTPlotSpace method
+-(nullable CPTPlotArea *)mappedPlotArea;
+
+@end
+
 @interface CPTPolarPlotSpace()
 
 -(CGFloat)viewCoordinateForViewLength:(NSDecimal)viewLength linearPlotRange:(CPTPlotRange *)range plotCoordinateValue:(NSDecimal)plotCoord;
@@ -1134,8 +1141,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     CGPoint viewPoint = [super plotAreaViewPointForPlotPoint:plotPoint];
     
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1179,8 +1185,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     CGPoint viewPoint = [super plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:count];
     
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1229,8 +1234,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     CGPoint viewPoint = [super plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:count];
     
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1275,8 +1279,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     CPTMutableNumberArray *plotPoint = [[super plotPointForPlotAreaViewPoint:point] mutableCopy];
     
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
@@ -1335,8 +1338,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     [super plotPoint:plotPoint numberOfCoordinates:count forPlotAreaViewPoint:point];
     
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
@@ -1394,8 +1396,7 @@ extern CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
     [super doublePrecisionPlotPoint:plotPoint numberOfCoordinates:count forPlotAreaViewPoint:point];
     
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
     
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
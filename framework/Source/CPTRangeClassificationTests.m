@@ -0,0 +1,295 @@
+#import "CPTRangeClassificationTests.h"
+
+#import "CPTUtilities.h"
+#import "_CPTRangeClassification.h"
+
+static const size_t numberOfSamples = 1000;
+
+// the draw flags as CPTScatterPlot worked them out before the classification kernel, one range comparison per sample
+static void CPTRangeClassificationTestsReferenceFlags(BOOL *flags, const double *xValues, const double *yValues, size_t count, CPTPlotRange *xRange, CPTPlotRange *yRange, CPTRangeClassificationExpansion expansion)
+{
+    CPTPlotRangeComparisonResult *xRangeFlags = calloc(count, sizeof(CPTPlotRangeComparisonResult));
+    CPTPlotRangeComparisonResult *yRangeFlags = calloc(count, sizeof(CPTPlotRangeComparisonResult));
+    BOOL *nanFlags                            = calloc(count, sizeof(BOOL));
+
+    for ( size_t i = 0; i < count; i++ ) {
+        CPTPlotRangeComparisonResult xFlag = [xRange compareToDouble:xValues[i]];
+
+        xRangeFlags[i] = xFlag;
+        yRangeFlags[i] = (xFlag != CPTPlotRangeComparisonResultNumberInRange) ? CPTPlotRangeComparisonResultNumberInRange : [yRange compareToDouble:yValues[i]];
+        nanFlags[i]    = isnan(xValues[i]) || isnan(yValues[i]);
+    }
+
+    memset(flags, NO, count * sizeof(BOOL));
+
+#define CPTInRange(i)  ((xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) && (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) && !nanFlags[i])
+#define CPTCrossing(i) (!nanFlags[(i) - 1] && !nanFlags[i] && ((xRangeFlags[(i) - 1] != xRangeFlags[i]) || (yRangeFlags[(i) - 1] != yRangeFlags[i])))
+
+    switch ( expansion ) {
+        case CPTRangeClassificationExpansionNone:
+            for ( size_t i = 0; i < count; i++ ) {
+                flags[i] = CPTInRange(i);
+            }
+            break;
+
+        case CPTRangeClassificationExpansionOne:
+            flags[0] = CPTInRange(0);
+            for ( size_t i = 1; i < count; i++ ) {
+                if ( CPTCrossing(i)) {
+                    flags[i - 1] = YES;
+                    flags[i]     = YES;
+                }
+                else if ( CPTInRange(i)) {
+                    flags[i] = YES;
+                }
+            }
+            break;
+
+        case CPTRangeClassificationExpansionTwo:
+            flags[0] = CPTInRange(0);
+            if ( count > 1 ) {
+                if ( CPTCrossing(1)) {
+                    flags[0] = YES;
+                    flags[1] = YES;
+                }
+                else if ( CPTInRange(1)) {
+                    flags[1] = YES;
+                }
+            }
+            for ( size_t i = 2; i < count; i++ ) {
+                if ((!nanFlags[i - 2] && !nanFlags[i - 1] && !nanFlags[i]) || CPTCrossing(i)) {
+                    flags[i - 2] = YES;
+                    flags[i - 1] = YES;
+                    flags[i]     = YES;
+                }
+                else if ( CPTInRange(i)) {
+                    flags[i] = YES;
+                }
+            }
+            break;
+    }
+
+#undef CPTInRange
+#undef CPTCrossing
+
+    free(xRangeFlags);
+    free(yRangeFlags);
+    free(nanFlags);
+}
+
+@interface CPTRangeClassificationTests()
+
+@property (nonatomic, readwrite, strong, nonnull) CPTPlotRange *xRange;
+@property (nonatomic, readwrite, strong, nonnull) CPTPlotRange *yRange;
+
+-(void)fillXValues:(nonnull double *)xValues yValues:(nonnull double *)yValues;
+
+@end
+
+#pragma mark -
+
+@implementation CPTRangeClassificationTests
+
+@synthesize xRange;
+@synthesize yRange;
+
+-(void)setUp
+{
+    self.xRange = [CPTPlotRange plotRangeWithLocation:@(-1.0) length:@2.0];
+    self.yRange = [CPTPlotRange plotRangeWithLocation:@(-1.0) length:@2.0];
+}
+
+// sixteenths, so every value is exact as an NSDecimal and the range limits themselves come up
+-(void)fillXValues:(nonnull double *)xValues yValues:(nonnull double *)yValues
+{
+    for ( size_t i = 0; i < numberOfSamples; i++ ) {
+        xValues[i] = (i % 37 == 0) ? (double)NAN : (double)((i * 7) % 41) / 16.0 - 1.25;
+        yValues[i] = (i % 53 == 5) ? (double)NAN : (double)((i * 11) % 43) / 16.0 - 1.3125;
+    }
+}
+
+#pragma mark -
+#pragma mark Region codes
+
+-(void)testRegionCodes
+{
+    const double xValues[]                    = { 0.0, -2.0, 2.0, 0.0, 0.0, NAN, -2.0, 1.0, -1.0 };
+    const double yValues[]                    = { 0.0, 0.0, 5.0, -2.0, 2.0, 0.0, NAN, 1.0, -1.0 };
+    const double *const coordinates[2]        = { xValues, yValues };
+    const CPTRangeClassificationLimits limits[2] = {
+        CPTRangeClassificationLimitsForRange(self.xRange),
+        CPTRangeClassificationLimitsForRange(self.yRange)
+    };
+
+    const CPTRegionCode below = CPTPlotRangeComparisonResultNumberBelowRange;
+    const CPTRegionCode in    = CPTPlotRangeComparisonResultNumberInRange;
+    const CPTRegionCode above = CPTPlotRangeComparisonResultNumberAboveRange;
+
+    const size_t count = sizeof(xValues) / sizeof(double);
+
+    CPTRegionCode codes[count];
+
+    CPTRangeClassificationClassifyDoubles(codes, coordinates, limits, 2, count);
+
+    XCTAssertEqual(codes[0], (CPTRegionCode)(in | in << 2), @"in range");
+    XCTAssertEqual(codes[1], (CPTRegionCode)(below | in << 2), @"x below range");
+    XCTAssertEqual(codes[2], (CPTRegionCode)(above | in << 2), @"y ignored once x is out of range");
+    XCTAssertEqual(codes[3], (CPTRegionCode)(in | below << 2), @"y below range");
+    XCTAssertEqual(codes[4], (CPTRegionCode)(in | above << 2), @"y above range");
+    XCTAssertTrue(codes[5] & CPTRegionCodeNaN, @"undefined x");
+    XCTAssertTrue(codes[6] & CPTRegionCodeNaN, @"undefined y after an out of range x");
+    XCTAssertEqual(codes[7], (CPTRegionCode)(in | in << 2), @"upper limits are in range");
+    XCTAssertEqual(codes[8], (CPTRegionCode)(in | in << 2), @"lower limits are in range");
+
+    for ( size_t i = 0; i < count; i++ ) {
+        CPTPlotRangeComparisonResult comparisons[2];
+
+        comparisons[0] = [self.xRange compareToDouble:xValues[i]];
+        comparisons[1] = [self.yRange compareToDouble:yValues[i]];
+
+        CPTRegionCode code = CPTRangeClassificationCodeForComparisons(comparisons, 2);
+
+        if ( code & CPTRegionCodeNaN ) {
+            XCTAssertTrue(codes[i] & CPTRegionCodeNaN, @"sample %lu undefined either way", (unsigned long)i);
+        }
+        else {
+            XCTAssertEqual(code, codes[i], @"sample %lu classified the same from comparison results", (unsigned long)i);
+        }
+    }
+}
+
+-(void)testMissingRangeIsBelow
+{
+    const double values[]                     = { -1.0e300, 0.0, 1.0e300 };
+    const double *const coordinates[1]        = { values };
+    const CPTRangeClassificationLimits limits = CPTRangeClassificationLimitsForRange(nil);
+
+    CPTRegionCode codes[3];
+
+    CPTRangeClassificationClassifyDoubles(codes, coordinates, &limits, 1, 3);
+
+    for ( size_t i = 0; i < 3; i++ ) {
+        XCTAssertEqual(codes[i], (CPTRegionCode)CPTPlotRangeComparisonResultNumberBelowRange, @"sample %lu", (unsigned long)i);
+    }
+}
+
+#pragma mark -
+#pragma mark Neighbour expansion
+
+-(void)testNaNSamplesBreakCrossings
+{
+    // in, NaN, out of range, in
+    const double xValues[] = { 0.0, NAN, 2.0, 0.0 };
+    const double yValues[] = { 0.0, 0.0, 0.0, 0.0 };
+
+    BOOL flags[4];
+
+    CPTRangeClassificationFlagPoints(flags, xValues, yValues, 4,
+                                     CPTRangeClassificationLimitsForRange(self.xRange),
+                                     CPTRangeClassificationLimitsForRange(self.yRange),
+                                     CPTRangeClassificationExpansionOne);
+
+    XCTAssertTrue(flags[0], @"in range");
+    XCTAssertFalse(flags[1], @"undefined sample");
+    XCTAssertTrue(flags[2], @"kept for the crossing into the range");
+    XCTAssertTrue(flags[3], @"in range");
+
+    CPTRangeClassificationFlagPoints(flags, xValues, yValues, 3,
+                                     CPTRangeClassificationLimitsForRange(self.xRange),
+                                     CPTRangeClassificationLimitsForRange(self.yRange),
+                                     CPTRangeClassificationExpansionOne);
+
+    XCTAssertFalse(flags[2], @"no crossing next to an undefined sample");
+}
+
+-(void)testOnePointExpansion
+{
+    // in, in, above, above, above, in
+    const double xValues[] = { 0.0, 0.5, 1.5, 2.0, 2.5, 0.5 };
+    const double yValues[] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    const BOOL expected[]  = { YES, YES, YES, NO, YES, YES };
+
+    BOOL flags[6];
+
+    CPTRangeClassificationFlagPoints(flags, xValues, yValues, 6,
+                                     CPTRangeClassificationLimitsForRange(self.xRange),
+                                     CPTRangeClassificationLimitsForRange(self.yRange),
+                                     CPTRangeClassificationExpansionOne);
+
+    for ( size_t i = 0; i < 6; i++ ) {
+        XCTAssertEqual(flags[i], expected[i], @"sample %lu", (unsigned long)i);
+    }
+}
+
+-(void)testExpansionsMatchRangeComparisons
+{
+    double *xValues = calloc(numberOfSamples, sizeof(double));
+    double *yValues = calloc(numberOfSamples, sizeof(double));
+    BOOL *flags     = calloc(numberOfSamples, sizeof(BOOL));
+    BOOL *expected  = calloc(numberOfSamples, sizeof(BOOL));
+
+    [self fillXValues:xValues yValues:yValues];
+
+    const CPTRangeClassificationExpansion expansions[] = { CPTRangeClassificationExpansionNone, CPTRangeClassificationExpansionOne, CPTRangeClassificationExpansionTwo };
+
+    for ( NSUInteger e = 0; e < 3; e++ ) {
+        // more samples than one block, so the expansion carries across block boundaries
+        CPTRangeClassificationFlagPoints(flags, xValues, yValues, numberOfSamples,
+                                         CPTRangeClassificationLimitsForRange(self.xRange),
+                                         CPTRangeClassificationLimitsForRange(self.yRange),
+                                         expansions[e]);
+        CPTRangeClassificationTestsReferenceFlags(expected, xValues, yValues, numberOfSamples, self.xRange, self.yRange, expansions[e]);
+
+        for ( size_t i = 0; i < numberOfSamples; i++ ) {
+            XCTAssertEqual(flags[i], expected[i], @"expansion %lu, sample %lu", (unsigned long)e, (unsigned long)i);
+        }
+    }
+
+    free(xValues);
+    free(yValues);
+    free(flags);
+    free(expected);
+}
+
+#pragma mark -
+#pragma mark NSDecimal
+
+-(void)testDecimalPointsMatchDoublePoints
+{
+    double *xValues      = calloc(numberOfSamples, sizeof(double));
+    double *yValues      = calloc(numberOfSamples, sizeof(double));
+    NSDecimal *xDecimals = calloc(numberOfSamples, sizeof(NSDecimal));
+    NSDecimal *yDecimals = calloc(numberOfSamples, sizeof(NSDecimal));
+    BOOL *flags          = calloc(numberOfSamples, sizeof(BOOL));
+    BOOL *decimalFlags   = calloc(numberOfSamples, sizeof(BOOL));
+
+    [self fillXValues:xValues yValues:yValues];
+
+    for ( size_t i = 0; i < numberOfSamples; i++ ) {
+        xDecimals[i] = isnan(xValues[i]) ? CPTDecimalNaN() : CPTDecimalFromDouble(xValues[i]);
+        yDecimals[i] = isnan(yValues[i]) ? CPTDecimalNaN() : CPTDecimalFromDouble(yValues[i]);
+    }
+
+    const CPTRangeClassificationExpansion expansions[] = { CPTRangeClassificationExpansionNone, CPTRangeClassificationExpansionOne, CPTRangeClassificationExpansionTwo };
+
+    for ( NSUInteger e = 0; e < 3; e++ ) {
+        CPTRangeClassificationFlagPoints(flags, xValues, yValues, numberOfSamples,
+                                         CPTRangeClassificationLimitsForRange(self.xRange),
+                                         CPTRangeClassificationLimitsForRange(self.yRange),
+                                         expansions[e]);
+        CPTRangeClassificationFlagDecimalPoints(decimalFlags, xDecimals, yDecimals, numberOfSamples, self.xRange, self.yRange, expansions[e]);
+
+        for ( size_t i = 0; i < numberOfSamples; i++ ) {
+            XCTAssertEqual(decimalFlags[i], flags[i], @"expansion %lu, sample %lu", (unsigned long)e, (unsigned long)i);
+        }
+    }
+
+    free(xValues);
+    free(yValues);
+    free(xDecimals);
+    free(yDecimals);
+    free(flags);
+    free(decimalFlags);
+}
+
+@end
@@ -14,6 +14,10 @@
 #import "CPTXYPlotSpace.h"
 #import "NSCoderExtensions.h"
 #import "NSNumberExtensions.h"
+#import "_CPTFixedPointNumbers.h"
+#import "_CPTRangeClassification.h"
+#import "_CPTScratchArena.h"
+#import "_CPTSpatialIndex.h"
 #import <tgmath.h>
 
 /** @defgroup plotAnimationRangePlot Range Plot
@@ -48,6 +52,34 @@ struct CGPointError {
 };
 typedef struct CGPointError CGPointError;
 
+// Pixel alignment of one view coordinate for a context without rotation or skew, where device
+// coordinates are scale * coordinate + offset. Gives the same result as CPTAlignPointToUserSpace
+// (before = 0.5, after = 0.5 in x; before = 0.0, after = -0.5 and roundsUp in y) and
+// CPTAlignIntegralPointToUserSpace (before = 0.0, after = 0.0 in x; before = 0.5, after = 0.0 and roundsUp in y).
+typedef struct {
+    CGFloat scale;
+    CGFloat offset;
+    CGFloat before;
+    CGFloat after;
+    BOOL roundsUp;
+} CPTRangePlotAxisAlignment;
+
+static inline CGFloat CPTRangePlotAlignCoordinate(CGFloat coordinate, const CPTRangePlotAxisAlignment *alignment)
+{
+    CGFloat device = coordinate * alignment->scale + alignment->offset - alignment->before;
+
+    device = (alignment->roundsUp ? ceil(device) : round(device)) + alignment->after;
+
+    return (device - alignment->offset) / alignment->scale;
+}
+
+@interface CPTPlot()
+
+// private CPTPlot methods
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot;
+
+@end
+
 @interface CPTRangePlot()
 
 @property (nonatomic, readwrite, copy, nullable) CPTNumberArray *xValues;
@@ -59,10 +91,16 @@ typedef struct CGPointError CGPointError;
 @property (nonatomic, readwrite, copy, nullable) CPTLineStyleArray *barLineStyles;
 @property (nonatomic, readwrite, copy, nullable) CPTLineStyleArray *barWidths;
 @property (nonatomic, readwrite, assign) NSUInteger pointingDeviceDownIndex;
+@property (nonatomic, readwrite, strong, nullable) NSMutableData *frameViewPointData;
+@property (nonatomic, readwrite, strong, nullable) NSMutableData *frameDrawPointFlagData;
+@property (nonatomic, readwrite, assign) CGRect frameBounds;
+@property (nonatomic, readwrite, assign) NSUInteger frameGeometryGeneration;
 
 -(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags numberOfPoints:(NSUInteger)dataCount forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace;
--(void)calculateViewPoints:(nonnull CGPointError *)viewPoints withDrawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount;
--(void)alignViewPointsToUserSpace:(nonnull CGPointError *)viewPoints withContext:(nonnull CGContextRef)context drawPointFlags:(nonnull BOOL *)drawPointFlag numberOfPoints:(NSUInteger)dataCounts;
+-(nullable const double *)doubleValuesForField:(NSUInteger)fieldEnum numberOfPoints:(NSUInteger)dataCount scratchArena:(nonnull _CPTScratchArena *)arena;
+-(void)calculateViewPoints:(nonnull CGPointError *)viewPoints alignedViewPoints:(nullable CGPointError *)alignedViewPoints inContext:(nullable CGContextRef)context withDrawPointFlags:(nonnull const BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount;
+-(void)cacheFrameGeometryWithAlignedViewPoints:(nullable CGPointError *)alignedViewPoints inContext:(nullable CGContextRef)context;
+-(BOOL)hasCurrentFrameGeometry;
 -(NSInteger)extremeDrawnPointIndexForFlags:(nonnull BOOL *)pointDrawFlags numberOfPoints:(NSUInteger)dataCount extremeNumIsLowerBound:(BOOL)isLowerBound;
 
 -(void)drawRangeInContext:(nonnull CGContextRef)context lineStyle:(nonnull CPTLineStyle *)lineStyle viewPoint:(CGPointError *)viewPoint halfGapSize:(CGSize)halfGapSize halfBarWidth:(CGFloat)halfBarWidth alignPoints:(BOOL)alignPoints;
@@ -144,6 +182,30 @@ typedef struct CGPointError CGPointError;
  **/
 @synthesize pointingDeviceDownIndex;
 
+/** @internal
+ *  @property nullable NSMutableData *frameViewPointData
+ *  @brief The view points of every record, before pixel alignment, from the last time the plot was drawn.
+ **/
+@synthesize frameViewPointData;
+
+/** @internal
+ *  @property nullable NSMutableData *frameDrawPointFlagData
+ *  @brief The draw flags of every record that go with @ref frameViewPointData.
+ **/
+@synthesize frameDrawPointFlagData;
+
+/** @internal
+ *  @property CGRect frameBounds
+ *  @brief The bounds of the plot when @ref frameViewPointData was calculated, or @ref CGRectNull once the plot has changed since.
+ **/
+@synthesize frameBounds;
+
+/** @internal
+ *  @property NSUInteger frameGeometryGeneration
+ *  @brief Counts the changes that make @ref frameViewPointData stale, so the geometry of a render snapshot is only taken back while it is current.
+ **/
+@synthesize frameGeometryGeneration;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -200,6 +262,11 @@ typedef struct CGPointError CGPointError;
 
         pointingDeviceDownIndex = NSNotFound;
 
+        frameViewPointData      = nil;
+        frameDrawPointFlagData  = nil;
+        frameBounds             = CGRectZero;
+        frameGeometryGeneration = 0;
+
         self.labelField = CPTRangePlotFieldX;
     }
     return self;
@@ -223,6 +290,12 @@ typedef struct CGPointError CGPointError;
         gapWidth            = theLayer->gapWidth;
 
         pointingDeviceDownIndex = NSNotFound;
+
+        // a render snapshot works out its own geometry and hands it back in -didRenderSnapshot:
+        frameViewPointData      = nil;
+        frameDrawPointFlagData  = nil;
+        frameBounds             = CGRectZero;
+        frameGeometryGeneration = theLayer->frameGeometryGeneration;
     }
     return self;
 }
@@ -248,6 +321,9 @@ typedef struct CGPointError CGPointError;
 
     // No need to archive these properties:
     // pointingDeviceDownIndex
+    // frameViewPointData
+    // frameDrawPointFlagData
+    // frameBounds
 }
 
 -(nullable instancetype)initWithCoder:(nonnull NSCoder *)coder
@@ -265,6 +341,11 @@ typedef struct CGPointError CGPointError;
                                                    forKey:@"CPTRangePlot.areaBorderLineStyle"] copy];
 
         pointingDeviceDownIndex = NSNotFound;
+
+        frameViewPointData      = nil;
+        frameDrawPointFlagData  = nil;
+        frameBounds             = CGRectZero;
+        frameGeometryGeneration = 0;
     }
     return self;
 }
@@ -301,10 +382,6 @@ typedef struct CGPointError CGPointError;
         }
     }
     else {
-        CPTPlotRangeComparisonResult *xRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-        CPTPlotRangeComparisonResult *yRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-        BOOL *nanFlags                            = calloc(dataCount, sizeof(BOOL));
-
         CPTPlotRange *xRange = xyPlotSpace.xRange;
         CPTPlotRange *yRange = xyPlotSpace.yRange;
 
@@ -313,220 +390,229 @@ typedef struct CGPointError CGPointError;
             const double *xBytes = (const double *)[self cachedNumbersForField:CPTRangePlotFieldX].data.bytes;
             const double *yBytes = (const double *)[self cachedNumbersForField:CPTRangePlotFieldY].data.bytes;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                const double x = xBytes[i];
-                const double y = yBytes[i];
-
-                xRangeFlags[i] = [xRange compareToDouble:x];
-                yRangeFlags[i] = [yRange compareToDouble:y];
-                nanFlags[i]    = isnan(x) || isnan(y);
-            });
+            CPTRangeClassificationFlagPoints(pointDrawFlags, xBytes, yBytes, dataCount,
+                                             CPTRangeClassificationLimitsForRange(xRange),
+                                             CPTRangeClassificationLimitsForRange(yRange),
+                                             CPTRangeClassificationExpansionNone);
         }
         else {
             const NSDecimal *xBytes = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldX].data.bytes;
             const NSDecimal *yBytes = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldY].data.bytes;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                const NSDecimal x = xBytes[i];
-                const NSDecimal y = yBytes[i];
+            _CPTFixedPointNumbers *xFixedPoint = [self fixedPointNumbersForField:CPTRangePlotFieldX];
+            _CPTFixedPointNumbers *yFixedPoint = [self fixedPointNumbersForField:CPTRangePlotFieldY];
 
-                xRangeFlags[i] = [xRange compareToDecimal:x];
-                yRangeFlags[i] = [yRange compareToDecimal:y];
-                nanFlags[i]    = NSDecimalIsNotANumber(&x);
-            });
-        }
-
-        for ( NSUInteger i = 0; i < dataCount; i++ ) {
-            BOOL drawPoint = (xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                             (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                             !nanFlags[i];
+            CPTRangeClassificationFixedPointLimits xLimits;
+            CPTRangeClassificationFixedPointLimits yLimits;
 
-            pointDrawFlags[i] = drawPoint;
+            if ((xFixedPoint.count >= dataCount) && (yFixedPoint.count >= dataCount) &&
+                [xFixedPoint getLimits:&xLimits forRange:xRange] && [yFixedPoint getLimits:&yLimits forRange:yRange] ) {
+                CPTRangeClassificationFlagFixedPointPoints(pointDrawFlags, xFixedPoint.values, yFixedPoint.values, xBytes, yBytes, dataCount,
+                                                           xLimits, yLimits, xRange, yRange, CPTRangeClassificationExpansionNone);
+            }
+            else {
+                CPTRangeClassificationFlagDecimalPoints(pointDrawFlags, xBytes, yBytes, dataCount, xRange, yRange, CPTRangeClassificationExpansionNone);
+            }
         }
-
-        free(xRangeFlags);
-        free(yRangeFlags);
-        free(nanFlags);
     }
 }
 
--(void)calculateViewPoints:(nonnull CGPointError *)viewPoints withDrawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount
+-(nullable const double *)doubleValuesForField:(NSUInteger)fieldEnum numberOfPoints:(NSUInteger)dataCount scratchArena:(nonnull _CPTScratchArena *)arena
 {
-    CPTPlotSpace *thePlotSpace = self.plotSpace;
-
-    // Calculate points
-    if ( self.doublePrecisionCache ) {
-        const double *xBytes     = (const double *)[self cachedNumbersForField:CPTRangePlotFieldX].data.bytes;
-        const double *yBytes     = (const double *)[self cachedNumbersForField:CPTRangePlotFieldY].data.bytes;
-        const double *highBytes  = (const double *)[self cachedNumbersForField:CPTRangePlotFieldHigh].data.bytes;
-        const double *lowBytes   = (const double *)[self cachedNumbersForField:CPTRangePlotFieldLow].data.bytes;
-        const double *leftBytes  = (const double *)[self cachedNumbersForField:CPTRangePlotFieldLeft].data.bytes;
-        const double *rightBytes = (const double *)[self cachedNumbersForField:CPTRangePlotFieldRight].data.bytes;
-
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x     = xBytes[i];
-            const double y     = yBytes[i];
-            const double high  = highBytes[i];
-            const double low   = lowBytes[i];
-            const double left  = leftBytes[i];
-            const double right = rightBytes[i];
-            if ( !drawPointFlags[i] || isnan(x) || isnan(y)) {
-                viewPoints[i].x = CPTNAN; // depending coordinates
-                viewPoints[i].y = CPTNAN;
-            }
-            else {
-                double plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
-                CGPoint pos               = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].x           = pos.x;
-                viewPoints[i].y           = pos.y;
-
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y + high;
-                pos                       = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].high        = pos.y;
-
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y - low;
-                pos                       = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].low         = pos.y;
-
-                plotPoint[CPTCoordinateX] = x - left;
-                plotPoint[CPTCoordinateY] = y;
-                pos                       = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].left        = pos.x;
-
-                plotPoint[CPTCoordinateX] = x + right;
-                plotPoint[CPTCoordinateY] = y;
-                pos                       = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].right       = pos.x;
-            }
-        });
+    CPTMutableNumericData *numbers = [self cachedNumbersForField:fieldEnum];
+    NSUInteger sampleCount         = MIN(numbers.numberOfSamples, dataCount);
+    BOOL doublePrecision           = self.doublePrecisionCache;
+
+    if ( doublePrecision && (sampleCount == dataCount)) {
+        // read the cache in place
+        return (const double *)numbers.data.bytes;
+    }
+
+    _CPTFixedPointNumbers *fixedPoint = doublePrecision ? nil : [self fixedPointNumbersForField:fieldEnum];
+
+    double *values = [arena allocateCount:MAX(dataCount, fixedPoint.count) size:sizeof(double)];
+
+    if ( doublePrecision ) {
+        memcpy(values, numbers.data.bytes, sampleCount * sizeof(double));
+    }
+    else if ( fixedPoint.count >= dataCount ) {
+        [fixedPoint getDoubles:values decimals:(const NSDecimal *)numbers.data.bytes];
     }
     else {
-        const NSDecimal *xBytes     = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldX].data.bytes;
-        const NSDecimal *yBytes     = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldY].data.bytes;
-        const NSDecimal *highBytes  = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldHigh].data.bytes;
-        const NSDecimal *lowBytes   = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldLow].data.bytes;
-        const NSDecimal *leftBytes  = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldLeft].data.bytes;
-        const NSDecimal *rightBytes = (const NSDecimal *)[self cachedNumbersForField:CPTRangePlotFieldRight].data.bytes;
-
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const NSDecimal x     = xBytes[i];
-            const NSDecimal y     = yBytes[i];
-            const NSDecimal high  = highBytes[i];
-            const NSDecimal low   = lowBytes[i];
-            const NSDecimal left  = leftBytes[i];
-            const NSDecimal right = rightBytes[i];
-
-            if ( !drawPointFlags[i] || NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y)) {
-                viewPoints[i].x = CPTNAN; // depending coordinates
-                viewPoints[i].y = CPTNAN;
-            }
-            else {
-                NSDecimal plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
-                CGPoint pos               = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].x           = pos.x;
-                viewPoints[i].y           = pos.y;
-
-                if ( !NSDecimalIsNotANumber(&high)) {
-                    plotPoint[CPTCoordinateX] = x;
-                    NSDecimal yh;
-                    NSDecimalAdd(&yh, &y, &high, NSRoundPlain);
-                    plotPoint[CPTCoordinateY] = yh;
-                    pos                       = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-                    viewPoints[i].high        = pos.y;
-                }
-                else {
-                    viewPoints[i].high = CPTNAN;
-                }
+        const NSDecimal *decimals = (const NSDecimal *)numbers.data.bytes;
 
-                if ( !NSDecimalIsNotANumber(&low)) {
-                    plotPoint[CPTCoordinateX] = x;
-                    NSDecimal yl;
-                    NSDecimalSubtract(&yl, &y, &low, NSRoundPlain);
-                    plotPoint[CPTCoordinateY] = yl;
-                    pos                       = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-                    viewPoints[i].low         = pos.y;
-                }
-                else {
-                    viewPoints[i].low = CPTNAN;
-                }
+        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+            values[i] = CPTDecimalDoubleValue(decimals[i]);
+        }
+    }
 
-                if ( !NSDecimalIsNotANumber(&left)) {
-                    NSDecimal xl;
-                    NSDecimalSubtract(&xl, &x, &left, NSRoundPlain);
-                    plotPoint[CPTCoordinateX] = xl;
-                    plotPoint[CPTCoordinateY] = y;
-                    pos                       = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-                    viewPoints[i].left        = pos.x;
-                }
-                else {
-                    viewPoints[i].left = CPTNAN;
-                }
-                if ( !NSDecimalIsNotANumber(&right)) {
-                    NSDecimal xr;
-                    NSDecimalAdd(&xr, &x, &right, NSRoundPlain);
-                    plotPoint[CPTCoordinateX] = xr;
-                    plotPoint[CPTCoordinateY] = y;
-                    pos                       = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-                    viewPoints[i].right       = pos.x;
-                }
-                else {
-                    viewPoints[i].right = CPTNAN;
-                }
-            }
-        });
+    // records missing from a short cache have no value
+    for ( NSUInteger i = sampleCount; i < dataCount; i++ ) {
+        values[i] = (double)NAN;
     }
+
+    return values;
 }
 
--(void)alignViewPointsToUserSpace:(nonnull CGPointError *)viewPoints withContext:(nonnull CGContextRef)context drawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount
+-(void)calculateViewPoints:(nonnull CGPointError *)viewPoints alignedViewPoints:(nullable CGPointError *)alignedViewPoints inContext:(nullable CGContextRef)context withDrawPointFlags:(nonnull const BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount
 {
+    if ( dataCount == 0 ) {
+        return;
+    }
+
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    // Read every column once, as doubles
+    const double *xBytes     = [self doubleValuesForField:CPTRangePlotFieldX numberOfPoints:dataCount scratchArena:arena];
+    const double *yBytes     = [self doubleValuesForField:CPTRangePlotFieldY numberOfPoints:dataCount scratchArena:arena];
+    const double *highBytes  = [self doubleValuesForField:CPTRangePlotFieldHigh numberOfPoints:dataCount scratchArena:arena];
+    const double *lowBytes   = [self doubleValuesForField:CPTRangePlotFieldLow numberOfPoints:dataCount scratchArena:arena];
+    const double *leftBytes  = [self doubleValuesForField:CPTRangePlotFieldLeft numberOfPoints:dataCount scratchArena:arena];
+    const double *rightBytes = [self doubleValuesForField:CPTRangePlotFieldRight numberOfPoints:dataCount scratchArena:arena];
+
+    // The x and y view coordinates of an XY plot space are independent of each other, so each bar end
+    // can share a plot point with one of the other axis: (x - left, y + high) gives the left and high
+    // view coordinates and (x + right, y - low) the right and low ones. All three points of every record
+    // then go through the plot space in a single call.
+    NSUInteger pointCount = 3 * dataCount;
+
+    double *plotXValues = [arena allocateCount:pointCount size:sizeof(double)];
+    double *plotYValues = [arena allocateCount:pointCount size:sizeof(double)];
+    CGPoint *positions  = [arena allocateCount:pointCount size:sizeof(CGPoint)];
+
+    double *leftHighXValues = plotXValues + dataCount;
+    double *leftHighYValues = plotYValues + dataCount;
+    double *rightLowXValues = plotXValues + 2 * dataCount;
+    double *rightLowYValues = plotYValues + 2 * dataCount;
+
+    for ( NSUInteger i = 0; i < dataCount; i++ ) {
+        const double x = xBytes[i];
+        const double y = yBytes[i];
+
+        plotXValues[i]     = x;
+        plotYValues[i]     = y;
+        leftHighXValues[i] = x - leftBytes[i];
+        leftHighYValues[i] = y + highBytes[i];
+        rightLowXValues[i] = x + rightBytes[i];
+        rightLowYValues[i] = y - lowBytes[i];
+    }
+
+    [self.plotSpace plotAreaViewPoints:positions forDoublePrecisionXValues:plotXValues yValues:plotYValues numberOfPoints:pointCount];
+
     // Align to device pixels if there is a data line.
     // Otherwise, align to view space, so fills are sharp at edges.
-    if ( self.barLineStyle.lineWidth > CPTFloat(0.0)) {
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            if ( drawPointFlags[i] ) {
-                CGFloat x       = viewPoints[i].x;
-                CGFloat y       = viewPoints[i].y;
-                CGPoint pos     = CPTAlignPointToUserSpace(context, CPTPointMake(viewPoints[i].x, viewPoints[i].y));
-                viewPoints[i].x = pos.x;
-                viewPoints[i].y = pos.y;
-
-                pos                 = CPTAlignPointToUserSpace(context, CPTPointMake(x, viewPoints[i].high));
-                viewPoints[i].high  = pos.y;
-                pos                 = CPTAlignPointToUserSpace(context, CPTPointMake(x, viewPoints[i].low));
-                viewPoints[i].low   = pos.y;
-                pos                 = CPTAlignPointToUserSpace(context, CPTPointMake(viewPoints[i].left, y));
-                viewPoints[i].left  = pos.x;
-                pos                 = CPTAlignPointToUserSpace(context, CPTPointMake(viewPoints[i].right, y));
-                viewPoints[i].right = pos.x;
-            }
-        });
+    BOOL alignsLines = (self.barLineStyle.lineWidth > CPTFloat(0.0));
+
+    CGPoint (*alignPoint)(CGContextRef, CGPoint) = alignsLines ? CPTAlignPointToUserSpace : CPTAlignIntegralPointToUserSpace;
+
+    CPTRangePlotAxisAlignment xAlignment = { CPTFloat(1.0), CPTFloat(0.0), CPTFloat(0.0), CPTFloat(0.0), NO };
+    CPTRangePlotAxisAlignment yAlignment = { CPTFloat(1.0), CPTFloat(0.0), CPTFloat(0.0), CPTFloat(0.0), YES };
+    BOOL separableAlignment              = NO;
+
+    if ( alignedViewPoints && context ) {
+        CGAffineTransform deviceTransform = CGContextGetUserSpaceToDeviceSpaceTransform(context);
+
+        // without rotation or skew each coordinate can be aligned on its own
+        separableAlignment = (deviceTransform.b == CPTFloat(0.0)) && (deviceTransform.c == CPTFloat(0.0)) &&
+                             (deviceTransform.a != CPTFloat(0.0)) && (deviceTransform.d != CPTFloat(0.0));
+
+        xAlignment.scale  = deviceTransform.a;
+        xAlignment.offset = deviceTransform.tx;
+        xAlignment.before = alignsLines ? CPTFloat(0.5) : CPTFloat(0.0);
+        xAlignment.after  = alignsLines ? CPTFloat(0.5) : CPTFloat(0.0);
+
+        yAlignment.scale  = deviceTransform.d;
+        yAlignment.offset = deviceTransform.ty;
+        yAlignment.before = alignsLines ? CPTFloat(0.0) : CPTFloat(0.5);
+        yAlignment.after  = alignsLines ? CPTFloat(-0.5) : CPTFloat(0.0);
     }
-    else {
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            if ( drawPointFlags[i] ) {
-                CGFloat x       = viewPoints[i].x;
-                CGFloat y       = viewPoints[i].y;
-                CGPoint pos     = CPTAlignIntegralPointToUserSpace(context, CPTPointMake(viewPoints[i].x, viewPoints[i].y));
-                viewPoints[i].x = pos.x;
-                viewPoints[i].y = pos.y;
-
-                pos                 = CPTAlignIntegralPointToUserSpace(context, CPTPointMake(x, viewPoints[i].high));
-                viewPoints[i].high  = pos.y;
-                pos                 = CPTAlignIntegralPointToUserSpace(context, CPTPointMake(x, viewPoints[i].low));
-                viewPoints[i].low   = pos.y;
-                pos                 = CPTAlignIntegralPointToUserSpace(context, CPTPointMake(viewPoints[i].left, y));
-                viewPoints[i].left  = pos.x;
-                pos                 = CPTAlignIntegralPointToUserSpace(context, CPTPointMake(viewPoints[i].right, y));
-                viewPoints[i].right = pos.x;
+
+    const CGPoint *leftHighPositions = positions + dataCount;
+    const CGPoint *rightLowPositions = positions + 2 * dataCount;
+
+    for ( NSUInteger i = 0; i < dataCount; i++ ) {
+        CGPointError viewPoint;
+
+        viewPoint.x     = positions[i].x;
+        viewPoint.y     = positions[i].y;
+        viewPoint.high  = leftHighPositions[i].y;
+        viewPoint.low   = rightLowPositions[i].y;
+        viewPoint.left  = leftHighPositions[i].x;
+        viewPoint.right = rightLowPositions[i].x;
+
+        BOOL drawPoint = drawPointFlags[i];
+
+        if ( !drawPoint || isnan(xBytes[i]) || isnan(yBytes[i])) {
+            viewPoint.x = CPTNAN; // depending coordinates
+            viewPoint.y = CPTNAN;
+        }
+
+        viewPoints[i] = viewPoint;
+
+        if ( alignedViewPoints ) {
+            if ( drawPoint && separableAlignment ) {
+                viewPoint.x     = CPTRangePlotAlignCoordinate(viewPoint.x, &xAlignment);
+                viewPoint.left  = CPTRangePlotAlignCoordinate(viewPoint.left, &xAlignment);
+                viewPoint.right = CPTRangePlotAlignCoordinate(viewPoint.right, &xAlignment);
+                viewPoint.y     = CPTRangePlotAlignCoordinate(viewPoint.y, &yAlignment);
+                viewPoint.high  = CPTRangePlotAlignCoordinate(viewPoint.high, &yAlignment);
+                viewPoint.low   = CPTRangePlotAlignCoordinate(viewPoint.low, &yAlignment);
+            }
+            else if ( drawPoint && context ) {
+                CGFloat x   = viewPoint.x;
+                CGFloat y   = viewPoint.y;
+                CGPoint pos = alignPoint(context, CPTPointMake(x, y));
+
+                viewPoint.x     = pos.x;
+                viewPoint.y     = pos.y;
+                viewPoint.high  = alignPoint(context, CPTPointMake(x, viewPoint.high)).y;
+                viewPoint.low   = alignPoint(context, CPTPointMake(x, viewPoint.low)).y;
+                viewPoint.left  = alignPoint(context, CPTPointMake(viewPoint.left, y)).x;
+                viewPoint.right = alignPoint(context, CPTPointMake(viewPoint.right, y)).x;
             }
-        });
+
+            alignedViewPoints[i] = viewPoint;
+        }
     }
+
+    [arena resetToMark:scratchMark];
+}
+
+-(void)cacheFrameGeometryWithAlignedViewPoints:(nullable CGPointError *)alignedViewPoints inContext:(nullable CGContextRef)context
+{
+    NSUInteger dataCount = self.cachedDataCount;
+
+    NSMutableData *viewPointData = self.frameViewPointData;
+    NSMutableData *flagData      = self.frameDrawPointFlagData;
+
+    // reuse the buffers of the last frame unless the number of records changed
+    if ( viewPointData.length != dataCount * sizeof(CGPointError)) {
+        viewPointData = [[NSMutableData alloc] initWithLength:dataCount * sizeof(CGPointError)];
+        flagData      = [[NSMutableData alloc] initWithLength:dataCount * sizeof(BOOL)];
+
+        self.frameViewPointData     = viewPointData;
+        self.frameDrawPointFlagData = flagData;
+    }
+
+    BOOL *drawPointFlags = (BOOL *)flagData.mutableBytes;
+
+    [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:(CPTXYPlotSpace *)self.plotSpace];
+    [self calculateViewPoints:(CGPointError *)viewPointData.mutableBytes
+            alignedViewPoints:alignedViewPoints
+                    inContext:context
+           withDrawPointFlags:drawPointFlags
+               numberOfPoints:dataCount];
+
+    self.frameBounds = self.bounds;
+}
+
+-(BOOL)hasCurrentFrameGeometry
+{
+    NSData *viewPointData = self.frameViewPointData;
+
+    return viewPointData && (viewPointData.length == self.cachedDataCount * sizeof(CGPointError)) &&
+           CGRectEqualToRect(self.frameBounds, self.bounds);
 }
 
 -(NSInteger)extremeDrawnPointIndexForFlags:(nonnull BOOL *)pointDrawFlags numberOfPoints:(NSUInteger)dataCount extremeNumIsLowerBound:(BOOL)isLowerBound
@@ -724,18 +810,22 @@ typedef struct CGPointError CGPointError;
 
     [super renderAsVectorInContext:context];
 
-    // Calculate view points, and align to user space
-    CGPointError *viewPoints = calloc(dataCount, sizeof(CGPointError));
-    BOOL *drawPointFlags     = calloc(dataCount, sizeof(BOOL));
+    // Calculate view points, and align to user space in the same pass. The unaligned
+    // points are kept for hit testing until the plot changes.
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
 
-    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
+    CGPointError *alignedViewPoints = NULL;
 
-    [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:thePlotSpace];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
     if ( self.alignsPointsToPixels ) {
-        [self alignViewPointsToUserSpace:viewPoints withContext:context drawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        alignedViewPoints = [arena allocateCount:dataCount size:sizeof(CGPointError)];
     }
 
+    [self cacheFrameGeometryWithAlignedViewPoints:alignedViewPoints inContext:context];
+
+    CGPointError *viewPoints = alignedViewPoints ? alignedViewPoints : (CGPointError *)self.frameViewPointData.mutableBytes;
+    BOOL *drawPointFlags     = (BOOL *)self.frameDrawPointFlagData.mutableBytes;
+
     // Get extreme points
     NSInteger lastDrawnPointIndex  = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:NO];
     NSInteger firstDrawnPointIndex = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
@@ -855,8 +945,7 @@ typedef struct CGPointError CGPointError;
         }
     }
 
-    free(viewPoints);
-    free(drawPointFlags);
+    [arena resetToMark:scratchMark];
 }
 
 -(void)drawRangeInContext:(nonnull CGContextRef)context
@@ -1044,6 +1133,24 @@ typedef struct CGPointError CGPointError;
     return theBarWidth;
 }
 
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot
+{
+    [super didRenderSnapshot:snapshot];
+
+    CPTRangePlot *theSnapshot = (CPTRangePlot *)snapshot;
+
+    // take over the view points the snapshot drew unless the plot changed since it was taken
+    NSMutableData *viewPointData = theSnapshot.frameViewPointData;
+
+    if ( viewPointData && (theSnapshot.frameGeometryGeneration == self.frameGeometryGeneration) &&
+         (viewPointData.length == self.cachedDataCount * sizeof(CGPointError)) &&
+         CGRectEqualToRect(theSnapshot.frameBounds, self.bounds)) {
+        self.frameViewPointData     = viewPointData;
+        self.frameDrawPointFlagData = theSnapshot.frameDrawPointFlagData;
+        self.frameBounds            = theSnapshot.frameBounds;
+    }
+}
+
 /// @endcond
 
 #pragma mark -
@@ -1173,53 +1280,68 @@ typedef struct CGPointError CGPointError;
 
 /// @cond
 
+-(void)invalidateSpatialIndex
+{
+    [super invalidateSpatialIndex];
+
+    // keep the buffers for the next draw
+    self.frameBounds = CGRectNull;
+    self.frameGeometryGeneration++;
+}
+
 -(NSUInteger)dataIndexFromInteractionPoint:(CGPoint)point
 {
-    NSUInteger dataCount     = self.cachedDataCount;
-    CGPointError *viewPoints = calloc(dataCount, sizeof(CGPointError));
-    BOOL *drawPointFlags     = calloc(dataCount, sizeof(BOOL));
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        // use the view points of the last frame drawn unless the plot changed since
+        if ( ![self hasCurrentFrameGeometry] ) {
+            [self cacheFrameGeometryWithAlignedViewPoints:NULL inContext:NULL];
+        }
 
-    [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:(CPTXYPlotSpace *)self.plotSpace];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        NSUInteger dataCount           = self.cachedDataCount;
+        NSData *viewPointData          = self.frameViewPointData;
+        const CGPointError *viewPoints = (const CGPointError *)viewPointData.bytes;
 
-    NSInteger result = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
 
-    if ( result != NSNotFound ) {
-        CGPointError lastViewPoint;
-        CGFloat minimumDistanceSquared = CPTNAN;
-        for ( NSUInteger i = (NSUInteger)result; i < dataCount; ++i ) {
-            if ( drawPointFlags[i] ) {
-                lastViewPoint = viewPoints[i];
-                CGPoint lastPoint       = CPTPointMake(lastViewPoint.x, lastViewPoint.y);
-                CGFloat distanceSquared = squareOfDistanceBetweenPoints(point, lastPoint);
-                if ( isnan(minimumDistanceSquared) || (distanceSquared < minimumDistanceSquared)) {
-                    minimumDistanceSquared = distanceSquared;
-                    result                 = (NSInteger)i;
-                }
-            }
+        CGPoint *centrePoints = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+
+        for ( NSUInteger i = 0; i < dataCount; ++i ) {
+            centrePoints[i] = CPTPointMake(viewPoints[i].x, viewPoints[i].y);
         }
-        if ( result != NSNotFound ) {
-            lastViewPoint = viewPoints[result];
 
-            if ( !isnan(lastViewPoint.left) && (point.x < lastViewPoint.left)) {
-                result = NSNotFound;
-            }
-            if ( !isnan(lastViewPoint.right) && (point.x > lastViewPoint.right)) {
-                result = NSNotFound;
-            }
-            if ( !isnan(lastViewPoint.high) && (point.y > lastViewPoint.high)) {
-                result = NSNotFound;
-            }
-            if ( !isnan(lastViewPoint.low) && (point.y < lastViewPoint.low)) {
-                result = NSNotFound;
-            }
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithPoints:centrePoints
+                                                                        flags:(const BOOL *)self.frameDrawPointFlagData.bytes
+                                                                        count:dataCount];
+        // keep the error bars for the bounds test of the closest point; the frame buffers are reused by the next draw
+        newIndex.itemData = [viewPointData copy];
+
+        [arena resetToMark:scratchMark];
+
+        return newIndex;
+    }];
+
+    NSUInteger result = [theIndex indexOfItemClosestToPoint:point];
+
+    if ( result != NSNotFound ) {
+        const CGPointError *viewPoints = (const CGPointError *)theIndex.itemData.bytes;
+        CGPointError lastViewPoint     = viewPoints[result];
+
+        if ( !isnan(lastViewPoint.left) && (point.x < lastViewPoint.left)) {
+            result = NSNotFound;
+        }
+        if ( !isnan(lastViewPoint.right) && (point.x > lastViewPoint.right)) {
+            result = NSNotFound;
+        }
+        if ( !isnan(lastViewPoint.high) && (point.y > lastViewPoint.high)) {
+            result = NSNotFound;
+        }
+        if ( !isnan(lastViewPoint.low) && (point.y < lastViewPoint.low)) {
+            result = NSNotFound;
         }
     }
 
-    free(viewPoints);
-    free(drawPointFlags);
-
-    return (NSUInteger)result;
+    return result;
 }
 
 /// @endcond
@@ -0,0 +1,13 @@
+#import "CPTTestCase.h"
+
+@class CPTRangePlot;
+@class CPTXYGraph;
+@class CPTXYPlotSpace;
+
+@interface CPTRangePlotTests : CPTTestCase
+
+@property (nonatomic, readwrite, strong, nullable) CPTRangePlot *plot;
+@property (nonatomic, readwrite, strong, nullable) CPTXYPlotSpace *plotSpace;
+@property (nonatomic, readwrite, strong, nullable) CPTXYGraph *graph;
+
+@end
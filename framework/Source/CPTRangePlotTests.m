@@ -0,0 +1,300 @@
+#import "CPTRangePlotTests.h"
+
+#import "CPTColorSpace.h"
+#import "CPTMutableLineStyle.h"
+#import "CPTPlotRange.h"
+#import "CPTRangePlot.h"
+#import "CPTUtilities.h"
+#import "CPTXYGraph.h"
+#import "CPTXYPlotSpace.h"
+
+// same layout as the view points of CPTRangePlot
+typedef struct {
+    CGFloat x;
+    CGFloat y;
+    CGFloat high;
+    CGFloat low;
+    CGFloat left;
+    CGFloat right;
+} CPTRangePlotTestsPointError;
+
+@interface CPTRangePlot(Testing)
+
+-(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags numberOfPoints:(NSUInteger)dataCount forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace;
+-(void)calculateViewPoints:(nonnull CPTRangePlotTestsPointError *)viewPoints alignedViewPoints:(nullable CPTRangePlotTestsPointError *)alignedViewPoints inContext:(nullable CGContextRef)context withDrawPointFlags:(nonnull const BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount;
+-(void)cacheFrameGeometryWithAlignedViewPoints:(nullable CPTRangePlotTestsPointError *)alignedViewPoints inContext:(nullable CGContextRef)context;
+-(nullable NSMutableData *)frameViewPointData;
+-(nullable NSMutableData *)frameDrawPointFlagData;
+-(nonnull CPTPlot *)renderSnapshot;
+-(void)didRenderSnapshot:(nonnull CPTPlot *)snapshot;
+
+@end
+
+@interface CPTRangePlotTests()
+
+-(void)loadPlot:(nonnull CPTRangePlot *)thePlot withXValues:(nonnull CPTNumberArray *)xValues;
+-(void)checkAlignmentInContext:(nonnull CGContextRef)context description:(nonnull NSString *)description;
+-(void)assertValue:(CGFloat)value equalsValue:(CGFloat)expected description:(nonnull NSString *)description;
+
+@end
+
+#pragma mark -
+
+@implementation CPTRangePlotTests
+
+@synthesize plot;
+@synthesize plotSpace;
+@synthesize graph;
+
+-(void)setUp
+{
+    self.graph = [[CPTXYGraph alloc] initWithFrame:CPTRectMake(0.0, 0.0, 100.0, 50.0)];
+
+    self.plotSpace        = [[CPTXYPlotSpace alloc] init];
+    self.plotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@0.0 length:@1.0];
+    self.plotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@0.0 length:@1.0];
+
+    self.plot                = [[CPTRangePlot alloc] init];
+    self.plot.cachePrecision = CPTPlotCachePrecisionDouble;
+
+    [self.graph addPlotSpace:self.plotSpace];
+    [self.graph addPlot:self.plot toPlotSpace:self.plotSpace];
+    [self.graph layoutIfNeeded];
+
+    [self loadPlot:self.plot withXValues:@[@0.1, @0.3, @0.5, @0.7, @0.9]];
+}
+
+-(void)tearDown
+{
+    self.plot      = nil;
+    self.plotSpace = nil;
+    self.graph     = nil;
+}
+
+-(void)loadPlot:(nonnull CPTRangePlot *)thePlot withXValues:(nonnull CPTNumberArray *)xValues
+{
+    [thePlot cacheNumbers:xValues forField:CPTRangePlotFieldX];
+    [thePlot cacheNumbers:@[@0.513, @0.227, @0.761, @0.349, @0.618] forField:CPTRangePlotFieldY];
+    [thePlot cacheNumbers:@[@0.113, @0.071, @0.059, @0.137, @0.093] forField:CPTRangePlotFieldHigh];
+    [thePlot cacheNumbers:@[@0.087, @0.123, @0.041, @0.066, @0.109] forField:CPTRangePlotFieldLow];
+    [thePlot cacheNumbers:@[@0.047, @0.031, @0.053, @0.029, @0.061] forField:CPTRangePlotFieldLeft];
+    [thePlot cacheNumbers:@[@0.033, @0.057, @0.049, @0.043, @0.027] forField:CPTRangePlotFieldRight];
+}
+
+-(void)assertValue:(CGFloat)value equalsValue:(CGFloat)expected description:(nonnull NSString *)description
+{
+    if ( isnan(expected)) {
+        XCTAssertTrue(isnan(value), @"%@", description);
+    }
+    else {
+        XCTAssertEqualWithAccuracy(value, expected, CPTFloat(1.0e-6), @"%@", description);
+    }
+}
+
+#pragma mark -
+#pragma mark Pixel alignment
+
+-(void)checkAlignmentInContext:(nonnull CGContextRef)context description:(nonnull NSString *)description
+{
+    CPTRangePlot *thePlot = self.plot;
+    NSUInteger dataCount  = thePlot.cachedDataCount;
+
+    BOOL drawPointFlags[dataCount];
+    CPTRangePlotTestsPointError viewPoints[dataCount];
+    CPTRangePlotTestsPointError alignedViewPoints[dataCount];
+
+    for ( NSUInteger lineIndex = 0; lineIndex < 2; lineIndex++ ) {
+        CPTMutableLineStyle *lineStyle = [CPTMutableLineStyle lineStyle];
+
+        // aligned to device pixels with a bar line, to view space without
+        lineStyle.lineWidth  = (lineIndex == 0) ? CPTFloat(1.0) : CPTFloat(0.0);
+        thePlot.barLineStyle = lineStyle;
+
+        CGPoint (*alignPoint)(CGContextRef, CGPoint) = (lineIndex == 0) ? CPTAlignPointToUserSpace : CPTAlignIntegralPointToUserSpace;
+
+        [thePlot calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:self.plotSpace];
+        [thePlot calculateViewPoints:viewPoints alignedViewPoints:alignedViewPoints inContext:context withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            XCTAssertTrue(drawPointFlags[i], @"%@: point %lu drawn", description, (unsigned long)i);
+
+            CPTRangePlotTestsPointError viewPoint    = viewPoints[i];
+            CPTRangePlotTestsPointError alignedPoint = alignedViewPoints[i];
+            NSString *pointDescription               = [NSString stringWithFormat:@"%@, line width %g, point %lu", description, (double)lineStyle.lineWidth, (unsigned long)i];
+
+            CGPoint expected = alignPoint(context, CPTPointMake(viewPoint.x, viewPoint.y));
+
+            [self assertValue:alignedPoint.x equalsValue:expected.x description:[pointDescription stringByAppendingString:@" x"]];
+            [self assertValue:alignedPoint.y equalsValue:expected.y description:[pointDescription stringByAppendingString:@" y"]];
+            [self assertValue:alignedPoint.high
+                  equalsValue:alignPoint(context, CPTPointMake(viewPoint.x, viewPoint.high)).y
+                  description:[pointDescription stringByAppendingString:@" high"]];
+            [self assertValue:alignedPoint.low
+                  equalsValue:alignPoint(context, CPTPointMake(viewPoint.x, viewPoint.low)).y
+                  description:[pointDescription stringByAppendingString:@" low"]];
+            [self assertValue:alignedPoint.left
+                  equalsValue:alignPoint(context, CPTPointMake(viewPoint.left, viewPoint.y)).x
+                  description:[pointDescription stringByAppendingString:@" left"]];
+            [self assertValue:alignedPoint.right
+                  equalsValue:alignPoint(context, CPTPointMake(viewPoint.right, viewPoint.y)).x
+                  description:[pointDescription stringByAppendingString:@" right"]];
+        }
+    }
+}
+
+-(void)testAlignedViewPointsWithScaledContext
+{
+    CGContextRef context = CGBitmapContextCreate(NULL, 256, 256, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CGContextSaveGState(context);
+    CGContextTranslateCTM(context, CPTFloat(0.25), CPTFloat(0.75));
+    CGContextScaleCTM(context, CPTFloat(2.0), CPTFloat(2.0));
+    [self checkAlignmentInContext:context description:@"Scaled"];
+    CGContextRestoreGState(context);
+
+    // flipped, as drawn on iOS
+    CGContextSaveGState(context);
+    CGContextTranslateCTM(context, CPTFloat(0.0), CPTFloat(200.0));
+    CGContextScaleCTM(context, CPTFloat(1.5), CPTFloat(-1.5));
+    [self checkAlignmentInContext:context description:@"Flipped"];
+    CGContextRestoreGState(context);
+
+    CGContextRelease(context);
+}
+
+-(void)testAlignedViewPointsWithRotatedContext
+{
+    CGContextRef context = CGBitmapContextCreate(NULL, 256, 256, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CGContextTranslateCTM(context, CPTFloat(128.0), CPTFloat(0.5));
+    CGContextRotateCTM(context, CPTFloat(M_PI / 6.0));
+    CGContextScaleCTM(context, CPTFloat(2.0), CPTFloat(2.0));
+    [self checkAlignmentInContext:context description:@"Rotated"];
+
+    CGContextRelease(context);
+}
+
+#pragma mark -
+#pragma mark Cache precision
+
+-(void)testDecimalAndDoubleCachesGiveTheSameGeometry
+{
+    CPTNumberArray *xValues = @[@0.1, @(NAN), @0.5, @1.4, @0.9];
+
+    CPTRangePlot *doublePlot  = self.plot;
+    CPTRangePlot *decimalPlot = [[CPTRangePlot alloc] init];
+
+    decimalPlot.cachePrecision = CPTPlotCachePrecisionDecimal;
+
+    [self.graph addPlot:decimalPlot toPlotSpace:self.plotSpace];
+    [self.graph layoutIfNeeded];
+
+    [self loadPlot:doublePlot withXValues:xValues];
+    [self loadPlot:decimalPlot withXValues:xValues];
+
+    XCTAssertTrue(doublePlot.doublePrecisionCache, @"double cache");
+    XCTAssertFalse(decimalPlot.doublePrecisionCache, @"decimal cache");
+
+    [doublePlot cacheFrameGeometryWithAlignedViewPoints:NULL inContext:NULL];
+    [decimalPlot cacheFrameGeometryWithAlignedViewPoints:NULL inContext:NULL];
+
+    NSUInteger dataCount = doublePlot.cachedDataCount;
+
+    XCTAssertEqual(decimalPlot.cachedDataCount, dataCount, @"record count");
+
+    const BOOL *doubleFlags  = (const BOOL *)doublePlot.frameDrawPointFlagData.bytes;
+    const BOOL *decimalFlags = (const BOOL *)decimalPlot.frameDrawPointFlagData.bytes;
+
+    const CPTRangePlotTestsPointError *doublePoints  = (const CPTRangePlotTestsPointError *)doublePlot.frameViewPointData.bytes;
+    const CPTRangePlotTestsPointError *decimalPoints = (const CPTRangePlotTestsPointError *)decimalPlot.frameViewPointData.bytes;
+
+    for ( NSUInteger i = 0; i < dataCount; i++ ) {
+        NSString *description = [NSString stringWithFormat:@"point %lu", (unsigned long)i];
+
+        XCTAssertEqual(decimalFlags[i], doubleFlags[i], @"%@ draw flag", description);
+
+        [self assertValue:decimalPoints[i].x equalsValue:doublePoints[i].x description:[description stringByAppendingString:@" x"]];
+        [self assertValue:decimalPoints[i].y equalsValue:doublePoints[i].y description:[description stringByAppendingString:@" y"]];
+        [self assertValue:decimalPoints[i].high equalsValue:doublePoints[i].high description:[description stringByAppendingString:@" high"]];
+        [self assertValue:decimalPoints[i].low equalsValue:doublePoints[i].low description:[description stringByAppendingString:@" low"]];
+        [self assertValue:decimalPoints[i].left equalsValue:doublePoints[i].left description:[description stringByAppendingString:@" left"]];
+        [self assertValue:decimalPoints[i].right equalsValue:doublePoints[i].right description:[description stringByAppendingString:@" right"]];
+    }
+
+    XCTAssertFalse(doubleFlags[3], @"point outside the x range is not drawn");
+    XCTAssertTrue(isnan(doublePoints[1].x), @"missing x value has no view point");
+}
+
+#pragma mark -
+#pragma mark Hit testing
+
+-(void)testDataIndexFollowsData
+{
+    CPTRangePlot *thePlot        = self.plot;
+    CPTXYPlotSpace *thePlotSpace = self.plotSpace;
+
+    CGPoint hitPoint = [thePlotSpace plotAreaViewPointForPlotPoint:@[@0.7, @0.349]];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)3, @"Bar under the hit point");
+
+    CGPoint outsidePoint = [thePlotSpace plotAreaViewPointForPlotPoint:@[@0.7, @0.6]];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:outsidePoint], (NSUInteger)NSNotFound, @"Point above the high value misses the bar");
+
+    // a stale index would still answer 3, which now holds the bar at 0.5
+    [self loadPlot:thePlot withXValues:@[@0.7, @0.1, @0.3, @0.5, @0.9]];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:[thePlotSpace plotAreaViewPointForPlotPoint:@[@0.7, @0.513]]], (NSUInteger)0, @"New data replaces the hit test geometry");
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)NSNotFound, @"Moved bar no longer hit");
+}
+
+-(void)testDataIndexFollowsPlotRange
+{
+    CPTRangePlot *thePlot        = self.plot;
+    CPTXYPlotSpace *thePlotSpace = self.plotSpace;
+
+    CGPoint hitPoint = [thePlotSpace plotAreaViewPointForPlotPoint:@[@0.5, @0.761]];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)2, @"Bar under the hit point");
+
+    // the same view point now shows the bar at 0.7
+    thePlotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@0.2 length:@1.0];
+    thePlotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@(-0.412) length:@1.0];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)3, @"New plot range replaces the hit test geometry");
+}
+
+#pragma mark -
+#pragma mark Render snapshots
+
+-(void)testSnapshotGeometryTakenBack
+{
+    CPTRangePlot *thePlot = self.plot;
+    CGContextRef context  = CGBitmapContextCreate(NULL, 100, 50, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CPTRangePlot *snapshot = (CPTRangePlot *)[thePlot renderSnapshot];
+
+    [snapshot renderAsVectorInContext:context];
+    XCTAssertNotNil(snapshot.frameViewPointData, @"Snapshot geometry");
+
+    [thePlot didRenderSnapshot:snapshot];
+    XCTAssertEqual(thePlot.frameViewPointData, snapshot.frameViewPointData, @"Geometry of the frame shown taken back");
+
+    CGPoint hitPoint = [self.plotSpace plotAreaViewPointForPlotPoint:@[@0.7, @0.349]];
+
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)3, @"Hit test with the snapshot geometry");
+
+    // data reloaded while the snapshot was drawn
+    snapshot = (CPTRangePlot *)[thePlot renderSnapshot];
+    [snapshot renderAsVectorInContext:context];
+
+    [self loadPlot:thePlot withXValues:@[@0.7, @0.1, @0.3, @0.5, @0.9]];
+
+    [thePlot didRenderSnapshot:snapshot];
+    XCTAssertNotEqual(thePlot.frameViewPointData, snapshot.frameViewPointData, @"Stale geometry not taken back");
+    XCTAssertEqual([thePlot dataIndexFromInteractionPoint:hitPoint], (NSUInteger)NSNotFound, @"Hit test with the new data");
+
+    CGContextRelease(context);
+}
+
+@end
@@ -253,6 +253,7 @@ typedef NS_ENUM (NSInteger, CPTScatterPlotHistogramOption) {
 @property (nonatomic, readwrite, assign) CPTScatterPlotHistogramOption histogramOption;
 @property (nonatomic, readwrite, assign) CPTScatterPlotCurvedInterpolationOption curvedInterpolationOption;
 @property (nonatomic, readwrite, assign) CGFloat curvedInterpolationCustomAlpha;
+@property (nonatomic, readwrite, assign) BOOL decimatesDataLine;
 /// @}
 
 /// @name Area Fill Bands
@@ -13,6 +13,11 @@
 #import "CPTUtilities.h"
 #import "CPTXYPlotSpace.h"
 #import "NSCoderExtensions.h"
+#import "_CPTFixedPointNumbers.h"
+#import "_CPTPlotSymbolAtlas.h"
+#import "_CPTRangeClassification.h"
+#import "_CPTScratchArena.h"
+#import "_CPTSpatialIndex.h"
 #import <tgmath.h>
 
 /** @defgroup plotAnimationScatterPlot Scatter Plot
@@ -32,6 +37,10 @@ CPTScatterPlotBinding const CPTScatterPlotBindingYValues     = @"yValues";     /
 CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; ///< Plot symbols.
 
 /// @cond
+
+// plot symbol index of a record drawn without a symbol
+static const uint32_t CPTScatterPlotNoSymbolIndex = UINT32_MAX;
+
 @interface CPTScatterPlot()
 
 @property (nonatomic, readwrite, copy, nullable) CPTNumberArray *xValues;
@@ -40,13 +49,27 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 @property (nonatomic, readwrite, assign) NSUInteger pointingDeviceDownIndex;
 @property (nonatomic, readwrite, assign) BOOL pointingDeviceDownOnLine;
 @property (nonatomic, readwrite, strong) CPTMutableLimitBandArray *mutableAreaFillBands;
+@property (nonatomic, readwrite, assign, nullable) CGPathRef cachedDataLinePath;
+@property (nonatomic, readwrite, strong, nullable) NSData *cachedDataLineViewPoints;
+@property (nonatomic, readwrite, assign) CGFloat cachedDataLineScale;
+@property (nonatomic, readwrite, strong, nullable) NSMutableDictionary<NSNumber *, id> *cachedAreaFillPaths;
+@property (nonatomic, readwrite, strong, nullable) NSData *plotSymbolIndices;
+@property (nonatomic, readwrite, strong, nullable) CPTPlotSymbolArray *indexedPlotSymbols;
+@property (nonatomic, readwrite, strong, nonnull) _CPTPlotSymbolAtlas *symbolAtlas;
 
 -(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace includeVisiblePointsOnly:(BOOL)visibleOnly numberOfPoints:(NSUInteger)dataCount;
 -(void)calculateViewPoints:(nonnull CGPoint *)viewPoints withDrawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount;
 -(void)alignViewPointsToUserSpace:(nonnull CGPoint *)viewPoints withContext:(nonnull CGContextRef)context drawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount;
 
+-(void)updatePlotSymbolIndices;
+-(void)drawPlotSymbolsInContext:(nonnull CGContextRef)context viewPoints:(nonnull const CGPoint *)viewPoints drawPointFlags:(nonnull const BOOL *)drawPointFlags indexRange:(NSRange)indexRange alignToPixels:(BOOL)pixelAlign;
+
 -(NSInteger)extremeDrawnPointIndexForFlags:(nonnull BOOL *)pointDrawFlags numberOfPoints:(NSUInteger)dataCount extremeNumIsLowerBound:(BOOL)isLowerBound;
 
+-(NSUInteger)decimateViewPoints:(nonnull const CGPoint *)viewPoints indexRange:(NSRange)indexRange intoPoints:(nonnull CGPoint *)decimatedPoints;
+-(nonnull CGPathRef)dataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange;
+-(nonnull CGPathRef)areaFillPathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue;
+-(void)invalidateDataLinePath;
 -(nonnull CGPathRef)newDataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue;
 -(nonnull CGPathRef)newCurvedDataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue;
 -(void)computeBezierControlPoints:(nonnull CGPoint *)cp1 points2:(nonnull CGPoint *)cp2 forViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange;
@@ -98,6 +121,19 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
  **/
 @synthesize curvedInterpolationCustomAlpha;
 
+/** @property BOOL decimatesDataLine
+ *  @brief If @YES, the data line and area fills are built from a min/max envelope of the view points.
+ *
+ *  Consecutive points that fall in the same device pixel column are reduced to the first, minimum, maximum,
+ *  and last point of the column before the path is constructed, so the path size depends on the width of
+ *  the plot area rather than the number of records. The rendered line is visually identical; plot symbols
+ *  are still drawn for every visible point.
+ *  Decimation is only applied when the @ref interpolation is #CPTScatterPlotInterpolationLinear
+ *  and the data line style does not have a dash pattern.
+ *  Default is @NO.
+ **/
+@synthesize decimatesDataLine;
+
 /** @property nullable CPTLineStyle *dataLineStyle
  *  @brief The line style for the data line.
  *  If @nil, the line is not drawn.
@@ -191,6 +227,51 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 
 @synthesize mutableAreaFillBands;
 
+/** @internal
+ *  @property nullable CGPathRef cachedDataLinePath
+ *  @brief The open data line built for the last frame, shared by the fills and the stroke.
+ **/
+@synthesize cachedDataLinePath;
+
+/** @internal
+ *  @property nullable NSData *cachedDataLineViewPoints
+ *  @brief A copy of the view points the @ref cachedDataLinePath was built from.
+ **/
+@synthesize cachedDataLineViewPoints;
+
+/** @internal
+ *  @property CGFloat cachedDataLineScale
+ *  @brief The @ref contentsScale used to decimate the @ref cachedDataLinePath.
+ **/
+@synthesize cachedDataLineScale;
+
+/** @internal
+ *  @property nullable NSMutableDictionary<NSNumber *, id> *cachedAreaFillPaths
+ *  @brief Closed fill paths derived from the @ref cachedDataLinePath, keyed by the baseline y-coordinate.
+ **/
+@synthesize cachedAreaFillPaths;
+
+/** @internal
+ *  @property nullable NSData *plotSymbolIndices
+ *  @brief The plot symbol of each record as a @c uint32_t, resolved when the symbols are loaded.
+ *
+ *  Zero (@num{0}) stands for the @ref plotSymbol, @par{k} for entry @par{k - 1} of @ref indexedPlotSymbols,
+ *  and @c UINT32_MAX for a record drawn without a symbol. @nil if no symbols are cached for the records.
+ **/
+@synthesize plotSymbolIndices;
+
+/** @internal
+ *  @property nullable CPTPlotSymbolArray *indexedPlotSymbols
+ *  @brief The distinct plot symbols in the cache, in the order of their first record.
+ **/
+@synthesize indexedPlotSymbols;
+
+/** @internal
+ *  @property nonnull _CPTPlotSymbolAtlas *symbolAtlas
+ *  @brief The plot symbols rasterized for the last frame, shared with the render snapshots.
+ **/
+@synthesize symbolAtlas;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -230,6 +311,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
  *  - @ref histogramOption = #CPTScatterPlotHistogramNormal
  *  - @ref curvedInterpolationOption = #CPTScatterPlotCurvedInterpolationNormal
  *  - @ref curvedInterpolationCustomAlpha = @num{0.5}
+ *  - @ref decimatesDataLine = @NO
  *  - @ref labelField = #CPTScatterPlotFieldY
  *
  *  @param  newFrame The frame rectangle.
@@ -250,9 +332,13 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         histogramOption                 = CPTScatterPlotHistogramNormal;
         curvedInterpolationOption       = CPTScatterPlotCurvedInterpolationNormal;
         curvedInterpolationCustomAlpha  = CPTFloat(0.5);
+        decimatesDataLine               = NO;
         pointingDeviceDownIndex         = NSNotFound;
         pointingDeviceDownOnLine        = NO;
         mutableAreaFillBands            = nil;
+        plotSymbolIndices               = nil;
+        indexedPlotSymbols              = nil;
+        symbolAtlas                     = nil;
         self.labelField                 = CPTScatterPlotFieldY;
     }
     return self;
@@ -280,13 +366,26 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         histogramOption                         = theLayer->histogramOption;
         curvedInterpolationOption               = theLayer->curvedInterpolationOption;
         curvedInterpolationCustomAlpha          = theLayer->curvedInterpolationCustomAlpha;
+        decimatesDataLine                       = theLayer->decimatesDataLine;
         mutableAreaFillBands                    = theLayer->mutableAreaFillBands;
         pointingDeviceDownIndex                 = NSNotFound;
         pointingDeviceDownOnLine                = NO;
+        cachedDataLinePath                      = NULL;
+        cachedDataLineViewPoints                = nil;
+        cachedDataLineScale                     = CPTFloat(0.0);
+        cachedAreaFillPaths                     = nil;
+        plotSymbolIndices                       = theLayer->plotSymbolIndices;
+        indexedPlotSymbols                      = theLayer->indexedPlotSymbols;
+        symbolAtlas                             = theLayer.symbolAtlas;
     }
     return self;
 }
 
+-(void)dealloc
+{
+    CGPathRelease(cachedDataLinePath);
+}
+
 /// @endcond
 
 #pragma mark -
@@ -302,6 +401,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     [coder encodeInteger:self.histogramOption forKey:@"CPTScatterPlot.histogramOption"];
     [coder encodeInteger:self.curvedInterpolationOption forKey:@"CPTScatterPlot.curvedInterpolationOption"];
     [coder encodeCGFloat:self.curvedInterpolationCustomAlpha forKey:@"CPTScatterPlot.curvedInterpolationCustomAlpha"];
+    [coder encodeBool:self.decimatesDataLine forKey:@"CPTScatterPlot.decimatesDataLine"];
     [coder encodeObject:self.dataLineStyle forKey:@"CPTScatterPlot.dataLineStyle"];
     [coder encodeObject:self.plotSymbol forKey:@"CPTScatterPlot.plotSymbol"];
     [coder encodeObject:self.areaFill forKey:@"CPTScatterPlot.areaFill"];
@@ -316,6 +416,9 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     // No need to archive these properties:
     // pointingDeviceDownIndex
     // pointingDeviceDownOnLine
+    // plotSymbolIndices
+    // indexedPlotSymbols
+    // symbolAtlas
 }
 
 -(nullable instancetype)initWithCoder:(nonnull NSCoder *)coder
@@ -325,6 +428,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         histogramOption                = (CPTScatterPlotHistogramOption)[coder decodeIntegerForKey:@"CPTScatterPlot.histogramOption"];
         curvedInterpolationOption      = (CPTScatterPlotCurvedInterpolationOption)[coder decodeIntegerForKey:@"CPTScatterPlot.curvedInterpolationOption"];
         curvedInterpolationCustomAlpha = [coder decodeCGFloatForKey:@"CPTScatterPlot.curvedInterpolationCustomAlpha"];
+        decimatesDataLine              = [coder decodeBoolForKey:@"CPTScatterPlot.decimatesDataLine"];
         dataLineStyle                  = [[coder decodeObjectOfClass:[CPTLineStyle class]
                                                               forKey:@"CPTScatterPlot.dataLineStyle"] copy];
         plotSymbol = [[coder decodeObjectOfClass:[CPTPlotSymbol class]
@@ -344,6 +448,9 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         allowSimultaneousSymbolAndPlotSelection = [coder decodeBoolForKey:@"CPTScatterPlot.allowSimultaneousSymbolAndPlotSelection"];
         pointingDeviceDownIndex                 = NSNotFound;
         pointingDeviceDownOnLine                = NO;
+        plotSymbolIndices                       = nil;
+        indexedPlotSymbols                      = nil;
+        symbolAtlas                             = nil;
     }
     return self;
 }
@@ -391,6 +498,12 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     }
 }
 
+-(void)deleteDataInIndexRange:(NSRange)indexRange
+{
+    [super deleteDataInIndexRange:indexRange];
+    [self updatePlotSymbolIndices];
+}
+
 /// @endcond
 
 /**
@@ -437,6 +550,8 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         [self cacheArray:array forKey:CPTScatterPlotBindingPlotSymbols atRecordIndex:indexRange.location];
     }
 
+    [self updatePlotSymbolIndices];
+
     // Legend
     if ( needsLegendUpdate ) {
         [[NSNotificationCenter defaultCenter] postNotificationName:CPTLegendNeedsRedrawForPlotNotification object:self];
@@ -463,6 +578,73 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     return symbol;
 }
 
+/// @cond
+
+/** @internal
+ *  @brief Resolves the cached plot symbols into @ref plotSymbolIndices and @ref indexedPlotSymbols
+ *  the same way as @link CPTScatterPlot::plotSymbolForRecordIndex: -plotSymbolForRecordIndex: @endlink.
+ *
+ *  Symbols are told apart by identity, so a data source that hands out one symbol per style gets one index per style.
+ **/
+-(void)updatePlotSymbolIndices
+{
+    CPTPlotSymbolArray *cachedSymbols = self.plotSymbols;
+
+    if ( cachedSymbols ) {
+        NSUInteger dataCount   = self.cachedDataCount;
+        NSUInteger symbolCount = cachedSymbols.count;
+        id nilObject           = [CPTPlot nilData];
+        Class symbolClass      = [CPTPlotSymbol class];
+
+        NSMutableData *indexData = [[NSMutableData alloc] initWithLength:dataCount * sizeof(uint32_t)];
+        uint32_t *indices        = (uint32_t *)indexData.mutableBytes;
+
+        CPTMutablePlotSymbolArray *uniqueSymbols = [[NSMutableArray alloc] init];
+        NSMapTable<id, NSNumber *> *symbolIndex  = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                                         valueOptions:NSPointerFunctionsStrongMemory];
+
+        // neighbouring records usually share a symbol, a missing one resolves to the plotSymbol
+        id lastObject      = nil;
+        uint32_t lastIndex = 0;
+
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            id object = (i < symbolCount) ? cachedSymbols[i] : nil;
+
+            if ( object != lastObject ) {
+                if ( !object || (object == nilObject)) {
+                    lastIndex = 0;
+                }
+                else if ( [object isKindOfClass:symbolClass] ) {
+                    NSNumber *knownIndex = [symbolIndex objectForKey:object];
+
+                    if ( knownIndex ) {
+                        lastIndex = knownIndex.unsignedIntValue;
+                    }
+                    else {
+                        [uniqueSymbols addObject:object];
+                        lastIndex = (uint32_t)uniqueSymbols.count;
+                        [symbolIndex setObject:@(lastIndex) forKey:object];
+                    }
+                }
+                else {
+                    lastIndex = CPTScatterPlotNoSymbolIndex;
+                }
+                lastObject = object;
+            }
+            indices[i] = lastIndex;
+        }
+
+        self.plotSymbolIndices  = indexData;
+        self.indexedPlotSymbols = uniqueSymbols;
+    }
+    else {
+        self.plotSymbolIndices  = nil;
+        self.indexedPlotSymbols = nil;
+    }
+}
+
+/// @endcond
+
 #pragma mark -
 #pragma mark Determining Which Points to Draw
 
@@ -483,129 +665,46 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         }
     }
     else {
-        CPTPlotRangeComparisonResult *xRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-        CPTPlotRangeComparisonResult *yRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult));
-        BOOL *nanFlags                            = calloc(dataCount, sizeof(BOOL));
-
         CPTPlotRange *xRange = xyPlotSpace.xRange;
         CPTPlotRange *yRange = xyPlotSpace.yRange;
 
+        // Ensure that whenever the path crosses over a region boundary, both points
+        // are included. This ensures no lines are left out that shouldn't be.
+        CPTRangeClassificationExpansion expansion = CPTRangeClassificationExpansionNone;
+
+        if ( !visibleOnly ) {
+            expansion = (self.interpolation == CPTScatterPlotInterpolationCurved) ? CPTRangeClassificationExpansionTwo : CPTRangeClassificationExpansionOne;
+        }
+
         // Determine where each point lies in relation to range
         if ( self.doublePrecisionCache ) {
             const double *xBytes = (const double *)[self cachedNumbersForField:CPTScatterPlotFieldX].data.bytes;
             const double *yBytes = (const double *)[self cachedNumbersForField:CPTScatterPlotFieldY].data.bytes;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                const double x = xBytes[i];
-                const double y = yBytes[i];
-
-                CPTPlotRangeComparisonResult xFlag = [xRange compareToDouble:x];
-                xRangeFlags[i]                     = xFlag;
-                if ( xFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    yRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if x is out of range, then y doesn't matter
-                }
-                else {
-                    yRangeFlags[i] = [yRange compareToDouble:y];
-                }
-                nanFlags[i] = isnan(x) || isnan(y);
-            });
+            CPTRangeClassificationFlagPoints(pointDrawFlags, xBytes, yBytes, dataCount,
+                                             CPTRangeClassificationLimitsForRange(xRange),
+                                             CPTRangeClassificationLimitsForRange(yRange),
+                                             expansion);
         }
         else {
-            // Determine where each point lies in relation to range
             const NSDecimal *xBytes = (const NSDecimal *)[self cachedNumbersForField:CPTScatterPlotFieldX].data.bytes;
             const NSDecimal *yBytes = (const NSDecimal *)[self cachedNumbersForField:CPTScatterPlotFieldY].data.bytes;
 
-            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-                const NSDecimal x = xBytes[i];
-                const NSDecimal y = yBytes[i];
+            _CPTFixedPointNumbers *xFixedPoint = [self fixedPointNumbersForField:CPTScatterPlotFieldX];
+            _CPTFixedPointNumbers *yFixedPoint = [self fixedPointNumbersForField:CPTScatterPlotFieldY];
 
-                CPTPlotRangeComparisonResult xFlag = [xRange compareToDecimal:x];
-                xRangeFlags[i]                     = xFlag;
-                if ( xFlag != CPTPlotRangeComparisonResultNumberInRange ) {
-                    yRangeFlags[i] = CPTPlotRangeComparisonResultNumberInRange; // if x is out of range, then y doesn't matter
-                }
-                else {
-                    yRangeFlags[i] = [yRange compareToDecimal:y];
-                }
+            CPTRangeClassificationFixedPointLimits xLimits;
+            CPTRangeClassificationFixedPointLimits yLimits;
 
-                nanFlags[i] = NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y);
-            });
-        }
-
-        // Ensure that whenever the path crosses over a region boundary, both points
-        // are included. This ensures no lines are left out that shouldn't be.
-        CPTScatterPlotInterpolation theInterpolation = self.interpolation;
-
-        memset(pointDrawFlags, NO, dataCount * sizeof(BOOL));
-        if ( dataCount > 0 ) {
-            pointDrawFlags[0] = (xRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange &&
-                                 yRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange &&
-                                 !nanFlags[0]);
-        }
-        if ( visibleOnly ) {
-            for ( NSUInteger i = 1; i < dataCount; i++ ) {
-                if ((xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                    (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                    !nanFlags[i] ) {
-                    pointDrawFlags[i] = YES;
-                }
+            if ((xFixedPoint.count >= dataCount) && (yFixedPoint.count >= dataCount) &&
+                [xFixedPoint getLimits:&xLimits forRange:xRange] && [yFixedPoint getLimits:&yLimits forRange:yRange] ) {
+                CPTRangeClassificationFlagFixedPointPoints(pointDrawFlags, xFixedPoint.values, yFixedPoint.values, xBytes, yBytes, dataCount,
+                                                           xLimits, yLimits, xRange, yRange, expansion);
             }
-        }
-        else {
-            switch ( theInterpolation ) {
-                case CPTScatterPlotInterpolationCurved:
-                    // Keep 2 points outside of the visible area on each side to maintain the correct curvature of the line
-                    if ( dataCount > 1 ) {
-                        if ( !nanFlags[0] && !nanFlags[1] && ((xRangeFlags[0] != xRangeFlags[1]) || (yRangeFlags[0] != yRangeFlags[1]))) {
-                            pointDrawFlags[0] = YES;
-                            pointDrawFlags[1] = YES;
-                        }
-                        else if ((xRangeFlags[1] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (yRangeFlags[1] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 !nanFlags[1] ) {
-                            pointDrawFlags[1] = YES;
-                        }
-                    }
-
-                    for ( NSUInteger i = 2; i < dataCount; i++ ) {
-                        if ( !nanFlags[i - 2] && !nanFlags[i - 1] && !nanFlags[i] ) {
-                            pointDrawFlags[i - 2] = YES;
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ( !nanFlags[i - 1] && !nanFlags[i] && ((xRangeFlags[i - 1] != xRangeFlags[i]) || (yRangeFlags[i - 1] != yRangeFlags[i]))) {
-                            pointDrawFlags[i - 2] = YES;
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ((xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 !nanFlags[i] ) {
-                            pointDrawFlags[i] = YES;
-                        }
-                    }
-                    break;
-
-                default:
-                    // Keep 1 point outside of the visible area on each side
-                    for ( NSUInteger i = 1; i < dataCount; i++ ) {
-                        if ( !nanFlags[i - 1] && !nanFlags[i] && ((xRangeFlags[i - 1] != xRangeFlags[i]) || (yRangeFlags[i - 1] != yRangeFlags[i]))) {
-                            pointDrawFlags[i - 1] = YES;
-                            pointDrawFlags[i]     = YES;
-                        }
-                        else if ((xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                                 !nanFlags[i] ) {
-                            pointDrawFlags[i] = YES;
-                        }
-                    }
-                    break;
+            else {
+                CPTRangeClassificationFlagDecimalPoints(pointDrawFlags, xBytes, yBytes, dataCount, xRange, yRange, expansion);
             }
         }
-
-        free(xRangeFlags);
-        free(yRangeFlags);
-        free(nanFlags);
     }
 }
 
@@ -618,20 +717,13 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         const double *xBytes = (const double *)[self cachedNumbersForField:CPTScatterPlotFieldX].data.bytes;
         const double *yBytes = (const double *)[self cachedNumbersForField:CPTScatterPlotFieldY].data.bytes;
 
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x = xBytes[i];
-            const double y = yBytes[i];
-            if ( !drawPointFlags[i] || isnan(x) || isnan(y)) {
-                viewPoints[i] = CPTPointMake(NAN, NAN);
-            }
-            else {
-                double plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
+        [thePlotSpace plotAreaViewPoints:viewPoints forDoublePrecisionXValues:xBytes yValues:yBytes numberOfPoints:dataCount];
 
-                viewPoints[i] = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            if ( !drawPointFlags[i] || isnan(xBytes[i]) || isnan(yBytes[i])) {
+                viewPoints[i] = CPTPointMake(NAN, NAN);
             }
-        });
+        }
     }
     else {
         CPTMutableNumericData *xData = [self cachedNumbersForField:CPTScatterPlotFieldX];
@@ -640,20 +732,46 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         const NSDecimal *xBytes = (const NSDecimal *)xData.data.bytes;
         const NSDecimal *yBytes = (const NSDecimal *)yData.data.bytes;
 
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const NSDecimal x = xBytes[i];
-            const NSDecimal y = yBytes[i];
-            if ( !drawPointFlags[i] || NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y)) {
-                viewPoints[i] = CPTPointMake(NAN, NAN);
-            }
-            else {
-                NSDecimal plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
+        _CPTFixedPointNumbers *xFixedPoint = [self fixedPointNumbersForField:CPTScatterPlotFieldX];
+        _CPTFixedPointNumbers *yFixedPoint = [self fixedPointNumbersForField:CPTScatterPlotFieldY];
 
-                viewPoints[i] = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
+        if ((xFixedPoint.count >= dataCount) && (yFixedPoint.count >= dataCount)) {
+            // Pixel placement does not need NSDecimal arithmetic; transform the fixed point values as doubles in one pass
+            _CPTScratchArena *arena = self.scratchArena;
+            NSUInteger scratchMark  = arena.mark;
+
+            double *xValues = [arena allocateCount:xFixedPoint.count size:sizeof(double)];
+            double *yValues = [arena allocateCount:yFixedPoint.count size:sizeof(double)];
+
+            [xFixedPoint getDoubles:xValues decimals:xBytes];
+            [yFixedPoint getDoubles:yValues decimals:yBytes];
+
+            [thePlotSpace plotAreaViewPoints:viewPoints forDoublePrecisionXValues:xValues yValues:yValues numberOfPoints:dataCount];
+
+            for ( NSUInteger i = 0; i < dataCount; i++ ) {
+                if ( !drawPointFlags[i] || isnan(xValues[i]) || isnan(yValues[i])) {
+                    viewPoints[i] = CPTPointMake(NAN, NAN);
+                }
             }
-        });
+
+            [arena resetToMark:scratchMark];
+        }
+        else {
+            dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+                const NSDecimal x = xBytes[i];
+                const NSDecimal y = yBytes[i];
+                if ( !drawPointFlags[i] || NSDecimalIsNotANumber(&x) || NSDecimalIsNotANumber(&y)) {
+                    viewPoints[i] = CPTPointMake(NAN, NAN);
+                }
+                else {
+                    NSDecimal plotPoint[2];
+                    plotPoint[CPTCoordinateX] = x;
+                    plotPoint[CPTCoordinateY] = y;
+
+                    viewPoints[i] = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
+                }
+            });
+        }
     }
 }
 
@@ -717,32 +835,25 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
  **/
 -(NSUInteger)indexOfVisiblePointClosestToPlotAreaPoint:(CGPoint)viewPoint
 {
-    NSUInteger dataCount = self.cachedDataCount;
-    CGPoint *viewPoints  = calloc(dataCount, sizeof(CGPoint));
-    BOOL *drawPointFlags = calloc(dataCount, sizeof(BOOL));
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        NSUInteger dataCount = self.cachedDataCount;
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
 
-    [self calculatePointsToDraw:drawPointFlags forPlotSpace:(CPTXYPlotSpace *)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+        BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
-    NSInteger result = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
+        [self calculatePointsToDraw:drawPointFlags forPlotSpace:(CPTXYPlotSpace *)self.plotSpace includeVisiblePointsOnly:YES numberOfPoints:dataCount];
+        [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
 
-    if ( result != NSNotFound ) {
-        CGFloat minimumDistanceSquared = CPTNAN;
-        for ( NSUInteger i = (NSUInteger)result; i < dataCount; ++i ) {
-            if ( drawPointFlags[i] ) {
-                CGFloat distanceSquared = squareOfDistanceBetweenPoints(viewPoint, viewPoints[i]);
-                if ( isnan(minimumDistanceSquared) || (distanceSquared < minimumDistanceSquared)) {
-                    minimumDistanceSquared = distanceSquared;
-                    result                 = (NSInteger)i;
-                }
-            }
-        }
-    }
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithPoints:viewPoints flags:drawPointFlags count:dataCount];
 
-    free(viewPoints);
-    free(drawPointFlags);
+        [arena resetToMark:scratchMark];
 
-    return (NSUInteger)result;
+        return newIndex;
+    }];
+
+    return [theIndex indexOfItemClosestToPoint:viewPoint];
 }
 
 /** @brief Returns the plot area view point of a visible point.
@@ -806,8 +917,11 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     [super renderAsVectorInContext:context];
 
     // Calculate view points, and align to user space
-    CGPoint *viewPoints  = calloc(dataCount, sizeof(CGPoint));
-    BOOL *drawPointFlags = calloc(dataCount, sizeof(BOOL));
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+    BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
     CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
 
@@ -868,7 +982,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
                         baseLinePoint = CPTAlignIntegralPointToUserSpace(context, baseLinePoint);
                     }
 
-                    CGPathRef dataLinePath = [self newDataLinePathForViewPoints:viewPoints indexRange:viewIndexRange baselineYValue:baseLinePoint.y];
+                    CGPathRef dataLinePath = [self areaFillPathForViewPoints:viewPoints indexRange:viewIndexRange baselineYValue:baseLinePoint.y];
 
                     if ( theFill ) {
                         CGContextBeginPath(context);
@@ -906,8 +1020,6 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
                         }
                     }
 
-                    CGPathRelease(dataLinePath);
-
                     if ( theLineStyle ) {
                         CGContextRestoreGState(context);
                     }
@@ -917,7 +1029,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 
         // Draw line
         if ( theLineStyle ) {
-            CGPathRef dataLinePath = [self newDataLinePathForViewPoints:viewPoints indexRange:viewIndexRange baselineYValue:CPTNAN];
+            CGPathRef dataLinePath = [self dataLinePathForViewPoints:viewPoints indexRange:viewIndexRange];
 
             // Give the delegate a chance to prepare for the drawing.
             id<CPTScatterPlotDelegate> theDelegate = (id<CPTScatterPlotDelegate>)self.delegate;
@@ -929,42 +1041,247 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
             CGContextAddPath(context, dataLinePath);
             [theLineStyle setLineStyleInContext:context];
             [theLineStyle strokePathInContext:context];
-            CGPathRelease(dataLinePath);
         }
 
         // Draw plot symbols
         if ( self.plotSymbol || self.plotSymbols.count ) {
-            Class symbolClass = [CPTPlotSymbol class];
-
             // clear the plot shadow if any--symbols draw their own shadows
             CGContextSetShadowWithColor(context, CGSizeZero, CPTFloat(0.0), NULL);
 
-            if ( self.useFastRendering ) {
-                CGFloat scale = self.contentsScale;
-                for ( NSUInteger i = (NSUInteger)firstDrawnPointIndex; i <= (NSUInteger)lastDrawnPointIndex; i++ ) {
-                    if ( drawPointFlags[i] ) {
-                        CPTPlotSymbol *currentSymbol = [self plotSymbolForRecordIndex:i];
-                        if ( [currentSymbol isKindOfClass:symbolClass] ) {
-                            [currentSymbol renderInContext:context atPoint:viewPoints[i] scale:scale alignToPixels:pixelAlign];
-                        }
+            [self drawPlotSymbolsInContext:context viewPoints:viewPoints drawPointFlags:drawPointFlags indexRange:viewIndexRange alignToPixels:pixelAlign];
+        }
+    }
+
+    [arena resetToMark:scratchMark];
+}
+
+/** @internal
+ *  @brief Draws the plot symbols of the flagged points in the given index range.
+ *
+ *  Bitmap output stamps the symbols from the @ref symbolAtlas, one batch for each run of points sharing a symbol
+ *  so the symbols still overlap in record order. Vector output, such as PDF, draws every symbol as a path.
+ *  @param context        The graphics context to draw into.
+ *  @param viewPoints     A pointer to the array of view points.
+ *  @param drawPointFlags A pointer to the array of draw flags.
+ *  @param indexRange     The range of records to draw.
+ *  @param pixelAlign     If @YES, the symbols are aligned with device pixels.
+ **/
+-(void)drawPlotSymbolsInContext:(nonnull CGContextRef)context viewPoints:(nonnull const CGPoint *)viewPoints drawPointFlags:(nonnull const BOOL *)drawPointFlags indexRange:(NSRange)indexRange alignToPixels:(BOOL)pixelAlign
+{
+    NSUInteger dataCount = self.cachedDataCount;
+
+    NSData *indexData = self.plotSymbolIndices;
+
+    if ( self.plotSymbols && (indexData.length != dataCount * sizeof(uint32_t))) {
+        // the record count changed without a symbol reload
+        [self updatePlotSymbolIndices];
+        indexData = self.plotSymbolIndices;
+    }
+
+    const uint32_t *symbolIndices = (indexData.length == dataCount * sizeof(uint32_t)) ? (const uint32_t *)indexData.bytes : NULL;
+
+    // entry zero is the default symbol, entry k the k-th indexed symbol
+    CPTPlotSymbolArray *theIndexedSymbols = symbolIndices ? self.indexedPlotSymbols : nil;
+    NSMutableArray *symbolEntries         = [[NSMutableArray alloc] initWithCapacity:theIndexedSymbols.count + 1];
+
+    [symbolEntries addObject:self.plotSymbol ?: [CPTPlot nilData]];
+    if ( theIndexedSymbols ) {
+        [symbolEntries addObjectsFromArray:theIndexedSymbols];
+    }
+
+    NSUInteger entryCount = symbolEntries.count;
+    NSUInteger maxIndex   = NSMaxRange(indexRange);
+
+    if ( self.useFastRendering ) {
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *runPoints = [arena allocateCount:indexRange.length size:sizeof(CGPoint)];
+
+        _CPTPlotSymbolAtlas *atlas = self.symbolAtlas;
+
+        // the atlas is shared with the render snapshots
+        @synchronized ( atlas ) {
+            [atlas prepareEntries:symbolEntries scale:self.contentsScale context:context];
+
+            NSUInteger runEntry = NSNotFound;
+            NSUInteger runCount = 0;
+
+            for ( NSUInteger i = indexRange.location; i < maxIndex; i++ ) {
+                if ( drawPointFlags[i] ) {
+                    NSUInteger entry = symbolIndices ? (NSUInteger)symbolIndices[i] : 0;
+
+                    if ( entry != runEntry ) {
+                        [atlas stampEntry:runEntry atPoints:runPoints count:runCount inContext:context alignToPixels:pixelAlign];
+                        runEntry = entry;
+                        runCount = 0;
                     }
+                    runPoints[runCount++] = viewPoints[i];
                 }
             }
-            else {
-                for ( NSUInteger i = (NSUInteger)firstDrawnPointIndex; i <= (NSUInteger)lastDrawnPointIndex; i++ ) {
-                    if ( drawPointFlags[i] ) {
-                        CPTPlotSymbol *currentSymbol = [self plotSymbolForRecordIndex:i];
-                        if ( [currentSymbol isKindOfClass:symbolClass] ) {
-                            [currentSymbol renderAsVectorInContext:context atPoint:viewPoints[i] scale:CPTFloat(1.0)];
-                        }
+            [atlas stampEntry:runEntry atPoints:runPoints count:runCount inContext:context alignToPixels:pixelAlign];
+        }
+
+        [arena resetToMark:scratchMark];
+    }
+    else {
+        Class symbolClass = [CPTPlotSymbol class];
+
+        for ( NSUInteger i = indexRange.location; i < maxIndex; i++ ) {
+            if ( drawPointFlags[i] ) {
+                NSUInteger entry = symbolIndices ? (NSUInteger)symbolIndices[i] : 0;
+
+                if ( entry < entryCount ) {
+                    CPTPlotSymbol *currentSymbol = symbolEntries[entry];
+
+                    if ( [currentSymbol isKindOfClass:symbolClass] ) {
+                        [currentSymbol renderAsVectorInContext:context atPoint:viewPoints[i] scale:CPTFloat(1.0)];
                     }
                 }
             }
         }
     }
+}
+
+/** @internal
+ *  @brief Returns the open data line through the given view points, reusing the one built for the last frame when the points have not moved.
+ *
+ *  The path is owned by the plot and stays valid until the next call or until the line shape properties change.
+ *  @param viewPoints A pointer to the array of view points.
+ *  @param indexRange The range of view points to connect.
+ *  @return           The data line path.
+ **/
+-(nonnull CGPathRef)dataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange
+{
+    CGPathRef dataLinePath = self.cachedDataLinePath;
+    NSData *cachedPoints   = self.cachedDataLineViewPoints;
+    CGFloat scale          = self.contentsScale;
+    size_t length          = indexRange.length * sizeof(CGPoint);
+
+    if ( !dataLinePath || (cachedPoints.length != length) || (self.cachedDataLineScale != scale) ||
+         (memcmp(cachedPoints.bytes, viewPoints + indexRange.location, length) != 0)) {
+        CGPathRef newPath = [self newDataLinePathForViewPoints:viewPoints indexRange:indexRange baselineYValue:CPTNAN];
+
+        self.cachedDataLinePath       = newPath;
+        self.cachedDataLineViewPoints = [NSData dataWithBytes:viewPoints + indexRange.location length:length];
+        self.cachedDataLineScale      = scale;
+        [self.cachedAreaFillPaths removeAllObjects];
+
+        CGPathRelease(newPath);
+        dataLinePath = newPath;
+    }
+
+    return dataLinePath;
+}
+
+/// @cond
+
+typedef struct {
+    CGMutablePathRef path;
+    CGFloat baselineYValue;
+    CGPoint firstPoint;
+    CGPoint currentPoint;
+    BOOL subpathOpen;
+} CPTScatterPlotFillPathBuilder;
+
+// drops the open subpath to the baseline and closes it
+static void CPTScatterPlotCloseFillSubpath(CPTScatterPlotFillPathBuilder *builder)
+{
+    if ( builder->subpathOpen ) {
+        CGPathAddLineToPoint(builder->path, NULL, builder->currentPoint.x, builder->baselineYValue);
+        CGPathAddLineToPoint(builder->path, NULL, builder->firstPoint.x, builder->baselineYValue);
+        CGPathCloseSubpath(builder->path);
+        builder->subpathOpen = NO;
+    }
+}
+
+static void CPTScatterPlotAppendFillPathElement(void *info, const CGPathElement *element)
+{
+    CPTScatterPlotFillPathBuilder *builder = (CPTScatterPlotFillPathBuilder *)info;
+    const CGPoint *points                  = element->points;
+
+    switch ( element->type ) {
+        case kCGPathElementMoveToPoint:
+            CPTScatterPlotCloseFillSubpath(builder);
+            CGPathMoveToPoint(builder->path, NULL, points[0].x, points[0].y);
+            builder->firstPoint   = points[0];
+            builder->currentPoint = points[0];
+            builder->subpathOpen  = YES;
+            break;
+
+        case kCGPathElementAddLineToPoint:
+            CGPathAddLineToPoint(builder->path, NULL, points[0].x, points[0].y);
+            builder->currentPoint = points[0];
+            break;
 
-    free(viewPoints);
-    free(drawPointFlags);
+        case kCGPathElementAddQuadCurveToPoint:
+            CGPathAddQuadCurveToPoint(builder->path, NULL, points[0].x, points[0].y, points[1].x, points[1].y);
+            builder->currentPoint = points[1];
+            break;
+
+        case kCGPathElementAddCurveToPoint:
+            CGPathAddCurveToPoint(builder->path, NULL, points[0].x, points[0].y, points[1].x, points[1].y, points[2].x, points[2].y);
+            builder->currentPoint = points[2];
+            break;
+
+        case kCGPathElementCloseSubpath:
+            CGPathCloseSubpath(builder->path);
+            builder->subpathOpen = NO;
+            break;
+    }
+}
+
+/// @endcond
+
+/** @internal
+ *  @brief Returns the area fill down to the given baseline, derived from the shared data line by closing each of its subpaths along the baseline.
+ *
+ *  The path is owned by the plot and stays valid until the data line is rebuilt.
+ *  @param viewPoints     A pointer to the array of view points.
+ *  @param indexRange     The range of view points to connect.
+ *  @param baselineYValue The y-coordinate of the baseline in view coordinates.
+ *  @return               The area fill path.
+ **/
+-(nonnull CGPathRef)areaFillPathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue
+{
+    CGPathRef dataLinePath = [self dataLinePathForViewPoints:viewPoints indexRange:indexRange];
+
+    NSMutableDictionary<NSNumber *, id> *fillPaths = self.cachedAreaFillPaths;
+
+    if ( !fillPaths ) {
+        fillPaths                = [[NSMutableDictionary alloc] init];
+        self.cachedAreaFillPaths = fillPaths;
+    }
+
+    NSNumber *baseline = @(baselineYValue);
+    id fillPath        = fillPaths[baseline];
+
+    if ( !fillPath ) {
+        CPTScatterPlotFillPathBuilder builder;
+        builder.path           = CGPathCreateMutable();
+        builder.baselineYValue = baselineYValue;
+        builder.firstPoint     = CGPointZero;
+        builder.currentPoint   = CGPointZero;
+        builder.subpathOpen    = NO;
+
+        CGPathApply(dataLinePath, &builder, CPTScatterPlotAppendFillPathElement);
+        CPTScatterPlotCloseFillSubpath(&builder);
+
+        fillPath            = (__bridge_transfer id)builder.path;
+        fillPaths[baseline] = fillPath;
+    }
+
+    return (__bridge CGPathRef)fillPath;
+}
+
+/** @internal
+ *  @brief Discards the cached data line and area fill paths so they are rebuilt on the next draw.
+ **/
+-(void)invalidateDataLinePath
+{
+    self.cachedDataLinePath       = NULL;
+    self.cachedDataLineViewPoints = nil;
+    [self.cachedAreaFillPaths removeAllObjects];
 }
 
 -(nonnull CGPathRef)newDataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue
@@ -975,6 +1292,19 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         return [self newCurvedDataLinePathForViewPoints:viewPoints indexRange:indexRange baselineYValue:baselineYValue];
     }
 
+    // Reduce each pixel column to its min/max envelope before building the path
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    if ((theInterpolation == CPTScatterPlotInterpolationLinear) && self.decimatesDataLine && !self.dataLineStyle.dashPattern && (indexRange.length > 4)) {
+        CGPoint *decimatedPoints = [arena allocateCount:indexRange.length size:sizeof(CGPoint)];
+
+        NSUInteger decimatedCount = [self decimateViewPoints:viewPoints indexRange:indexRange intoPoints:decimatedPoints];
+
+        viewPoints = decimatedPoints;
+        indexRange = NSMakeRange(0, decimatedCount);
+    }
+
     CGMutablePathRef dataLinePath  = CGPathCreateMutable();
     BOOL lastPointSkipped          = YES;
     CGPoint firstPoint             = CGPointZero;
@@ -985,7 +1315,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         lastDrawnPointIndex--;
     }
 
-    for ( NSUInteger i = indexRange.location; i <= lastDrawnPointIndex; i++ ) {
+    for ( NSUInteger i = indexRange.location; (i <= lastDrawnPointIndex) && (i < NSMaxRange(indexRange)); i++ ) {
         CGPoint viewPoint = viewPoints[i];
 
         if ( isnan(viewPoint.x) || isnan(viewPoint.y)) {
@@ -1043,9 +1373,96 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         CGPathCloseSubpath(dataLinePath);
     }
 
+    [arena resetToMark:scratchMark];
+
     return dataLinePath;
 }
 
+/** @internal
+ *  @brief Reduces runs of view points that fall in the same device pixel column to the first, minimum, maximum, and last point of the run.
+ *
+ *  Gaps (points with a NAN coordinate) are preserved as a single NAN point so the path is broken in the same places.
+ *  The output never holds more points than the input.
+ *
+ *  @param viewPoints      A pointer to the array of view points.
+ *  @param indexRange      The range of view points to decimate.
+ *  @param decimatedPoints A pointer to an array with room for at least @par{indexRange.length} points that receives the result.
+ *  @return                The number of points written to @par{decimatedPoints}.
+ **/
+-(NSUInteger)decimateViewPoints:(nonnull const CGPoint *)viewPoints indexRange:(NSRange)indexRange intoPoints:(nonnull CGPoint *)decimatedPoints
+{
+    CGFloat scale = self.contentsScale;
+
+    if ( scale <= CPTFloat(0.0)) {
+        scale = CPTFloat(1.0);
+    }
+
+    NSUInteger count    = 0;
+    NSUInteger maxIndex = NSMaxRange(indexRange);
+
+    BOOL inColumn       = NO;
+    CGFloat column      = CPTFloat(0.0);
+    NSUInteger firstIdx = 0;
+    NSUInteger minIdx   = 0;
+    NSUInteger maxIdx   = 0;
+    NSUInteger lastIdx  = 0;
+
+    for ( NSUInteger i = indexRange.location; i <= maxIndex; i++ ) {
+        CGPoint viewPoint = (i < maxIndex) ? viewPoints[i] : CPTPointMake(NAN, NAN);
+        BOOL isGap        = isnan(viewPoint.x) || isnan(viewPoint.y);
+        CGFloat newColumn = isGap ? CPTFloat(0.0) : floor(viewPoint.x * scale);
+
+        if ( inColumn && !isGap && (newColumn == column)) {
+            if ( viewPoint.y < viewPoints[minIdx].y ) {
+                minIdx = i;
+            }
+            if ( viewPoint.y > viewPoints[maxIdx].y ) {
+                maxIdx = i;
+            }
+            lastIdx = i;
+            continue;
+        }
+
+        // Flush the finished column in record order
+        if ( inColumn ) {
+            NSUInteger lowIdx  = MIN(minIdx, maxIdx);
+            NSUInteger highIdx = MAX(minIdx, maxIdx);
+
+            decimatedPoints[count++] = viewPoints[firstIdx];
+            if ((lowIdx != firstIdx) && (lowIdx != lastIdx)) {
+                decimatedPoints[count++] = viewPoints[lowIdx];
+            }
+            if ((highIdx != lowIdx) && (highIdx != firstIdx) && (highIdx != lastIdx)) {
+                decimatedPoints[count++] = viewPoints[highIdx];
+            }
+            if ( lastIdx != firstIdx ) {
+                decimatedPoints[count++] = viewPoints[lastIdx];
+            }
+            inColumn = NO;
+        }
+
+        if ( i == maxIndex ) {
+            break;
+        }
+
+        if ( isGap ) {
+            if ((count > 0) && !isnan(decimatedPoints[count - 1].x)) {
+                decimatedPoints[count++] = CPTPointMake(NAN, NAN);
+            }
+        }
+        else {
+            inColumn = YES;
+            column   = newColumn;
+            firstIdx = i;
+            minIdx   = i;
+            maxIdx   = i;
+            lastIdx  = i;
+        }
+    }
+
+    return count;
+}
+
 -(nonnull CGPathRef)newCurvedDataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue
 {
     CGMutablePathRef dataLinePath  = CGPathCreateMutable();
@@ -1058,8 +1475,11 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     CPTScatterPlotCurvedInterpolationOption interpolationOption = self.curvedInterpolationOption;
 
     if ( lastDrawnPointIndex > 0 ) {
-        CGPoint *controlPoints1 = calloc(lastDrawnPointIndex, sizeof(CGPoint));
-        CGPoint *controlPoints2 = calloc(lastDrawnPointIndex, sizeof(CGPoint));
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *controlPoints1 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
+        CGPoint *controlPoints2 = [arena allocateCount:lastDrawnPointIndex size:sizeof(CGPoint)];
 
         lastDrawnPointIndex--;
 
@@ -1239,8 +1659,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
             CGPathCloseSubpath(dataLinePath);
         }
 
-        free(controlPoints1);
-        free(controlPoints2);
+        [arena resetToMark:scratchMark];
     }
 
     return dataLinePath;
@@ -1488,10 +1907,13 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
         NSUInteger n = indexRange.length - 1;
 
         // rhs vector
-        CGPoint *a = calloc(n, sizeof(CGPoint));
-        CGPoint *b = calloc(n, sizeof(CGPoint));
-        CGPoint *c = calloc(n, sizeof(CGPoint));
-        CGPoint *r = calloc(n, sizeof(CGPoint));
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *a = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *b = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *c = [arena allocateCount:n size:sizeof(CGPoint)];
+        CGPoint *r = [arena allocateCount:n size:sizeof(CGPoint)];
 
         // left most segment
         a[0] = CGPointZero;
@@ -1555,10 +1977,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
                                     CPTFloat(0.5) * (viewPoints[rangeEnd].y + cp1[rangeEnd].y));
 
         // clean up
-        free(a);
-        free(b);
-        free(c);
-        free(r);
+        [arena resetToMark:scratchMark];
     }
 }
 
@@ -1641,8 +2060,11 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     }
 
     // Calculate view points
-    CGPoint *viewPoints  = calloc(dataCount, sizeof(CGPoint));
-    BOOL *drawPointFlags = calloc(dataCount, sizeof(BOOL));
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+    BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
     for ( NSUInteger i = 0; i < dataCount; i++ ) {
         drawPointFlags[i] = YES;
@@ -1655,8 +2077,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
                                                      indexRange:NSMakeRange(0, dataCount)
                                                  baselineYValue:CPTNAN];
 
-    free(viewPoints);
-    free(drawPointFlags);
+    [arena resetToMark:scratchMark];
 
     return dataLinePath;
 }
@@ -2142,8 +2563,11 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     NSUInteger dataCount     = self.cachedDataCount;
 
     if ( theGraph && thePlotArea && !self.hidden && dataCount ) {
-        CGPoint *viewPoints  = calloc(dataCount, sizeof(CGPoint));
-        BOOL *drawPointFlags = calloc(dataCount, sizeof(BOOL));
+        _CPTScratchArena *arena = self.scratchArena;
+        NSUInteger scratchMark  = arena.mark;
+
+        CGPoint *viewPoints  = [arena allocateCount:dataCount size:sizeof(CGPoint)];
+        BOOL *drawPointFlags = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
         CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
         [self calculatePointsToDraw:drawPointFlags forPlotSpace:thePlotSpace includeVisiblePointsOnly:NO numberOfPoints:dataCount];
@@ -2169,8 +2593,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
             CGPathRelease(path);
         }
 
-        free(viewPoints);
-        free(drawPointFlags);
+        [arena resetToMark:scratchMark];
     }
 
     return plotLineHit;
@@ -2183,10 +2606,19 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 
 /// @cond
 
+-(void)setCachedDataLinePath:(nullable CGPathRef)newPath
+{
+    if ( cachedDataLinePath != newPath ) {
+        CGPathRelease(cachedDataLinePath);
+        cachedDataLinePath = CGPathRetain(newPath);
+    }
+}
+
 -(void)setInterpolation:(CPTScatterPlotInterpolation)newInterpolation
 {
     if ( newInterpolation != interpolation ) {
         interpolation = newInterpolation;
+        [self invalidateDataLinePath];
         [self setNeedsDisplay];
     }
 }
@@ -2195,6 +2627,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 {
     if ( newHistogramOption != histogramOption ) {
         histogramOption = newHistogramOption;
+        [self invalidateDataLinePath];
         [self setNeedsDisplay];
     }
 }
@@ -2203,6 +2636,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 {
     if ( newCurvedInterpolationOption != curvedInterpolationOption ) {
         curvedInterpolationOption = newCurvedInterpolationOption;
+        [self invalidateDataLinePath];
         [self setNeedsDisplay];
     }
 }
@@ -2218,6 +2652,16 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 
     if ( newCurvedInterpolationCustomAlpha != curvedInterpolationCustomAlpha ) {
         curvedInterpolationCustomAlpha = newCurvedInterpolationCustomAlpha;
+        [self invalidateDataLinePath];
+        [self setNeedsDisplay];
+    }
+}
+
+-(void)setDecimatesDataLine:(BOOL)newDecimatesDataLine
+{
+    if ( newDecimatesDataLine != decimatesDataLine ) {
+        decimatesDataLine = newDecimatesDataLine;
+        [self invalidateDataLinePath];
         [self setNeedsDisplay];
     }
 }
@@ -2234,6 +2678,10 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 -(void)setDataLineStyle:(nullable CPTLineStyle *)newLineStyle
 {
     if ( dataLineStyle != newLineStyle ) {
+        if ((dataLineStyle.dashPattern != nil) != (newLineStyle.dashPattern != nil)) {
+            // dashed lines are never decimated
+            [self invalidateDataLinePath];
+        }
         dataLineStyle = [newLineStyle copy];
         [self setNeedsDisplay];
         [[NSNotificationCenter defaultCenter] postNotificationName:CPTLegendNeedsRedrawForPlotNotification object:self];
@@ -2318,6 +2766,7 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
 -(void)setPlotSymbols:(nullable CPTPlotSymbolArray *)newSymbols
 {
     [self cacheArray:newSymbols forKey:CPTScatterPlotBindingPlotSymbols];
+    [self updatePlotSymbolIndices];
     [self setNeedsDisplay];
 }
 
@@ -2326,6 +2775,14 @@ CPTScatterPlotBinding const CPTScatterPlotBindingPlotSymbols = @"plotSymbols"; /
     return [self cachedArrayForKey:CPTScatterPlotBindingPlotSymbols];
 }
 
+-(nonnull _CPTPlotSymbolAtlas *)symbolAtlas
+{
+    if ( !symbolAtlas ) {
+        symbolAtlas = [[_CPTPlotSymbolAtlas alloc] init];
+    }
+    return symbolAtlas;
+}
+
 /// @endcond
 
 @end
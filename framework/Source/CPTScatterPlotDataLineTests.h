@@ -0,0 +1,9 @@
+#import "CPTTestCase.h"
+
+@class CPTScatterPlot;
+
+@interface CPTScatterPlotDataLineTests : CPTTestCase
+
+@property (nonatomic, readwrite, strong, nullable) CPTScatterPlot *plot;
+
+@end
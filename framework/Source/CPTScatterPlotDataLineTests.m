@@ -0,0 +1,61 @@
+#import "CPTScatterPlotDataLineTests.h"
+
+#import "CPTScatterPlot.h"
+#import "CPTUtilities.h"
+
+@interface CPTScatterPlot(Testing)
+
+-(nonnull CGPathRef)dataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange;
+-(nonnull CGPathRef)areaFillPathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue;
+-(nonnull CGPathRef)newDataLinePathForViewPoints:(nonnull CGPoint *)viewPoints indexRange:(NSRange)indexRange baselineYValue:(CGFloat)baselineYValue;
+
+@end
+
+#pragma mark -
+
+@implementation CPTScatterPlotDataLineTests
+
+@synthesize plot;
+
+-(void)setUp
+{
+    self.plot = [CPTScatterPlot new];
+}
+
+-(void)tearDown
+{
+    self.plot = nil;
+}
+
+#pragma mark -
+#pragma mark Shared data line
+
+-(void)testAreaFillPathSharesDataLine
+{
+    CPTScatterPlot *thePlot = self.plot;
+
+    CGPoint viewPoints[6] = {
+        { 0.0, 1.0 }, { 1.0, 3.0 }, { 2.0, 2.0 }, { NAN, NAN }, { 4.0, 5.0 }, { 5.0, 4.0 }
+    };
+    NSRange indexRange = NSMakeRange(0, 6);
+
+    thePlot.interpolation = CPTScatterPlotInterpolationCurved;
+
+    CGPathRef dataLinePath = CGPathRetain([thePlot dataLinePathForViewPoints:viewPoints indexRange:indexRange]);
+    XCTAssertEqual([thePlot dataLinePathForViewPoints:viewPoints indexRange:indexRange], dataLinePath, @"Unchanged view points reuse the data line");
+
+    CGPathRef expectedLine = [thePlot newDataLinePathForViewPoints:viewPoints indexRange:indexRange baselineYValue:CPTNAN];
+    XCTAssertTrue(CGPathEqualToPath(dataLinePath, expectedLine), @"Shared data line matches a freshly built one");
+    CGPathRelease(expectedLine);
+
+    CGPathRef expectedFill = [thePlot newDataLinePathForViewPoints:viewPoints indexRange:indexRange baselineYValue:CPTFloat(0.5)];
+    CGPathRef fillPath     = [thePlot areaFillPathForViewPoints:viewPoints indexRange:indexRange baselineYValue:CPTFloat(0.5)];
+    XCTAssertTrue(CGPathEqualToPath(fillPath, expectedFill), @"Fill derived from the data line matches a freshly built one");
+    CGPathRelease(expectedFill);
+
+    viewPoints[1].y = CPTFloat(2.5);
+    XCTAssertFalse(CGPathEqualToPath([thePlot dataLinePathForViewPoints:viewPoints indexRange:indexRange], dataLinePath), @"Moved view points rebuild the data line");
+    CGPathRelease(dataLinePath);
+}
+
+@end
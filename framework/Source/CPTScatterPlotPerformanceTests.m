@@ -0,0 +1,127 @@
+#import "CPTScatterPlotPerformanceTests.h"
+
+#import "CPTMutableNumericData.h"
+#import "CPTPlotRange.h"
+#import "CPTScatterPlot.h"
+#import "CPTXYPlotSpace.h"
+#import "_CPTRangeClassification.h"
+
+static const NSUInteger numberOfPoints = 1000000;
+
+@interface CPTScatterPlot(PerformanceTesting)
+
+-(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace includeVisiblePointsOnly:(BOOL)visibleOnly numberOfPoints:(NSUInteger)dataCount;
+
+@end
+
+@interface CPTScatterPlotPerformanceTests()
+
+@property (nonatomic, readwrite, strong, nullable) CPTScatterPlot *plot;
+@property (nonatomic, readwrite, strong, nullable) CPTXYPlotSpace *plotSpace;
+
+@end
+
+@implementation CPTScatterPlotPerformanceTests
+
+@synthesize plot;
+@synthesize plotSpace;
+
+-(void)setUp
+{
+    NSMutableData *xData = [[NSMutableData alloc] initWithLength:numberOfPoints * sizeof(double)];
+    NSMutableData *yData = [[NSMutableData alloc] initWithLength:numberOfPoints * sizeof(double)];
+    double *xSamples     = (double *)xData.mutableBytes;
+    double *ySamples     = (double *)yData.mutableBytes;
+
+    for ( NSUInteger i = 0; i < numberOfPoints; i++ ) {
+        xSamples[i] = (double)i / numberOfPoints;
+        ySamples[i] = (i % 1000 == 0) ? NAN : sin(i * 0.001);
+    }
+
+    CPTNumericDataType doubleType = CPTDataType(CPTFloatingPointDataType, sizeof(double), CFByteOrderGetCurrent());
+
+    self.plot                = [CPTScatterPlot new];
+    self.plot.cachePrecision = CPTPlotCachePrecisionDouble;
+    [self.plot cacheNumbers:[[CPTMutableNumericData alloc] initWithData:xData dataType:doubleType shape:nil] forField:CPTScatterPlotFieldX];
+    [self.plot cacheNumbers:[[CPTMutableNumericData alloc] initWithData:yData dataType:doubleType shape:nil] forField:CPTScatterPlotFieldY];
+
+    self.plotSpace        = [[CPTXYPlotSpace alloc] init];
+    self.plotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@0.25 length:@0.5];
+    self.plotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@(-0.5) length:@1.0];
+}
+
+-(void)tearDown
+{
+    self.plot      = nil;
+    self.plotSpace = nil;
+}
+
+-(void)testCalculatePointsToDraw
+{
+    CPTScatterPlot *thePlot      = self.plot;
+    CPTXYPlotSpace *thePlotSpace = self.plotSpace;
+    BOOL *drawFlags              = calloc(numberOfPoints, sizeof(BOOL));
+
+    [self measureBlock:^{
+        [thePlot calculatePointsToDraw:drawFlags forPlotSpace:thePlotSpace includeVisiblePointsOnly:NO numberOfPoints:numberOfPoints];
+    }];
+
+    free(drawFlags);
+}
+
+// The classification as it was done before the C kernel, one range comparison message per sample
+// on the global queue, for comparison with testCalculatePointsToDraw.
+-(void)testCalculatePointsToDrawWithRangeComparisons
+{
+    const double *xBytes = (const double *)[self.plot cachedNumbersForField:CPTScatterPlotFieldX].data.bytes;
+    const double *yBytes = (const double *)[self.plot cachedNumbersForField:CPTScatterPlotFieldY].data.bytes;
+    CPTPlotRange *xRange = self.plotSpace.xRange;
+    CPTPlotRange *yRange = self.plotSpace.yRange;
+    BOOL *drawFlags      = calloc(numberOfPoints, sizeof(BOOL));
+
+    [self measureBlock:^{
+        CPTPlotRangeComparisonResult *xRangeFlags = calloc(numberOfPoints, sizeof(CPTPlotRangeComparisonResult));
+        CPTPlotRangeComparisonResult *yRangeFlags = calloc(numberOfPoints, sizeof(CPTPlotRangeComparisonResult));
+        BOOL *nanFlags                            = calloc(numberOfPoints, sizeof(BOOL));
+
+        dispatch_apply(numberOfPoints, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+            CPTPlotRangeComparisonResult xFlag = [xRange compareToDouble:xBytes[i]];
+            xRangeFlags[i] = xFlag;
+            yRangeFlags[i] = (xFlag != CPTPlotRangeComparisonResultNumberInRange) ? CPTPlotRangeComparisonResultNumberInRange : [yRange compareToDouble:yBytes[i]];
+            nanFlags[i]    = isnan(xBytes[i]) || isnan(yBytes[i]);
+        });
+
+        memset(drawFlags, NO, numberOfPoints * sizeof(BOOL));
+        drawFlags[0] = (xRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange) && (yRangeFlags[0] == CPTPlotRangeComparisonResultNumberInRange) && !nanFlags[0];
+        for ( NSUInteger i = 1; i < numberOfPoints; i++ ) {
+            if ( !nanFlags[i - 1] && !nanFlags[i] && ((xRangeFlags[i - 1] != xRangeFlags[i]) || (yRangeFlags[i - 1] != yRangeFlags[i]))) {
+                drawFlags[i - 1] = YES;
+                drawFlags[i]     = YES;
+            }
+            else if ((xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
+                     (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
+                     !nanFlags[i] ) {
+                drawFlags[i] = YES;
+            }
+        }
+
+        free(xRangeFlags);
+        free(yRangeFlags);
+        free(nanFlags);
+    }];
+
+    // the kernel keeps the same points
+    BOOL *kernelFlags = calloc(numberOfPoints, sizeof(BOOL));
+
+    CPTRangeClassificationFlagPoints(kernelFlags, xBytes, yBytes, numberOfPoints,
+                                     CPTRangeClassificationLimitsForRange(xRange),
+                                     CPTRangeClassificationLimitsForRange(yRange),
+                                     CPTRangeClassificationExpansionOne);
+
+    XCTAssertEqual(memcmp(drawFlags, kernelFlags, numberOfPoints * sizeof(BOOL)), 0, @"Range comparisons and the classification kernel draw the same points");
+
+    free(kernelFlags);
+    free(drawFlags);
+}
+
+@end
@@ -7,11 +7,14 @@
 @interface CPTScatterPlot(Testing)
 
 -(void)calculatePointsToDraw:(nonnull BOOL *)pointDrawFlags forPlotSpace:(nonnull CPTXYPlotSpace *)xyPlotSpace includeVisiblePointsOnly:(BOOL)visibleOnly numberOfPoints:(NSUInteger)dataCount;
+-(NSUInteger)decimateViewPoints:(nonnull const CGPoint *)viewPoints indexRange:(NSRange)indexRange intoPoints:(nonnull CGPoint *)decimatedPoints;
 -(void)setXValues:(nullable CPTNumberArray *)newValues;
 -(void)setYValues:(nullable CPTNumberArray *)newValues;
 
 @end
 
+#pragma mark -
+
 @implementation CPTScatterPlotTests
 
 @synthesize plot;
@@ -246,4 +249,51 @@
     free(drawFlags);
 }
 
+#pragma mark -
+#pragma mark Decimation
+
+-(void)testDecimateViewPointsSingleColumn
+{
+    const NSUInteger count = 100;
+    CGPoint *viewPoints    = calloc(count, sizeof(CGPoint));
+    CGPoint *decimated     = calloc(count, sizeof(CGPoint));
+
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        viewPoints[i] = CGPointMake(0.1 + 0.005 * i, sin((double)i));
+    }
+    viewPoints[20].y = -5.0;
+    viewPoints[70].y = 5.0;
+
+    self.plot.contentsScale = 1.0;
+    NSUInteger decimatedCount = [self.plot decimateViewPoints:viewPoints indexRange:NSMakeRange(0, count) intoPoints:decimated];
+
+    XCTAssertEqual(decimatedCount, (NSUInteger)4, @"Single column reduced to first/min/max/last");
+    XCTAssertEqual(decimated[0].y, viewPoints[0].y, @"First point");
+    XCTAssertEqual(decimated[1].y, -5.0, @"Minimum point");
+    XCTAssertEqual(decimated[2].y, 5.0, @"Maximum point");
+    XCTAssertEqual(decimated[3].y, viewPoints[count - 1].y, @"Last point");
+
+    free(viewPoints);
+    free(decimated);
+}
+
+-(void)testDecimateViewPointsPreservesGaps
+{
+    const NSUInteger count = 9;
+    CGPoint viewPoints[9]  = {
+        { 0.1, 1.0 }, { 0.2, 2.0 }, { 0.3, 0.0 },
+        { NAN, NAN }, { NAN, NAN },
+        { 0.4, 3.0 }, { 1.5, 1.0 }, { 2.5, 4.0 }, { 2.6, 4.5 }
+    };
+    CGPoint decimated[9];
+
+    self.plot.contentsScale = 1.0;
+    NSUInteger decimatedCount = [self.plot decimateViewPoints:viewPoints indexRange:NSMakeRange(0, count) intoPoints:decimated];
+
+    XCTAssertEqual(decimatedCount, (NSUInteger)8, @"Gap collapsed to a single point");
+    XCTAssertTrue(isnan(decimated[3].x), @"Gap preserved");
+    XCTAssertEqual(decimated[4].y, 3.0, @"Point after gap starts a new column");
+    XCTAssertEqual(decimated[7].y, 4.5, @"Last point of final column");
+}
+
 @end
@@ -13,6 +13,7 @@
 #import "CPTXYPlotSpace.h"
 #import "NSCoderExtensions.h"
 #import "NSNumberExtensions.h"
+#import "_CPTScratchArena.h"
 #import <tgmath.h>
 
 /** @defgroup plotAnimationTradingRangePlot Trading Range Plot
@@ -42,6 +43,168 @@ CPTTradingRangePlotBinding const CPTTradingRangePlotBindingBarWidths          =
 static const CPTCoordinate independentCoord = CPTCoordinateX;
 static const CPTCoordinate dependentCoord   = CPTCoordinateY;
 
+/// @cond
+
+// bars drawn with the same fill and line style, collected so each style is set once per frame
+@interface _CPTTradingRangeBatch : NSObject
+
+@property (nonatomic, readonly, strong, nullable) CPTFill *fill;
+@property (nonatomic, readonly, strong, nullable) CPTLineStyle *lineStyle;
+// candlesticks with open == close are filled with the line color of their line style
+@property (nonatomic, readonly) BOOL fillsWithLineColor;
+@property (nonatomic, readonly, nonnull) CGMutablePathRef fillPath;
+@property (nonatomic, readonly, nonnull) CGMutablePathRef strokePath;
+
+-(nonnull instancetype)initWithFill:(nullable CPTFill *)newFill lineStyle:(nullable CPTLineStyle *)newLineStyle fillsWithLineColor:(BOOL)newFillsWithLineColor NS_DESIGNATED_INITIALIZER;
+
+-(void)drawInContext:(nonnull CGContextRef)context;
+
+@end
+
+@implementation _CPTTradingRangeBatch
+
+@synthesize fill;
+@synthesize lineStyle;
+@synthesize fillsWithLineColor;
+@synthesize fillPath;
+@synthesize strokePath;
+
+-(nonnull instancetype)initWithFill:(nullable CPTFill *)newFill lineStyle:(nullable CPTLineStyle *)newLineStyle fillsWithLineColor:(BOOL)newFillsWithLineColor
+{
+    if ((self = [super init])) {
+        fill               = newFill;
+        lineStyle          = newLineStyle;
+        fillsWithLineColor = newFillsWithLineColor;
+        fillPath           = CGPathCreateMutable();
+        strokePath         = CGPathCreateMutable();
+    }
+    return self;
+}
+
+-(nonnull instancetype)init
+{
+    return [self initWithFill:nil lineStyle:nil fillsWithLineColor:NO];
+}
+
+-(void)dealloc
+{
+    CGPathRelease(fillPath);
+    CGPathRelease(strokePath);
+}
+
+-(void)drawInContext:(nonnull CGContextRef)context
+{
+    CPTFill *theFill           = self.fill;
+    CPTLineStyle *theLineStyle = self.lineStyle;
+
+    if ( self.fillsWithLineColor ) {
+        CPTColor *lineColor = theLineStyle.lineColor;
+        if ( lineColor ) {
+            theFill = [CPTFill fillWithColor:lineColor];
+        }
+    }
+
+    if ( theFill && !CGPathIsEmpty(fillPath)) {
+        CGContextBeginPath(context);
+        CGContextAddPath(context, fillPath);
+        [theFill fillPathInContext:context];
+    }
+
+    if ( theLineStyle && !CGPathIsEmpty(strokePath)) {
+        [theLineStyle setLineStyleInContext:context];
+        CGContextBeginPath(context);
+        CGContextAddPath(context, strokePath);
+        [theLineStyle strokePathInContext:context];
+    }
+}
+
+@end
+
+// the batch for a fill and line style, added to batches if there is none yet. Column aggregation
+// keeps the number of bars, and so of batches, down to the pixel width of the plot.
+static _CPTTradingRangeBatch *CPTTradingRangeBatchForStyles(NSMutableArray<_CPTTradingRangeBatch *> *batches, CPTFill *fill, CPTLineStyle *lineStyle, BOOL fillsWithLineColor)
+{
+    // gradients and images are laid out over the bounds of the path, so those bars get a batch of their own
+    BOOL sharesBatch = ((fill == nil) || (fill.cgColor != NULL)) &&
+                       ((lineStyle == nil) || ((lineStyle.lineFill == nil) && (lineStyle.lineGradient == nil)));
+
+    if ( sharesBatch ) {
+        // neighbouring bars usually share their styles so start with the newest batch
+        for ( _CPTTradingRangeBatch *batch in batches.reverseObjectEnumerator ) {
+            if ((batch.fill == fill) && (batch.lineStyle == lineStyle) && (batch.fillsWithLineColor == fillsWithLineColor)) {
+                return batch;
+            }
+        }
+    }
+
+    _CPTTradingRangeBatch *newBatch = [[_CPTTradingRangeBatch alloc] initWithFill:fill lineStyle:lineStyle fillsWithLineColor:fillsWithLineColor];
+
+    [batches addObject:newBatch];
+
+    return newBatch;
+}
+
+// adds the candlestick body through points, right edge first, to path
+static void CPTTradingRangeAddBody(CGMutablePathRef path, const CGPoint *points, CGFloat radius)
+{
+    CGPathMoveToPoint(path, NULL, points[0].x, points[0].y);
+    CGPathAddArcToPoint(path, NULL, points[1].x, points[1].y, points[2].x, points[2].y, radius);
+    CGPathAddArcToPoint(path, NULL, points[3].x, points[3].y, points[4].x, points[4].y, radius);
+    CGPathAddLineToPoint(path, NULL, points[4].x, points[4].y);
+    CGPathCloseSubpath(path);
+}
+
+// index of the first of the ascending locations above value, or not below it unless includeEqual is set
+static NSUInteger CPTTradingRangeSearchDoubles(const double *locations, NSUInteger count, double value, BOOL includeEqual)
+{
+    NSUInteger low  = 0;
+    NSUInteger high = count;
+
+    while ( low < high ) {
+        NSUInteger mid  = low + (high - low) / 2;
+        double location = locations[mid];
+
+        if ((location < value) || (includeEqual && (location == value))) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static NSUInteger CPTTradingRangeSearchDecimals(const NSDecimal *locations, NSUInteger count, NSDecimal value, BOOL includeEqual)
+{
+    NSUInteger low  = 0;
+    NSUInteger high = count;
+
+    while ( low < high ) {
+        NSUInteger mid     = low + (high - low) / 2;
+        NSDecimal location = locations[mid];
+
+        if ( CPTDecimalLessThan(location, value) || (includeEqual && CPTDecimalEquals(location, value))) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// doubles of the NSDecimal numbers in range
+static void CPTTradingRangeGetDoubles(double *doubles, CPTNumericData *numbers, NSRange range)
+{
+    const NSDecimal *decimals = (const NSDecimal *)numbers.data.bytes + range.location;
+
+    for ( NSUInteger i = 0; i < range.length; i++ ) {
+        doubles[i] = CPTDecimalDoubleValue(decimals[i]);
+    }
+}
+
+/// @endcond
+
 /// @cond
 @interface CPTTradingRangePlot()
 
@@ -57,9 +220,17 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
 @property (nonatomic, readwrite, copy, nullable) CPTLineStyleArray *decreaseLineStyles;
 @property (nonatomic, readwrite, copy, nullable) CPTLineStyleArray *barWidths;
 @property (nonatomic, readwrite, assign) NSUInteger pointingDeviceDownIndex;
+@property (nonatomic, readwrite, weak, nullable) CPTNumericData *sortedLocations;
+@property (nonatomic, readwrite, assign) NSUInteger sortedLocationCount;
 
 -(void)drawCandleStickInContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue width:(CGFloat)width alignPoints:(BOOL)alignPoints;
 -(void)drawOHLCInContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue alignPoints:(BOOL)alignPoints;
+-(void)addCandleStickToBatches:(nonnull NSMutableArray<_CPTTradingRangeBatch *> *)batches inContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue width:(CGFloat)width alignPoints:(BOOL)alignPoints;
+-(void)addOHLCToBatches:(nonnull NSMutableArray<_CPTTradingRangeBatch *> *)batches inContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue alignPoints:(BOOL)alignPoints;
+
+-(CGFloat)maximumBarReach;
+-(NSRange)visibleRecordRangeForLocations:(nonnull CPTNumericData *)locations minimumViewX:(CGFloat)minimumViewX maximumViewX:(CGFloat)maximumViewX;
+-(BOOL)locationsAreSorted:(nonnull CPTNumericData *)locations;
 
 -(nullable CPTFill *)increaseFillForIndex:(NSUInteger)idx;
 -(nullable CPTFill *)decreaseFillForIndex:(NSUInteger)idx;
@@ -160,6 +331,18 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
  **/
 @synthesize pointingDeviceDownIndex;
 
+/** @internal
+ *  @property nullable CPTNumericData *sortedLocations
+ *  @brief The x values last checked for ascending order.
+ **/
+@synthesize sortedLocations;
+
+/** @internal
+ *  @property NSUInteger sortedLocationCount
+ *  @brief The number of leading records of @ref sortedLocations known to be in ascending order.
+ **/
+@synthesize sortedLocationCount;
+
 #pragma mark -
 #pragma mark Init/Dealloc
 
@@ -251,6 +434,10 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
         showBarBorder     = theLayer->showBarBorder;
 
         pointingDeviceDownIndex = NSNotFound;
+
+        // render snapshots share the cached locations, so the sort check carries over
+        sortedLocations     = theLayer->sortedLocations;
+        sortedLocationCount = theLayer->sortedLocationCount;
     }
     return self;
 }
@@ -338,10 +525,30 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
     [self reloadBarWidthsInIndexRange:indexRange];
 }
 
+-(void)cacheNumbers:(nullable id)numbers forField:(NSUInteger)fieldEnum
+{
+    [super cacheNumbers:numbers forField:fieldEnum];
+
+    if ( fieldEnum == CPTTradingRangePlotFieldX ) {
+        self.sortedLocationCount = 0;
+    }
+}
+
+-(void)cacheNumbers:(nullable id)numbers forField:(NSUInteger)fieldEnum atRecordIndex:(NSUInteger)idx
+{
+    [super cacheNumbers:numbers forField:fieldEnum atRecordIndex:idx];
+
+    if ( fieldEnum == CPTTradingRangePlotFieldX ) {
+        self.sortedLocationCount = MIN(self.sortedLocationCount, idx);
+    }
+}
+
 -(void)reloadPlotDataInIndexRange:(NSRange)indexRange
 {
     [super reloadPlotDataInIndexRange:indexRange];
 
+    self.sortedLocationCount = MIN(self.sortedLocationCount, indexRange.location);
+
     if ( ![self loadNumbersForAllFieldsFromDataSourceInRecordIndexRange:indexRange] ) {
         id<CPTTradingRangePlotDataSource> theDataSource = (id<CPTTradingRangePlotDataSource>)self.dataSource;
 
@@ -634,204 +841,328 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
 
     [super renderAsVectorInContext:context];
 
-    CGPoint openPoint, highPoint, lowPoint, closePoint;
-
     CPTPlotSpace *thePlotSpace            = self.plotSpace;
     CPTTradingRangePlotStyle thePlotStyle = self.plotStyle;
     BOOL alignPoints                      = self.alignsPointsToPixels;
 
-    CGContextBeginTransparencyLayer(context, NULL);
+    // bars are merged by pixel column, which only makes sense when x alone decides the view x coordinate
+    BOOL aggregatesBars = [thePlotSpace isKindOfClass:[CPTXYPlotSpace class]];
+
+    // a bar further than its reach outside the area being drawn cannot touch it
+    CGRect clipRect      = CGContextGetClipBoundingBox(context);
+    CGFloat reach        = [self maximumBarReach];
+    CGFloat minimumViewX = CGRectGetMinX(clipRect) - reach;
+    CGFloat maximumViewX = CGRectGetMaxX(clipRect) + reach;
+
+    NSRange visibleRange    = [self visibleRecordRangeForLocations:locations minimumViewX:minimumViewX maximumViewX:maximumViewX];
+    NSUInteger visibleCount = visibleRange.length;
+
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    const double *locationValues;
+    const double *openValues;
+    const double *highValues;
+    const double *lowValues;
+    const double *closeValues;
 
     if ( self.doublePrecisionCache ) {
-        const double *locationBytes = (const double *)locations.data.bytes;
-        const double *openBytes     = (const double *)opens.data.bytes;
-        const double *highBytes     = (const double *)highs.data.bytes;
-        const double *lowBytes      = (const double *)lows.data.bytes;
-        const double *closeBytes    = (const double *)closes.data.bytes;
+        locationValues = (const double *)locations.data.bytes + visibleRange.location;
+        openValues     = (const double *)opens.data.bytes + visibleRange.location;
+        highValues     = (const double *)highs.data.bytes + visibleRange.location;
+        lowValues      = (const double *)lows.data.bytes + visibleRange.location;
+        closeValues    = (const double *)closes.data.bytes + visibleRange.location;
+    }
+    else {
+        double *doubleValues = [arena allocateCount:visibleCount * 5 size:sizeof(double)];
 
-        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
-            double plotPoint[2];
-            plotPoint[independentCoord] = *locationBytes++;
-            if ( isnan(plotPoint[independentCoord])) {
-                openBytes++;
-                highBytes++;
-                lowBytes++;
-                closeBytes++;
+        CPTTradingRangeGetDoubles(doubleValues, locations, visibleRange);
+        CPTTradingRangeGetDoubles(doubleValues + visibleCount, opens, visibleRange);
+        CPTTradingRangeGetDoubles(doubleValues + visibleCount * 2, highs, visibleRange);
+        CPTTradingRangeGetDoubles(doubleValues + visibleCount * 3, lows, visibleRange);
+        CPTTradingRangeGetDoubles(doubleValues + visibleCount * 4, closes, visibleRange);
+
+        locationValues = doubleValues;
+        openValues     = doubleValues + visibleCount;
+        highValues     = doubleValues + visibleCount * 2;
+        lowValues      = doubleValues + visibleCount * 3;
+        closeValues    = doubleValues + visibleCount * 4;
+    }
+
+    // bars left to draw, each holding the record index its styles come from
+    NSUInteger *barIndexes = [arena allocateCount:visibleCount size:sizeof(NSUInteger)];
+    double *barValues      = [arena allocateCount:visibleCount * 5 size:sizeof(double)];
+    double *barLocations   = barValues;
+    double *barOpens       = barValues + visibleCount;
+    double *barHighs       = barValues + visibleCount * 2;
+    double *barLows        = barValues + visibleCount * 3;
+    double *barCloses      = barValues + visibleCount * 4;
+    NSUInteger barCount    = 0;
+
+    if ( aggregatesBars ) {
+        CGPoint *locationPoints = [arena allocateCount:visibleCount size:sizeof(CGPoint)];
+
+        [thePlotSpace plotAreaViewPoints:locationPoints forDoublePrecisionXValues:locationValues yValues:openValues numberOfPoints:visibleCount];
+
+        // bars landing in the same pixel column are drawn as one with the first open, highest high, lowest low and last close
+        CGFloat columnScale = self.contentsScale;
+        CGFloat lastColumn  = CPTFloat(0.0);
+
+        for ( NSUInteger i = 0; i < visibleCount; i++ ) {
+            CGFloat viewX = locationPoints[i].x;
+
+            if ( isnan(locationValues[i]) || isnan(viewX) || (viewX < minimumViewX) || (viewX > maximumViewX)) {
                 continue;
             }
 
-            // open point
-            plotPoint[dependentCoord] = *openBytes++;
-            if ( isnan(plotPoint[dependentCoord])) {
-                openPoint = CPTPointMake(NAN, NAN);
-            }
-            else {
-                openPoint = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+            CGFloat column = floor(viewX * columnScale);
 
-            // high point
-            plotPoint[dependentCoord] = *highBytes++;
-            if ( isnan(plotPoint[dependentCoord])) {
-                highPoint = CPTPointMake(NAN, NAN);
-            }
-            else {
-                highPoint = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+            if ((barCount > 0) && (column == lastColumn)) {
+                NSUInteger bar = barCount - 1;
 
-            // low point
-            plotPoint[dependentCoord] = *lowBytes++;
-            if ( isnan(plotPoint[dependentCoord])) {
-                lowPoint = CPTPointMake(NAN, NAN);
+                if ( isnan(barOpens[bar])) {
+                    barOpens[bar] = openValues[i];
+                }
+                barHighs[bar] = fmax(barHighs[bar], highValues[i]);
+                barLows[bar]  = fmin(barLows[bar], lowValues[i]);
+                if ( !isnan(closeValues[i])) {
+                    barCloses[bar] = closeValues[i];
+                }
             }
             else {
-                lowPoint = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+                barIndexes[barCount]   = visibleRange.location + i;
+                barLocations[barCount] = locationValues[i];
+                barOpens[barCount]     = openValues[i];
+                barHighs[barCount]     = highValues[i];
+                barLows[barCount]      = lowValues[i];
+                barCloses[barCount]    = closeValues[i];
+                barCount++;
 
-            // close point
-            plotPoint[dependentCoord] = *closeBytes++;
-            if ( isnan(plotPoint[dependentCoord])) {
-                closePoint = CPTPointMake(NAN, NAN);
+                lastColumn = column;
             }
-            else {
-                closePoint = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
+        }
+    }
+    else {
+        for ( NSUInteger i = 0; i < visibleCount; i++ ) {
+            if ( !isnan(locationValues[i])) {
+                barIndexes[barCount]   = visibleRange.location + i;
+                barLocations[barCount] = locationValues[i];
+                barOpens[barCount]     = openValues[i];
+                barHighs[barCount]     = highValues[i];
+                barLows[barCount]      = lowValues[i];
+                barCloses[barCount]    = closeValues[i];
+                barCount++;
             }
+        }
+    }
 
-            CGFloat xCoord = openPoint.x;
-            if ( isnan(xCoord)) {
-                xCoord = highPoint.x;
-            }
-            else if ( isnan(xCoord)) {
-                xCoord = lowPoint.x;
-            }
-            else if ( isnan(xCoord)) {
-                xCoord = closePoint.x;
-            }
+    CGPoint *openPoints  = [arena allocateCount:barCount size:sizeof(CGPoint)];
+    CGPoint *highPoints  = [arena allocateCount:barCount size:sizeof(CGPoint)];
+    CGPoint *lowPoints   = [arena allocateCount:barCount size:sizeof(CGPoint)];
+    CGPoint *closePoints = [arena allocateCount:barCount size:sizeof(CGPoint)];
 
-            if ( !isnan(xCoord)) {
-                // Draw
-                switch ( thePlotStyle ) {
-                    case CPTTradingRangePlotStyleOHLC:
-                        [self drawOHLCInContext:context
-                                        atIndex:i
-                                              x:xCoord
-                                           open:openPoint.y
-                                          close:closePoint.y
-                                           high:highPoint.y
-                                            low:lowPoint.y
-                                    alignPoints:alignPoints];
-                        break;
-
-                    case CPTTradingRangePlotStyleCandleStick:
-                        [self drawCandleStickInContext:context
-                                               atIndex:i
-                                                     x:xCoord
-                                                  open:openPoint.y
-                                                 close:closePoint.y
-                                                  high:highPoint.y
-                                                   low:lowPoint.y
-                                                 width:[self barWidthForIndex:i].cgFloatValue
-                                           alignPoints:alignPoints];
-                        break;
-                }
+    [thePlotSpace plotAreaViewPoints:openPoints forDoublePrecisionXValues:barLocations yValues:barOpens numberOfPoints:barCount];
+    [thePlotSpace plotAreaViewPoints:highPoints forDoublePrecisionXValues:barLocations yValues:barHighs numberOfPoints:barCount];
+    [thePlotSpace plotAreaViewPoints:lowPoints forDoublePrecisionXValues:barLocations yValues:barLows numberOfPoints:barCount];
+    [thePlotSpace plotAreaViewPoints:closePoints forDoublePrecisionXValues:barLocations yValues:barCloses numberOfPoints:barCount];
+
+    // bars sharing a fill and line style are collected into one path of each kind
+    NSMutableArray<_CPTTradingRangeBatch *> *batches = [[NSMutableArray alloc] init];
+
+    for ( NSUInteger i = 0; i < barCount; i++ ) {
+        CGPoint openPoint  = isnan(barOpens[i]) ? CPTPointMake(NAN, NAN) : openPoints[i];
+        CGPoint highPoint  = isnan(barHighs[i]) ? CPTPointMake(NAN, NAN) : highPoints[i];
+        CGPoint lowPoint   = isnan(barLows[i]) ? CPTPointMake(NAN, NAN) : lowPoints[i];
+        CGPoint closePoint = isnan(barCloses[i]) ? CPTPointMake(NAN, NAN) : closePoints[i];
+
+        CGFloat xCoord = openPoint.x;
+        if ( isnan(xCoord)) {
+            xCoord = highPoint.x;
+        }
+
+        if ( !isnan(xCoord)) {
+            switch ( thePlotStyle ) {
+                case CPTTradingRangePlotStyleOHLC:
+                    [self addOHLCToBatches:batches
+                                 inContext:context
+                                   atIndex:barIndexes[i]
+                                         x:xCoord
+                                      open:openPoint.y
+                                     close:closePoint.y
+                                      high:highPoint.y
+                                       low:lowPoint.y
+                               alignPoints:alignPoints];
+                    break;
+
+                case CPTTradingRangePlotStyleCandleStick:
+                    [self addCandleStickToBatches:batches
+                                        inContext:context
+                                          atIndex:barIndexes[i]
+                                                x:xCoord
+                                             open:openPoint.y
+                                            close:closePoint.y
+                                             high:highPoint.y
+                                              low:lowPoint.y
+                                            width:[self barWidthForIndex:barIndexes[i]].cgFloatValue
+                                      alignPoints:alignPoints];
+                    break;
             }
         }
     }
-    else {
-        const NSDecimal *locationBytes = (const NSDecimal *)locations.data.bytes;
-        const NSDecimal *openBytes     = (const NSDecimal *)opens.data.bytes;
-        const NSDecimal *highBytes     = (const NSDecimal *)highs.data.bytes;
-        const NSDecimal *lowBytes      = (const NSDecimal *)lows.data.bytes;
-        const NSDecimal *closeBytes    = (const NSDecimal *)closes.data.bytes;
 
-        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
-            NSDecimal plotPoint[2];
-            plotPoint[independentCoord] = *locationBytes++;
-            if ( NSDecimalIsNotANumber(&plotPoint[independentCoord])) {
-                openBytes++;
-                highBytes++;
-                lowBytes++;
-                closeBytes++;
-                continue;
-            }
+    [arena resetToMark:scratchMark];
 
-            // open point
-            plotPoint[dependentCoord] = *openBytes++;
-            if ( NSDecimalIsNotANumber(&plotPoint[dependentCoord])) {
-                openPoint = CPTPointMake(NAN, NAN);
-            }
-            else {
-                openPoint = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+    CGContextBeginTransparencyLayer(context, NULL);
 
-            // high point
-            plotPoint[dependentCoord] = *highBytes++;
-            if ( NSDecimalIsNotANumber(&plotPoint[dependentCoord])) {
-                highPoint = CPTPointMake(NAN, NAN);
-            }
-            else {
-                highPoint = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+    for ( _CPTTradingRangeBatch *batch in batches ) {
+        [batch drawInContext:context];
+    }
 
-            // low point
-            plotPoint[dependentCoord] = *lowBytes++;
-            if ( NSDecimalIsNotANumber(&plotPoint[dependentCoord])) {
-                lowPoint = CPTPointMake(NAN, NAN);
+    CGContextEndTransparencyLayer(context);
+}
+
+/** @internal
+ *  @brief The furthest a bar can draw from its x coordinate, including half the widest line.
+ *  @return The distance in view coordinates.
+ **/
+-(CGFloat)maximumBarReach
+{
+    CGFloat reach = CPTFloat(0.0);
+
+    switch ( self.plotStyle ) {
+        case CPTTradingRangePlotStyleOHLC:
+            reach = ABS(self.stickLength);
+            break;
+
+        case CPTTradingRangePlotStyleCandleStick:
+            reach = ABS(CPTFloat(0.5) * self.barWidth);
+            for ( id width in [self cachedArrayForKey:CPTTradingRangePlotBindingBarWidths] ) {
+                if ( [width isKindOfClass:[NSNumber class]] ) {
+                    reach = MAX(reach, ABS(CPTFloat(0.5) * [width cgFloatValue]));
+                }
             }
-            else {
-                lowPoint = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
+            break;
+    }
+
+    CGFloat lineWidth = MAX(MAX(self.lineStyle.lineWidth, self.increaseLineStyle.lineWidth), self.decreaseLineStyle.lineWidth);
+
+    for ( NSString *key in @[CPTTradingRangePlotBindingLineStyles, CPTTradingRangePlotBindingIncreaseLineStyles, CPTTradingRangePlotBindingDecreaseLineStyles] ) {
+        for ( id style in [self cachedArrayForKey:key] ) {
+            if ( [style isKindOfClass:[CPTLineStyle class]] ) {
+                lineWidth = MAX(lineWidth, ((CPTLineStyle *)style).lineWidth);
             }
+        }
+    }
 
-            // close point
-            plotPoint[dependentCoord] = *closeBytes++;
-            if ( NSDecimalIsNotANumber(&plotPoint[dependentCoord])) {
-                closePoint = CPTPointMake(NAN, NAN);
+    // allow a point for pixel alignment
+    return reach + CPTFloat(0.5) * lineWidth + CPTFloat(1.0);
+}
+
+/** @internal
+ *  @brief Finds the records whose bars can reach a band of view x coordinates.
+ *
+ *  When the locations are in ascending order and the plot space is a CPTXYPlotSpace,
+ *  the ends of the band are found with a binary search, otherwise every record is returned.
+ *
+ *  @param locations The x values of the plot.
+ *  @param minimumViewX The left edge of the band.
+ *  @param maximumViewX The right edge of the band.
+ *  @return The index range of the records to draw.
+ **/
+-(NSRange)visibleRecordRangeForLocations:(nonnull CPTNumericData *)locations minimumViewX:(CGFloat)minimumViewX maximumViewX:(CGFloat)maximumViewX
+{
+    NSUInteger sampleCount = locations.numberOfSamples;
+    NSRange visibleRange   = NSMakeRange(0, sampleCount);
+
+    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
+
+    if ( [thePlotSpace isKindOfClass:[CPTXYPlotSpace class]] && [self locationsAreSorted:locations] ) {
+        double plotPoint[2];
+
+        [thePlotSpace doublePrecisionPlotPoint:plotPoint numberOfCoordinates:2 forPlotAreaViewPoint:CGPointMake(minimumViewX, CPTFloat(0.0))];
+        double firstLimit = plotPoint[independentCoord];
+
+        [thePlotSpace doublePrecisionPlotPoint:plotPoint numberOfCoordinates:2 forPlotAreaViewPoint:CGPointMake(maximumViewX, CPTFloat(0.0))];
+        double secondLimit = plotPoint[independentCoord];
+
+        if ( !isnan(firstLimit) && !isnan(secondLimit)) {
+            // the x range may be reversed
+            double minLocation = MIN(firstLimit, secondLimit);
+            double maxLocation = MAX(firstLimit, secondLimit);
+
+            NSUInteger first;
+            NSUInteger last;
+
+            if ( self.doublePrecisionCache ) {
+                const double *values = (const double *)locations.data.bytes;
+
+                first = CPTTradingRangeSearchDoubles(values, sampleCount, minLocation, NO);
+                last  = CPTTradingRangeSearchDoubles(values, sampleCount, maxLocation, YES);
             }
             else {
-                closePoint = [thePlotSpace plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:2];
-            }
+                const NSDecimal *values = (const NSDecimal *)locations.data.bytes;
 
-            CGFloat xCoord = openPoint.x;
-            if ( isnan(xCoord)) {
-                xCoord = highPoint.x;
+                first = CPTTradingRangeSearchDecimals(values, sampleCount, CPTDecimalFromDouble(minLocation), NO);
+                last  = CPTTradingRangeSearchDecimals(values, sampleCount, CPTDecimalFromDouble(maxLocation), YES);
             }
-            else if ( isnan(xCoord)) {
-                xCoord = lowPoint.x;
-            }
-            else if ( isnan(xCoord)) {
-                xCoord = closePoint.x;
+
+            // keep one more record each side in case rounding moved a limit past a bar that reaches the band
+            first = (first > 0) ? first - 1 : 0;
+            last  = MIN(last + 1, sampleCount);
+
+            visibleRange = NSMakeRange(first, MAX(last, first) - first);
+        }
+    }
+
+    return visibleRange;
+}
+
+/** @internal
+ *  @brief Checks if the locations are in ascending order with no @NAN values.
+ *
+ *  Only the records after the sorted run found last time are checked, so appending
+ *  data in order costs no more than looking at the new records.
+ *
+ *  @param locations The x values of the plot.
+ *  @return @YES if the locations can be searched.
+ **/
+-(BOOL)locationsAreSorted:(nonnull CPTNumericData *)locations
+{
+    NSUInteger sampleCount = locations.numberOfSamples;
+    NSUInteger sortedCount = 0;
+
+    if ( self.sortedLocations == locations ) {
+        // removing records keeps the rest in order
+        sortedCount = MIN(self.sortedLocationCount, sampleCount);
+    }
+
+    if ( self.doublePrecisionCache ) {
+        const double *values = (const double *)locations.data.bytes;
+
+        while ( sortedCount < sampleCount ) {
+            double value = values[sortedCount];
+            if ( isnan(value) || ((sortedCount > 0) && (value < values[sortedCount - 1]))) {
+                break;
             }
+            sortedCount++;
+        }
+    }
+    else {
+        const NSDecimal *values = (const NSDecimal *)locations.data.bytes;
 
-            if ( !isnan(xCoord)) {
-                // Draw
-                switch ( thePlotStyle ) {
-                    case CPTTradingRangePlotStyleOHLC:
-                        [self drawOHLCInContext:context
-                                        atIndex:i
-                                              x:xCoord
-                                           open:openPoint.y
-                                          close:closePoint.y
-                                           high:highPoint.y
-                                            low:lowPoint.y
-                                    alignPoints:alignPoints];
-                        break;
-
-                    case CPTTradingRangePlotStyleCandleStick:
-                        [self drawCandleStickInContext:context
-                                               atIndex:i
-                                                     x:xCoord
-                                                  open:openPoint.y
-                                                 close:closePoint.y
-                                                  high:highPoint.y
-                                                   low:lowPoint.y
-                                                 width:[self barWidthForIndex:i].cgFloatValue
-                                           alignPoints:alignPoints];
-                        break;
-                }
+        while ( sortedCount < sampleCount ) {
+            NSDecimal value = values[sortedCount];
+            if ( NSDecimalIsNotANumber(&value) || ((sortedCount > 0) && CPTDecimalLessThan(value, values[sortedCount - 1]))) {
+                break;
             }
+            sortedCount++;
         }
     }
 
-    CGContextEndTransparencyLayer(context);
+    self.sortedLocations     = locations;
+    self.sortedLocationCount = sortedCount;
+
+    return sortedCount == sampleCount;
 }
 
 -(void)drawCandleStickInContext:(nonnull CGContextRef)context
@@ -843,11 +1174,41 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
                             low:(CGFloat)lowValue
                           width:(CGFloat)width
                     alignPoints:(BOOL)alignPoints
+{
+    NSMutableArray<_CPTTradingRangeBatch *> *batches = [[NSMutableArray alloc] initWithCapacity:1];
+
+    [self addCandleStickToBatches:batches
+                        inContext:context
+                          atIndex:idx
+                                x:x
+                             open:openValue
+                            close:closeValue
+                             high:highValue
+                              low:lowValue
+                            width:width
+                      alignPoints:alignPoints];
+
+    for ( _CPTTradingRangeBatch *batch in batches ) {
+        [batch drawInContext:context];
+    }
+}
+
+-(void)addCandleStickToBatches:(nonnull NSMutableArray<_CPTTradingRangeBatch *> *)batches
+                     inContext:(nonnull CGContextRef)context
+                       atIndex:(NSUInteger)idx
+                             x:(CGFloat)x
+                          open:(CGFloat)openValue
+                         close:(CGFloat)closeValue
+                          high:(CGFloat)highValue
+                           low:(CGFloat)lowValue
+                         width:(CGFloat)width
+                   alignPoints:(BOOL)alignPoints
 {
     const CGFloat halfBarWidth = CPTFloat(0.5) * width;
 
     CPTFill *currentBarFill          = nil;
     CPTLineStyle *theBorderLineStyle = nil;
+    BOOL fillsWithLineColor          = NO;
 
     if ( !isnan(openValue) && !isnan(closeValue)) {
         if ( openValue < closeValue ) {
@@ -860,71 +1221,64 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
         }
         else {
             theBorderLineStyle = [self lineStyleForIndex:idx];
-            CPTColor *lineColor = theBorderLineStyle.lineColor;
-            if ( lineColor ) {
-                currentBarFill = [CPTFill fillWithColor:lineColor];
-            }
+            fillsWithLineColor = YES;
         }
     }
 
-    CPTAlignPointFunction alignmentFunction = CPTAlignPointToUserSpace;
-
     BOOL hasLineStyle = [theBorderLineStyle isKindOfClass:[CPTLineStyle class]];
 
-    if ( hasLineStyle ) {
-        [theBorderLineStyle setLineStyleInContext:context];
-
-        CGFloat lineWidth = theBorderLineStyle.lineWidth;
-        if ((self.contentsScale > CPTFloat(1.0)) && (round(lineWidth) == lineWidth)) {
-            alignmentFunction = CPTAlignIntegralPointToUserSpace;
-        }
+    if ( !hasLineStyle ) {
+        theBorderLineStyle = nil;
+        fillsWithLineColor = NO;
+    }
+    if ( ![currentBarFill isKindOfClass:[CPTFill class]] ) {
+        currentBarFill = nil;
     }
 
-    // high - low only
-    if ( hasLineStyle && !isnan(highValue) && !isnan(lowValue) && (isnan(openValue) || isnan(closeValue))) {
-        CGPoint alignedHighPoint = CPTPointMake(x, highValue);
-        CGPoint alignedLowPoint  = CPTPointMake(x, lowValue);
-        if ( alignPoints ) {
-            alignedHighPoint = alignmentFunction(context, alignedHighPoint);
-            alignedLowPoint  = alignmentFunction(context, alignedLowPoint);
-        }
+    BOOL hasFill = (currentBarFill != nil) || (fillsWithLineColor && (theBorderLineStyle.lineColor != nil));
 
-        CGMutablePathRef path = CGPathCreateMutable();
-        CGPathMoveToPoint(path, NULL, alignedHighPoint.x, alignedHighPoint.y);
-        CGPathAddLineToPoint(path, NULL, alignedLowPoint.x, alignedLowPoint.y);
+    if ( hasFill || hasLineStyle ) {
+        _CPTTradingRangeBatch *batch = CPTTradingRangeBatchForStyles(batches, currentBarFill, theBorderLineStyle, fillsWithLineColor);
+        CGMutablePathRef strokePath  = batch.strokePath;
 
-        CGContextBeginPath(context);
-        CGContextAddPath(context, path);
-        [theBorderLineStyle strokePathInContext:context];
+        CPTAlignPointFunction alignmentFunction = CPTAlignPointToUserSpace;
 
-        CGPathRelease(path);
-    }
+        if ( hasLineStyle ) {
+            CGFloat lineWidth = theBorderLineStyle.lineWidth;
+            if ((self.contentsScale > CPTFloat(1.0)) && (round(lineWidth) == lineWidth)) {
+                alignmentFunction = CPTAlignIntegralPointToUserSpace;
+            }
+        }
 
-    // open-close
-    if ( !isnan(openValue) && !isnan(closeValue)) {
-        if ( currentBarFill || hasLineStyle ) {
+        // high - low only
+        if ( hasLineStyle && !isnan(highValue) && !isnan(lowValue) && (isnan(openValue) || isnan(closeValue))) {
+            CGPoint alignedHighPoint = CPTPointMake(x, highValue);
+            CGPoint alignedLowPoint  = CPTPointMake(x, lowValue);
+            if ( alignPoints ) {
+                alignedHighPoint = alignmentFunction(context, alignedHighPoint);
+                alignedLowPoint  = alignmentFunction(context, alignedLowPoint);
+            }
+
+            CGPathMoveToPoint(strokePath, NULL, alignedHighPoint.x, alignedHighPoint.y);
+            CGPathAddLineToPoint(strokePath, NULL, alignedLowPoint.x, alignedLowPoint.y);
+        }
+
+        // open-close
+        if ( !isnan(openValue) && !isnan(closeValue)) {
             CGFloat radius = MIN(self.barCornerRadius, halfBarWidth);
             radius = MIN(radius, ABS(closeValue - openValue));
 
-            CGPoint alignedPoint1 = CPTPointMake(x + halfBarWidth, openValue);
-            CGPoint alignedPoint2 = CPTPointMake(x + halfBarWidth, closeValue);
-            CGPoint alignedPoint3 = CPTPointMake(x, closeValue);
-            CGPoint alignedPoint4 = CPTPointMake(x - halfBarWidth, closeValue);
-            CGPoint alignedPoint5 = CPTPointMake(x - halfBarWidth, openValue);
+            CGPoint alignedPoints[5];
+            alignedPoints[0] = CPTPointMake(x + halfBarWidth, openValue);
+            alignedPoints[1] = CPTPointMake(x + halfBarWidth, closeValue);
+            alignedPoints[2] = CPTPointMake(x, closeValue);
+            alignedPoints[3] = CPTPointMake(x - halfBarWidth, closeValue);
+            alignedPoints[4] = CPTPointMake(x - halfBarWidth, openValue);
             if ( alignPoints ) {
-                if ( hasLineStyle && self.showBarBorder ) {
-                    alignedPoint1 = alignmentFunction(context, alignedPoint1);
-                    alignedPoint2 = alignmentFunction(context, alignedPoint2);
-                    alignedPoint3 = alignmentFunction(context, alignedPoint3);
-                    alignedPoint4 = alignmentFunction(context, alignedPoint4);
-                    alignedPoint5 = alignmentFunction(context, alignedPoint5);
-                }
-                else {
-                    alignedPoint1 = CPTAlignIntegralPointToUserSpace(context, alignedPoint1);
-                    alignedPoint2 = CPTAlignIntegralPointToUserSpace(context, alignedPoint2);
-                    alignedPoint3 = CPTAlignIntegralPointToUserSpace(context, alignedPoint3);
-                    alignedPoint4 = CPTAlignIntegralPointToUserSpace(context, alignedPoint4);
-                    alignedPoint5 = CPTAlignIntegralPointToUserSpace(context, alignedPoint5);
+                CPTAlignPointFunction bodyAlignmentFunction = (hasLineStyle && self.showBarBorder) ? alignmentFunction : CPTAlignIntegralPointToUserSpace;
+
+                for ( NSUInteger i = 0; i < 5; i++ ) {
+                    alignedPoints[i] = bodyAlignmentFunction(context, alignedPoints[i]);
                 }
             }
 
@@ -932,30 +1286,20 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
                 // #285 Draw a cross with open/close values marked
                 const CGFloat halfLineWidth = CPTFloat(0.5) * theBorderLineStyle.lineWidth;
 
-                alignedPoint1.y -= halfLineWidth;
-                alignedPoint2.y += halfLineWidth;
-                alignedPoint3.y += halfLineWidth;
-                alignedPoint4.y += halfLineWidth;
-                alignedPoint5.y -= halfLineWidth;
+                alignedPoints[0].y -= halfLineWidth;
+                alignedPoints[1].y += halfLineWidth;
+                alignedPoints[2].y += halfLineWidth;
+                alignedPoints[3].y += halfLineWidth;
+                alignedPoints[4].y -= halfLineWidth;
             }
 
-            CGMutablePathRef path = CGPathCreateMutable();
-            CGPathMoveToPoint(path, NULL, alignedPoint1.x, alignedPoint1.y);
-            CGPathAddArcToPoint(path, NULL, alignedPoint2.x, alignedPoint2.y, alignedPoint3.x, alignedPoint3.y, radius);
-            CGPathAddArcToPoint(path, NULL, alignedPoint4.x, alignedPoint4.y, alignedPoint5.x, alignedPoint5.y, radius);
-            CGPathAddLineToPoint(path, NULL, alignedPoint5.x, alignedPoint5.y);
-            CGPathCloseSubpath(path);
-
-            if ( [currentBarFill isKindOfClass:[CPTFill class]] ) {
-                CGContextBeginPath(context);
-                CGContextAddPath(context, path);
-                [currentBarFill fillPathInContext:context];
+            if ( hasFill ) {
+                CPTTradingRangeAddBody(batch.fillPath, alignedPoints, radius);
             }
 
             if ( hasLineStyle ) {
-                if ( !self.showBarBorder ) {
-                    CGPathRelease(path);
-                    path = CGPathCreateMutable();
+                if ( self.showBarBorder ) {
+                    CPTTradingRangeAddBody(strokePath, alignedPoints, radius);
                 }
 
                 if ( !isnan(lowValue)) {
@@ -967,8 +1311,8 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
                             alignedLowPoint   = alignmentFunction(context, alignedLowPoint);
                         }
 
-                        CGPathMoveToPoint(path, NULL, alignedStartPoint.x, alignedStartPoint.y);
-                        CGPathAddLineToPoint(path, NULL, alignedLowPoint.x, alignedLowPoint.y);
+                        CGPathMoveToPoint(strokePath, NULL, alignedStartPoint.x, alignedStartPoint.y);
+                        CGPathAddLineToPoint(strokePath, NULL, alignedLowPoint.x, alignedLowPoint.y);
                     }
                 }
                 if ( !isnan(highValue)) {
@@ -980,16 +1324,11 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
                             alignedHighPoint  = alignmentFunction(context, alignedHighPoint);
                         }
 
-                        CGPathMoveToPoint(path, NULL, alignedStartPoint.x, alignedStartPoint.y);
-                        CGPathAddLineToPoint(path, NULL, alignedHighPoint.x, alignedHighPoint.y);
+                        CGPathMoveToPoint(strokePath, NULL, alignedStartPoint.x, alignedStartPoint.y);
+                        CGPathAddLineToPoint(strokePath, NULL, alignedHighPoint.x, alignedHighPoint.y);
                     }
                 }
-                CGContextBeginPath(context);
-                CGContextAddPath(context, path);
-                [theBorderLineStyle strokePathInContext:context];
             }
-
-            CGPathRelease(path);
         }
     }
 }
@@ -1002,6 +1341,33 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
                     high:(CGFloat)highValue
                      low:(CGFloat)lowValue
              alignPoints:(BOOL)alignPoints
+{
+    NSMutableArray<_CPTTradingRangeBatch *> *batches = [[NSMutableArray alloc] initWithCapacity:1];
+
+    [self addOHLCToBatches:batches
+                 inContext:context
+                   atIndex:idx
+                         x:x
+                      open:openValue
+                     close:closeValue
+                      high:highValue
+                       low:lowValue
+               alignPoints:alignPoints];
+
+    for ( _CPTTradingRangeBatch *batch in batches ) {
+        [batch drawInContext:context];
+    }
+}
+
+-(void)addOHLCToBatches:(nonnull NSMutableArray<_CPTTradingRangeBatch *> *)batches
+              inContext:(nonnull CGContextRef)context
+                atIndex:(NSUInteger)idx
+                      x:(CGFloat)x
+                   open:(CGFloat)openValue
+                  close:(CGFloat)closeValue
+                   high:(CGFloat)highValue
+                    low:(CGFloat)lowValue
+            alignPoints:(BOOL)alignPoints
 {
     CPTLineStyle *theLineStyle = [self lineStyleForIndex:idx];
 
@@ -1022,7 +1388,7 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
 
     if ( [theLineStyle isKindOfClass:[CPTLineStyle class]] ) {
         CGFloat theStickLength = self.stickLength;
-        CGMutablePathRef path  = CGPathCreateMutable();
+        CGMutablePathRef path  = CPTTradingRangeBatchForStyles(batches, nil, theLineStyle, NO).strokePath;
 
         CPTAlignPointFunction alignmentFunction = CPTAlignPointToUserSpace;
 
@@ -1066,12 +1432,6 @@ static const CPTCoordinate dependentCoord   = CPTCoordinateY;
             CGPathMoveToPoint(path, NULL, alignedCloseStartPoint.x, alignedCloseStartPoint.y);
             CGPathAddLineToPoint(path, NULL, alignedCloseEndPoint.x, alignedCloseEndPoint.y);
         }
-
-        CGContextBeginPath(context);
-        CGContextAddPath(context, path);
-        [theLineStyle setLineStyleInContext:context];
-        [theLineStyle strokePathInContext:context];
-        CGPathRelease(path);
     }
 }
 
@@ -0,0 +1,11 @@
+#import "CPTTestCase.h"
+
+@class CPTTradingRangePlot;
+@class CPTXYGraph;
+
+@interface CPTTradingRangePlotTests : CPTTestCase
+
+@property (nonatomic, readwrite, strong, nullable) CPTTradingRangePlot *plot;
+@property (nonatomic, readwrite, strong, nullable) CPTXYGraph *graph;
+
+@end
@@ -0,0 +1,376 @@
+#import "CPTTradingRangePlotTests.h"
+
+#import "CPTColor.h"
+#import "CPTColorSpace.h"
+#import "CPTFill.h"
+#import "CPTGradient.h"
+#import "CPTMutableLineStyle.h"
+#import "CPTNumericData.h"
+#import "CPTPlotRange.h"
+#import "CPTTradingRangePlot.h"
+#import "CPTUtilities.h"
+#import "CPTXYGraph.h"
+#import "CPTXYPlotSpace.h"
+#import "NSNumberExtensions.h"
+
+@interface CPTTradingRangePlot(Testing)
+
+-(void)addCandleStickToBatches:(nonnull NSMutableArray *)batches inContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue width:(CGFloat)width alignPoints:(BOOL)alignPoints;
+-(BOOL)locationsAreSorted:(nonnull CPTNumericData *)locations;
+-(NSUInteger)sortedLocationCount;
+-(NSRange)visibleRecordRangeForLocations:(nonnull CPTNumericData *)locations minimumViewX:(CGFloat)minimumViewX maximumViewX:(CGFloat)maximumViewX;
+-(void)addOHLCToBatches:(nonnull NSMutableArray *)batches inContext:(nonnull CGContextRef)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue alignPoints:(BOOL)alignPoints;
+
+@end
+
+#pragma mark -
+
+// records the bars handed to the batches instead of drawing them
+@interface CPTTradingRangePlotTestsRecordingPlot : CPTTradingRangePlot
+
+@property (nonatomic, readwrite, strong, nonnull) NSMutableArray<CPTNumberArray *> *bars;
+
+@end
+
+@implementation CPTTradingRangePlotTestsRecordingPlot
+
+@synthesize bars;
+
+-(void)addOHLCToBatches:(nonnull NSMutableArray *__unused)batches inContext:(nonnull CGContextRef __unused)context atIndex:(NSUInteger)idx x:(CGFloat)x open:(CGFloat)openValue close:(CGFloat)closeValue high:(CGFloat)highValue low:(CGFloat)lowValue alignPoints:(BOOL __unused)alignPoints
+{
+    if ( !self.bars ) {
+        self.bars = [[NSMutableArray alloc] init];
+    }
+    [self.bars addObject:@[@(idx), @(x), @(openValue), @(highValue), @(lowValue), @(closeValue)]];
+}
+
+@end
+
+#pragma mark -
+
+@interface CPTTradingRangePlotTests()
+
+-(void)addPlot:(nonnull CPTTradingRangePlot *)thePlot withXRange:(nonnull CPTPlotRange *)xRange;
+-(nonnull CPTNumericData *)cacheLocations:(nonnull CPTNumberArray *)locations;
+
+@end
+
+#pragma mark -
+
+@implementation CPTTradingRangePlotTests
+
+@synthesize plot;
+@synthesize graph;
+
+-(void)setUp
+{
+    self.plot = [[CPTTradingRangePlot alloc] init];
+}
+
+-(void)tearDown
+{
+    self.plot  = nil;
+    self.graph = nil;
+}
+
+-(void)addPlot:(nonnull CPTTradingRangePlot *)thePlot withXRange:(nonnull CPTPlotRange *)xRange
+{
+    CPTXYGraph *graph            = [[CPTXYGraph alloc] initWithFrame:CPTRectMake(0.0, 0.0, 200.0, 100.0)];
+    CPTXYPlotSpace *thePlotSpace = [[CPTXYPlotSpace alloc] init];
+
+    thePlotSpace.xRange = xRange;
+    thePlotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@0.0 length:@100.0];
+
+    thePlot.cachePrecision = CPTPlotCachePrecisionDouble;
+
+    [graph addPlotSpace:thePlotSpace];
+    [graph addPlot:thePlot toPlotSpace:thePlotSpace];
+    [graph layoutIfNeeded];
+
+    self.graph = graph;
+}
+
+-(nonnull CPTNumericData *)cacheLocations:(nonnull CPTNumberArray *)locations
+{
+    CPTTradingRangePlot *thePlot = self.plot;
+
+    [thePlot cacheNumbers:locations forField:CPTTradingRangePlotFieldX];
+
+    return [thePlot cachedNumbersForField:CPTTradingRangePlotFieldX];
+}
+
+#pragma mark -
+#pragma mark Batching
+
+-(void)testBarsWithSolidStylesShareABatch
+{
+    CPTTradingRangePlot *thePlot = self.plot;
+
+    CGContextRef context = CGBitmapContextCreate(NULL, 64, 64, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    CPTMutableLineStyle *solidLine = [CPTMutableLineStyle lineStyle];
+
+    thePlot.increaseFill      = [CPTFill fillWithColor:[CPTColor greenColor]];
+    thePlot.increaseLineStyle = solidLine;
+
+    NSMutableArray *batches = [[NSMutableArray alloc] init];
+
+    for ( NSUInteger i = 0; i < 3; i++ ) {
+        [thePlot addCandleStickToBatches:batches inContext:context atIndex:i x:CPTFloat(10.0 + 10.0 * i) open:CPTFloat(10.0) close:CPTFloat(20.0) high:CPTFloat(30.0) low:CPTFloat(5.0) width:CPTFloat(5.0) alignPoints:NO];
+    }
+    XCTAssertEqual(batches.count, (NSUInteger)1, @"Bars with a color fill and a plain line share a batch");
+
+    thePlot.increaseFill = [CPTFill fillWithGradient:[CPTGradient rainbowGradient]];
+    [batches removeAllObjects];
+
+    for ( NSUInteger i = 0; i < 3; i++ ) {
+        [thePlot addCandleStickToBatches:batches inContext:context atIndex:i x:CPTFloat(10.0 + 10.0 * i) open:CPTFloat(10.0) close:CPTFloat(20.0) high:CPTFloat(30.0) low:CPTFloat(5.0) width:CPTFloat(5.0) alignPoints:NO];
+    }
+    XCTAssertEqual(batches.count, (NSUInteger)3, @"Bars with a gradient fill are drawn one by one");
+
+    CPTMutableLineStyle *gradientLine = [CPTMutableLineStyle lineStyle];
+
+    gradientLine.lineGradient = [CPTGradient rainbowGradient];
+
+    thePlot.increaseFill      = [CPTFill fillWithColor:[CPTColor greenColor]];
+    thePlot.increaseLineStyle = gradientLine;
+    [batches removeAllObjects];
+
+    for ( NSUInteger i = 0; i < 3; i++ ) {
+        [thePlot addCandleStickToBatches:batches inContext:context atIndex:i x:CPTFloat(10.0 + 10.0 * i) open:CPTFloat(10.0) close:CPTFloat(20.0) high:CPTFloat(30.0) low:CPTFloat(5.0) width:CPTFloat(5.0) alignPoints:NO];
+    }
+    XCTAssertEqual(batches.count, (NSUInteger)3, @"Bars with a gradient line are drawn one by one");
+
+    CGContextRelease(context);
+}
+
+#pragma mark -
+#pragma mark Sorted locations
+
+-(void)testReplacingLocationsResetsSortOrder
+{
+    CPTTradingRangePlot *thePlot = self.plot;
+
+    [thePlot cacheNumbers:@[@1.0, @2.0, @3.0, @4.0] forField:CPTTradingRangePlotFieldX];
+
+    XCTAssertTrue([thePlot locationsAreSorted:[thePlot cachedNumbersForField:CPTTradingRangePlotFieldX]], @"Ascending locations");
+    XCTAssertEqual(thePlot.sortedLocationCount, (NSUInteger)4, @"Every location checked");
+
+    [thePlot cacheNumbers:@[@4.0, @3.0] forField:CPTTradingRangePlotFieldX atRecordIndex:2];
+    XCTAssertEqual(thePlot.sortedLocationCount, (NSUInteger)2, @"Replaced locations are checked again");
+    XCTAssertFalse([thePlot locationsAreSorted:[thePlot cachedNumbersForField:CPTTradingRangePlotFieldX]], @"Replaced locations out of order");
+
+    [thePlot cacheNumbers:@[@1.0, @2.0] forField:CPTTradingRangePlotFieldX];
+    XCTAssertEqual(thePlot.sortedLocationCount, (NSUInteger)0, @"New locations are checked again");
+    XCTAssertTrue([thePlot locationsAreSorted:[thePlot cachedNumbersForField:CPTTradingRangePlotFieldX]], @"New locations in order");
+}
+
+#pragma mark -
+#pragma mark Visible records
+
+-(void)testVisibleRecordRangeKeepsOneRecordEachSide
+{
+    CPTTradingRangePlot *thePlot = self.plot;
+
+    [self addPlot:thePlot withXRange:[CPTPlotRange plotRangeWithLocation:@0.0 length:@10.0]];
+
+    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)thePlot.plotSpace;
+    CPTNumericData *locations    = [self cacheLocations:@[@0.0, @1.0, @2.0, @3.0, @4.0, @5.0, @6.0, @7.0, @8.0, @9.0]];
+
+    CGFloat minimumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@2.5, @0.0]].x;
+    CGFloat maximumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@5.5, @0.0]].x;
+
+    // records 3 to 5 are in the band
+    NSRange visibleRange = [thePlot visibleRecordRangeForLocations:locations minimumViewX:minimumViewX maximumViewX:maximumViewX];
+
+    XCTAssertEqual(visibleRange.location, (NSUInteger)2, @"one record before the band");
+    XCTAssertEqual(visibleRange.length, (NSUInteger)5, @"one record after the band");
+
+    minimumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@0.5, @0.0]].x;
+    maximumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@8.5, @0.0]].x;
+
+    visibleRange = [thePlot visibleRecordRangeForLocations:locations minimumViewX:minimumViewX maximumViewX:maximumViewX];
+
+    XCTAssertEqual(visibleRange.location, (NSUInteger)0, @"margin stops at the first record");
+    XCTAssertEqual(visibleRange.length, (NSUInteger)10, @"margin stops at the last record");
+
+    minimumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@(-5.0), @0.0]].x;
+    maximumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@(-1.0), @0.0]].x;
+
+    visibleRange = [thePlot visibleRecordRangeForLocations:locations minimumViewX:minimumViewX maximumViewX:maximumViewX];
+
+    XCTAssertEqual(visibleRange.location, (NSUInteger)0, @"band before the data");
+    XCTAssertEqual(visibleRange.length, (NSUInteger)1, @"only the margin record before the data");
+
+    // unsorted locations cannot be searched
+    locations = [self cacheLocations:@[@0.0, @2.0, @1.0, @3.0, @4.0, @5.0, @6.0, @7.0, @8.0, @9.0]];
+
+    minimumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@2.5, @0.0]].x;
+    maximumViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@5.5, @0.0]].x;
+
+    visibleRange = [thePlot visibleRecordRangeForLocations:locations minimumViewX:minimumViewX maximumViewX:maximumViewX];
+
+    XCTAssertEqual(visibleRange.location, (NSUInteger)0, @"unsorted locations start at the first record");
+    XCTAssertEqual(visibleRange.length, (NSUInteger)10, @"unsorted locations cover every record");
+}
+
+-(void)testVisibleRecordRangeWithReversedRange
+{
+    CPTTradingRangePlot *thePlot = self.plot;
+
+    [self addPlot:thePlot withXRange:[CPTPlotRange plotRangeWithLocation:@10.0 length:@(-10.0)]];
+
+    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)thePlot.plotSpace;
+    CPTNumericData *locations    = [self cacheLocations:@[@0.0, @1.0, @2.0, @3.0, @4.0, @5.0, @6.0, @7.0, @8.0, @9.0]];
+
+    // larger locations are further left
+    CGFloat firstViewX = [thePlotSpace plotAreaViewPointForPlotPoint:@[@2.5, @0.0]].x;
+    CGFloat lastViewX  = [thePlotSpace plotAreaViewPointForPlotPoint:@[@5.5, @0.0]].x;
+
+    XCTAssertGreaterThan(firstViewX, lastViewX, @"reversed x range");
+
+    NSRange visibleRange = [thePlot visibleRecordRangeForLocations:locations minimumViewX:lastViewX maximumViewX:firstViewX];
+
+    XCTAssertEqual(visibleRange.location, (NSUInteger)2, @"one record before the band");
+    XCTAssertEqual(visibleRange.length, (NSUInteger)5, @"one record after the band");
+}
+
+#pragma mark -
+#pragma mark Column aggregation
+
+-(void)testBarsInOnePixelColumnAreMerged
+{
+    CPTTradingRangePlotTestsRecordingPlot *thePlot = [[CPTTradingRangePlotTestsRecordingPlot alloc] init];
+
+    self.plot         = thePlot;
+    thePlot.plotStyle = CPTTradingRangePlotStyleOHLC;
+
+    // about three records to a pixel
+    [self addPlot:thePlot withXRange:[CPTPlotRange plotRangeWithLocation:@0.0 length:@500.0]];
+
+    CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)thePlot.plotSpace;
+
+    const NSUInteger recordCount = 60;
+
+    double locations[recordCount];
+    double opens[recordCount];
+    double highs[recordCount];
+    double lows[recordCount];
+    double closes[recordCount];
+
+    CPTMutableNumberArray *locationArray = [[NSMutableArray alloc] init];
+    CPTMutableNumberArray *openArray     = [[NSMutableArray alloc] init];
+    CPTMutableNumberArray *highArray     = [[NSMutableArray alloc] init];
+    CPTMutableNumberArray *lowArray      = [[NSMutableArray alloc] init];
+    CPTMutableNumberArray *closeArray    = [[NSMutableArray alloc] init];
+
+    for ( NSUInteger i = 0; i < recordCount; i++ ) {
+        locations[i] = (double)i + 0.37;
+        opens[i]     = (i % 5 == 0) ? (double)NAN : 10.0 + (double)i;
+        highs[i]     = (i == 7) ? (double)NAN : 50.0 + (double)((i * 7) % 13);
+        lows[i]      = 5.0 + (double)((i * 3) % 4);
+        closes[i]    = (i % 4 == 3) ? (double)NAN : 20.0 + (double)i;
+
+        [locationArray addObject:@(locations[i])];
+        [openArray addObject:@(opens[i])];
+        [highArray addObject:@(highs[i])];
+        [lowArray addObject:@(lows[i])];
+        [closeArray addObject:@(closes[i])];
+    }
+
+    [thePlot cacheNumbers:locationArray forField:CPTTradingRangePlotFieldX];
+    [thePlot cacheNumbers:openArray forField:CPTTradingRangePlotFieldOpen];
+    [thePlot cacheNumbers:highArray forField:CPTTradingRangePlotFieldHigh];
+    [thePlot cacheNumbers:lowArray forField:CPTTradingRangePlotFieldLow];
+    [thePlot cacheNumbers:closeArray forField:CPTTradingRangePlotFieldClose];
+
+
+    // merge the bars the same way, one record at a time
+    CGPoint viewPoints[recordCount];
+
+    [thePlotSpace plotAreaViewPoints:viewPoints forDoublePrecisionXValues:locations yValues:opens numberOfPoints:recordCount];
+
+    NSUInteger barIndexes[recordCount];
+    double barLocations[recordCount];
+    double barOpens[recordCount];
+    double barHighs[recordCount];
+    double barLows[recordCount];
+    double barCloses[recordCount];
+    NSUInteger barCount = 0;
+    CGFloat lastColumn  = CPTFloat(0.0);
+
+    for ( NSUInteger i = 0; i < recordCount; i++ ) {
+        CGFloat column = floor(viewPoints[i].x * thePlot.contentsScale);
+
+        if ((barCount > 0) && (column == lastColumn)) {
+            NSUInteger bar = barCount - 1;
+
+            if ( isnan(barOpens[bar])) {
+                barOpens[bar] = opens[i];
+            }
+            if ( isnan(barHighs[bar]) || (highs[i] > barHighs[bar])) {
+                barHighs[bar] = highs[i];
+            }
+            if ( isnan(barLows[bar]) || (lows[i] < barLows[bar])) {
+                barLows[bar] = lows[i];
+            }
+            if ( !isnan(closes[i])) {
+                barCloses[bar] = closes[i];
+            }
+        }
+        else {
+            barIndexes[barCount]   = i;
+            barLocations[barCount] = locations[i];
+            barOpens[barCount]     = opens[i];
+            barHighs[barCount]     = highs[i];
+            barLows[barCount]      = lows[i];
+            barCloses[barCount]    = closes[i];
+            barCount++;
+
+            lastColumn = column;
+        }
+    }
+
+    XCTAssertLessThan(barCount, recordCount, @"records share pixel columns");
+
+    CGContextRef context = CGBitmapContextCreate(NULL, 200, 100, 8, 0, [CPTColorSpace genericRGBSpace].cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+    [thePlot renderAsVectorInContext:context];
+
+    CGContextRelease(context);
+
+    XCTAssertEqual(thePlot.bars.count, barCount, @"one bar per pixel column");
+
+    for ( NSUInteger bar = 0; bar < MIN(barCount, thePlot.bars.count); bar++ ) {
+        CPTNumberArray *recordedBar = thePlot.bars[bar];
+
+        CGPoint openPoint  = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:(double[2]) { barLocations[bar], barOpens[bar] } numberOfCoordinates:2];
+        CGPoint highPoint  = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:(double[2]) { barLocations[bar], barHighs[bar] } numberOfCoordinates:2];
+        CGPoint lowPoint   = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:(double[2]) { barLocations[bar], barLows[bar] } numberOfCoordinates:2];
+        CGPoint closePoint = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:(double[2]) { barLocations[bar], barCloses[bar] } numberOfCoordinates:2];
+
+        CGFloat expectedValues[5] = {
+            isnan(barOpens[bar]) ? highPoint.x : openPoint.x,
+            isnan(barOpens[bar]) ? CPTNAN : openPoint.y,
+            isnan(barHighs[bar]) ? CPTNAN : highPoint.y,
+            isnan(barLows[bar]) ? CPTNAN : lowPoint.y,
+            isnan(barCloses[bar]) ? CPTNAN : closePoint.y
+        };
+        NSString *names[5] = { @"x", @"open", @"high", @"low", @"close" };
+
+        XCTAssertEqual(recordedBar[0].unsignedIntegerValue, barIndexes[bar], @"bar %lu takes the styles of the first record", (unsigned long)bar);
+
+        for ( NSUInteger j = 0; j < 5; j++ ) {
+            CGFloat value = recordedBar[j + 1].cgFloatValue;
+
+            if ( isnan(expectedValues[j])) {
+                XCTAssertTrue(isnan(value), @"bar %lu %@", (unsigned long)bar, names[j]);
+            }
+            else {
+                XCTAssertEqualWithAccuracy(value, expectedValues[j], CPTFloat(1.0e-6), @"bar %lu %@", (unsigned long)bar, names[j]);
+            }
+        }
+    }
+}
+
+@end
@@ -21,6 +21,9 @@
 #import "CPTXYPlotSpace.h"
 #import "NSCoderExtensions.h"
 #import "CPTFieldFunctionDataSource.h"
+#import "_CPTRangeClassification.h"
+#import "_CPTScratchArena.h"
+#import "_CPTSpatialIndex.h"
 #import "tgmath.h"
 
 /** @defgroup plotAnimationVectorFieldPlot Vector Field Plot
@@ -329,10 +332,6 @@ typedef struct CGPointVector CGPointVector;
         return;
     }
 
-    CPTPlotRangeComparisonResult *xRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult) );
-    CPTPlotRangeComparisonResult *yRangeFlags = calloc(dataCount, sizeof(CPTPlotRangeComparisonResult) );
-    BOOL *nanFlags                            = calloc(dataCount, sizeof(BOOL) );
-
     CPTPlotRange *xRange = xyPlotSpace.xRange;
     CPTPlotRange *yRange = xyPlotSpace.yRange;
 
@@ -341,40 +340,17 @@ typedef struct CGPointVector CGPointVector;
         const double *xBytes = (const double *)[self cachedNumbersForField:CPTVectorFieldPlotFieldX].data.bytes;
         const double *yBytes = (const double *)[self cachedNumbersForField:CPTVectorFieldPlotFieldY].data.bytes;
 
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x = xBytes[i];
-            const double y = yBytes[i];
-
-            xRangeFlags[i] = [xRange compareToDouble:x];
-            yRangeFlags[i] = [yRange compareToDouble:y];
-            nanFlags[i]    = isnan(x) || isnan(y);
-        });
+        CPTRangeClassificationFlagPoints(pointDrawFlags, xBytes, yBytes, dataCount,
+                                         CPTRangeClassificationLimitsForRange(xRange),
+                                         CPTRangeClassificationLimitsForRange(yRange),
+                                         CPTRangeClassificationExpansionNone);
     }
     else {
         const NSDecimal *xBytes = (const NSDecimal *)[self cachedNumbersForField:CPTVectorFieldPlotFieldX].data.bytes;
         const NSDecimal *yBytes = (const NSDecimal *)[self cachedNumbersForField:CPTVectorFieldPlotFieldY].data.bytes;
 
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const NSDecimal x = xBytes[i];
-            const NSDecimal y = yBytes[i];
-
-            xRangeFlags[i] = [xRange compareToDecimal:x];
-            yRangeFlags[i] = [yRange compareToDecimal:y];
-            nanFlags[i]    = NSDecimalIsNotANumber(&x);
-        });
+        CPTRangeClassificationFlagDecimalPoints(pointDrawFlags, xBytes, yBytes, dataCount, xRange, yRange, CPTRangeClassificationExpansionNone);
     }
-
-    for ( NSUInteger i = 0; i < dataCount; i++ ) {
-        BOOL drawPoint = (xRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                         (yRangeFlags[i] == CPTPlotRangeComparisonResultNumberInRange) &&
-                         !nanFlags[i];
-
-        pointDrawFlags[i] = drawPoint;
-    }
-
-    free(xRangeFlags);
-    free(yRangeFlags);
-    free(nanFlags);
 }
 
 -(void)calculateViewPoints:(nonnull CGPointVector *)viewPoints withDrawPointFlags:(nonnull BOOL *)drawPointFlags numberOfPoints:(NSUInteger)dataCount
@@ -394,31 +370,38 @@ typedef struct CGPointVector CGPointVector;
         double factor = (double)self.normalisedVectorLength / maxLength;
         const double *directionBytes   = (const double *)[self cachedNumbersForField:CPTVectorFieldPlotFieldVectorDirection].data.bytes;
         
-        dispatch_apply(dataCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
-            const double x     = xBytes[i];
-            const double y     = yBytes[i];
-            const double length  = factor * lengthBytes[i];
-            const double direction   = directionBytes[i];
-            
-            if ( !drawPointFlags[i] || isnan(x) || isnan(y) ) {
+        CGPoint *positions = calloc(dataCount, sizeof(CGPoint));
+        double *tipXBytes  = calloc(dataCount, sizeof(double));
+        double *tipYBytes  = calloc(dataCount, sizeof(double));
+
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            const double length    = factor * lengthBytes[i];
+            const double direction = directionBytes[i];
+            tipXBytes[i] = xBytes[i] + length * sin(direction);
+            tipYBytes[i] = yBytes[i] + length * cos(direction);
+        }
+
+        [thePlotSpace plotAreaViewPoints:positions forDoublePrecisionXValues:xBytes yValues:yBytes numberOfPoints:dataCount];
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            viewPoints[i].x = positions[i].x;
+            viewPoints[i].y = positions[i].y;
+        }
+
+        [thePlotSpace plotAreaViewPoints:positions forDoublePrecisionXValues:tipXBytes yValues:tipYBytes numberOfPoints:dataCount];
+        for ( NSUInteger i = 0; i < dataCount; i++ ) {
+            if ( !drawPointFlags[i] || isnan(xBytes[i]) || isnan(yBytes[i]) ) {
                 viewPoints[i].x = CPTNAN; // depending coordinates
                 viewPoints[i].y = CPTNAN;
             }
             else {
-                double plotPoint[2];
-                plotPoint[CPTCoordinateX] = x;
-                plotPoint[CPTCoordinateY] = y;
-                CGPoint pos               = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].x           = pos.x;
-                viewPoints[i].y           = pos.y;
-
-                plotPoint[CPTCoordinateX] = x + length * sin(direction);
-                plotPoint[CPTCoordinateY] = y + length * cos(direction);
-                pos                       = [thePlotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
-                viewPoints[i].tip_x        = pos.x;
-                viewPoints[i].tip_y        = pos.y;
+                viewPoints[i].tip_x = positions[i].x;
+                viewPoints[i].tip_y = positions[i].y;
             }
-        });
+        }
+
+        free(positions);
+        free(tipXBytes);
+        free(tipYBytes);
     }
     else {
         const NSDecimal *xBytes     = (const NSDecimal *)[self cachedNumbersForField:CPTVectorFieldPlotFieldX].data.bytes;
@@ -734,8 +717,11 @@ typedef struct CGPointVector CGPointVector;
     [super renderAsVectorInContext:context];
 
     // Calculate view points, and align to user space
-    CGPointVector *viewPoints = calloc(dataCount, sizeof(CGPointVector) );
-    BOOL *drawPointFlags     = calloc(dataCount, sizeof(BOOL) );
+    _CPTScratchArena *arena = self.scratchArena;
+    NSUInteger scratchMark  = arena.mark;
+
+    CGPointVector *viewPoints = [arena allocateCount:dataCount size:sizeof(CGPointVector)];
+    BOOL *drawPointFlags     = [arena allocateCount:dataCount size:sizeof(BOOL)];
 
     CPTXYPlotSpace *thePlotSpace = (CPTXYPlotSpace *)self.plotSpace;
     [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:thePlotSpace includeVisiblePointsOnly:NO];
@@ -792,8 +778,7 @@ typedef struct CGPointVector CGPointVector;
         }
     }
 
-    free(viewPoints);
-    free(drawPointFlags);
+    [arena resetToMark:scratchMark];
 }
 
 -(void)drawVectorInContext:(nonnull CGContextRef)context
@@ -1123,44 +1108,44 @@ typedef struct CGPointVector CGPointVector;
  **/
 -(NSUInteger)indexOfVisiblePointClosestToPlotAreaPoint:(CGPoint)viewPoint
 {
-    NSUInteger dataCount     = self.cachedDataCount;
-    CGPointVector *viewPoints = calloc(dataCount, sizeof(CGPointVector) );
-    BOOL *drawPointFlags     = calloc(dataCount, sizeof(BOOL) );
+    _CPTSpatialIndex *theIndex = [self spatialIndexBuiltWithBlock:^_CPTSpatialIndex *{
+        NSUInteger dataCount      = self.cachedDataCount;
+        CGPointVector *viewPoints = calloc(dataCount, sizeof(CGPointVector) );
+        CGPoint *basePoints       = calloc(dataCount, sizeof(CGPoint) );
+        BOOL *drawPointFlags      = calloc(dataCount, sizeof(BOOL) );
 
-    [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:(id)self.plotSpace includeVisiblePointsOnly:YES];
-    [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
+        [self calculatePointsToDraw:drawPointFlags numberOfPoints:dataCount forPlotSpace:(id)self.plotSpace includeVisiblePointsOnly:YES];
+        [self calculateViewPoints:viewPoints withDrawPointFlags:drawPointFlags numberOfPoints:dataCount];
 
-    NSInteger result = [self extremeDrawnPointIndexForFlags:drawPointFlags numberOfPoints:dataCount extremeNumIsLowerBound:YES];
-    if ( result != NSNotFound ) {
-        CGPointVector lastViewPoint;
-        CGFloat minimumDistanceSquared = CPTNAN;
-        for ( NSUInteger i = (NSUInteger)result; i < dataCount; ++i ) {
-            if ( drawPointFlags[i] ) {
-                lastViewPoint = viewPoints[i];
-                CGPoint lastPoint       = CPTPointMake(lastViewPoint.x, lastViewPoint.y);
-                CGFloat distanceSquared = squareOfDistanceBetweenPoints(viewPoint, lastPoint);
-                if ( isnan(minimumDistanceSquared) || (distanceSquared < minimumDistanceSquared) ) {
-                    minimumDistanceSquared = distanceSquared;
-                    result                 = (NSInteger)i;
-                }
-            }
+        for ( NSUInteger i = 0; i < dataCount; ++i ) {
+            basePoints[i] = CPTPointMake(viewPoints[i].x, viewPoints[i].y);
         }
-        if ( result != NSNotFound ) {
-            lastViewPoint = viewPoints[result];
 
-            if ( !isnan(lastViewPoint.tip_x) && (viewPoint.x > lastViewPoint.tip_x) ) {
-                result = NSNotFound;
-            }
-            if ( !isnan(lastViewPoint.tip_y) && (viewPoint.x > lastViewPoint.tip_y) ) {
-                result = NSNotFound;
-            }
+        _CPTSpatialIndex *newIndex = [[_CPTSpatialIndex alloc] initWithPoints:basePoints flags:drawPointFlags count:dataCount];
+        // keep the vectors for the tip test of the closest point
+        newIndex.itemData = [NSData dataWithBytesNoCopy:viewPoints length:dataCount * sizeof(CGPointVector) freeWhenDone:YES];
+
+        free(basePoints);
+        free(drawPointFlags);
+
+        return newIndex;
+    }];
+
+    NSUInteger result = [theIndex indexOfItemClosestToPoint:viewPoint];
+
+    if ( result != NSNotFound ) {
+        const CGPointVector *viewPoints = (const CGPointVector *)theIndex.itemData.bytes;
+        CGPointVector lastViewPoint     = viewPoints[result];
+
+        if ( !isnan(lastViewPoint.tip_x) && (viewPoint.x > lastViewPoint.tip_x) ) {
+            result = NSNotFound;
+        }
+        if ( !isnan(lastViewPoint.tip_y) && (viewPoint.x > lastViewPoint.tip_y) ) {
+            result = NSNotFound;
         }
     }
 
-    free(viewPoints);
-    free(drawPointFlags);
-
-    return (NSUInteger)result;
+    return result;
 }
 
 /** @brief Returns the plot area view point of a visible point.
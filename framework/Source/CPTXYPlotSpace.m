@@ -19,6 +19,27 @@
 /// @cond
 typedef NSMutableArray<CPTAnimationOperation *> CPTMutableAnimationArray;
 
+// The parameters needed to map one coordinate of a plot point to the plot area.
+// Captured once per batch conversion so the per-point loop does no message sends.
+struct CPTXYPlotSpaceAxisTransform {
+    CPTScaleType scaleType; // scale type of the coordinate
+    CGFloat viewLength;     // length of the plot area along the coordinate
+    double start;           // range location (log-transformed for log scales)
+    double length;          // range length (log-transformed for log scales)
+    BOOL isValid;           // NO if every point maps to zero
+};
+typedef struct CPTXYPlotSpaceAxisTransform CPTXYPlotSpaceAxisTransform;
+
+/// Number of points converted per task when a batch conversion is split across threads.
+static const size_t kCPTXYPlotSpaceBatchSize = 16384;
+
+@interface CPTPlotSpace()
+
+// private CPTPlotSpace method
+-(nullable CPTPlotArea *)mappedPlotArea;
+
+@end
+
 @interface CPTXYPlotSpace()
 
 -(CGFloat)viewCoordinateForViewLength:(NSDecimal)viewLength linearPlotRange:(nonnull CPTPlotRange *)range plotCoordinateValue:(NSDecimal)plotCoord;
@@ -41,6 +62,8 @@ typedef NSMutableArray<CPTAnimationOperation *> CPTMutableAnimationArray;
 
 -(CGFloat)viewCoordinateForRange:(nullable CPTPlotRange *)range coordinate:(CPTCoordinate)coordinate direction:(BOOL)direction;
 
+-(CPTXYPlotSpaceAxisTransform)axisTransformForViewLength:(CGFloat)viewLength plotRange:(nullable CPTPlotRange *)range scaleType:(CPTScaleType)scaleType;
+
 CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c);
 
 @property (nonatomic, readwrite) BOOL isDragging;
@@ -1015,6 +1038,102 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     return CPTInverseLogModulus(coordinate);
 }
 
+// Batch conversion
+-(CPTXYPlotSpaceAxisTransform)axisTransformForViewLength:(CGFloat)viewLength plotRange:(nullable CPTPlotRange *)range scaleType:(CPTScaleType)scaleType
+{
+    CPTXYPlotSpaceAxisTransform transform;
+
+    transform.scaleType  = scaleType;
+    transform.viewLength = viewLength;
+    transform.start      = 0.0;
+    transform.length     = 0.0;
+    transform.isValid    = NO;
+
+    switch ( scaleType ) {
+        case CPTScaleTypeLinear:
+        case CPTScaleTypeCategory:
+            if ( range && (range.lengthDouble != 0.0)) {
+                transform.start   = range.locationDouble;
+                transform.length  = range.lengthDouble;
+                transform.isValid = YES;
+            }
+            break;
+
+        case CPTScaleTypeLog:
+            if ((range.minLimitDouble > 0.0) && (range.maxLimitDouble > 0.0)) {
+                double logLoc = log10(range.locationDouble);
+
+                transform.start   = logLoc;
+                transform.length  = log10(range.endDouble) - logLoc;
+                transform.isValid = YES;
+            }
+            break;
+
+        case CPTScaleTypeLogModulus:
+            if ( range ) {
+                double logLoc = CPTLogModulus(range.locationDouble);
+
+                transform.start   = logLoc;
+                transform.length  = CPTLogModulus(range.endDouble) - logLoc;
+                transform.isValid = YES;
+            }
+            break;
+
+        default:
+            [NSException raise:CPTException format:@"Scale type not supported in CPTXYPlotSpace"];
+    }
+
+    return transform;
+}
+
+/**
+ *  @internal
+ *  @brief Maps a contiguous list of plot coordinates to view coordinates.
+ *  @param transform  The coordinate transform.
+ *  @param values     The plot coordinates.
+ *  @param viewCoords The first view coordinate to write. Successive values are written every @par{stride} elements.
+ *  @param stride     The distance between successive view coordinates.
+ *  @param count      The number of values to convert.
+ **/
+static void CPTXYPlotSpaceTransformCoordinates(CPTXYPlotSpaceAxisTransform transform, const double *__restrict values, CGFloat *__restrict viewCoords, size_t stride, size_t count)
+{
+    const CGFloat viewLength = transform.viewLength;
+    const double start       = transform.start;
+    const double length      = transform.length;
+
+    if ( !transform.isValid ) {
+        for ( size_t i = 0; i < count; i++ ) {
+            viewCoords[i * stride] = CPTFloat(0.0);
+        }
+        return;
+    }
+
+    switch ( transform.scaleType ) {
+        case CPTScaleTypeLinear:
+        case CPTScaleTypeCategory:
+            for ( size_t i = 0; i < count; i++ ) {
+                viewCoords[i * stride] = viewLength * (CGFloat)((values[i] - start) / length);
+            }
+            break;
+
+        case CPTScaleTypeLog:
+            for ( size_t i = 0; i < count; i++ ) {
+                const double value = values[i];
+                viewCoords[i * stride] = (value <= 0.0) ? CPTFloat(0.0) : viewLength * (CGFloat)((log10(value) - start) / length);
+            }
+            break;
+
+        case CPTScaleTypeLogModulus:
+            for ( size_t i = 0; i < count; i++ ) {
+                viewCoords[i * stride] = viewLength * (CGFloat)((CPTLogModulus(values[i]) - start) / length);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
 /// @endcond
 
 #pragma mark -
@@ -1033,8 +1152,7 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     CGPoint viewPoint = [super plotAreaViewPointForPlotPoint:plotPoint];
 
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1087,8 +1205,7 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     CGPoint viewPoint = [super plotAreaViewPointForPlotPoint:plotPoint numberOfCoordinates:count];
 
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1153,8 +1270,7 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     CGPoint viewPoint = [super plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:count];
 
     CGSize layerSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         layerSize = plotArea.bounds.size;
@@ -1202,14 +1318,50 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     return viewPoint;
 }
 
+-(void)plotAreaViewPoints:(nonnull CGPoint *)viewPoints forDoublePrecisionXValues:(nonnull const double *)xValues yValues:(nonnull const double *)yValues numberOfPoints:(NSUInteger)dataCount
+{
+    if ( dataCount == 0 ) {
+        return;
+    }
+
+    CPTPlotArea *plotArea = [self mappedPlotArea];
+
+    if ( !plotArea ) {
+        memset(viewPoints, 0, dataCount * sizeof(CGPoint));
+        return;
+    }
+
+    CGSize layerSize = plotArea.bounds.size;
+
+    CPTXYPlotSpaceAxisTransform xTransform = [self axisTransformForViewLength:layerSize.width plotRange:self.xRange scaleType:self.xScaleType];
+    CPTXYPlotSpaceAxisTransform yTransform = [self axisTransformForViewLength:layerSize.height plotRange:self.yRange scaleType:self.yScaleType];
+
+    CGFloat *viewCoords = (CGFloat *)viewPoints;
+
+    if ( dataCount <= kCPTXYPlotSpaceBatchSize ) {
+        CPTXYPlotSpaceTransformCoordinates(xTransform, xValues, viewCoords, 2, dataCount);
+        CPTXYPlotSpaceTransformCoordinates(yTransform, yValues, viewCoords + 1, 2, dataCount);
+    }
+    else {
+        size_t batchCount = (dataCount + kCPTXYPlotSpaceBatchSize - 1) / kCPTXYPlotSpaceBatchSize;
+
+        dispatch_apply(batchCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t batch) {
+            size_t first = batch * kCPTXYPlotSpaceBatchSize;
+            size_t count = MIN(kCPTXYPlotSpaceBatchSize, dataCount - first);
+
+            CPTXYPlotSpaceTransformCoordinates(xTransform, xValues + first, viewCoords + 2 * first, 2, count);
+            CPTXYPlotSpaceTransformCoordinates(yTransform, yValues + first, viewCoords + 2 * first + 1, 2, count);
+        });
+    }
+}
+
 // Plot point for view point
 -(nullable CPTNumberArray *)plotPointForPlotAreaViewPoint:(CGPoint)point
 {
     CPTMutableNumberArray *plotPoint = [[super plotPointForPlotAreaViewPoint:point] mutableCopy];
 
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
@@ -1270,8 +1422,7 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     [super plotPoint:plotPoint numberOfCoordinates:count forPlotAreaViewPoint:point];
 
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
@@ -1325,8 +1476,7 @@ CGFloat CPTFirstPositiveRoot(CGFloat a, CGFloat b, CGFloat c)
     [super doublePrecisionPlotPoint:plotPoint numberOfCoordinates:count forPlotAreaViewPoint:point];
 
     CGSize boundsSize;
-    CPTGraph *theGraph    = self.graph;
-    CPTPlotArea *plotArea = theGraph.plotAreaFrame.plotArea;
+    CPTPlotArea *plotArea = [self mappedPlotArea];
 
     if ( plotArea ) {
         boundsSize = plotArea.bounds.size;
@@ -289,6 +289,46 @@
     XCTAssertEqualWithAccuracy(viewPoint.y, CPTFloat(25.0), CPTFloat(0.01), @"");
 }
 
+#pragma mark -
+#pragma mark View points for plot point lists
+
+-(void)testViewPointsForDoublePrecisionValuesMatchSinglePoints
+{
+    CPTScaleType scaleTypes[3] = { CPTScaleTypeLinear, CPTScaleTypeLog, CPTScaleTypeLogModulus };
+
+    double xValues[5] = { 0.5, 1.0, 5.0, 10.0, NAN };
+    double yValues[5] = { 2.0, 0.1, 100.0, 3.0, 4.0 };
+    CGPoint viewPoints[5];
+
+    for ( NSUInteger s = 0; s < 3; s++ ) {
+        self.plotSpace.xScaleType = scaleTypes[s];
+        self.plotSpace.yScaleType = scaleTypes[s];
+
+        self.plotSpace.xRange = [CPTPlotRange plotRangeWithLocation:@0.1
+                                                             length:@9.9];
+        self.plotSpace.yRange = [CPTPlotRange plotRangeWithLocation:@1.0
+                                                             length:@99.0];
+
+        [self.plotSpace plotAreaViewPoints:viewPoints forDoublePrecisionXValues:xValues yValues:yValues numberOfPoints:5];
+
+        for ( NSUInteger i = 0; i < 5; i++ ) {
+            double plotPoint[2];
+            plotPoint[CPTCoordinateX] = xValues[i];
+            plotPoint[CPTCoordinateY] = yValues[i];
+
+            CGPoint viewPoint = [self.plotSpace plotAreaViewPointForDoublePrecisionPlotPoint:plotPoint numberOfCoordinates:2];
+
+            if ( isnan(viewPoint.x)) {
+                XCTAssertTrue(isnan(viewPoints[i].x), @"scale type %lu, point %lu", (unsigned long)s, (unsigned long)i);
+            }
+            else {
+                XCTAssertEqualWithAccuracy(viewPoints[i].x, viewPoint.x, CPTFloat(0.0001), @"scale type %lu, point %lu", (unsigned long)s, (unsigned long)i);
+            }
+            XCTAssertEqualWithAccuracy(viewPoints[i].y, viewPoint.y, CPTFloat(0.0001), @"scale type %lu, point %lu", (unsigned long)s, (unsigned long)i);
+        }
+    }
+}
+
 #pragma mark -
 #pragma mark Plot point for view point (linear)
 
@@ -55,14 +55,18 @@ void clearContourPlanes(ContourPlanes *a);
 void freeContourPlanes(ContourPlanes *a);
 
 typedef struct {
-    NSUInteger * _Nullable array;
+    NSUInteger * _Nullable array;       // grid node indices in the order they were found
     size_t used;
     size_t size;
+    uint8_t * _Nullable members;        // one bit per grid node index, set if the index is in array
+    size_t membersSize;                 // number of bytes in members
+    BOOL sorted;                        // array is in ascending order
 } Discontinuities;
 
 void initDiscontinuities(Discontinuities *a, size_t initialSize);
 void appendDiscontinuities(Discontinuities *a, NSUInteger element);
 BOOL containsDiscontinuities(Discontinuities *a,  NSUInteger element);
+void sortDiscontinuities(Discontinuities *a);
 void clearDiscontinuities(Discontinuities *a);
 void freeDiscontinuities(Discontinuities *a);
 
@@ -74,6 +78,15 @@ int compareNSUInteger(const void * a, const void * b);
 @property (nonatomic, readwrite) BOOL containsFunctionNans;
 @property (nonatomic, readwrite) BOOL containsFunctionInfinities;
 @property (nonatomic, readwrite) BOOL containsFunctionNegativeInfinities;
+// evaluate the whole field up front and trace the isocurves in parallel, the field block must be thread safe
+@property (nonatomic, readwrite) BOOL concurrentGeneration;
+// evaluate the whole field up front and keep it, so the region can later be grown with extendToLimits:
+@property (nonatomic, readwrite) BOOL denseGeneration;
+// generation of the field block, changes each time the plot is given a new block
+@property (nonatomic, readwrite) NSUInteger fieldGeneration;
+// set while extendToLimits: traces the cells along the grown sides a second time, exported lines are then
+// ones already exported that have to be taken back
+@property (nonatomic, readonly) BOOL withdrawingLines;
 
 -(nonnull instancetype)initWithNoIsoCurve:(NSUInteger)newNoIsoCurves IsoCurveValues:(double*)newContourPlanes Limits:(double*)newLimits;
     
@@ -84,6 +97,12 @@ int compareNSUInteger(const void * a, const void * b);
 
 // generate the contours
 -(BOOL) generate;
+// grow the region to cover newLimits keeping the grid spacing, only the added border is evaluated
+// and traced. Returns NO if the field was not generated densely, the contours must then be generated again
+-(BOOL) extendToLimits:(double*)newLimits;
+// moves grid node indices over to the grown grid, called by extendToLimits: after the lines of the
+// cells that are traced again have been withdrawn
+-(void) remapIndicesFromColumns:(NSUInteger)oldColumns Rows:(NSUInteger)oldRows OffsetX:(NSUInteger)offsetX OffsetY:(NSUInteger)offsetY;
 
 // Set the dimension of the primary grid
 -(void) setFirstGridDimensionColumns:(NSUInteger)iCol Rows:(NSUInteger)iRow;
@@ -104,6 +123,8 @@ int compareNSUInteger(const void * a, const void * b);
 
 // Gets the value for F(x,y) function
 -(double) getFieldValueForX:(double)x Y:(double)y;
+// Gets the block to the F(x,y) function
+-(CPTContourDataSourceBlock _Nullable) getFieldBlock;
 
 // Retrieve dimension of size region and isocurve
 -(NSUInteger) getNoIsoCurves;
@@ -7,6 +7,8 @@
 
 #import "_CPTContour.h"
 
+#import <pthread.h>
+
 #define NEGINF ((-1.0) / 0.0)
 #define POSINF ((1.0) / 0.0)
 
@@ -79,22 +81,40 @@ void initDiscontinuities(Discontinuities *a, size_t initialSize) {
     a->array = (NSUInteger*)calloc(initialSize, sizeof(NSUInteger));
     a->used = 0;
     a->size = initialSize;
+    a->members = NULL;
+    a->membersSize = 0;
+    a->sorted = YES;
 }
 
 void appendDiscontinuities(Discontinuities *a, NSUInteger element) {
     // a->used is the number of used entries, because a->array[a->used++] updates a->used only *after* the array has been accessed.
     // Therefore a->used can go up to a->size
     if (a->used == a->size) {
-        a->size *= 2;
+        a->size = a->size > 0 ? a->size * 2 : 8;
         a->array = (NSUInteger*)realloc(a->array, a->size * sizeof(NSUInteger));
     }
+    // grow the membership bitmap to cover the new grid node index
+    size_t byte = (size_t)(element >> 3);
+    if (byte >= a->membersSize) {
+        size_t newSize = a->membersSize > 0 ? a->membersSize * 2 : 1024;
+        while (newSize <= byte) {
+            newSize *= 2;
+        }
+        a->members = (uint8_t*)realloc(a->members, newSize);
+        memset(a->members + a->membersSize, 0, newSize - a->membersSize);
+        a->membersSize = newSize;
+    }
+    a->members[byte] |= (uint8_t)(1 << (element & 7));
+    
+    if (a->used > 0 && a->array[a->used - 1] > element) {
+        a->sorted = NO;
+    }
     a->array[a->used++] = element;
 }
 
 BOOL containsDiscontinuities(Discontinuities *a,  NSUInteger element) {
-    qsort(a->array, a->used, sizeof(NSUInteger), compareNSUInteger);
-    NSUInteger *item = (NSUInteger*)bsearch(&element, a->array, a->used, sizeof(NSUInteger), compareNSUInteger);
-    if( item != NULL ) {
+    size_t byte = (size_t)(element >> 3);
+    if ( byte < a->membersSize && (a->members[byte] & (1 << (element & 7))) ) {
         return YES;
     }
     else {
@@ -102,14 +122,30 @@ BOOL containsDiscontinuities(Discontinuities *a,  NSUInteger element) {
     }
 }
 
+// Only needed by consumers that walk the indices in grid order
+void sortDiscontinuities(Discontinuities *a) {
+    if (!a->sorted) {
+        qsort(a->array, a->used, sizeof(NSUInteger), compareNSUInteger);
+        a->sorted = YES;
+    }
+}
+
 void clearDiscontinuities(Discontinuities *a) {
+    for (size_t i = 0; i < a->used; i++) {
+        a->members[a->array[i] >> 3] = 0;
+    }
     a->used = 0;
+    a->sorted = YES;
 }
 
 void freeDiscontinuities(Discontinuities *a) {
     free(a->array);
     a->array = NULL;
     a->used = a->size = 0;
+    free(a->members);
+    a->members = NULL;
+    a->membersSize = 0;
+    a->sorted = YES;
 }
 
 
@@ -145,11 +181,21 @@ typedef struct  {
 
     
 @property (nonatomic, readwrite) FunctionDatum **functionData; // pointer to mesh parts
+@property (nonatomic, readwrite) BOOL denseField;                 // functionData holds every node of the secondary grid
+@property (nonatomic, readwrite) NSUInteger *bandBoundsX;         // primary cell edges along x on the secondary grid, noRowsFirst + 1 of them
+@property (nonatomic, readwrite) NSUInteger *bandBoundsY;         // primary cell edges along y on the secondary grid, noColumnsFirst + 1 of them
+@property (nonatomic, readwrite) BOOL withdrawingLines;
 
 -(FunctionDatum)functionDataForColumn:(NSUInteger)i Row:(NSUInteger)j;
 -(double) fieldForX:(NSUInteger)x Y:(NSUInteger) y;     /* evaluate funct if we must,    */
 -(void) contour1ForX1:(NSUInteger)x1 X2:(NSUInteger)x2 Y1:(NSUInteger)y1 Y2:(NSUInteger)y2;
 -(void) pass2ForX1:(NSUInteger)x1 X2:(NSUInteger)x2 Y1:(NSUInteger)y1 Y2:(NSUInteger)y2; /* draws the contour lines */
+-(void) pass2ForX1:(NSUInteger)x1 X2:(NSUInteger)x2 Y1:(NSUInteger)y1 Y2:(NSUInteger)y2 Planes:(NSRange)planes;
+-(void) generateFromDenseField;
+-(void) evaluateFieldExcludingColumns:(NSRange)keptColumns Rows:(NSRange)keptRows;
+-(void) traceCells:(NSUInteger*)cells Count:(NSUInteger)noCells;
+-(void) pass2Cells:(NSUInteger*)cells Count:(NSUInteger)noCells;
+-(void) recordDiscontinuityAtIndex:(NSUInteger)index;
 
 @end
                                     
@@ -159,6 +205,8 @@ typedef struct  {
 static ContourPlanes contourPlanes;
 static Discontinuities discontinuities;
 static NSUInteger maxColumnsByRows;
+// guards discontinuities while isocurves are traced concurrently
+static pthread_mutex_t discontinuitiesMutex = PTHREAD_MUTEX_INITIALIZER;
 
 @synthesize noColumnsFirst, noRowsFirst, noColumnsSecondary, noRowsSecondary, noPlanes;
 @synthesize limits;
@@ -166,6 +214,10 @@ static NSUInteger maxColumnsByRows;
 @synthesize deltaX, deltaY;
 @synthesize functionData;
 @synthesize containsFunctionNans, containsFunctionInfinities, containsFunctionNegativeInfinities;
+@synthesize concurrentGeneration, denseGeneration, denseField;
+@synthesize fieldGeneration;
+@synthesize bandBoundsX, bandBoundsY;
+@synthesize withdrawingLines;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -255,6 +307,11 @@ static NSUInteger maxColumnsByRows;
         free(self.functionData);
         self.functionData = NULL;
     }
+    self.denseField = NO;
+    free(self.bandBoundsX);
+    free(self.bandBoundsY);
+    self.bandBoundsX = NULL;
+    self.bandBoundsY = NULL;
 }
 
 
@@ -316,6 +373,10 @@ static NSUInteger maxColumnsByRows;
     }
 }
 
+-(CPTContourDataSourceBlock) getFieldBlock {
+    return self.fieldBlock;
+}
+
 -(NSUInteger) getNoColumnsFirstGrid {
     return self.noColumnsFirst;
 }
@@ -448,75 +509,80 @@ static BOOL once = NO;
     self.deltaX = (self.limits[1] - self.limits[0]) / (double)(self.noColumnsSecondary);
     self.deltaY = (self.limits[3] - self.limits[2]) / (double)(self.noRowsSecondary);
 
-    xlow = 0;
-    oldx3 = 0;
-    x3 = (cols - 1) / self.noRowsFirst;
-    x4 = (2 * (cols - 1)) / self.noRowsFirst;
-    for (x = oldx3; x <= x4; x++) {      // allocate new columns needed
-        if (x >= cols) {
-            break;
-        }
-        if ( self.functionData[x] == NULL) {
-            self.functionData[x] = (FunctionDatum*)calloc((size_t)rows, sizeof(FunctionDatum));
-        }
-        for (y = 0; y < rows; y++) {
-            self.functionData[x][y].topLength = -1;
-        }
-    }
-
-    y4 = 0;
-    for (j = 0; j < self.noColumnsFirst; j++) {
-        y3 = y4;
-        y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
-        [self contour1ForX1:oldx3 X2:x3 Y1:y3 Y2:y4];
+    if ( self.concurrentGeneration || self.denseGeneration ) {
+        [self generateFromDenseField];
     }
-
-    for (i = 1; i < self.noRowsFirst; i++) {
-        y4 = 0;
-        for (j = 0; j < self.noColumnsFirst; j++) {
-            y3 = y4;
-            y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
-            [self contour1ForX1:x3 X2:x4 Y1:y3 Y2:y4];
+    else {
+        xlow = 0;
+        oldx3 = 0;
+        x3 = (cols - 1) / self.noRowsFirst;
+        x4 = (2 * (cols - 1)) / self.noRowsFirst;
+        for (x = oldx3; x <= x4; x++) {      // allocate new columns needed
+            if (x >= cols) {
+                break;
+            }
+            if ( self.functionData[x] == NULL) {
+                self.functionData[x] = (FunctionDatum*)calloc((size_t)rows, sizeof(FunctionDatum));
+            }
+            for (y = 0; y < rows; y++) {
+                self.functionData[x][y].topLength = -1;
+            }
         }
 
         y4 = 0;
         for (j = 0; j < self.noColumnsFirst; j++) {
             y3 = y4;
             y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
-            [self pass2ForX1:oldx3 X2:x3 Y1:y3 Y2:y4];
+            [self contour1ForX1:oldx3 X2:x3 Y1:y3 Y2:y4];
         }
 
-        if (i < (self.noRowsFirst - 1)) {     /* re-use columns no longer needed */
-            oldx3 = x3;
-            x3 = x4;
-            x4 = ((i + 2) * (cols - 1)) / self.noRowsFirst;
-            for (x = x3 + 1; x <= x4; x++) {
-                if (xlow < oldx3) {
-                    if (self.functionData[x]) {
-                        free(self.functionData[x]);
+        for (i = 1; i < self.noRowsFirst; i++) {
+            y4 = 0;
+            for (j = 0; j < self.noColumnsFirst; j++) {
+                y3 = y4;
+                y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
+                [self contour1ForX1:x3 X2:x4 Y1:y3 Y2:y4];
+            }
+
+            y4 = 0;
+            for (j = 0; j < self.noColumnsFirst; j++) {
+                y3 = y4;
+                y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
+                [self pass2ForX1:oldx3 X2:x3 Y1:y3 Y2:y4];
+            }
+
+            if (i < (self.noRowsFirst - 1)) {     /* re-use columns no longer needed */
+                oldx3 = x3;
+                x3 = x4;
+                x4 = ((i + 2) * (cols - 1)) / self.noRowsFirst;
+                for (x = x3 + 1; x <= x4; x++) {
+                    if (xlow < oldx3) {
+                        if (self.functionData[x]) {
+                            free(self.functionData[x]);
+                        }
+                        self.functionData[x] = self.functionData[xlow];
+                        self.functionData[xlow++] = NULL;
                     }
-                    self.functionData[x] = self.functionData[xlow];
-                    self.functionData[xlow++] = NULL;
-                }
-                else {
-                    if (self.functionData[x] == NULL) {
-                        self.functionData[x] = (FunctionDatum*)calloc((size_t)rows, sizeof(FunctionDatum));
+                    else {
+                        if (self.functionData[x] == NULL) {
+                            self.functionData[x] = (FunctionDatum*)calloc((size_t)rows, sizeof(FunctionDatum));
+                        }
+                    }
+                    for (y = 0; y < rows; y++) {
+                        self.functionData[x][y].topLength = -1;
                     }
-                }
-                for (y = 0; y < rows; y++) {
-                    self.functionData[x][y].topLength = -1;
                 }
             }
         }
-    }
 
-    y4 = 0;
-    for (j = 0; j < self.noColumnsFirst; j++) {
-        y3 = y4;
-        y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
-        [self pass2ForX1:x3 X2:x4 Y1:y3 Y2:y4];
+        y4 = 0;
+        for (j = 0; j < self.noColumnsFirst; j++) {
+            y3 = y4;
+            y4 = ((j + 1) * (rows - 1)) / self.noColumnsFirst;
+            [self pass2ForX1:x3 X2:x4 Y1:y3 Y2:y4];
+        }
     }
-    
+
     if ( discontinuities.used > 0 ) {
         self.containsFunctionNans = YES;
         
@@ -545,9 +611,7 @@ static BOOL once = NO;
 
     if ( isnan(f11) || f11 == POSINF || f11 == NEGINF ) {
         index = y1 * (self.noRowsSecondary + 1) + x1;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f11) || f11 == NEGINF ) {
             f11 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -557,9 +621,7 @@ static BOOL once = NO;
     }
     if ( isnan(f12) || f12 == POSINF || f12 == NEGINF ) {
         index = y2 * (self.noRowsSecondary + 1) + x1;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f12) || f12 == NEGINF ) {
             f12 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -569,9 +631,7 @@ static BOOL once = NO;
     }
     if ( isnan(f21) || f21 == POSINF || f21 == NEGINF ) {
         index = y1 * (self.noRowsSecondary + 1) + x2;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f21) || isnan(f12) || f21 == NEGINF ) {
             f21 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -581,9 +641,7 @@ static BOOL once = NO;
     }
     if ( isnan(f22) || f22 == POSINF || f22 == NEGINF ) {
         index = y2 * (self.noRowsSecondary + 1) + x2;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f22) || f22 == NEGINF ) {
             f22 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -598,9 +656,7 @@ static BOOL once = NO;
         double f33 = [self fieldForX:x3 Y:y3];
         if( isnan(f33) || f33 == POSINF || f33 == NEGINF ) {
             index = y3 * (self.noRowsSecondary + 1) + x3;
-            if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                appendDiscontinuities(&discontinuities, index);
-            }
+            [self recordDiscontinuityAtIndex:index];
             if ( isnan(f33) || f33 == NEGINF ) {
                 f33 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
             }
@@ -628,6 +684,10 @@ static BOOL once = NO;
 }
 
 -(void) pass2ForX1:(NSUInteger)x1 X2:(NSUInteger)x2 Y1:(NSUInteger)y1 Y2:(NSUInteger)y2 {
+    [self pass2ForX1:x1 X2:x2 Y1:y1 Y2:y2 Planes:NSMakeRange(0, (NSUInteger)contourPlanes.used)];
+}
+
+-(void) pass2ForX1:(NSUInteger)x1 X2:(NSUInteger)x2 Y1:(NSUInteger)y1 Y2:(NSUInteger)y2 Planes:(NSRange)planes {
     
     NSUInteger left = 0, right = 0, top = 0, bot = 0, old, iNew, i, j, x3, y3;
     double yy0 = 0.0, yy1 = 0.0, xx0 = 0.0, xx1 = 0.0, xx3, yy3;
@@ -646,9 +706,7 @@ static BOOL once = NO;
     
     if ( isnan(f11) || f11 == POSINF || f11 == NEGINF ) {
         index = y1 * (self.noRowsSecondary + 1) + x1;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f11) || f11 == NEGINF ) {
             f11 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -658,9 +716,7 @@ static BOOL once = NO;
     }
     if ( isnan(f12) || f12 == POSINF || f12 == NEGINF ) {
         index = y2 * (self.noRowsSecondary + 1) + x1;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f12) || f12 == NEGINF ) {
             f12 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -670,9 +726,7 @@ static BOOL once = NO;
     }
     if ( isnan(f21) || f21 == POSINF || f21 == NEGINF ) {
         index = y1 * (self.noRowsSecondary + 1) + x2;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f21) || f21 == NEGINF ) {
             f21 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -682,9 +736,7 @@ static BOOL once = NO;
     }
     if ( isnan(f22) || f22 == POSINF || f22 == NEGINF ) {
         index = y2 * (self.noRowsSecondary + 1) + x2;
-        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-            appendDiscontinuities(&discontinuities, index);
-        }
+        [self recordDiscontinuityAtIndex:index];
         if ( isnan(f22) || f22 == NEGINF ) {
             f22 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
         }
@@ -699,9 +751,7 @@ static BOOL once = NO;
         f33 = [self functionDataForColumn:x3 Row:y3].value;
         if ( isnan(f33) || isinf(f33) || f33 == NEGINF ) {
             index = y3 * (self.noRowsSecondary + 1) + x3;
-            if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                appendDiscontinuities(&discontinuities, index);
-            }
+            [self recordDiscontinuityAtIndex:index];
             if ( isnan(f33) || f33 == NEGINF ) {
                 f33 = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
             }
@@ -716,15 +766,15 @@ static BOOL once = NO;
         if (f33 < f22) i++; else if (f33 > f22) j++;
         if ((i > 2) || (j > 2)) {   // should we divide cell?
             // subdivide cell
-            [self pass2ForX1:x1 X2:x3 Y1:y1 Y2:y3];
-            [self pass2ForX1:x3 X2:x2 Y1:y1 Y2:y3];
-            [self pass2ForX1:x1 X2:x3 Y1:y3 Y2:y2];
-            [self pass2ForX1:x3 X2:x2 Y1:y3 Y2:y2];
+            [self pass2ForX1:x1 X2:x3 Y1:y1 Y2:y3 Planes:planes];
+            [self pass2ForX1:x3 X2:x2 Y1:y1 Y2:y3 Planes:planes];
+            [self pass2ForX1:x1 X2:x3 Y1:y3 Y2:y2 Planes:planes];
+            [self pass2ForX1:x3 X2:x2 Y1:y3 Y2:y2 Planes:planes];
             return;
         }
     }
 
-    for (i = 0; i < (NSUInteger)contourPlanes.used; i++) {
+    for (i = planes.location; i < NSMaxRange(planes); i++) {
         v = contourPlanes.array[i];
         j = 0;
         if (f21 > v) j++;
@@ -742,9 +792,7 @@ static BOOL once = NO;
                     fnew = self.functionData[x1][iNew].value;
                     if ( isnan(fnew) || fnew == POSINF || fnew == NEGINF ) {
                         index = iNew * (self.noRowsSecondary + 1) + x1;
-                        if ( index < maxColumnsByRows &&  !containsDiscontinuities(&discontinuities, index) ) {
-                            appendDiscontinuities(&discontinuities, index);
-                        }
+                        [self recordDiscontinuityAtIndex:index];
                         if ( isnan(fnew) || fnew == NEGINF ) {
                             fnew = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
                         }
@@ -775,9 +823,7 @@ static BOOL once = NO;
                     fnew = self.functionData[x2][iNew].value;
                     if ( isnan(fnew) || fnew == POSINF || fnew == NEGINF ) {
                         index = iNew * (self.noRowsSecondary + 1) + x2;
-                        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                            appendDiscontinuities(&discontinuities, index);
-                        }
+                        [self recordDiscontinuityAtIndex:index];
                         if ( isnan(fnew) || fnew == NEGINF ) {
                             fnew = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
                         }
@@ -808,9 +854,7 @@ static BOOL once = NO;
                     fnew = self.functionData[iNew][y1].value;
                     if ( isnan(fnew) || fnew == POSINF || fnew == NEGINF ) {
                         index = y1 * (self.noRowsSecondary + 1) + iNew;
-                        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                            appendDiscontinuities(&discontinuities, index);
-                        }
+                        [self recordDiscontinuityAtIndex:index];
                         if ( isnan(fnew) || fnew == NEGINF ) {
                             fnew = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
                         }
@@ -841,9 +885,7 @@ static BOOL once = NO;
                     fnew = self.functionData[iNew][y2].value;
                     if ( isnan(fnew) || fnew == POSINF || fnew == NEGINF ) {
                         index = y2 * (self.noRowsSecondary + 1) + iNew;
-                        if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                            appendDiscontinuities(&discontinuities, index);
-                        }
+                        [self recordDiscontinuityAtIndex:index];
                         if ( isnan(fnew) || fnew == NEGINF ) {
                             fnew = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
                         }
@@ -912,9 +954,7 @@ static BOOL once = NO;
                         f = self.fieldBlock(xx3, yy3);
                         if ( isnan(f) || f == POSINF || f == NEGINF ) {
                             index = [self getIndexAtX:xx3 Y:yy3];
-                            if ( index < maxColumnsByRows && !containsDiscontinuities(&discontinuities, index) ) {
-                                appendDiscontinuities(&discontinuities, index);
-                            }
+                            [self recordDiscontinuityAtIndex:index];
                             if ( isnan(f) || f == NEGINF ) {
                                 f = [self getIsoCurves][0] * ([self getIsoCurves][0] < 0 ? 10.0 : -10);
                             }
@@ -947,6 +987,291 @@ static BOOL once = NO;
     }
 }
 
+// Two phase version of the serial sweep in generate. The field is evaluated at every
+// node of the secondary grid and the cells are subdivided against those values, then
+// the isocurves are traced. With concurrentGeneration the field is evaluated in parallel
+// column tiles and each isocurve is traced on its own worker; every plane only exports
+// into its own strip list, so the workers never share output.
+-(void) generateFromDenseField {
+    NSUInteger cols = self.noColumnsSecondary + 1;
+    NSUInteger rows = self.noRowsSecondary + 1;
+    NSUInteger noBandsX = self.noRowsFirst;
+    NSUInteger noBandsY = self.noColumnsFirst;
+    
+    for (NSUInteger x = 0; x < cols; x++) {
+        if ( self.functionData[x] == NULL ) {
+            self.functionData[x] = (FunctionDatum*)calloc((size_t)rows, sizeof(FunctionDatum));
+        }
+    }
+    [self evaluateFieldExcludingColumns:NSMakeRange(0, 0) Rows:NSMakeRange(0, 0)];
+    self.denseField = YES;
+    
+    // kept so extendToLimits: knows where the cells it adds have to line up
+    free(self.bandBoundsX);
+    free(self.bandBoundsY);
+    self.bandBoundsX = (NSUInteger*)malloc((noBandsX + 1) * sizeof(NSUInteger));
+    self.bandBoundsY = (NSUInteger*)malloc((noBandsY + 1) * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i <= noBandsX; i++) {
+        self.bandBoundsX[i] = (i * (cols - 1)) / noBandsX;
+    }
+    for (NSUInteger j = 0; j <= noBandsY; j++) {
+        self.bandBoundsY[j] = (j * (rows - 1)) / noBandsY;
+    }
+    
+    NSUInteger *cells = (NSUInteger*)malloc(noBandsX * noBandsY * 4 * sizeof(NSUInteger));
+    NSUInteger noCells = 0;
+    for (NSUInteger i = 0; i < noBandsX; i++) {
+        for (NSUInteger j = 0; j < noBandsY; j++) {
+            cells[noCells * 4] = self.bandBoundsX[i];
+            cells[noCells * 4 + 1] = self.bandBoundsX[i + 1];
+            cells[noCells * 4 + 2] = self.bandBoundsY[j];
+            cells[noCells * 4 + 3] = self.bandBoundsY[j + 1];
+            noCells++;
+        }
+    }
+    [self traceCells:cells Count:noCells];
+    free(cells);
+}
+
+// the same values fieldForX:Y: would evaluate lazily, for every node outside the kept rectangle
+-(void) evaluateFieldExcludingColumns:(NSRange)keptColumns Rows:(NSRange)keptRows {
+    NSUInteger cols = self.noColumnsSecondary + 1;
+    NSUInteger rows = self.noRowsSecondary + 1;
+    FunctionDatum **data = self.functionData;
+    double x0 = self.limits[0];
+    double y0 = self.limits[2];
+    double dX = self.deltaX;
+    double dY = self.deltaY;
+    CPTContourDataSourceBlock block = self.fieldBlock;
+    
+    const size_t tileColumns = 16;
+    void (^evaluateTile)(size_t) = ^(size_t tile) {
+        NSUInteger xEnd = MIN((NSUInteger)((tile + 1) * tileColumns), cols);
+        for (NSUInteger x = (NSUInteger)(tile * tileColumns); x < xEnd; x++) {
+            FunctionDatum *column = data[x];
+            BOOL kept = keptRows.length > 0 && NSLocationInRange(x, keptColumns);
+            double xx = x0 + dX * (double)x;
+            NSUInteger y = 0;
+            while ( y < rows ) {
+                if ( kept && y == keptRows.location ) {
+                    y = NSMaxRange(keptRows);
+                    continue;
+                }
+                column[y].value = block != NULL ? block(xx, y0 + dY * (double)y) : 0.0;
+                column[y].topLength = column[y].bottomLength = column[y].leftLength = column[y].rightLength = 0;
+                y++;
+            }
+        }
+    };
+    size_t noTiles = ((size_t)cols + tileColumns - 1) / tileColumns;
+    if ( self.concurrentGeneration ) {
+        dispatch_apply(noTiles, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), evaluateTile);
+    }
+    else {
+        for (size_t tile = 0; tile < noTiles; tile++) {
+            evaluateTile(tile);
+        }
+    }
+}
+
+// cells holds x1, x2, y1, y2 for each primary grid cell
+-(void) traceCells:(NSUInteger*)cells Count:(NSUInteger)noCells {
+    // the subdivision only compares the stored values, so keep it on this thread
+    for (NSUInteger k = 0; k < noCells; k++) {
+        [self contour1ForX1:cells[k * 4] X2:cells[k * 4 + 1] Y1:cells[k * 4 + 2] Y2:cells[k * 4 + 3]];
+    }
+    [self pass2Cells:cells Count:noCells];
+}
+
+// traces the isocurves through cells that have already been subdivided
+-(void) pass2Cells:(NSUInteger*)cells Count:(NSUInteger)noCells {
+    if ( self.concurrentGeneration ) {
+        // one isocurve per work item
+        dispatch_apply((size_t)contourPlanes.used, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iPlane) {
+            NSRange plane = NSMakeRange((NSUInteger)iPlane, 1);
+            for (NSUInteger k = 0; k < noCells; k++) {
+                [self pass2ForX1:cells[k * 4] X2:cells[k * 4 + 1] Y1:cells[k * 4 + 2] Y2:cells[k * 4 + 3] Planes:plane];
+            }
+        });
+    }
+    else {
+        for (NSUInteger k = 0; k < noCells; k++) {
+            [self pass2ForX1:cells[k * 4] X2:cells[k * 4 + 1] Y1:cells[k * 4 + 2] Y2:cells[k * 4 + 3]];
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark EXTEND CONTOURS
+
+-(BOOL) extendToLimits:(double*)newLimits {
+    if ( !self.denseField ) {
+        return NO;
+    }
+    
+    // snap the new limits outwards onto the existing grid, so the spacing and every evaluated node is kept
+    double dX = self.deltaX;
+    double dY = self.deltaY;
+    NSUInteger left = newLimits[0] < self.limits[0] ? (NSUInteger)ceil((self.limits[0] - newLimits[0]) / dX) : 0;
+    NSUInteger right = newLimits[1] > self.limits[1] ? (NSUInteger)ceil((newLimits[1] - self.limits[1]) / dX) : 0;
+    NSUInteger bottom = newLimits[2] < self.limits[2] ? (NSUInteger)ceil((self.limits[2] - newLimits[2]) / dY) : 0;
+    NSUInteger top = newLimits[3] > self.limits[3] ? (NSUInteger)ceil((newLimits[3] - self.limits[3]) / dY) : 0;
+    if ( left + right + bottom + top == 0 ) {
+        return YES;
+    }
+    
+    NSUInteger oldColumns = self.noColumnsSecondary;
+    NSUInteger oldRows = self.noRowsSecondary;
+    NSUInteger columns = oldColumns + left + right;
+    NSUInteger rows = oldRows + bottom + top;
+    NSUInteger oldNoBandsX = self.noRowsFirst;
+    NSUInteger oldNoBandsY = self.noColumnsFirst;
+    NSUInteger *oldBoundsX = self.bandBoundsX;
+    NSUInteger *oldBoundsY = self.bandBoundsY;
+    
+    // the old cells along a grown side were traced with nothing beyond them. Once the new cells next to
+    // them are subdivided an isocurve can cross their shared edge somewhere else, so take back what these
+    // cells exported and trace them again when their new neighbours are in place
+    NSUInteger *ringCells = (NSUInteger*)malloc(2 * (oldNoBandsX + oldNoBandsY) * 4 * sizeof(NSUInteger));
+    NSUInteger noRingCells = 0;
+    for (NSUInteger i = 0; i < oldNoBandsX; i++) {
+        for (NSUInteger j = 0; j < oldNoBandsY; j++) {
+            if ( (left > 0 && i == 0) || (right > 0 && i == oldNoBandsX - 1) || (bottom > 0 && j == 0) || (top > 0 && j == oldNoBandsY - 1) ) {
+                ringCells[noRingCells * 4] = oldBoundsX[i];
+                ringCells[noRingCells * 4 + 1] = oldBoundsX[i + 1];
+                ringCells[noRingCells * 4 + 2] = oldBoundsY[j];
+                ringCells[noRingCells * 4 + 3] = oldBoundsY[j + 1];
+                noRingCells++;
+            }
+        }
+    }
+    self.withdrawingLines = YES;
+    [self pass2Cells:ringCells Count:noRingCells];
+    self.withdrawingLines = NO;
+    
+    // move the evaluated columns into the grown grid
+    FunctionDatum **data = (FunctionDatum**)calloc((size_t)(columns + 1), sizeof(FunctionDatum*));
+    for (NSUInteger x = 0; x <= oldColumns; x++) {
+        FunctionDatum *column = (FunctionDatum*)realloc(self.functionData[x], (size_t)(rows + 1) * sizeof(FunctionDatum));
+        memmove(column + bottom, column, (size_t)(oldRows + 1) * sizeof(FunctionDatum));
+        data[x + left] = column;
+    }
+    for (NSUInteger x = 0; x <= columns; x++) {
+        if ( data[x] == NULL ) {
+            data[x] = (FunctionDatum*)calloc((size_t)(rows + 1), sizeof(FunctionDatum));
+        }
+    }
+    free(self.functionData);
+    self.functionData = data;
+    
+    self.limits[0] -= dX * (double)left;
+    self.limits[1] += dX * (double)right;
+    self.limits[2] -= dY * (double)bottom;
+    self.limits[3] += dY * (double)top;
+    self.noColumnsSecondary = columns;
+    self.noRowsSecondary = rows;
+    maxColumnsByRows = (columns + 1) * (rows + 1);
+    
+    [self remapIndicesFromColumns:oldColumns Rows:oldRows OffsetX:left OffsetY:bottom];
+    [self evaluateFieldExcludingColumns:NSMakeRange(left, oldColumns + 1) Rows:NSMakeRange(bottom, oldRows + 1)];
+    
+    // primary cells of the border, the same size as the existing ones and lined up with them
+    NSUInteger cellWidth = MAX(oldColumns / oldNoBandsX, 1);
+    NSUInteger cellHeight = MAX(oldRows / oldNoBandsY, 1);
+    NSUInteger noLeftBands = (left + cellWidth - 1) / cellWidth;
+    NSUInteger noRightBands = (right + cellWidth - 1) / cellWidth;
+    NSUInteger noBottomBands = (bottom + cellHeight - 1) / cellHeight;
+    NSUInteger noTopBands = (top + cellHeight - 1) / cellHeight;
+    NSUInteger noBandsX = noLeftBands + oldNoBandsX + noRightBands;
+    NSUInteger noBandsY = noBottomBands + oldNoBandsY + noTopBands;
+    
+    NSUInteger *boundsX = (NSUInteger*)malloc((noBandsX + 1) * sizeof(NSUInteger));
+    NSUInteger *boundsY = (NSUInteger*)malloc((noBandsY + 1) * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < noLeftBands; i++) {
+        boundsX[i] = (i * left) / noLeftBands;
+    }
+    for (NSUInteger i = 0; i <= oldNoBandsX; i++) {
+        boundsX[noLeftBands + i] = left + oldBoundsX[i];
+    }
+    for (NSUInteger i = 1; i <= noRightBands; i++) {
+        boundsX[noLeftBands + oldNoBandsX + i] = left + oldColumns + (i * right) / noRightBands;
+    }
+    for (NSUInteger j = 0; j < noBottomBands; j++) {
+        boundsY[j] = (j * bottom) / noBottomBands;
+    }
+    for (NSUInteger j = 0; j <= oldNoBandsY; j++) {
+        boundsY[noBottomBands + j] = bottom + oldBoundsY[j];
+    }
+    for (NSUInteger j = 1; j <= noTopBands; j++) {
+        boundsY[noBottomBands + oldNoBandsY + j] = bottom + oldRows + (j * top) / noTopBands;
+    }
+    
+    NSUInteger *cells = (NSUInteger*)malloc((noBandsX * noBandsY - oldNoBandsX * oldNoBandsY) * 4 * sizeof(NSUInteger));
+    NSUInteger noCells = 0;
+    for (NSUInteger i = 0; i < noBandsX; i++) {
+        BOOL insideX = i >= noLeftBands && i < noLeftBands + oldNoBandsX;
+        for (NSUInteger j = 0; j < noBandsY; j++) {
+            if ( insideX && j >= noBottomBands && j < noBottomBands + oldNoBandsY ) {
+                continue;   // already traced
+            }
+            cells[noCells * 4] = boundsX[i];
+            cells[noCells * 4 + 1] = boundsX[i + 1];
+            cells[noCells * 4 + 2] = boundsY[j];
+            cells[noCells * 4 + 3] = boundsY[j + 1];
+            noCells++;
+        }
+    }
+    self.noRowsFirst = noBandsX;
+    self.noColumnsFirst = noBandsY;
+    
+    [self traceCells:cells Count:noCells];
+    
+    for (NSUInteger k = 0; k < noRingCells; k++) {
+        ringCells[k * 4] += left;
+        ringCells[k * 4 + 1] += left;
+        ringCells[k * 4 + 2] += bottom;
+        ringCells[k * 4 + 3] += bottom;
+    }
+    [self pass2Cells:ringCells Count:noRingCells];
+    
+    free(cells);
+    free(ringCells);
+    free(oldBoundsX);
+    free(oldBoundsY);
+    self.bandBoundsX = boundsX;
+    self.bandBoundsY = boundsY;
+    return YES;
+}
+
+-(void) remapIndicesFromColumns:(NSUInteger)oldColumns Rows:(NSUInteger)oldRows OffsetX:(NSUInteger)offsetX OffsetY:(NSUInteger)offsetY {
+    // discontinuities are indexed with a stride of noRowsSecondary + 1
+    NSUInteger oldStride = oldRows + 1;
+    NSUInteger stride = self.noRowsSecondary + 1;
+    size_t n = discontinuities.used;
+    if ( n > 0 ) {
+        NSUInteger *indices = (NSUInteger*)malloc(n * sizeof(NSUInteger));
+        for (size_t i = 0; i < n; i++) {
+            NSUInteger index = discontinuities.array[i];
+            indices[i] = (index / oldStride + offsetY) * stride + index % oldStride + offsetX;
+        }
+        clearDiscontinuities(&discontinuities);
+        for (size_t i = 0; i < n; i++) {
+            [self recordDiscontinuityAtIndex:indices[i]];
+        }
+        free(indices);
+    }
+}
+
+-(void) recordDiscontinuityAtIndex:(NSUInteger)index {
+    if ( index < maxColumnsByRows ) {
+        pthread_mutex_lock(&discontinuitiesMutex);
+        if ( !containsDiscontinuities(&discontinuities, index) ) {
+            appendDiscontinuities(&discontinuities, index);
+        }
+        pthread_mutex_unlock(&discontinuitiesMutex);
+    }
+}
+
 -(double) fieldForX:(NSUInteger)x Y:(NSUInteger)y {   /* evaluate funct if we must,    */
     double x1, y1;
     
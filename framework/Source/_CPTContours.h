@@ -94,12 +94,13 @@ typedef struct {
 -(IndicesList* _Nullable) getIntersectionIndicesList;
 
 /**
- *  The reads all planes and contours from the disk
+ *  Reads all planes and contours from a cache file written by writePlanesToDisk:, the file is memory mapped.
+ *  Returns NO if the file was generated for a different field block, limits, grid or isocurve values.
  */
 -(BOOL) readPlanesFromDisk:(nonnull NSString*)filePath;
 
 /**
- *  The writes all planes and contours to the disk
+ *  Writes all planes and contours to a versioned cache file, each strip stored as a contiguous array
  */
 -(BOOL) writePlanesToDisk:(nonnull NSString*)filePath;
 
@@ -149,6 +149,38 @@ void freeOccurences(Occurences *a) {
 
 
 
+// Planes cache file layout, every section is 8 byte aligned so a mapped file can be read in place:
+//  ContourPlanesCacheHeader
+//  double   isocurve values[noIsoCurves]
+//  uint64_t strips per isocurve[noIsoCurves]
+//  uint64_t strip lengths[noStrips]
+//  NSUInteger strip node indices[noIndices]
+//  NSUInteger discontinuity indices[noDiscontinuities]
+#define kContourPlanesCacheMagic   0x43505443   // 'CPTC'
+#define kContourPlanesCacheVersion 2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t indexSize;             // sizeof(NSUInteger) of the writer
+    uint64_t fieldGeneration;       // generation of the field block the planes were generated from
+    double limits[4];
+    uint64_t noColumnsFirst;
+    uint64_t noRowsFirst;
+    uint64_t noColumnsSecondary;
+    uint64_t noRowsSecondary;
+    uint64_t noIsoCurves;
+    uint64_t noStrips;
+    uint64_t noIndices;
+    uint64_t noDiscontinuities;
+    double deltaX;
+    double deltaY;
+} ContourPlanesCacheHeader;
+
+static NSUInteger contourPlanesCacheLength(uint64_t noIsoCurves, uint64_t noStrips, uint64_t noIndices, uint64_t noDiscontinuities) {
+    return (NSUInteger)(sizeof(ContourPlanesCacheHeader) + noIsoCurves * (sizeof(double) + sizeof(uint64_t)) + noStrips * sizeof(uint64_t) + (noIndices + noDiscontinuities) * sizeof(NSUInteger));
+}
+
 @interface CPTContours()
 
 -(BOOL) checkForCrossesOverOnStrip:(LineStrip*)pStrip Index:(NSUInteger)index Jndex:(NSUInteger)jndex StartIndex:(NSUInteger*)startIndex;
@@ -250,128 +282,154 @@ static IsoCurvesList extraLineStripLists;
 #pragma mark Input/Output
 
 -(BOOL) readPlanesFromDisk:(NSString*)filePath {
-    BOOL OK = NO;
+    // mapped rather than read, the strips are copied straight out of the file's pages
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:NULL];
+    if ( data.length < sizeof(ContourPlanesCacheHeader) ) {
+        return NO;
+    }
+    
+    const ContourPlanesCacheHeader *header = (const ContourPlanesCacheHeader*)data.bytes;
+    NSUInteger noIsoCurves = [self getNoIsoCurves];
+    double *limits = [self getLimits];
+    if ( header->magic != kContourPlanesCacheMagic || header->version != kContourPlanesCacheVersion || header->indexSize != sizeof(NSUInteger) ||
+        header->fieldGeneration != (uint64_t)self.fieldGeneration ||
+        header->limits[0] != limits[0] || header->limits[1] != limits[1] || header->limits[2] != limits[2] || header->limits[3] != limits[3] ||
+        header->noColumnsFirst != [self getNoColumnsFirstGrid] || header->noRowsFirst != [self getNoRowsFirstGrid] ||
+        header->noColumnsSecondary != [self getNoColumnsSecondaryGrid] || header->noRowsSecondary != [self getNoRowsSecondaryGrid] ||
+        header->noIsoCurves != noIsoCurves ) {
+        return NO;
+    }
+    if ( data.length != contourPlanesCacheLength(header->noIsoCurves, header->noStrips, header->noIndices, header->noDiscontinuities) ) {
+        return NO;
+    }
+    
+    const uint8_t *bytes = (const uint8_t*)data.bytes + sizeof(ContourPlanesCacheHeader);
+    const double *isoCurveValues = (const double*)bytes;
+    if ( noIsoCurves > 0 && memcmp(isoCurveValues, [self getIsoCurves], noIsoCurves * sizeof(double)) != 0 ) {
+        return NO;
+    }
+    const uint64_t *stripCounts = (const uint64_t*)(isoCurveValues + noIsoCurves);
+    const uint64_t *stripLengths = stripCounts + noIsoCurves;
+    const NSUInteger *indices = (const NSUInteger*)(stripLengths + header->noStrips);
+    const NSUInteger *discontinuityIndices = indices + header->noIndices;
+    
+    uint64_t totalStrips = 0, totalIndices = 0;
+    for(NSUInteger iPlane = 0; iPlane < noIsoCurves; iPlane++) {
+        totalStrips += stripCounts[iPlane];
+    }
+    if ( totalStrips != header->noStrips ) {
+        return NO;
+    }
+    for(uint64_t i = 0; i < header->noStrips; i++) {
+        totalIndices += stripLengths[i];
+    }
+    if ( totalIndices != header->noIndices ) {
+        return NO;
+    }
     
     [self initialiseMemory];
     
-    NSMutableData *data = [[NSMutableData alloc] initWithContentsOfFile:filePath];
-    if(data.length > 0) {
-        NSUInteger index, noIsoCurves;
-        LineStripList stripList;
-        LineStrip strip;
-        size_t stripLists_Size, strip_Size;;
-        
-        NSRange theRange = NSMakeRange(0, 0);
-        NSUInteger counter = 0;
-        theRange.location = counter;
-        theRange.length = sizeof(size_t);
-        counter+= theRange.length;
-        [data getBytes:&noIsoCurves range:theRange];
-        if ( noIsoCurves == [self getNoIsoCurves] ) {
-            for(NSUInteger iPlane = 0; iPlane < [self getNoIsoCurves]; iPlane++) {
-                theRange.location = counter;
-                theRange.length = sizeof(size_t);
-                counter+= theRange.length;
-                
-                [data getBytes:&stripLists_Size range:theRange];
-                initLineStripList(&stripList, stripLists_Size);
-                
-//                NSLog(@"Number of strips : %ld\n", stripLists_Size);
-                
-                for(NSUInteger i = 0; i < stripLists_Size; i++) {
-                    theRange.location = counter;
-                    theRange.length = sizeof(size_t);
-                    counter+= theRange.length;
-                    [data getBytes:&strip_Size range:theRange];
-                    initLineStrip(&strip, strip_Size);
-                    
-                    for(NSUInteger j = 0; j < strip_Size; j++) {
-                        theRange.location = counter;
-                        theRange.length = sizeof(NSUInteger);
-                        counter+= theRange.length;
-                        [data getBytes:&index range:theRange];
-                        appendLineStrip(&strip, index);
-                    }
-                    appendLineStripList(&stripList, strip);
-//                    printf("\t%ld\t%ld\t%ld\n", strip.used, strip.array[0], strip.array[strip.used-1]);
-                }
-//                printf("\n");
-                if(&stripList.used > 0) {
-                    [self setStripListAtPlane:iPlane StripList:&stripList];
-                }
-            }
-            double deltaX, deltaY;
-            theRange.location = counter;
-            theRange.length = sizeof(size_t);
-            counter+= theRange.length;
-            [data getBytes:&deltaX range:theRange];
-            [self setDX:deltaX];
-            theRange.location = counter;
-            theRange.length = sizeof(size_t);
-            counter+= theRange.length;
-            [data getBytes:&deltaY range:theRange];
-            [self setDY:deltaY];
-            theRange.location = counter;
-            theRange.length = sizeof(size_t);
-            counter+= theRange.length;
-            NSUInteger noDiscontinuities;
-            [data getBytes:&noDiscontinuities range:theRange];
-            Discontinuities *pDiscontinuties = [self getDiscontinuities];
-            if ( pDiscontinuties->size == 0 ) {
-                initDiscontinuities(pDiscontinuties, noDiscontinuities);
-            }
-            else {
-                clearDiscontinuities(pDiscontinuties);
-            }
-            for( NSUInteger i = 0; i < noDiscontinuities; i++ ) {
-                theRange.location = counter;
-                theRange.length = sizeof(NSUInteger);
-                counter+= theRange.length;
-                [data getBytes:&index range:theRange];
-                appendDiscontinuities(pDiscontinuties, index);
-            }
-            OK = YES;
+    LineStripList stripList;
+    LineStrip strip;
+    for(NSUInteger iPlane = 0; iPlane < noIsoCurves; iPlane++) {
+        size_t noStrips = (size_t)stripCounts[iPlane];
+        if ( noStrips == 0 ) {
+            continue;
+        }
+        initLineStripList(&stripList, noStrips);
+        for(size_t i = 0; i < noStrips; i++) {
+            size_t length = (size_t)*stripLengths++;
+            initLineStrip(&strip, length);
+            memcpy(strip.array, indices, length * sizeof(NSUInteger));
+            strip.used = length;
+            indices += length;
+            appendLineStripList(&stripList, strip);
         }
+        [self setStripListAtPlane:iPlane StripList:&stripList];
+        // the plane's list now owns the strips
+        freeLineStripList(&stripList);
     }
-    return OK;
+    [self setDX:header->deltaX];
+    [self setDY:header->deltaY];
+    
+    Discontinuities *pDiscontinuties = [self getDiscontinuities];
+    if ( pDiscontinuties->size == 0 ) {
+        initDiscontinuities(pDiscontinuties, (size_t)MAX(header->noDiscontinuities, 8));
+    }
+    else {
+        clearDiscontinuities(pDiscontinuties);
+    }
+    for( NSUInteger i = 0; i < header->noDiscontinuities; i++ ) {
+        appendDiscontinuities(pDiscontinuties, discontinuityIndices[i]);
+    }
+    return YES;
 }
 
 -(BOOL) writePlanesToDisk:(NSString*)filePath {
-    
-    NSMutableData *data = [[NSMutableData alloc] init];
-    NSUInteger index, noIsoCurves = [self getNoIsoCurves];
+    NSUInteger noIsoCurves = [self getNoIsoCurves];
+    Discontinuities *pDiscontinuties = [self getDiscontinuities];
+    LineStripList* pStripList;
     LineStrip* pStrip;
-
-    [data appendBytes:&noIsoCurves length:(NSUInteger)sizeof(size_t)];
+    
+    // size everything first so the file is built in a single buffer
+    uint64_t noStrips = 0, noIndices = 0;
     for(NSUInteger iPlane = 0; iPlane < noIsoCurves; iPlane++) {
-        LineStripList* pStripList = [self getStripListForIsoCurve:iPlane];
-        [data appendBytes:&pStripList->used length:(NSUInteger)sizeof(size_t)];
-        if ( pStripList->used > 0 ) {
-            for (NSUInteger pos = 0; pos < pStripList->used; pos++) {
-                pStrip = &pStripList->array[pos];
-                NSAssert(pStrip, @"pStrip is null");
-                [data appendBytes:&pStrip->used length:(NSUInteger)sizeof(size_t)];
-                if ( pStrip->used > 0 ) {
-                    for (NSUInteger pos2 = 0; pos2 < pStrip->used; pos2++) {
-                        index = pStrip->array[pos2];
-                        [data appendBytes:&index length:(NSUInteger)sizeof(NSUInteger)];
-                    }
-                }
+        pStripList = [self getStripListForIsoCurve:iPlane];
+        for (NSUInteger pos = 0; pos < pStripList->used; pos++) {
+            pStrip = &pStripList->array[pos];
+            if ( pStrip->used > 0 ) {
+                noStrips++;
+                noIndices += pStrip->used;
             }
         }
     }
-    double delta = [self getDX];
-    [data appendBytes:&delta length:(NSUInteger)sizeof(double)];
-    delta = [self getDY];
-    [data appendBytes:&delta length:(NSUInteger)sizeof(double)];
+    NSMutableData *data = [NSMutableData dataWithLength:contourPlanesCacheLength(noIsoCurves, noStrips, noIndices, pDiscontinuties->used)];
+    
+    ContourPlanesCacheHeader *header = (ContourPlanesCacheHeader*)data.mutableBytes;
+    double *limits = [self getLimits];
+    header->magic = kContourPlanesCacheMagic;
+    header->version = kContourPlanesCacheVersion;
+    header->indexSize = sizeof(NSUInteger);
+    header->fieldGeneration = (uint64_t)self.fieldGeneration;
+    header->limits[0] = limits[0];
+    header->limits[1] = limits[1];
+    header->limits[2] = limits[2];
+    header->limits[3] = limits[3];
+    header->noColumnsFirst = [self getNoColumnsFirstGrid];
+    header->noRowsFirst = [self getNoRowsFirstGrid];
+    header->noColumnsSecondary = [self getNoColumnsSecondaryGrid];
+    header->noRowsSecondary = [self getNoRowsSecondaryGrid];
+    header->noIsoCurves = noIsoCurves;
+    header->noStrips = noStrips;
+    header->noIndices = noIndices;
+    header->noDiscontinuities = pDiscontinuties->used;
+    header->deltaX = [self getDX];
+    header->deltaY = [self getDY];
     
-    [data appendBytes:&[self getDiscontinuities]->used length:(NSUInteger)sizeof(size_t)];
-    for( NSUInteger i = 0; i < [self getDiscontinuities]->used; i++ ) {
-        [data appendBytes:&[self getDiscontinuities]->array[i] length:(NSUInteger)sizeof(NSUInteger)];
+    double *isoCurveValues = (double*)((uint8_t*)data.mutableBytes + sizeof(ContourPlanesCacheHeader));
+    if ( noIsoCurves > 0 ) {
+        memcpy(isoCurveValues, [self getIsoCurves], noIsoCurves * sizeof(double));
+    }
+    uint64_t *stripCounts = (uint64_t*)(isoCurveValues + noIsoCurves);
+    uint64_t *stripLengths = stripCounts + noIsoCurves;
+    NSUInteger *indices = (NSUInteger*)(stripLengths + noStrips);
+    for(NSUInteger iPlane = 0; iPlane < noIsoCurves; iPlane++) {
+        pStripList = [self getStripListForIsoCurve:iPlane];
+        for (NSUInteger pos = 0; pos < pStripList->used; pos++) {
+            pStrip = &pStripList->array[pos];
+            if ( pStrip->used > 0 ) {
+                stripCounts[iPlane]++;
+                *stripLengths++ = pStrip->used;
+                memcpy(indices, pStrip->array, pStrip->used * sizeof(NSUInteger));
+                indices += pStrip->used;
+            }
+        }
+    }
+    if ( pDiscontinuties->used > 0 ) {
+        memcpy(indices, pDiscontinuties->array, pDiscontinuties->used * sizeof(NSUInteger));
     }
     
-    BOOL OK = [data writeToFile:filePath atomically:YES];
-    return OK;
+    return [data writeToFile:filePath options:NSDataWritingAtomic error:NULL];
 }
 
 #pragma mark Intersections of Contours and Create Extra Contours
@@ -0,0 +1,57 @@
+//
+//  _CPTFixedPointNumbers.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Fixed point copy of an NSDecimal cache field. Every sample is held as a 64-bit integer
+//  scaled by a power of ten shared by the whole field, chosen so the samples keep all their
+//  digits, so range checks compare integers exactly and view points are worked out in double
+//  precision instead of NSDecimal arithmetic. Samples that cannot be held exactly are marked
+//  and handled through their NSDecimal values, as are labels, which always use the cache.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlot.h"
+#import "_CPTRangeClassification.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// fixed point value of a NaN sample
+#define CPTFixedPointNaN ((int64_t)INT64_MIN)
+// fixed point value of a sample too large or too precise for the shared exponent
+#define CPTFixedPointOverflow CPTRangeClassificationFixedPointMarker
+
+@interface _CPTFixedPointNumbers : NSObject
+
+// power of ten applied to every value
+@property (nonatomic, readonly) short exponent;
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly, nonnull) const int64_t *values;
+// number of samples marked CPTFixedPointOverflow
+@property (nonatomic, readonly) NSUInteger overflowCount;
+
+-(nonnull instancetype)initWithNumbers:(nonnull CPTNumericData *)numbers NS_DESIGNATED_INITIALIZER;
+
+// YES if numbers still hold the samples this copy was made from
+-(BOOL)isValidForNumbers:(nonnull CPTNumericData *)numbers;
+
+-(NSDecimal)decimalForValue:(int64_t)value;
+// limits of range at the shared exponent, NO if the decimal classification must be used instead
+-(BOOL)getLimits:(nonnull CPTRangeClassificationFixedPointLimits *)limits forRange:(nullable CPTPlotRange *)range;
+// samples as doubles for the view transforms, overflowed ones are read from decimals
+-(void)getDoubles:(nonnull double *)doubles decimals:(nonnull const NSDecimal *)decimals;
+// extrema of the non-NaN samples, returns the number of NaN samples
+-(NSUInteger)getMinimum:(nonnull NSDecimal *)minimum maximum:(nonnull NSDecimal *)maximum decimals:(nonnull const NSDecimal *)decimals;
+
+@end
+
+@interface CPTPlot(FixedPointNumbers)
+
+// fixed point copy of an NSDecimal field, built on first use and kept until the field changes
+-(nullable _CPTFixedPointNumbers *)fixedPointNumbersForField:(NSUInteger)fieldEnum;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,341 @@
+//
+//  _CPTFixedPointNumbers.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTFixedPointNumbers.h"
+
+#import "CPTNumericData.h"
+#import "CPTPlotRange.h"
+#import "CPTUtilities.h"
+#import <tgmath.h>
+
+// digits every value of an int64_t can hold
+static const int CPTFixedPointDigits = 18;
+
+static const uint64_t CPTFixedPointPowersOfTen[] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull
+};
+
+static const int CPTFixedPointMaximumShift = (int)(sizeof(CPTFixedPointPowersOfTen) / sizeof(CPTFixedPointPowersOfTen[0])) - 1;
+
+// largest magnitude of a fixed point value, keeping INT64_MAX free for the range limits
+static const uint64_t CPTFixedPointMaximumMagnitude = (uint64_t)INT64_MAX - 1;
+
+// mantissa of decimal, NO if it needs more than 64 bits
+static inline BOOL CPTFixedPointMantissa(const NSDecimal *decimal, uint64_t *mantissa)
+{
+    if ( decimal->_length > 4 ) {
+        return NO;
+    }
+
+    uint64_t value = 0;
+
+    for ( unsigned int i = decimal->_length; i > 0; i-- ) {
+        value = (value << 16) | decimal->_mantissa[i - 1];
+    }
+    *mantissa = value;
+
+    return YES;
+}
+
+static inline int CPTFixedPointDigitCount(uint64_t mantissa)
+{
+    int digits = 1;
+
+    while ( digits <= CPTFixedPointMaximumShift && mantissa >= CPTFixedPointPowersOfTen[digits] ) {
+        digits++;
+    }
+    return digits;
+}
+
+// mantissa * 10^shift, truncated toward zero; NO if the result does not fit in 64 bits
+static inline BOOL CPTFixedPointScale(uint64_t mantissa, int shift, uint64_t *scaled, BOOL *inexact)
+{
+    *inexact = NO;
+
+    if ( mantissa == 0 ) {
+        *scaled = 0;
+        return YES;
+    }
+
+    if ( shift >= 0 ) {
+        return (shift <= CPTFixedPointMaximumShift) && !__builtin_mul_overflow(mantissa, CPTFixedPointPowersOfTen[shift], scaled);
+    }
+
+    if ( -shift > CPTFixedPointMaximumShift ) {
+        *scaled  = 0;
+        *inexact = YES;
+        return YES;
+    }
+
+    uint64_t divisor = CPTFixedPointPowersOfTen[-shift];
+
+    *scaled  = mantissa / divisor;
+    *inexact = (mantissa % divisor) != 0;
+
+    return YES;
+}
+
+// limit rounded toward the inside of the range, saturated so the integer comparisons keep their result
+static BOOL CPTFixedPointLimit(NSDecimal limit, int exponent, BOOL roundUp, int64_t *result)
+{
+    uint64_t mantissa;
+
+    if ( NSDecimalIsNotANumber(&limit) || !CPTFixedPointMantissa(&limit, &mantissa)) {
+        return NO;
+    }
+
+    BOOL negative = limit._isNegative && (mantissa != 0);
+    BOOL inexact;
+    uint64_t scaled;
+
+    if ( !CPTFixedPointScale(mantissa, limit._exponent - exponent, &scaled, &inexact) || (scaled > CPTFixedPointMaximumMagnitude)) {
+        *result = negative ? CPTFixedPointOverflow : INT64_MAX;
+        return YES;
+    }
+
+    int64_t value = negative ? -(int64_t)scaled : (int64_t)scaled;
+
+    if ( inexact ) {
+        if ( roundUp && !negative ) {
+            value++;
+        }
+        else if ( !roundUp && negative ) {
+            value--;
+        }
+    }
+    *result = value;
+
+    return YES;
+}
+
+@interface _CPTFixedPointNumbers()
+
+@property (nonatomic, readwrite) short exponent;
+@property (nonatomic, readwrite) NSUInteger count;
+@property (nonatomic, readwrite) NSUInteger overflowCount;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableData *valueData;
+@property (nonatomic, readwrite, weak, nullable) CPTNumericData *source;
+@property (nonatomic, readwrite, assign, nullable) const void *sourceBytes;
+
+@end
+
+#pragma mark -
+
+@implementation _CPTFixedPointNumbers
+
+@synthesize exponent;
+@synthesize count;
+@synthesize overflowCount;
+@synthesize valueData;
+@synthesize source;
+@synthesize sourceBytes;
+
+#pragma mark -
+#pragma mark Init/Dealloc
+
+-(nonnull instancetype)initWithNumbers:(nonnull CPTNumericData *)numbers
+{
+    if ((self = [super init])) {
+        const NSDecimal *decimals = (const NSDecimal *)numbers.bytes;
+        NSUInteger sampleCount    = numbers.numberOfSamples;
+
+        // the smallest exponent of the samples, unless the largest sample would then need more digits than fit
+        int minExponent = INT_MAX;
+        int maxDigit    = INT_MIN;
+
+        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+            NSDecimal decimal = decimals[i];
+            uint64_t mantissa;
+
+            if ( !NSDecimalIsNotANumber(&decimal) && CPTFixedPointMantissa(&decimal, &mantissa) && (mantissa != 0)) {
+                minExponent = MIN(minExponent, (int)decimal._exponent);
+                maxDigit    = MAX(maxDigit, (int)decimal._exponent + CPTFixedPointDigitCount(mantissa));
+            }
+        }
+
+        int sharedExponent = (minExponent == INT_MAX) ? 0 : MAX(minExponent, maxDigit - CPTFixedPointDigits);
+
+        NSMutableData *newData = [[NSMutableData alloc] initWithLength:MAX(sampleCount, (NSUInteger)1) * sizeof(int64_t)];
+        int64_t *newValues     = (int64_t *)newData.mutableBytes;
+        NSUInteger overflows   = 0;
+
+        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+            NSDecimal decimal = decimals[i];
+            uint64_t mantissa;
+            uint64_t scaled;
+            BOOL inexact;
+
+            if ( NSDecimalIsNotANumber(&decimal)) {
+                newValues[i] = CPTFixedPointNaN;
+            }
+            else if ( CPTFixedPointMantissa(&decimal, &mantissa) &&
+                      CPTFixedPointScale(mantissa, decimal._exponent - sharedExponent, &scaled, &inexact) &&
+                      !inexact && (scaled <= CPTFixedPointMaximumMagnitude)) {
+                newValues[i] = decimal._isNegative ? -(int64_t)scaled : (int64_t)scaled;
+            }
+            else {
+                newValues[i] = CPTFixedPointOverflow;
+                overflows++;
+            }
+        }
+
+        exponent      = (short)sharedExponent;
+        count         = sampleCount;
+        overflowCount = overflows;
+        valueData     = newData;
+        source        = numbers;
+        sourceBytes   = numbers.bytes;
+    }
+    return self;
+}
+
+-(nonnull instancetype)init
+{
+    return [self initWithNumbers:[CPTNumericData numericDataWithData:[NSData data]
+                                                            dataType:CPTDataType(CPTDecimalDataType, sizeof(NSDecimal), CFByteOrderGetCurrent())
+                                                               shape:nil]];
+}
+
+#pragma mark -
+#pragma mark Accessors
+
+-(nonnull const int64_t *)values
+{
+    return (const int64_t *)self.valueData.bytes;
+}
+
+-(BOOL)isValidForNumbers:(nonnull CPTNumericData *)numbers
+{
+    CPTNumericData *theSource = self.source;
+
+    return (theSource == numbers) && (numbers.bytes == self.sourceBytes) && (numbers.numberOfSamples == self.count) &&
+           (numbers.dataTypeFormat == CPTDecimalDataType);
+}
+
+#pragma mark -
+#pragma mark Conversion
+
+-(NSDecimal)decimalForValue:(int64_t)value
+{
+    NSDecimal result = CPTDecimalFromLongLong(value);
+
+    NSDecimalMultiplyByPowerOf10(&result, &result, self.exponent, NSRoundPlain);
+
+    return result;
+}
+
+-(BOOL)getLimits:(nonnull CPTRangeClassificationFixedPointLimits *)limits forRange:(nullable CPTPlotRange *)range
+{
+    if ( !range ) {
+        // everything is below a missing range, like messaging nil for a comparison
+        limits->minLimit = INT64_MAX;
+        limits->maxLimit = INT64_MAX;
+        return YES;
+    }
+
+    return CPTFixedPointLimit(range.minLimitDecimal, self.exponent, YES, &limits->minLimit) &&
+           CPTFixedPointLimit(range.maxLimitDecimal, self.exponent, NO, &limits->maxLimit);
+}
+
+-(void)getDoubles:(nonnull double *)doubles decimals:(nonnull const NSDecimal *)decimals
+{
+    const int64_t *fixedValues = self.values;
+    NSUInteger sampleCount     = self.count;
+    short theExponent          = self.exponent;
+
+    // divide by the power of ten rather than multiply by its inverse, which has no exact double form
+    double scale = pow(10.0, (double)ABS(theExponent));
+
+    for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+        int64_t value = fixedValues[i];
+
+        if ( value == CPTFixedPointNaN ) {
+            doubles[i] = (double)NAN;
+        }
+        else if ( value == CPTFixedPointOverflow ) {
+            doubles[i] = CPTDecimalDoubleValue(decimals[i]);
+        }
+        else if ( theExponent < 0 ) {
+            doubles[i] = (double)value / scale;
+        }
+        else {
+            doubles[i] = (double)value * scale;
+        }
+    }
+}
+
+-(NSUInteger)getMinimum:(nonnull NSDecimal *)minimum maximum:(nonnull NSDecimal *)maximum decimals:(nonnull const NSDecimal *)decimals
+{
+    const int64_t *fixedValues = self.values;
+    NSUInteger sampleCount     = self.count;
+
+    NSUInteger nanCount = 0;
+    int64_t min         = INT64_MAX;
+    int64_t max         = INT64_MIN;
+
+    for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+        int64_t value = fixedValues[i];
+
+        if ( value > CPTFixedPointOverflow ) {
+            min = MIN(min, value);
+            max = MAX(max, value);
+        }
+        else if ( value == CPTFixedPointNaN ) {
+            nanCount++;
+        }
+    }
+
+    if ( min <= max ) {
+        NSDecimal minDecimal = [self decimalForValue:min];
+        NSDecimal maxDecimal = [self decimalForValue:max];
+
+        if ( CPTDecimalLessThan(minDecimal, *minimum)) {
+            *minimum = minDecimal;
+        }
+        if ( CPTDecimalGreaterThan(maxDecimal, *maximum)) {
+            *maximum = maxDecimal;
+        }
+    }
+
+    if ( self.overflowCount > 0 ) {
+        for ( NSUInteger i = 0; i < sampleCount; i++ ) {
+            if ( fixedValues[i] == CPTFixedPointOverflow ) {
+                NSDecimal value = decimals[i];
+
+                if ( CPTDecimalLessThan(value, *minimum)) {
+                    *minimum = value;
+                }
+                if ( CPTDecimalGreaterThan(value, *maximum)) {
+                    *maximum = value;
+                }
+            }
+        }
+    }
+
+    return nanCount;
+}
+
+@end
@@ -105,8 +105,11 @@ void freeIsoCurvesList(IsoCurvesList *a);
 
 -(void) exportLineForIsoCurve:(NSUInteger)iPlane FromX1:(NSUInteger)x1 FromY1:(NSUInteger)y1 ToX2:(NSUInteger)x2 ToY2:(NSUInteger)y2;
 
-// Basic algorithm to concatanate line strip. Not optimized at all !
+// Segments are welded into line strips as they are exported, compacting then only joins the near misses
 -(void)generateAndCompactStrips;
+// Grows the region keeping the existing strips, only the added border is traced before compacting.
+// Returns NO if the contours were not generated densely and have to be generated again.
+-(BOOL) extendAndCompactStripsToLimits:(double*)newLimits;
 /// debugging
 -(void) dumpPlane:(NSUInteger)iPlane;
 
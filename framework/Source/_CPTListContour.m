@@ -379,6 +379,374 @@ void freeIsoCurvesList(IsoCurvesList *a) {
     a->used = a->size = 0;
 }
 
+//////////////////////////////////////////////////////////////////////
+// Strip assembly
+//
+// Segments exported by the contour tracer are welded into strips as
+// they arrive. Each plane keeps an open addressed map from grid node
+// index to the strip ends sitting on that node, so finding the strip a
+// segment extends is O(1) rather than a scan of every strip, and the
+// strips themselves are deques so that prepending a node is O(1).
+// When a segment bridges the ends of two strips the shorter one is
+// moved onto the longer, so the exact endpoint merging previously done
+// by compactStrips happens during export. Once generation is finished
+// the deques are copied out into the plane's LineStripList.
+//////////////////////////////////////////////////////////////////////
+
+#define kStripEndpointEmpty   SIZE_MAX
+#define kStripEndpointRemoved (SIZE_MAX - 1)
+
+typedef struct {
+    NSUInteger node;    // grid node index
+    size_t strip;       // index into StripAssembly.array, or kStripEndpointEmpty/kStripEndpointRemoved
+    BOOL tail;          // YES for the last node of the strip, NO for the first
+} StripEndpoint;
+
+typedef struct {
+    LineStrip front;    // prepended nodes, most recently prepended last
+    LineStrip back;     // first segment followed by appended nodes
+    BOOL live;          // NO once merged into another strip
+} StripDeque;
+
+typedef struct {
+    StripDeque * _Nullable array;           // strips in the order they were started
+    size_t used;
+    size_t size;
+    StripEndpoint * _Nullable endpoints;    // open addressed, size is a power of 2
+    size_t endpointsSize;
+    size_t endpointsFilled;                 // slots that are in use or removed
+    BOOL collided;                          // two open strips ended on the same node
+    BOOL materialised;                      // strips have been copied to the LineStripList
+    LineStrip withdrawn;                    // segments to take out of the strips, lower node first
+} StripAssembly;
+
+typedef struct {
+    NSUInteger lo;
+    NSUInteger hi;
+} StripSegment;
+
+static size_t hashStripNode(NSUInteger node, size_t mask) {
+    uint64_t h = (uint64_t)node * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h >> 32) & mask;
+}
+
+static void rehashStripEndpoints(StripAssembly *a, size_t newSize) {
+    StripEndpoint *old = a->endpoints;
+    size_t oldSize = a->endpointsSize;
+
+    a->endpoints = (StripEndpoint*)malloc(newSize * sizeof(StripEndpoint));
+    a->endpointsSize = newSize;
+    a->endpointsFilled = 0;
+    for( size_t i = 0; i < newSize; i++ ) {
+        a->endpoints[i].strip = kStripEndpointEmpty;
+    }
+    for( size_t i = 0; i < oldSize; i++ ) {
+        if ( old[i].strip < kStripEndpointRemoved ) {
+            size_t slot = hashStripNode(old[i].node, newSize - 1);
+            while ( a->endpoints[slot].strip != kStripEndpointEmpty ) {
+                slot = (slot + 1) & (newSize - 1);
+            }
+            a->endpoints[slot] = old[i];
+            a->endpointsFilled++;
+        }
+    }
+    free(old);
+}
+
+static void insertStripEndpoint(StripAssembly *a, NSUInteger node, size_t strip, BOOL tail) {
+    if ( (a->endpointsFilled + 1) * 2 > a->endpointsSize ) {
+        rehashStripEndpoints(a, a->endpointsSize == 0 ? 16 : a->endpointsSize * 2);
+    }
+    size_t mask = a->endpointsSize - 1;
+    size_t slot = hashStripNode(node, mask);
+    size_t reuse = kStripEndpointEmpty;
+    while ( a->endpoints[slot].strip != kStripEndpointEmpty ) {
+        if ( a->endpoints[slot].strip == kStripEndpointRemoved ) {
+            if ( reuse == kStripEndpointEmpty ) {
+                reuse = slot;
+            }
+        }
+        else if ( a->endpoints[slot].node == node ) {
+            a->collided = YES;
+        }
+        slot = (slot + 1) & mask;
+    }
+    if ( reuse != kStripEndpointEmpty ) {
+        slot = reuse;
+    }
+    else {
+        a->endpointsFilled++;
+    }
+    a->endpoints[slot].node = node;
+    a->endpoints[slot].strip = strip;
+    a->endpoints[slot].tail = tail;
+}
+
+static StripEndpoint *findStripEndpoint(StripAssembly *a, NSUInteger node) {
+    if ( a->endpointsSize == 0 ) {
+        return NULL;
+    }
+    size_t mask = a->endpointsSize - 1;
+    size_t slot = hashStripNode(node, mask);
+    while ( a->endpoints[slot].strip != kStripEndpointEmpty ) {
+        if ( a->endpoints[slot].strip != kStripEndpointRemoved && a->endpoints[slot].node == node ) {
+            return &a->endpoints[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+static void removeStripEndpoint(StripAssembly *a, NSUInteger node, size_t strip, BOOL tail) {
+    if ( a->endpointsSize == 0 ) {
+        return;
+    }
+    size_t mask = a->endpointsSize - 1;
+    size_t slot = hashStripNode(node, mask);
+    while ( a->endpoints[slot].strip != kStripEndpointEmpty ) {
+        if ( a->endpoints[slot].strip == strip && a->endpoints[slot].node == node && a->endpoints[slot].tail == tail ) {
+            a->endpoints[slot].strip = kStripEndpointRemoved;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+static size_t countStripDeque(StripDeque *d) {
+    return d->front.used + d->back.used;
+}
+
+static NSUInteger stripDequeAtIndex(StripDeque *d, size_t index) {
+    return index < d->front.used ? d->front.array[d->front.used - 1 - index] : d->back.array[index - d->front.used];
+}
+
+static NSUInteger stripDequeEnd(StripDeque *d, BOOL tail) {
+    return stripDequeAtIndex(d, tail ? countStripDeque(d) - 1 : 0);
+}
+
+static void pushStripDeque(StripDeque *d, NSUInteger node, BOOL tail) {
+    appendLineStrip(tail ? &d->back : &d->front, node);
+}
+
+static void startStripAssembly(StripAssembly *a, NSUInteger i1, NSUInteger i2) {
+    if ( a->used == a->size ) {
+        a->size = a->size == 0 ? 8 : a->size * 2;
+        a->array = (StripDeque*)realloc(a->array, a->size * sizeof(StripDeque));
+    }
+    size_t strip = a->used++;
+    StripDeque *d = &a->array[strip];
+    initLineStrip(&d->front, 4);
+    initLineStrip(&d->back, 8);
+    appendLineStrip(&d->back, i1);
+    appendLineStrip(&d->back, i2);
+    d->live = YES;
+    insertStripEndpoint(a, i1, strip, NO);
+    insertStripEndpoint(a, i2, strip, YES);
+}
+
+static void extendStripAssembly(StripAssembly *a, size_t strip, BOOL tail, NSUInteger oldEnd, NSUInteger newEnd) {
+    removeStripEndpoint(a, oldEnd, strip, tail);
+    pushStripDeque(&a->array[strip], newEnd, tail);
+    insertStripEndpoint(a, newEnd, strip, tail);
+}
+
+// the segment i1-i2 joins the end of strip1 sitting on i1 to the end of strip2 sitting on i2
+static void joinStripAssembly(StripAssembly *a, size_t strip1, BOOL tail1, NSUInteger i1, size_t strip2, BOOL tail2, NSUInteger i2) {
+    removeStripEndpoint(a, i1, strip1, tail1);
+    removeStripEndpoint(a, i2, strip2, tail2);
+    if ( strip1 == strip2 ) {
+        // closes the strip, neither end can be extended any further
+        pushStripDeque(&a->array[strip1], i2, tail1);
+        return;
+    }
+
+    // move the shorter strip onto the longer one, starting at the joined end
+    size_t target = strip1, source = strip2;
+    BOOL targetTail = tail1, sourceTail = tail2;
+    if ( countStripDeque(&a->array[strip2]) > countStripDeque(&a->array[strip1]) ) {
+        target = strip2;
+        source = strip1;
+        targetTail = tail2;
+        sourceTail = tail1;
+    }
+    StripDeque *pTarget = &a->array[target];
+    StripDeque *pSource = &a->array[source];
+    NSUInteger farEnd = stripDequeEnd(pSource, !sourceTail);
+    removeStripEndpoint(a, farEnd, source, !sourceTail);
+
+    size_t n = countStripDeque(pSource);
+    for( size_t k = 0; k < n; k++ ) {
+        pushStripDeque(pTarget, stripDequeAtIndex(pSource, sourceTail ? n - 1 - k : k), targetTail);
+    }
+    freeLineStrip(&pSource->front);
+    freeLineStrip(&pSource->back);
+    pSource->live = NO;
+
+    if ( farEnd == stripDequeEnd(pTarget, !targetTail) ) {
+        removeStripEndpoint(a, farEnd, target, !targetTail);
+    }
+    else {
+        insertStripEndpoint(a, farEnd, target, targetTail);
+    }
+}
+
+// carries a strip that has already been generated into the assembly so new segments can extend it
+static void seedStripAssembly(StripAssembly *a, LineStrip strip) {
+    if ( a->used == a->size ) {
+        a->size = a->size == 0 ? 8 : a->size * 2;
+        a->array = (StripDeque*)realloc(a->array, a->size * sizeof(StripDeque));
+    }
+    size_t index = a->used++;
+    StripDeque *d = &a->array[index];
+    initLineStrip(&d->front, 4);
+    d->back = strip;
+    d->live = YES;
+    if ( strip.array[0] != strip.array[strip.used - 1] ) {
+        insertStripEndpoint(a, strip.array[0], index, NO);
+        insertStripEndpoint(a, strip.array[strip.used - 1], index, YES);
+    }
+}
+
+static void materialiseStripAssembly(StripAssembly *a, LineStripList *pStripList) {
+    if ( pStripList->size == 0 ) {
+        initLineStripList(pStripList, 8);
+    }
+    // most recently started strips first, as the strips used to be inserted at the front of the list
+    for( size_t s = a->used; s-- > 0; ) {
+        StripDeque *d = &a->array[s];
+        if ( d->live ) {
+            size_t n = countStripDeque(d);
+            LineStrip strip;
+            initLineStrip(&strip, n);
+            for( size_t k = 0; k < n; k++ ) {
+                appendLineStrip(&strip, stripDequeAtIndex(d, k));
+            }
+            appendLineStripList(pStripList, strip);
+            freeLineStrip(&d->front);
+            freeLineStrip(&d->back);
+        }
+    }
+    free(a->array);
+    free(a->endpoints);
+    a->array = NULL;
+    a->endpoints = NULL;
+    a->used = a->size = 0;
+    a->endpointsSize = a->endpointsFilled = 0;
+    a->materialised = YES;
+}
+
+static void freeStripAssembly(StripAssembly *a) {
+    for( size_t s = 0; s < a->used; s++ ) {
+        if ( a->array[s].live ) {
+            freeLineStrip(&a->array[s].front);
+            freeLineStrip(&a->array[s].back);
+        }
+    }
+    free(a->array);
+    free(a->endpoints);
+    free(a->withdrawn.array);
+    memset(a, 0, sizeof(StripAssembly));
+}
+
+static int compareStripSegments(const void *a, const void *b) {
+    const StripSegment *aO = (const StripSegment*)a;
+    const StripSegment *bO = (const StripSegment*)b;
+    
+    if ( aO->lo != bO->lo ) {
+        return aO->lo > bO->lo ? 1 : -1;
+    }
+    if ( aO->hi != bO->hi ) {
+        return aO->hi > bO->hi ? 1 : -1;
+    }
+    return 0;
+}
+
+// marks one copy of the segment i1-i2 as taken, segments is sorted
+static BOOL takeStripSegment(StripSegment *segments, BOOL *taken, size_t noSegments, NSUInteger i1, NSUInteger i2) {
+    StripSegment key = { MIN(i1, i2), MAX(i1, i2) };
+    size_t lo = 0, hi = noSegments;
+    while ( lo < hi ) {
+        size_t mid = (lo + hi) / 2;
+        if ( compareStripSegments(&segments[mid], &key) < 0 ) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    for( ; lo < noSegments && compareStripSegments(&segments[lo], &key) == 0; lo++ ) {
+        if ( !taken[lo] ) {
+            taken[lo] = YES;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// takes the withdrawn segments out of the strips, a strip is split where a segment leaves a gap in it
+// and a closed strip is opened at its first gap
+static void withdrawStripSegments(LineStripList *pStripList, LineStrip *withdrawn) {
+    size_t noSegments = withdrawn->used / 2;
+    if ( noSegments == 0 ) {
+        return;
+    }
+    StripSegment *segments = (StripSegment*)withdrawn->array;
+    qsort(segments, noSegments, sizeof(StripSegment), compareStripSegments);
+    BOOL *taken = (BOOL*)calloc(noSegments, sizeof(BOOL));
+    
+    LineStripList pieces;
+    initLineStripList(&pieces, pStripList->used + 4);
+    for( size_t s = 0; s < pStripList->used; s++ ) {
+        LineStrip *pStrip = &pStripList->array[s];
+        size_t n = pStrip->used;
+        if ( n < 2 ) {
+            appendLineStripList(&pieces, *pStrip);
+            continue;
+        }
+        BOOL *cut = (BOOL*)calloc(n - 1, sizeof(BOOL));
+        size_t firstCut = SIZE_MAX;
+        for( size_t k = 0; k < n - 1; k++ ) {
+            if ( takeStripSegment(segments, taken, noSegments, pStrip->array[k], pStrip->array[k + 1]) ) {
+                cut[k] = YES;
+                if ( firstCut == SIZE_MAX ) {
+                    firstCut = k;
+                }
+            }
+        }
+        if ( firstCut == SIZE_MAX ) {
+            appendLineStripList(&pieces, *pStrip);
+            free(cut);
+            continue;
+        }
+        
+        BOOL closed = n > 2 && pStrip->array[0] == pStrip->array[n - 1];
+        LineStrip piece = { NULL, 0, 0 };
+        for( size_t t = 0; t < n - 1; t++ ) {
+            size_t k = closed ? (firstCut + 1 + t) % (n - 1) : t;
+            if ( cut[k] ) {
+                if ( piece.used > 0 ) {
+                    appendLineStripList(&pieces, piece);
+                    piece = (LineStrip){ NULL, 0, 0 };
+                }
+                continue;
+            }
+            if ( piece.used == 0 ) {
+                initLineStrip(&piece, 8);
+                appendLineStrip(&piece, pStrip->array[k]);
+            }
+            appendLineStrip(&piece, pStrip->array[k + 1]);
+        }
+        if ( piece.used > 0 ) {
+            appendLineStripList(&pieces, piece);
+        }
+        freeLineStrip(pStrip);
+        free(cut);
+    }
+    freeLineStripList(pStripList);
+    *pStripList = pieces;
+    free(taken);
+}
+
 @interface CPTListContour()
 
 
@@ -388,6 +756,9 @@ void freeIsoCurvesList(IsoCurvesList *a) {
 
 // array of line strips
 static IsoCurvesList stripLists;
+// per plane strip assembly used while generating
+static StripAssembly *stripAssemblies = NULL;
+static size_t noStripAssemblies = 0;
 static double overrideWeldDistMultiplier;
 
 @synthesize overrideWeldDistance; // for flexiblity may want to override the Weld Distance for compacting contours
@@ -420,6 +791,63 @@ static double overrideWeldDistMultiplier;
     return &stripLists;
 }
 
+-(BOOL) generate {
+    BOOL OK = [super generate];
+    // copy the welded strips out of the assemblies, a nested regenerate will already have done so
+    for (NSUInteger i = 0; i < (NSUInteger)noStripAssemblies && i < (NSUInteger)stripLists.used; i++) {
+        if ( !stripAssemblies[i].materialised ) {
+            materialiseStripAssembly(&stripAssemblies[i], &stripLists.array[i]);
+        }
+    }
+    return OK;
+}
+
+-(BOOL) extendToLimits:(double*)newLimits {
+    BOOL OK = [super extendToLimits:newLimits];
+    for (NSUInteger i = 0; i < (NSUInteger)noStripAssemblies && i < (NSUInteger)stripLists.used; i++) {
+        if ( !stripAssemblies[i].materialised ) {
+            materialiseStripAssembly(&stripAssemblies[i], &stripLists.array[i]);
+        }
+    }
+    return OK;
+}
+
+-(void) remapIndicesFromColumns:(NSUInteger)oldColumns Rows:(NSUInteger)oldRows OffsetX:(NSUInteger)offsetX OffsetY:(NSUInteger)offsetY {
+    [super remapIndicesFromColumns:oldColumns Rows:oldRows OffsetX:offsetX OffsetY:offsetY];
+    
+    // strips are indexed with a stride of noColumnsSecondary + 1
+    NSUInteger oldStride = oldColumns + 1;
+    NSUInteger stride = [self getNoColumnsSecondaryGrid] + 1;
+    for (NSUInteger i = 0; i < (NSUInteger)stripLists.used && i < (NSUInteger)noStripAssemblies; i++) {
+        LineStripList *pStripList = &stripLists.array[i];
+        StripAssembly *pAssembly = &stripAssemblies[i];
+        withdrawStripSegments(pStripList, &pAssembly->withdrawn);
+        freeStripAssembly(pAssembly);
+        // seeded in reverse so the strips come back out in the same order
+        for (NSUInteger pos = pStripList->used; pos-- > 0; ) {
+            LineStrip *pStrip = &pStripList->array[pos];
+            if ( pStrip->used == 0 ) {
+                freeLineStrip(pStrip);
+                continue;
+            }
+            for (size_t k = 0; k < pStrip->used; k++) {
+                NSUInteger index = pStrip->array[k];
+                pStrip->array[k] = (index / oldStride + offsetY) * stride + index % oldStride + offsetX;
+            }
+            seedStripAssembly(pAssembly, *pStrip);
+        }
+        clearLineStripList(pStripList);
+    }
+}
+
+-(BOOL) extendAndCompactStripsToLimits:(double*)newLimits {
+    if ( [self extendToLimits:newLimits] ) {
+        [self compactStrips];
+        return YES;
+    }
+    return NO;
+}
+
 -(void)generateAndCompactStrips {
     // generate line strips
     if( [self generate] ) {
@@ -429,7 +857,7 @@ static double overrideWeldDistMultiplier;
 }
 
 -(void) initialiseMemory {
-    if ( stripLists.size > 0 ) {
+    if ( stripLists.size > 0 || stripAssemblies != NULL ) {
         [self cleanMemory];
     }
     [super initialiseMemory];
@@ -440,6 +868,8 @@ static double overrideWeldDistMultiplier;
         initLineStripList(&list, 4);
         appendIsoCurvesList(&stripLists, list);
     }
+    stripAssemblies = (StripAssembly*)calloc((size_t)noIsoCurves, sizeof(StripAssembly));
+    noStripAssemblies = (size_t)noIsoCurves;
 }
 
 -(void) cleanMemory {
@@ -464,6 +894,15 @@ static double overrideWeldDistMultiplier;
         }
         freeIsoCurvesList(&stripLists);
     }
+    
+    if ( stripAssemblies != NULL ) {
+        for (size_t i = 0; i < noStripAssemblies; i++) {
+            freeStripAssembly(&stripAssemblies[i]);
+        }
+        free(stripAssemblies);
+        stripAssemblies = NULL;
+        noStripAssemblies = 0;
+    }
 }
 
 
@@ -476,6 +915,10 @@ static double overrideWeldDistMultiplier;
     
     LineStrip* pStrip;
     LineStripList* actualStripList = [self getStripListForIsoCurve:iPlane];
+    if ( (size_t)iPlane < noStripAssemblies ) {
+        // these strips have not been welded, leave it to compactStrips
+        stripAssemblies[iPlane].collided = YES;
+    }
     for(NSUInteger pos = 0; pos < (NSUInteger)pLineStripList->used; pos++) {
         pStrip = &pLineStripList->array[pos];
         if(pStrip->used > 0) {
@@ -496,49 +939,35 @@ static double overrideWeldDistMultiplier;
 //        return;
     }
     
-    LineStripList* pStripList = &stripLists.array[iPlane];
-    if ( pStripList->size == 0 ) {
-        initLineStripList(pStripList, 8);
-        LineStrip strip;
-        initLineStrip(&strip, 2);
-        appendLineStrip(&strip, i1);
-        appendLineStrip(&strip, i2);
-        appendLineStripList(pStripList, strip);
+    if ( i1 == i2 || (size_t)iPlane >= noStripAssemblies ) {
+        return;
     }
-    else {
-        BOOL added = NO;
-        for (NSUInteger pos = 0; pos < pStripList->used && !added; pos++) {
-            LineStrip* pStrip = &pStripList->array[pos];
-            NSAssert(pStrip->array != NULL, @"LineStrip is NULL");
-            if (i1 == pStrip->array[0]) {
-                insertLineStripAtIndex(pStrip, i2, 0);
-                added = YES;
-                break;
-            }
-            else if (i1 == pStrip->array[pStrip->used-1]) {
-                appendLineStrip(pStrip, i2);
-                added = YES;
-                break;
-            }
-            else if (i2 == pStrip->array[0]) {
-                insertLineStripAtIndex(pStrip, i1, 0);
-                added = YES;
-                break;
-            }
-            else if (i2 == pStrip->array[pStrip->used-1]) {
-                appendLineStrip(pStrip, i1);
-                added = YES;
-                break;
-            }
-        }
-        if ( !added ) {
-            // segment was not part of any line strip, creating new one
-            LineStrip strip;
-            initLineStrip(&strip, 8);
-            appendLineStrip(&strip, i1);
-            appendLineStrip(&strip, i2);
-            insertLineStripListAtIndex(pStripList, strip, 0);
+    
+    StripAssembly *pAssembly = &stripAssemblies[iPlane];
+    if ( self.withdrawingLines ) {
+        // taken out of the strips when the indices are remapped
+        if ( pAssembly->withdrawn.size == 0 ) {
+            initLineStrip(&pAssembly->withdrawn, 16);
         }
+        appendLineStrip(&pAssembly->withdrawn, MIN(i1, i2));
+        appendLineStrip(&pAssembly->withdrawn, MAX(i1, i2));
+        return;
+    }
+    pAssembly->materialised = NO;
+    StripEndpoint *pEndpoint1 = findStripEndpoint(pAssembly, i1);
+    StripEndpoint *pEndpoint2 = findStripEndpoint(pAssembly, i2);
+    if ( pEndpoint1 != NULL && pEndpoint2 != NULL ) {
+        joinStripAssembly(pAssembly, pEndpoint1->strip, pEndpoint1->tail, i1, pEndpoint2->strip, pEndpoint2->tail, i2);
+    }
+    else if ( pEndpoint1 != NULL ) {
+        extendStripAssembly(pAssembly, pEndpoint1->strip, pEndpoint1->tail, i1, i2);
+    }
+    else if ( pEndpoint2 != NULL ) {
+        extendStripAssembly(pAssembly, pEndpoint2->strip, pEndpoint2->tail, i2, i1);
+    }
+    else {
+        // segment was not part of any line strip, creating new one
+        startStripAssembly(pAssembly, i1, i2);
     }
 }
 
@@ -699,7 +1128,8 @@ static double overrideWeldDistMultiplier;
         
         for (NSUInteger i = 0; i < stripLists.used; i++) {
             pStripList = &stripLists.array[i];
-            again = YES;
+            // strips welded on export have no ends left in common, skip straight to compacting more
+            again = !(i < (NSUInteger)noStripAssemblies && stripAssemblies[i].materialised && !stripAssemblies[i].collided);
             while(again) {
                 // REPEAT COMPACT PROCESS UNTIL LAST PROCESS MAKES NO CHANGE
                 again = NO;
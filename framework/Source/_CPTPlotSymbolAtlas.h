@@ -0,0 +1,47 @@
+//
+//  _CPTPlotSymbolAtlas.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Bitmap atlas of the plot symbols a plot draws. Every distinct symbol is rasterized once per
+//  scale into a cell of one shared bitmap, in the color space of the destination. A batch of
+//  pixel aligned points is blended into one image from the cell pixels and drawn once, other
+//  points are stamped from an image of the cell, so a frame draws without rendering a symbol or
+//  looking one up per point. Symbols that do not fit in the bitmap are drawn through their own
+//  cached layer instead.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlotSymbol.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface _CPTPlotSymbolAtlas : NSObject
+
+@property (nonatomic, readonly) CGFloat scale;
+@property (nonatomic, readonly) NSUInteger entryCount;
+// number of times the symbols were rasterized
+@property (nonatomic, readonly) NSUInteger buildCount;
+// size of the shared bitmap in pixels
+@property (nonatomic, readonly) CGSize bitmapSize;
+
+-(nonnull instancetype)init NS_DESIGNATED_INITIALIZER;
+
+// rasterizes entries at scale for drawing into context unless the atlas already holds them, entries that are not plot symbols draw nothing
+-(void)prepareEntries:(nonnull NSArray *)entries scale:(CGFloat)scale context:(nonnull CGContextRef)context;
+// draws entry at each of count points, positioned as -[CPTPlotSymbol renderInContext:atPoint:scale:alignToPixels:] would
+-(void)stampEntry:(NSUInteger)entry atPoints:(nonnull const CGPoint *)points count:(NSUInteger)count inContext:(nonnull CGContextRef)context alignToPixels:(BOOL)alignToPixels;
+
+@end
+
+@interface CPTPlotSymbol(SymbolAtlas)
+
+// changes whenever the cached symbol image is discarded, so copies of it can tell they are stale
+-(NSUInteger)appearanceGeneration;
+-(CGSize)layerSizeForScale:(CGFloat)scale;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,457 @@
+//
+//  _CPTPlotSymbolAtlas.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTPlotSymbolAtlas.h"
+
+#import "CPTColorSpace.h"
+#import "CPTUtilities.h"
+#import <tgmath.h>
+
+// widest and tallest shared bitmap in pixels
+static const CGFloat CPTPlotSymbolAtlasMaximumSize = 2048.0;
+
+// empty pixels around each cell so filtering never reads a neighbour
+static const CGFloat CPTPlotSymbolAtlasCellPadding = 1.0;
+
+// largest area in pixels a batch is composited into before it is drawn, larger batches draw each point
+static const size_t CPTPlotSymbolAtlasMaximumBatchArea = 2048 * 2048;
+
+#pragma mark -
+
+/// @cond
+
+@interface _CPTPlotSymbolAtlasEntry : NSObject
+
+@property (nonatomic, readwrite, strong, nullable) id symbol;
+@property (nonatomic, readwrite, assign) NSUInteger appearanceGeneration;
+@property (nonatomic, readwrite, assign, nullable) CGImageRef image;
+// cell of the shared bitmap in pixels, y up
+@property (nonatomic, readwrite, assign) CGRect cellRect;
+
+@end
+
+@implementation _CPTPlotSymbolAtlasEntry
+
+@synthesize symbol;
+@synthesize appearanceGeneration;
+@synthesize image;
+@synthesize cellRect;
+
+-(void)dealloc
+{
+    CGImageRelease(image);
+}
+
+-(void)setImage:(nullable CGImageRef)newImage
+{
+    if ( newImage != image ) {
+        CGImageRelease(image);
+        image = CGImageRetain(newImage);
+    }
+}
+
+@end
+
+@interface _CPTPlotSymbolAtlas()
+
+@property (nonatomic, readwrite) CGFloat scale;
+@property (nonatomic, readwrite) NSUInteger buildCount;
+@property (nonatomic, readwrite) CGSize bitmapSize;
+@property (nonatomic, readwrite, strong, nonnull) NSArray<_CPTPlotSymbolAtlasEntry *> *entries;
+// color space of the context the symbols were prepared for
+@property (nonatomic, readwrite, strong, nullable) CPTColorSpace *destinationColorSpace;
+// color space of the bitmap, the destination one unless a bitmap could not be made in it
+@property (nonatomic, readwrite, strong, nullable) CPTColorSpace *pixelColorSpace;
+// premultiplied RGBA rows of the bitmap, top row first
+@property (nonatomic, readwrite, strong, nullable) NSData *pixels;
+@property (nonatomic, readwrite) size_t bytesPerRow;
+
+-(BOOL)holdsEntries:(nonnull NSArray *)newEntries scale:(CGFloat)newScale colorSpace:(nonnull CGColorSpaceRef)newColorSpace;
+-(BOOL)compositeEntry:(nonnull _CPTPlotSymbolAtlasEntry *)entry atPoints:(nonnull const CGPoint *)points count:(NSUInteger)count offset:(CGPoint)offset inContext:(nonnull CGContextRef)context;
+
+@end
+
+/// @endcond
+
+#pragma mark -
+
+@implementation _CPTPlotSymbolAtlas
+
+@synthesize scale;
+@synthesize buildCount;
+@synthesize bitmapSize;
+@synthesize entries;
+@synthesize destinationColorSpace;
+@synthesize pixelColorSpace;
+@synthesize pixels;
+@synthesize bytesPerRow;
+
+#pragma mark -
+#pragma mark Init/Dealloc
+
+-(nonnull instancetype)init
+{
+    if ((self = [super init])) {
+        scale      = CPTFloat(0.0);
+        buildCount = 0;
+        bitmapSize = CGSizeZero;
+        entries    = @[];
+
+        destinationColorSpace = nil;
+        pixelColorSpace       = nil;
+        pixels                = nil;
+        bytesPerRow           = 0;
+    }
+    return self;
+}
+
+#pragma mark -
+#pragma mark Accessors
+
+-(NSUInteger)entryCount
+{
+    return self.entries.count;
+}
+
+#pragma mark -
+#pragma mark Rasterizing
+
+-(BOOL)holdsEntries:(nonnull NSArray *)newEntries scale:(CGFloat)newScale colorSpace:(nonnull CGColorSpaceRef)newColorSpace
+{
+    NSArray<_CPTPlotSymbolAtlasEntry *> *theEntries = self.entries;
+    NSUInteger count                                = theEntries.count;
+
+    if ((newScale != self.scale) || (newEntries.count != count)) {
+        return NO;
+    }
+
+    CPTColorSpace *theColorSpace = self.destinationColorSpace;
+
+    if ( !theColorSpace || !CFEqual(theColorSpace.cgColorSpace, newColorSpace)) {
+        return NO;
+    }
+
+    Class symbolClass = [CPTPlotSymbol class];
+
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        _CPTPlotSymbolAtlasEntry *entry = theEntries[i];
+        id newEntry                     = newEntries[i];
+
+        if ( newEntry != entry.symbol ) {
+            return NO;
+        }
+        if ( [newEntry isKindOfClass:symbolClass] && (((CPTPlotSymbol *)newEntry).appearanceGeneration != entry.appearanceGeneration)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+-(void)prepareEntries:(nonnull NSArray *)newEntries scale:(CGFloat)newScale context:(nonnull CGContextRef)context
+{
+    // draw in the color space of the destination so stamping does not convert every pixel
+    CGColorSpaceRef newColorSpace = CGBitmapContextGetColorSpace(context);
+
+    if ( !newColorSpace ) {
+        newColorSpace = [CPTColorSpace genericRGBSpace].cgColorSpace;
+    }
+
+    if ( [self holdsEntries:newEntries scale:newScale colorSpace:newColorSpace] ) {
+        return;
+    }
+
+    NSUInteger count                                  = newEntries.count;
+    NSMutableArray<_CPTPlotSymbolAtlasEntry *> *cells = [[NSMutableArray alloc] initWithCapacity:count];
+    Class symbolClass                                 = [CPTPlotSymbol class];
+
+    // shelf packing in entry order, the entries that do not fit are left without a cell
+    CGFloat shelfX      = CPTPlotSymbolAtlasCellPadding;
+    CGFloat shelfY      = CPTPlotSymbolAtlasCellPadding;
+    CGFloat shelfHeight = CPTFloat(0.0);
+    CGFloat usedWidth   = CPTFloat(0.0);
+    CGFloat usedHeight  = CPTFloat(0.0);
+
+    for ( id newEntry in newEntries ) {
+        _CPTPlotSymbolAtlasEntry *entry = [[_CPTPlotSymbolAtlasEntry alloc] init];
+
+        entry.symbol   = newEntry;
+        entry.cellRect = CGRectNull;
+
+        if ( [newEntry isKindOfClass:symbolClass] ) {
+            CPTPlotSymbol *symbol = (CPTPlotSymbol *)newEntry;
+            CGSize layerSize      = [symbol layerSizeForScale:newScale];
+            CGFloat cellWidth     = ceil(layerSize.width);
+            CGFloat cellHeight    = ceil(layerSize.height);
+
+            entry.appearanceGeneration = symbol.appearanceGeneration;
+
+            BOOL fitsShelf = (cellWidth > CPTFloat(0.0)) && (cellHeight > CPTFloat(0.0)) &&
+                             (cellWidth + CPTPlotSymbolAtlasCellPadding * CPTFloat(2.0) <= CPTPlotSymbolAtlasMaximumSize);
+
+            if ( fitsShelf && (shelfX + cellWidth + CPTPlotSymbolAtlasCellPadding > CPTPlotSymbolAtlasMaximumSize)) {
+                shelfX       = CPTPlotSymbolAtlasCellPadding;
+                shelfY      += shelfHeight + CPTPlotSymbolAtlasCellPadding;
+                shelfHeight  = CPTFloat(0.0);
+            }
+
+            if ( fitsShelf && (shelfY + cellHeight + CPTPlotSymbolAtlasCellPadding <= CPTPlotSymbolAtlasMaximumSize)) {
+                entry.cellRect = CGRectMake(shelfX, shelfY, cellWidth, cellHeight);
+
+                shelfX     += cellWidth + CPTPlotSymbolAtlasCellPadding;
+                shelfHeight = MAX(shelfHeight, cellHeight);
+                usedWidth   = MAX(usedWidth, shelfX);
+                usedHeight  = MAX(usedHeight, shelfY + cellHeight + CPTPlotSymbolAtlasCellPadding);
+            }
+        }
+
+        [cells addObject:entry];
+    }
+
+    size_t pixelWidth  = (size_t)usedWidth;
+    size_t pixelHeight = (size_t)usedHeight;
+
+    CPTColorSpace *newPixelColorSpace = [[CPTColorSpace alloc] initWithCGColorSpace:newColorSpace];
+    NSData *newPixels                 = nil;
+    size_t newBytesPerRow             = 0;
+
+    if ((pixelWidth > 0) && (pixelHeight > 0)) {
+        CGContextRef atlasContext = CGBitmapContextCreate(NULL, pixelWidth, pixelHeight, 8, 0, newColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+
+        if ( !atlasContext ) {
+            // not an RGB space with eight bit components
+            newPixelColorSpace = [CPTColorSpace genericRGBSpace];
+            atlasContext       = CGBitmapContextCreate(NULL, pixelWidth, pixelHeight, 8, 0, newPixelColorSpace.cgColorSpace, (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+        }
+
+        if ( atlasContext ) {
+            for ( _CPTPlotSymbolAtlasEntry *entry in cells ) {
+                CGRect cell = entry.cellRect;
+
+                if ( !CGRectIsNull(cell)) {
+                    CPTPlotSymbol *symbol = (CPTPlotSymbol *)entry.symbol;
+                    CGPoint symbolAnchor  = symbol.anchorPoint;
+                    CGSize symbolSize     = symbol.size;
+
+                    // center the symbol in its cell whatever its anchor point, the anchor is applied when stamping
+                    CGPoint center = CPTPointMake(CGRectGetMidX(cell) - (symbolAnchor.x - CPTFloat(0.5)) * symbolSize.width,
+                                                  CGRectGetMidY(cell) - (symbolAnchor.y - CPTFloat(0.5)) * symbolSize.height);
+
+                    CGContextSaveGState(atlasContext);
+                    CGContextClipToRect(atlasContext, cell);
+                    [symbol renderAsVectorInContext:atlasContext atPoint:center scale:newScale];
+                    CGContextRestoreGState(atlasContext);
+                }
+            }
+
+            newBytesPerRow = CGBitmapContextGetBytesPerRow(atlasContext);
+            newPixels      = [[NSData alloc] initWithBytes:CGBitmapContextGetData(atlasContext) length:newBytesPerRow * pixelHeight];
+
+            CGImageRef atlasImage = CGBitmapContextCreateImage(atlasContext);
+            CGContextRelease(atlasContext);
+
+            for ( _CPTPlotSymbolAtlasEntry *entry in cells ) {
+                CGRect cell = entry.cellRect;
+
+                if ( !CGRectIsNull(cell)) {
+                    // image rows run top down
+                    CGRect imageRect = cell;
+
+                    imageRect.origin.y = (CGFloat)pixelHeight - CGRectGetMaxY(cell);
+
+                    CGImageRef cellImage = CGImageCreateWithImageInRect(atlasImage, imageRect);
+                    entry.image = cellImage;
+                    CGImageRelease(cellImage);
+                }
+            }
+
+            CGImageRelease(atlasImage);
+        }
+    }
+
+    self.entries               = cells;
+    self.scale                 = newScale;
+    self.bitmapSize            = CGSizeMake((CGFloat)pixelWidth, (CGFloat)pixelHeight);
+    self.destinationColorSpace = [[CPTColorSpace alloc] initWithCGColorSpace:newColorSpace];
+    self.pixelColorSpace       = newPixelColorSpace;
+    self.pixels                = newPixels;
+    self.bytesPerRow           = newBytesPerRow;
+    self.buildCount++;
+}
+
+#pragma mark -
+#pragma mark Drawing
+
+-(void)stampEntry:(NSUInteger)entryIndex atPoints:(nonnull const CGPoint *)points count:(NSUInteger)count inContext:(nonnull CGContextRef)context alignToPixels:(BOOL)alignToPixels
+{
+    NSArray<_CPTPlotSymbolAtlasEntry *> *theEntries = self.entries;
+
+    if ((entryIndex >= theEntries.count) || (count == 0)) {
+        return;
+    }
+
+    _CPTPlotSymbolAtlasEntry *entry = theEntries[entryIndex];
+    id theSymbol                    = entry.symbol;
+
+    if ( ![theSymbol isKindOfClass:[CPTPlotSymbol class]] ) {
+        return;
+    }
+
+    CPTPlotSymbol *symbol = (CPTPlotSymbol *)theSymbol;
+    CGFloat theScale      = self.scale;
+    CGImageRef cellImage  = entry.image;
+
+    if ( cellImage ) {
+        CGPoint symbolAnchor = symbol.anchorPoint;
+        CGSize symbolSize    = symbol.size;
+        CGSize cellSize      = entry.cellRect.size;
+
+        cellSize.width  /= theScale;
+        cellSize.height /= theScale;
+
+        // offset of the image origin from each point, the same for the whole batch
+        CGPoint offset = CPTPointMake(-cellSize.width * CPTFloat(0.5) - symbolSize.width * (symbolAnchor.x - CPTFloat(0.5)),
+                                      -cellSize.height * CPTFloat(0.5) - symbolSize.height * (symbolAnchor.y - CPTFloat(0.5)));
+
+        if ( alignToPixels && (count > 1) && [self compositeEntry:entry atPoints:points count:count offset:offset inContext:context] ) {
+            return;
+        }
+
+        for ( NSUInteger i = 0; i < count; i++ ) {
+            CGPoint origin = CPTPointMake(points[i].x + offset.x, points[i].y + offset.y);
+
+            if ( alignToPixels ) {
+                if ( theScale == CPTFloat(1.0)) {
+                    origin.x = round(origin.x);
+                    origin.y = round(origin.y);
+                }
+                else {
+                    origin.x = round(origin.x * theScale) / theScale;
+                    origin.y = round(origin.y * theScale) / theScale;
+                }
+            }
+
+            CGContextDrawImage(context, CPTRectMake(origin.x, origin.y, cellSize.width, cellSize.height), cellImage);
+        }
+    }
+    else {
+        // no room left in the bitmap, or it could not be made
+        for ( NSUInteger i = 0; i < count; i++ ) {
+            [symbol renderInContext:context atPoint:points[i] scale:theScale alignToPixels:alignToPixels];
+        }
+    }
+}
+
+// Blends every stamp of the batch into one image, in record order, and draws that image once. The stamps
+// land on whole device pixels, so this is what drawing the cell image at each point would produce.
+-(BOOL)compositeEntry:(nonnull _CPTPlotSymbolAtlasEntry *)entry atPoints:(nonnull const CGPoint *)points count:(NSUInteger)count offset:(CGPoint)offset inContext:(nonnull CGContextRef)context
+{
+    NSData *thePixels = self.pixels;
+
+    if ( !thePixels ) {
+        return NO;
+    }
+
+    CGFloat theScale  = self.scale;
+    CGRect cell       = entry.cellRect;
+    size_t cellX      = (size_t)cell.origin.x;
+    size_t cellY      = (size_t)cell.origin.y;
+    size_t cellWidth  = (size_t)cell.size.width;
+    size_t cellHeight = (size_t)cell.size.height;
+
+    NSMutableData *originData = [[NSMutableData alloc] initWithLength:count * 2 * sizeof(NSInteger)];
+    NSInteger *origins        = (NSInteger *)originData.mutableBytes;
+    NSUInteger originCount    = 0;
+
+    NSInteger minX = NSIntegerMax;
+    NSInteger minY = NSIntegerMax;
+    NSInteger maxX = NSIntegerMin;
+    NSInteger maxY = NSIntegerMin;
+
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        CGFloat x = round((points[i].x + offset.x) * theScale);
+        CGFloat y = round((points[i].y + offset.y) * theScale);
+
+        if ( !isfinite(x) || !isfinite(y)) {
+            continue;
+        }
+
+        NSInteger pixelX = (NSInteger)x;
+        NSInteger pixelY = (NSInteger)y;
+
+        origins[originCount * 2]     = pixelX;
+        origins[originCount * 2 + 1] = pixelY;
+        originCount++;
+
+        minX = MIN(minX, pixelX);
+        minY = MIN(minY, pixelY);
+        maxX = MAX(maxX, pixelX);
+        maxY = MAX(maxY, pixelY);
+    }
+
+    if ( originCount == 0 ) {
+        return YES;
+    }
+
+    size_t width  = (size_t)(maxX - minX) + cellWidth;
+    size_t height = (size_t)(maxY - minY) + cellHeight;
+
+    if ( width * height > CPTPlotSymbolAtlasMaximumBatchArea ) {
+        return NO;
+    }
+
+    NSMutableData *batchData = [[NSMutableData alloc] initWithLength:width * height * 4];
+    uint8_t *batchPixels     = (uint8_t *)batchData.mutableBytes;
+    size_t batchBytesPerRow  = width * 4;
+
+    const uint8_t *atlasPixels = (const uint8_t *)thePixels.bytes;
+    size_t atlasBytesPerRow    = self.bytesPerRow;
+    size_t atlasHeight         = (size_t)self.bitmapSize.height;
+
+    for ( NSUInteger k = 0; k < originCount; k++ ) {
+        size_t x0 = (size_t)(origins[k * 2] - minX);
+        size_t y0 = (size_t)(origins[k * 2 + 1] - minY);
+
+        for ( size_t row = 0; row < cellHeight; row++ ) {
+            // rows run top down in both bitmaps
+            const uint8_t *source = atlasPixels + (atlasHeight - 1 - (cellY + row)) * atlasBytesPerRow + cellX * 4;
+            uint8_t *destination  = batchPixels + (height - 1 - (y0 + row)) * batchBytesPerRow + x0 * 4;
+
+            for ( size_t byte = 0; byte < cellWidth * 4; byte += 4 ) {
+                uint32_t alpha = source[byte + 3];
+
+                if ( alpha == 255 ) {
+                    memcpy(destination + byte, source + byte, 4);
+                }
+                else if ( alpha > 0 ) {
+                    // premultiplied source over
+                    uint32_t remaining = 255 - alpha;
+
+                    for ( size_t c = 0; c < 4; c++ ) {
+                        destination[byte + c] = (uint8_t)(source[byte + c] + (destination[byte + c] * remaining + 127) / 255);
+                    }
+                }
+            }
+        }
+    }
+
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)batchData);
+    CGImageRef batchImage      = CGImageCreate(width, height, 8, 32, batchBytesPerRow, self.pixelColorSpace.cgColorSpace,
+                                               (CGBitmapInfo)kCGImageAlphaPremultipliedLast, provider, NULL, false, kCGRenderingIntentDefault);
+
+    CGDataProviderRelease(provider);
+
+    if ( !batchImage ) {
+        return NO;
+    }
+
+    CGContextDrawImage(context, CPTRectMake((CGFloat)minX / theScale, (CGFloat)minY / theScale, (CGFloat)width / theScale, (CGFloat)height / theScale), batchImage);
+    CGImageRelease(batchImage);
+
+    return YES;
+}
+
+@end
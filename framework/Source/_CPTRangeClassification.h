@@ -0,0 +1,80 @@
+//
+//  _CPTRangeClassification.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Decides which data points a plot needs to draw. Samples are classified against the
+//  plot ranges in blocks of CPTRangeClassificationBlockSize with branch free compares the
+//  compiler turns into vector code, one region code byte per sample, and the neighbour
+//  expansion runs over each block as it is classified. Everything lives on the stack so
+//  nothing is allocated per frame.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlotRange.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// number of samples classified at a time
+#define CPTRangeClassificationBlockSize 256
+
+// region code of a sample: two bits per coordinate holding the CPTPlotRangeComparisonResult
+// (below, in or above) and CPTRegionCodeNaN if any coordinate is undefined. Once a coordinate
+// is out of range the later ones are recorded as in range as they no longer matter.
+typedef uint8_t CPTRegionCode;
+
+#define CPTRegionCodeNaN ((CPTRegionCode)0x40)
+
+typedef struct {
+    double minLimit;
+    double maxLimit;
+} CPTRangeClassificationLimits;
+
+// limits of a range as fixed point values, see _CPTFixedPointNumbers
+typedef struct {
+    int64_t minLimit;
+    int64_t maxLimit;
+} CPTRangeClassificationFixedPointLimits;
+
+// fixed point samples at or below this value are NaN or have no exact fixed point value
+#define CPTRangeClassificationFixedPointMarker ((int64_t)(INT64_MIN + 1))
+
+typedef NS_ENUM (NSInteger, CPTRangeClassificationExpansion) {
+    CPTRangeClassificationExpansionNone, ///< Only the points inside the ranges are drawn.
+    CPTRangeClassificationExpansionOne,  ///< One point is kept either side of a region crossing.
+    CPTRangeClassificationExpansionTwo   ///< Two points are kept either side of a region crossing, for curved lines.
+};
+
+// running state of the neighbour expansion so flags can be produced one block at a time
+typedef struct {
+    CPTRangeClassificationExpansion expansion;
+    CPTRegionCode inRangeCode;  // code of a sample inside every range
+    size_t index;               // number of samples seen so far
+    CPTRegionCode previous[2];  // codes of the last two samples, most recent first
+} CPTRangeClassificationState;
+
+// reads the limits of range once
+CPTRangeClassificationLimits CPTRangeClassificationLimitsForRange(CPTPlotRange *_Nullable range);
+
+// classifies count samples (at most CPTRangeClassificationBlockSize) of dimensions coordinates (1 to 3)
+void CPTRangeClassificationClassifyDoubles(CPTRegionCode *codes, const double *_Nonnull const *_Nonnull coordinates, const CPTRangeClassificationLimits *limits, NSUInteger dimensions, size_t count);
+// region code for comparison results from CPTPlotRange, for data the double kernel cannot classify
+CPTRegionCode CPTRangeClassificationCodeForComparisons(const CPTPlotRangeComparisonResult *comparisons, NSUInteger dimensions);
+
+void CPTRangeClassificationStateInit(CPTRangeClassificationState *state, CPTRangeClassificationExpansion expansion, NSUInteger dimensions);
+// sets the draw flags of the next count samples, flags is the whole flag array of the plot as
+// a crossing may also flag the one or two samples before the block
+void CPTRangeClassificationAppendCodes(CPTRangeClassificationState *state, const CPTRegionCode *codes, size_t count, BOOL *flags);
+
+// convenience, classifies whole x and y arrays and sets their draw flags
+void CPTRangeClassificationFlagPoints(BOOL *flags, const double *xValues, const double *yValues, size_t count, CPTRangeClassificationLimits xLimits, CPTRangeClassificationLimits yLimits, CPTRangeClassificationExpansion expansion);
+
+// NSDecimal version of CPTRangeClassificationFlagPoints, comparing exactly through the plot ranges
+void CPTRangeClassificationFlagDecimalPoints(BOOL *flags, const NSDecimal *xValues, const NSDecimal *yValues, size_t count, CPTPlotRange *_Nullable xRange, CPTPlotRange *_Nullable yRange, CPTRangeClassificationExpansion expansion);
+
+// fixed point version of CPTRangeClassificationFlagPoints, classifying marked samples through their NSDecimal values
+void CPTRangeClassificationFlagFixedPointPoints(BOOL *flags, const int64_t *xValues, const int64_t *yValues, const NSDecimal *xDecimals, const NSDecimal *yDecimals, size_t count, CPTRangeClassificationFixedPointLimits xLimits, CPTRangeClassificationFixedPointLimits yLimits, CPTPlotRange *_Nullable xRange, CPTPlotRange *_Nullable yRange, CPTRangeClassificationExpansion expansion);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,288 @@
+//
+//  _CPTRangeClassification.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTRangeClassification.h"
+
+#pragma mark -
+#pragma mark Classification
+
+CPTRangeClassificationLimits CPTRangeClassificationLimitsForRange(CPTPlotRange *_Nullable range)
+{
+    CPTRangeClassificationLimits limits;
+
+    if ( range ) {
+        limits.minLimit = range.minLimitDouble;
+        limits.maxLimit = range.maxLimitDouble;
+    }
+    else {
+        // everything is below a missing range, like messaging nil for a comparison
+        limits.minLimit = (double)INFINITY;
+        limits.maxLimit = (double)INFINITY;
+    }
+    return limits;
+}
+
+// comparison result of value, forced in range once an earlier coordinate is out of range (open == 0)
+static inline CPTRegionCode CPTRangeClassificationCompare(double value, CPTRangeClassificationLimits limits, CPTRegionCode *open, CPTRegionCode *nan)
+{
+    // below 0, in 1, above 2 and NaN fails both compares
+    CPTRegionCode comparison = (CPTRegionCode)((value >= limits.minLimit) + (value > limits.maxLimit));
+
+    // arithmetic select rather than a branch so the loop stays vectorisable
+    *nan      |= (CPTRegionCode)(value != value);
+    comparison = (CPTRegionCode)(*open * comparison + (1 - *open) * CPTPlotRangeComparisonResultNumberInRange);
+    *open     &= (CPTRegionCode)(comparison == CPTPlotRangeComparisonResultNumberInRange);
+
+    return comparison;
+}
+
+// dimensions is a constant in each call below so the branches on it fold away and the loop is vectorised
+static inline void CPTRangeClassificationClassify(CPTRegionCode *restrict codes, const double *const *coordinates, const CPTRangeClassificationLimits *limits, const NSUInteger dimensions, size_t count)
+{
+    const double *restrict first  = coordinates[0];
+    const double *restrict second = dimensions > 1 ? coordinates[1] : first;
+    const double *restrict third  = dimensions > 2 ? coordinates[2] : first;
+
+    const CPTRangeClassificationLimits firstLimits  = limits[0];
+    const CPTRangeClassificationLimits secondLimits = dimensions > 1 ? limits[1] : firstLimits;
+    const CPTRangeClassificationLimits thirdLimits  = dimensions > 2 ? limits[2] : firstLimits;
+
+    for ( size_t i = 0; i < count; i++ ) {
+        CPTRegionCode open = 1;
+        CPTRegionCode nan  = 0;
+        CPTRegionCode code = CPTRangeClassificationCompare(first[i], firstLimits, &open, &nan);
+
+        if ( dimensions > 1 ) {
+            code |= (CPTRegionCode)(CPTRangeClassificationCompare(second[i], secondLimits, &open, &nan) << 2);
+        }
+        if ( dimensions > 2 ) {
+            code |= (CPTRegionCode)(CPTRangeClassificationCompare(third[i], thirdLimits, &open, &nan) << 4);
+        }
+        codes[i] = code | (CPTRegionCode)(nan << 6);
+    }
+}
+
+void CPTRangeClassificationClassifyDoubles(CPTRegionCode *codes, const double *_Nonnull const *_Nonnull coordinates, const CPTRangeClassificationLimits *limits, NSUInteger dimensions, size_t count)
+{
+    switch ( dimensions ) {
+        case 1:
+            CPTRangeClassificationClassify(codes, coordinates, limits, 1, count);
+            break;
+
+        case 2:
+            CPTRangeClassificationClassify(codes, coordinates, limits, 2, count);
+            break;
+
+        case 3:
+            CPTRangeClassificationClassify(codes, coordinates, limits, 3, count);
+            break;
+
+        default:
+            [NSException raise:NSInvalidArgumentException format:@"Range classification supports 1 to 3 coordinates, not %lu", (unsigned long)dimensions];
+            break;
+    }
+}
+
+CPTRegionCode CPTRangeClassificationCodeForComparisons(const CPTPlotRangeComparisonResult *comparisons, NSUInteger dimensions)
+{
+    CPTRegionCode code = 0;
+    BOOL open          = YES;
+    BOOL nan           = NO;
+
+    for ( NSUInteger d = 0; d < dimensions; d++ ) {
+        CPTPlotRangeComparisonResult comparison = comparisons[d];
+
+        if ( comparison == CPTPlotRangeComparisonResultNumberUndefined ) {
+            nan        = YES;
+            comparison = CPTPlotRangeComparisonResultNumberBelowRange;
+        }
+        if ( !open ) {
+            comparison = CPTPlotRangeComparisonResultNumberInRange;
+        }
+        code |= (CPTRegionCode)(comparison << (2 * d));
+        open  = open && (comparison == CPTPlotRangeComparisonResultNumberInRange);
+    }
+    return code | (nan ? CPTRegionCodeNaN : 0);
+}
+
+#pragma mark -
+#pragma mark Neighbour Expansion
+
+void CPTRangeClassificationStateInit(CPTRangeClassificationState *state, CPTRangeClassificationExpansion expansion, NSUInteger dimensions)
+{
+    state->expansion   = expansion;
+    state->inRangeCode = 0;
+    for ( NSUInteger d = 0; d < dimensions; d++ ) {
+        state->inRangeCode |= (CPTRegionCode)(CPTPlotRangeComparisonResultNumberInRange << (2 * d));
+    }
+    state->index       = 0;
+    state->previous[0] = CPTRegionCodeNaN;
+    state->previous[1] = CPTRegionCodeNaN;
+}
+
+void CPTRangeClassificationAppendCodes(CPTRangeClassificationState *state, const CPTRegionCode *codes, size_t count, BOOL *flags)
+{
+    const CPTRegionCode inRangeCode = state->inRangeCode;
+    const size_t base               = state->index;
+
+    CPTRegionCode previous1 = state->previous[0];
+    CPTRegionCode previous2 = state->previous[1];
+
+    switch ( state->expansion ) {
+        case CPTRangeClassificationExpansionNone:
+            for ( size_t i = 0; i < count; i++ ) {
+                flags[base + i] = (codes[i] == inRangeCode);
+            }
+            break;
+
+        case CPTRangeClassificationExpansionOne:
+            // Keep 1 point outside of the visible area on each side
+            for ( size_t i = 0; i < count; i++ ) {
+                const size_t n           = base + i;
+                const CPTRegionCode code = codes[i];
+                BOOL drawPoint           = (code == inRangeCode);
+
+                if ((n > 0) && !((previous1 | code) & CPTRegionCodeNaN) && (previous1 != code)) {
+                    flags[n - 1] = YES;
+                    drawPoint    = YES;
+                }
+                flags[n]  = drawPoint;
+                previous2 = previous1;
+                previous1 = code;
+            }
+            break;
+
+        case CPTRangeClassificationExpansionTwo:
+            // Keep 2 points outside of the visible area on each side to maintain the correct curvature of the line
+            for ( size_t i = 0; i < count; i++ ) {
+                const size_t n           = base + i;
+                const CPTRegionCode code = codes[i];
+                BOOL drawPoint           = (code == inRangeCode);
+
+                if ( n == 1 ) {
+                    if ( !((previous1 | code) & CPTRegionCodeNaN) && (previous1 != code)) {
+                        flags[0]  = YES;
+                        drawPoint = YES;
+                    }
+                }
+                else if ( n >= 2 ) {
+                    BOOL lastTwoDefined = !((previous1 | code) & CPTRegionCodeNaN);
+                    if ( lastTwoDefined && (!(previous2 & CPTRegionCodeNaN) || (previous1 != code))) {
+                        flags[n - 2] = YES;
+                        flags[n - 1] = YES;
+                        drawPoint    = YES;
+                    }
+                }
+                flags[n]  = drawPoint;
+                previous2 = previous1;
+                previous1 = code;
+            }
+            break;
+    }
+
+    state->index       = base + count;
+    state->previous[0] = previous1;
+    state->previous[1] = previous2;
+}
+
+void CPTRangeClassificationFlagPoints(BOOL *flags, const double *xValues, const double *yValues, size_t count, CPTRangeClassificationLimits xLimits, CPTRangeClassificationLimits yLimits, CPTRangeClassificationExpansion expansion)
+{
+    CPTRegionCode codes[CPTRangeClassificationBlockSize];
+    const CPTRangeClassificationLimits limits[2] = { xLimits, yLimits };
+
+    CPTRangeClassificationState state;
+
+    CPTRangeClassificationStateInit(&state, expansion, 2);
+
+    for ( size_t start = 0; start < count; start += CPTRangeClassificationBlockSize ) {
+        size_t blockCount                = MIN(count - start, (size_t)CPTRangeClassificationBlockSize);
+        const double *const coordinates[2] = { xValues + start, yValues + start };
+
+        CPTRangeClassificationClassify(codes, coordinates, limits, 2, blockCount);
+        CPTRangeClassificationAppendCodes(&state, codes, blockCount, flags);
+    }
+}
+
+// code of one NSDecimal sample, comparing exactly through the plot ranges
+static CPTRegionCode CPTRangeClassificationDecimalCode(NSDecimal x, NSDecimal y, CPTPlotRange *_Nullable xRange, CPTPlotRange *_Nullable yRange)
+{
+    CPTPlotRangeComparisonResult comparisons[2];
+
+    comparisons[0] = [xRange compareToDecimal:x];
+    if ( comparisons[0] != CPTPlotRangeComparisonResultNumberInRange ) {
+        // if x is out of range, then y doesn't matter unless it is undefined
+        comparisons[1] = NSDecimalIsNotANumber(&y) ? CPTPlotRangeComparisonResultNumberUndefined : CPTPlotRangeComparisonResultNumberInRange;
+    }
+    else {
+        comparisons[1] = [yRange compareToDecimal:y];
+    }
+    return CPTRangeClassificationCodeForComparisons(comparisons, 2);
+}
+
+void CPTRangeClassificationFlagDecimalPoints(BOOL *flags, const NSDecimal *xValues, const NSDecimal *yValues, size_t count, CPTPlotRange *_Nullable xRange, CPTPlotRange *_Nullable yRange, CPTRangeClassificationExpansion expansion)
+{
+    CPTRegionCode codes[CPTRangeClassificationBlockSize];
+
+    CPTRangeClassificationState state;
+
+    CPTRangeClassificationStateInit(&state, expansion, 2);
+
+    for ( size_t start = 0; start < count; start += CPTRangeClassificationBlockSize ) {
+        size_t blockCount = MIN(count - start, (size_t)CPTRangeClassificationBlockSize);
+
+        for ( size_t i = 0; i < blockCount; i++ ) {
+            codes[i] = CPTRangeClassificationDecimalCode(xValues[start + i], yValues[start + i], xRange, yRange);
+        }
+        CPTRangeClassificationAppendCodes(&state, codes, blockCount, flags);
+    }
+}
+
+// fixed point version of CPTRangeClassificationCompare, marked samples are classified again afterwards
+static inline CPTRegionCode CPTRangeClassificationCompareFixedPoint(int64_t value, CPTRangeClassificationFixedPointLimits limits, CPTRegionCode *open)
+{
+    CPTRegionCode comparison = (CPTRegionCode)((value >= limits.minLimit) + (value > limits.maxLimit));
+
+    comparison = (CPTRegionCode)(*open * comparison + (1 - *open) * CPTPlotRangeComparisonResultNumberInRange);
+    *open     &= (CPTRegionCode)(comparison == CPTPlotRangeComparisonResultNumberInRange);
+
+    return comparison;
+}
+
+void CPTRangeClassificationFlagFixedPointPoints(BOOL *flags, const int64_t *xValues, const int64_t *yValues, const NSDecimal *xDecimals, const NSDecimal *yDecimals, size_t count, CPTRangeClassificationFixedPointLimits xLimits, CPTRangeClassificationFixedPointLimits yLimits, CPTPlotRange *_Nullable xRange, CPTPlotRange *_Nullable yRange, CPTRangeClassificationExpansion expansion)
+{
+    CPTRegionCode codes[CPTRangeClassificationBlockSize];
+
+    CPTRangeClassificationState state;
+
+    CPTRangeClassificationStateInit(&state, expansion, 2);
+
+    for ( size_t start = 0; start < count; start += CPTRangeClassificationBlockSize ) {
+        size_t blockCount          = MIN(count - start, (size_t)CPTRangeClassificationBlockSize);
+        const int64_t *restrict xs = xValues + start;
+        const int64_t *restrict ys = yValues + start;
+        CPTRegionCode marked       = 0;
+
+        for ( size_t i = 0; i < blockCount; i++ ) {
+            CPTRegionCode open = 1;
+            CPTRegionCode code = CPTRangeClassificationCompareFixedPoint(xs[i], xLimits, &open);
+
+            code    |= (CPTRegionCode)(CPTRangeClassificationCompareFixedPoint(ys[i], yLimits, &open) << 2);
+            codes[i] = code;
+            marked  |= (CPTRegionCode)((xs[i] <= CPTRangeClassificationFixedPointMarker) | (ys[i] <= CPTRangeClassificationFixedPointMarker));
+        }
+
+        if ( marked ) {
+            // NaN and samples without an exact fixed point value go through their NSDecimal values
+            for ( size_t i = 0; i < blockCount; i++ ) {
+                if ((xs[i] <= CPTRangeClassificationFixedPointMarker) || (ys[i] <= CPTRangeClassificationFixedPointMarker)) {
+                    codes[i] = CPTRangeClassificationDecimalCode(xDecimals[start + i], yDecimals[start + i], xRange, yRange);
+                }
+            }
+        }
+        CPTRangeClassificationAppendCodes(&state, codes, blockCount, flags);
+    }
+}
@@ -0,0 +1,54 @@
+//
+//  _CPTRasterTileCache.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Bitmap cache of a plot drawn in tiles laid out on a grid in plot coordinates. While the
+//  plot is only translated the tiles keep their place on the grid, so a frame composites the
+//  cached images and renders just the part of the plot that has come into view. The plots skip
+//  points outside their ranges, so a tile rendered while partly off screen only holds the part
+//  that was visible and is rendered again once more of it is needed.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlot.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// linear mapping from plot coordinates to the layer: layer = offset + scale * plot
+typedef struct {
+    double offset[2];
+    double scale[2];
+} CPTRasterTileMapping;
+
+typedef void (^CPTRasterTileRenderer)(CGContextRef context);
+
+@interface _CPTRasterTileCache : NSObject
+
+// width and height of a tile in layer points
+@property (nonatomic, readonly) CGFloat tileSize;
+@property (nonatomic, readonly) NSUInteger tileCount;
+// number of times the renderer was called, at most once per frame
+@property (nonatomic, readonly) NSUInteger renderCount;
+// YES if the last frame showed tiles drawn at another scale, resized until they are rendered again
+@property (nonatomic, readonly) BOOL showsStaleTiles;
+
+-(nonnull instancetype)initWithTileSize:(CGFloat)newTileSize NS_DESIGNATED_INITIALIZER;
+
+// draws the tiles covering bounds, rendering the missing ones into one bitmap with renderer,
+// and returns NO without drawing anything if the mapping cannot be tiled
+-(BOOL)drawInContext:(CGContextRef)context bounds:(CGRect)bounds mapping:(CPTRasterTileMapping)mapping contentsScale:(CGFloat)contentsScale renderer:(CPTRasterTileRenderer)renderer;
+-(void)removeAllTiles;
+
+@end
+
+@interface CPTPlot(RasterTileCache)
+
+// redisplays the plot after its plot space moved, keeping the tiles as they are keyed by plot coordinates
+-(void)setNeedsDisplayKeepingRasterTiles;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,370 @@
+//
+//  _CPTRasterTileCache.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTRasterTileCache.h"
+
+#import "CPTColorSpace.h"
+#import "CPTUtilities.h"
+#import <tgmath.h>
+
+// tile edge used by -init
+static const CGFloat CPTRasterTileCacheDefaultTileSize = 256.0;
+
+// largest relative change of the scale still treated as a translation
+static const double CPTRasterTileCacheScaleTolerance = 1.0e-9;
+
+typedef struct {
+    NSInteger column;
+    NSInteger row;
+} CPTRasterTileIndex;
+
+// rectangle in plot coordinates
+typedef struct {
+    double min[2];
+    double max[2];
+} CPTRasterTileExtent;
+
+static CGRect CPTRasterTileViewRect(CPTRasterTileExtent extent, CPTRasterTileMapping mapping)
+{
+    double x0 = mapping.offset[0] + mapping.scale[0] * extent.min[0];
+    double x1 = mapping.offset[0] + mapping.scale[0] * extent.max[0];
+    double y0 = mapping.offset[1] + mapping.scale[1] * extent.min[1];
+    double y1 = mapping.offset[1] + mapping.scale[1] * extent.max[1];
+
+    return CGRectStandardize(CGRectMake((CGFloat)x0, (CGFloat)y0, (CGFloat)(x1 - x0), (CGFloat)(y1 - y0)));
+}
+
+static CPTRasterTileExtent CPTRasterTileExtentForViewRect(CGRect rect, CPTRasterTileMapping mapping)
+{
+    CPTRasterTileExtent extent;
+
+    double x0 = ((double)CGRectGetMinX(rect) - mapping.offset[0]) / mapping.scale[0];
+    double x1 = ((double)CGRectGetMaxX(rect) - mapping.offset[0]) / mapping.scale[0];
+    double y0 = ((double)CGRectGetMinY(rect) - mapping.offset[1]) / mapping.scale[1];
+    double y1 = ((double)CGRectGetMaxY(rect) - mapping.offset[1]) / mapping.scale[1];
+
+    extent.min[0] = MIN(x0, x1);
+    extent.max[0] = MAX(x0, x1);
+    extent.min[1] = MIN(y0, y1);
+    extent.max[1] = MAX(y0, y1);
+
+    return extent;
+}
+
+static CPTRasterTileExtent CPTRasterTileExtentIntersection(CPTRasterTileExtent a, CPTRasterTileExtent b)
+{
+    CPTRasterTileExtent extent;
+
+    for ( int i = 0; i < 2; i++ ) {
+        extent.min[i] = MAX(a.min[i], b.min[i]);
+        extent.max[i] = MIN(a.max[i], b.max[i]);
+    }
+    return extent;
+}
+
+static BOOL CPTRasterTileExtentIsEmpty(CPTRasterTileExtent extent)
+{
+    return !(extent.max[0] > extent.min[0]) || !(extent.max[1] > extent.min[1]);
+}
+
+static BOOL CPTRasterTileExtentContains(CPTRasterTileExtent outer, CPTRasterTileExtent inner, const double *tolerance)
+{
+    for ( int i = 0; i < 2; i++ ) {
+        if ((inner.min[i] < outer.min[i] - tolerance[i]) || (inner.max[i] > outer.max[i] + tolerance[i])) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+#pragma mark -
+
+/// @cond
+
+@interface _CPTRasterTile : NSObject
+
+@property (nonatomic, readwrite, assign, nullable) CGImageRef image;
+@property (nonatomic, readwrite, assign) CPTRasterTileExtent extent;
+
+@end
+
+@implementation _CPTRasterTile
+
+@synthesize image;
+@synthesize extent;
+
+-(void)dealloc
+{
+    CGImageRelease(image);
+}
+
+-(void)setImage:(nullable CGImageRef)newImage
+{
+    if ( newImage != image ) {
+        CGImageRelease(image);
+        image = CGImageRetain(newImage);
+    }
+}
+
+@end
+
+@interface _CPTRasterTileCache()
+
+@property (nonatomic, readwrite) CGFloat tileSize;
+@property (nonatomic, readwrite) NSUInteger renderCount;
+@property (nonatomic, readwrite) BOOL showsStaleTiles;
+@property (nonatomic, readwrite, strong, nonnull) NSMutableDictionary<NSValue *, _CPTRasterTile *> *tiles;
+@property (nonatomic, readwrite, assign) CPTRasterTileMapping tileMapping;
+@property (nonatomic, readwrite, assign) CGFloat tileContentsScale;
+
+-(void)drawTile:(nonnull _CPTRasterTile *)tile inContext:(nonnull CGContextRef)context mapping:(CPTRasterTileMapping)mapping clipRect:(CGRect)clipRect;
+
+@end
+
+/// @endcond
+
+#pragma mark -
+
+@implementation _CPTRasterTileCache
+
+@synthesize tileSize;
+@synthesize renderCount;
+@synthesize showsStaleTiles;
+@synthesize tiles;
+@synthesize tileMapping;
+@synthesize tileContentsScale;
+
+#pragma mark -
+#pragma mark Init/Dealloc
+
+-(nonnull instancetype)initWithTileSize:(CGFloat)newTileSize
+{
+    if ((self = [super init])) {
+        tileSize          = newTileSize;
+        renderCount       = 0;
+        showsStaleTiles   = NO;
+        tiles             = [[NSMutableDictionary alloc] init];
+        tileContentsScale = CPTFloat(0.0);
+    }
+    return self;
+}
+
+-(nonnull instancetype)init
+{
+    return [self initWithTileSize:CPTRasterTileCacheDefaultTileSize];
+}
+
+#pragma mark -
+#pragma mark Tiles
+
+-(NSUInteger)tileCount
+{
+    return self.tiles.count;
+}
+
+-(void)removeAllTiles
+{
+    [self.tiles removeAllObjects];
+    self.showsStaleTiles = NO;
+}
+
+-(BOOL)drawInContext:(nonnull CGContextRef)context bounds:(CGRect)bounds mapping:(CPTRasterTileMapping)mapping contentsScale:(CGFloat)contentsScale renderer:(nonnull CPTRasterTileRenderer)renderer
+{
+    for ( int i = 0; i < 2; i++ ) {
+        if ( !isfinite(mapping.offset[i]) || !isfinite(mapping.scale[i]) || (mapping.scale[i] == 0.0)) {
+            return NO;
+        }
+    }
+    if ( CGRectIsEmpty(bounds) || (contentsScale <= CPTFloat(0.0))) {
+        return NO;
+    }
+
+    NSMutableDictionary<NSValue *, _CPTRasterTile *> *theTiles = self.tiles;
+
+    // a zoom changes every tile, so show the old ones resized until the plot asks for new ones
+    CPTRasterTileMapping oldMapping = self.tileMapping;
+    BOOL sameScale                  = (contentsScale == self.tileContentsScale);
+
+    for ( int i = 0; i < 2; i++ ) {
+        sameScale = sameScale && (fabs(mapping.scale[i] - oldMapping.scale[i]) <= CPTRasterTileCacheScaleTolerance * fabs(mapping.scale[i]));
+    }
+
+    if ( !sameScale && (theTiles.count > 0)) {
+        self.showsStaleTiles = YES;
+        for ( _CPTRasterTile *tile in theTiles.allValues ) {
+            [self drawTile:tile inContext:context mapping:mapping clipRect:bounds];
+        }
+        return YES;
+    }
+
+    self.tileMapping       = mapping;
+    self.tileContentsScale = contentsScale;
+    self.showsStaleTiles   = NO;
+
+    // tiles covering the bounds
+    const double tileWidth[2] = { (double)self.tileSize / fabs(mapping.scale[0]), (double)self.tileSize / fabs(mapping.scale[1]) };
+    const double tolerance[2] = { 0.5 / (fabs(mapping.scale[0]) * (double)contentsScale), 0.5 / (fabs(mapping.scale[1]) * (double)contentsScale) };
+
+    CPTRasterTileExtent visibleExtent = CPTRasterTileExtentForViewRect(bounds, mapping);
+
+    NSInteger firstColumn = (NSInteger)floor(visibleExtent.min[0] / tileWidth[0]);
+    NSInteger lastColumn  = MAX((NSInteger)ceil(visibleExtent.max[0] / tileWidth[0]) - 1, firstColumn);
+    NSInteger firstRow    = (NSInteger)floor(visibleExtent.min[1] / tileWidth[1]);
+    NSInteger lastRow     = MAX((NSInteger)ceil(visibleExtent.max[1] / tileWidth[1]) - 1, firstRow);
+
+    // drop the tiles that scrolled away
+    for ( NSValue *key in theTiles.allKeys ) {
+        CPTRasterTileIndex tileIndex;
+        [key getValue:&tileIndex];
+
+        if ((tileIndex.column < firstColumn - 1) || (tileIndex.column > lastColumn + 1) ||
+            (tileIndex.row < firstRow - 1) || (tileIndex.row > lastRow + 1)) {
+            [theTiles removeObjectForKey:key];
+        }
+    }
+
+    // find the tiles missing part of what is now visible
+    NSMutableArray<NSValue *> *staleKeys     = [NSMutableArray array];
+    NSMutableArray<NSValue *> *neededExtents = [NSMutableArray array];
+    CGRect dirtyRect                         = CGRectNull;
+
+    for ( NSInteger row = firstRow; row <= lastRow; row++ ) {
+        for ( NSInteger column = firstColumn; column <= lastColumn; column++ ) {
+            CPTRasterTileIndex tileIndex = { column, row };
+            CPTRasterTileExtent tileExtent;
+            tileExtent.min[0] = (double)column * tileWidth[0];
+            tileExtent.max[0] = (double)(column + 1) * tileWidth[0];
+            tileExtent.min[1] = (double)row * tileWidth[1];
+            tileExtent.max[1] = (double)(row + 1) * tileWidth[1];
+
+            CPTRasterTileExtent neededExtent = CPTRasterTileExtentIntersection(tileExtent, visibleExtent);
+            if ( CPTRasterTileExtentIsEmpty(neededExtent)) {
+                continue;
+            }
+
+            NSValue *key         = [NSValue valueWithBytes:&tileIndex objCType:@encode(CPTRasterTileIndex)];
+            _CPTRasterTile *tile = theTiles[key];
+            if ( !tile || !CPTRasterTileExtentContains(tile.extent, neededExtent, tolerance)) {
+                [staleKeys addObject:key];
+                [neededExtents addObject:[NSValue valueWithBytes:&neededExtent objCType:@encode(CPTRasterTileExtent)]];
+                dirtyRect = CGRectUnion(dirtyRect, CPTRasterTileViewRect(neededExtent, mapping));
+            }
+        }
+    }
+
+    // render everything missing in one pass and cut it into tiles
+    if ( staleKeys.count > 0 ) {
+        CGRect pixelRect = CGRectIntegral(CGRectMake(dirtyRect.origin.x * contentsScale, dirtyRect.origin.y * contentsScale,
+                                                     dirtyRect.size.width * contentsScale, dirtyRect.size.height * contentsScale));
+        size_t pixelWidth  = (size_t)pixelRect.size.width;
+        size_t pixelHeight = (size_t)pixelRect.size.height;
+
+        dirtyRect = CGRectMake(pixelRect.origin.x / contentsScale, pixelRect.origin.y / contentsScale,
+                               pixelRect.size.width / contentsScale, pixelRect.size.height / contentsScale);
+
+        CGContextRef tileContext = CGBitmapContextCreate(NULL, pixelWidth, pixelHeight, 8, 0,
+                                                         [CPTColorSpace genericRGBSpace].cgColorSpace,
+                                                         (CGBitmapInfo)kCGImageAlphaPremultipliedLast);
+        if ( !tileContext ) {
+            return NO;
+        }
+
+        CGContextScaleCTM(tileContext, contentsScale, contentsScale);
+        CGContextTranslateCTM(tileContext, -dirtyRect.origin.x, -dirtyRect.origin.y);
+        CGContextClipToRect(tileContext, dirtyRect);
+
+        renderer(tileContext);
+        self.renderCount++;
+
+        CGImageRef renderedImage = CGBitmapContextCreateImage(tileContext);
+        CGContextRelease(tileContext);
+
+        for ( NSUInteger i = 0; i < staleKeys.count; i++ ) {
+            CPTRasterTileExtent neededExtent;
+            [neededExtents[i] getValue:&neededExtent];
+
+            // whole pixels of the bitmap holding the needed part of the tile
+            CGRect tileRect      = CPTRasterTileViewRect(neededExtent, mapping);
+            CGRect tilePixelRect = CGRectIntegral(CGRectMake((tileRect.origin.x - dirtyRect.origin.x) * contentsScale,
+                                                             (tileRect.origin.y - dirtyRect.origin.y) * contentsScale,
+                                                             tileRect.size.width * contentsScale,
+                                                             tileRect.size.height * contentsScale));
+            tilePixelRect = CGRectIntersection(tilePixelRect, CGRectMake(0.0, 0.0, (CGFloat)pixelWidth, (CGFloat)pixelHeight));
+            if ( CGRectIsEmpty(tilePixelRect)) {
+                continue;
+            }
+
+            // image rows run top down
+            CGRect imageRect = tilePixelRect;
+
+            imageRect.origin.y = (CGFloat)pixelHeight - CGRectGetMaxY(tilePixelRect);
+
+            CGImageRef tileImage = CGImageCreateWithImageInRect(renderedImage, imageRect);
+
+            _CPTRasterTile *tile = [[_CPTRasterTile alloc] init];
+            tile.image  = tileImage;
+            tile.extent = CPTRasterTileExtentForViewRect(CGRectMake(dirtyRect.origin.x + tilePixelRect.origin.x / contentsScale,
+                                                                    dirtyRect.origin.y + tilePixelRect.origin.y / contentsScale,
+                                                                    tilePixelRect.size.width / contentsScale,
+                                                                    tilePixelRect.size.height / contentsScale),
+                                                         mapping);
+            theTiles[staleKeys[i]] = tile;
+
+            CGImageRelease(tileImage);
+        }
+
+        CGImageRelease(renderedImage);
+    }
+
+    // composite, each tile clipped to its own grid cell so neighbours never overlap
+    for ( NSInteger row = firstRow; row <= lastRow; row++ ) {
+        for ( NSInteger column = firstColumn; column <= lastColumn; column++ ) {
+            CPTRasterTileIndex tileIndex = { column, row };
+            _CPTRasterTile *tile         = theTiles[[NSValue valueWithBytes:&tileIndex objCType:@encode(CPTRasterTileIndex)]];
+
+            if ( tile ) {
+                CPTRasterTileExtent cellExtent;
+                cellExtent.min[0] = (double)column * tileWidth[0];
+                cellExtent.max[0] = (double)(column + 1) * tileWidth[0];
+                cellExtent.min[1] = (double)row * tileWidth[1];
+                cellExtent.max[1] = (double)(row + 1) * tileWidth[1];
+
+                CGRect cellRect = CPTAlignIntegralRectToUserSpace(context, CPTRasterTileViewRect(cellExtent, mapping));
+
+                [self drawTile:tile inContext:context mapping:mapping clipRect:CGRectIntersection(cellRect, bounds)];
+            }
+        }
+    }
+
+    return YES;
+}
+
+/// @cond
+
+-(void)drawTile:(nonnull _CPTRasterTile *)tile inContext:(nonnull CGContextRef)context mapping:(CPTRasterTileMapping)mapping clipRect:(CGRect)clipRect
+{
+    CGRect imageRect = CPTRasterTileViewRect(tile.extent, mapping);
+
+    CGContextSaveGState(context);
+    CGContextClipToRect(context, clipRect);
+
+    if ( self.showsStaleTiles ) {
+        CGContextSetInterpolationQuality(context, kCGInterpolationDefault);
+    }
+    else {
+        // same scale, so snap to the pixel grid rather than resample
+        imageRect.origin = CPTAlignIntegralPointToUserSpace(context, imageRect.origin);
+        CGContextSetInterpolationQuality(context, kCGInterpolationNone);
+    }
+    CGContextDrawImage(context, imageRect, tile.image);
+
+    CGContextRestoreGState(context);
+}
+
+/// @endcond
+
+@end
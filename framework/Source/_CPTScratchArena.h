@@ -0,0 +1,47 @@
+//
+//  _CPTScratchArena.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Bump allocator for the temporary buffers of a render pass. Buffers are handed out
+//  from chunks kept between frames and released by resetting to a mark taken before
+//  allocating them, so they must be released in the reverse order they were taken.
+//  A frame that overflows the current chunk gets another one, and once every buffer
+//  is back the chunks are merged into one large enough for the whole frame, so a
+//  plot redrawn with the same amount of data stops allocating memory altogether.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlot.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface _CPTScratchArena : NSObject
+
+// bytes currently held from the system
+@property (nonatomic, readonly) NSUInteger capacity;
+// most bytes in use at once since the arena was created or purged
+@property (nonatomic, readonly) NSUInteger highWaterMark;
+// number of times memory was requested from the system
+@property (nonatomic, readonly) NSUInteger systemAllocationCount;
+// current position, pass to resetToMark: to release the buffers allocated after it
+@property (nonatomic, readonly) NSUInteger mark;
+
+// zero filled buffer of count elements of size bytes, aligned for any scalar or vector type
+-(nonnull void *)allocateCount:(NSUInteger)count size:(size_t)size;
+-(void)resetToMark:(NSUInteger)mark;
+// gives the memory back to the system, deferred until every buffer is released if the arena is in use
+-(void)purge;
+
+@end
+
+@interface CPTPlot(ScratchArena)
+
+// the scratch arena of the plot, created on first use
+-(nonnull _CPTScratchArena *)scratchArena;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,235 @@
+//
+//  _CPTScratchArena.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTScratchArena.h"
+
+// alignment of every buffer
+static const size_t CPTScratchArenaAlignment = 16;
+
+// smallest chunk requested from the system
+static const size_t CPTScratchArenaMinimumChunkSize = 64 * 1024;
+
+typedef struct {
+    uint8_t *bytes;
+    size_t size;
+    size_t start;   // position of the first byte of the chunk
+} CPTScratchChunk;
+
+@interface _CPTScratchArena()
+
+@property (nonatomic, readwrite) NSUInteger capacity;
+@property (nonatomic, readwrite) NSUInteger highWaterMark;
+@property (nonatomic, readwrite) NSUInteger systemAllocationCount;
+@property (nonatomic, readwrite) BOOL needsPurge;
+
++(void)registerArena:(nonnull _CPTScratchArena *)arena;
+-(void)appendChunkOfSize:(size_t)size;
+-(void)releaseChunks;
+
+@end
+
+#pragma mark -
+
+// the memory pressure handler purges arenas from the main queue, so the arenas drawn on a render queue are locked
+@implementation _CPTScratchArena {
+    CPTScratchChunk *chunks;
+    size_t chunkCount;
+    size_t currentChunk;
+    size_t used;
+}
+
+@synthesize capacity;
+@synthesize highWaterMark;
+@synthesize systemAllocationCount;
+@synthesize needsPurge;
+
+#pragma mark -
+#pragma mark Memory Pressure
+
+/// @cond
+
+// purges every arena when the system runs short of memory
++(void)registerArena:(nonnull _CPTScratchArena *)arena
+{
+    static NSHashTable<_CPTScratchArena *> *arenas = nil;
+    static dispatch_source_t memoryPressureSource  = nil;
+    static dispatch_once_t onceToken               = 0;
+
+    dispatch_once(&onceToken, ^{
+        arenas               = [NSHashTable weakObjectsHashTable];
+        memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                      DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                      dispatch_get_main_queue());
+        dispatch_source_set_event_handler(memoryPressureSource, ^{
+            NSArray<_CPTScratchArena *> *allArenas;
+            @synchronized ( arenas ) {
+                allArenas = arenas.allObjects;
+            }
+            for ( _CPTScratchArena *theArena in allArenas ) {
+                [theArena purge];
+            }
+        });
+        dispatch_resume(memoryPressureSource);
+    });
+
+    @synchronized ( arenas ) {
+        [arenas addObject:arena];
+    }
+}
+
+/// @endcond
+
+#pragma mark -
+#pragma mark Init/Dealloc
+
+-(nonnull instancetype)init
+{
+    if ((self = [super init])) {
+        chunks                = NULL;
+        chunkCount            = 0;
+        currentChunk          = 0;
+        used                  = 0;
+        capacity              = 0;
+        highWaterMark         = 0;
+        systemAllocationCount = 0;
+        needsPurge            = NO;
+
+        [_CPTScratchArena registerArena:self];
+    }
+    return self;
+}
+
+-(void)dealloc
+{
+    [self releaseChunks];
+}
+
+#pragma mark -
+#pragma mark Allocation
+
+-(NSUInteger)mark
+{
+    return (NSUInteger)used;
+}
+
+-(nonnull void *)allocateCount:(NSUInteger)count size:(size_t)size
+{
+    @synchronized ( self ) {
+        size_t length = MAX((size_t)count * size, (size_t)1);
+        size_t offset = (used + CPTScratchArenaAlignment - 1) & ~(CPTScratchArenaAlignment - 1);
+
+        while ( chunkCount == 0 || (offset + length > chunks[currentChunk].start + chunks[currentChunk].size)) {
+            if ((chunkCount > 0) && (currentChunk + 1 < chunkCount) && (chunks[currentChunk + 1].size >= length)) {
+                // a chunk kept from an earlier frame is big enough
+                currentChunk++;
+            }
+            else {
+                // drop any smaller chunks after the current one and grow by at least the memory held so far
+                for ( size_t i = currentChunk + 1; i < chunkCount; i++ ) {
+                    capacity -= chunks[i].size;
+                    free(chunks[i].bytes);
+                }
+                chunkCount = chunkCount > 0 ? currentChunk + 1 : 0;
+
+                [self appendChunkOfSize:MAX(MAX(length, (size_t)capacity), CPTScratchArenaMinimumChunkSize)];
+                currentChunk = chunkCount - 1;
+            }
+            offset = MAX(offset, chunks[currentChunk].start);
+        }
+
+        used          = offset + length;
+        highWaterMark = MAX(highWaterMark, (NSUInteger)used);
+
+        void *buffer = chunks[currentChunk].bytes + (offset - chunks[currentChunk].start);
+
+        memset(buffer, 0, length);
+
+        return buffer;
+    }
+}
+
+-(void)resetToMark:(NSUInteger)mark
+{
+    @synchronized ( self ) {
+        used = MIN((size_t)mark, used);
+
+        while ( currentChunk > 0 && chunks[currentChunk].start > used ) {
+            currentChunk--;
+        }
+
+        if ( used == 0 ) {
+            if ( self.needsPurge ) {
+                [self releaseChunks];
+                self.highWaterMark = 0;
+            }
+            else if ( chunkCount > 1 ) {
+                // the last frame did not fit in one chunk, replace them all by one that holds the whole frame
+                size_t frameSize = MAX((size_t)self.highWaterMark, (size_t)capacity);
+                [self releaseChunks];
+                [self appendChunkOfSize:frameSize];
+            }
+        }
+    }
+}
+
+-(void)purge
+{
+    @synchronized ( self ) {
+        if ( used == 0 ) {
+            [self releaseChunks];
+            self.highWaterMark = 0;
+        }
+        else {
+            self.needsPurge = YES;
+        }
+    }
+}
+
+/// @cond
+
+-(void)appendChunkOfSize:(size_t)size
+{
+    CPTScratchChunk *newChunks = realloc(chunks, (chunkCount + 1) * sizeof(CPTScratchChunk));
+
+    if ( !newChunks ) {
+        [NSException raise:NSMallocException format:@"Could not grow the scratch arena"];
+    }
+    chunks = newChunks;
+
+    uint8_t *bytes = NULL;
+
+    if ( posix_memalign((void **)&bytes, CPTScratchArenaAlignment, size) != 0 ) {
+        [NSException raise:NSMallocException format:@"Could not allocate %lu scratch bytes", (unsigned long)size];
+    }
+
+    size_t start = chunkCount > 0 ? chunks[chunkCount - 1].start + chunks[chunkCount - 1].size : 0;
+
+    chunks[chunkCount].bytes = bytes;
+    chunks[chunkCount].size  = size;
+    chunks[chunkCount].start = start;
+    chunkCount++;
+
+    capacity += size;
+    systemAllocationCount++;
+}
+
+-(void)releaseChunks
+{
+    for ( size_t i = 0; i < chunkCount; i++ ) {
+        free(chunks[i].bytes);
+    }
+    free(chunks);
+    chunks       = NULL;
+    chunkCount   = 0;
+    currentChunk = 0;
+    capacity     = 0;
+    needsPurge   = NO;
+}
+
+/// @endcond
+
+@end
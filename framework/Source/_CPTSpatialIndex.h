@@ -0,0 +1,50 @@
+//
+//  _CPTSpatialIndex.h
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+//  Static bounding volume tree over the view space rectangles of plot items (points are
+//  rectangles of zero size). Items are split at the median of their centres along the
+//  wider axis of each node until a node holds a handful of items, so nearest item and
+//  hit test queries only visit O(log n) nodes instead of every record of the plot.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "CPTPlot.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface _CPTSpatialIndex : NSObject
+
+// number of items in the index
+@property (nonatomic, readonly) NSUInteger count;
+// per item data kept with the index by its owner, e.g. vector tips
+@property (nonatomic, readwrite, strong, nullable) NSData *itemData;
+
+// items whose flag is NO or whose coordinates are NaN are left out, flags may be NULL
+-(nonnull instancetype)initWithPoints:(nullable const CGPoint *)points flags:(nullable const BOOL *)flags count:(NSUInteger)count;
+-(nonnull instancetype)initWithRects:(nullable const CGRect *)rects flags:(nullable const BOOL *)flags count:(NSUInteger)count;
+
+// index of the item nearest to point, the lowest index wins a tie. NSNotFound if the index is empty
+-(NSUInteger)indexOfItemClosestToPoint:(CGPoint)point;
+// lowest index of the items whose rectangle contains point (edges included) and which pass test,
+// test may be nil. NSNotFound if there is none
+-(NSUInteger)lowestIndexOfItemContainingPoint:(CGPoint)point passingTest:(nullable BOOL (^)(NSUInteger idx))test;
+
+@end
+
+typedef _CPTSpatialIndex *_Nonnull (^CPTSpatialIndexBuilder)(void);
+
+@interface CPTPlot(SpatialIndex)
+
+// returns the hit test index of the plot, builder is only called if the index was invalidated
+// or the plot bounds changed since it was built
+-(nonnull _CPTSpatialIndex *)spatialIndexBuiltWithBlock:(nonnull CPTSpatialIndexBuilder)builder;
+// drops the hit test index, called whenever the plot is redisplayed
+-(void)invalidateSpatialIndex;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,316 @@
+//
+//  _CPTSpatialIndex.m
+//  CorePlot
+//
+//  Created by Steve Wainwright on 17/10/2026.
+//
+
+#import "_CPTSpatialIndex.h"
+
+#import <tgmath.h>
+
+// nodes holding this many items or fewer are not split
+static const size_t CPTSpatialIndexLeafSize = 8;
+
+typedef struct {
+    CGFloat minX, minY, maxX, maxY;
+} CPTSpatialIndexBox;
+
+typedef struct {
+    CPTSpatialIndexBox box;
+    NSUInteger index;
+} CPTSpatialIndexItem;
+
+typedef struct {
+    CPTSpatialIndexBox box;     // bounds of all the items below the node
+    size_t start;               // first item of the node
+    size_t count;               // number of items below the node
+    size_t left;                // child nodes, 0 for a leaf as the root is never a child
+    size_t right;
+} CPTSpatialIndexNode;
+
+static CGFloat CPTSpatialIndexItemCentre(const CPTSpatialIndexItem *item, int axis)
+{
+    return axis == 0 ? item->box.minX + item->box.maxX : item->box.minY + item->box.maxY;
+}
+
+// squared distance from point to the nearest point of box, 0 if the box contains it
+static CGFloat CPTSpatialIndexDistanceSquared(CGPoint point, const CPTSpatialIndexBox *box)
+{
+    CGFloat dx = 0.0;
+    CGFloat dy = 0.0;
+
+    if ( point.x < box->minX ) {
+        dx = box->minX - point.x;
+    }
+    else if ( point.x > box->maxX ) {
+        dx = point.x - box->maxX;
+    }
+    if ( point.y < box->minY ) {
+        dy = box->minY - point.y;
+    }
+    else if ( point.y > box->maxY ) {
+        dy = point.y - box->maxY;
+    }
+    return dx * dx + dy * dy;
+}
+
+// reorders items so that the item at position k has the k-th smallest centre along axis,
+// with no larger centre before it and no smaller one after it
+static void CPTSpatialIndexSelect(CPTSpatialIndexItem *items, size_t count, size_t k, int axis)
+{
+    size_t lo = 0;
+    size_t hi = count - 1;
+
+    while ( hi > lo ) {
+        CGFloat pivot = CPTSpatialIndexItemCentre(&items[lo + (hi - lo) / 2], axis);
+        size_t i      = lo;
+        size_t j      = hi;
+        while ( i <= j ) {
+            while ( CPTSpatialIndexItemCentre(&items[i], axis) < pivot ) {
+                i++;
+            }
+            while ( CPTSpatialIndexItemCentre(&items[j], axis) > pivot ) {
+                j--;
+            }
+            if ( i <= j ) {
+                CPTSpatialIndexItem swap = items[i];
+                items[i] = items[j];
+                items[j] = swap;
+                i++;
+                if ( j == 0 ) {
+                    break;
+                }
+                j--;
+            }
+        }
+        if ( k <= j ) {
+            hi = j;
+        }
+        else if ( k >= i ) {
+            lo = i;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+static size_t CPTSpatialIndexBuildNode(CPTSpatialIndexNode *nodes, size_t *nodeCount, CPTSpatialIndexItem *items, size_t start, size_t count)
+{
+    size_t n                = (*nodeCount)++;
+    CPTSpatialIndexBox box  = items[start].box;
+
+    for ( size_t i = start + 1; i < start + count; i++ ) {
+        const CPTSpatialIndexBox *itemBox = &items[i].box;
+        box.minX = MIN(box.minX, itemBox->minX);
+        box.minY = MIN(box.minY, itemBox->minY);
+        box.maxX = MAX(box.maxX, itemBox->maxX);
+        box.maxY = MAX(box.maxY, itemBox->maxY);
+    }
+    nodes[n].box   = box;
+    nodes[n].start = start;
+    nodes[n].count = count;
+    nodes[n].left  = 0;
+    nodes[n].right = 0;
+
+    if ( count > CPTSpatialIndexLeafSize ) {
+        int axis    = (box.maxX - box.minX >= box.maxY - box.minY) ? 0 : 1;
+        size_t half = count / 2;
+        CPTSpatialIndexSelect(items + start, count, half, axis);
+        size_t left  = CPTSpatialIndexBuildNode(nodes, nodeCount, items, start, half);
+        size_t right = CPTSpatialIndexBuildNode(nodes, nodeCount, items, start + half, count - half);
+        nodes[n].left  = left;
+        nodes[n].right = right;
+    }
+    return n;
+}
+
+static void CPTSpatialIndexNearest(const CPTSpatialIndexNode *nodes, const CPTSpatialIndexItem *items, size_t node, CGPoint point, CGFloat *bestDistance, NSUInteger *bestIndex)
+{
+    const CPTSpatialIndexNode *theNode = &nodes[node];
+
+    if ( theNode->left == 0 ) {
+        for ( size_t i = theNode->start; i < theNode->start + theNode->count; i++ ) {
+            CGFloat distance = CPTSpatialIndexDistanceSquared(point, &items[i].box);
+            if ( (distance < *bestDistance) || ((distance == *bestDistance) && (items[i].index < *bestIndex)) ) {
+                *bestDistance = distance;
+                *bestIndex    = items[i].index;
+            }
+        }
+        return;
+    }
+
+    size_t first        = theNode->left;
+    size_t second       = theNode->right;
+    CGFloat firstDist   = CPTSpatialIndexDistanceSquared(point, &nodes[first].box);
+    CGFloat secondDist  = CPTSpatialIndexDistanceSquared(point, &nodes[second].box);
+
+    if ( secondDist < firstDist ) {
+        size_t swapNode = first;
+        first  = second;
+        second = swapNode;
+        CGFloat swapDist = firstDist;
+        firstDist  = secondDist;
+        secondDist = swapDist;
+    }
+    // a node at the same distance as the best item may still hold a lower index
+    if ( firstDist <= *bestDistance ) {
+        CPTSpatialIndexNearest(nodes, items, first, point, bestDistance, bestIndex);
+    }
+    if ( secondDist <= *bestDistance ) {
+        CPTSpatialIndexNearest(nodes, items, second, point, bestDistance, bestIndex);
+    }
+}
+
+static void CPTSpatialIndexContaining(const CPTSpatialIndexNode *nodes, const CPTSpatialIndexItem *items, size_t node, CGPoint point, NSMutableIndexSet *found)
+{
+    const CPTSpatialIndexNode *theNode = &nodes[node];
+
+    if ( (point.x < theNode->box.minX) || (point.x > theNode->box.maxX) || (point.y < theNode->box.minY) || (point.y > theNode->box.maxY) ) {
+        return;
+    }
+    if ( theNode->left == 0 ) {
+        for ( size_t i = theNode->start; i < theNode->start + theNode->count; i++ ) {
+            const CPTSpatialIndexBox *box = &items[i].box;
+            if ( (point.x >= box->minX) && (point.x <= box->maxX) && (point.y >= box->minY) && (point.y <= box->maxY) ) {
+                [found addIndex:items[i].index];
+            }
+        }
+        return;
+    }
+    CPTSpatialIndexContaining(nodes, items, theNode->left, point, found);
+    CPTSpatialIndexContaining(nodes, items, theNode->right, point, found);
+}
+
+@interface _CPTSpatialIndex()
+
+-(void)buildNodes;
+
+@end
+
+#pragma mark -
+
+@implementation _CPTSpatialIndex {
+    CPTSpatialIndexItem *items;
+    CPTSpatialIndexNode *nodes;
+    size_t itemCount;
+}
+
+@synthesize itemData;
+
+#pragma mark -
+#pragma mark Init/Dealloc
+
+-(nonnull instancetype)initWithPoints:(nullable const CGPoint *)points flags:(nullable const BOOL *)flags count:(NSUInteger)count
+{
+    if ((self = [super init])) {
+        items     = count > 0 ? (CPTSpatialIndexItem *)malloc(count * sizeof(CPTSpatialIndexItem)) : NULL;
+        itemCount = 0;
+        for ( NSUInteger i = 0; i < count && points; i++ ) {
+            if ( (flags && !flags[i]) || isnan(points[i].x) || isnan(points[i].y)) {
+                continue;
+            }
+            CPTSpatialIndexItem *item = &items[itemCount++];
+            item->box.minX = item->box.maxX = points[i].x;
+            item->box.minY = item->box.maxY = points[i].y;
+            item->index    = i;
+        }
+        [self buildNodes];
+    }
+    return self;
+}
+
+-(nonnull instancetype)initWithRects:(nullable const CGRect *)rects flags:(nullable const BOOL *)flags count:(NSUInteger)count
+{
+    if ((self = [super init])) {
+        items     = count > 0 ? (CPTSpatialIndexItem *)malloc(count * sizeof(CPTSpatialIndexItem)) : NULL;
+        itemCount = 0;
+        for ( NSUInteger i = 0; i < count && rects; i++ ) {
+            CGRect rect = CGRectStandardize(rects[i]);
+            if ( (flags && !flags[i]) || isnan(rect.origin.x) || isnan(rect.origin.y) || isnan(rect.size.width) || isnan(rect.size.height)) {
+                continue;
+            }
+            CPTSpatialIndexItem *item = &items[itemCount++];
+            item->box.minX = rect.origin.x;
+            item->box.minY = rect.origin.y;
+            item->box.maxX = rect.origin.x + rect.size.width;
+            item->box.maxY = rect.origin.y + rect.size.height;
+            item->index    = i;
+        }
+        [self buildNodes];
+    }
+    return self;
+}
+
+-(void)dealloc
+{
+    free(items);
+    free(nodes);
+}
+
+-(void)buildNodes
+{
+    nodes = NULL;
+    if ( itemCount > 0 ) {
+        // a tree whose leaves are never empty has fewer than twice as many nodes as items
+        size_t nodeCount = 0;
+        nodes = (CPTSpatialIndexNode *)malloc((2 * itemCount) * sizeof(CPTSpatialIndexNode));
+        CPTSpatialIndexBuildNode(nodes, &nodeCount, items, 0, itemCount);
+    }
+}
+
+#pragma mark -
+#pragma mark Queries
+
+-(NSUInteger)count
+{
+    return (NSUInteger)itemCount;
+}
+
+-(NSUInteger)indexOfItemClosestToPoint:(CGPoint)point
+{
+    NSUInteger bestIndex = NSNotFound;
+
+    if ( itemCount > 0 ) {
+        if ( isnan(point.x) || isnan(point.y)) {
+            // no distance can be compared, fall back to the first item like a linear scan would
+            for ( size_t i = 0; i < itemCount; i++ ) {
+                bestIndex = MIN(bestIndex, items[i].index);
+            }
+        }
+        else {
+            CGFloat bestDistance = (CGFloat)INFINITY;
+            CPTSpatialIndexNearest(nodes, items, 0, point, &bestDistance, &bestIndex);
+        }
+    }
+    return bestIndex;
+}
+
+-(NSUInteger)lowestIndexOfItemContainingPoint:(CGPoint)point passingTest:(nullable BOOL (^)(NSUInteger idx))test
+{
+    if ((itemCount == 0) || isnan(point.x) || isnan(point.y)) {
+        return NSNotFound;
+    }
+
+    NSMutableIndexSet *found = [NSMutableIndexSet indexSet];
+
+    CPTSpatialIndexContaining(nodes, items, 0, point, found);
+
+    if ( !test ) {
+        return found.firstIndex;
+    }
+
+    __block NSUInteger result = NSNotFound;
+
+    [found enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        if ( test(idx)) {
+            result = idx;
+            *stop  = YES;
+        }
+    }];
+
+    return result;
+}
+
+@end